@@ -0,0 +1,112 @@
+//! Alt/az sampling kernel benchmarks.
+//!
+//! Measures the precomputed-grid kernel at the AltAz page's worst realistic
+//! size (1k targets × 4k samples, i.e. ~28 days at 10-minute cadence) and
+//! compares per-sample cost against siderust's per-point `altitude_at` on a
+//! small subset.
+//!
+//! Run with `cargo bench --bench altaz_kernel`.
+
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use tsi_rust::qtty::{Degrees, Meters};
+use tsi_rust::services::altaz::{horizontal_at, sample_horizontal, DirectionBatch, HorizontalGrid};
+use tsi_rust::siderust::calculus::altitude::AltitudePeriodsProvider;
+use tsi_rust::siderust::coordinates::centers::Geodetic;
+use tsi_rust::siderust::coordinates::frames::ECEF;
+use tsi_rust::siderust::coordinates::spherical::direction;
+use tsi_rust::siderust::time::ModifiedJulianDate;
+
+const LAT_DEG: f64 = 28.7624;
+const LON_DEG: f64 = -17.8892;
+const START_MJD: f64 = 60694.0;
+const STEP_DAYS: f64 = 10.0 / 1440.0;
+
+/// Deterministic pseudo-random directions spread over the sphere.
+fn directions(count: usize) -> Vec<(f64, f64)> {
+    let golden = 0.618_033_988_749_894_9_f64;
+    (0..count)
+        .map(|i| {
+            let ra = (i as f64 * golden).fract() * 360.0;
+            let dec = ((i as f64 + 0.5) / count as f64 * 2.0 - 1.0)
+                .asin()
+                .to_degrees();
+            (ra, dec)
+        })
+        .collect()
+}
+
+fn bench_grid_precompute(c: &mut Criterion) {
+    let mut group = c.benchmark_group("altaz_grid");
+    for samples in [1_000usize, 4_000] {
+        group.throughput(Throughput::Elements(samples as u64));
+        group.bench_with_input(BenchmarkId::from_parameter(samples), &samples, |b, &n| {
+            b.iter(|| HorizontalGrid::regular(LAT_DEG, LON_DEG, START_MJD, STEP_DAYS, black_box(n)))
+        });
+    }
+    group.finish();
+}
+
+fn bench_kernel(c: &mut Criterion) {
+    let mut group = c.benchmark_group("altaz_kernel");
+    group.sample_size(10);
+    for (targets, samples) in [(200usize, 4_000usize), (1_000, 4_000)] {
+        let grid = HorizontalGrid::regular(LAT_DEG, LON_DEG, START_MJD, STEP_DAYS, samples);
+        let batch = DirectionBatch::from_ra_dec(directions(targets));
+        let mut altitudes = vec![0.0_f32; targets * samples];
+        let mut azimuths = vec![0.0_f32; targets * samples];
+        group.throughput(Throughput::Elements((targets * samples) as u64));
+        group.bench_function(format!("{targets}x{samples}"), |b| {
+            b.iter(|| sample_horizontal(&grid, &batch, &mut altitudes, &mut azimuths))
+        });
+    }
+    group.finish();
+}
+
+fn bench_per_point_baselines(c: &mut Criterion) {
+    let mut group = c.benchmark_group("altaz_per_point");
+    group.sample_size(10);
+    let targets = directions(10);
+    let samples = 4_000usize;
+    group.throughput(Throughput::Elements((targets.len() * samples) as u64));
+
+    group.bench_function("scalar_horizontal_at_10x4000", |b| {
+        b.iter(|| {
+            let mut acc = 0.0;
+            for &(ra, dec) in &targets {
+                for i in 0..samples {
+                    let mjd = START_MJD + i as f64 * STEP_DAYS;
+                    acc += horizontal_at(ra, dec, LAT_DEG, LON_DEG, mjd).0;
+                }
+            }
+            black_box(acc)
+        })
+    });
+
+    let observer = Geodetic::<ECEF>::new(
+        Degrees::new(LON_DEG),
+        Degrees::new(LAT_DEG),
+        Meters::new(2396.0),
+    );
+    group.bench_function("siderust_altitude_at_10x4000", |b| {
+        b.iter(|| {
+            let mut acc = 0.0;
+            for &(ra, dec) in &targets {
+                let subject = direction::ICRS::new(Degrees::new(ra), Degrees::new(dec));
+                for i in 0..samples {
+                    let mjd = ModifiedJulianDate::new(START_MJD + i as f64 * STEP_DAYS);
+                    acc += subject.altitude_at(&observer, mjd).value();
+                }
+            }
+            black_box(acc)
+        })
+    });
+    group.finish();
+}
+
+criterion_group!(
+    benches,
+    bench_grid_precompute,
+    bench_kernel,
+    bench_per_point_baselines
+);
+criterion_main!(benches);
@@ -0,0 +1,184 @@
+//! Throughput of the compare endpoint's data path under concurrent clients.
+//!
+//! Two synthetic schedules are stored in the repository selected by
+//! `REPOSITORY_TYPE`/`DATABASE_URL` (in-memory by default) and 64 clients
+//! (override with `TSI_BENCH_CLIENTS`) each load one comparison per round.
+//! `TSI_BENCH_BLOCKS` sets the schedule size (default 10k).
+//!
+//! - `compare/sequential` awaits the four repository reads one after
+//!   another; `compare/concurrent` is `get_compare_data`, which issues them
+//!   together.
+//! - With `--features postgres-async` and `DATABASE_URL` set,
+//!   `postgres/blocking_pool` and `postgres/async_reads` run the same
+//!   service against the Diesel-only and the async read paths.
+//!
+//! Run with `cargo bench --bench concurrent_clients`.
+
+use std::sync::Arc;
+use std::time::{Duration, Instant};
+
+use criterion::{criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use tokio::runtime::Runtime;
+use tsi_rust::api::ScheduleId;
+use tsi_rust::db::repository::FullRepository;
+use tsi_rust::db::{services as db_services, RepositoryFactory};
+use tsi_rust::models::synthetic::{generate_schedule, SyntheticScheduleConfig};
+use tsi_rust::services::compare::get_compare_data;
+
+fn env_or<T: std::str::FromStr>(key: &str, default: T) -> T {
+    std::env::var(key)
+        .ok()
+        .and_then(|v| v.parse().ok())
+        .unwrap_or(default)
+}
+
+/// Store the two schedules every client compares.
+async fn seed(repo: &(dyn FullRepository + 'static), blocks: usize) -> (ScheduleId, ScheduleId) {
+    let mut ids = Vec::with_capacity(2);
+    for seed in [0x5eed_u64, 0xc0ffee] {
+        let schedule = generate_schedule(&SyntheticScheduleConfig {
+            blocks,
+            seed,
+            ..Default::default()
+        });
+        let info = db_services::store_schedule(repo, &schedule)
+            .await
+            .expect("store benchmark schedule");
+        ids.push(info.schedule_id);
+    }
+    (ids[0], ids[1])
+}
+
+/// The compare reads awaited one after another.
+async fn compare_sequential(
+    repo: &(dyn FullRepository + 'static),
+    current: ScheduleId,
+    other: ScheduleId,
+) {
+    let current_columns = repo.get_schedule_columns(current).await.unwrap();
+    let other_columns = repo.get_schedule_columns(other).await.unwrap();
+    let _ = repo.fetch_gap_metrics(current).await;
+    let _ = repo.fetch_gap_metrics(other).await;
+    assert!(current_columns.len() + other_columns.len() > 0);
+}
+
+async fn compare_concurrent(
+    repo: &(dyn FullRepository + 'static),
+    current: ScheduleId,
+    other: ScheduleId,
+) {
+    get_compare_data(
+        repo,
+        current,
+        other,
+        "current".to_string(),
+        "other".to_string(),
+        None,
+        None,
+        None,
+    )
+    .await
+    .unwrap();
+}
+
+/// Run `rounds` rounds of `clients` concurrent requests; returns the wall time.
+fn run_clients<F, Fut>(
+    runtime: &Runtime,
+    repo: &Arc<dyn FullRepository>,
+    clients: usize,
+    rounds: u64,
+    request: F,
+) -> Duration
+where
+    F: Fn(Arc<dyn FullRepository>) -> Fut,
+    Fut: std::future::Future<Output = ()> + Send + 'static,
+{
+    runtime.block_on(async {
+        let started = Instant::now();
+        for _ in 0..rounds {
+            let handles: Vec<_> = (0..clients)
+                .map(|_| tokio::spawn(request(repo.clone())))
+                .collect();
+            for handle in handles {
+                handle.await.unwrap();
+            }
+        }
+        started.elapsed()
+    })
+}
+
+fn bench_compare(c: &mut Criterion) {
+    let runtime = Runtime::new().unwrap();
+    let clients = env_or("TSI_BENCH_CLIENTS", 64usize);
+    let blocks = env_or("TSI_BENCH_BLOCKS", 10_000usize);
+
+    let repo = runtime
+        .block_on(RepositoryFactory::from_env())
+        .expect("create benchmark repository");
+    let (current, other) = runtime.block_on(seed(repo.as_ref(), blocks));
+
+    let mut group = c.benchmark_group("compare");
+    group.sample_size(10);
+    group.throughput(Throughput::Elements(clients as u64));
+    group.bench_function(BenchmarkId::new("sequential", clients), |b| {
+        b.iter_custom(|rounds| {
+            run_clients(&runtime, &repo, clients, rounds, |repo| async move {
+                compare_sequential(repo.as_ref(), current, other).await
+            })
+        })
+    });
+    group.bench_function(BenchmarkId::new("concurrent", clients), |b| {
+        b.iter_custom(|rounds| {
+            run_clients(&runtime, &repo, clients, rounds, |repo| async move {
+                compare_concurrent(repo.as_ref(), current, other).await
+            })
+        })
+    });
+    group.finish();
+}
+
+#[cfg(feature = "postgres-async")]
+fn bench_postgres_paths(c: &mut Criterion) {
+    use tsi_rust::db::{PostgresConfig, PostgresRepository};
+
+    let Ok(config) = PostgresConfig::from_env() else {
+        eprintln!("DATABASE_URL not set; skipping postgres/* benchmarks");
+        return;
+    };
+    let runtime = Runtime::new().unwrap();
+    let clients = env_or("TSI_BENCH_CLIENTS", 64usize);
+    let blocks = env_or("TSI_BENCH_BLOCKS", 10_000usize);
+
+    let async_repo = PostgresRepository::new(config).expect("connect to Postgres");
+    let blocking_repo = async_repo.clone().without_async_reads();
+    let (current, other) = runtime.block_on(seed(&async_repo, blocks));
+
+    let mut group = c.benchmark_group("postgres");
+    group.sample_size(10);
+    group.throughput(Throughput::Elements(clients as u64));
+    for (name, repo) in [
+        (
+            "blocking_pool",
+            Arc::new(blocking_repo) as Arc<dyn FullRepository>,
+        ),
+        (
+            "async_reads",
+            Arc::new(async_repo) as Arc<dyn FullRepository>,
+        ),
+    ] {
+        group.bench_function(BenchmarkId::new(name, clients), |b| {
+            b.iter_custom(|rounds| {
+                run_clients(&runtime, &repo, clients, rounds, |repo| async move {
+                    compare_concurrent(repo.as_ref(), current, other).await
+                })
+            })
+        });
+    }
+    group.finish();
+}
+
+#[cfg(not(feature = "postgres-async"))]
+fn bench_postgres_paths(_c: &mut Criterion) {}
+
+criterion_group!(benches, bench_compare, bench_postgres_paths);
+criterion_main!(benches);
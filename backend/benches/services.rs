@@ -0,0 +1,336 @@
+//! Service-layer benchmarks on synthetic schedules.
+//!
+//! Each pure service computation is measured at 1k, 10k and 100k blocks
+//! (override with `TSI_BENCH_SCALES=1000,5000`). Schedules come from
+//! [`tsi_rust::models::synthetic`] and are shaped by `TSI_BENCH_PERIODS`
+//! (visibility periods per block, default 8) and `TSI_BENCH_WINDOW_DAYS`
+//! (schedule window, default 30). `examples/schedule.json` is parsed as a
+//! realistic fixture alongside the synthetic payloads.
+//!
+//! Run with `cargo bench --bench services`.
+
+use criterion::{
+    black_box, criterion_group, criterion_main, BatchSize, BenchmarkId, Criterion, Throughput,
+};
+use tsi_rust::api::{
+    CompareBlock, DistributionBlock, Schedule, ScheduleId, TrendsBlock, ValidationReport,
+};
+use tsi_rust::db::models::BlockHistogramData;
+use tsi_rust::models::schedule::parse_schedule_json_str;
+use tsi_rust::models::synthetic::{
+    generate_schedule, schedule_to_native_json, SyntheticScheduleConfig,
+};
+use tsi_rust::models::ScheduleColumns;
+use tsi_rust::qtty;
+use tsi_rust::services::compare::compute_compare_data;
+use tsi_rust::services::distributions::compute_distribution_data;
+use tsi_rust::services::fragmentation::compute_fragmentation;
+use tsi_rust::services::stats::SummaryStats;
+use tsi_rust::services::trends::compute_trends_data;
+use tsi_rust::services::validation::{validate_blocks, BlockForValidation};
+use tsi_rust::services::visibility::{
+    compute_block_visibility, compute_visibility_histogram_columns,
+    compute_visibility_histogram_rust, VisibilityInput,
+};
+
+const FIXTURE: &str = include_str!(concat!(
+    env!("CARGO_MANIFEST_DIR"),
+    "/../examples/schedule.json"
+));
+const MJD_EPOCH_UNIX: i64 = -3_506_716_800;
+
+fn env_or<T: std::str::FromStr>(key: &str, default: T) -> T {
+    std::env::var(key)
+        .ok()
+        .and_then(|v| v.parse().ok())
+        .unwrap_or(default)
+}
+
+fn scales() -> Vec<usize> {
+    std::env::var("TSI_BENCH_SCALES")
+        .ok()
+        .map(|v| v.split(',').filter_map(|s| s.trim().parse().ok()).collect())
+        .filter(|v: &Vec<usize>| !v.is_empty())
+        .unwrap_or_else(|| vec![1_000, 10_000, 100_000])
+}
+
+fn config(blocks: usize, seed: u64) -> SyntheticScheduleConfig {
+    SyntheticScheduleConfig {
+        blocks,
+        periods_per_block: env_or("TSI_BENCH_PERIODS", 8),
+        window_days: env_or("TSI_BENCH_WINDOW_DAYS", 30.0),
+        seed,
+        ..Default::default()
+    }
+}
+
+/// One generated schedule plus the row shapes the repositories hand to
+/// each service.
+struct Fixture {
+    schedule: Schedule,
+    columns: ScheduleColumns,
+    histogram_rows: Vec<BlockHistogramData>,
+    compare_rows: Vec<CompareBlock>,
+    comparison_rows: Vec<CompareBlock>,
+    trends_rows: Vec<TrendsBlock>,
+    distribution_rows: Vec<DistributionBlock>,
+    validation_rows: Vec<BlockForValidation>,
+    native_json: String,
+}
+
+fn compare_rows(schedule: &Schedule) -> Vec<CompareBlock> {
+    schedule
+        .blocks
+        .iter()
+        .map(|b| CompareBlock {
+            scheduling_block_id: b.id.map(|id| id.value()).unwrap_or(0).to_string(),
+            original_block_id: b.original_block_id.clone(),
+            block_name: b.block_name.clone(),
+            priority: b.priority,
+            scheduled: b.scheduled_period.is_some(),
+            requested_hours: qtty::Hours::new(b.requested_duration.value() / 3600.0),
+            scheduled_start_mjd: b.scheduled_period.as_ref().map(|p| p.start.value()),
+            scheduled_stop_mjd: b.scheduled_period.as_ref().map(|p| p.end.value()),
+        })
+        .collect()
+}
+
+fn fixture(blocks: usize) -> Fixture {
+    let schedule = generate_schedule(&config(blocks, 1));
+    let comparison = generate_schedule(&config(blocks, 2));
+
+    let histogram_rows = schedule
+        .blocks
+        .iter()
+        .map(|b| BlockHistogramData {
+            scheduling_block_id: b.id.map(|id| id.value()).unwrap_or(0),
+            priority: b.priority,
+            visibility_periods: Some(b.visibility_periods.clone()),
+        })
+        .collect();
+
+    let trends_rows: Vec<TrendsBlock> = schedule
+        .blocks
+        .iter()
+        .map(|b| TrendsBlock {
+            scheduling_block_id: b.id.map(|id| id.value()).unwrap_or(0),
+            original_block_id: b.original_block_id.clone(),
+            block_name: b.block_name.clone(),
+            priority: b.priority,
+            total_visibility_hours: qtty::Hours::new(
+                b.visibility_periods
+                    .iter()
+                    .map(|p| p.duration().value() * 24.0)
+                    .sum(),
+            ),
+            requested_hours: qtty::Hours::new(b.requested_duration.value() / 3600.0),
+            scheduled: b.scheduled_period.is_some(),
+        })
+        .collect();
+
+    let distribution_rows = trends_rows
+        .iter()
+        .map(|b| DistributionBlock {
+            priority: b.priority,
+            total_visibility_hours: b.total_visibility_hours,
+            requested_hours: b.requested_hours,
+            elevation_range_deg: qtty::Degrees::new(30.0),
+            scheduled: b.scheduled,
+        })
+        .collect();
+
+    let validation_rows = schedule
+        .blocks
+        .iter()
+        .map(|b| {
+            let hours = b
+                .visibility_periods
+                .iter()
+                .map(|p| p.duration().value() * 24.0);
+            BlockForValidation {
+                schedule_id: ScheduleId::new(1),
+                scheduling_block_id: b.id.map(|id| id.value()).unwrap_or(0),
+                priority: b.priority,
+                requested_duration_sec: b.requested_duration.value() as i32,
+                min_observation_sec: b.min_observation.value() as i32,
+                total_visibility_hours: hours.clone().sum(),
+                max_visibility_period_hours: hours.fold(0.0, f64::max),
+                min_alt_deg: Some(b.constraints.min_alt.value()),
+                max_alt_deg: Some(b.constraints.max_alt.value()),
+                constraint_start_mjd: None,
+                constraint_stop_mjd: None,
+                scheduled_start_mjd: b.scheduled_period.as_ref().map(|p| p.start.value()),
+                scheduled_stop_mjd: b.scheduled_period.as_ref().map(|p| p.end.value()),
+                target_ra_deg: b.target_ra.value(),
+                target_dec_deg: b.target_dec.value(),
+            }
+        })
+        .collect();
+
+    Fixture {
+        histogram_rows,
+        compare_rows: compare_rows(&schedule),
+        comparison_rows: compare_rows(&comparison),
+        trends_rows,
+        distribution_rows,
+        validation_rows,
+        native_json: schedule_to_native_json(&schedule).to_string(),
+        columns: ScheduleColumns::from_schedule(&schedule),
+        schedule,
+    }
+}
+
+fn empty_report(schedule: &Schedule) -> ValidationReport {
+    ValidationReport {
+        schedule_id: ScheduleId::new(1),
+        total_blocks: schedule.blocks.len(),
+        valid_blocks: schedule.blocks.len(),
+        impossible_blocks: Vec::new(),
+        validation_errors: Vec::new(),
+        validation_warnings: Vec::new(),
+    }
+}
+
+fn bench_services(c: &mut Criterion) {
+    for blocks in scales() {
+        let f = fixture(blocks);
+        let mut group = c.benchmark_group(format!("services/{blocks}_blocks"));
+        group.sample_size(10);
+        group.throughput(Throughput::Elements(blocks as u64));
+
+        let start_unix =
+            MJD_EPOCH_UNIX + (f.schedule.schedule_period.start.value() * 86_400.0) as i64;
+        let end_unix = MJD_EPOCH_UNIX + (f.schedule.schedule_period.end.value() * 86_400.0) as i64;
+        // Owned inputs are cloned in untimed setup so only the service is measured.
+        group.bench_function("visibility_histogram", |b| {
+            b.iter_batched(
+                || f.histogram_rows.clone(),
+                |rows| {
+                    compute_visibility_histogram_rust(
+                        rows.into_iter(),
+                        start_unix,
+                        end_unix,
+                        (end_unix - start_unix) / 50,
+                        None,
+                        None,
+                    )
+                    .unwrap()
+                },
+                BatchSize::LargeInput,
+            )
+        });
+        group.bench_function("visibility_histogram_columns", |b| {
+            b.iter(|| {
+                compute_visibility_histogram_columns(
+                    black_box(&f.columns),
+                    0..f.columns.len(),
+                    start_unix,
+                    end_unix,
+                    (end_unix - start_unix) / 50,
+                    None,
+                    None,
+                )
+                .unwrap()
+            })
+        });
+        group.bench_function("schedule_columns", |b| {
+            b.iter(|| ScheduleColumns::from_schedule(black_box(&f.schedule)))
+        });
+
+        let report = empty_report(&f.schedule);
+        group.bench_function("fragmentation", |b| {
+            b.iter(|| compute_fragmentation(black_box(&f.columns), &report))
+        });
+
+        group.bench_function("compare", |b| {
+            b.iter_batched(
+                || (f.compare_rows.clone(), f.comparison_rows.clone()),
+                |(current, comparison)| {
+                    compute_compare_data(
+                        current,
+                        comparison,
+                        "current".to_string(),
+                        "comparison".to_string(),
+                        None,
+                        None,
+                        None,
+                    )
+                    .unwrap()
+                },
+                BatchSize::LargeInput,
+            )
+        });
+
+        group.bench_function("trends", |b| {
+            b.iter_batched(
+                || f.trends_rows.clone(),
+                |rows| compute_trends_data(rows, 10, 0.5, 12).unwrap(),
+                BatchSize::LargeInput,
+            )
+        });
+
+        group.bench_function("distributions", |b| {
+            b.iter_batched(
+                || f.distribution_rows.clone(),
+                |rows| compute_distribution_data(rows, 0).unwrap(),
+                BatchSize::LargeInput,
+            )
+        });
+
+        // The shared fused-statistics kernel on its own: one pass plus an
+        // O(n) median.
+        group.bench_function("summary_stats", |b| {
+            b.iter(|| {
+                let mut stats = SummaryStats::with_median(f.trends_rows.len());
+                for row in &f.trends_rows {
+                    stats.push(black_box(row.priority));
+                }
+                (stats.std_dev(), stats.median())
+            })
+        });
+
+        group.bench_function("validate_blocks", |b| {
+            b.iter(|| validate_blocks(black_box(&f.validation_rows)))
+        });
+
+        group.throughput(Throughput::Bytes(f.native_json.len() as u64));
+        group.bench_function("parse_schedule_json", |b| {
+            b.iter(|| parse_schedule_json_str(black_box(&f.native_json)).unwrap())
+        });
+
+        group.finish();
+    }
+}
+
+fn bench_fixture(c: &mut Criterion) {
+    let mut group = c.benchmark_group("fixture");
+    group.sample_size(10);
+
+    group.bench_function("parse_example_schedule", |b| {
+        b.iter(|| parse_schedule_json_str(black_box(FIXTURE)).unwrap())
+    });
+
+    // Per-block siderust visibility search (the import fallback path).
+    let schedule = parse_schedule_json_str(FIXTURE).unwrap();
+    for block in &schedule.blocks {
+        let input = VisibilityInput {
+            location: &schedule.geographic_location,
+            schedule_period: &schedule.schedule_period,
+            target_ra: block.target_ra,
+            target_dec: block.target_dec,
+            constraints: &block.constraints,
+            min_duration: block.min_observation,
+            astronomical_nights: Some(&schedule.astronomical_nights),
+        };
+        group.bench_with_input(
+            BenchmarkId::new("block_visibility", &block.original_block_id),
+            &input,
+            |b, input| b.iter(|| compute_block_visibility(input)),
+        );
+    }
+
+    group.finish();
+}
+
+criterion_group!(benches, bench_services, bench_fixture);
+criterion_main!(benches);
@@ -6,7 +6,6 @@
 pub use crate::routes::algorithm_trace::{
     AlgorithmTraceIteration, AlgorithmTraceResponse, AlgorithmTraceSummary, ScheduleMetadata,
 };
-pub use crate::routes::altaz::AltAzCurve;
 pub use crate::routes::altaz::AltAzData;
 pub use crate::routes::altaz::AltAzObservatoryRequest;
 pub use crate::routes::altaz::AltAzRequest;
@@ -23,6 +22,8 @@ pub use crate::routes::compare::RetimedBlockChange;
 pub use crate::routes::compare::SchedulingChange;
 pub use crate::routes::distribution::DistributionBlock;
 pub use crate::routes::distribution::DistributionData;
+pub use crate::routes::distribution::DistributionHistogram;
+pub use crate::routes::distribution::DistributionHistograms;
 pub use crate::routes::distribution::DistributionStats;
 pub use crate::routes::fragmentation::{
     FragmentationData, FragmentationGap, FragmentationMetrics, FragmentationSegment,
@@ -37,9 +38,13 @@ pub use crate::routes::insights::TopObservation;
 pub use crate::routes::landing::ScheduleInfo;
 pub use crate::routes::skymap::LightweightBlock;
 pub use crate::routes::skymap::PriorityBinInfo;
+pub use crate::routes::skymap::SkyDensityCell;
 pub use crate::routes::skymap::SkyMapData;
+pub use crate::routes::skymap::SkyMapDensity;
 pub use crate::routes::timeline::ScheduleTimelineBlock;
 pub use crate::routes::timeline::ScheduleTimelineData;
+pub use crate::routes::timeline::TimelineLayout;
+pub use crate::routes::timeline::TIMELINE_COLOR_BINS;
 pub use crate::routes::trends::EmpiricalRatePoint;
 pub use crate::routes::trends::HeatmapBin;
 pub use crate::routes::trends::SmoothedPoint;
@@ -48,7 +53,12 @@ pub use crate::routes::trends::TrendsData;
 pub use crate::routes::trends::TrendsMetrics;
 pub use crate::routes::validation::ValidationIssue;
 pub use crate::routes::validation::ValidationReport;
+pub use crate::routes::visibility::SortDirection;
+pub use crate::routes::visibility::VisibilityBlockCursor;
+pub use crate::routes::visibility::VisibilityBlockSort;
 pub use crate::routes::visibility::VisibilityBlockSummary;
+pub use crate::routes::visibility::VisibilityBlocksPage;
+pub use crate::routes::visibility::VisibilityBlocksQuery;
 pub use crate::routes::visibility::VisibilityMapData;
 
 use serde::{Deserialize, Serialize};
@@ -0,0 +1,100 @@
+//! Synthetic schedule generator.
+//!
+//! Writes a deterministic schedule in the native TSI JSON format
+//! (`schemas/schedule.schema.json`) at an arbitrary scale, for load tests
+//! and manual profiling of large uploads.
+//!
+//! # Usage
+//!
+//! ```bash
+//! cargo run --release --bin tsi-generate-schedule -- \
+//!     --blocks 100000 --periods 8 --days 30 --seed 42 --output big.json
+//! ```
+//!
+//! # Options
+//!
+//! - `--blocks N`: number of scheduling blocks (default: 1000)
+//! - `--periods N`: visibility periods per block (default: 8)
+//! - `--days D`: schedule window length in days (default: 30)
+//! - `--start-mjd MJD`: schedule window start (default: 60694)
+//! - `--scheduled-fraction F`: fraction of scheduled blocks (default: 0.4)
+//! - `--seed S`: PRNG seed (default: 24301)
+//! - `--output PATH`: output file (default: stdout)
+//! - `--pretty`: pretty-print the JSON
+
+use std::env;
+use std::fs::File;
+use std::io::{self, BufWriter, Write};
+
+use anyhow::{bail, Context};
+
+use tsi_rust::models::synthetic::{
+    generate_schedule, schedule_to_native_json, SyntheticScheduleConfig,
+};
+
+fn parse_value<T: std::str::FromStr>(flag: &str, value: Option<String>) -> anyhow::Result<T> {
+    let value = value.with_context(|| format!("missing value for {}", flag))?;
+    value
+        .parse()
+        .map_err(|_| anyhow::anyhow!("invalid value for {}: {}", flag, value))
+}
+
+fn main() -> anyhow::Result<()> {
+    let mut config = SyntheticScheduleConfig::default();
+    let mut output: Option<String> = None;
+    let mut pretty = false;
+
+    let mut args = env::args().skip(1);
+    while let Some(flag) = args.next() {
+        match flag.as_str() {
+            "--blocks" => config.blocks = parse_value(&flag, args.next())?,
+            "--periods" => config.periods_per_block = parse_value(&flag, args.next())?,
+            "--days" => config.window_days = parse_value(&flag, args.next())?,
+            "--start-mjd" => config.start_mjd = parse_value(&flag, args.next())?,
+            "--scheduled-fraction" => config.scheduled_fraction = parse_value(&flag, args.next())?,
+            "--seed" => config.seed = parse_value(&flag, args.next())?,
+            "--output" => output = Some(parse_value(&flag, args.next())?),
+            "--pretty" => pretty = true,
+            "-h" | "--help" => {
+                eprintln!(
+                    "usage: tsi-generate-schedule [--blocks N] [--periods N] [--days D] \
+                     [--start-mjd MJD] [--scheduled-fraction F] [--seed S] \
+                     [--output PATH] [--pretty]"
+                );
+                return Ok(());
+            }
+            other => bail!("unknown argument: {}", other),
+        }
+    }
+
+    if !config.window_days.is_finite() || config.window_days <= 0.0 {
+        bail!("--days must be a positive, finite number");
+    }
+    if !(0.0..=1.0).contains(&config.scheduled_fraction) {
+        bail!("--scheduled-fraction must be within [0, 1]");
+    }
+
+    let schedule = generate_schedule(&config);
+    let json = schedule_to_native_json(&schedule);
+
+    let writer: Box<dyn Write> = match &output {
+        Some(path) => Box::new(File::create(path).with_context(|| format!("creating {}", path))?),
+        None => Box::new(io::stdout().lock()),
+    };
+    let mut writer = BufWriter::new(writer);
+    if pretty {
+        serde_json::to_writer_pretty(&mut writer, &json)?;
+    } else {
+        serde_json::to_writer(&mut writer, &json)?;
+    }
+    writeln!(writer)?;
+    writer.flush()?;
+
+    if let Some(path) = output {
+        eprintln!(
+            "wrote {} blocks x {} periods over {} days to {}",
+            config.blocks, config.periods_per_block, config.window_days, path
+        );
+    }
+    Ok(())
+}
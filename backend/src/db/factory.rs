@@ -11,6 +11,8 @@ use super::repo_config::RepositoryConfig;
 use super::repositories::LocalRepository;
 #[cfg(feature = "postgres-repo")]
 use super::repositories::PostgresRepository;
+#[cfg(feature = "sqlite-repo")]
+use super::repositories::{SqliteConfig, SqliteRepository};
 use super::repository::{FullRepository, RepositoryError, RepositoryResult};
 use super::PostgresConfig;
 
@@ -21,6 +23,8 @@ pub enum RepositoryType {
     Postgres,
     /// In-memory local repository
     Local,
+    /// Embedded single-file SQLite repository
+    Sqlite,
 }
 
 impl FromStr for RepositoryType {
@@ -29,7 +33,7 @@ impl FromStr for RepositoryType {
     /// Parse repository type from string.
     ///
     /// # Arguments
-    /// * `s` - String representation ("postgres", "local")
+    /// * `s` - String representation ("postgres", "local", "sqlite")
     ///
     /// # Returns
     /// * `Ok(RepositoryType)` if valid
@@ -38,6 +42,7 @@ impl FromStr for RepositoryType {
         match s.to_lowercase().as_str() {
             "postgres" | "pg" => Ok(Self::Postgres),
             "local" => Ok(Self::Local),
+            "sqlite" => Ok(Self::Sqlite),
             _ => Err(format!("Unknown repository type: {}", s)),
         }
     }
@@ -119,6 +124,7 @@ impl RepositoryFactory {
                 }
             }
             RepositoryType::Local => Ok(Self::create_local()),
+            RepositoryType::Sqlite => Self::create_sqlite_from_env(),
         }
     }
 
@@ -138,6 +144,38 @@ impl RepositoryFactory {
         Ok(Arc::new(repo))
     }
 
+    /// Create a SQLite repository, creating and migrating the database file.
+    ///
+    /// # Arguments
+    /// * `config` - SQLite configuration
+    ///
+    /// # Returns
+    /// * `Ok(Arc<SqliteRepository>)` - SQLite repository instance
+    /// * `Err(RepositoryError)` - If the database cannot be opened or migrated
+    #[cfg(feature = "sqlite-repo")]
+    pub fn create_sqlite(config: SqliteConfig) -> RepositoryResult<Arc<SqliteRepository>> {
+        Ok(Arc::new(SqliteRepository::new(config)?))
+    }
+
+    /// Create a SQLite repository configured from `SQLITE_*` environment variables.
+    ///
+    /// # Returns
+    /// * `Ok(Arc<dyn FullRepository>)` - SQLite repository instance
+    /// * `Err(RepositoryError)` - If creation fails or the feature is disabled
+    pub fn create_sqlite_from_env() -> RepositoryResult<Arc<dyn FullRepository>> {
+        #[cfg(feature = "sqlite-repo")]
+        {
+            let sqlite = Self::create_sqlite(SqliteConfig::from_env())?;
+            Ok(sqlite as Arc<dyn FullRepository>)
+        }
+        #[cfg(not(feature = "sqlite-repo"))]
+        {
+            Err(RepositoryError::ConfigurationError(
+                "SQLite repository feature not enabled".to_string(),
+            ))
+        }
+    }
+
     /// Create an in-memory local repository.
     ///
     /// # Returns
@@ -146,6 +184,38 @@ impl RepositoryFactory {
         Arc::new(LocalRepository::new())
     }
 
+    /// Create a local repository persisted to a data directory.
+    ///
+    /// # Arguments
+    /// * `data_dir` - Directory holding the snapshot and journal
+    /// * `snapshot_threshold_mb` - Optional journal size (MiB) that triggers a snapshot
+    ///
+    /// # Returns
+    /// * `Ok(Arc<dyn FullRepository>)` - Repository holding the persisted schedules
+    /// * `Err(RepositoryError)` - If the directory cannot be opened
+    pub fn create_local_persistent<P: AsRef<Path>>(
+        data_dir: P,
+        snapshot_threshold_mb: Option<u64>,
+    ) -> RepositoryResult<Arc<dyn FullRepository>> {
+        let mut repo = LocalRepository::open(data_dir)?;
+        if let Some(mb) = snapshot_threshold_mb {
+            repo = repo.with_snapshot_threshold(mb * 1024 * 1024);
+        }
+        Ok(Arc::new(repo))
+    }
+
+    /// Create a local repository, persisted to `LOCAL_DATA_DIR` if set.
+    ///
+    /// # Returns
+    /// * `Ok(Arc<dyn FullRepository>)` - Local repository instance
+    /// * `Err(RepositoryError)` - If the data directory cannot be opened
+    pub fn create_local_from_env() -> RepositoryResult<Arc<dyn FullRepository>> {
+        match std::env::var("LOCAL_DATA_DIR") {
+            Ok(dir) if !dir.is_empty() => Self::create_local_persistent(dir, None),
+            _ => Ok(Self::create_local()),
+        }
+    }
+
     /// Create repository from environment configuration.
     ///
     /// Reads `REPOSITORY_TYPE` environment variable to determine which
@@ -174,7 +244,8 @@ impl RepositoryFactory {
                     ))
                 }
             }
-            RepositoryType::Local => Ok(Self::create_local()),
+            RepositoryType::Local => Self::create_local_from_env(),
+            RepositoryType::Sqlite => Self::create_sqlite_from_env(),
         }
     }
 
@@ -240,7 +311,23 @@ impl RepositoryFactory {
                     ))
                 }
             }
-            RepositoryType::Local => Ok(Self::create_local()),
+            RepositoryType::Local => match &config.local.data_dir {
+                Some(dir) => Self::create_local_persistent(dir, config.local.snapshot_threshold_mb),
+                None => Ok(Self::create_local()),
+            },
+            RepositoryType::Sqlite => {
+                #[cfg(feature = "sqlite-repo")]
+                {
+                    let sqlite = Self::create_sqlite(config.to_sqlite_config())?;
+                    Ok(sqlite as Arc<dyn FullRepository>)
+                }
+                #[cfg(not(feature = "sqlite-repo"))]
+                {
+                    Err(RepositoryError::ConfigurationError(
+                        "SQLite repository feature not enabled".to_string(),
+                    ))
+                }
+            }
         }
     }
 }
@@ -433,6 +520,10 @@ mod tests {
             RepositoryType::from_str("Pg").unwrap(),
             RepositoryType::Postgres
         );
+        assert_eq!(
+            RepositoryType::from_str("SQLite").unwrap(),
+            RepositoryType::Sqlite
+        );
         assert!(RepositoryType::from_str("invalid").is_err());
     }
 
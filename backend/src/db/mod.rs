@@ -35,6 +35,7 @@
 //! - `repository`: Trait definition for database operations
 //! - `repositories::postgres`: Postgres implementation with Diesel ORM
 //! - `repositories::local`: In-memory implementation for unit testing and local development
+//! - `repositories::sqlite`: Embedded single-file implementation (feature `sqlite-repo`)
 //! - `factory`: Factory for creating repository instances
 //!
 //! # Recommended Usage
@@ -58,7 +59,11 @@
 
 // Feature flag priority: postgres > local
 // When multiple features are enabled (e.g., --all-features), postgres takes precedence.
-#[cfg(not(any(feature = "postgres-repo", feature = "local-repo")))]
+#[cfg(not(any(
+    feature = "postgres-repo",
+    feature = "local-repo",
+    feature = "sqlite-repo"
+)))]
 compile_error!("Enable at least one repository backend feature.");
 
 pub mod checksum;
@@ -102,6 +107,8 @@ pub use factory::{RepositoryBuilder, RepositoryFactory, RepositoryType};
 pub use repositories::LocalRepository;
 #[cfg(feature = "postgres-repo")]
 pub use repositories::PostgresRepository;
+#[cfg(feature = "sqlite-repo")]
+pub use repositories::{SqliteConfig, SqliteRepository};
 pub use repository::{
     AnalyticsRepository, ErrorContext, FullRepository, RepositoryError, RepositoryResult,
     ScheduleRepository, ValidationRepository, VisualizationRepository,
@@ -11,6 +11,8 @@ use std::str::FromStr;
 use super::factory::RepositoryType;
 use super::repository::RepositoryError;
 use crate::db::PostgresConfig;
+#[cfg(feature = "sqlite-repo")]
+use crate::db::SqliteConfig;
 
 /// Repository configuration from file.
 #[derive(Debug, Clone, Serialize, Deserialize)]
@@ -18,6 +20,10 @@ pub struct RepositoryConfig {
     pub repository: RepositorySettings,
     #[serde(default)]
     pub postgres: PostgresSettings,
+    #[serde(default)]
+    pub local: LocalSettings,
+    #[serde(default)]
+    pub sqlite: SqliteSettings,
 }
 
 /// Repository type settings.
@@ -46,6 +52,31 @@ pub struct PostgresSettings {
     pub retry_delay_ms: u64,
 }
 
+/// Local repository settings.
+#[derive(Debug, Clone, Default, Serialize, Deserialize)]
+pub struct LocalSettings {
+    /// Directory schedules are persisted to; in-memory only when unset.
+    #[serde(default)]
+    pub data_dir: Option<PathBuf>,
+    /// Journal size in MiB past which a new snapshot is written.
+    #[serde(default)]
+    pub snapshot_threshold_mb: Option<u64>,
+}
+
+/// SQLite repository settings; unset values use the `SqliteConfig` defaults.
+#[derive(Debug, Clone, Default, Serialize, Deserialize)]
+pub struct SqliteSettings {
+    /// Database file, created if missing.
+    #[serde(default)]
+    pub path: Option<PathBuf>,
+    /// Number of read-only connections.
+    #[serde(default)]
+    pub read_connections: Option<usize>,
+    /// Lock wait in milliseconds.
+    #[serde(default)]
+    pub busy_timeout_ms: Option<u64>,
+}
+
 fn default_max_connections() -> u32 {
     8
 }
@@ -150,6 +181,7 @@ impl RepositoryConfig {
             idle_timeout_sec: self.postgres.idle_timeout,
             max_retries: self.postgres.max_retries,
             retry_delay_ms: self.postgres.retry_delay_ms,
+            bulk_copy: true,
         }))
     }
 
@@ -168,6 +200,22 @@ impl RepositoryConfig {
 
         Ok(None)
     }
+
+    /// Convert the `[sqlite]` settings to a SqliteConfig.
+    #[cfg(feature = "sqlite-repo")]
+    pub fn to_sqlite_config(&self) -> SqliteConfig {
+        let mut config = SqliteConfig::default();
+        if let Some(path) = &self.sqlite.path {
+            config.path = path.clone();
+        }
+        if let Some(read_connections) = self.sqlite.read_connections {
+            config.read_connections = read_connections;
+        }
+        if let Some(busy_timeout_ms) = self.sqlite.busy_timeout_ms {
+            config.busy_timeout_ms = busy_timeout_ms;
+        }
+        config
+    }
 }
 
 #[cfg(test)]
@@ -184,6 +232,47 @@ type = "local"
         let config: RepositoryConfig = toml::from_str(toml).unwrap();
         assert_eq!(config.repository.repo_type, "local");
         assert_eq!(config.repository_type().unwrap(), RepositoryType::Local);
+        assert!(config.local.data_dir.is_none());
+    }
+
+    #[test]
+    fn test_parse_persistent_local_config() {
+        let toml = r#"
+[repository]
+type = "local"
+
+[local]
+data_dir = "/var/lib/tsi"
+snapshot_threshold_mb = 64
+"#;
+
+        let config: RepositoryConfig = toml::from_str(toml).unwrap();
+        assert_eq!(
+            config.local.data_dir.as_deref(),
+            Some(Path::new("/var/lib/tsi"))
+        );
+        assert_eq!(config.local.snapshot_threshold_mb, Some(64));
+    }
+
+    #[cfg(feature = "sqlite-repo")]
+    #[test]
+    fn test_parse_sqlite_config() {
+        let toml = r#"
+[repository]
+type = "sqlite"
+
+[sqlite]
+path = "/tmp/tsi.sqlite3"
+read_connections = 2
+"#;
+
+        let config: RepositoryConfig = toml::from_str(toml).unwrap();
+        assert_eq!(config.repository_type().unwrap(), RepositoryType::Sqlite);
+
+        let sqlite_config = config.to_sqlite_config();
+        assert_eq!(sqlite_config.path, Path::new("/tmp/tsi.sqlite3"));
+        assert_eq!(sqlite_config.read_connections, 2);
+        assert_eq!(sqlite_config.busy_timeout_ms, 5000);
     }
 
     #[cfg(feature = "postgres-repo")]
@@ -3,17 +3,27 @@
 //! This module provides a local implementation of all repository traits
 //! suitable for unit testing and local development. All data is stored in memory using HashMap and Vec
 //! structures, providing fast, deterministic, and isolated execution.
+//!
+//! [`LocalRepository::open`] additionally persists schedules to a data
+//! directory, for deployments without Postgres.
 
 use async_trait::async_trait;
-use std::collections::HashMap;
+use std::collections::{BTreeMap, HashMap};
+use std::path::Path;
+use std::sync::atomic::{AtomicBool, Ordering};
 use std::sync::{Arc, RwLock};
 
+use super::local_store::{
+    JournalRecord, ScheduleHeader, SnapshotCut, SnapshotImage, Store, StoredSchedule,
+};
+
 use crate::api::{Period, ScheduleId};
 use crate::db::{
     models::{InsightsBlock, Schedule, SchedulingBlock},
     repository::*,
 };
 use crate::services::validation::ValidationResult;
+use crate::services::visibility_blocks::VisibilityBlockIndex;
 
 /// In-memory local repository.
 ///
@@ -38,13 +48,147 @@ use crate::services::validation::ValidationResult;
 #[derive(Clone, Debug)]
 pub struct LocalRepository {
     data: Arc<RwLock<LocalData>>,
+    /// Kept outside `data` so schedule reads never take the global lock.
+    schedules: Arc<ScheduleShards>,
+    healthy: Arc<AtomicBool>,
+    /// Data directory of a persistent repository, locked after `data`.
+    store: Option<Arc<parking_lot::Mutex<Store>>>,
+    /// Held while a snapshot is written and installed, before `data`.
+    snapshot_writer: Arc<parking_lot::Mutex<()>>,
+    /// Random per-instance prefix of schedule versions: ids and version
+    /// counters start over in a new instance.
+    instance: u64,
+}
+
+/// Number of independently locked [`ScheduleShards`] shards.
+const SCHEDULE_SHARDS: usize = 16;
+
+/// Stored schedules, split over independently locked shards.
+///
+/// Schedules are immutable once stored and shared as `Arc`s: a read holds
+/// one shard's lock only long enough to copy the pointer, so concurrent
+/// readers neither queue on a single lock nor clone schedule data. An
+/// update swaps in a new `Arc`; readers still holding the old one keep a
+/// consistent snapshot. Schedules loaded from a snapshot are decoded on
+/// their first read.
+#[derive(Debug)]
+struct ScheduleShards {
+    shards: Vec<parking_lot::RwLock<HashMap<i64, StoredSchedule>>>,
+}
+
+impl Default for ScheduleShards {
+    fn default() -> Self {
+        Self {
+            shards: (0..SCHEDULE_SHARDS).map(|_| Default::default()).collect(),
+        }
+    }
+}
+
+impl ScheduleShards {
+    fn shard(&self, schedule_id: i64) -> &parking_lot::RwLock<HashMap<i64, StoredSchedule>> {
+        &self.shards[schedule_id.rem_euclid(SCHEDULE_SHARDS as i64) as usize]
+    }
+
+    fn get(&self, schedule_id: i64) -> RepositoryResult<Option<Arc<Schedule>>> {
+        let stored = match self.shard(schedule_id).read().get(&schedule_id) {
+            None => return Ok(None),
+            Some(StoredSchedule::Loaded(schedule)) => return Ok(Some(schedule.clone())),
+            Some(stored) => stored.clone(),
+        };
+
+        // Decoded outside the lock; if another reader got there first, its
+        // copy wins.
+        let decoded = stored.decode()?;
+        let mut shard = self.shard(schedule_id).write();
+        Ok(shard.get_mut(&schedule_id).map(|entry| match *entry {
+            StoredSchedule::Loaded(ref schedule) => schedule.clone(),
+            StoredSchedule::OnDisk { .. } => {
+                *entry = StoredSchedule::Loaded(decoded.clone());
+                decoded
+            }
+        }))
+    }
+
+    fn contains(&self, schedule_id: i64) -> bool {
+        self.shard(schedule_id).read().contains_key(&schedule_id)
+    }
+
+    fn insert(&self, schedule_id: i64, schedule: StoredSchedule) {
+        self.shard(schedule_id)
+            .write()
+            .insert(schedule_id, schedule);
+    }
+
+    fn remove(&self, schedule_id: i64) -> Option<StoredSchedule> {
+        self.shard(schedule_id).write().remove(&schedule_id)
+    }
+
+    /// Apply `f` to a schedule, copying it first if readers still share it.
+    /// Returns the updated schedule, or `None` if it does not exist.
+    fn update(
+        &self,
+        schedule_id: i64,
+        f: impl FnOnce(&mut Schedule),
+    ) -> RepositoryResult<Option<Arc<Schedule>>> {
+        if self.get(schedule_id)?.is_none() {
+            return Ok(None);
+        }
+        let mut shard = self.shard(schedule_id).write();
+        let Some(StoredSchedule::Loaded(schedule)) = shard.get_mut(&schedule_id) else {
+            return Ok(None);
+        };
+        f(Arc::make_mut(schedule));
+        Ok(Some(schedule.clone()))
+    }
+
+    /// Point schedules still on disk at `image`, which holds them at the
+    /// ranges in `index`, so the snapshot they were read from is released.
+    fn repoint(&self, image: &Arc<SnapshotImage>, index: &[(i64, std::ops::Range<usize>)]) {
+        for (schedule_id, range) in index {
+            let mut shard = self.shard(*schedule_id).write();
+            if let Some(StoredSchedule::OnDisk {
+                image: old_image,
+                range: old_range,
+            }) = shard.get_mut(schedule_id)
+            {
+                *old_image = image.clone();
+                *old_range = range.clone();
+            }
+        }
+    }
+
+    /// Every stored schedule, ordered by id, without decoding any.
+    fn entries(&self) -> Vec<(i64, StoredSchedule)> {
+        let mut entries: Vec<_> = self
+            .shards
+            .iter()
+            .flat_map(|shard| {
+                let shard = shard.read();
+                shard
+                    .iter()
+                    .map(|(id, stored)| (*id, stored.clone()))
+                    .collect::<Vec<_>>()
+            })
+            .collect();
+        entries.sort_by_key(|(id, _)| *id);
+        entries
+    }
+
+    fn len(&self) -> usize {
+        self.shards.iter().map(|shard| shard.read().len()).sum()
+    }
+
+    fn clear(&self) {
+        self.shards.iter().for_each(|shard| shard.write().clear());
+    }
 }
 
 #[derive(Default, Debug)]
 struct LocalData {
-    schedules: HashMap<i64, Schedule>,
     schedule_metadata: HashMap<i64, crate::api::ScheduleInfo>,
-    blocks: HashMap<i64, SchedulingBlock>,
+    /// First block id -> (schedule id, block count). A schedule's blocks
+    /// are numbered consecutively, so one entry locates all of them.
+    block_ranges: BTreeMap<i64, (i64, usize)>,
     possible_periods: HashMap<i64, Vec<Period>>,
 
     // Analytics data
@@ -68,13 +212,36 @@ struct LocalData {
     preschedule: HashMap<i64, serde_json::Value>,
     schedule_environment: HashMap<i64, i64>, // schedule_id -> env_id
 
+    // Presorted visibility-map block indexes, built on first page request
+    visibility_indexes: HashMap<i64, Arc<VisibilityBlockIndex>>,
+
+    // Per-schedule count of writes to derived data (see `schedule_version`)
+    schedule_versions: HashMap<i64, u64>,
+
     // ID counters
     next_schedule_id: i64,
     next_block_id: i64,
     next_environment_id: i64,
+}
+
+/// Unpredictable per-instance token: `RandomState` is randomly keyed per
+/// process, and the clock separates instances created within one.
+fn instance_token() -> u64 {
+    use std::hash::{BuildHasher, Hasher};
+    let mut hasher = std::collections::hash_map::RandomState::new().build_hasher();
+    let nanos = std::time::SystemTime::now()
+        .duration_since(std::time::UNIX_EPOCH)
+        .map(|d| d.as_nanos())
+        .unwrap_or_default();
+    hasher.write_u128(nanos);
+    hasher.finish()
+}
 
-    // Connection health
-    is_healthy: bool,
+impl LocalData {
+    /// Record a write to data derived from `schedule_id`.
+    fn bump_version(&mut self, schedule_id: i64) {
+        *self.schedule_versions.entry(schedule_id).or_default() += 1;
+    }
 }
 
 impl LocalRepository {
@@ -82,12 +249,145 @@ impl LocalRepository {
     pub fn new() -> Self {
         Self {
             data: Arc::new(RwLock::new(LocalData {
-                is_healthy: true,
                 next_schedule_id: 1,
                 next_block_id: 1,
                 next_environment_id: 1,
                 ..Default::default()
             })),
+            schedules: Arc::new(ScheduleShards::default()),
+            healthy: Arc::new(AtomicBool::new(true)),
+            store: None,
+            snapshot_writer: Arc::default(),
+            instance: instance_token(),
+        }
+    }
+
+    /// Open a persistent local repository backed by the directory `dir`.
+    ///
+    /// Schedules, their deletion and metadata updates are journaled to
+    /// `dir` and restored on the next open. Schedules in the snapshot are
+    /// listed immediately and decoded on first read. Analytics and
+    /// validation results are recomputed on demand; environments and
+    /// algorithm traces are kept in memory only.
+    ///
+    /// # Arguments
+    /// * `dir` - Data directory, created if missing
+    ///
+    /// # Returns
+    /// * `Ok(LocalRepository)` - Repository holding the persisted schedules
+    /// * `Err(RepositoryError)` - If the directory cannot be read or is corrupt
+    pub fn open(dir: impl AsRef<Path>) -> RepositoryResult<Self> {
+        let (store, recovered) = Store::open(dir.as_ref())?;
+        let mut repo = Self::new();
+        {
+            let mut data = repo.data.write().unwrap();
+            data.next_schedule_id = recovered.next_schedule_id;
+            data.next_block_id = recovered.next_block_id;
+            for (header, stored) in recovered.schedules {
+                repo.insert_schedule(&mut data, header, stored);
+            }
+            for record in recovered.journal {
+                repo.replay(&mut data, record);
+            }
+        }
+        repo.store = Some(Arc::new(parking_lot::Mutex::new(store)));
+        Ok(repo)
+    }
+
+    /// Set the journal size, in bytes, past which a persistent repository
+    /// folds its journal into a new snapshot. No effect on an in-memory one.
+    pub fn with_snapshot_threshold(self, bytes: u64) -> Self {
+        if let Some(store) = &self.store {
+            store.lock().snapshot_threshold = bytes;
+        }
+        self
+    }
+
+    /// Write a snapshot of every schedule and empty the journal.
+    /// No effect on an in-memory repository.
+    pub fn snapshot(&self) -> RepositoryResult<()> {
+        let Some(store) = &self.store else {
+            return Ok(());
+        };
+        let _writer = self.snapshot_writer.lock();
+        let cut = {
+            let data = self.data.read().unwrap();
+            self.cut(&data, &store.lock())
+        };
+        self.write_snapshot(store, &cut)
+    }
+
+    fn cut(&self, data: &LocalData, store: &Store) -> SnapshotCut {
+        store.cut(
+            data.next_schedule_id,
+            data.next_block_id,
+            self.schedules.entries(),
+        )
+    }
+
+    /// Write and install `cut`, then repoint schedules still on disk so the
+    /// replaced snapshot is unmapped. Called holding `snapshot_writer`.
+    fn write_snapshot(
+        &self,
+        store: &parking_lot::Mutex<Store>,
+        cut: &SnapshotCut,
+    ) -> RepositoryResult<()> {
+        let index = cut.write()?;
+        let installed = store.lock().install_snapshot(cut)?;
+        if let Some(image) = installed {
+            self.schedules.repoint(&image, &index);
+        }
+        Ok(())
+    }
+
+    /// Journal a mutation through `record`, before it is applied in memory.
+    fn persist(
+        &self,
+        record: impl FnOnce(&mut Store) -> RepositoryResult<()>,
+    ) -> RepositoryResult<()> {
+        match &self.store {
+            Some(store) => record(&mut store.lock()),
+            None => Ok(()),
+        }
+    }
+
+    /// Fold the journal into a new snapshot once it has outgrown the
+    /// threshold. Called after a journaled mutation has been applied, with
+    /// `data` still locked; the snapshot is written on a background thread
+    /// so neither readers nor further mutations wait for it.
+    fn snapshot_if_due(&self, data: &LocalData) {
+        let Some(store) = &self.store else {
+            return;
+        };
+        let cut = {
+            let mut store = store.lock();
+            if !store.needs_snapshot() {
+                return;
+            }
+            store.snapshot_pending = true;
+            self.cut(data, &store)
+        };
+
+        let repo = self.clone();
+        let spawned = std::thread::Builder::new()
+            .name("tsi-local-snapshot".to_string())
+            .spawn(move || {
+                let Some(store) = &repo.store else {
+                    return;
+                };
+                let written = {
+                    let _writer = repo.snapshot_writer.lock();
+                    repo.write_snapshot(store, &cut)
+                };
+                // The journal still holds everything the snapshot missed.
+                if let Err(e) = written {
+                    log::warn!("Local repository snapshot failed: {}", e);
+                }
+                store.lock().snapshot_pending = false;
+            });
+        if let Err(e) = spawned {
+            log::warn!("Failed to start local repository snapshot: {}", e);
+            store.lock().snapshot_pending = false;
         }
     }
 
@@ -101,74 +401,189 @@ impl LocalRepository {
     ///
     /// # Returns
     /// The ID assigned to the schedule
-    pub fn store_schedule_impl(&self, mut schedule: Schedule) -> ScheduleId {
+    ///
+    /// # Panics
+    /// If a persistent repository cannot journal the schedule; use
+    /// [`ScheduleRepository::store_schedule`] to handle that error.
+    pub fn store_schedule_impl(&self, schedule: Schedule) -> ScheduleId {
+        self.try_store_schedule(schedule)
+            .expect("failed to journal schedule")
+    }
+
+    fn try_store_schedule(&self, mut schedule: Schedule) -> RepositoryResult<ScheduleId> {
         let mut data = self.data.write().unwrap();
         let schedule_id = ScheduleId(data.next_schedule_id);
         data.next_schedule_id += 1;
 
-        // Assign IDs to blocks and store them in the global blocks map.
-        for block in &mut schedule.blocks {
-            let block_id = data.next_block_id;
+        // Set the DB-assigned IDs on the blocks so later code that expects
+        // `block.id` to be present (e.g. analytics/visualization helpers)
+        // won't panic with `DB Block ID missing`.
+        for block in schedule.blocks.iter_mut() {
+            block.id = Some(crate::api::SchedulingBlockId(data.next_block_id));
             data.next_block_id += 1;
+        }
 
-            // Set the DB-assigned ID on the block so later code that expects
-            // `block.id` to be present (e.g. analytics/visualization helpers)
-            // won't panic with `DB Block ID missing`.
-            block.id = Some(crate::api::SchedulingBlockId(block_id));
+        self.persist(|store| store.log_store(schedule_id.0, &schedule))?;
+        let header = ScheduleHeader::of(schedule_id.0, &schedule);
+        self.insert_schedule(
+            &mut data,
+            header,
+            StoredSchedule::Loaded(Arc::new(schedule)),
+        );
+        self.snapshot_if_due(&data);
 
-            data.blocks.insert(block_id, block.clone());
+        Ok(schedule_id)
+    }
+
+    /// Make a stored schedule readable and listed.
+    fn insert_schedule(
+        &self,
+        data: &mut LocalData,
+        header: ScheduleHeader,
+        stored: StoredSchedule,
+    ) {
+        let schedule_id = header.schedule_id;
+        if header.block_count > 0 {
+            data.block_ranges
+                .insert(header.first_block_id, (schedule_id, header.block_count));
         }
+        data.next_schedule_id = data.next_schedule_id.max(schedule_id + 1);
+        data.next_block_id = data
+            .next_block_id
+            .max(header.first_block_id + header.block_count as i64);
 
         let metadata = crate::api::ScheduleInfo {
-            schedule_id,
-            schedule_name: schedule.name.clone(),
-            observer_location: schedule.geographic_location,
-            schedule_period: schedule.schedule_period,
-            environment_id: data.schedule_environment.get(&schedule_id.0).copied(),
+            schedule_id: ScheduleId(schedule_id),
+            schedule_name: header.name,
+            observer_location: header.geographic_location,
+            schedule_period: header.schedule_period,
+            environment_id: data.schedule_environment.get(&schedule_id).copied(),
         };
 
-        data.schedule_metadata.insert(schedule_id.0, metadata);
-        data.schedules.insert(schedule_id.0, schedule);
+        // Readable before it is listed.
+        self.schedules.insert(schedule_id, stored);
+        data.schedule_metadata.insert(schedule_id, metadata);
+    }
+
+    /// Remove a schedule and everything derived from it.
+    /// Returns whether it existed.
+    fn remove_schedule(&self, data: &mut LocalData, schedule_id: i64) -> bool {
+        // Unlisted before it stops being readable.
+        data.schedule_metadata.remove(&schedule_id);
+        if self.schedules.remove(schedule_id).is_none() {
+            return false;
+        }
+        data.analytics_exists.remove(&schedule_id);
+        data.validation_results.remove(&schedule_id);
+        data.possible_periods.remove(&schedule_id);
+        data.schedule_environment.remove(&schedule_id);
+        data.visibility_indexes.remove(&schedule_id);
+        data.schedule_versions.remove(&schedule_id);
+        data.block_ranges
+            .retain(|_, (owner, _)| *owner != schedule_id);
+        true
+    }
+
+    fn apply_metadata_update(
+        &self,
+        data: &mut LocalData,
+        schedule_id: ScheduleId,
+        new_name: Option<String>,
+        new_location: Option<crate::api::GeographicLocation>,
+    ) -> RepositoryResult<crate::api::ScheduleInfo> {
+        let updated = self
+            .schedules
+            .update(schedule_id.0, |schedule| {
+                if let Some(ref name) = new_name {
+                    schedule.name = name.clone();
+                }
+                if let Some(location) = new_location {
+                    schedule.geographic_location = location;
+                }
+            })?
+            .ok_or_else(|| {
+                RepositoryError::NotFound(format!("Schedule {} not found", schedule_id))
+            })?;
+
+        data.bump_version(schedule_id.0);
+
+        // Update metadata
+        if let Some(meta) = data.schedule_metadata.get_mut(&schedule_id.0) {
+            if let Some(name) = new_name {
+                meta.schedule_name = name;
+            }
+            meta.observer_location = updated.geographic_location;
+        }
+
+        let meta = data.schedule_metadata.get(&schedule_id.0).cloned().unwrap();
+        Ok(meta)
+    }
 
-        schedule_id
+    /// Apply a journaled mutation while opening.
+    fn replay(&self, data: &mut LocalData, record: JournalRecord) {
+        match record {
+            JournalRecord::Store(header, schedule) => {
+                self.insert_schedule(data, header, StoredSchedule::Loaded(Arc::new(schedule)))
+            }
+            JournalRecord::Delete(schedule_id) => {
+                self.remove_schedule(data, schedule_id);
+            }
+            JournalRecord::UpdateMetadata {
+                schedule_id,
+                name,
+                location,
+            } => {
+                if let Err(e) =
+                    self.apply_metadata_update(data, ScheduleId(schedule_id), name, location)
+                {
+                    log::warn!(
+                        "Skipping journaled update of schedule {}: {}",
+                        schedule_id,
+                        e
+                    );
+                }
+            }
+        }
     }
 
     /// Set the health status for testing connection failures.
     pub fn set_healthy(&self, healthy: bool) {
-        let mut data = self.data.write().unwrap();
-        data.is_healthy = healthy;
+        self.healthy.store(healthy, Ordering::Relaxed);
     }
 
-    /// Clear all data from the repository.
+    /// Clear all data from the repository, including a persistent
+    /// repository's data directory.
     pub fn clear(&self) {
+        let _writer = self.snapshot_writer.lock();
         let mut data = self.data.write().unwrap();
+        self.schedules.clear();
         *data = LocalData {
-            is_healthy: data.is_healthy,
             next_schedule_id: 1,
             next_block_id: 1,
             next_environment_id: 1,
             ..Default::default()
         };
+        if let Some(store) = &self.store {
+            let cut = self.cut(&data, &store.lock());
+            if let Err(e) = self.write_snapshot(store, &cut) {
+                log::warn!("Failed to clear local repository data directory: {}", e);
+            }
+        }
     }
 
     /// Get the number of schedules stored.
     pub fn schedule_count(&self) -> usize {
-        self.data.read().unwrap().schedules.len()
+        self.schedules.len()
     }
 
     /// Check if a schedule exists.
     pub fn has_schedule(&self, schedule_id: ScheduleId) -> bool {
-        self.data
-            .read()
-            .unwrap()
-            .schedules
-            .contains_key(&schedule_id.0)
+        self.schedules.contains(schedule_id.0)
     }
 
     /// Helper to check health and return error if unhealthy.
     fn check_health(&self) -> RepositoryResult<()> {
-        let data = self.data.read().unwrap();
-        if !data.is_healthy {
+        if !self.healthy.load(Ordering::Relaxed) {
             return Err(RepositoryError::ConnectionError(
                 "Database is not healthy".to_string(),
             ));
@@ -176,12 +591,10 @@ impl LocalRepository {
         Ok(())
     }
 
-    /// Helper to get a schedule or return NotFound error.
-    fn get_schedule_impl(&self, schedule_id: ScheduleId) -> RepositoryResult<Schedule> {
-        let data = self.data.read().unwrap();
-        data.schedules
-            .get(&schedule_id.0)
-            .cloned()
+    /// Helper to get a shared schedule or return NotFound error.
+    fn get_schedule_impl(&self, schedule_id: ScheduleId) -> RepositoryResult<Arc<Schedule>> {
+        self.schedules
+            .get(schedule_id.0)?
             .ok_or_else(|| RepositoryError::NotFound(format!("Schedule {} not found", schedule_id)))
     }
 
@@ -194,6 +607,7 @@ impl LocalRepository {
         let mut data = self.data.write().unwrap();
         let existed = map_accessor(&mut data).remove(&schedule_id.0).is_some();
         if existed {
+            data.bump_version(schedule_id.0);
             1
         } else {
             0
@@ -207,11 +621,25 @@ impl Default for LocalRepository {
     }
 }
 
+fn visibility_block_summaries(schedule: &Schedule) -> Vec<crate::api::VisibilityBlockSummary> {
+    schedule
+        .blocks
+        .iter()
+        .map(|b| crate::api::VisibilityBlockSummary {
+            scheduling_block_id: b.id.expect("DB Block ID missing").0,
+            original_block_id: b.original_block_id.clone(),
+            block_name: b.block_name.clone(),
+            priority: b.priority,
+            num_visibility_periods: b.visibility_periods.len(),
+            scheduled: b.scheduled_period.is_some(),
+        })
+        .collect()
+}
+
 #[async_trait]
 impl ScheduleRepository for LocalRepository {
     async fn health_check(&self) -> RepositoryResult<bool> {
-        let data = self.data.read().unwrap();
-        Ok(data.is_healthy)
+        Ok(self.healthy.load(Ordering::Relaxed))
     }
 
     async fn store_schedule(
@@ -220,8 +648,7 @@ impl ScheduleRepository for LocalRepository {
     ) -> RepositoryResult<crate::api::ScheduleInfo> {
         self.check_health()?;
 
-        // Use the helper method to add the schedule
-        let schedule_id = self.store_schedule_impl(schedule.clone());
+        let schedule_id = self.try_store_schedule(schedule.clone())?;
 
         // Retrieve and return the metadata
         let data = self.data.read().unwrap();
@@ -231,6 +658,15 @@ impl ScheduleRepository for LocalRepository {
     }
 
     async fn get_schedule(&self, schedule_id: ScheduleId) -> RepositoryResult<Schedule> {
+        self.check_health()?;
+        self.get_schedule_impl(schedule_id)
+            .map(|schedule| Schedule::clone(&schedule))
+    }
+
+    async fn get_schedule_shared(
+        &self,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<Arc<Schedule>> {
         self.check_health()?;
         self.get_schedule_impl(schedule_id)
     }
@@ -291,25 +727,47 @@ impl ScheduleRepository for LocalRepository {
         &self,
         scheduling_block_id: i64,
     ) -> RepositoryResult<SchedulingBlock> {
-        let data = self.data.read().unwrap();
+        let location = self
+            .data
+            .read()
+            .unwrap()
+            .block_ranges
+            .range(..=scheduling_block_id)
+            .next_back()
+            .and_then(|(&first_block_id, &(schedule_id, block_count))| {
+                let row = (scheduling_block_id - first_block_id) as usize;
+                (row < block_count).then_some((schedule_id, row))
+            });
 
-        data.blocks
-            .get(&scheduling_block_id)
-            .cloned()
-            .ok_or_else(|| {
-                RepositoryError::NotFound(format!(
-                    "Scheduling block {} not found",
-                    scheduling_block_id
-                ))
-            })
+        let block = match location {
+            Some((schedule_id, row)) => self
+                .schedules
+                .get(schedule_id)?
+                .and_then(|schedule| schedule.blocks.get(row).cloned()),
+            None => None,
+        };
+        block.ok_or_else(|| {
+            RepositoryError::NotFound(format!(
+                "Scheduling block {} not found",
+                scheduling_block_id
+            ))
+        })
     }
 
     async fn get_blocks_for_schedule(
         &self,
         schedule_id: ScheduleId,
     ) -> RepositoryResult<Vec<SchedulingBlock>> {
+        Ok(self.get_schedule_impl(schedule_id)?.blocks.clone())
+    }
+
+    async fn get_schedule_columns(
+        &self,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<crate::models::ScheduleColumns> {
+        self.check_health()?;
         let schedule = self.get_schedule_impl(schedule_id)?;
-        Ok(schedule.blocks.clone())
+        Ok(crate::models::ScheduleColumns::from_schedule(&schedule))
     }
 
     async fn fetch_dark_periods(&self, schedule_id: ScheduleId) -> RepositoryResult<Vec<Period>> {
@@ -334,22 +792,15 @@ impl ScheduleRepository for LocalRepository {
         self.check_health()?;
 
         let mut data = self.data.write().unwrap();
-        if data.schedules.remove(&schedule_id.0).is_none() {
+        if !self.schedules.contains(schedule_id.0) {
             return Err(RepositoryError::NotFound(format!(
                 "Schedule {} not found",
                 schedule_id
             )));
         }
-        data.schedule_metadata.remove(&schedule_id.0);
-        data.analytics_exists.remove(&schedule_id.0);
-        data.validation_results.remove(&schedule_id.0);
-        data.possible_periods.remove(&schedule_id.0);
-        data.schedule_environment.remove(&schedule_id.0);
-        // Remove blocks belonging to this schedule
-        let block_ids_to_remove: Vec<i64> = data.blocks.iter().map(|(&id, _)| id).collect();
-        // We can't easily filter by schedule_id in local repo for blocks,
-        // but schedule data itself is removed which is the important part
-        let _ = block_ids_to_remove;
+        self.persist(|store| store.log_delete(schedule_id.0))?;
+        self.remove_schedule(&mut data, schedule_id.0);
+        self.snapshot_if_due(&data);
         Ok(())
     }
 
@@ -362,36 +813,32 @@ impl ScheduleRepository for LocalRepository {
         self.check_health()?;
 
         let mut data = self.data.write().unwrap();
-
-        let schedule = data.schedules.get_mut(&schedule_id.0).ok_or_else(|| {
-            RepositoryError::NotFound(format!("Schedule {} not found", schedule_id))
+        if !self.schedules.contains(schedule_id.0) {
+            return Err(RepositoryError::NotFound(format!(
+                "Schedule {} not found",
+                schedule_id
+            )));
+        }
+        self.persist(|store| {
+            store.log_update_metadata(schedule_id.0, new_name.as_deref(), new_location.as_ref())
         })?;
+        let updated = self.apply_metadata_update(&mut data, schedule_id, new_name, new_location);
+        self.snapshot_if_due(&data);
+        updated
+    }
 
-        if let Some(ref name) = new_name {
-            schedule.name = name.clone();
-        }
-        if let Some(location) = new_location {
-            schedule.geographic_location = location;
+    async fn schedule_version(&self, schedule_id: ScheduleId) -> RepositoryResult<Option<String>> {
+        self.check_health()?;
+        let data = self.data.read().unwrap();
+        if !data.schedule_metadata.contains_key(&schedule_id.0) {
+            return Ok(None);
         }
-
-        // Capture updated values before splitting borrows
-        let updated_location = data
-            .schedules
+        let version = data
+            .schedule_versions
             .get(&schedule_id.0)
-            .map(|s| s.geographic_location);
-
-        // Update metadata
-        if let Some(meta) = data.schedule_metadata.get_mut(&schedule_id.0) {
-            if let Some(name) = new_name {
-                meta.schedule_name = name;
-            }
-            if let Some(loc) = updated_location {
-                meta.observer_location = loc;
-            }
-        }
-
-        let meta = data.schedule_metadata.get(&schedule_id.0).cloned().unwrap();
-        Ok(meta)
+            .copied()
+            .unwrap_or(0);
+        Ok(Some(format!("{:016x}.{}", self.instance, version)))
     }
 }
 
@@ -474,6 +921,7 @@ impl AnalyticsRepository for LocalRepository {
         // Mark analytics as populated
         let mut data = self.data.write().unwrap();
         data.analytics_exists.insert(schedule_id.0, true);
+        data.bump_version(schedule_id.0);
 
         // Return the number of blocks processed (not validation count)
         Ok(schedule.blocks.len())
@@ -738,6 +1186,7 @@ impl ValidationRepository for LocalRepository {
         };
 
         data.validation_results.insert(schedule_id.0, report);
+        data.bump_version(schedule_id.0);
         Ok(results.len())
     }
 
@@ -776,8 +1225,6 @@ impl VisualizationRepository for LocalRepository {
         &self,
         schedule_id: ScheduleId,
     ) -> RepositoryResult<crate::api::VisibilityMapData> {
-        use crate::api::VisibilityBlockSummary;
-
         let schedule = self.get_schedule_impl(schedule_id)?;
 
         if schedule.blocks.is_empty() {
@@ -790,19 +1237,7 @@ impl VisualizationRepository for LocalRepository {
             });
         }
 
-        // Convert schedule blocks to VisibilityBlockSummary
-        let blocks: Vec<VisibilityBlockSummary> = schedule
-            .blocks
-            .iter()
-            .map(|b| VisibilityBlockSummary {
-                scheduling_block_id: b.id.expect("DB Block ID missing").0,
-                original_block_id: b.original_block_id.clone(),
-                block_name: b.block_name.clone(),
-                priority: b.priority,
-                num_visibility_periods: b.visibility_periods.len(),
-                scheduled: b.scheduled_period.is_some(),
-            })
-            .collect();
+        let blocks = visibility_block_summaries(&schedule);
 
         // Compute statistics
         let priority_min = blocks
@@ -827,6 +1262,36 @@ impl VisualizationRepository for LocalRepository {
         })
     }
 
+    async fn fetch_visibility_blocks_page(
+        &self,
+        schedule_id: ScheduleId,
+        query: &crate::api::VisibilityBlocksQuery,
+    ) -> RepositoryResult<crate::api::VisibilityBlocksPage> {
+        let cached = self
+            .data
+            .read()
+            .unwrap()
+            .visibility_indexes
+            .get(&schedule_id.0)
+            .cloned();
+        let index = match cached {
+            Some(index) => index,
+            None => {
+                let schedule = self.get_schedule_impl(schedule_id)?;
+                let index = Arc::new(VisibilityBlockIndex::new(visibility_block_summaries(
+                    &schedule,
+                )));
+                self.data
+                    .write()
+                    .unwrap()
+                    .visibility_indexes
+                    .insert(schedule_id.0, index.clone());
+                index
+            }
+        };
+        Ok(index.page(query))
+    }
+
     async fn fetch_blocks_for_histogram(
         &self,
         schedule_id: ScheduleId,
@@ -981,9 +1446,7 @@ impl VisualizationRepository for LocalRepository {
         }
 
         // Collect scheduled periods from blocks
-        let schedule = data.schedules.get(&schedule_id.0).cloned().ok_or_else(|| {
-            RepositoryError::NotFound(format!("Schedule {} not found", schedule_id))
-        })?;
+        let schedule = self.get_schedule_impl(schedule_id)?;
 
         let mut periods: Vec<(f64, f64)> = schedule
             .blocks
@@ -1156,10 +1619,17 @@ impl crate::db::repository::EnvironmentRepository for LocalRepository {
             .retain(|_, &mut env_id| env_id != id);
 
         // Update schedule metadata to reflect unassignment
-        for (_, meta) in data.schedule_metadata.iter_mut() {
-            if meta.environment_id == Some(id) {
+        let unassigned: Vec<i64> = data
+            .schedule_metadata
+            .iter_mut()
+            .filter(|(_, meta)| meta.environment_id == Some(id))
+            .map(|(schedule_id, meta)| {
                 meta.environment_id = None;
-            }
+                *schedule_id
+            })
+            .collect();
+        for schedule_id in unassigned {
+            data.bump_version(schedule_id);
         }
 
         Ok(())
@@ -1215,7 +1685,7 @@ impl crate::db::repository::EnvironmentRepository for LocalRepository {
         let mut data = self.data.write().unwrap();
 
         // Check schedule exists
-        if !data.schedules.contains_key(&schedule_id.0) {
+        if !self.schedules.contains(schedule_id.0) {
             return Err(RepositoryError::not_found(format!(
                 "Schedule {} not found",
                 schedule_id
@@ -1229,6 +1699,7 @@ impl crate::db::repository::EnvironmentRepository for LocalRepository {
         if let Some(meta) = data.schedule_metadata.get_mut(&schedule_id.0) {
             meta.environment_id = Some(env_id);
         }
+        data.bump_version(schedule_id.0);
 
         Ok(())
     }
@@ -1244,6 +1715,7 @@ impl crate::db::repository::EnvironmentRepository for LocalRepository {
         if let Some(meta) = data.schedule_metadata.get_mut(&schedule_id.0) {
             meta.environment_id = None;
         }
+        data.bump_version(schedule_id.0);
 
         Ok(())
     }
@@ -1273,6 +1745,7 @@ impl crate::db::repository::AlgorithmTraceRepository for LocalRepository {
             schedule_id.0,
             (algorithm.to_string(), summary.clone(), iterations.clone()),
         );
+        data.bump_version(schedule_id.0);
         Ok(())
     }
 
@@ -1417,6 +1890,145 @@ mod tests {
         assert!(matches!(result, Err(RepositoryError::NotFound { .. })));
     }
 
+    #[tokio::test]
+    async fn test_shared_schedule_reads_and_snapshots() {
+        let repo = LocalRepository::new();
+        let block = SchedulingBlock::new(
+            "ob-1".to_string(),
+            "M31".to_string(),
+            Degrees::new(10.0),
+            Degrees::new(41.0),
+            crate::api::Constraints::new(
+                Degrees::new(30.0),
+                Degrees::new(90.0),
+                Degrees::new(0.0),
+                Degrees::new(360.0),
+                None,
+            ),
+            5.0,
+            600.0.into(),
+            3600.0.into(),
+            None,
+            None,
+            None,
+        );
+        let schedule_id = repo.store_schedule_impl(Schedule {
+            id: None,
+            name: "Shared".to_string(),
+            blocks: vec![block],
+            dark_periods: vec![],
+            geographic_location: Geodetic::<ECEF>::new(
+                Degrees::new(-17.8892),
+                Degrees::new(28.7624),
+                Meters::new(2396.0),
+            ),
+            astronomical_nights: vec![],
+            checksum: "shared".to_string(),
+            schedule_period: default_schedule_period(),
+        });
+
+        let first = repo.get_schedule_shared(schedule_id).await.unwrap();
+        let second = repo.get_schedule_shared(schedule_id).await.unwrap();
+        assert!(Arc::ptr_eq(&first, &second));
+
+        let block_id = first.blocks[0].id.unwrap().0;
+        let stored = repo.get_scheduling_block(block_id).await.unwrap();
+        assert_eq!(stored.original_block_id, "ob-1");
+
+        // Updates swap in a new schedule; earlier readers keep their snapshot.
+        repo.update_schedule_metadata(schedule_id, Some("Renamed".to_string()), None)
+            .await
+            .unwrap();
+        let renamed = repo.get_schedule_shared(schedule_id).await.unwrap();
+        assert_eq!(first.name, "Shared");
+        assert_eq!(renamed.name, "Renamed");
+
+        repo.delete_schedule(schedule_id).await.unwrap();
+        assert!(repo.get_scheduling_block(block_id).await.is_err());
+        assert_eq!(first.blocks.len(), 1);
+    }
+
+    #[tokio::test]
+    async fn test_persistent_repository_reopens() {
+        let dir = std::env::temp_dir().join(format!("tsi-local-repo-{}", std::process::id()));
+        let _ = std::fs::remove_dir_all(&dir);
+        let mk = |name: &str, blocks: usize| Schedule {
+            id: None,
+            name: name.to_string(),
+            blocks: (0..blocks)
+                .map(|i| {
+                    SchedulingBlock::new(
+                        format!("ob-{i}"),
+                        "M31".to_string(),
+                        Degrees::new(10.0),
+                        Degrees::new(41.0),
+                        crate::api::Constraints::new(
+                            Degrees::new(30.0),
+                            Degrees::new(90.0),
+                            Degrees::new(0.0),
+                            Degrees::new(360.0),
+                            None,
+                        ),
+                        5.0,
+                        600.0.into(),
+                        3600.0.into(),
+                        None,
+                        Some(vec![default_schedule_period()]),
+                        None,
+                    )
+                })
+                .collect(),
+            dark_periods: vec![],
+            geographic_location: Geodetic::<ECEF>::new(
+                Degrees::new(-17.8892),
+                Degrees::new(28.7624),
+                Meters::new(2396.0),
+            ),
+            astronomical_nights: vec![],
+            checksum: name.to_string(),
+            schedule_period: default_schedule_period(),
+        };
+
+        let (first, second, third) = {
+            let repo = LocalRepository::open(&dir).unwrap();
+            let first = repo.store_schedule(&mk("first", 2)).await.unwrap();
+            let second = repo.store_schedule(&mk("second", 1)).await.unwrap();
+            repo.snapshot().unwrap();
+            // Journaled on top of the snapshot.
+            let third = repo.store_schedule(&mk("third", 3)).await.unwrap();
+            repo.update_schedule_metadata(first.schedule_id, Some("renamed".to_string()), None)
+                .await
+                .unwrap();
+            repo.delete_schedule(second.schedule_id).await.unwrap();
+            (first.schedule_id, second.schedule_id, third.schedule_id)
+        };
+
+        let repo = LocalRepository::open(&dir).unwrap();
+        let names: Vec<_> = repo
+            .list_schedules()
+            .await
+            .unwrap()
+            .into_iter()
+            .map(|info| info.schedule_name)
+            .collect();
+        assert_eq!(names, ["renamed", "third"]);
+        assert!(!repo.has_schedule(second));
+
+        let third_schedule = repo.get_schedule(third).await.unwrap();
+        let block_id = third_schedule.blocks[2].id.unwrap().0;
+        let block = repo.get_scheduling_block(block_id).await.unwrap();
+        assert_eq!(block.original_block_id, "ob-2");
+        assert_eq!(block.visibility_periods.len(), 1);
+        assert_eq!(repo.get_schedule(first).await.unwrap().blocks.len(), 2);
+
+        // Ids keep counting from where the previous process stopped.
+        let fourth = repo.store_schedule(&mk("fourth", 1)).await.unwrap();
+        assert!(fourth.schedule_id.0 > third.0);
+
+        drop(repo);
+        std::fs::remove_dir_all(&dir).unwrap();
+    }
+
     #[tokio::test]
     async fn test_bulk_delete_schedules() {
         let repo = LocalRepository::new();
@@ -0,0 +1,986 @@
+//! On-disk persistence for the local repository.
+//!
+//! A persistent [`LocalRepository`](super::LocalRepository) keeps two files
+//! in its data directory:
+//! - `snapshot.tsi`: every schedule as of the last snapshot, followed by an
+//!   index of where each one starts.
+//! - `journal.tsi`: schedule mutations made since that snapshot, appended as
+//!   they happen.
+//!
+//! On open only the snapshot's index and the short header of each schedule
+//! are read; blocks are decoded the first time a schedule is read. With the
+//! `local-mmap` feature the file is memory-mapped, otherwise those ranges
+//! are fetched with positional reads, so neither holds the file in memory. The journal is then replayed
+//! on top. Once the journal outgrows a threshold it is folded into a new
+//! snapshot, copying schedules that were never read without decoding them.
+//! The snapshot is written from a [`SnapshotCut`] without holding the
+//! [`Store`], so mutations keep being journaled meanwhile; only the journal
+//! prefix the cut covers is dropped when the snapshot is installed.
+//!
+//! All integers and floats are little-endian. Strings are a `u32` byte
+//! length followed by UTF-8, and period lists a `u32` count followed by
+//! `(start, end)` MJD pairs. The observer location is stored as JSON, the
+//! same representation the Postgres repository uses.
+
+use std::borrow::Cow;
+use std::fs::{self, File, OpenOptions};
+use std::io::{BufWriter, Read, Seek, SeekFrom, Write};
+use std::ops::Range;
+use std::path::{Path, PathBuf};
+use std::sync::Arc;
+
+use crate::api::{
+    Constraints, GeographicLocation, ModifiedJulianDate, Period, Schedule, SchedulingBlock,
+    SchedulingBlockId,
+};
+use crate::db::repository::{RepositoryError, RepositoryResult};
+
+const SNAPSHOT_FILE: &str = "snapshot.tsi";
+const SNAPSHOT_TMP_FILE: &str = "snapshot.tsi.tmp";
+const JOURNAL_FILE: &str = "journal.tsi";
+const JOURNAL_TMP_FILE: &str = "journal.tsi.tmp";
+
+const SNAPSHOT_MAGIC: &[u8; 8] = b"TSISNAP1";
+/// Magic, next schedule id, next block id.
+const SNAPSHOT_HEADER_LEN: usize = 8 + 8 + 8;
+/// Index offset, schedule count, magic.
+const SNAPSHOT_FOOTER_LEN: usize = 8 + 8 + 8;
+/// Schedule id, offset, length.
+const SNAPSHOT_INDEX_ENTRY_LEN: usize = 8 + 8 + 8;
+/// Payload length, payload checksum.
+const JOURNAL_RECORD_HEADER_LEN: usize = 4 + 4;
+/// Bytes read to decode a schedule header on open; a header longer than
+/// this (a very long name) costs a second read of the whole schedule.
+const HEADER_READ_LEN: usize = 4096;
+
+const RECORD_STORE: u8 = 1;
+const RECORD_DELETE: u8 = 2;
+const RECORD_UPDATE_METADATA: u8 = 3;
+
+/// Journal size past which it is folded into a new snapshot.
+pub(crate) const DEFAULT_SNAPSHOT_THRESHOLD_BYTES: u64 = 256 * 1024 * 1024;
+
+fn io_error(action: &str, path: &Path, e: std::io::Error) -> RepositoryError {
+    RepositoryError::InternalError(format!("Failed to {} {}: {}", action, path.display(), e))
+}
+
+fn corrupt(what: &str) -> RepositoryError {
+    RepositoryError::InternalError(format!("Corrupt local repository {}", what))
+}
+
+/// FNV-1a, to detect torn or garbled journal records.
+fn checksum(bytes: &[u8]) -> u32 {
+    bytes.iter().fold(0x811c_9dc5u32, |hash, &b| {
+        (hash ^ b as u32).wrapping_mul(0x0100_0193)
+    })
+}
+
+// ==================== Snapshot image ====================
+
+enum Backing {
+    #[cfg(feature = "local-mmap")]
+    Mapped(memmap2::Mmap),
+    #[cfg(not(feature = "local-mmap"))]
+    File { file: File, len: usize },
+}
+
+/// Read-only contents of a snapshot file.
+pub(crate) struct SnapshotImage {
+    path: PathBuf,
+    backing: Backing,
+}
+
+impl std::fmt::Debug for SnapshotImage {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("SnapshotImage")
+            .field("path", &self.path)
+            .field("len", &self.len())
+            .finish()
+    }
+}
+
+impl SnapshotImage {
+    #[cfg(feature = "local-mmap")]
+    fn load(path: &Path, file: File) -> RepositoryResult<Self> {
+        // SAFETY: snapshot files are written under a temporary name and
+        // renamed into place, never modified after the rename, so the
+        // mapped bytes cannot change underneath us.
+        let map = unsafe { memmap2::Mmap::map(&file) }.map_err(|e| io_error("map", path, e))?;
+        Ok(Self {
+            path: path.to_path_buf(),
+            backing: Backing::Mapped(map),
+        })
+    }
+
+    #[cfg(not(feature = "local-mmap"))]
+    fn load(path: &Path, file: File) -> RepositoryResult<Self> {
+        let len = file
+            .metadata()
+            .map_err(|e| io_error("read", path, e))?
+            .len() as usize;
+        Ok(Self {
+            path: path.to_path_buf(),
+            backing: Backing::File { file, len },
+        })
+    }
+
+    pub(crate) fn len(&self) -> usize {
+        match &self.backing {
+            #[cfg(feature = "local-mmap")]
+            Backing::Mapped(map) => map.len(),
+            #[cfg(not(feature = "local-mmap"))]
+            Backing::File { len, .. } => *len,
+        }
+    }
+
+    /// Bytes `range` of the snapshot, borrowed from the mapping or read
+    /// from the file.
+    pub(crate) fn read(&self, range: Range<usize>) -> RepositoryResult<Cow<'_, [u8]>> {
+        if range.start > range.end || range.end > self.len() {
+            return Err(corrupt("snapshot index"));
+        }
+        match &self.backing {
+            #[cfg(feature = "local-mmap")]
+            Backing::Mapped(map) => Ok(Cow::Borrowed(&map[range])),
+            #[cfg(not(feature = "local-mmap"))]
+            Backing::File { file, .. } => {
+                let mut bytes = vec![0u8; range.len()];
+                read_exact_at(file, &mut bytes, range.start as u64)
+                    .map_err(|e| io_error("read", &self.path, e))?;
+                Ok(Cow::Owned(bytes))
+            }
+        }
+    }
+}
+
+#[cfg(all(not(feature = "local-mmap"), unix))]
+fn read_exact_at(file: &File, buf: &mut [u8], offset: u64) -> std::io::Result<()> {
+    std::os::unix::fs::FileExt::read_exact_at(file, buf, offset)
+}
+
+#[cfg(all(not(feature = "local-mmap"), windows))]
+fn read_exact_at(file: &File, mut buf: &mut [u8], mut offset: u64) -> std::io::Result<()> {
+    use std::os::windows::fs::FileExt;
+    while !buf.is_empty() {
+        match file.seek_read(buf, offset) {
+            Ok(0) => return Err(std::io::ErrorKind::UnexpectedEof.into()),
+            Ok(n) => {
+                buf = &mut buf[n..];
+                offset += n as u64;
+            }
+            Err(e) if e.kind() == std::io::ErrorKind::Interrupted => {}
+            Err(e) => return Err(e),
+        }
+    }
+    Ok(())
+}
+
+/// A stored schedule, decoded or still in its snapshot.
+#[derive(Debug, Clone)]
+pub(crate) enum StoredSchedule {
+    Loaded(Arc<Schedule>),
+    /// Not decoded yet: bytes `range` of `image`.
+    OnDisk {
+        image: Arc<SnapshotImage>,
+        range: Range<usize>,
+    },
+}
+
+impl StoredSchedule {
+    pub(crate) fn decode(&self) -> RepositoryResult<Arc<Schedule>> {
+        match self {
+            Self::Loaded(schedule) => Ok(schedule.clone()),
+            Self::OnDisk { image, range } => {
+                let bytes = image.read(range.clone())?;
+                decode_schedule(&bytes).map(|(_, schedule)| Arc::new(schedule))
+            }
+        }
+    }
+}
+
+// ==================== Encoding ====================
+
+fn put_u8(out: &mut Vec<u8>, v: u8) {
+    out.push(v);
+}
+
+fn put_u32(out: &mut Vec<u8>, v: u32) {
+    out.extend_from_slice(&v.to_le_bytes());
+}
+
+fn put_u64(out: &mut Vec<u8>, v: u64) {
+    out.extend_from_slice(&v.to_le_bytes());
+}
+
+fn put_i64(out: &mut Vec<u8>, v: i64) {
+    out.extend_from_slice(&v.to_le_bytes());
+}
+
+fn put_f64(out: &mut Vec<u8>, v: f64) {
+    out.extend_from_slice(&v.to_le_bytes());
+}
+
+fn put_str(out: &mut Vec<u8>, s: &str) {
+    put_u32(out, s.len() as u32);
+    out.extend_from_slice(s.as_bytes());
+}
+
+fn put_opt_str(out: &mut Vec<u8>, s: Option<&str>) {
+    put_u8(out, s.is_some() as u8);
+    if let Some(s) = s {
+        put_str(out, s);
+    }
+}
+
+fn put_period(out: &mut Vec<u8>, period: &Period) {
+    put_f64(out, period.start.value());
+    put_f64(out, period.end.value());
+}
+
+fn put_opt_period(out: &mut Vec<u8>, period: Option<&Period>) {
+    put_u8(out, period.is_some() as u8);
+    if let Some(period) = period {
+        put_period(out, period);
+    }
+}
+
+fn put_periods(out: &mut Vec<u8>, periods: &[Period]) {
+    put_u32(out, periods.len() as u32);
+    periods.iter().for_each(|p| put_period(out, p));
+}
+
+fn location_json(location: &GeographicLocation) -> RepositoryResult<String> {
+    serde_json::to_string(location).map_err(|e| {
+        RepositoryError::InternalError(format!("Failed to serialize observer location: {}", e))
+    })
+}
+
+struct Reader<'a> {
+    bytes: &'a [u8],
+}
+
+impl<'a> Reader<'a> {
+    fn new(bytes: &'a [u8]) -> Self {
+        Self { bytes }
+    }
+
+    fn take(&mut self, n: usize) -> RepositoryResult<&'a [u8]> {
+        if self.bytes.len() < n {
+            return Err(corrupt("record: truncated"));
+        }
+        let (head, tail) = self.bytes.split_at(n);
+        self.bytes = tail;
+        Ok(head)
+    }
+
+    fn array<const N: usize>(&mut self) -> RepositoryResult<[u8; N]> {
+        let mut array = [0u8; N];
+        array.copy_from_slice(self.take(N)?);
+        Ok(array)
+    }
+
+    fn u8(&mut self) -> RepositoryResult<u8> {
+        Ok(self.take(1)?[0])
+    }
+
+    fn u32(&mut self) -> RepositoryResult<u32> {
+        self.array().map(u32::from_le_bytes)
+    }
+
+    fn u64(&mut self) -> RepositoryResult<u64> {
+        self.array().map(u64::from_le_bytes)
+    }
+
+    fn i64(&mut self) -> RepositoryResult<i64> {
+        self.array().map(i64::from_le_bytes)
+    }
+
+    fn f64(&mut self) -> RepositoryResult<f64> {
+        self.array().map(f64::from_le_bytes)
+    }
+
+    fn str(&mut self) -> RepositoryResult<String> {
+        let len = self.u32()? as usize;
+        String::from_utf8(self.take(len)?.to_vec()).map_err(|_| corrupt("record: invalid UTF-8"))
+    }
+
+    fn opt_str(&mut self) -> RepositoryResult<Option<String>> {
+        match self.u8()? {
+            0 => Ok(None),
+            _ => self.str().map(Some),
+        }
+    }
+
+    fn period(&mut self) -> RepositoryResult<Period> {
+        Ok(Period {
+            start: ModifiedJulianDate::new(self.f64()?),
+            end: ModifiedJulianDate::new(self.f64()?),
+        })
+    }
+
+    fn opt_period(&mut self) -> RepositoryResult<Option<Period>> {
+        match self.u8()? {
+            0 => Ok(None),
+            _ => self.period().map(Some),
+        }
+    }
+
+    fn periods(&mut self) -> RepositoryResult<Vec<Period>> {
+        let len = self.u32()? as usize;
+        // Each period is 16 bytes; reject counts the input cannot hold.
+        if self.bytes.len() / 16 < len {
+            return Err(corrupt("record: truncated"));
+        }
+        (0..len).map(|_| self.period()).collect()
+    }
+
+    fn location(&mut self) -> RepositoryResult<GeographicLocation> {
+        serde_json::from_str(&self.str()?).map_err(|_| corrupt("record: invalid location"))
+    }
+}
+
+/// What the repository needs to list a schedule and locate its blocks,
+/// readable without decoding the blocks.
+#[derive(Debug, Clone)]
+pub(crate) struct ScheduleHeader {
+    pub schedule_id: i64,
+    pub name: String,
+    pub schedule_period: Period,
+    pub geographic_location: GeographicLocation,
+    /// Blocks are numbered consecutively from this id.
+    pub first_block_id: i64,
+    pub block_count: usize,
+}
+
+impl ScheduleHeader {
+    pub(crate) fn of(schedule_id: i64, schedule: &Schedule) -> Self {
+        Self {
+            schedule_id,
+            name: schedule.name.clone(),
+            schedule_period: schedule.schedule_period,
+            geographic_location: schedule.geographic_location,
+            first_block_id: schedule
+                .blocks
+                .first()
+                .and_then(|b| b.id)
+                .map_or(0, |id| id.0),
+            block_count: schedule.blocks.len(),
+        }
+    }
+}
+
+/// Append the header of a schedule, then its body.
+///
+/// Block ids are not written: the repository numbers a schedule's blocks
+/// consecutively, so they are rebuilt from the header's first block id.
+fn encode_schedule(
+    schedule_id: i64,
+    schedule: &Schedule,
+    out: &mut Vec<u8>,
+) -> RepositoryResult<()> {
+    let header = ScheduleHeader::of(schedule_id, schedule);
+    put_i64(out, header.schedule_id);
+    put_str(out, &header.name);
+    put_period(out, &header.schedule_period);
+    put_str(out, &location_json(&header.geographic_location)?);
+    put_i64(out, header.first_block_id);
+    put_u32(out, header.block_count as u32);
+
+    put_u8(out, schedule.id.is_some() as u8);
+    put_str(out, &schedule.checksum);
+    put_periods(out, &schedule.dark_periods);
+    put_periods(out, &schedule.astronomical_nights);
+    for block in &schedule.blocks {
+        put_str(out, &block.original_block_id);
+        put_str(out, &block.block_name);
+        put_f64(out, block.target_ra.value());
+        put_f64(out, block.target_dec.value());
+        put_f64(out, block.constraints.min_alt.value());
+        put_f64(out, block.constraints.max_alt.value());
+        put_f64(out, block.constraints.min_az.value());
+        put_f64(out, block.constraints.max_az.value());
+        put_opt_period(out, block.constraints.fixed_time.as_ref());
+        put_f64(out, block.priority);
+        put_f64(out, block.min_observation.value());
+        put_f64(out, block.requested_duration.value());
+        put_periods(out, &block.visibility_periods);
+        put_opt_period(out, block.scheduled_period.as_ref());
+    }
+    Ok(())
+}
+
+fn read_header(r: &mut Reader<'_>) -> RepositoryResult<ScheduleHeader> {
+    Ok(ScheduleHeader {
+        schedule_id: r.i64()?,
+        name: r.str()?,
+        schedule_period: r.period()?,
+        geographic_location: r.location()?,
+        first_block_id: r.i64()?,
+        block_count: r.u32()? as usize,
+    })
+}
+
+pub(crate) fn decode_header(bytes: &[u8]) -> RepositoryResult<ScheduleHeader> {
+    read_header(&mut Reader::new(bytes))
+}
+
+fn read_schedule(r: &mut Reader<'_>) -> RepositoryResult<(ScheduleHeader, Schedule)> {
+    let header = read_header(r)?;
+    let has_id = r.u8()? != 0;
+    let checksum = r.str()?;
+    let dark_periods = r.periods()?;
+    let astronomical_nights = r.periods()?;
+
+    let mut blocks = Vec::with_capacity(header.block_count.min(r.bytes.len()));
+    for row in 0..header.block_count {
+        let original_block_id = r.str()?;
+        let block_name = r.str()?;
+        let target_ra = r.f64()?.into();
+        let target_dec = r.f64()?.into();
+        let constraints = Constraints::new(
+            r.f64()?.into(),
+            r.f64()?.into(),
+            r.f64()?.into(),
+            r.f64()?.into(),
+            r.opt_period()?,
+        );
+        blocks.push(SchedulingBlock {
+            id: Some(SchedulingBlockId(header.first_block_id + row as i64)),
+            original_block_id,
+            block_name,
+            target_ra,
+            target_dec,
+            constraints,
+            priority: r.f64()?,
+            min_observation: r.f64()?.into(),
+            requested_duration: r.f64()?.into(),
+            visibility_periods: r.periods()?,
+            scheduled_period: r.opt_period()?,
+        });
+    }
+
+    let schedule = Schedule {
+        id: has_id.then_some(header.schedule_id),
+        name: header.name.clone(),
+        checksum,
+        schedule_period: header.schedule_period,
+        dark_periods,
+        geographic_location: header.geographic_location,
+        astronomical_nights,
+        blocks,
+    };
+    Ok((header, schedule))
+}
+
+pub(crate) fn decode_schedule(bytes: &[u8]) -> RepositoryResult<(ScheduleHeader, Schedule)> {
+    read_schedule(&mut Reader::new(bytes))
+}
+
+// ==================== Journal ====================
+
+/// A schedule mutation read back from the journal.
+#[derive(Debug)]
+pub(crate) enum JournalRecord {
+    Store(ScheduleHeader, Schedule),
+    Delete(i64),
+    UpdateMetadata {
+        schedule_id: i64,
+        name: Option<String>,
+        location: Option<GeographicLocation>,
+    },
+}
+
+fn decode_record(payload: &[u8]) -> RepositoryResult<JournalRecord> {
+    let mut r = Reader::new(payload);
+    match r.u8()? {
+        RECORD_STORE => {
+            let (header, schedule) = read_schedule(&mut r)?;
+            Ok(JournalRecord::Store(header, schedule))
+        }
+        RECORD_DELETE => Ok(JournalRecord::Delete(r.i64()?)),
+        RECORD_UPDATE_METADATA => {
+            let schedule_id = r.i64()?;
+            let name = r.opt_str()?;
+            let location = match r.u8()? {
+                0 => None,
+                _ => Some(r.location()?),
+            };
+            Ok(JournalRecord::UpdateMetadata {
+                schedule_id,
+                name,
+                location,
+            })
+        }
+        _ => Err(corrupt("journal: unknown record")),
+    }
+}
+
+/// State read back by [`Store::open`].
+#[derive(Debug, Default)]
+pub(crate) struct Recovered {
+    pub next_schedule_id: i64,
+    pub next_block_id: i64,
+    /// Snapshot contents, still encoded.
+    pub schedules: Vec<(ScheduleHeader, StoredSchedule)>,
+    /// Mutations since the snapshot, in order.
+    pub journal: Vec<JournalRecord>,
+}
+
+/// The data directory of a persistent local repository.
+#[derive(Debug)]
+pub(crate) struct Store {
+    dir: PathBuf,
+    journal: File,
+    journal_len: u64,
+    /// Snapshots installed so far; a cut taken before the latest one
+    /// refers to a journal that no longer exists.
+    generation: u64,
+    pub snapshot_threshold: u64,
+    /// A cut is being written in the background.
+    pub snapshot_pending: bool,
+}
+
+/// The contents of a snapshot and the journal prefix it supersedes, taken
+/// while no mutation could run.
+pub(crate) struct SnapshotCut {
+    dir: PathBuf,
+    next_schedule_id: i64,
+    next_block_id: i64,
+    schedules: Vec<(i64, StoredSchedule)>,
+    journal_len: u64,
+    generation: u64,
+}
+
+impl Store {
+    /// Open (creating if needed) the data directory at `dir`.
+    ///
+    /// A torn record at the end of the journal, left by a crash mid-write,
+    /// is dropped along with anything after it.
+    pub(crate) fn open(dir: &Path) -> RepositoryResult<(Self, Recovered)> {
+        fs::create_dir_all(dir).map_err(|e| io_error("create", dir, e))?;
+        let mut recovered = Self::read_snapshot(&dir.join(SNAPSHOT_FILE))?;
+
+        let journal_path = dir.join(JOURNAL_FILE);
+        let mut journal = OpenOptions::new()
+            .read(true)
+            .append(true)
+            .create(true)
+            .open(&journal_path)
+            .map_err(|e| io_error("open", &journal_path, e))?;
+        let mut bytes = Vec::new();
+        journal
+            .read_to_end(&mut bytes)
+            .map_err(|e| io_error("read", &journal_path, e))?;
+
+        let mut valid = 0usize;
+        while let Some(record) = Self::next_record(&bytes[valid..]) {
+            let (len, payload) = record;
+            match decode_record(payload) {
+                Ok(record) => recovered.journal.push(record),
+                Err(_) => break,
+            }
+            valid += len;
+        }
+        if valid < bytes.len() {
+            log::warn!(
+                "Discarding {} bytes of incomplete journal at {}",
+                bytes.len() - valid,
+                journal_path.display()
+            );
+            journal
+                .set_len(valid as u64)
+                .map_err(|e| io_error("truncate", &journal_path, e))?;
+        }
+
+        let store = Self {
+            dir: dir.to_path_buf(),
+            journal,
+            journal_len: valid as u64,
+            generation: 0,
+            snapshot_threshold: DEFAULT_SNAPSHOT_THRESHOLD_BYTES,
+            snapshot_pending: false,
+        };
+        Ok((store, recovered))
+    }
+
+    /// Split the first checksummed record off `bytes`, returning its total
+    /// length and payload.
+    fn next_record(bytes: &[u8]) -> Option<(usize, &[u8])> {
+        let header = bytes.get(..JOURNAL_RECORD_HEADER_LEN)?;
+        let len = u32::from_le_bytes(header[..4].try_into().ok()?) as usize;
+        let sum = u32::from_le_bytes(header[4..].try_into().ok()?);
+        let payload = bytes.get(JOURNAL_RECORD_HEADER_LEN..JOURNAL_RECORD_HEADER_LEN + len)?;
+        (checksum(payload) == sum).then_some((JOURNAL_RECORD_HEADER_LEN + len, payload))
+    }
+
+    fn read_snapshot(path: &Path) -> RepositoryResult<Recovered> {
+        let file = match File::open(path) {
+            Ok(file) => file,
+            Err(e) if e.kind() == std::io::ErrorKind::NotFound => {
+                return Ok(Recovered {
+                    next_schedule_id: 1,
+                    next_block_id: 1,
+                    ..Default::default()
+                })
+            }
+            Err(e) => return Err(io_error("open", path, e)),
+        };
+        let image = Arc::new(SnapshotImage::load(path, file)?);
+        let len = image.len();
+        if len < SNAPSHOT_HEADER_LEN + SNAPSHOT_FOOTER_LEN {
+            return Err(corrupt("snapshot"));
+        }
+        let head = image.read(0..SNAPSHOT_HEADER_LEN)?;
+        let tail = image.read(len - SNAPSHOT_FOOTER_LEN..len)?;
+        if &head[..8] != SNAPSHOT_MAGIC || &tail[SNAPSHOT_FOOTER_LEN - 8..] != SNAPSHOT_MAGIC {
+            return Err(corrupt("snapshot"));
+        }
+
+        let mut header = Reader::new(&head[8..]);
+        let next_schedule_id = header.i64()?;
+        let next_block_id = header.i64()?;
+        let mut footer = Reader::new(&tail);
+        let index_offset = footer.u64()? as usize;
+        let count = footer.u64()? as usize;
+        let index_range = index_offset..len - SNAPSHOT_FOOTER_LEN;
+        if index_offset > index_range.end
+            || index_range.len() != count.saturating_mul(SNAPSHOT_INDEX_ENTRY_LEN)
+        {
+            return Err(corrupt("snapshot index"));
+        }
+        let index = image.read(index_range)?;
+
+        let mut schedules = Vec::with_capacity(count);
+        let mut index = Reader::new(&index);
+        for _ in 0..count {
+            let _schedule_id = index.i64()?;
+            let offset = index.u64()? as usize;
+            let len = index.u64()? as usize;
+            let range = offset..offset.saturating_add(len);
+            if range.end > index_offset {
+                return Err(corrupt("snapshot index"));
+            }
+            let prefix = range.start..range.end.min(range.start + HEADER_READ_LEN);
+            let header = match decode_header(&image.read(prefix)?) {
+                Ok(header) => header,
+                Err(_) => decode_header(&image.read(range.clone())?)?,
+            };
+            schedules.push((
+                header,
+                StoredSchedule::OnDisk {
+                    image: image.clone(),
+                    range,
+                },
+            ));
+        }
+
+        Ok(Recovered {
+            next_schedule_id,
+            next_block_id,
+            schedules,
+            journal: Vec::new(),
+        })
+    }
+
+    fn append(&mut self, payload: &[u8]) -> RepositoryResult<()> {
+        let mut record = Vec::with_capacity(JOURNAL_RECORD_HEADER_LEN + payload.len());
+        put_u32(&mut record, payload.len() as u32);
+        put_u32(&mut record, checksum(payload));
+        record.extend_from_slice(payload);
+
+        let path = self.dir.join(JOURNAL_FILE);
+        self.journal
+            .write_all(&record)
+            .and_then(|()| self.journal.sync_data())
+            .map_err(|e| io_error("append to", &path, e))?;
+        self.journal_len += record.len() as u64;
+        Ok(())
+    }
+
+    pub(crate) fn log_store(
+        &mut self,
+        schedule_id: i64,
+        schedule: &Schedule,
+    ) -> RepositoryResult<()> {
+        let mut payload = vec![RECORD_STORE];
+        encode_schedule(schedule_id, schedule, &mut payload)?;
+        self.append(&payload)
+    }
+
+    pub(crate) fn log_delete(&mut self, schedule_id: i64) -> RepositoryResult<()> {
+        let mut payload = vec![RECORD_DELETE];
+        put_i64(&mut payload, schedule_id);
+        self.append(&payload)
+    }
+
+    pub(crate) fn log_update_metadata(
+        &mut self,
+        schedule_id: i64,
+        name: Option<&str>,
+        location: Option<&GeographicLocation>,
+    ) -> RepositoryResult<()> {
+        let mut payload = vec![RECORD_UPDATE_METADATA];
+        put_i64(&mut payload, schedule_id);
+        put_opt_str(&mut payload, name);
+        put_opt_str(
+            &mut payload,
+            location.map(location_json).transpose()?.as_deref(),
+        );
+        self.append(&payload)
+    }
+
+    /// Whether the journal has outgrown the snapshot threshold and no
+    /// snapshot is already being written.
+    pub(crate) fn needs_snapshot(&self) -> bool {
+        !self.snapshot_pending && self.journal_len >= self.snapshot_threshold
+    }
+
+    /// Capture `schedules`, ordered by id, as the next snapshot. Must be
+    /// called while no mutation can be journaled.
+    pub(crate) fn cut(
+        &self,
+        next_schedule_id: i64,
+        next_block_id: i64,
+        schedules: Vec<(i64, StoredSchedule)>,
+    ) -> SnapshotCut {
+        SnapshotCut {
+            dir: self.dir.clone(),
+            next_schedule_id,
+            next_block_id,
+            schedules,
+            journal_len: self.journal_len,
+            generation: self.generation,
+        }
+    }
+
+    /// Replace the snapshot with the one written from `cut` and drop the
+    /// journal records it covers.
+    ///
+    /// Returns the new snapshot, or `None` if another snapshot was installed
+    /// since `cut` was taken, in which case `cut` is discarded. A crash
+    /// after the rename leaves the new snapshot and a journal whose covered
+    /// records replay to the same state.
+    pub(crate) fn install_snapshot(
+        &mut self,
+        cut: &SnapshotCut,
+    ) -> RepositoryResult<Option<Arc<SnapshotImage>>> {
+        let tmp_path = self.dir.join(SNAPSHOT_TMP_FILE);
+        if cut.generation != self.generation {
+            let _ = fs::remove_file(&tmp_path);
+            return Ok(None);
+        }
+
+        let snapshot_path = self.dir.join(SNAPSHOT_FILE);
+        fs::rename(&tmp_path, &snapshot_path)
+            .map_err(|e| io_error("replace", &snapshot_path, e))?;
+        self.generation += 1;
+        self.drop_journal_prefix(cut.journal_len)?;
+
+        let file = File::open(&snapshot_path).map_err(|e| io_error("open", &snapshot_path, e))?;
+        SnapshotImage::load(&snapshot_path, file).map(|image| Some(Arc::new(image)))
+    }
+
+    /// Drop the first `covered` bytes of the journal, keeping records
+    /// appended after them.
+    fn drop_journal_prefix(&mut self, covered: u64) -> RepositoryResult<()> {
+        let journal_path = self.dir.join(JOURNAL_FILE);
+        if covered >= self.journal_len {
+            self.journal
+                .set_len(0)
+                .and_then(|()| self.journal.sync_all())
+                .map_err(|e| io_error("truncate", &journal_path, e))?;
+            self.journal_len = 0;
+            return Ok(());
+        }
+
+        let mut tail = Vec::new();
+        self.journal
+            .seek(SeekFrom::Start(covered))
+            .and_then(|_| self.journal.read_to_end(&mut tail))
+            .map_err(|e| io_error("read", &journal_path, e))?;
+        let tmp_path = self.dir.join(JOURNAL_TMP_FILE);
+        File::create(&tmp_path)
+            .and_then(|mut file| file.write_all(&tail).and_then(|()| file.sync_all()))
+            .map_err(|e| io_error("write", &tmp_path, e))?;
+        fs::rename(&tmp_path, &journal_path).map_err(|e| io_error("replace", &journal_path, e))?;
+        self.journal = OpenOptions::new()
+            .read(true)
+            .append(true)
+            .open(&journal_path)
+            .map_err(|e| io_error("open", &journal_path, e))?;
+        self.journal_len = tail.len() as u64;
+        Ok(())
+    }
+}
+
+impl SnapshotCut {
+    /// Write the snapshot under a temporary name for
+    /// [`Store::install_snapshot`], returning where each schedule landed.
+    ///
+    /// Schedules still on disk are copied byte for byte.
+    pub(crate) fn write(&self) -> RepositoryResult<Vec<(i64, Range<usize>)>> {
+        let tmp_path = self.dir.join(SNAPSHOT_TMP_FILE);
+        let file = File::create(&tmp_path).map_err(|e| io_error("create", &tmp_path, e))?;
+        let mut out = BufWriter::new(file);
+        let write_error = |e| io_error("write", &tmp_path, e);
+
+        let mut head = Vec::with_capacity(SNAPSHOT_HEADER_LEN);
+        head.extend_from_slice(SNAPSHOT_MAGIC);
+        put_i64(&mut head, self.next_schedule_id);
+        put_i64(&mut head, self.next_block_id);
+        out.write_all(&head).map_err(write_error)?;
+
+        let mut offset = SNAPSHOT_HEADER_LEN as u64;
+        let mut index = Vec::with_capacity(self.schedules.len() * SNAPSHOT_INDEX_ENTRY_LEN);
+        let mut ranges = Vec::with_capacity(self.schedules.len());
+        let mut encoded = Vec::new();
+        for (schedule_id, stored) in &self.schedules {
+            let bytes: Cow<'_, [u8]> = match stored {
+                StoredSchedule::OnDisk { image, range } => image.read(range.clone())?,
+                StoredSchedule::Loaded(schedule) => {
+                    encoded.clear();
+                    encode_schedule(*schedule_id, schedule, &mut encoded)?;
+                    Cow::Borrowed(&encoded[..])
+                }
+            };
+            out.write_all(&bytes).map_err(write_error)?;
+            put_i64(&mut index, *schedule_id);
+            put_u64(&mut index, offset);
+            put_u64(&mut index, bytes.len() as u64);
+            ranges.push((
+                *schedule_id,
+                offset as usize..(offset as usize + bytes.len()),
+            ));
+            offset += bytes.len() as u64;
+        }
+
+        put_u64(&mut index, offset);
+        put_u64(&mut index, self.schedules.len() as u64);
+        index.extend_from_slice(SNAPSHOT_MAGIC);
+        out.write_all(&index).map_err(write_error)?;
+        let file = out
+            .into_inner()
+            .map_err(|e| io_error("write", &tmp_path, e.into_error()))?;
+        file.sync_all().map_err(write_error)?;
+        Ok(ranges)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use siderust::coordinates::centers::Geodetic;
+    use siderust::coordinates::frames::ECEF;
+
+    fn period(start: f64, end: f64) -> Period {
+        Period {
+            start: ModifiedJulianDate::new(start),
+            end: ModifiedJulianDate::new(end),
+        }
+    }
+
+    fn schedule() -> Schedule {
+        let block = |id: i64, scheduled: Option<Period>| SchedulingBlock {
+            id: Some(SchedulingBlockId(id)),
+            original_block_id: format!("ob-{id}"),
+            block_name: "M31".to_string(),
+            target_ra: 10.5.into(),
+            target_dec: 41.2.into(),
+            constraints: Constraints::new(
+                20.0.into(),
+                85.0.into(),
+                0.0.into(),
+                360.0.into(),
+                Some(period(60000.0, 60001.0)),
+            ),
+            priority: id as f64,
+            min_observation: 600.0.into(),
+            requested_duration: 3600.0.into(),
+            visibility_periods: vec![period(60000.1, 60000.2), period(60000.5, 60000.7)],
+            scheduled_period: scheduled,
+        };
+        Schedule {
+            id: None,
+            name: "persisted".to_string(),
+            checksum: "abc".to_string(),
+            schedule_period: period(60000.0, 60007.0),
+            dark_periods: vec![period(60000.0, 60000.4)],
+            geographic_location: Geodetic::<ECEF>::new(
+                qtty::Degrees::new(-17.89),
+                qtty::Degrees::new(28.76),
+                qtty::Meters::new(2200.0),
+            ),
+            astronomical_nights: vec![],
+            blocks: vec![block(7, Some(period(60000.5, 60000.6))), block(8, None)],
+        }
+    }
+
+    #[test]
+    fn schedule_round_trips_and_torn_journal_tail_is_dropped() {
+        let original = schedule();
+        let mut bytes = Vec::new();
+        encode_schedule(3, &original, &mut bytes).unwrap();
+
+        let header = decode_header(&bytes).unwrap();
+        assert_eq!((header.schedule_id, header.first_block_id), (3, 7));
+        assert_eq!(header.block_count, 2);
+
+        let (_, decoded) = decode_schedule(&bytes).unwrap();
+        assert_eq!(decoded.id, None);
+        assert_eq!(
+            serde_json::to_value(&decoded).unwrap(),
+            serde_json::to_value(&original).unwrap()
+        );
+
+        let dir = std::env::temp_dir().join(format!("tsi-local-store-{}", std::process::id()));
+        let _ = fs::remove_dir_all(&dir);
+        {
+            let (mut store, _) = Store::open(&dir).unwrap();
+            store.log_store(3, &original).unwrap();
+            store.log_delete(3).unwrap();
+        }
+        // Simulate a crash halfway through the last record.
+        let journal = dir.join(JOURNAL_FILE);
+        let len = fs::metadata(&journal).unwrap().len();
+        OpenOptions::new()
+            .write(true)
+            .open(&journal)
+            .unwrap()
+            .set_len(len - 3)
+            .unwrap();
+
+        let (_, recovered) = Store::open(&dir).unwrap();
+        assert_eq!(recovered.journal.len(), 1);
+        assert!(
+            matches!(recovered.journal[0], JournalRecord::Store(ref h, _) if h.schedule_id == 3)
+        );
+        fs::remove_dir_all(&dir).unwrap();
+    }
+
+    #[test]
+    fn snapshot_keeps_records_journaled_while_it_was_written() {
+        let dir = std::env::temp_dir().join(format!("tsi-local-cut-{}", std::process::id()));
+        let _ = fs::remove_dir_all(&dir);
+        let (mut store, _) = Store::open(&dir).unwrap();
+        store.log_store(3, &schedule()).unwrap();
+        let cut = store.cut(
+            4,
+            9,
+            vec![(3, StoredSchedule::Loaded(Arc::new(schedule())))],
+        );
+        let index = cut.write().unwrap();
+        store.log_delete(3).unwrap();
+
+        let image = store.install_snapshot(&cut).unwrap().unwrap();
+        let (header, _) = decode_schedule(&image.read(index[0].1.clone()).unwrap()).unwrap();
+        assert_eq!(header.schedule_id, 3);
+        // The journal the cut refers to is gone.
+        assert!(store.install_snapshot(&cut).unwrap().is_none());
+        drop(store);
+
+        let (_, recovered) = Store::open(&dir).unwrap();
+        assert_eq!(recovered.schedules.len(), 1);
+        assert!(matches!(recovered.journal[..], [JournalRecord::Delete(3)]));
+        fs::remove_dir_all(&dir).unwrap();
+    }
+}
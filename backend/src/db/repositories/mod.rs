@@ -3,10 +3,17 @@
 //! This module contains different implementations of the `ScheduleRepository` trait:
 //! - `postgres`: PostgreSQL implementation with Diesel ORM
 //! - `local`: In-memory implementation for unit testing and local development
+//! - `local_store`: Optional on-disk persistence for `local`
+//! - `sqlite`: Embedded single-file implementation with SQLite
 pub mod local;
+mod local_store;
 #[cfg(feature = "postgres-repo")]
 pub mod postgres;
+#[cfg(feature = "sqlite-repo")]
+pub mod sqlite;
 
 pub use local::LocalRepository;
 #[cfg(feature = "postgres-repo")]
 pub use postgres::{PoolStats, PostgresConfig, PostgresRepository};
+#[cfg(feature = "sqlite-repo")]
+pub use sqlite::{SqliteConfig, SqliteRepository};
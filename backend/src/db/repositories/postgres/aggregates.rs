@@ -0,0 +1,508 @@
+//! Aggregate queries behind the distribution and insights push-down.
+//!
+//! The distributions and insights services otherwise load every analytics
+//! row of a schedule to compute a handful of numbers. These queries let
+//! Postgres compute them instead (`percentile_cont` medians, `width_bucket`
+//! histograms, `corr` over average ranks, an interval self-join for
+//! conflicts) so only the aggregates cross the wire. Results follow the
+//! in-Rust computations in `services::distributions` and
+//! `services::insights`: same filtering (non-zero visibility), population
+//! standard deviation, tie-averaged Spearman ranks and histogram bins.
+
+use diesel::pg::PgConnection;
+use diesel::prelude::*;
+use diesel::sql_query;
+use diesel::sql_types::{Array, BigInt, Bool, Double, Integer, Nullable, Text};
+
+use super::map_diesel_error;
+use super::schema::{schedule_block_analytics, schedule_blocks};
+use crate::api::{
+    AnalyticsMetrics, ConflictRecord, CorrelationEntry, DistributionData, DistributionHistogram,
+    DistributionHistograms, DistributionStats, InsightsData, ModifiedJulianDate, TopObservation,
+};
+use crate::db::repository::RepositoryResult;
+use crate::services::insights::CORRELATION_COLUMNS;
+
+/// Blocks of schedule `$1` joined to their analytics rows.
+const ANALYTICS_JOIN: &str = "schedule_blocks b \
+     JOIN schedule_block_analytics a \
+       ON a.schedule_id = b.schedule_id AND a.scheduling_block_id = b.scheduling_block_id";
+
+/// Restricts [`ANALYTICS_JOIN`] to the blocks the services analyse.
+const VISIBLE_FILTER: &str = "b.schedule_id = $1 AND a.total_visibility_hours > 0";
+
+/// Distribution columns unpivoted to `(col, x)`, in the order of
+/// [`DistributionHistograms`]' fields.
+const DISTRIBUTION_COLUMNS: &str = "CROSS JOIN LATERAL (VALUES \
+     (0, b.priority), (1, a.total_visibility_hours), (2, a.requested_hours)) AS c(col, x)";
+
+/// SQL expression for each entry of [`CORRELATION_COLUMNS`], by name.
+const CORRELATION_COLUMN_SQL: &[(&str, &str)] = &[
+    ("priority", "b.priority"),
+    ("total_visibility_hours", "a.total_visibility_hours"),
+    ("requested_hours", "a.requested_hours"),
+    ("elevation_range_deg", "COALESCE(a.elevation_range_deg, 0)"),
+];
+
+#[derive(Debug, QueryableByName)]
+struct ColumnStatsRow {
+    #[diesel(sql_type = Integer)]
+    col: i32,
+    #[diesel(sql_type = BigInt)]
+    count: i64,
+    #[diesel(sql_type = BigInt)]
+    scheduled: i64,
+    #[diesel(sql_type = Double)]
+    mean: f64,
+    #[diesel(sql_type = Double)]
+    median: f64,
+    #[diesel(sql_type = Double)]
+    std_dev: f64,
+    #[diesel(sql_type = Double)]
+    min: f64,
+    #[diesel(sql_type = Double)]
+    max: f64,
+    #[diesel(sql_type = Double)]
+    sum: f64,
+}
+
+#[derive(Debug, QueryableByName)]
+struct HistogramBinRow {
+    #[diesel(sql_type = Integer)]
+    col: i32,
+    #[diesel(sql_type = Integer)]
+    bin: i32,
+    #[diesel(sql_type = Bool)]
+    scheduled: bool,
+    #[diesel(sql_type = BigInt)]
+    count: i64,
+}
+
+#[derive(Debug, QueryableByName)]
+struct MetricsRow {
+    #[diesel(sql_type = BigInt)]
+    total: i64,
+    #[diesel(sql_type = BigInt)]
+    scheduled: i64,
+    #[diesel(sql_type = Double)]
+    mean_priority: f64,
+    #[diesel(sql_type = Double)]
+    median_priority: f64,
+    #[diesel(sql_type = Double)]
+    mean_priority_scheduled: f64,
+    #[diesel(sql_type = Double)]
+    mean_priority_unscheduled: f64,
+    #[diesel(sql_type = Double)]
+    sum_priority_total: f64,
+    #[diesel(sql_type = Double)]
+    sum_priority_scheduled: f64,
+    #[diesel(sql_type = Double)]
+    total_visibility_hours: f64,
+    #[diesel(sql_type = Double)]
+    mean_requested_hours: f64,
+}
+
+#[derive(Debug, QueryableByName)]
+struct CorrelationRow {
+    #[diesel(sql_type = Array<Nullable<Double>>)]
+    correlations: Vec<Option<f64>>,
+}
+
+#[derive(Debug, QueryableByName)]
+struct ConflictRow {
+    #[diesel(sql_type = Text)]
+    block_id_1: String,
+    #[diesel(sql_type = Text)]
+    block_id_2: String,
+    #[diesel(sql_type = Double)]
+    start_1: f64,
+    #[diesel(sql_type = Double)]
+    stop_1: f64,
+    #[diesel(sql_type = Double)]
+    start_2: f64,
+    #[diesel(sql_type = Double)]
+    stop_2: f64,
+}
+
+fn empty_stats() -> DistributionStats {
+    DistributionStats {
+        count: 0,
+        mean: 0.0,
+        median: 0.0,
+        std_dev: 0.0,
+        min: 0.0,
+        max: 0.0,
+        sum: 0.0,
+    }
+}
+
+/// Distribution statistics of schedule `schedule_id`, with histograms of
+/// `bins` bins when requested. `blocks` is empty and `impossible_count` 0.
+pub(super) fn distribution_summary(
+    conn: &mut PgConnection,
+    schedule_id: i64,
+    bins: Option<usize>,
+) -> RepositoryResult<DistributionData> {
+    let stats_rows = sql_query(format!(
+        "SELECT c.col, \
+                count(*) AS count, \
+                count(*) FILTER (WHERE a.scheduled) AS scheduled, \
+                avg(c.x) AS mean, \
+                percentile_cont(0.5) WITHIN GROUP (ORDER BY c.x) AS median, \
+                stddev_pop(c.x) AS std_dev, \
+                min(c.x) AS min, max(c.x) AS max, sum(c.x) AS sum \
+         FROM {ANALYTICS_JOIN} {DISTRIBUTION_COLUMNS} \
+         WHERE {VISIBLE_FILTER} \
+         GROUP BY c.col"
+    ))
+    .bind::<BigInt, _>(schedule_id)
+    .load::<ColumnStatsRow>(conn)
+    .map_err(map_diesel_error)?;
+
+    let mut stats = [empty_stats(), empty_stats(), empty_stats()];
+    let (mut total_count, mut scheduled_count) = (0, 0);
+    for row in &stats_rows {
+        let Some(slot) = stats.get_mut(row.col as usize) else {
+            continue;
+        };
+        *slot = DistributionStats {
+            count: row.count as usize,
+            mean: row.mean,
+            median: row.median,
+            std_dev: row.std_dev,
+            min: row.min,
+            max: row.max,
+            sum: row.sum,
+        };
+        total_count = row.count as usize;
+        scheduled_count = row.scheduled as usize;
+    }
+
+    let histograms = match bins {
+        Some(bins) if total_count > 0 => Some(histograms(conn, schedule_id, bins, &stats)?),
+        _ => None,
+    };
+
+    let [priority_stats, visibility_stats, requested_hours_stats] = stats;
+    Ok(DistributionData {
+        blocks: Vec::new(),
+        priority_stats,
+        visibility_stats,
+        requested_hours_stats,
+        total_count,
+        scheduled_count,
+        unscheduled_count: total_count - scheduled_count,
+        impossible_count: 0,
+        histograms,
+    })
+}
+
+/// `width_bucket` histograms over each column's `[min, max]`, with `max`
+/// folded into the last bin.
+fn histograms(
+    conn: &mut PgConnection,
+    schedule_id: i64,
+    bins: usize,
+    stats: &[DistributionStats; 3],
+) -> RepositoryResult<DistributionHistograms> {
+    let bins = bins.max(1);
+    let rows = sql_query(format!(
+        "WITH cols AS ( \
+             SELECT c.col, c.x, a.scheduled \
+             FROM {ANALYTICS_JOIN} {DISTRIBUTION_COLUMNS} \
+             WHERE {VISIBLE_FILTER} \
+         ), bounds AS ( \
+             SELECT col, min(x) AS lo, max(x) AS hi FROM cols GROUP BY col \
+         ) \
+         SELECT cols.col, \
+                CASE WHEN bounds.hi > bounds.lo \
+                     THEN LEAST(width_bucket(cols.x, bounds.lo, bounds.hi, $2), $2) - 1 \
+                     ELSE 0 END AS bin, \
+                cols.scheduled, \
+                count(*) AS count \
+         FROM cols JOIN bounds ON bounds.col = cols.col \
+         GROUP BY 1, 2, 3"
+    ))
+    .bind::<BigInt, _>(schedule_id)
+    .bind::<Integer, _>(bins as i32)
+    .load::<HistogramBinRow>(conn)
+    .map_err(map_diesel_error)?;
+
+    let mut histograms: [DistributionHistogram; 3] =
+        std::array::from_fn(|col| DistributionHistogram {
+            min: stats[col].min,
+            max: stats[col].max,
+            scheduled: vec![0; bins],
+            unscheduled: vec![0; bins],
+        });
+    for row in rows {
+        let Some(histogram) = histograms.get_mut(row.col as usize) else {
+            continue;
+        };
+        let bin = (row.bin.max(0) as usize).min(bins - 1);
+        if row.scheduled {
+            histogram.scheduled[bin] += row.count as usize;
+        } else {
+            histogram.unscheduled[bin] += row.count as usize;
+        }
+    }
+
+    let [priority, visibility_hours, requested_hours] = histograms;
+    Ok(DistributionHistograms {
+        priority,
+        visibility_hours,
+        requested_hours,
+    })
+}
+
+/// Spearman correlation query over [`CORRELATION_COLUMNS`]: each column is
+/// replaced by its tie-averaged rank and every pair passed to `corr`, in
+/// the order the service emits them. `None` if a column has no SQL
+/// counterpart.
+fn correlation_query() -> Option<String> {
+    let expressions = CORRELATION_COLUMNS
+        .iter()
+        .map(|(name, _)| {
+            CORRELATION_COLUMN_SQL
+                .iter()
+                .find(|(sql_name, _)| sql_name == name)
+                .map(|(_, expression)| *expression)
+        })
+        .collect::<Option<Vec<_>>>()?;
+
+    let ranks = expressions
+        .iter()
+        .enumerate()
+        .map(|(i, e)| {
+            format!(
+                "(rank() OVER (ORDER BY {e}) + (count(*) OVER (PARTITION BY {e}) - 1) / 2.0)::float8 AS r{i}"
+            )
+        })
+        .collect::<Vec<_>>()
+        .join(", ");
+    let mut pairs = Vec::new();
+    for i in 0..expressions.len() {
+        for j in (i + 1)..expressions.len() {
+            pairs.push(format!("corr(r{i}, r{j})"));
+        }
+    }
+
+    Some(format!(
+        "SELECT ARRAY[{}]::float8[] AS correlations \
+         FROM (SELECT {ranks} FROM {ANALYTICS_JOIN} WHERE {VISIBLE_FILTER}) ranked",
+        pairs.join(", ")
+    ))
+}
+
+/// Top `limit` visible blocks by priority or by visibility, highest first.
+fn top_observations(
+    conn: &mut PgConnection,
+    schedule_id: i64,
+    by_visibility: bool,
+    limit: usize,
+) -> RepositoryResult<Vec<TopObservation>> {
+    let query = schedule_blocks::table
+        .inner_join(schedule_block_analytics::table.on(
+            schedule_block_analytics::scheduling_block_id.eq(schedule_blocks::scheduling_block_id),
+        ))
+        .filter(schedule_blocks::schedule_id.eq(schedule_id))
+        .filter(schedule_block_analytics::total_visibility_hours.gt(0.0))
+        .select((
+            schedule_blocks::scheduling_block_id,
+            schedule_blocks::source_block_id,
+            schedule_blocks::original_block_id,
+            schedule_blocks::block_name,
+            schedule_blocks::priority,
+            schedule_block_analytics::total_visibility_hours,
+            schedule_block_analytics::requested_hours,
+            schedule_block_analytics::scheduled,
+        ))
+        .into_boxed();
+    let query = if by_visibility {
+        query.order((
+            schedule_block_analytics::total_visibility_hours.desc(),
+            schedule_blocks::scheduling_block_id.asc(),
+        ))
+    } else {
+        query.order((
+            schedule_blocks::priority.desc(),
+            schedule_blocks::scheduling_block_id.asc(),
+        ))
+    };
+
+    let rows = query
+        .limit(limit as i64)
+        .load::<(i64, i64, Option<String>, String, f64, f64, f64, bool)>(conn)
+        .map_err(map_diesel_error)?;
+
+    Ok(rows
+        .into_iter()
+        .map(
+            |(
+                block_id,
+                source_block_id,
+                original_block_id,
+                block_name,
+                priority,
+                vis,
+                req,
+                scheduled,
+            )| {
+                TopObservation {
+                    scheduling_block_id: block_id,
+                    original_block_id: original_block_id
+                        .unwrap_or_else(|| source_block_id.to_string()),
+                    block_name,
+                    priority,
+                    total_visibility_hours: qtty::Hours::new(vis),
+                    requested_hours: qtty::Hours::new(req),
+                    scheduled,
+                }
+            },
+        )
+        .collect())
+}
+
+/// Overlapping pairs of scheduled, visible blocks.
+fn conflicts(conn: &mut PgConnection, schedule_id: i64) -> RepositoryResult<Vec<ConflictRecord>> {
+    let rows = sql_query(format!(
+        "WITH s AS ( \
+             SELECT b.scheduling_block_id AS id, \
+                    COALESCE(b.original_block_id, b.source_block_id::text) AS block_id, \
+                    a.scheduled_start_mjd AS start_mjd, \
+                    a.scheduled_stop_mjd AS stop_mjd \
+             FROM {ANALYTICS_JOIN} \
+             WHERE {VISIBLE_FILTER} AND a.scheduled \
+               AND a.scheduled_start_mjd < a.scheduled_stop_mjd \
+         ) \
+         SELECT s1.block_id AS block_id_1, s2.block_id AS block_id_2, \
+                s1.start_mjd AS start_1, s1.stop_mjd AS stop_1, \
+                s2.start_mjd AS start_2, s2.stop_mjd AS stop_2 \
+         FROM s s1 JOIN s s2 \
+           ON s1.id < s2.id AND s1.start_mjd < s2.stop_mjd AND s2.start_mjd < s1.stop_mjd \
+         ORDER BY s1.id, s2.id"
+    ))
+    .bind::<BigInt, _>(schedule_id)
+    .load::<ConflictRow>(conn)
+    .map_err(map_diesel_error)?;
+
+    Ok(rows
+        .into_iter()
+        .map(|row| {
+            let overlap_days = row.stop_1.min(row.stop_2) - row.start_1.max(row.start_2);
+            ConflictRecord {
+                block_id_1: row.block_id_1,
+                block_id_2: row.block_id_2,
+                start_time_1: ModifiedJulianDate::new(row.start_1),
+                stop_time_1: ModifiedJulianDate::new(row.stop_1),
+                start_time_2: ModifiedJulianDate::new(row.start_2),
+                stop_time_2: ModifiedJulianDate::new(row.stop_2),
+                overlap_hours: qtty::Hours::new(overlap_days * 24.0),
+            }
+        })
+        .collect())
+}
+
+/// Insights of schedule `schedule_id` with `top_n`-long top lists, or
+/// `None` if the correlation columns cannot be expressed in SQL. `blocks`
+/// is empty.
+pub(super) fn insights_summary(
+    conn: &mut PgConnection,
+    schedule_id: i64,
+    top_n: usize,
+) -> RepositoryResult<Option<InsightsData>> {
+    let Some(correlation_sql) = correlation_query() else {
+        return Ok(None);
+    };
+
+    let m = sql_query(format!(
+        "SELECT count(*) AS total, \
+                count(*) FILTER (WHERE a.scheduled) AS scheduled, \
+                COALESCE(avg(b.priority), 0) AS mean_priority, \
+                COALESCE(percentile_cont(0.5) WITHIN GROUP (ORDER BY b.priority), 0) AS median_priority, \
+                COALESCE(avg(b.priority) FILTER (WHERE a.scheduled), 0) AS mean_priority_scheduled, \
+                COALESCE(avg(b.priority) FILTER (WHERE NOT a.scheduled), 0) AS mean_priority_unscheduled, \
+                COALESCE(sum(b.priority), 0) AS sum_priority_total, \
+                COALESCE(sum(b.priority) FILTER (WHERE a.scheduled), 0) AS sum_priority_scheduled, \
+                COALESCE(sum(a.total_visibility_hours), 0) AS total_visibility_hours, \
+                COALESCE(avg(a.requested_hours), 0) AS mean_requested_hours \
+         FROM {ANALYTICS_JOIN} \
+         WHERE {VISIBLE_FILTER}"
+    ))
+    .bind::<BigInt, _>(schedule_id)
+    .get_result::<MetricsRow>(conn)
+    .map_err(map_diesel_error)?;
+
+    let total_observations = m.total as usize;
+    let scheduled_count = m.scheduled as usize;
+    let metrics = AnalyticsMetrics {
+        total_observations,
+        scheduled_count,
+        unscheduled_count: total_observations - scheduled_count,
+        scheduling_rate: if total_observations > 0 {
+            scheduled_count as f64 / total_observations as f64
+        } else {
+            0.0
+        },
+        mean_priority: m.mean_priority,
+        median_priority: m.median_priority,
+        mean_priority_scheduled: m.mean_priority_scheduled,
+        mean_priority_unscheduled: m.mean_priority_unscheduled,
+        priority_capture_ratio: if m.sum_priority_total > 0.0 {
+            m.sum_priority_scheduled / m.sum_priority_total
+        } else {
+            0.0
+        },
+        sum_priority_scheduled: m.sum_priority_scheduled,
+        sum_priority_total: m.sum_priority_total,
+        total_visibility_hours: qtty::Hours::new(m.total_visibility_hours),
+        mean_requested_hours: qtty::Hours::new(m.mean_requested_hours),
+    };
+
+    let mut correlations = Vec::new();
+    if total_observations >= 2 {
+        let values = sql_query(correlation_sql)
+            .bind::<BigInt, _>(schedule_id)
+            .get_result::<CorrelationRow>(conn)
+            .map_err(map_diesel_error)?
+            .correlations;
+        let mut values = values.into_iter();
+        for i in 0..CORRELATION_COLUMNS.len() {
+            for j in (i + 1)..CORRELATION_COLUMNS.len() {
+                // `corr` is NULL when either column is constant.
+                let correlation = values.next().flatten().unwrap_or(0.0);
+                correlations.push(CorrelationEntry {
+                    variable1: CORRELATION_COLUMNS[i].0.to_string(),
+                    variable2: CORRELATION_COLUMNS[j].0.to_string(),
+                    correlation: correlation.clamp(-1.0, 1.0),
+                });
+            }
+        }
+    }
+
+    Ok(Some(InsightsData {
+        blocks: Vec::new(),
+        metrics,
+        correlations,
+        top_priority: top_observations(conn, schedule_id, false, top_n)?,
+        top_visibility: top_observations(conn, schedule_id, true, top_n)?,
+        conflicts: conflicts(conn, schedule_id)?,
+        total_count: total_observations,
+        scheduled_count,
+        impossible_count: 0,
+    }))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn correlation_query_covers_every_pair_in_service_order() {
+        let sql = correlation_query().expect("every correlation column has SQL");
+        let n = CORRELATION_COLUMNS.len();
+        assert_eq!(sql.matches("corr(").count(), n * (n - 1) / 2);
+        assert!(sql.contains("corr(r0, r1), corr(r0, r2)"));
+        assert!(sql.contains(&format!("AS r{}", n - 1)));
+    }
+}
@@ -0,0 +1,312 @@
+//! Async read path for the hottest Postgres queries.
+//!
+//! The Diesel path checks an r2d2 connection out on the blocking pool for
+//! every call, so under load each in-flight read holds both a blocking
+//! thread and a pool connection for its whole duration. This module serves
+//! the reads the analytics endpoints issue most (schedule columns, compare
+//! and timeline rows, gap metrics) through `tokio-postgres` instead: no
+//! blocking thread, cached prepared statements per connection, and
+//! independent statements of one call pipelined on the same connection
+//! (`tokio-postgres` sends queries that are polled together back to back
+//! without waiting for each response).
+//!
+//! Writes and the remaining reads stay on Diesel. Enabled by the
+//! `postgres-async` feature; [`PostgresRepository::without_async_reads`]
+//! turns it off for a single repository.
+
+use std::future::Future;
+use std::sync::atomic::Ordering;
+use std::time::{Duration, Instant};
+
+use deadpool_postgres::{ManagerConfig, Object, Pool, RecyclingMethod, Runtime};
+use serde_json::Value;
+use tokio_postgres::NoTls;
+
+use super::{json_to_period, value_to_periods, value_to_single_period};
+use super::{PostgresConfig, PostgresRepository};
+use crate::api::{
+    CompareBlock, ModifiedJulianDate, ScheduleId, ScheduleTimelineBlock, SchedulingBlockId,
+};
+use crate::db::repository::{ErrorContext, RepositoryError, RepositoryResult};
+use crate::models::{ScheduleColumns, ScheduleColumnsBuilder};
+
+/// Pool of `tokio-postgres` connections beside the Diesel pool.
+#[derive(Clone)]
+pub(super) struct AsyncPool(Pool);
+
+impl std::fmt::Debug for AsyncPool {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        let status = self.0.status();
+        f.debug_struct("AsyncPool")
+            .field("size", &status.size)
+            .field("available", &status.available)
+            .field("max_size", &status.max_size)
+            .finish()
+    }
+}
+
+impl AsyncPool {
+    /// Build the pool; connections are opened lazily on first use.
+    ///
+    /// Returns `None` (with a warning) if the URL cannot be used by
+    /// `tokio-postgres`, in which case every read stays on Diesel.
+    pub(super) fn new(config: &PostgresConfig) -> Option<Self> {
+        let mut pool_config = deadpool_postgres::Config::new();
+        pool_config.url = Some(config.database_url.clone());
+        pool_config.manager = Some(ManagerConfig {
+            recycling_method: RecyclingMethod::Fast,
+        });
+        let mut limits = deadpool_postgres::PoolConfig::new(config.max_pool_size as usize);
+        limits.timeouts.wait = Some(Duration::from_secs(config.connection_timeout_sec));
+        pool_config.pool = Some(limits);
+
+        match pool_config.create_pool(Some(Runtime::Tokio1), NoTls) {
+            Ok(pool) => Some(Self(pool)),
+            Err(e) => {
+                log::warn!(
+                    "Async Postgres reads disabled, using the blocking pool: {}",
+                    e
+                );
+                None
+            }
+        }
+    }
+}
+
+const SCHEDULE_HEADER_SQL: &str = "SELECT schedule_name, schedule_period_json, \
+     dark_periods_json, astronomical_night_periods_json \
+     FROM schedules WHERE schedule_id = $1";
+
+const SCHEDULE_COLUMNS_SQL: &str = "SELECT scheduling_block_id, original_block_id, block_name, \
+     priority, requested_duration_sec, visibility_periods_json, scheduled_periods_json \
+     FROM schedule_blocks WHERE schedule_id = $1 ORDER BY scheduling_block_id";
+
+const TIMELINE_SQL: &str = "SELECT b.scheduling_block_id, b.source_block_id, \
+     b.original_block_id, b.block_name, b.priority, a.scheduled_start_mjd, \
+     a.scheduled_stop_mjd, b.target_ra_deg, b.target_dec_deg, a.requested_hours, \
+     a.total_visibility_hours, a.num_visibility_periods \
+     FROM schedule_blocks b \
+     JOIN schedule_block_analytics a ON a.scheduling_block_id = b.scheduling_block_id \
+     WHERE b.schedule_id = $1 AND a.scheduled";
+
+const COMPARE_SQL: &str = "SELECT b.scheduling_block_id, b.original_block_id, b.block_name, \
+     b.priority, a.scheduled, a.requested_hours, a.scheduled_start_mjd, a.scheduled_stop_mjd \
+     FROM schedule_blocks b \
+     JOIN schedule_block_analytics a ON a.scheduling_block_id = b.scheduling_block_id \
+     WHERE b.schedule_id = $1";
+
+const GAP_METRICS_SQL: &str = "SELECT gap_count, gap_mean_hours, gap_median_hours \
+     FROM schedule_summary_analytics WHERE schedule_id = $1";
+
+impl PostgresRepository {
+    /// Async counterpart of `with_conn`: same retry policy, counters and
+    /// metrics, but awaiting the pool and the query instead of blocking.
+    async fn with_client<T, F, Fut>(&self, pool: &AsyncPool, op: F) -> RepositoryResult<T>
+    where
+        F: Fn(Object) -> Fut,
+        Fut: Future<Output = RepositoryResult<T>>,
+    {
+        let metrics = crate::metrics::global();
+        let max_retries = self.config.max_retries;
+        let mut retry_delay = Duration::from_millis(self.config.retry_delay_ms);
+        let mut last_error = None;
+
+        for attempt in 0..=max_retries {
+            if attempt > 0 {
+                self.retried_operations.fetch_add(1, Ordering::Relaxed);
+                tokio::time::sleep(retry_delay).await;
+                retry_delay *= 2; // Exponential backoff
+            }
+
+            let wait_started = Instant::now();
+            let client = pool.0.get().await;
+            metrics
+                .db_pool_wait
+                .observe_duration(wait_started.elapsed());
+            let client = match client {
+                Ok(c) => c,
+                Err(e) => {
+                    let err = RepositoryError::connection_with_context(
+                        e.to_string(),
+                        ErrorContext::new("get_async_connection")
+                            .with_details(format!("attempt={}", attempt + 1))
+                            .retryable(),
+                    );
+                    if attempt < max_retries {
+                        last_error = Some(err);
+                        continue;
+                    }
+                    self.failed_queries.fetch_add(1, Ordering::Relaxed);
+                    metrics.record_db_operation(false);
+                    return Err(err);
+                }
+            };
+
+            self.total_queries.fetch_add(1, Ordering::Relaxed);
+            let query_started = Instant::now();
+            let outcome = op(client).await;
+            metrics.db_query.observe_duration(query_started.elapsed());
+            match outcome {
+                Ok(result) => {
+                    metrics.record_db_operation(true);
+                    return Ok(result);
+                }
+                Err(e) if e.is_retryable() && attempt < max_retries => {
+                    last_error = Some(e);
+                    continue;
+                }
+                Err(e) => {
+                    self.failed_queries.fetch_add(1, Ordering::Relaxed);
+                    metrics.record_db_operation(false);
+                    return Err(e);
+                }
+            }
+        }
+
+        self.failed_queries.fetch_add(1, Ordering::Relaxed);
+        metrics.record_db_operation(false);
+        Err(last_error.unwrap_or_else(|| {
+            RepositoryError::internal("Max retries exceeded with no error captured")
+        }))
+    }
+
+    /// `get_schedule_columns`, with the schedule row and its block rows
+    /// pipelined on one connection.
+    pub(super) async fn schedule_columns_async(
+        &self,
+        pool: &AsyncPool,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<ScheduleColumns> {
+        self.with_client(pool, |client| async move {
+            let (header_stmt, columns_stmt) = tokio::try_join!(
+                client.prepare_cached(SCHEDULE_HEADER_SQL),
+                client.prepare_cached(SCHEDULE_COLUMNS_SQL),
+            )?;
+            let (header, rows) = tokio::try_join!(
+                client.query_opt(&header_stmt, &[&schedule_id.0]),
+                client.query(&columns_stmt, &[&schedule_id.0]),
+            )?;
+            let header = header.ok_or_else(|| {
+                RepositoryError::not_found(format!("Schedule {} not found", schedule_id))
+            })?;
+
+            let name: String = header.try_get(0)?;
+            let schedule_period =
+                json_to_period(&header.try_get::<_, Value>(1)?)?.ok_or_else(|| {
+                    RepositoryError::InternalError(
+                        "schedule_period_json is required but was null".to_string(),
+                    )
+                })?;
+
+            let mut builder =
+                ScheduleColumnsBuilder::new(Some(schedule_id.0), name, schedule_period)
+                    .with_capacity(rows.len());
+            builder.dark_periods = value_to_periods(&header.try_get::<_, Value>(2)?)?;
+            builder.astronomical_nights = value_to_periods(&header.try_get::<_, Value>(3)?)?;
+            for row in rows {
+                let original_block_id: Option<String> = row.try_get(1)?;
+                let block_name: String = row.try_get(2)?;
+                let requested: i32 = row.try_get(4)?;
+                builder.push_row(
+                    Some(SchedulingBlockId(row.try_get(0)?)),
+                    original_block_id.as_deref().unwrap_or_default(),
+                    &block_name,
+                    row.try_get(3)?,
+                    requested as f64,
+                    value_to_single_period(&row.try_get::<_, Value>(6)?)?,
+                    value_to_periods(&row.try_get::<_, Value>(5)?)?,
+                );
+            }
+            Ok(builder.finish())
+        })
+        .await
+    }
+
+    pub(super) async fn timeline_blocks_async(
+        &self,
+        pool: &AsyncPool,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<Vec<ScheduleTimelineBlock>> {
+        self.with_client(pool, |client| async move {
+            let stmt = client.prepare_cached(TIMELINE_SQL).await?;
+            let rows = client.query(&stmt, &[&schedule_id.0]).await?;
+
+            let mut blocks = Vec::with_capacity(rows.len());
+            for row in rows {
+                let (Some(start), Some(stop)) = (
+                    row.try_get::<_, Option<f64>>(5)?,
+                    row.try_get::<_, Option<f64>>(6)?,
+                ) else {
+                    continue;
+                };
+                let original_block_id: Option<String> = row.try_get(2)?;
+                blocks.push(ScheduleTimelineBlock {
+                    scheduling_block_id: row.try_get(0)?,
+                    original_block_id: match original_block_id {
+                        Some(id) => id,
+                        None => row.try_get::<_, i64>(1)?.to_string(),
+                    },
+                    block_name: row.try_get(3)?,
+                    priority: row.try_get(4)?,
+                    scheduled_start_mjd: ModifiedJulianDate::new(start),
+                    scheduled_stop_mjd: ModifiedJulianDate::new(stop),
+                    ra_deg: qtty::Degrees::new(row.try_get(7)?),
+                    dec_deg: qtty::Degrees::new(row.try_get(8)?),
+                    requested_hours: qtty::time::Hours::new(row.try_get(9)?),
+                    total_visibility_hours: qtty::time::Hours::new(row.try_get(10)?),
+                    num_visibility_periods: row.try_get::<_, i32>(11)? as usize,
+                });
+            }
+            Ok(blocks)
+        })
+        .await
+    }
+
+    pub(super) async fn compare_blocks_async(
+        &self,
+        pool: &AsyncPool,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<Vec<CompareBlock>> {
+        self.with_client(pool, |client| async move {
+            let stmt = client.prepare_cached(COMPARE_SQL).await?;
+            let rows = client.query(&stmt, &[&schedule_id.0]).await?;
+
+            rows.into_iter()
+                .map(|row| {
+                    Ok(CompareBlock {
+                        scheduling_block_id: row.try_get::<_, i64>(0)?.to_string(),
+                        original_block_id: row.try_get::<_, Option<String>>(1)?.unwrap_or_default(),
+                        block_name: row.try_get(2)?,
+                        priority: row.try_get(3)?,
+                        scheduled: row.try_get(4)?,
+                        requested_hours: row.try_get::<_, f64>(5)?.into(),
+                        scheduled_start_mjd: row.try_get(6)?,
+                        scheduled_stop_mjd: row.try_get(7)?,
+                    })
+                })
+                .collect()
+        })
+        .await
+    }
+
+    pub(super) async fn gap_metrics_async(
+        &self,
+        pool: &AsyncPool,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<(Option<i32>, Option<qtty::Hours>, Option<qtty::Hours>)> {
+        self.with_client(pool, |client| async move {
+            let stmt = client.prepare_cached(GAP_METRICS_SQL).await?;
+            let row = client.query_opt(&stmt, &[&schedule_id.0]).await?;
+
+            Ok(match row {
+                Some(row) => (
+                    row.try_get(0)?,
+                    row.try_get::<_, Option<f64>>(1)?.map(qtty::Hours::new),
+                    row.try_get::<_, Option<f64>>(2)?.map(qtty::Hours::new),
+                ),
+                None => (None, None, None),
+            })
+        })
+        .await
+    }
+}
@@ -0,0 +1,180 @@
+//! Bulk ingest for the per-block tables.
+//!
+//! A schedule with 100k blocks produces as many block, analytics and
+//! validation rows. Binary `COPY ... FROM STDIN` streams each table in a
+//! single statement instead of hundreds of parameter-limited `INSERT`
+//! batches that the server has to parse and plan one by one.
+//!
+//! COPY runs inside a savepoint: if it is rejected (e.g. by a pooler that
+//! does not support the COPY sub-protocol) the savepoint is rolled back and
+//! the same rows go through chunked `INSERT`s, leaving the surrounding
+//! transaction intact.
+
+use std::time::{Duration, Instant};
+
+use diesel::pg::PgConnection;
+use diesel::prelude::*;
+
+/// Rows per `INSERT` on the fallback path; keeps the widest row type well
+/// under Postgres's 65535 bind-parameter limit.
+pub(super) const INSERT_CHUNK_ROWS: usize = 1000;
+
+/// How a batch of rows reached its table.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub(super) enum IngestMethod {
+    Copy,
+    Insert,
+}
+
+impl IngestMethod {
+    fn as_str(self) -> &'static str {
+        match self {
+            IngestMethod::Copy => "COPY",
+            IngestMethod::Insert => "INSERT",
+        }
+    }
+}
+
+/// Outcome of one [`copy_or_insert`] call.
+#[derive(Debug, Clone, Copy)]
+pub(super) struct IngestStats {
+    pub rows: usize,
+    pub method: IngestMethod,
+    pub elapsed: Duration,
+}
+
+impl IngestStats {
+    pub fn rows_per_sec(&self) -> f64 {
+        let secs = self.elapsed.as_secs_f64();
+        if secs > 0.0 {
+            self.rows as f64 / secs
+        } else {
+            self.rows as f64
+        }
+    }
+}
+
+/// Write `rows` with `copy`, falling back to `insert` over
+/// [`INSERT_CHUNK_ROWS`]-sized chunks when COPY fails or `use_copy` is off.
+///
+/// `copy` runs in a savepoint, so it may also clear rows it replaces (the
+/// analytics upsert has no COPY equivalent) without affecting the fallback.
+pub(super) fn copy_or_insert<R>(
+    conn: &mut PgConnection,
+    use_copy: bool,
+    table: &str,
+    rows: &[R],
+    copy: impl Fn(&mut PgConnection, &[R]) -> QueryResult<usize>,
+    insert: impl Fn(&mut PgConnection, &[R]) -> QueryResult<usize>,
+) -> QueryResult<IngestStats> {
+    let started = Instant::now();
+    if rows.is_empty() {
+        return Ok(IngestStats {
+            rows: 0,
+            method: IngestMethod::Copy,
+            elapsed: started.elapsed(),
+        });
+    }
+
+    let copied = if use_copy {
+        conn.transaction::<_, diesel::result::Error, _>(|sp| copy(sp, rows))
+            .map_err(|e| {
+                log::warn!(
+                    "COPY into {} failed ({}); falling back to batched INSERT",
+                    table,
+                    e
+                );
+            })
+    } else {
+        Err(())
+    };
+    let (inserted, method) = match copied {
+        Ok(n) => (n, IngestMethod::Copy),
+        Err(()) => {
+            let mut n = 0;
+            for chunk in rows.chunks(INSERT_CHUNK_ROWS) {
+                n += insert(conn, chunk)?;
+            }
+            (n, IngestMethod::Insert)
+        }
+    };
+
+    let stats = IngestStats {
+        rows: inserted,
+        method,
+        elapsed: started.elapsed(),
+    };
+    log::info!(
+        "Ingested {} rows into {} via {} in {:.2}s ({:.0} rows/s)",
+        stats.rows,
+        table,
+        stats.method.as_str(),
+        stats.elapsed.as_secs_f64(),
+        stats.rows_per_sec()
+    );
+    Ok(stats)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_rows_per_sec() {
+        let stats = IngestStats {
+            rows: 50_000,
+            method: IngestMethod::Copy,
+            elapsed: Duration::from_millis(500),
+        };
+        assert_eq!(stats.rows_per_sec(), 100_000.0);
+
+        let instant = IngestStats {
+            elapsed: Duration::ZERO,
+            ..stats
+        };
+        assert_eq!(instant.rows_per_sec(), 50_000.0);
+    }
+
+    /// Needs `DATABASE_URL`; skipped otherwise.
+    #[test]
+    fn test_failed_copy_falls_back_inside_the_transaction() {
+        use diesel::sql_types::{BigInt, Integer};
+
+        #[derive(QueryableByName)]
+        struct Count {
+            #[diesel(sql_type = BigInt)]
+            n: i64,
+        }
+
+        let Ok(url) = std::env::var("DATABASE_URL") else {
+            return;
+        };
+        let mut conn = PgConnection::establish(&url).expect("Should connect");
+        conn.test_transaction::<_, diesel::result::Error, _>(|conn| {
+            diesel::sql_query("CREATE TEMP TABLE ingest_probe (v INT NOT NULL)").execute(conn)?;
+            let stats = copy_or_insert(
+                conn,
+                true,
+                "ingest_probe",
+                &[1, 2, 3],
+                |c, _| diesel::sql_query("COPY no_such_table FROM STDIN").execute(c),
+                |c, chunk| {
+                    for v in chunk {
+                        diesel::sql_query("INSERT INTO ingest_probe VALUES ($1)")
+                            .bind::<Integer, _>(*v)
+                            .execute(c)?;
+                    }
+                    Ok(chunk.len())
+                },
+            )?;
+            assert_eq!(stats.method, IngestMethod::Insert);
+            assert_eq!(stats.rows, 3);
+
+            // Only the savepoint was rolled back.
+            let count: Count =
+                diesel::sql_query("SELECT count(*) AS n FROM ingest_probe").get_result(conn)?;
+            assert_eq!(count.n, 3);
+            Ok(())
+        });
+    }
+}
@@ -0,0 +1,3 @@
+DROP INDEX IF EXISTS schedule_block_analytics_scheduled_keyset_idx;
+DROP INDEX IF EXISTS schedule_block_analytics_periods_keyset_idx;
+DROP INDEX IF EXISTS schedule_blocks_priority_keyset_idx;
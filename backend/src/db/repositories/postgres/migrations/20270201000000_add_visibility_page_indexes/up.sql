@@ -0,0 +1,15 @@
+-- Keyset pagination for the visibility-map block table.
+--
+-- `fetch_visibility_blocks_page` orders a schedule's blocks by one sort key
+-- with the block id as tie-breaker and resumes after the last (key, id)
+-- pair it returned.  These indexes let each page be an index range scan
+-- instead of a sort of every block in the schedule.
+
+CREATE INDEX IF NOT EXISTS schedule_blocks_priority_keyset_idx
+    ON schedule_blocks (schedule_id, priority, scheduling_block_id);
+
+CREATE INDEX IF NOT EXISTS schedule_block_analytics_periods_keyset_idx
+    ON schedule_block_analytics (schedule_id, num_visibility_periods, scheduling_block_id);
+
+CREATE INDEX IF NOT EXISTS schedule_block_analytics_scheduled_keyset_idx
+    ON schedule_block_analytics (schedule_id, scheduled, scheduling_block_id);
@@ -0,0 +1,8 @@
+-- Per-schedule version of everything derived from a schedule.
+--
+-- Analytics, validation results, algorithm traces, metadata edits and
+-- environment (un)assignment all advance `data_version` in the same
+-- transaction, so HTTP validators built from it are shared by every
+-- replica and change whenever a cached analytics response would.
+ALTER TABLE schedules
+    ADD COLUMN IF NOT EXISTS data_version BIGINT NOT NULL DEFAULT 1;
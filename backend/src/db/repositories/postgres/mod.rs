@@ -9,6 +9,8 @@
 //! - Automatic retry for transient failures
 //! - Connection health monitoring
 //! - Automatic migration execution
+//! - With the `postgres-async` feature, hot reads served through
+//!   `tokio-postgres` without the blocking pool (see [`async_reads`])
 //!
 //! ## Configuration
 //!
@@ -32,25 +34,33 @@ use serde_json::{json, Value};
 use std::collections::HashSet;
 use std::sync::atomic::{AtomicU64, Ordering};
 use std::time::{Duration, Instant};
-use tokio::task;
 
 use crate::api::{
     AlgorithmTraceIteration, AlgorithmTraceResponse, AlgorithmTraceSummary, CompareBlock,
-    Constraints, DistributionBlock, InsightsBlock, LightweightBlock, ModifiedJulianDate, Period,
-    Schedule, ScheduleId, ScheduleInfo, ScheduleTimelineBlock, SchedulingBlock, SchedulingBlockId,
-    VisibilityBlockSummary, VisibilityMapData,
+    Constraints, DistributionBlock, DistributionData, InsightsBlock, InsightsData,
+    LightweightBlock, ModifiedJulianDate, Period, Schedule, ScheduleId, ScheduleInfo,
+    ScheduleTimelineBlock, SchedulingBlock, SchedulingBlockId, SortDirection,
+    VisibilityBlockCursor, VisibilityBlockSort, VisibilityBlockSummary, VisibilityBlocksPage,
+    VisibilityBlocksQuery, VisibilityMapData,
 };
 use crate::db::repository::{
     AlgorithmTraceRepository, AnalyticsRepository, ErrorContext, RepositoryError, RepositoryResult,
     ScheduleRepository, ValidationRepository, VisualizationRepository,
 };
+use crate::models::{ScheduleColumns, ScheduleColumnsBuilder};
 use crate::services::validation::{
     validate_blocks, BlockForValidation, ValidationResult, ValidationStatus,
 };
+use crate::services::visibility_blocks::MAX_VISIBILITY_PAGE_SIZE;
 
+mod aggregates;
+#[cfg(feature = "postgres-async")]
+mod async_reads;
+mod bulk_ingest;
 mod models;
 mod schema;
 
+use bulk_ingest::copy_or_insert;
 use models::*;
 use schema::*;
 
@@ -75,6 +85,9 @@ pub struct PostgresConfig {
     pub max_retries: u32,
     /// Initial retry delay in milliseconds (doubles with each retry)
     pub retry_delay_ms: u64,
+    /// Ingest per-block rows with `COPY`; `false` always uses batched
+    /// `INSERT`s (e.g. behind a pooler without COPY support)
+    pub bulk_copy: bool,
 }
 
 impl Default for PostgresConfig {
@@ -95,6 +108,7 @@ impl Default for PostgresConfig {
             idle_timeout_sec: 600,
             max_retries: 3,
             retry_delay_ms: 100,
+            bulk_copy: true,
         }
     }
 }
@@ -113,6 +127,7 @@ impl PostgresConfig {
     /// - `PG_IDLE_TIMEOUT_SEC`: Idle connection timeout in seconds (default: 600)
     /// - `PG_MAX_RETRIES`: Maximum retry attempts (default: 3)
     /// - `PG_RETRY_DELAY_MS`: Initial retry delay in milliseconds (default: 100)
+    /// - `PG_BULK_COPY`: Ingest per-block rows with `COPY` (default: true)
     pub fn from_env() -> Result<Self, String> {
         let database_url = std::env::var("DATABASE_URL")
             .or_else(|_| std::env::var("PG_DATABASE_URL"))
@@ -148,6 +163,11 @@ impl PostgresConfig {
             .and_then(|v| v.parse::<u64>().ok())
             .unwrap_or(100);
 
+        let bulk_copy = std::env::var("PG_BULK_COPY")
+            .ok()
+            .and_then(|v| v.parse::<bool>().ok())
+            .unwrap_or(true);
+
         Ok(Self {
             database_url,
             max_pool_size,
@@ -156,6 +176,7 @@ impl PostgresConfig {
             idle_timeout_sec,
             max_retries,
             retry_delay_ms,
+            bulk_copy,
         })
     }
 
@@ -202,6 +223,9 @@ pub struct PostgresRepository {
     total_queries: std::sync::Arc<AtomicU64>,
     failed_queries: std::sync::Arc<AtomicU64>,
     retried_operations: std::sync::Arc<AtomicU64>,
+    // Non-blocking pool for the hot reads; None falls back to Diesel.
+    #[cfg(feature = "postgres-async")]
+    async_pool: Option<async_reads::AsyncPool>,
 }
 
 impl PostgresRepository {
@@ -244,13 +268,23 @@ impl PostgresRepository {
 
         Ok(Self {
             pool,
-            config,
             total_queries: std::sync::Arc::new(AtomicU64::new(0)),
             failed_queries: std::sync::Arc::new(AtomicU64::new(0)),
             retried_operations: std::sync::Arc::new(AtomicU64::new(0)),
+            #[cfg(feature = "postgres-async")]
+            async_pool: async_reads::AsyncPool::new(&config),
+            config,
         })
     }
 
+    /// Serve every read through the blocking Diesel pool, e.g. to compare
+    /// against the async path.
+    #[cfg(feature = "postgres-async")]
+    pub fn without_async_reads(mut self) -> Self {
+        self.async_pool = None;
+        self
+    }
+
     /// Run pending database migrations.
     fn run_migrations(conn: &mut PgConnection) -> RepositoryResult<()> {
         conn.run_pending_migrations(MIGRATIONS).map_err(|e| {
@@ -279,7 +313,8 @@ impl PostgresRepository {
         let failed_queries = self.failed_queries.clone();
         let retried_operations = self.retried_operations.clone();
 
-        task::spawn_blocking(move || {
+        crate::metrics::spawn_blocking(move || {
+            let metrics = crate::metrics::global();
             let mut last_error = None;
             let mut retry_delay = Duration::from_millis(retry_delay_ms);
 
@@ -291,7 +326,12 @@ impl PostgresRepository {
                 }
 
                 // Get connection
-                let mut conn = match pool.get() {
+                let wait_started = Instant::now();
+                let conn = pool.get();
+                metrics
+                    .db_pool_wait
+                    .observe_duration(wait_started.elapsed());
+                let mut conn = match conn {
                     Ok(c) => c,
                     Err(e) => {
                         let err = RepositoryError::connection_with_context(
@@ -305,26 +345,35 @@ impl PostgresRepository {
                             continue;
                         }
                         failed_queries.fetch_add(1, Ordering::Relaxed);
+                        metrics.record_db_operation(false);
                         return Err(err);
                     }
                 };
 
                 // Execute the operation
                 total_queries.fetch_add(1, Ordering::Relaxed);
-                match f.clone()(&mut conn) {
-                    Ok(result) => return Ok(result),
+                let query_started = Instant::now();
+                let outcome = f.clone()(&mut conn);
+                metrics.db_query.observe_duration(query_started.elapsed());
+                match outcome {
+                    Ok(result) => {
+                        metrics.record_db_operation(true);
+                        return Ok(result);
+                    }
                     Err(e) if e.is_retryable() && attempt < max_retries => {
                         last_error = Some(e);
                         continue;
                     }
                     Err(e) => {
                         failed_queries.fetch_add(1, Ordering::Relaxed);
+                        metrics.record_db_operation(false);
                         return Err(e);
                     }
                 }
             }
 
             failed_queries.fetch_add(1, Ordering::Relaxed);
+            metrics.record_db_operation(false);
             Err(last_error.unwrap_or_else(|| {
                 RepositoryError::internal("Max retries exceeded with no error captured")
             }))
@@ -386,6 +435,18 @@ fn map_diesel_error(err: diesel::result::Error) -> RepositoryError {
     RepositoryError::from(err)
 }
 
+/// Escape `%`, `_` and `\` so user text matches literally inside ILIKE.
+fn escape_like(text: &str) -> String {
+    let mut escaped = String::with_capacity(text.len());
+    for c in text.chars() {
+        if matches!(c, '%' | '_' | '\\') {
+            escaped.push('\\');
+        }
+        escaped.push(c);
+    }
+    escaped
+}
+
 fn periods_to_json(periods: &[Period]) -> Value {
     serde_json::to_value(periods).unwrap_or_else(|_| json!([]))
 }
@@ -443,6 +504,42 @@ fn priority_bucket(priority: f64) -> i16 {
     }
 }
 
+/// Advance a schedule's `data_version`, which backs
+/// [`schedule_version`](ScheduleRepository::schedule_version). Called in
+/// the transaction of every write that changes what the schedule's
+/// analytics endpoints return.
+fn bump_data_version(conn: &mut PgConnection, schedule_id: i64) -> RepositoryResult<()> {
+    diesel::update(schedules::table.filter(schedules::schedule_id.eq(schedule_id)))
+        .set(schedules::data_version.eq(schedules::data_version + 1))
+        .execute(conn)
+        .map_err(map_diesel_error)?;
+    Ok(())
+}
+
+/// COPY half of the validation-results ingest shared by analytics
+/// population and `insert_validation_results`.
+fn copy_validation_rows(
+    conn: &mut PgConnection,
+    rows: &[NewScheduleValidationResultRow],
+) -> QueryResult<usize> {
+    diesel::copy_from(schedule_validation_results::table)
+        .from_insertable(
+            rows.iter()
+                .map(CopyScheduleValidationResultRow::from)
+                .collect::<Vec<_>>(),
+        )
+        .execute(conn)
+}
+
+fn insert_validation_rows(
+    conn: &mut PgConnection,
+    rows: &[NewScheduleValidationResultRow],
+) -> QueryResult<usize> {
+    diesel::insert_into(schedule_validation_results::table)
+        .values(rows)
+        .execute(conn)
+}
+
 fn row_to_block(row: ScheduleBlockRow) -> RepositoryResult<SchedulingBlock> {
     let constraints = Constraints {
         min_alt: row
@@ -710,6 +807,7 @@ impl ScheduleRepository for PostgresRepository {
         schedule: &Schedule,
     ) -> RepositoryResult<crate::api::ScheduleInfo> {
         let schedule = schedule.clone();
+        let bulk_copy = self.config.bulk_copy;
         self.with_conn(move |conn| {
             conn.transaction(|tx| {
                 // Idempotency: return existing schedule if checksum matches
@@ -794,18 +892,27 @@ impl ScheduleRepository for PostgresRepository {
                     })
                     .collect();
 
-                if !block_rows.is_empty() {
-                    // Insert blocks in chunks to avoid exceeding Postgres parameter limits
-                    // (very large schedules can generate more than 65535 parameters in a single
-                    // prepared statement). Choose a conservative chunk size.
-                    let chunk_size: usize = 1000;
-                    for chunk in block_rows.chunks(chunk_size) {
+                copy_or_insert(
+                    tx,
+                    bulk_copy,
+                    "schedule_blocks",
+                    &block_rows,
+                    |c, rows| {
+                        diesel::copy_from(schedule_blocks::table)
+                            .from_insertable(
+                                rows.iter()
+                                    .map(CopyScheduleBlockRow::from)
+                                    .collect::<Vec<_>>(),
+                            )
+                            .execute(c)
+                    },
+                    |c, chunk| {
                         diesel::insert_into(schedule_blocks::table)
                             .values(chunk)
-                            .execute(tx)
-                            .map_err(map_diesel_error)?;
-                    }
-                }
+                            .execute(c)
+                    },
+                )
+                .map_err(map_diesel_error)?;
 
                 Ok(ScheduleInfo {
                     schedule_id: ScheduleId(inserted.schedule_id),
@@ -1002,6 +1109,71 @@ impl ScheduleRepository for PostgresRepository {
         .await
     }
 
+    async fn get_schedule_columns(
+        &self,
+        schedule_id: crate::api::ScheduleId,
+    ) -> RepositoryResult<ScheduleColumns> {
+        #[cfg(feature = "postgres-async")]
+        if let Some(pool) = &self.async_pool {
+            return self.schedule_columns_async(pool, schedule_id).await;
+        }
+        self.with_conn(move |conn| {
+            let (name, period_json, dark_json, nights_json): (String, Value, Value, Value) =
+                schedules::table
+                    .filter(schedules::schedule_id.eq(schedule_id.0))
+                    .select((
+                        schedules::schedule_name,
+                        schedules::schedule_period_json,
+                        schedules::dark_periods_json,
+                        schedules::astronomical_night_periods_json,
+                    ))
+                    .first(conn)
+                    .map_err(map_diesel_error)?;
+            let schedule_period = json_to_period(&period_json)?.ok_or_else(|| {
+                RepositoryError::InternalError(
+                    "schedule_period_json is required but was null".to_string(),
+                )
+            })?;
+
+            // Only the columns the analytics read; constraints stay behind.
+            let rows = schedule_blocks::table
+                .filter(schedule_blocks::schedule_id.eq(schedule_id.0))
+                .select((
+                    schedule_blocks::scheduling_block_id,
+                    schedule_blocks::original_block_id,
+                    schedule_blocks::block_name,
+                    schedule_blocks::priority,
+                    schedule_blocks::requested_duration_sec,
+                    schedule_blocks::visibility_periods_json,
+                    schedule_blocks::scheduled_periods_json,
+                ))
+                .order(schedule_blocks::scheduling_block_id.asc())
+                .load::<(i64, Option<String>, String, f64, i32, Value, Value)>(conn)
+                .map_err(map_diesel_error)?;
+
+            let mut builder =
+                ScheduleColumnsBuilder::new(Some(schedule_id.0), name, schedule_period)
+                    .with_capacity(rows.len());
+            builder.dark_periods = value_to_periods(&dark_json)?;
+            builder.astronomical_nights = value_to_periods(&nights_json)?;
+            for (id, original_block_id, block_name, priority, requested, visibility, scheduled) in
+                rows
+            {
+                builder.push_row(
+                    Some(SchedulingBlockId(id)),
+                    original_block_id.as_deref().unwrap_or_default(),
+                    &block_name,
+                    priority,
+                    requested as f64,
+                    value_to_single_period(&scheduled)?,
+                    value_to_periods(&visibility)?,
+                );
+            }
+            Ok(builder.finish())
+        })
+        .await
+    }
+
     async fn fetch_dark_periods(
         &self,
         schedule_id: crate::api::ScheduleId,
@@ -1101,7 +1273,10 @@ impl ScheduleRepository for PostgresRepository {
 
             if let Some(ref name) = new_name {
                 diesel::update(schedules::table.filter(schedules::schedule_id.eq(schedule_id.0)))
-                    .set(schedules::schedule_name.eq(name))
+                    .set((
+                        schedules::schedule_name.eq(name),
+                        schedules::data_version.eq(schedules::data_version + 1),
+                    ))
                     .execute(conn)
                     .map_err(map_diesel_error)?;
             }
@@ -1111,7 +1286,10 @@ impl ScheduleRepository for PostgresRepository {
                     map_diesel_error(diesel::result::Error::SerializationError(Box::new(e)))
                 })?;
                 diesel::update(schedules::table.filter(schedules::schedule_id.eq(schedule_id.0)))
-                    .set(schedules::observer_location_json.eq(loc_json))
+                    .set((
+                        schedules::observer_location_json.eq(loc_json),
+                        schedules::data_version.eq(schedules::data_version + 1),
+                    ))
                     .execute(conn)
                     .map_err(map_diesel_error)?;
             }
@@ -1151,6 +1329,30 @@ impl ScheduleRepository for PostgresRepository {
         })
         .await
     }
+
+    async fn schedule_version(
+        &self,
+        schedule_id: crate::api::ScheduleId,
+    ) -> RepositoryResult<Option<String>> {
+        self.with_conn(move |conn| {
+            let row = schedules::table
+                .filter(schedules::schedule_id.eq(schedule_id.0))
+                .select((schedules::checksum, schedules::data_version))
+                .first::<(String, i64)>(conn)
+                .optional()
+                .map_err(map_diesel_error)?;
+            // The checksum prefix keeps versions distinct should ids be
+            // handed out again, e.g. after the database is recreated.
+            Ok(row.map(|(checksum, version)| {
+                format!(
+                    "{}.{}",
+                    checksum.chars().take(16).collect::<String>(),
+                    version
+                )
+            }))
+        })
+        .await
+    }
 }
 
 #[async_trait]
@@ -1159,6 +1361,7 @@ impl AnalyticsRepository for PostgresRepository {
         &self,
         schedule_id: crate::api::ScheduleId,
     ) -> RepositoryResult<usize> {
+        let bulk_copy = self.config.bulk_copy;
         self.with_conn(move |conn| {
             conn.transaction(|tx| {
                 let block_rows = schedule_blocks::table
@@ -1256,35 +1459,59 @@ impl AnalyticsRepository for PostgresRepository {
                         impossible_block_ids.contains(&row.scheduling_block_id);
                 }
 
-                diesel::insert_into(schedule_block_analytics::table)
-                    .values(&analytics_rows)
-                    .on_conflict((
-                        schedule_block_analytics::schedule_id,
-                        schedule_block_analytics::scheduling_block_id,
-                    ))
-                    .do_update()
-                    .set((
-                        schedule_block_analytics::priority_bucket
-                            .eq(excluded(schedule_block_analytics::priority_bucket)),
-                        schedule_block_analytics::requested_hours
-                            .eq(excluded(schedule_block_analytics::requested_hours)),
-                        schedule_block_analytics::total_visibility_hours
-                            .eq(excluded(schedule_block_analytics::total_visibility_hours)),
-                        schedule_block_analytics::num_visibility_periods
-                            .eq(excluded(schedule_block_analytics::num_visibility_periods)),
-                        schedule_block_analytics::elevation_range_deg
-                            .eq(excluded(schedule_block_analytics::elevation_range_deg)),
-                        schedule_block_analytics::scheduled
-                            .eq(excluded(schedule_block_analytics::scheduled)),
-                        schedule_block_analytics::scheduled_start_mjd
-                            .eq(excluded(schedule_block_analytics::scheduled_start_mjd)),
-                        schedule_block_analytics::scheduled_stop_mjd
-                            .eq(excluded(schedule_block_analytics::scheduled_stop_mjd)),
-                        schedule_block_analytics::validation_impossible
-                            .eq(excluded(schedule_block_analytics::validation_impossible)),
-                    ))
-                    .execute(tx)
-                    .map_err(map_diesel_error)?;
+                // COPY cannot upsert: replace the schedule's rows instead,
+                // which is equivalent since every block is recomputed here.
+                copy_or_insert(
+                    tx,
+                    bulk_copy,
+                    "schedule_block_analytics",
+                    &analytics_rows,
+                    |c, rows| {
+                        diesel::delete(
+                            schedule_block_analytics::table
+                                .filter(schedule_block_analytics::schedule_id.eq(schedule_id.0)),
+                        )
+                        .execute(c)?;
+                        diesel::copy_from(schedule_block_analytics::table)
+                            .from_insertable(
+                                rows.iter()
+                                    .map(CopyScheduleBlockAnalyticsRow::from)
+                                    .collect::<Vec<_>>(),
+                            )
+                            .execute(c)
+                    },
+                    |c, chunk| {
+                        diesel::insert_into(schedule_block_analytics::table)
+                            .values(chunk)
+                            .on_conflict((
+                                schedule_block_analytics::schedule_id,
+                                schedule_block_analytics::scheduling_block_id,
+                            ))
+                            .do_update()
+                            .set((
+                                schedule_block_analytics::priority_bucket
+                                    .eq(excluded(schedule_block_analytics::priority_bucket)),
+                                schedule_block_analytics::requested_hours
+                                    .eq(excluded(schedule_block_analytics::requested_hours)),
+                                schedule_block_analytics::total_visibility_hours
+                                    .eq(excluded(schedule_block_analytics::total_visibility_hours)),
+                                schedule_block_analytics::num_visibility_periods
+                                    .eq(excluded(schedule_block_analytics::num_visibility_periods)),
+                                schedule_block_analytics::elevation_range_deg
+                                    .eq(excluded(schedule_block_analytics::elevation_range_deg)),
+                                schedule_block_analytics::scheduled
+                                    .eq(excluded(schedule_block_analytics::scheduled)),
+                                schedule_block_analytics::scheduled_start_mjd
+                                    .eq(excluded(schedule_block_analytics::scheduled_start_mjd)),
+                                schedule_block_analytics::scheduled_stop_mjd
+                                    .eq(excluded(schedule_block_analytics::scheduled_stop_mjd)),
+                                schedule_block_analytics::validation_impossible
+                                    .eq(excluded(schedule_block_analytics::validation_impossible)),
+                            ))
+                            .execute(c)
+                    },
+                )
+                .map_err(map_diesel_error)?;
 
                 // Persist validation results (one-or-more per block, including "valid").
                 diesel::delete(
@@ -1310,12 +1537,15 @@ impl AnalyticsRepository for PostgresRepository {
                     })
                     .collect();
 
-                if !new_validation_rows.is_empty() {
-                    diesel::insert_into(schedule_validation_results::table)
-                        .values(&new_validation_rows)
-                        .execute(tx)
-                        .map_err(map_diesel_error)?;
-                }
+                copy_or_insert(
+                    tx,
+                    bulk_copy,
+                    "schedule_validation_results",
+                    &new_validation_rows,
+                    copy_validation_rows,
+                    insert_validation_rows,
+                )
+                .map_err(map_diesel_error)?;
 
                 let summary_row =
                     compute_summary_metrics(schedule_id.0, &block_rows, &analytics_rows);
@@ -1359,6 +1589,7 @@ impl AnalyticsRepository for PostgresRepository {
                     .execute(tx)
                     .map_err(map_diesel_error)?;
 
+                bump_data_version(tx, schedule_id.0)?;
                 Ok(analytics_rows.len())
             })
         })
@@ -1385,6 +1616,7 @@ impl AnalyticsRepository for PostgresRepository {
                 .execute(tx)
                 .map_err(map_diesel_error)?;
 
+                bump_data_version(tx, schedule_id.0)?;
                 Ok(deleted)
             })
         })
@@ -1602,6 +1834,26 @@ impl AnalyticsRepository for PostgresRepository {
         })
         .await
     }
+
+    async fn fetch_distribution_summary(
+        &self,
+        schedule_id: crate::api::ScheduleId,
+        bins: Option<usize>,
+    ) -> RepositoryResult<Option<DistributionData>> {
+        self.with_conn(move |conn| {
+            aggregates::distribution_summary(conn, schedule_id.0, bins).map(Some)
+        })
+        .await
+    }
+
+    async fn fetch_insights_summary(
+        &self,
+        schedule_id: crate::api::ScheduleId,
+        top_n: usize,
+    ) -> RepositoryResult<Option<InsightsData>> {
+        self.with_conn(move |conn| aggregates::insights_summary(conn, schedule_id.0, top_n))
+            .await
+    }
 }
 
 #[async_trait]
@@ -1611,6 +1863,7 @@ impl ValidationRepository for PostgresRepository {
         results: &[ValidationResult],
     ) -> RepositoryResult<usize> {
         let results = results.to_vec();
+        let bulk_copy = self.config.bulk_copy;
         self.with_conn(move |conn| {
             conn.transaction(|tx| {
                 if results.is_empty() {
@@ -1642,10 +1895,16 @@ impl ValidationRepository for PostgresRepository {
                     })
                     .collect();
 
-                let inserted = diesel::insert_into(schedule_validation_results::table)
-                    .values(&new_rows)
-                    .execute(tx)
-                    .map_err(map_diesel_error)?;
+                let inserted = copy_or_insert(
+                    tx,
+                    bulk_copy,
+                    "schedule_validation_results",
+                    &new_rows,
+                    copy_validation_rows,
+                    insert_validation_rows,
+                )
+                .map_err(map_diesel_error)?
+                .rows;
 
                 // Reset validation flags before marking impossible blocks
                 diesel::update(
@@ -1676,6 +1935,7 @@ impl ValidationRepository for PostgresRepository {
                     .map_err(map_diesel_error)?;
                 }
 
+                bump_data_version(tx, schedule_id)?;
                 Ok(inserted)
             })
         })
@@ -1801,13 +2061,16 @@ impl ValidationRepository for PostgresRepository {
         schedule_id: crate::api::ScheduleId,
     ) -> RepositoryResult<u64> {
         self.with_conn(move |conn| {
-            let deleted = diesel::delete(
-                schedule_validation_results::table
-                    .filter(schedule_validation_results::schedule_id.eq(schedule_id.0)),
-            )
-            .execute(conn)
-            .map_err(map_diesel_error)?;
-            Ok(deleted as u64)
+            conn.transaction(|tx| {
+                let deleted = diesel::delete(
+                    schedule_validation_results::table
+                        .filter(schedule_validation_results::schedule_id.eq(schedule_id.0)),
+                )
+                .execute(tx)
+                .map_err(map_diesel_error)?;
+                bump_data_version(tx, schedule_id.0)?;
+                Ok(deleted as u64)
+            })
         })
         .await
     }
@@ -1819,6 +2082,10 @@ impl VisualizationRepository for PostgresRepository {
         &self,
         schedule_id: crate::api::ScheduleId,
     ) -> RepositoryResult<Vec<ScheduleTimelineBlock>> {
+        #[cfg(feature = "postgres-async")]
+        if let Some(pool) = &self.async_pool {
+            return self.timeline_blocks_async(pool, schedule_id).await;
+        }
         self.with_conn(move |conn| {
             let rows = schedule_blocks::table
                 .inner_join(
@@ -1904,6 +2171,10 @@ impl VisualizationRepository for PostgresRepository {
         &self,
         schedule_id: crate::api::ScheduleId,
     ) -> RepositoryResult<Vec<CompareBlock>> {
+        #[cfg(feature = "postgres-async")]
+        if let Some(pool) = &self.async_pool {
+            return self.compare_blocks_async(pool, schedule_id).await;
+        }
         self.with_conn(move |conn| {
             let rows = schedule_blocks::table
                 .inner_join(
@@ -2045,6 +2316,208 @@ impl VisualizationRepository for PostgresRepository {
         .await
     }
 
+    async fn fetch_visibility_blocks_page(
+        &self,
+        schedule_id: crate::api::ScheduleId,
+        query: &VisibilityBlocksQuery,
+    ) -> RepositoryResult<VisibilityBlocksPage> {
+        use diesel::dsl::{count_star, max, min};
+
+        let query = query.clone();
+        self.with_conn(move |conn| {
+            let limit = query.limit.clamp(1, MAX_VISIBILITY_PAGE_SIZE);
+            let pattern = query
+                .search
+                .as_deref()
+                .map(str::trim)
+                .filter(|s| !s.is_empty())
+                .map(|s| format!("%{}%", escape_like(s)));
+            let search_id = query
+                .search
+                .as_deref()
+                .and_then(|s| s.trim().parse::<i64>().ok());
+
+            // Join + filters shared by the count and the page query.
+            let filtered = || {
+                let mut q = schedule_blocks::table
+                    .inner_join(
+                        schedule_block_analytics::table
+                            .on(schedule_block_analytics::scheduling_block_id
+                                .eq(schedule_blocks::scheduling_block_id)),
+                    )
+                    .filter(schedule_blocks::schedule_id.eq(schedule_id.0))
+                    .into_boxed();
+                if let Some(min_p) = query.priority_min {
+                    q = q.filter(schedule_blocks::priority.ge(min_p));
+                }
+                if let Some(max_p) = query.priority_max {
+                    q = q.filter(schedule_blocks::priority.le(max_p));
+                }
+                if let Some(scheduled) = query.scheduled {
+                    q = q.filter(schedule_block_analytics::scheduled.eq(scheduled));
+                }
+                if let Some(ref pattern) = pattern {
+                    let text = schedule_blocks::original_block_id
+                        .ilike(pattern.clone())
+                        .or(schedule_blocks::block_name.ilike(pattern.clone()));
+                    q = match search_id {
+                        Some(id) => q.filter(text.or(schedule_blocks::scheduling_block_id.eq(id))),
+                        None => q.filter(text),
+                    };
+                }
+                q
+            };
+
+            let (priority_min, priority_max, total_count): (Option<f64>, Option<f64>, i64) =
+                schedule_blocks::table
+                    .filter(schedule_blocks::schedule_id.eq(schedule_id.0))
+                    .select((
+                        min(schedule_blocks::priority),
+                        max(schedule_blocks::priority),
+                        count_star(),
+                    ))
+                    .first(conn)
+                    .map_err(map_diesel_error)?;
+            let scheduled_count: i64 = schedule_block_analytics::table
+                .filter(schedule_block_analytics::schedule_id.eq(schedule_id.0))
+                .filter(schedule_block_analytics::scheduled.eq(true))
+                .select(count_star())
+                .first(conn)
+                .map_err(map_diesel_error)?;
+            let matched_count: i64 = filtered()
+                .select(count_star())
+                .first(conn)
+                .map_err(map_diesel_error)?;
+
+            let mut page = filtered();
+            let asc = query.direction == SortDirection::Asc;
+            let id = schedule_blocks::scheduling_block_id;
+            if let Some(after) = query.after {
+                // Keyset: rows strictly past (key, id) in the query direction.
+                page = match (query.sort, asc) {
+                    (VisibilityBlockSort::Priority, true) => {
+                        let key = schedule_blocks::priority;
+                        page.filter(key.gt(after.key).or(key.eq(after.key).and(id.gt(after.id))))
+                    }
+                    (VisibilityBlockSort::Priority, false) => {
+                        let key = schedule_blocks::priority;
+                        page.filter(key.lt(after.key).or(key.eq(after.key).and(id.lt(after.id))))
+                    }
+                    (VisibilityBlockSort::NumVisibilityPeriods, asc) => {
+                        let key = schedule_block_analytics::num_visibility_periods;
+                        let k = after.key as i32;
+                        if asc {
+                            page.filter(key.gt(k).or(key.eq(k).and(id.gt(after.id))))
+                        } else {
+                            page.filter(key.lt(k).or(key.eq(k).and(id.lt(after.id))))
+                        }
+                    }
+                    // Bool keys have no ordering operators in diesel, so spell
+                    // out "the following value, or this value past the id".
+                    (VisibilityBlockSort::Scheduled, true) => {
+                        let key = schedule_block_analytics::scheduled;
+                        if after.key < 0.5 {
+                            page.filter(key.eq(true).or(key.eq(false).and(id.gt(after.id))))
+                        } else {
+                            page.filter(key.eq(true).and(id.gt(after.id)))
+                        }
+                    }
+                    (VisibilityBlockSort::Scheduled, false) => {
+                        let key = schedule_block_analytics::scheduled;
+                        if after.key >= 0.5 {
+                            page.filter(key.eq(false).or(key.eq(true).and(id.lt(after.id))))
+                        } else {
+                            page.filter(key.eq(false).and(id.lt(after.id)))
+                        }
+                    }
+                };
+            } else if query.offset > 0 {
+                page = page.offset(query.offset as i64);
+            }
+            page = match (query.sort, asc) {
+                (VisibilityBlockSort::Priority, true) => {
+                    page.order_by((schedule_blocks::priority.asc(), id.asc()))
+                }
+                (VisibilityBlockSort::Priority, false) => {
+                    page.order_by((schedule_blocks::priority.desc(), id.desc()))
+                }
+                (VisibilityBlockSort::NumVisibilityPeriods, true) => page.order_by((
+                    schedule_block_analytics::num_visibility_periods.asc(),
+                    id.asc(),
+                )),
+                (VisibilityBlockSort::NumVisibilityPeriods, false) => page.order_by((
+                    schedule_block_analytics::num_visibility_periods.desc(),
+                    id.desc(),
+                )),
+                (VisibilityBlockSort::Scheduled, true) => {
+                    page.order_by((schedule_block_analytics::scheduled.asc(), id.asc()))
+                }
+                (VisibilityBlockSort::Scheduled, false) => {
+                    page.order_by((schedule_block_analytics::scheduled.desc(), id.desc()))
+                }
+            };
+
+            // One extra row tells us whether another page follows.
+            let mut rows = page
+                .select((
+                    schedule_blocks::scheduling_block_id,
+                    schedule_blocks::source_block_id,
+                    schedule_blocks::original_block_id,
+                    schedule_blocks::block_name,
+                    schedule_blocks::priority,
+                    schedule_block_analytics::num_visibility_periods,
+                    schedule_block_analytics::scheduled,
+                ))
+                .limit(limit as i64 + 1)
+                .load::<(i64, i64, Option<String>, String, f64, i32, bool)>(conn)
+                .map_err(map_diesel_error)?;
+            let has_more = rows.len() > limit;
+            rows.truncate(limit);
+
+            let blocks: Vec<VisibilityBlockSummary> = rows
+                .into_iter()
+                .map(
+                    |(
+                        block_id,
+                        source_block_id,
+                        original_block_id,
+                        block_name,
+                        priority,
+                        num_periods,
+                        scheduled,
+                    )| VisibilityBlockSummary {
+                        scheduling_block_id: block_id,
+                        original_block_id: original_block_id
+                            .unwrap_or_else(|| source_block_id.to_string()),
+                        block_name,
+                        priority,
+                        num_visibility_periods: num_periods as usize,
+                        scheduled,
+                    },
+                )
+                .collect();
+            let next_cursor = if has_more {
+                blocks.last().map(|b| VisibilityBlockCursor {
+                    key: query.sort.key(b),
+                    id: b.scheduling_block_id,
+                })
+            } else {
+                None
+            };
+
+            Ok(VisibilityBlocksPage {
+                blocks,
+                matched_count: matched_count as usize,
+                total_count: total_count as usize,
+                scheduled_count: scheduled_count as usize,
+                priority_min: priority_min.unwrap_or(0.0),
+                priority_max: priority_max.unwrap_or(1.0),
+                next_cursor,
+            })
+        })
+        .await
+    }
+
     async fn fetch_blocks_for_histogram(
         &self,
         schedule_id: crate::api::ScheduleId,
@@ -2097,6 +2570,10 @@ impl VisualizationRepository for PostgresRepository {
         &self,
         schedule_id: crate::api::ScheduleId,
     ) -> RepositoryResult<(Option<i32>, Option<qtty::Hours>, Option<qtty::Hours>)> {
+        #[cfg(feature = "postgres-async")]
+        if let Some(pool) = &self.async_pool {
+            return self.gap_metrics_async(pool, schedule_id).await;
+        }
         self.with_conn(move |conn| {
             let result = schedule_summary_analytics::table
                 .filter(schedule_summary_analytics::schedule_id.eq(schedule_id.0))
@@ -2333,7 +2810,10 @@ impl crate::db::repository::EnvironmentRepository for PostgresRepository {
 
                 // Unassign all schedules from this environment
                 diesel::update(schedules::table.filter(schedules::environment_id.eq(id)))
-                    .set(schedules::environment_id.eq::<Option<i64>>(None))
+                    .set((
+                        schedules::environment_id.eq::<Option<i64>>(None),
+                        schedules::data_version.eq(schedules::data_version + 1),
+                    ))
                     .execute(tx)
                     .map_err(map_diesel_error)?;
 
@@ -2442,7 +2922,10 @@ impl crate::db::repository::EnvironmentRepository for PostgresRepository {
         self.with_conn(move |conn| {
             let updated =
                 diesel::update(schedules::table.filter(schedules::schedule_id.eq(schedule_id.0)))
-                    .set(schedules::environment_id.eq(Some(env_id)))
+                    .set((
+                        schedules::environment_id.eq(Some(env_id)),
+                        schedules::data_version.eq(schedules::data_version + 1),
+                    ))
                     .execute(conn)
                     .map_err(map_diesel_error)?;
 
@@ -2461,7 +2944,10 @@ impl crate::db::repository::EnvironmentRepository for PostgresRepository {
     async fn unassign_schedule(&self, schedule_id: ScheduleId) -> RepositoryResult<()> {
         self.with_conn(move |conn| {
             diesel::update(schedules::table.filter(schedules::schedule_id.eq(schedule_id.0)))
-                .set(schedules::environment_id.eq::<Option<i64>>(None))
+                .set((
+                    schedules::environment_id.eq::<Option<i64>>(None),
+                    schedules::data_version.eq(schedules::data_version + 1),
+                ))
                 .execute(conn)
                 .map_err(map_diesel_error)?;
 
@@ -2501,24 +2987,26 @@ impl AlgorithmTraceRepository for PostgresRepository {
         let iterations = iterations.clone();
         let algorithm = algorithm.to_string();
         self.with_conn(move |conn| {
-            diesel::insert_into(algorithm_traces::table)
-                .values((
-                    algorithm_traces::schedule_id.eq(schedule_id.0),
-                    algorithm_traces::algorithm.eq(&algorithm),
-                    algorithm_traces::summary.eq(&summary),
-                    algorithm_traces::iterations.eq(&iterations),
-                ))
-                .on_conflict(algorithm_traces::schedule_id)
-                .do_update()
-                .set((
-                    algorithm_traces::algorithm.eq(excluded(algorithm_traces::algorithm)),
-                    algorithm_traces::summary.eq(excluded(algorithm_traces::summary)),
-                    algorithm_traces::iterations.eq(excluded(algorithm_traces::iterations)),
-                    algorithm_traces::created_at.eq(diesel::dsl::now),
-                ))
-                .execute(conn)
-                .map_err(map_diesel_error)?;
-            Ok(())
+            conn.transaction(|tx| {
+                diesel::insert_into(algorithm_traces::table)
+                    .values((
+                        algorithm_traces::schedule_id.eq(schedule_id.0),
+                        algorithm_traces::algorithm.eq(&algorithm),
+                        algorithm_traces::summary.eq(&summary),
+                        algorithm_traces::iterations.eq(&iterations),
+                    ))
+                    .on_conflict(algorithm_traces::schedule_id)
+                    .do_update()
+                    .set((
+                        algorithm_traces::algorithm.eq(excluded(algorithm_traces::algorithm)),
+                        algorithm_traces::summary.eq(excluded(algorithm_traces::summary)),
+                        algorithm_traces::iterations.eq(excluded(algorithm_traces::iterations)),
+                        algorithm_traces::created_at.eq(diesel::dsl::now),
+                    ))
+                    .execute(tx)
+                    .map_err(map_diesel_error)?;
+                bump_data_version(tx, schedule_id.0)
+            })
         })
         .await
     }
@@ -87,6 +87,58 @@ pub struct NewScheduleBlockRow {
     pub scheduled_periods_json: Value,
 }
 
+/// [`NewScheduleBlockRow`] as `COPY FROM` writes it.
+///
+/// COPY cannot ask for a column's `DEFAULT`, so `None` is sent as `NULL`
+/// (none of these columns has a default). The `INSERT` path keeps using
+/// the plain row.
+#[derive(Debug, Insertable)]
+#[diesel(table_name = schedule_blocks)]
+#[diesel(treat_none_as_default_value = false)]
+pub struct CopyScheduleBlockRow<'a> {
+    pub schedule_id: i64,
+    pub source_block_id: i64,
+    pub original_block_id: Option<&'a str>,
+    pub block_name: &'a str,
+    pub priority: f64,
+    pub requested_duration_sec: i32,
+    pub min_observation_sec: i32,
+    pub target_ra_deg: Degrees,
+    pub target_dec_deg: Degrees,
+    pub min_altitude_deg: Option<Degrees>,
+    pub max_altitude_deg: Option<Degrees>,
+    pub min_azimuth_deg: Option<Degrees>,
+    pub max_azimuth_deg: Option<Degrees>,
+    pub constraint_start_mjd: Option<f64>,
+    pub constraint_stop_mjd: Option<f64>,
+    pub visibility_periods_json: &'a Value,
+    pub scheduled_periods_json: &'a Value,
+}
+
+impl<'a> From<&'a NewScheduleBlockRow> for CopyScheduleBlockRow<'a> {
+    fn from(row: &'a NewScheduleBlockRow) -> Self {
+        Self {
+            schedule_id: row.schedule_id,
+            source_block_id: row.source_block_id,
+            original_block_id: row.original_block_id.as_deref(),
+            block_name: &row.block_name,
+            priority: row.priority,
+            requested_duration_sec: row.requested_duration_sec,
+            min_observation_sec: row.min_observation_sec,
+            target_ra_deg: row.target_ra_deg,
+            target_dec_deg: row.target_dec_deg,
+            min_altitude_deg: row.min_altitude_deg,
+            max_altitude_deg: row.max_altitude_deg,
+            min_azimuth_deg: row.min_azimuth_deg,
+            max_azimuth_deg: row.max_azimuth_deg,
+            constraint_start_mjd: row.constraint_start_mjd,
+            constraint_stop_mjd: row.constraint_stop_mjd,
+            visibility_periods_json: &row.visibility_periods_json,
+            scheduled_periods_json: &row.scheduled_periods_json,
+        }
+    }
+}
+
 #[derive(Debug, Clone, Queryable, Selectable)]
 #[diesel(table_name = schedule_block_analytics)]
 // Analytics table row structure (for future use)
@@ -122,6 +174,43 @@ pub struct NewScheduleBlockAnalyticsRow {
     pub validation_impossible: bool,
 }
 
+/// [`NewScheduleBlockAnalyticsRow`] as `COPY FROM` writes it; see
+/// [`CopyScheduleBlockRow`].
+#[derive(Debug, Insertable)]
+#[diesel(table_name = schedule_block_analytics)]
+#[diesel(treat_none_as_default_value = false)]
+pub struct CopyScheduleBlockAnalyticsRow {
+    pub schedule_id: i64,
+    pub scheduling_block_id: i64,
+    pub priority_bucket: i16,
+    pub requested_hours: Hours,
+    pub total_visibility_hours: Hours,
+    pub num_visibility_periods: i32,
+    pub elevation_range_deg: Option<Degrees>,
+    pub scheduled: bool,
+    pub scheduled_start_mjd: Option<f64>,
+    pub scheduled_stop_mjd: Option<f64>,
+    pub validation_impossible: bool,
+}
+
+impl From<&NewScheduleBlockAnalyticsRow> for CopyScheduleBlockAnalyticsRow {
+    fn from(row: &NewScheduleBlockAnalyticsRow) -> Self {
+        Self {
+            schedule_id: row.schedule_id,
+            scheduling_block_id: row.scheduling_block_id,
+            priority_bucket: row.priority_bucket,
+            requested_hours: row.requested_hours,
+            total_visibility_hours: row.total_visibility_hours,
+            num_visibility_periods: row.num_visibility_periods,
+            elevation_range_deg: row.elevation_range_deg,
+            scheduled: row.scheduled,
+            scheduled_start_mjd: row.scheduled_start_mjd,
+            scheduled_stop_mjd: row.scheduled_stop_mjd,
+            validation_impossible: row.validation_impossible,
+        }
+    }
+}
+
 #[derive(Debug, Clone, Queryable, Selectable)]
 #[diesel(table_name = schedule_summary_analytics)]
 // Summary analytics table row structure (for future use)
@@ -198,6 +287,41 @@ pub struct NewScheduleValidationResultRow {
     pub description: Option<String>,
 }
 
+/// [`NewScheduleValidationResultRow`] as `COPY FROM` writes it; see
+/// [`CopyScheduleBlockRow`].
+#[derive(Debug, Insertable)]
+#[diesel(table_name = schedule_validation_results)]
+#[diesel(treat_none_as_default_value = false)]
+pub struct CopyScheduleValidationResultRow<'a> {
+    pub schedule_id: i64,
+    pub scheduling_block_id: i64,
+    pub status: &'a str,
+    pub issue_type: Option<&'a str>,
+    pub issue_category: Option<&'a str>,
+    pub criticality: Option<&'a str>,
+    pub field_name: Option<&'a str>,
+    pub current_value: Option<&'a str>,
+    pub expected_value: Option<&'a str>,
+    pub description: Option<&'a str>,
+}
+
+impl<'a> From<&'a NewScheduleValidationResultRow> for CopyScheduleValidationResultRow<'a> {
+    fn from(row: &'a NewScheduleValidationResultRow) -> Self {
+        Self {
+            schedule_id: row.schedule_id,
+            scheduling_block_id: row.scheduling_block_id,
+            status: &row.status,
+            issue_type: row.issue_type.as_deref(),
+            issue_category: row.issue_category.as_deref(),
+            criticality: row.criticality.as_deref(),
+            field_name: row.field_name.as_deref(),
+            current_value: row.current_value.as_deref(),
+            expected_value: row.expected_value.as_deref(),
+            description: row.description.as_deref(),
+        }
+    }
+}
+
 #[derive(Debug, Clone, Queryable, Selectable)]
 #[diesel(table_name = environments)]
 #[allow(dead_code)]
@@ -13,6 +13,7 @@ diesel::table! {
         observer_location_json -> Jsonb,
         astronomical_night_periods_json -> Jsonb,
         environment_id -> Nullable<Int8>,
+        data_version -> Int8,
     }
 }
 
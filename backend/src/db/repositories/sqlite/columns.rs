@@ -0,0 +1,105 @@
+//! Columnar encoding of period lists.
+//!
+//! Postgres keeps periods as JSON documents; here a period list is one BLOB
+//! of packed little-endian `(start_mjd, end_mjd)` `f64` pairs, 16 bytes per
+//! period. Decoding is a straight copy with no parsing, the column is about
+//! a third the size of the JSON text, and the per-block aggregates the
+//! analytics need (count, total and longest duration) are read without
+//! building `Period` values at all.
+
+use crate::api::{ModifiedJulianDate, Period};
+use crate::db::repository::{RepositoryError, RepositoryResult};
+
+/// Encoded size of one period.
+const PERIOD_BYTES: usize = 16;
+
+/// Pack `periods` into a BLOB.
+pub(super) fn encode_periods(periods: &[Period]) -> Vec<u8> {
+    let mut bytes = Vec::with_capacity(periods.len() * PERIOD_BYTES);
+    for period in periods {
+        bytes.extend_from_slice(&period.start.value().to_le_bytes());
+        bytes.extend_from_slice(&period.end.value().to_le_bytes());
+    }
+    bytes
+}
+
+/// `(start_mjd, end_mjd)` pairs of an encoded BLOB.
+pub(super) fn period_bounds(
+    bytes: &[u8],
+) -> RepositoryResult<impl Iterator<Item = (f64, f64)> + '_> {
+    if bytes.len() % PERIOD_BYTES != 0 {
+        return Err(RepositoryError::internal(format!(
+            "Period column of {} bytes is not a whole number of periods",
+            bytes.len()
+        )));
+    }
+    Ok(bytes.chunks_exact(PERIOD_BYTES).map(|chunk| {
+        let (start, end) = chunk.split_at(8);
+        (
+            f64::from_le_bytes(start.try_into().unwrap()),
+            f64::from_le_bytes(end.try_into().unwrap()),
+        )
+    }))
+}
+
+/// Unpack a BLOB written by [`encode_periods`].
+pub(super) fn decode_periods(bytes: &[u8]) -> RepositoryResult<Vec<Period>> {
+    Ok(period_bounds(bytes)?
+        .map(|(start, end)| Period {
+            start: ModifiedJulianDate::new(start),
+            end: ModifiedJulianDate::new(end),
+        })
+        .collect())
+}
+
+/// Number of periods, total hours and longest period in hours of an
+/// encoded BLOB.
+pub(super) fn period_hours(bytes: &[u8]) -> RepositoryResult<(usize, f64, f64)> {
+    let mut count = 0;
+    let mut total = 0.0;
+    let mut longest = 0.0_f64;
+    for (start, end) in period_bounds(bytes)? {
+        let hours = (end - start) * 24.0;
+        count += 1;
+        total += hours;
+        longest = longest.max(hours);
+    }
+    Ok((count, total, longest))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn period(start: f64, end: f64) -> Period {
+        Period {
+            start: ModifiedJulianDate::new(start),
+            end: ModifiedJulianDate::new(end),
+        }
+    }
+
+    #[test]
+    fn test_periods_round_trip() {
+        let periods = vec![period(60000.0, 60000.5), period(60001.25, 60002.0)];
+        let bytes = encode_periods(&periods);
+        assert_eq!(bytes.len(), 2 * PERIOD_BYTES);
+
+        let decoded = decode_periods(&bytes).unwrap();
+        assert_eq!(decoded.len(), 2);
+        assert_eq!(decoded[1].start.value(), 60001.25);
+        assert_eq!(decoded[1].end.value(), 60002.0);
+        assert!(decode_periods(&[]).unwrap().is_empty());
+    }
+
+    #[test]
+    fn test_period_hours() {
+        let bytes = encode_periods(&[period(60000.0, 60000.5), period(60001.0, 60001.25)]);
+        assert_eq!(period_hours(&bytes).unwrap(), (2, 18.0, 12.0));
+    }
+
+    #[test]
+    fn test_truncated_column_is_rejected() {
+        let bytes = encode_periods(&[period(60000.0, 60001.0)]);
+        assert!(decode_periods(&bytes[..12]).is_err());
+    }
+}
@@ -0,0 +1,253 @@
+//! Embedded schema migrations for the SQLite repository.
+//!
+//! The tables mirror the end state of the Postgres migrations (schedules,
+//! blocks, per-block and summary analytics, validation results,
+//! environments and algorithm traces, with the same cascading deletes),
+//! except that period lists are columnar BLOBs (see [`super::columns`])
+//! and a block's scheduled period is a pair of columns. As with
+//! `diesel_migrations`, pending migrations run in order when the database
+//! is opened, each in its own transaction; the applied version is kept in
+//! `PRAGMA user_version`. Append new migrations, never edit applied ones.
+
+use rusqlite::Connection;
+
+use crate::db::repository::{ErrorContext, RepositoryError, RepositoryResult};
+
+/// Migrations in application order; migration `i` brings the schema to
+/// version `i + 1`.
+const MIGRATIONS: &[(&str, &str)] = &[
+    ("init_schema", INIT_SCHEMA),
+    ("add_analytics_indexes", ADD_ANALYTICS_INDEXES),
+    ("add_schedule_data_version", ADD_SCHEDULE_DATA_VERSION),
+];
+
+/// Timestamp default matching the RFC 3339 text the repository writes.
+macro_rules! now_default {
+    () => {
+        "(strftime('%Y-%m-%dT%H:%M:%fZ', 'now'))"
+    };
+}
+
+const INIT_SCHEMA: &str = concat!(
+    "
+CREATE TABLE environments (
+  environment_id    INTEGER PRIMARY KEY AUTOINCREMENT,
+  name              TEXT NOT NULL UNIQUE,
+  period_start_mjd  REAL,
+  period_end_mjd    REAL,
+  lat_deg           REAL,
+  lon_deg           REAL,
+  elevation_m       REAL,
+  blocks_hash       TEXT,
+  created_at        TEXT NOT NULL DEFAULT ",
+    now_default!(),
+    "
+);
+
+CREATE TABLE environment_preschedule (
+  environment_id  INTEGER PRIMARY KEY
+                  REFERENCES environments(environment_id) ON DELETE CASCADE,
+  payload_json    TEXT NOT NULL,
+  computed_at     TEXT NOT NULL DEFAULT ",
+    now_default!(),
+    "
+);
+
+CREATE TABLE schedules (
+  schedule_id                 INTEGER PRIMARY KEY AUTOINCREMENT,
+  schedule_name               TEXT NOT NULL,
+  checksum                    TEXT NOT NULL UNIQUE,
+  uploaded_at                 TEXT NOT NULL DEFAULT ",
+    now_default!(),
+    ",
+  schedule_period_start_mjd   REAL NOT NULL,
+  schedule_period_end_mjd     REAL NOT NULL,
+  observer_location_json      TEXT NOT NULL,
+  dark_periods                BLOB NOT NULL,
+  astronomical_night_periods  BLOB NOT NULL,
+  possible_periods            BLOB NOT NULL,
+  environment_id              INTEGER
+                              REFERENCES environments(environment_id) ON DELETE SET NULL
+);
+
+CREATE TABLE schedule_blocks (
+  scheduling_block_id     INTEGER PRIMARY KEY AUTOINCREMENT,
+  schedule_id             INTEGER NOT NULL REFERENCES schedules(schedule_id) ON DELETE CASCADE,
+  source_block_id         INTEGER NOT NULL,
+  original_block_id       TEXT,
+  block_name              TEXT NOT NULL DEFAULT '',
+  priority                REAL NOT NULL,
+  requested_duration_sec  INTEGER NOT NULL CHECK (requested_duration_sec >= 0),
+  min_observation_sec     INTEGER NOT NULL CHECK (min_observation_sec >= 0),
+  target_ra_deg           REAL NOT NULL,
+  target_dec_deg          REAL NOT NULL,
+  min_altitude_deg        REAL,
+  max_altitude_deg        REAL,
+  min_azimuth_deg         REAL,
+  max_azimuth_deg         REAL,
+  constraint_start_mjd    REAL,
+  constraint_stop_mjd     REAL,
+  visibility_periods      BLOB NOT NULL,
+  scheduled_start_mjd     REAL,
+  scheduled_stop_mjd      REAL,
+  created_at              TEXT NOT NULL DEFAULT ",
+    now_default!(),
+    ",
+  UNIQUE (schedule_id, source_block_id),
+  CHECK (min_observation_sec <= requested_duration_sec),
+  CHECK (length(visibility_periods) % 16 = 0),
+  CHECK ((scheduled_start_mjd IS NULL) = (scheduled_stop_mjd IS NULL))
+);
+
+CREATE TABLE schedule_block_analytics (
+  schedule_id             INTEGER NOT NULL REFERENCES schedules(schedule_id) ON DELETE CASCADE,
+  scheduling_block_id     INTEGER NOT NULL
+                          REFERENCES schedule_blocks(scheduling_block_id) ON DELETE CASCADE,
+  priority_bucket         INTEGER NOT NULL,
+  requested_hours         REAL NOT NULL,
+  total_visibility_hours  REAL NOT NULL,
+  num_visibility_periods  INTEGER NOT NULL,
+  elevation_range_deg     REAL,
+  scheduled               INTEGER NOT NULL,
+  scheduled_start_mjd     REAL,
+  scheduled_stop_mjd      REAL,
+  validation_impossible   INTEGER NOT NULL DEFAULT 0,
+  created_at              TEXT NOT NULL DEFAULT ",
+    now_default!(),
+    ",
+  PRIMARY KEY (schedule_id, scheduling_block_id)
+);
+
+CREATE TABLE schedule_summary_analytics (
+  schedule_id                 INTEGER PRIMARY KEY
+                              REFERENCES schedules(schedule_id) ON DELETE CASCADE,
+  total_blocks                INTEGER NOT NULL,
+  scheduled_blocks            INTEGER NOT NULL,
+  unscheduled_blocks          INTEGER NOT NULL,
+  impossible_blocks           INTEGER NOT NULL,
+  scheduling_rate             REAL NOT NULL,
+  priority_mean               REAL,
+  priority_median             REAL,
+  priority_scheduled_mean     REAL,
+  priority_unscheduled_mean   REAL,
+  visibility_total_hours      REAL NOT NULL,
+  requested_mean_hours        REAL,
+  gap_count                   INTEGER,
+  gap_mean_hours              REAL,
+  gap_median_hours            REAL,
+  created_at                  TEXT NOT NULL DEFAULT ",
+    now_default!(),
+    "
+);
+
+CREATE TABLE schedule_validation_results (
+  validation_id         INTEGER PRIMARY KEY AUTOINCREMENT,
+  schedule_id           INTEGER NOT NULL REFERENCES schedules(schedule_id) ON DELETE CASCADE,
+  scheduling_block_id   INTEGER NOT NULL
+                        REFERENCES schedule_blocks(scheduling_block_id) ON DELETE CASCADE,
+  status                TEXT NOT NULL,
+  issue_type            TEXT,
+  issue_category        TEXT,
+  criticality           TEXT,
+  field_name            TEXT,
+  current_value         TEXT,
+  expected_value        TEXT,
+  description           TEXT,
+  created_at            TEXT NOT NULL DEFAULT ",
+    now_default!(),
+    "
+);
+
+CREATE TABLE algorithm_traces (
+  schedule_id  INTEGER PRIMARY KEY REFERENCES schedules(schedule_id) ON DELETE CASCADE,
+  algorithm    TEXT NOT NULL,
+  summary      TEXT NOT NULL,
+  iterations   TEXT NOT NULL,
+  created_at   TEXT NOT NULL DEFAULT ",
+    now_default!(),
+    "
+);
+"
+);
+
+/// Foreign-key indexes for cascading deletes plus the composite keys the
+/// analytics and visibility-page queries scan, as in the Postgres
+/// performance, cascade and keyset index migrations.
+const ADD_ANALYTICS_INDEXES: &str = "
+CREATE INDEX schedules_uploaded_at_idx ON schedules (uploaded_at DESC, schedule_id DESC);
+CREATE INDEX schedules_environment_id_idx ON schedules (environment_id);
+
+CREATE INDEX schedule_blocks_schedule_id_idx ON schedule_blocks (schedule_id);
+CREATE INDEX schedule_blocks_priority_keyset_idx
+  ON schedule_blocks (schedule_id, priority, scheduling_block_id);
+
+CREATE INDEX schedule_block_analytics_block_id_idx
+  ON schedule_block_analytics (scheduling_block_id);
+CREATE INDEX schedule_block_analytics_periods_keyset_idx
+  ON schedule_block_analytics (schedule_id, num_visibility_periods, scheduling_block_id);
+CREATE INDEX schedule_block_analytics_scheduled_keyset_idx
+  ON schedule_block_analytics (schedule_id, scheduled, scheduling_block_id);
+
+CREATE INDEX schedule_validation_results_schedule_id_idx
+  ON schedule_validation_results (schedule_id, status);
+CREATE INDEX schedule_validation_results_block_id_idx
+  ON schedule_validation_results (scheduling_block_id);
+";
+
+/// Per-schedule version behind `schedule_version`, as in the Postgres
+/// `add_schedule_data_version` migration.
+const ADD_SCHEDULE_DATA_VERSION: &str = "
+ALTER TABLE schedules ADD COLUMN data_version INTEGER NOT NULL DEFAULT 1;
+";
+
+/// Apply the migrations newer than the database's `user_version`.
+pub(super) fn run_pending_migrations(conn: &mut Connection) -> RepositoryResult<()> {
+    let migration_error = |name: &str, e: rusqlite::Error| {
+        RepositoryError::internal_with_context(
+            format!("Migration failed: {}", e),
+            ErrorContext::new("run_migrations").with_details(name.to_string()),
+        )
+    };
+
+    let applied: usize = conn
+        .query_row("PRAGMA user_version", [], |row| row.get::<_, i64>(0))
+        .map_err(|e| migration_error("user_version", e))? as usize;
+    if applied > MIGRATIONS.len() {
+        return Err(RepositoryError::configuration(format!(
+            "Database schema version {} is newer than this build supports ({})",
+            applied,
+            MIGRATIONS.len()
+        )));
+    }
+
+    for (version, (name, sql)) in MIGRATIONS.iter().enumerate().skip(applied) {
+        let tx = conn.transaction().map_err(|e| migration_error(name, e))?;
+        tx.execute_batch(sql)
+            .map_err(|e| migration_error(name, e))?;
+        // PRAGMA does not take bound parameters.
+        tx.execute_batch(&format!("PRAGMA user_version = {}", version + 1))
+            .map_err(|e| migration_error(name, e))?;
+        tx.commit().map_err(|e| migration_error(name, e))?;
+        log::info!("Applied SQLite migration {} ({})", version + 1, name);
+    }
+
+    Ok(())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_migrations_apply_once() {
+        let mut conn = Connection::open_in_memory().unwrap();
+        run_pending_migrations(&mut conn).unwrap();
+        // Re-running finds nothing pending instead of recreating tables.
+        run_pending_migrations(&mut conn).unwrap();
+
+        let version: i64 = conn
+            .query_row("PRAGMA user_version", [], |row| row.get(0))
+            .unwrap();
+        assert_eq!(version as usize, MIGRATIONS.len());
+    }
+}
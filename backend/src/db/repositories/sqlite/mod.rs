@@ -0,0 +1,2349 @@
+//! Embedded SQLite repository implementation.
+//!
+//! A single-file alternative to the Postgres repository for laptops and CI:
+//! the same tables, cascades and derived analytics (see [`migrations`]),
+//! without a database service. Period lists are stored columnar (see
+//! [`columns`]) rather than as JSON.
+//!
+//! ## Connections
+//!
+//! SQLite admits one writer at a time, so writes go through a single
+//! connection behind a mutex. A file database runs in WAL mode with a few
+//! read-only connections beside it, so reads neither wait for each other
+//! nor for a write in progress. All calls run on the blocking pool, like
+//! the Postgres repository's.
+//!
+//! ## Configuration
+//!
+//! Environment variables:
+//! - `SQLITE_PATH`: Database file (default: `tsi.sqlite3`; `:memory:` for a
+//!   private in-memory database)
+//! - `SQLITE_READ_CONNECTIONS`: Read-only connections (default: 4)
+//! - `SQLITE_BUSY_TIMEOUT_MS`: Wait for another process's lock (default: 5000)
+
+use async_trait::async_trait;
+use parking_lot::{Mutex, MutexGuard};
+use rusqlite::types::Value as SqlValue;
+use rusqlite::{params, params_from_iter, Connection, OpenFlags, OptionalExtension, Transaction};
+use std::collections::{HashMap, HashSet};
+use std::path::{Path, PathBuf};
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::Arc;
+use std::time::{Duration, Instant};
+
+use crate::api::{
+    AlgorithmTraceIteration, AlgorithmTraceResponse, AlgorithmTraceSummary, CompareBlock,
+    Constraints, DistributionBlock, InsightsBlock, LightweightBlock, ModifiedJulianDate, Period,
+    Schedule, ScheduleId, ScheduleInfo, ScheduleTimelineBlock, SchedulingBlock, SchedulingBlockId,
+    SortDirection, VisibilityBlockCursor, VisibilityBlockSort, VisibilityBlockSummary,
+    VisibilityBlocksPage, VisibilityBlocksQuery, VisibilityMapData,
+};
+use crate::db::repository::{
+    AlgorithmTraceRepository, AnalyticsRepository, ErrorContext, RepositoryError, RepositoryResult,
+    ScheduleRepository, ValidationRepository, VisualizationRepository,
+};
+use crate::models::{ScheduleColumns, ScheduleColumnsBuilder};
+use crate::services::stats::{median_in_place, SummaryStats};
+use crate::services::validation::{
+    validate_blocks, BlockForValidation, ValidationResult, ValidationStatus,
+};
+use crate::services::visibility_blocks::MAX_VISIBILITY_PAGE_SIZE;
+
+mod columns;
+mod migrations;
+
+use columns::{decode_periods, encode_periods, period_bounds, period_hours};
+
+/// Configuration for opening a SQLite database.
+#[derive(Debug, Clone)]
+pub struct SqliteConfig {
+    /// Database file, or `:memory:`
+    pub path: PathBuf,
+    /// Number of read-only connections (ignored for `:memory:`)
+    pub read_connections: usize,
+    /// How long to wait for a lock held by another process, in milliseconds
+    pub busy_timeout_ms: u64,
+}
+
+impl Default for SqliteConfig {
+    fn default() -> Self {
+        Self {
+            path: PathBuf::from("tsi.sqlite3"),
+            read_connections: 4,
+            busy_timeout_ms: 5000,
+        }
+    }
+}
+
+impl SqliteConfig {
+    /// Configuration for the database file at `path` with default settings.
+    pub fn new<P: Into<PathBuf>>(path: P) -> Self {
+        Self {
+            path: path.into(),
+            ..Self::default()
+        }
+    }
+
+    /// Create configuration from environment variables.
+    ///
+    /// # Environment Variables
+    /// - `SQLITE_PATH`: Database file (default: `tsi.sqlite3`)
+    /// - `SQLITE_READ_CONNECTIONS`: Read-only connections (default: 4)
+    /// - `SQLITE_BUSY_TIMEOUT_MS`: Lock wait in milliseconds (default: 5000)
+    pub fn from_env() -> Self {
+        let defaults = Self::default();
+        Self {
+            path: std::env::var("SQLITE_PATH")
+                .ok()
+                .filter(|v| !v.is_empty())
+                .map(PathBuf::from)
+                .unwrap_or(defaults.path),
+            read_connections: std::env::var("SQLITE_READ_CONNECTIONS")
+                .ok()
+                .and_then(|v| v.parse().ok())
+                .unwrap_or(defaults.read_connections),
+            busy_timeout_ms: std::env::var("SQLITE_BUSY_TIMEOUT_MS")
+                .ok()
+                .and_then(|v| v.parse().ok())
+                .unwrap_or(defaults.busy_timeout_ms),
+        }
+    }
+
+    fn is_in_memory(&self) -> bool {
+        self.path.as_os_str() == ":memory:"
+    }
+}
+
+/// The writer and read-only connections of one database.
+#[derive(Debug)]
+struct Connections {
+    writer: Mutex<Connection>,
+    readers: Vec<Mutex<Connection>>,
+    next_reader: AtomicUsize,
+}
+
+impl Connections {
+    /// An idle reader if there is one, otherwise the next in turn. Falls
+    /// back to the writer for in-memory databases, which have no readers.
+    fn reader(&self) -> MutexGuard<'_, Connection> {
+        if self.readers.is_empty() {
+            return self.writer.lock();
+        }
+        let start = self.next_reader.fetch_add(1, Ordering::Relaxed) % self.readers.len();
+        for offset in 0..self.readers.len() {
+            let idx = (start + offset) % self.readers.len();
+            if let Some(conn) = self.readers[idx].try_lock() {
+                return conn;
+            }
+        }
+        self.readers[start].lock()
+    }
+}
+
+/// SQLite-backed repository.
+///
+/// This repository implementation provides:
+/// - A single database file, created and migrated on open
+/// - Concurrent reads through WAL-mode read-only connections
+/// - The Postgres repository's derived analytics and validation tables
+#[derive(Clone, Debug)]
+pub struct SqliteRepository {
+    conns: Arc<Connections>,
+}
+
+impl SqliteRepository {
+    /// Open (creating if needed) a database and run pending migrations.
+    ///
+    /// # Arguments
+    /// * `config` - Database configuration
+    ///
+    /// # Returns
+    /// * `Ok(SqliteRepository)` on success
+    /// * `Err(RepositoryError)` if the file cannot be opened or migrated
+    pub fn new(config: SqliteConfig) -> RepositoryResult<Self> {
+        let open_error = |e: rusqlite::Error| {
+            RepositoryError::connection_with_context(
+                e.to_string(),
+                ErrorContext::new("open_database")
+                    .with_details(format!("path={}", config.path.display())),
+            )
+        };
+        let busy_timeout = Duration::from_millis(config.busy_timeout_ms);
+
+        let mut writer = Connection::open(&config.path).map_err(open_error)?;
+        writer.busy_timeout(busy_timeout).map_err(open_error)?;
+        if !config.is_in_memory() {
+            writer
+                .pragma_update_and_check(None, "journal_mode", "WAL", |row| row.get::<_, String>(0))
+                .map_err(open_error)?;
+            // Durable at checkpoints rather than every commit, as is usual with WAL.
+            writer
+                .pragma_update(None, "synchronous", "NORMAL")
+                .map_err(open_error)?;
+        }
+        writer
+            .pragma_update(None, "foreign_keys", true)
+            .map_err(open_error)?;
+        migrations::run_pending_migrations(&mut writer)?;
+
+        let mut readers = Vec::new();
+        if !config.is_in_memory() {
+            for _ in 0..config.read_connections {
+                let reader = Connection::open_with_flags(
+                    &config.path,
+                    OpenFlags::SQLITE_OPEN_READ_ONLY | OpenFlags::SQLITE_OPEN_NO_MUTEX,
+                )
+                .map_err(open_error)?;
+                reader.busy_timeout(busy_timeout).map_err(open_error)?;
+                readers.push(Mutex::new(reader));
+            }
+        }
+
+        Ok(Self {
+            conns: Arc::new(Connections {
+                writer: Mutex::new(writer),
+                readers,
+                next_reader: AtomicUsize::new(0),
+            }),
+        })
+    }
+
+    /// Open the database file at `path` with default settings.
+    pub fn open<P: AsRef<Path>>(path: P) -> RepositoryResult<Self> {
+        Self::new(SqliteConfig::new(path.as_ref()))
+    }
+
+    /// Open a private in-memory database, e.g. for tests.
+    pub fn open_in_memory() -> RepositoryResult<Self> {
+        Self::new(SqliteConfig::new(":memory:"))
+    }
+
+    /// Run `f` on the writer connection.
+    async fn with_conn<T, F>(&self, f: F) -> RepositoryResult<T>
+    where
+        T: Send + 'static,
+        F: FnOnce(&mut Connection) -> RepositoryResult<T> + Send + 'static,
+    {
+        let conns = self.conns.clone();
+        Self::run(move || {
+            let wait_started = Instant::now();
+            let mut conn = conns.writer.lock();
+            crate::metrics::global()
+                .db_pool_wait
+                .observe_duration(wait_started.elapsed());
+            f(&mut conn)
+        })
+        .await
+    }
+
+    /// Run `f` on a read-only connection.
+    async fn with_read<T, F>(&self, f: F) -> RepositoryResult<T>
+    where
+        T: Send + 'static,
+        F: FnOnce(&Connection) -> RepositoryResult<T> + Send + 'static,
+    {
+        let conns = self.conns.clone();
+        Self::run(move || {
+            let wait_started = Instant::now();
+            let conn = conns.reader();
+            crate::metrics::global()
+                .db_pool_wait
+                .observe_duration(wait_started.elapsed());
+            f(&conn)
+        })
+        .await
+    }
+
+    async fn run<T, F>(op: F) -> RepositoryResult<T>
+    where
+        T: Send + 'static,
+        F: FnOnce() -> RepositoryResult<T> + Send + 'static,
+    {
+        crate::metrics::spawn_blocking(move || {
+            let metrics = crate::metrics::global();
+            let query_started = Instant::now();
+            let outcome = op();
+            metrics.db_query.observe_duration(query_started.elapsed());
+            metrics.record_db_operation(outcome.is_ok());
+            outcome
+        })
+        .await
+        .map_err(|e| {
+            RepositoryError::internal_with_context(
+                format!("Task join error: {}", e),
+                ErrorContext::new("spawn_blocking"),
+            )
+        })?
+    }
+}
+
+fn priority_bucket(priority: f64) -> i64 {
+    // Simple quartile-style bucket across 0-10 range
+    if priority < 2.5 {
+        1
+    } else if priority < 5.0 {
+        2
+    } else if priority < 7.5 {
+        3
+    } else {
+        4
+    }
+}
+
+/// Escape `%`, `_` and `\` so user text matches literally inside LIKE.
+fn escape_like(text: &str) -> String {
+    let mut escaped = String::with_capacity(text.len());
+    for c in text.chars() {
+        if matches!(c, '%' | '_' | '\\') {
+            escaped.push('\\');
+        }
+        escaped.push(c);
+    }
+    escaped
+}
+
+fn period_from(start: Option<f64>, end: Option<f64>) -> Option<Period> {
+    match (start, end) {
+        (Some(start), Some(end)) => Some(Period {
+            start: ModifiedJulianDate::new(start),
+            end: ModifiedJulianDate::new(end),
+        }),
+        _ => None,
+    }
+}
+
+fn parse_location(json: &str) -> RepositoryResult<crate::api::GeographicLocation> {
+    serde_json::from_str(json).map_err(|e| {
+        RepositoryError::InternalError(format!("Failed to parse observer_location_json: {e}"))
+    })
+}
+
+fn parse_timestamp(text: &str) -> RepositoryResult<chrono::DateTime<chrono::Utc>> {
+    chrono::DateTime::parse_from_rfc3339(text)
+        .map(|t| t.with_timezone(&chrono::Utc))
+        .map_err(|e| RepositoryError::internal(format!("Failed to parse timestamp '{text}': {e}")))
+}
+
+/// Columns of [`InfoRow`], for schedules aliased `s`.
+const INFO_COLUMNS: &str = "s.schedule_id, s.schedule_name, s.schedule_period_start_mjd, \
+     s.schedule_period_end_mjd, s.observer_location_json, s.environment_id";
+
+/// A `schedules` row as listed.
+struct InfoRow {
+    schedule_id: i64,
+    schedule_name: String,
+    period_start_mjd: f64,
+    period_end_mjd: f64,
+    observer_location_json: String,
+    environment_id: Option<i64>,
+}
+
+impl InfoRow {
+    fn from_row(row: &rusqlite::Row<'_>) -> rusqlite::Result<Self> {
+        Ok(Self {
+            schedule_id: row.get(0)?,
+            schedule_name: row.get(1)?,
+            period_start_mjd: row.get(2)?,
+            period_end_mjd: row.get(3)?,
+            observer_location_json: row.get(4)?,
+            environment_id: row.get(5)?,
+        })
+    }
+
+    fn into_info(self) -> RepositoryResult<ScheduleInfo> {
+        Ok(ScheduleInfo {
+            schedule_id: ScheduleId(self.schedule_id),
+            schedule_name: self.schedule_name,
+            observer_location: parse_location(&self.observer_location_json)?,
+            schedule_period: Period {
+                start: ModifiedJulianDate::new(self.period_start_mjd),
+                end: ModifiedJulianDate::new(self.period_end_mjd),
+            },
+            environment_id: self.environment_id,
+        })
+    }
+}
+
+fn fetch_info(conn: &Connection, schedule_id: i64) -> RepositoryResult<ScheduleInfo> {
+    conn.query_row(
+        &format!("SELECT {INFO_COLUMNS} FROM schedules s WHERE s.schedule_id = ?1"),
+        [schedule_id],
+        InfoRow::from_row,
+    )?
+    .into_info()
+}
+
+/// Columns of [`BlockRow`], in order.
+const BLOCK_COLUMNS: &str = "scheduling_block_id, source_block_id, original_block_id, \
+     block_name, priority, requested_duration_sec, min_observation_sec, target_ra_deg, \
+     target_dec_deg, min_altitude_deg, max_altitude_deg, min_azimuth_deg, max_azimuth_deg, \
+     constraint_start_mjd, constraint_stop_mjd, visibility_periods, scheduled_start_mjd, \
+     scheduled_stop_mjd";
+
+/// A `schedule_blocks` row.
+struct BlockRow {
+    scheduling_block_id: i64,
+    source_block_id: i64,
+    original_block_id: Option<String>,
+    block_name: String,
+    priority: f64,
+    requested_duration_sec: i64,
+    min_observation_sec: i64,
+    target_ra_deg: f64,
+    target_dec_deg: f64,
+    min_altitude_deg: Option<f64>,
+    max_altitude_deg: Option<f64>,
+    min_azimuth_deg: Option<f64>,
+    max_azimuth_deg: Option<f64>,
+    constraint_start_mjd: Option<f64>,
+    constraint_stop_mjd: Option<f64>,
+    visibility_periods: Vec<u8>,
+    scheduled_start_mjd: Option<f64>,
+    scheduled_stop_mjd: Option<f64>,
+}
+
+impl BlockRow {
+    fn from_row(row: &rusqlite::Row<'_>) -> rusqlite::Result<Self> {
+        Ok(Self {
+            scheduling_block_id: row.get(0)?,
+            source_block_id: row.get(1)?,
+            original_block_id: row.get(2)?,
+            block_name: row.get(3)?,
+            priority: row.get(4)?,
+            requested_duration_sec: row.get(5)?,
+            min_observation_sec: row.get(6)?,
+            target_ra_deg: row.get(7)?,
+            target_dec_deg: row.get(8)?,
+            min_altitude_deg: row.get(9)?,
+            max_altitude_deg: row.get(10)?,
+            min_azimuth_deg: row.get(11)?,
+            max_azimuth_deg: row.get(12)?,
+            constraint_start_mjd: row.get(13)?,
+            constraint_stop_mjd: row.get(14)?,
+            visibility_periods: row.get(15)?,
+            scheduled_start_mjd: row.get(16)?,
+            scheduled_stop_mjd: row.get(17)?,
+        })
+    }
+
+    fn into_block(self) -> RepositoryResult<SchedulingBlock> {
+        let degrees = |v: Option<f64>| qtty::Degrees::new(v.unwrap_or(0.0));
+        Ok(SchedulingBlock {
+            id: Some(SchedulingBlockId(self.scheduling_block_id)),
+            original_block_id: self.original_block_id.unwrap_or_default(),
+            block_name: self.block_name,
+            target_ra: qtty::Degrees::new(self.target_ra_deg),
+            target_dec: qtty::Degrees::new(self.target_dec_deg),
+            constraints: Constraints {
+                min_alt: degrees(self.min_altitude_deg),
+                max_alt: degrees(self.max_altitude_deg),
+                min_az: degrees(self.min_azimuth_deg),
+                max_az: degrees(self.max_azimuth_deg),
+                fixed_time: period_from(self.constraint_start_mjd, self.constraint_stop_mjd),
+            },
+            priority: self.priority,
+            min_observation: (self.min_observation_sec as f64).into(),
+            requested_duration: (self.requested_duration_sec as f64).into(),
+            visibility_periods: decode_periods(&self.visibility_periods)?,
+            scheduled_period: period_from(self.scheduled_start_mjd, self.scheduled_stop_mjd),
+        })
+    }
+}
+
+fn load_block_rows(conn: &Connection, schedule_id: i64) -> RepositoryResult<Vec<BlockRow>> {
+    let mut stmt = conn.prepare_cached(&format!(
+        "SELECT {BLOCK_COLUMNS} FROM schedule_blocks \
+         WHERE schedule_id = ?1 ORDER BY scheduling_block_id"
+    ))?;
+    let rows = stmt
+        .query_map([schedule_id], BlockRow::from_row)?
+        .collect::<rusqlite::Result<Vec<_>>>()?;
+    Ok(rows)
+}
+
+/// A `schedule_block_analytics` row being written.
+struct AnalyticsRow {
+    scheduling_block_id: i64,
+    priority: f64,
+    requested_hours: f64,
+    total_visibility_hours: f64,
+    num_visibility_periods: i64,
+    elevation_range_deg: Option<f64>,
+    scheduled_start_mjd: Option<f64>,
+    scheduled_stop_mjd: Option<f64>,
+    validation_impossible: bool,
+}
+
+impl AnalyticsRow {
+    fn scheduled(&self) -> bool {
+        self.scheduled_start_mjd.is_some()
+    }
+}
+
+/// The `schedule_summary_analytics` row of a schedule, as the Postgres
+/// repository computes it.
+fn write_summary(
+    tx: &Transaction<'_>,
+    schedule_id: i64,
+    rows: &[AnalyticsRow],
+) -> RepositoryResult<()> {
+    let mut priorities = SummaryStats::with_median(rows.len());
+    let mut scheduled_priorities = SummaryStats::new();
+    let mut unscheduled_priorities = SummaryStats::new();
+    let mut visibility_hours = 0.0;
+    let mut requested_hours = SummaryStats::new();
+    let mut impossible = 0;
+    let mut scheduled_periods = Vec::new();
+    for row in rows {
+        priorities.push(row.priority);
+        if row.scheduled() {
+            scheduled_priorities.push(row.priority);
+        } else {
+            unscheduled_priorities.push(row.priority);
+        }
+        visibility_hours += row.total_visibility_hours;
+        requested_hours.push(row.requested_hours);
+        if row.validation_impossible {
+            impossible += 1;
+        }
+        if let (Some(start), Some(stop)) = (row.scheduled_start_mjd, row.scheduled_stop_mjd) {
+            scheduled_periods.push((start, stop));
+        }
+    }
+
+    // Positive gaps between consecutive scheduled observations, in hours.
+    scheduled_periods.sort_by(|a, b| a.0.partial_cmp(&b.0).unwrap_or(std::cmp::Ordering::Equal));
+    let mut gaps: Vec<f64> = scheduled_periods
+        .windows(2)
+        .map(|w| (w[1].0 - w[0].1) * 24.0)
+        .filter(|gap| *gap > 0.0)
+        .collect();
+    let (gap_count, gap_mean, gap_median) = if gaps.is_empty() {
+        (None, None, None)
+    } else {
+        let mean = gaps.iter().sum::<f64>() / gaps.len() as f64;
+        (
+            Some(gaps.len() as i64),
+            Some(mean),
+            median_in_place(&mut gaps),
+        )
+    };
+
+    let total = rows.len() as i64;
+    let scheduled = scheduled_priorities.count() as i64;
+    let mean = |stats: &SummaryStats| (!stats.is_empty()).then(|| stats.mean());
+    tx.execute(
+        "INSERT INTO schedule_summary_analytics (
+            schedule_id, total_blocks, scheduled_blocks, unscheduled_blocks,
+            impossible_blocks, scheduling_rate, priority_mean, priority_median,
+            priority_scheduled_mean, priority_unscheduled_mean, visibility_total_hours,
+            requested_mean_hours, gap_count, gap_mean_hours, gap_median_hours
+         ) VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11, ?12, ?13, ?14, ?15)
+         ON CONFLICT (schedule_id) DO UPDATE SET
+            total_blocks = excluded.total_blocks,
+            scheduled_blocks = excluded.scheduled_blocks,
+            unscheduled_blocks = excluded.unscheduled_blocks,
+            impossible_blocks = excluded.impossible_blocks,
+            scheduling_rate = excluded.scheduling_rate,
+            priority_mean = excluded.priority_mean,
+            priority_median = excluded.priority_median,
+            priority_scheduled_mean = excluded.priority_scheduled_mean,
+            priority_unscheduled_mean = excluded.priority_unscheduled_mean,
+            visibility_total_hours = excluded.visibility_total_hours,
+            requested_mean_hours = excluded.requested_mean_hours,
+            gap_count = excluded.gap_count,
+            gap_mean_hours = excluded.gap_mean_hours,
+            gap_median_hours = excluded.gap_median_hours",
+        params![
+            schedule_id,
+            total,
+            scheduled,
+            total - scheduled,
+            impossible,
+            if total > 0 {
+                scheduled as f64 / total as f64
+            } else {
+                0.0
+            },
+            mean(&priorities),
+            priorities.median(),
+            mean(&scheduled_priorities),
+            mean(&unscheduled_priorities),
+            visibility_hours,
+            mean(&requested_hours),
+            gap_count,
+            gap_mean,
+            gap_median,
+        ],
+    )?;
+    Ok(())
+}
+
+/// Advance a schedule's `data_version`, which backs `schedule_version`.
+/// Called in the transaction of every write that changes what the
+/// schedule's analytics endpoints return.
+fn bump_data_version(conn: &Connection, schedule_id: i64) -> RepositoryResult<()> {
+    conn.execute(
+        "UPDATE schedules SET data_version = data_version + 1 WHERE schedule_id = ?1",
+        [schedule_id],
+    )?;
+    Ok(())
+}
+
+/// Replace the validation results of a schedule and re-flag its
+/// impossible blocks.
+fn write_validation_results(
+    tx: &Transaction<'_>,
+    schedule_id: i64,
+    results: &[ValidationResult],
+) -> RepositoryResult<usize> {
+    tx.execute(
+        "DELETE FROM schedule_validation_results WHERE schedule_id = ?1",
+        [schedule_id],
+    )?;
+    let mut insert = tx.prepare_cached(
+        "INSERT INTO schedule_validation_results (
+            schedule_id, scheduling_block_id, status, issue_type, issue_category,
+            criticality, field_name, current_value, expected_value, description
+         ) VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10)",
+    )?;
+    for r in results {
+        insert.execute(params![
+            r.schedule_id.0,
+            r.scheduling_block_id,
+            r.status.as_str(),
+            r.issue_type,
+            r.issue_category.map(|c| c.as_str()),
+            r.criticality.map(|c| c.as_str()),
+            r.field_name,
+            r.current_value,
+            r.expected_value,
+            r.description,
+        ])?;
+    }
+
+    tx.execute(
+        "UPDATE schedule_block_analytics SET validation_impossible = 0 WHERE schedule_id = ?1",
+        [schedule_id],
+    )?;
+    let mut flag = tx.prepare_cached(
+        "UPDATE schedule_block_analytics SET validation_impossible = 1 \
+         WHERE schedule_id = ?1 AND scheduling_block_id = ?2",
+    )?;
+    for r in results
+        .iter()
+        .filter(|r| matches!(r.status, ValidationStatus::Impossible))
+    {
+        flag.execute(params![schedule_id, r.scheduling_block_id])?;
+    }
+
+    Ok(results.len())
+}
+
+/// Blocks of schedule `?1` joined to their analytics rows.
+const ANALYTICS_JOIN: &str = "schedule_blocks b \
+     JOIN schedule_block_analytics a \
+       ON a.schedule_id = b.schedule_id AND a.scheduling_block_id = b.scheduling_block_id";
+
+fn display_block_id(original_block_id: Option<String>, source_block_id: i64) -> String {
+    original_block_id.unwrap_or_else(|| source_block_id.to_string())
+}
+
+#[async_trait]
+impl ScheduleRepository for SqliteRepository {
+    async fn health_check(&self) -> RepositoryResult<bool> {
+        self.with_read(|conn| Ok(conn.query_row("SELECT 1", [], |row| row.get::<_, i64>(0))? == 1))
+            .await
+    }
+
+    async fn store_schedule(&self, schedule: &Schedule) -> RepositoryResult<ScheduleInfo> {
+        let schedule = schedule.clone();
+        self.with_conn(move |conn| {
+            let tx = conn.transaction()?;
+
+            // Idempotency: return existing schedule if checksum matches
+            let existing = tx
+                .query_row(
+                    &format!("SELECT {INFO_COLUMNS} FROM schedules s WHERE s.checksum = ?1"),
+                    [&schedule.checksum],
+                    InfoRow::from_row,
+                )
+                .optional()?;
+            if let Some(existing) = existing {
+                return existing.into_info();
+            }
+
+            let location_json =
+                serde_json::to_string(&schedule.geographic_location).map_err(|e| {
+                    RepositoryError::internal(format!("Failed to serialize observer location: {e}"))
+                })?;
+            let mut possible_periods = Vec::new();
+            for block in &schedule.blocks {
+                possible_periods.extend(encode_periods(&block.visibility_periods));
+            }
+            tx.execute(
+                "INSERT INTO schedules (
+                    schedule_name, checksum, schedule_period_start_mjd, schedule_period_end_mjd,
+                    observer_location_json, dark_periods, astronomical_night_periods,
+                    possible_periods
+                 ) VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8)",
+                params![
+                    schedule.name,
+                    schedule.checksum,
+                    schedule.schedule_period.start.value(),
+                    schedule.schedule_period.end.value(),
+                    location_json,
+                    encode_periods(&schedule.dark_periods),
+                    encode_periods(&schedule.astronomical_nights),
+                    possible_periods,
+                ],
+            )?;
+            let schedule_id = tx.last_insert_rowid();
+
+            // One prepared statement reused per row: SQLite has no wire
+            // protocol to batch over, so this is its fastest bulk path.
+            {
+                let mut insert = tx.prepare_cached(
+                    "INSERT INTO schedule_blocks (
+                        schedule_id, source_block_id, original_block_id, block_name, priority,
+                        requested_duration_sec, min_observation_sec, target_ra_deg,
+                        target_dec_deg, min_altitude_deg, max_altitude_deg, min_azimuth_deg,
+                        max_azimuth_deg, constraint_start_mjd, constraint_stop_mjd,
+                        visibility_periods, scheduled_start_mjd, scheduled_stop_mjd
+                     ) VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11, ?12, ?13, ?14, ?15,
+                               ?16, ?17, ?18)",
+                )?;
+                for (idx, b) in schedule.blocks.iter().enumerate() {
+                    let fixed = b.constraints.fixed_time.as_ref();
+                    let scheduled = b.scheduled_period.as_ref();
+                    insert.execute(params![
+                        schedule_id,
+                        idx as i64 + 1,
+                        b.original_block_id,
+                        b.block_name,
+                        b.priority,
+                        b.requested_duration.value() as i64,
+                        b.min_observation.value() as i64,
+                        b.target_ra.value(),
+                        b.target_dec.value(),
+                        b.constraints.min_alt.value(),
+                        b.constraints.max_alt.value(),
+                        b.constraints.min_az.value(),
+                        b.constraints.max_az.value(),
+                        fixed.map(|p| p.start.value()),
+                        fixed.map(|p| p.end.value()),
+                        encode_periods(&b.visibility_periods),
+                        scheduled.map(|p| p.start.value()),
+                        scheduled.map(|p| p.end.value()),
+                    ])?;
+                }
+            }
+            tx.commit()?;
+
+            Ok(ScheduleInfo {
+                schedule_id: ScheduleId(schedule_id),
+                schedule_name: schedule.name,
+                observer_location: schedule.geographic_location,
+                schedule_period: schedule.schedule_period,
+                environment_id: None,
+            })
+        })
+        .await
+    }
+
+    async fn get_schedule(&self, schedule_id: ScheduleId) -> RepositoryResult<Schedule> {
+        self.with_read(move |conn| {
+            let (name, checksum, start, end, location_json, dark, nights) = conn.query_row(
+                "SELECT schedule_name, checksum, schedule_period_start_mjd,
+                        schedule_period_end_mjd, observer_location_json, dark_periods,
+                        astronomical_night_periods
+                 FROM schedules WHERE schedule_id = ?1",
+                [schedule_id.0],
+                |row| {
+                    Ok((
+                        row.get::<_, String>(0)?,
+                        row.get::<_, String>(1)?,
+                        row.get::<_, f64>(2)?,
+                        row.get::<_, f64>(3)?,
+                        row.get::<_, String>(4)?,
+                        row.get::<_, Vec<u8>>(5)?,
+                        row.get::<_, Vec<u8>>(6)?,
+                    ))
+                },
+            )?;
+
+            let blocks = load_block_rows(conn, schedule_id.0)?
+                .into_iter()
+                .map(BlockRow::into_block)
+                .collect::<RepositoryResult<Vec<_>>>()?;
+
+            Ok(Schedule {
+                id: Some(schedule_id.0),
+                name,
+                checksum,
+                schedule_period: Period {
+                    start: ModifiedJulianDate::new(start),
+                    end: ModifiedJulianDate::new(end),
+                },
+                dark_periods: decode_periods(&dark)?,
+                geographic_location: parse_location(&location_json)?,
+                astronomical_nights: decode_periods(&nights)?,
+                blocks,
+            })
+        })
+        .await
+    }
+
+    async fn list_schedules(&self) -> RepositoryResult<Vec<ScheduleInfo>> {
+        self.with_read(|conn| {
+            let mut stmt = conn.prepare_cached(&format!(
+                "SELECT {INFO_COLUMNS} FROM schedules s \
+                 ORDER BY s.uploaded_at DESC, s.schedule_id DESC"
+            ))?;
+            let rows = stmt
+                .query_map([], InfoRow::from_row)?
+                .collect::<rusqlite::Result<Vec<_>>>()?;
+            rows.into_iter().map(InfoRow::into_info).collect()
+        })
+        .await
+    }
+
+    async fn list_schedules_with_algorithms(
+        &self,
+        limit: u32,
+        offset: u32,
+    ) -> RepositoryResult<(Vec<(ScheduleInfo, Option<String>)>, u64)> {
+        self.with_read(move |conn| {
+            let total: i64 =
+                conn.query_row("SELECT COUNT(*) FROM schedules", [], |row| row.get(0))?;
+
+            let mut stmt = conn.prepare_cached(&format!(
+                "SELECT {INFO_COLUMNS}, t.algorithm FROM schedules s \
+                 LEFT JOIN algorithm_traces t ON t.schedule_id = s.schedule_id \
+                 ORDER BY s.uploaded_at DESC, s.schedule_id DESC LIMIT ?1 OFFSET ?2"
+            ))?;
+            let rows = stmt
+                .query_map(params![limit, offset], |row| {
+                    Ok((InfoRow::from_row(row)?, row.get::<_, Option<String>>(6)?))
+                })?
+                .collect::<rusqlite::Result<Vec<_>>>()?;
+
+            let items = rows
+                .into_iter()
+                .map(|(info, algorithm)| Ok((info.into_info()?, algorithm)))
+                .collect::<RepositoryResult<Vec<_>>>()?;
+            Ok((items, total.max(0) as u64))
+        })
+        .await
+    }
+
+    async fn get_schedule_time_range(
+        &self,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<Option<Period>> {
+        self.with_read(move |conn| {
+            let (start, end) = conn.query_row(
+                "SELECT schedule_period_start_mjd, schedule_period_end_mjd
+                 FROM schedules WHERE schedule_id = ?1",
+                [schedule_id.0],
+                |row| Ok((row.get(0)?, row.get(1)?)),
+            )?;
+            Ok(period_from(Some(start), Some(end)))
+        })
+        .await
+    }
+
+    async fn get_scheduling_block(
+        &self,
+        scheduling_block_id: i64,
+    ) -> RepositoryResult<SchedulingBlock> {
+        self.with_read(move |conn| {
+            conn.query_row(
+                &format!(
+                    "SELECT {BLOCK_COLUMNS} FROM schedule_blocks WHERE scheduling_block_id = ?1"
+                ),
+                [scheduling_block_id],
+                BlockRow::from_row,
+            )?
+            .into_block()
+        })
+        .await
+    }
+
+    async fn get_blocks_for_schedule(
+        &self,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<Vec<SchedulingBlock>> {
+        self.with_read(move |conn| {
+            load_block_rows(conn, schedule_id.0)?
+                .into_iter()
+                .map(BlockRow::into_block)
+                .collect()
+        })
+        .await
+    }
+
+    async fn get_schedule_columns(
+        &self,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<ScheduleColumns> {
+        self.with_read(move |conn| {
+            let (name, start, end, dark, nights) = conn.query_row(
+                "SELECT schedule_name, schedule_period_start_mjd, schedule_period_end_mjd,
+                        dark_periods, astronomical_night_periods
+                 FROM schedules WHERE schedule_id = ?1",
+                [schedule_id.0],
+                |row| {
+                    Ok((
+                        row.get::<_, String>(0)?,
+                        row.get::<_, f64>(1)?,
+                        row.get::<_, f64>(2)?,
+                        row.get::<_, Vec<u8>>(3)?,
+                        row.get::<_, Vec<u8>>(4)?,
+                    ))
+                },
+            )?;
+            let schedule_period = Period {
+                start: ModifiedJulianDate::new(start),
+                end: ModifiedJulianDate::new(end),
+            };
+
+            // Only the columns the analytics read; constraints stay behind.
+            let mut stmt = conn.prepare_cached(
+                "SELECT scheduling_block_id, original_block_id, block_name, priority,
+                        requested_duration_sec, visibility_periods, scheduled_start_mjd,
+                        scheduled_stop_mjd
+                 FROM schedule_blocks WHERE schedule_id = ?1 ORDER BY scheduling_block_id",
+            )?;
+            let mut rows = stmt.query([schedule_id.0])?;
+
+            let mut builder =
+                ScheduleColumnsBuilder::new(Some(schedule_id.0), name, schedule_period);
+            builder.dark_periods = decode_periods(&dark)?;
+            builder.astronomical_nights = decode_periods(&nights)?;
+            while let Some(row) = rows.next()? {
+                let original_block_id: Option<String> = row.get(1)?;
+                let block_name: String = row.get(2)?;
+                let requested: i64 = row.get(4)?;
+                let visibility: Vec<u8> = row.get(5)?;
+                builder.push_row(
+                    Some(SchedulingBlockId(row.get(0)?)),
+                    original_block_id.as_deref().unwrap_or_default(),
+                    &block_name,
+                    row.get(3)?,
+                    requested as f64,
+                    period_from(row.get(6)?, row.get(7)?),
+                    decode_periods(&visibility)?,
+                );
+            }
+            Ok(builder.finish())
+        })
+        .await
+    }
+
+    async fn fetch_dark_periods(&self, schedule_id: ScheduleId) -> RepositoryResult<Vec<Period>> {
+        self.with_read(move |conn| {
+            let dark: Vec<u8> = conn.query_row(
+                "SELECT dark_periods FROM schedules WHERE schedule_id = ?1",
+                [schedule_id.0],
+                |row| row.get(0),
+            )?;
+            decode_periods(&dark)
+        })
+        .await
+    }
+
+    async fn fetch_possible_periods(
+        &self,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<Vec<Period>> {
+        self.with_read(move |conn| {
+            let possible: Vec<u8> = conn.query_row(
+                "SELECT possible_periods FROM schedules WHERE schedule_id = ?1",
+                [schedule_id.0],
+                |row| row.get(0),
+            )?;
+            decode_periods(&possible)
+        })
+        .await
+    }
+
+    async fn delete_schedule(&self, schedule_id: ScheduleId) -> RepositoryResult<()> {
+        self.with_conn(move |conn| {
+            let deleted = conn.execute(
+                "DELETE FROM schedules WHERE schedule_id = ?1",
+                [schedule_id.0],
+            )?;
+            if deleted == 0 {
+                return Err(RepositoryError::NotFound(format!(
+                    "Schedule {} not found",
+                    schedule_id
+                )));
+            }
+            // CASCADE deletes handle related tables (blocks, analytics, validation, summary)
+            Ok(())
+        })
+        .await
+    }
+
+    async fn bulk_delete_schedules(&self, schedule_ids: &[ScheduleId]) -> RepositoryResult<usize> {
+        if schedule_ids.is_empty() {
+            return Ok(0);
+        }
+        let ids: Vec<i64> = schedule_ids.iter().map(|id| id.0).collect();
+        self.with_conn(move |conn| {
+            let tx = conn.transaction()?;
+            let mut deleted = 0;
+            {
+                let mut delete =
+                    tx.prepare_cached("DELETE FROM schedules WHERE schedule_id = ?1")?;
+                for id in ids {
+                    deleted += delete.execute([id])?;
+                }
+            }
+            tx.commit()?;
+            // CASCADE deletes handle related tables.
+            Ok(deleted)
+        })
+        .await
+    }
+
+    async fn update_schedule_metadata(
+        &self,
+        schedule_id: ScheduleId,
+        new_name: Option<String>,
+        new_location: Option<crate::api::GeographicLocation>,
+    ) -> RepositoryResult<ScheduleInfo> {
+        self.with_conn(move |conn| {
+            let location_json = new_location
+                .map(|location| serde_json::to_string(&location))
+                .transpose()
+                .map_err(|e| {
+                    RepositoryError::internal(format!("Failed to serialize observer location: {e}"))
+                })?;
+            let updated = conn.execute(
+                "UPDATE schedules SET
+                    schedule_name = COALESCE(?2, schedule_name),
+                    observer_location_json = COALESCE(?3, observer_location_json),
+                    data_version = data_version + 1
+                 WHERE schedule_id = ?1",
+                params![schedule_id.0, new_name, location_json],
+            )?;
+            if updated == 0 {
+                return Err(RepositoryError::NotFound(format!(
+                    "Schedule {} not found",
+                    schedule_id
+                )));
+            }
+            fetch_info(conn, schedule_id.0)
+        })
+        .await
+    }
+
+    async fn schedule_version(&self, schedule_id: ScheduleId) -> RepositoryResult<Option<String>> {
+        self.with_read(move |conn| {
+            let row = conn
+                .query_row(
+                    "SELECT substr(checksum, 1, 16), data_version FROM schedules
+                     WHERE schedule_id = ?1",
+                    [schedule_id.0],
+                    |row| Ok((row.get::<_, String>(0)?, row.get::<_, i64>(1)?)),
+                )
+                .optional()?;
+            // The checksum prefix keeps versions distinct when a new
+            // database file hands out the same ids again.
+            Ok(row.map(|(checksum, version)| format!("{}.{}", checksum, version)))
+        })
+        .await
+    }
+}
+
+#[async_trait]
+impl AnalyticsRepository for SqliteRepository {
+    async fn populate_schedule_analytics(
+        &self,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<usize> {
+        self.with_conn(move |conn| {
+            let tx = conn.transaction()?;
+            let block_rows = load_block_rows(&tx, schedule_id.0)?;
+
+            if block_rows.is_empty() {
+                // Keep derived tables consistent even for empty schedules.
+                tx.execute(
+                    "DELETE FROM schedule_validation_results WHERE schedule_id = ?1",
+                    [schedule_id.0],
+                )?;
+                tx.commit()?;
+                return Ok(0);
+            }
+
+            let mut analytics_rows = Vec::with_capacity(block_rows.len());
+            let mut blocks_for_validation = Vec::with_capacity(block_rows.len());
+            for row in &block_rows {
+                let (num_periods, total_visibility_hours, max_visibility_period_hours) =
+                    period_hours(&row.visibility_periods)?;
+
+                blocks_for_validation.push(BlockForValidation {
+                    schedule_id,
+                    scheduling_block_id: row.scheduling_block_id,
+                    priority: row.priority,
+                    requested_duration_sec: row.requested_duration_sec as i32,
+                    min_observation_sec: row.min_observation_sec as i32,
+                    total_visibility_hours,
+                    max_visibility_period_hours,
+                    min_alt_deg: row.min_altitude_deg,
+                    max_alt_deg: row.max_altitude_deg,
+                    constraint_start_mjd: row.constraint_start_mjd,
+                    constraint_stop_mjd: row.constraint_stop_mjd,
+                    scheduled_start_mjd: row.scheduled_start_mjd,
+                    scheduled_stop_mjd: row.scheduled_stop_mjd,
+                    target_ra_deg: row.target_ra_deg,
+                    target_dec_deg: row.target_dec_deg,
+                });
+
+                analytics_rows.push(AnalyticsRow {
+                    scheduling_block_id: row.scheduling_block_id,
+                    priority: row.priority,
+                    requested_hours: row.requested_duration_sec as f64 / 3600.0,
+                    total_visibility_hours,
+                    num_visibility_periods: num_periods as i64,
+                    elevation_range_deg: match (row.min_altitude_deg, row.max_altitude_deg) {
+                        (Some(min), Some(max)) => Some(max - min),
+                        _ => None,
+                    },
+                    scheduled_start_mjd: row.scheduled_start_mjd,
+                    scheduled_stop_mjd: row.scheduled_stop_mjd,
+                    validation_impossible: false,
+                });
+            }
+
+            // Run validation as part of ETL so the dashboard can show the Validation Report.
+            let validation_results = validate_blocks(&blocks_for_validation);
+            let impossible_block_ids: HashSet<i64> = validation_results
+                .iter()
+                .filter(|r| matches!(r.status, ValidationStatus::Impossible))
+                .map(|r| r.scheduling_block_id)
+                .collect();
+            for row in &mut analytics_rows {
+                row.validation_impossible = impossible_block_ids.contains(&row.scheduling_block_id);
+            }
+
+            {
+                let mut upsert = tx.prepare_cached(
+                    "INSERT INTO schedule_block_analytics (
+                        schedule_id, scheduling_block_id, priority_bucket, requested_hours,
+                        total_visibility_hours, num_visibility_periods, elevation_range_deg,
+                        scheduled, scheduled_start_mjd, scheduled_stop_mjd, validation_impossible
+                     ) VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11)
+                     ON CONFLICT (schedule_id, scheduling_block_id) DO UPDATE SET
+                        priority_bucket = excluded.priority_bucket,
+                        requested_hours = excluded.requested_hours,
+                        total_visibility_hours = excluded.total_visibility_hours,
+                        num_visibility_periods = excluded.num_visibility_periods,
+                        elevation_range_deg = excluded.elevation_range_deg,
+                        scheduled = excluded.scheduled,
+                        scheduled_start_mjd = excluded.scheduled_start_mjd,
+                        scheduled_stop_mjd = excluded.scheduled_stop_mjd,
+                        validation_impossible = excluded.validation_impossible",
+                )?;
+                for row in &analytics_rows {
+                    upsert.execute(params![
+                        schedule_id.0,
+                        row.scheduling_block_id,
+                        priority_bucket(row.priority),
+                        row.requested_hours,
+                        row.total_visibility_hours,
+                        row.num_visibility_periods,
+                        row.elevation_range_deg,
+                        row.scheduled(),
+                        row.scheduled_start_mjd,
+                        row.scheduled_stop_mjd,
+                        row.validation_impossible,
+                    ])?;
+                }
+            }
+
+            // Persist validation results (one-or-more per block, including "valid").
+            write_validation_results(&tx, schedule_id.0, &validation_results)?;
+            write_summary(&tx, schedule_id.0, &analytics_rows)?;
+            bump_data_version(&tx, schedule_id.0)?;
+            tx.commit()?;
+
+            Ok(analytics_rows.len())
+        })
+        .await
+    }
+
+    async fn delete_schedule_analytics(&self, schedule_id: ScheduleId) -> RepositoryResult<usize> {
+        self.with_conn(move |conn| {
+            let tx = conn.transaction()?;
+            tx.execute(
+                "DELETE FROM schedule_summary_analytics WHERE schedule_id = ?1",
+                [schedule_id.0],
+            )?;
+            let deleted = tx.execute(
+                "DELETE FROM schedule_block_analytics WHERE schedule_id = ?1",
+                [schedule_id.0],
+            )?;
+            bump_data_version(&tx, schedule_id.0)?;
+            tx.commit()?;
+            Ok(deleted)
+        })
+        .await
+    }
+
+    async fn has_analytics_data(&self, schedule_id: ScheduleId) -> RepositoryResult<bool> {
+        self.with_read(move |conn| {
+            Ok(conn.query_row(
+                "SELECT EXISTS (SELECT 1 FROM schedule_block_analytics WHERE schedule_id = ?1)",
+                [schedule_id.0],
+                |row| row.get(0),
+            )?)
+        })
+        .await
+    }
+
+    async fn fetch_analytics_blocks_for_sky_map(
+        &self,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<Vec<LightweightBlock>> {
+        self.with_read(move |conn| {
+            let mut stmt = conn.prepare_cached(&format!(
+                "SELECT b.source_block_id, b.original_block_id, b.block_name, b.priority,
+                        b.requested_duration_sec, b.target_ra_deg, b.target_dec_deg,
+                        a.scheduled_start_mjd, a.scheduled_stop_mjd
+                 FROM {ANALYTICS_JOIN} WHERE b.schedule_id = ?1"
+            ))?;
+            let blocks = stmt
+                .query_map([schedule_id.0], |row| {
+                    Ok(LightweightBlock {
+                        original_block_id: display_block_id(row.get(1)?, row.get(0)?),
+                        block_name: row.get(2)?,
+                        priority: row.get(3)?,
+                        priority_bin: String::new(),
+                        requested_duration_seconds: (row.get::<_, i64>(4)? as f64).into(),
+                        target_ra_deg: row.get::<_, f64>(5)?.into(),
+                        target_dec_deg: row.get::<_, f64>(6)?.into(),
+                        scheduled_period: period_from(row.get(7)?, row.get(8)?),
+                    })
+                })?
+                .collect::<rusqlite::Result<Vec<_>>>()?;
+            Ok(blocks)
+        })
+        .await
+    }
+
+    async fn fetch_analytics_blocks_for_distribution(
+        &self,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<Vec<DistributionBlock>> {
+        self.with_read(move |conn| {
+            let mut stmt = conn.prepare_cached(&format!(
+                "SELECT b.priority, a.total_visibility_hours, a.requested_hours,
+                        a.elevation_range_deg, a.scheduled
+                 FROM {ANALYTICS_JOIN} WHERE b.schedule_id = ?1"
+            ))?;
+            let blocks = stmt
+                .query_map([schedule_id.0], |row| {
+                    Ok(DistributionBlock {
+                        priority: row.get(0)?,
+                        total_visibility_hours: row.get::<_, f64>(1)?.into(),
+                        requested_hours: row.get::<_, f64>(2)?.into(),
+                        elevation_range_deg: row.get::<_, Option<f64>>(3)?.unwrap_or(0.0).into(),
+                        scheduled: row.get(4)?,
+                    })
+                })?
+                .collect::<rusqlite::Result<Vec<_>>>()?;
+            Ok(blocks)
+        })
+        .await
+    }
+
+    async fn fetch_analytics_blocks_for_insights(
+        &self,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<Vec<InsightsBlock>> {
+        self.with_read(move |conn| {
+            let mut stmt = conn.prepare_cached(&format!(
+                "SELECT b.scheduling_block_id, b.source_block_id, b.original_block_id,
+                        b.block_name, b.priority, a.total_visibility_hours, a.requested_hours,
+                        a.elevation_range_deg, a.scheduled, a.scheduled_start_mjd,
+                        a.scheduled_stop_mjd
+                 FROM {ANALYTICS_JOIN} WHERE b.schedule_id = ?1"
+            ))?;
+            let blocks = stmt
+                .query_map([schedule_id.0], |row| {
+                    Ok(InsightsBlock {
+                        scheduling_block_id: row.get(0)?,
+                        original_block_id: display_block_id(row.get(2)?, row.get(1)?),
+                        block_name: row.get(3)?,
+                        priority: row.get(4)?,
+                        total_visibility_hours: qtty::time::Hours::new(row.get(5)?),
+                        requested_hours: qtty::time::Hours::new(row.get(6)?),
+                        elevation_range_deg: qtty::Degrees::new(
+                            row.get::<_, Option<f64>>(7)?.unwrap_or(0.0),
+                        ),
+                        scheduled: row.get(8)?,
+                        scheduled_start_mjd: row
+                            .get::<_, Option<f64>>(9)?
+                            .map(ModifiedJulianDate::new),
+                        scheduled_stop_mjd: row
+                            .get::<_, Option<f64>>(10)?
+                            .map(ModifiedJulianDate::new),
+                    })
+                })?
+                .collect::<rusqlite::Result<Vec<_>>>()?;
+            Ok(blocks)
+        })
+        .await
+    }
+}
+
+#[async_trait]
+impl ValidationRepository for SqliteRepository {
+    async fn insert_validation_results(
+        &self,
+        results: &[ValidationResult],
+    ) -> RepositoryResult<usize> {
+        if results.is_empty() {
+            return Ok(0);
+        }
+        let results = results.to_vec();
+        self.with_conn(move |conn| {
+            let tx = conn.transaction()?;
+            let inserted = write_validation_results(&tx, results[0].schedule_id.0, &results)?;
+            bump_data_version(&tx, results[0].schedule_id.0)?;
+            tx.commit()?;
+            Ok(inserted)
+        })
+        .await
+    }
+
+    async fn fetch_validation_results(
+        &self,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<crate::api::ValidationReport> {
+        self.with_read(move |conn| {
+            let mut blocks = conn.prepare_cached(
+                "SELECT scheduling_block_id, original_block_id, block_name
+                 FROM schedule_blocks WHERE schedule_id = ?1",
+            )?;
+            let block_id_map: HashMap<i64, (Option<String>, String)> = blocks
+                .query_map([schedule_id.0], |row| {
+                    Ok((row.get(0)?, (row.get(1)?, row.get(2)?)))
+                })?
+                .collect::<rusqlite::Result<_>>()?;
+            let total_blocks = block_id_map.len();
+
+            let mut results = conn.prepare_cached(
+                "SELECT scheduling_block_id, status, issue_type, issue_category, criticality,
+                        field_name, current_value, expected_value, description
+                 FROM schedule_validation_results
+                 WHERE schedule_id = ?1 ORDER BY validation_id",
+            )?;
+            let mut rows = results.query([schedule_id.0])?;
+
+            let mut impossible_blocks = Vec::new();
+            let mut validation_errors = Vec::new();
+            let mut validation_warnings = Vec::new();
+            let mut valid_blocks = 0usize;
+            let mut any = false;
+
+            while let Some(row) = rows.next()? {
+                any = true;
+                let block_id: i64 = row.get(0)?;
+                let status: String = row.get(1)?;
+                if status == ValidationStatus::Valid.as_str() {
+                    valid_blocks += 1;
+                    continue;
+                }
+
+                let (original_block_id, block_name) = block_id_map
+                    .get(&block_id)
+                    .cloned()
+                    .unwrap_or((None, String::new()));
+                let issue = crate::api::ValidationIssue {
+                    block_id,
+                    original_block_id,
+                    block_name: (!block_name.is_empty()).then_some(block_name),
+                    issue_type: row.get::<_, Option<String>>(2)?.unwrap_or_default(),
+                    category: row.get::<_, Option<String>>(3)?.unwrap_or_default(),
+                    criticality: row.get::<_, Option<String>>(4)?.unwrap_or_default(),
+                    field_name: row.get(5)?,
+                    current_value: row.get(6)?,
+                    expected_value: row.get(7)?,
+                    description: row.get::<_, Option<String>>(8)?.unwrap_or_default(),
+                };
+                if status == ValidationStatus::Impossible.as_str() {
+                    impossible_blocks.push(issue);
+                } else if status == ValidationStatus::Warning.as_str() {
+                    validation_warnings.push(issue);
+                } else {
+                    validation_errors.push(issue);
+                }
+            }
+
+            if !any {
+                // If validation hasn't been populated yet, return an "all valid" empty report
+                // instead of hard failing the UI.
+                valid_blocks = total_blocks;
+            }
+
+            Ok(crate::api::ValidationReport {
+                schedule_id,
+                total_blocks,
+                valid_blocks,
+                impossible_blocks,
+                validation_errors,
+                validation_warnings,
+            })
+        })
+        .await
+    }
+
+    async fn has_validation_results(&self, schedule_id: ScheduleId) -> RepositoryResult<bool> {
+        self.with_read(move |conn| {
+            Ok(conn.query_row(
+                "SELECT EXISTS (SELECT 1 FROM schedule_validation_results WHERE schedule_id = ?1)",
+                [schedule_id.0],
+                |row| row.get(0),
+            )?)
+        })
+        .await
+    }
+
+    async fn delete_validation_results(&self, schedule_id: ScheduleId) -> RepositoryResult<u64> {
+        self.with_conn(move |conn| {
+            let tx = conn.transaction()?;
+            let deleted = tx.execute(
+                "DELETE FROM schedule_validation_results WHERE schedule_id = ?1",
+                [schedule_id.0],
+            )?;
+            bump_data_version(&tx, schedule_id.0)?;
+            tx.commit()?;
+            Ok(deleted as u64)
+        })
+        .await
+    }
+}
+
+#[async_trait]
+impl VisualizationRepository for SqliteRepository {
+    async fn fetch_schedule_timeline_blocks(
+        &self,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<Vec<ScheduleTimelineBlock>> {
+        self.with_read(move |conn| {
+            let mut stmt = conn.prepare_cached(&format!(
+                "SELECT b.scheduling_block_id, b.source_block_id, b.original_block_id,
+                        b.block_name, b.priority, a.scheduled_start_mjd, a.scheduled_stop_mjd,
+                        b.target_ra_deg, b.target_dec_deg, a.requested_hours,
+                        a.total_visibility_hours, a.num_visibility_periods
+                 FROM {ANALYTICS_JOIN}
+                 WHERE b.schedule_id = ?1 AND a.scheduled
+                   AND a.scheduled_start_mjd IS NOT NULL AND a.scheduled_stop_mjd IS NOT NULL"
+            ))?;
+            let blocks = stmt
+                .query_map([schedule_id.0], |row| {
+                    Ok(ScheduleTimelineBlock {
+                        scheduling_block_id: row.get(0)?,
+                        original_block_id: display_block_id(row.get(2)?, row.get(1)?),
+                        block_name: row.get(3)?,
+                        priority: row.get(4)?,
+                        scheduled_start_mjd: ModifiedJulianDate::new(row.get(5)?),
+                        scheduled_stop_mjd: ModifiedJulianDate::new(row.get(6)?),
+                        ra_deg: qtty::Degrees::new(row.get(7)?),
+                        dec_deg: qtty::Degrees::new(row.get(8)?),
+                        requested_hours: qtty::time::Hours::new(row.get(9)?),
+                        total_visibility_hours: qtty::time::Hours::new(row.get(10)?),
+                        num_visibility_periods: row.get::<_, i64>(11)? as usize,
+                    })
+                })?
+                .collect::<rusqlite::Result<Vec<_>>>()?;
+            Ok(blocks)
+        })
+        .await
+    }
+
+    async fn fetch_compare_blocks(
+        &self,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<Vec<CompareBlock>> {
+        self.with_read(move |conn| {
+            let mut stmt = conn.prepare_cached(&format!(
+                "SELECT b.scheduling_block_id, b.original_block_id, b.block_name, b.priority,
+                        a.scheduled, a.requested_hours, a.scheduled_start_mjd,
+                        a.scheduled_stop_mjd
+                 FROM {ANALYTICS_JOIN} WHERE b.schedule_id = ?1"
+            ))?;
+            let blocks = stmt
+                .query_map([schedule_id.0], |row| {
+                    Ok(CompareBlock {
+                        scheduling_block_id: row.get::<_, i64>(0)?.to_string(),
+                        original_block_id: row.get::<_, Option<String>>(1)?.unwrap_or_default(),
+                        block_name: row.get(2)?,
+                        priority: row.get(3)?,
+                        scheduled: row.get(4)?,
+                        requested_hours: row.get::<_, f64>(5)?.into(),
+                        scheduled_start_mjd: row.get(6)?,
+                        scheduled_stop_mjd: row.get(7)?,
+                    })
+                })?
+                .collect::<rusqlite::Result<Vec<_>>>()?;
+            Ok(blocks)
+        })
+        .await
+    }
+
+    async fn fetch_visibility_map_data(
+        &self,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<VisibilityMapData> {
+        self.with_read(move |conn| {
+            let mut stmt = conn.prepare_cached(&format!(
+                "SELECT b.scheduling_block_id, b.source_block_id, b.original_block_id,
+                        b.block_name, b.priority, a.num_visibility_periods, a.scheduled
+                 FROM {ANALYTICS_JOIN} WHERE b.schedule_id = ?1"
+            ))?;
+            let blocks = stmt
+                .query_map([schedule_id.0], visibility_summary)?
+                .collect::<rusqlite::Result<Vec<_>>>()?;
+
+            if blocks.is_empty() {
+                return Ok(VisibilityMapData {
+                    blocks: vec![],
+                    priority_min: 0.0,
+                    priority_max: 1.0,
+                    total_count: 0,
+                    scheduled_count: 0,
+                });
+            }
+
+            let priority_min = blocks.iter().map(|b| b.priority).fold(f64::MAX, f64::min);
+            let priority_max = blocks.iter().map(|b| b.priority).fold(f64::MIN, f64::max);
+            let scheduled_count = blocks.iter().filter(|b| b.scheduled).count();
+            let total_count = blocks.len();
+
+            Ok(VisibilityMapData {
+                blocks,
+                priority_min,
+                priority_max,
+                total_count,
+                scheduled_count,
+            })
+        })
+        .await
+    }
+
+    async fn fetch_visibility_blocks_page(
+        &self,
+        schedule_id: ScheduleId,
+        query: &VisibilityBlocksQuery,
+    ) -> RepositoryResult<VisibilityBlocksPage> {
+        let query = query.clone();
+        self.with_read(move |conn| {
+            let limit = query.limit.clamp(1, MAX_VISIBILITY_PAGE_SIZE);
+
+            // Filters shared by the count and the page query.
+            let mut filter = String::from("b.schedule_id = ?");
+            let mut args: Vec<SqlValue> = vec![SqlValue::Integer(schedule_id.0)];
+            if let Some(min_p) = query.priority_min {
+                filter.push_str(" AND b.priority >= ?");
+                args.push(SqlValue::Real(min_p));
+            }
+            if let Some(max_p) = query.priority_max {
+                filter.push_str(" AND b.priority <= ?");
+                args.push(SqlValue::Real(max_p));
+            }
+            if let Some(scheduled) = query.scheduled {
+                filter.push_str(" AND a.scheduled = ?");
+                args.push(SqlValue::Integer(scheduled as i64));
+            }
+            if let Some(search) = query.search.as_deref().map(str::trim).filter(|s| !s.is_empty()) {
+                // SQLite's LIKE is case-insensitive for ASCII, like ILIKE.
+                let pattern = format!("%{}%", escape_like(search));
+                filter.push_str(
+                    " AND (b.original_block_id LIKE ? ESCAPE '\\' OR b.block_name LIKE ? ESCAPE '\\'",
+                );
+                args.push(SqlValue::Text(pattern.clone()));
+                args.push(SqlValue::Text(pattern));
+                if let Ok(id) = search.parse::<i64>() {
+                    filter.push_str(" OR b.scheduling_block_id = ?");
+                    args.push(SqlValue::Integer(id));
+                }
+                filter.push(')');
+            }
+
+            let (priority_min, priority_max, total_count): (Option<f64>, Option<f64>, i64) = conn
+                .query_row(
+                    "SELECT MIN(priority), MAX(priority), COUNT(*)
+                     FROM schedule_blocks WHERE schedule_id = ?1",
+                    [schedule_id.0],
+                    |row| Ok((row.get(0)?, row.get(1)?, row.get(2)?)),
+                )?;
+            let scheduled_count: i64 = conn.query_row(
+                "SELECT COUNT(*) FROM schedule_block_analytics WHERE schedule_id = ?1 AND scheduled",
+                [schedule_id.0],
+                |row| row.get(0),
+            )?;
+            let matched_count: i64 = conn.query_row(
+                &format!("SELECT COUNT(*) FROM {ANALYTICS_JOIN} WHERE {filter}"),
+                params_from_iter(args.iter()),
+                |row| row.get(0),
+            )?;
+
+            let (key, after_key) = match query.sort {
+                VisibilityBlockSort::Priority => {
+                    ("b.priority", query.after.map(|c| SqlValue::Real(c.key)))
+                }
+                VisibilityBlockSort::NumVisibilityPeriods => (
+                    "a.num_visibility_periods",
+                    query.after.map(|c| SqlValue::Integer(c.key as i64)),
+                ),
+                VisibilityBlockSort::Scheduled => (
+                    "a.scheduled",
+                    query
+                        .after
+                        .map(|c| SqlValue::Integer((c.key >= 0.5) as i64)),
+                ),
+            };
+            let (cmp, dir) = match query.direction {
+                SortDirection::Asc => (">", "ASC"),
+                SortDirection::Desc => ("<", "DESC"),
+            };
+            let mut page_sql = format!(
+                "SELECT b.scheduling_block_id, b.source_block_id, b.original_block_id,
+                        b.block_name, b.priority, a.num_visibility_periods, a.scheduled
+                 FROM {ANALYTICS_JOIN} WHERE {filter}"
+            );
+            if let (Some(after), Some(after_key)) = (query.after, after_key) {
+                // Keyset: rows strictly past (key, id) in the query direction.
+                page_sql.push_str(&format!(" AND ({key}, b.scheduling_block_id) {cmp} (?, ?)"));
+                args.push(after_key);
+                args.push(SqlValue::Integer(after.id));
+            }
+            page_sql.push_str(&format!(
+                " ORDER BY {key} {dir}, b.scheduling_block_id {dir} LIMIT ? OFFSET ?"
+            ));
+            // One extra row tells us whether another page follows.
+            args.push(SqlValue::Integer(limit as i64 + 1));
+            args.push(SqlValue::Integer(if query.after.is_some() {
+                0
+            } else {
+                query.offset as i64
+            }));
+
+            let mut stmt = conn.prepare(&page_sql)?;
+            let mut blocks = stmt
+                .query_map(params_from_iter(args.iter()), visibility_summary)?
+                .collect::<rusqlite::Result<Vec<_>>>()?;
+            let has_more = blocks.len() > limit;
+            blocks.truncate(limit);
+
+            let next_cursor = if has_more {
+                blocks.last().map(|b| VisibilityBlockCursor {
+                    key: query.sort.key(b),
+                    id: b.scheduling_block_id,
+                })
+            } else {
+                None
+            };
+
+            Ok(VisibilityBlocksPage {
+                blocks,
+                matched_count: matched_count as usize,
+                total_count: total_count as usize,
+                scheduled_count: scheduled_count as usize,
+                priority_min: priority_min.unwrap_or(0.0),
+                priority_max: priority_max.unwrap_or(1.0),
+                next_cursor,
+            })
+        })
+        .await
+    }
+
+    async fn fetch_blocks_for_histogram(
+        &self,
+        schedule_id: ScheduleId,
+        priority_min: Option<f64>,
+        priority_max: Option<f64>,
+        block_ids: Option<Vec<i64>>,
+    ) -> RepositoryResult<Vec<crate::db::models::BlockHistogramData>> {
+        self.with_read(move |conn| {
+            // Filter ids here rather than binding an IN list that could
+            // exceed SQLite's parameter limit.
+            let wanted: Option<HashSet<i64>> = block_ids.map(|ids| ids.into_iter().collect());
+            let mut stmt = conn.prepare_cached(
+                "SELECT scheduling_block_id, priority, visibility_periods FROM schedule_blocks
+                 WHERE schedule_id = ?1
+                   AND (?2 IS NULL OR priority >= ?2) AND (?3 IS NULL OR priority <= ?3)",
+            )?;
+            let mut rows = stmt.query(params![schedule_id.0, priority_min, priority_max])?;
+
+            let mut blocks = Vec::new();
+            while let Some(row) = rows.next()? {
+                let block_id: i64 = row.get(0)?;
+                if wanted.as_ref().is_some_and(|ids| !ids.contains(&block_id)) {
+                    continue;
+                }
+                blocks.push(crate::db::models::BlockHistogramData {
+                    scheduling_block_id: block_id,
+                    priority: row.get(1)?,
+                    visibility_periods: decode_periods(&row.get::<_, Vec<u8>>(2)?).ok(),
+                });
+            }
+            Ok(blocks)
+        })
+        .await
+    }
+
+    async fn fetch_gap_metrics(
+        &self,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<(Option<i32>, Option<qtty::Hours>, Option<qtty::Hours>)> {
+        self.with_read(move |conn| {
+            let result = conn
+                .query_row(
+                    "SELECT gap_count, gap_mean_hours, gap_median_hours
+                     FROM schedule_summary_analytics WHERE schedule_id = ?1",
+                    [schedule_id.0],
+                    |row| {
+                        Ok((
+                            row.get::<_, Option<i32>>(0)?,
+                            row.get::<_, Option<f64>>(1)?,
+                            row.get::<_, Option<f64>>(2)?,
+                        ))
+                    },
+                )
+                .optional()?;
+
+            Ok(match result {
+                Some((count, mean, median)) => (
+                    count,
+                    mean.map(qtty::Hours::new),
+                    median.map(qtty::Hours::new),
+                ),
+                None => (None, None, None),
+            })
+        })
+        .await
+    }
+}
+
+fn visibility_summary(row: &rusqlite::Row<'_>) -> rusqlite::Result<VisibilityBlockSummary> {
+    Ok(VisibilityBlockSummary {
+        scheduling_block_id: row.get(0)?,
+        original_block_id: display_block_id(row.get(2)?, row.get(1)?),
+        block_name: row.get(3)?,
+        priority: row.get(4)?,
+        num_visibility_periods: row.get::<_, i64>(5)? as usize,
+        scheduled: row.get(6)?,
+    })
+}
+
+// ==================== Environment Repository ====================
+
+/// Columns of an `environments` row, as read by [`environment_info`].
+const ENVIRONMENT_COLUMNS: &str = "environment_id, name, period_start_mjd, period_end_mjd, \
+     lat_deg, lon_deg, elevation_m, blocks_hash, created_at";
+
+fn environment_info(
+    conn: &Connection,
+    row: &rusqlite::Row<'_>,
+) -> RepositoryResult<crate::api::EnvironmentInfo> {
+    let environment_id: i64 = row.get(0)?;
+    let structure = match (
+        row.get::<_, Option<f64>>(2)?,
+        row.get::<_, Option<f64>>(3)?,
+        row.get::<_, Option<f64>>(4)?,
+        row.get::<_, Option<f64>>(5)?,
+        row.get::<_, Option<f64>>(6)?,
+        row.get::<_, Option<String>>(7)?,
+    ) {
+        (Some(start), Some(end), Some(lat), Some(lon), Some(elev), Some(hash)) => {
+            Some(crate::api::EnvironmentStructure {
+                period_start_mjd: start,
+                period_end_mjd: end,
+                lat_deg: lat,
+                lon_deg: lon,
+                elevation_m: elev,
+                blocks_hash: hash,
+            })
+        }
+        _ => None,
+    };
+
+    let mut schedules = conn.prepare_cached(
+        "SELECT schedule_id FROM schedules WHERE environment_id = ?1 ORDER BY schedule_id",
+    )?;
+    let schedule_ids = schedules
+        .query_map([environment_id], |row| Ok(ScheduleId(row.get(0)?)))?
+        .collect::<rusqlite::Result<Vec<_>>>()?;
+
+    Ok(crate::api::EnvironmentInfo {
+        environment_id,
+        name: row.get(1)?,
+        structure,
+        schedule_ids,
+        created_at: parse_timestamp(&row.get::<_, String>(8)?)?,
+    })
+}
+
+#[async_trait]
+impl crate::db::repository::EnvironmentRepository for SqliteRepository {
+    async fn list_environments(&self) -> RepositoryResult<Vec<crate::api::EnvironmentInfo>> {
+        self.with_read(|conn| {
+            let mut stmt = conn.prepare_cached(&format!(
+                "SELECT {ENVIRONMENT_COLUMNS} FROM environments ORDER BY environment_id"
+            ))?;
+            let mut rows = stmt.query([])?;
+            let mut result = Vec::new();
+            while let Some(row) = rows.next()? {
+                result.push(environment_info(conn, row)?);
+            }
+            Ok(result)
+        })
+        .await
+    }
+
+    async fn get_environment(
+        &self,
+        id: crate::api::EnvironmentId,
+    ) -> RepositoryResult<Option<crate::api::EnvironmentInfo>> {
+        self.with_read(move |conn| {
+            let mut stmt = conn.prepare_cached(&format!(
+                "SELECT {ENVIRONMENT_COLUMNS} FROM environments WHERE environment_id = ?1"
+            ))?;
+            let mut rows = stmt.query([id])?;
+            match rows.next()? {
+                Some(row) => environment_info(conn, row).map(Some),
+                None => Ok(None),
+            }
+        })
+        .await
+    }
+
+    async fn create_environment(
+        &self,
+        name: &str,
+    ) -> RepositoryResult<crate::api::EnvironmentInfo> {
+        let name = name.to_string();
+        self.with_conn(move |conn| {
+            let tx = conn.transaction()?;
+
+            // Check for duplicate name (case-insensitive)
+            let name_lower = name.trim().to_lowercase();
+            {
+                let mut names = tx.prepare_cached("SELECT name FROM environments")?;
+                let mut rows = names.query([])?;
+                while let Some(row) = rows.next()? {
+                    if row.get::<_, String>(0)?.trim().to_lowercase() == name_lower {
+                        return Err(RepositoryError::validation(format!(
+                            "Environment with name '{}' already exists",
+                            name
+                        )));
+                    }
+                }
+            }
+
+            let created_at = chrono::Utc::now();
+            tx.execute(
+                "INSERT INTO environments (name, created_at) VALUES (?1, ?2)",
+                params![name, created_at.to_rfc3339()],
+            )?;
+            let environment_id = tx.last_insert_rowid();
+            tx.commit()?;
+
+            Ok(crate::api::EnvironmentInfo {
+                environment_id,
+                name,
+                structure: None,
+                schedule_ids: vec![],
+                created_at,
+            })
+        })
+        .await
+    }
+
+    async fn delete_environment(&self, id: crate::api::EnvironmentId) -> RepositoryResult<()> {
+        self.with_conn(move |conn| {
+            let tx = conn.transaction()?;
+            tx.execute(
+                "UPDATE schedules SET data_version = data_version + 1 WHERE environment_id = ?1",
+                [id],
+            )?;
+            // Schedules are unassigned (SET NULL) and the preschedule cache
+            // removed (CASCADE) by the foreign keys.
+            let deleted = tx.execute("DELETE FROM environments WHERE environment_id = ?1", [id])?;
+            if deleted == 0 {
+                return Err(RepositoryError::not_found(format!(
+                    "Environment {} not found",
+                    id
+                )));
+            }
+            tx.commit()?;
+            Ok(())
+        })
+        .await
+    }
+
+    async fn initialise_environment(
+        &self,
+        id: crate::api::EnvironmentId,
+        structure: &crate::api::EnvironmentStructure,
+        preschedule: &serde_json::Value,
+    ) -> RepositoryResult<()> {
+        let structure = structure.clone();
+        let payload = preschedule.to_string();
+        self.with_conn(move |conn| {
+            let tx = conn.transaction()?;
+
+            let current = tx
+                .query_row(
+                    "SELECT period_start_mjd, period_end_mjd, lat_deg, lon_deg, elevation_m,
+                            blocks_hash
+                     FROM environments WHERE environment_id = ?1",
+                    [id],
+                    |row| {
+                        Ok((
+                            row.get::<_, Option<f64>>(0)?,
+                            row.get::<_, Option<f64>>(1)?,
+                            row.get::<_, Option<f64>>(2)?,
+                            row.get::<_, Option<f64>>(3)?,
+                            row.get::<_, Option<f64>>(4)?,
+                            row.get::<_, Option<String>>(5)?,
+                        ))
+                    },
+                )
+                .optional()?
+                .ok_or_else(|| {
+                    RepositoryError::not_found(format!("Environment {} not found", id))
+                })?;
+
+            if current.0.is_some() {
+                // Already initialised: the structure must match.
+                let matches = current
+                    == (
+                        Some(structure.period_start_mjd),
+                        Some(structure.period_end_mjd),
+                        Some(structure.lat_deg),
+                        Some(structure.lon_deg),
+                        Some(structure.elevation_m),
+                        Some(structure.blocks_hash.clone()),
+                    );
+                if !matches {
+                    return Err(RepositoryError::validation(format!(
+                        "Environment {} already has a different structure",
+                        id
+                    )));
+                }
+            } else {
+                tx.execute(
+                    "UPDATE environments SET period_start_mjd = ?2, period_end_mjd = ?3,
+                            lat_deg = ?4, lon_deg = ?5, elevation_m = ?6, blocks_hash = ?7
+                     WHERE environment_id = ?1",
+                    params![
+                        id,
+                        structure.period_start_mjd,
+                        structure.period_end_mjd,
+                        structure.lat_deg,
+                        structure.lon_deg,
+                        structure.elevation_m,
+                        structure.blocks_hash,
+                    ],
+                )?;
+            }
+
+            // Upsert preschedule cache
+            tx.execute(
+                "INSERT INTO environment_preschedule (environment_id, payload_json, computed_at)
+                 VALUES (?1, ?2, ?3)
+                 ON CONFLICT (environment_id) DO UPDATE SET
+                    payload_json = excluded.payload_json,
+                    computed_at = excluded.computed_at",
+                params![id, payload, chrono::Utc::now().to_rfc3339()],
+            )?;
+            tx.commit()?;
+            Ok(())
+        })
+        .await
+    }
+
+    async fn assign_schedule(
+        &self,
+        schedule_id: ScheduleId,
+        env_id: crate::api::EnvironmentId,
+    ) -> RepositoryResult<()> {
+        self.with_conn(move |conn| {
+            let updated = conn.execute(
+                "UPDATE schedules SET environment_id = ?2, data_version = data_version + 1
+                 WHERE schedule_id = ?1",
+                params![schedule_id.0, env_id],
+            )?;
+            if updated == 0 {
+                return Err(RepositoryError::not_found(format!(
+                    "Schedule {} not found",
+                    schedule_id
+                )));
+            }
+            Ok(())
+        })
+        .await
+    }
+
+    async fn unassign_schedule(&self, schedule_id: ScheduleId) -> RepositoryResult<()> {
+        self.with_conn(move |conn| {
+            conn.execute(
+                "UPDATE schedules SET environment_id = NULL, data_version = data_version + 1
+                 WHERE schedule_id = ?1",
+                [schedule_id.0],
+            )?;
+            Ok(())
+        })
+        .await
+    }
+
+    async fn get_preschedule(
+        &self,
+        env_id: crate::api::EnvironmentId,
+    ) -> RepositoryResult<Option<serde_json::Value>> {
+        self.with_read(move |conn| {
+            let payload: Option<String> = conn
+                .query_row(
+                    "SELECT payload_json FROM environment_preschedule WHERE environment_id = ?1",
+                    [env_id],
+                    |row| row.get(0),
+                )
+                .optional()?;
+            payload
+                .map(|p| {
+                    serde_json::from_str(&p).map_err(|e| {
+                        RepositoryError::internal(format!("Failed to decode preschedule: {e}"))
+                    })
+                })
+                .transpose()
+        })
+        .await
+    }
+}
+
+#[async_trait]
+impl AlgorithmTraceRepository for SqliteRepository {
+    async fn store_algorithm_trace(
+        &self,
+        schedule_id: ScheduleId,
+        algorithm: &str,
+        summary: &serde_json::Value,
+        iterations: &serde_json::Value,
+    ) -> RepositoryResult<()> {
+        let algorithm = algorithm.to_string();
+        let summary = summary.to_string();
+        let iterations = iterations.to_string();
+        self.with_conn(move |conn| {
+            let tx = conn.transaction()?;
+            tx.execute(
+                "INSERT INTO algorithm_traces (schedule_id, algorithm, summary, iterations)
+                 VALUES (?1, ?2, ?3, ?4)
+                 ON CONFLICT (schedule_id) DO UPDATE SET
+                    algorithm = excluded.algorithm,
+                    summary = excluded.summary,
+                    iterations = excluded.iterations,
+                    created_at = excluded.created_at",
+                params![schedule_id.0, algorithm, summary, iterations],
+            )?;
+            bump_data_version(&tx, schedule_id.0)?;
+            tx.commit()?;
+            Ok(())
+        })
+        .await
+    }
+
+    async fn get_algorithm_trace(
+        &self,
+        schedule_id: ScheduleId,
+    ) -> RepositoryResult<Option<AlgorithmTraceResponse>> {
+        self.with_read(move |conn| {
+            let row = conn
+                .query_row(
+                    "SELECT algorithm, summary, iterations FROM algorithm_traces
+                     WHERE schedule_id = ?1",
+                    [schedule_id.0],
+                    |row| {
+                        Ok((
+                            row.get::<_, String>(0)?,
+                            row.get::<_, String>(1)?,
+                            row.get::<_, String>(2)?,
+                        ))
+                    },
+                )
+                .optional()?;
+
+            let Some((algorithm, summary_json, iterations_json)) = row else {
+                return Ok(None);
+            };
+
+            let mut summary: AlgorithmTraceSummary =
+                serde_json::from_str(&summary_json).map_err(|e| {
+                    RepositoryError::internal(format!(
+                        "Failed to decode algorithm_trace summary: {e}"
+                    ))
+                })?;
+            if summary.algorithm.is_empty() {
+                summary.algorithm = algorithm;
+            }
+            let iterations: Vec<AlgorithmTraceIteration> = serde_json::from_str(&iterations_json)
+                .map_err(|e| {
+                RepositoryError::internal(format!(
+                    "Failed to decode algorithm_trace iterations: {e}"
+                ))
+            })?;
+
+            Ok(Some(AlgorithmTraceResponse {
+                schedule_id,
+                summary,
+                iterations,
+            }))
+        })
+        .await
+    }
+
+    async fn list_algorithm_names(&self) -> RepositoryResult<Vec<(ScheduleId, String)>> {
+        self.with_read(|conn| {
+            let mut stmt =
+                conn.prepare_cached("SELECT schedule_id, algorithm FROM algorithm_traces")?;
+            let rows = stmt
+                .query_map([], |row| Ok((ScheduleId::new(row.get(0)?), row.get(1)?)))?
+                .collect::<rusqlite::Result<Vec<_>>>()?;
+            Ok(rows)
+        })
+        .await
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::db::repository::EnvironmentRepository;
+    use qtty::{Degrees, Meters};
+    use siderust::coordinates::centers::Geodetic;
+    use siderust::coordinates::frames::ECEF;
+
+    fn period(start: f64, end: f64) -> Period {
+        Period {
+            start: ModifiedJulianDate::new(start),
+            end: ModifiedJulianDate::new(end),
+        }
+    }
+
+    fn schedule(checksum: &str, blocks: usize) -> Schedule {
+        Schedule {
+            id: None,
+            name: checksum.to_string(),
+            blocks: (0..blocks)
+                .map(|i| {
+                    let start = 60000.0 + i as f64 * 0.25;
+                    SchedulingBlock::new(
+                        format!("ob-{i}"),
+                        "M31".to_string(),
+                        Degrees::new(10.0),
+                        Degrees::new(41.0),
+                        Constraints::new(
+                            Degrees::new(30.0),
+                            Degrees::new(90.0),
+                            Degrees::new(0.0),
+                            Degrees::new(360.0),
+                            None,
+                        ),
+                        i as f64,
+                        600.0.into(),
+                        3600.0.into(),
+                        None,
+                        Some(vec![period(start, start + 0.2)]),
+                        // Every other block is scheduled at the start of its window.
+                        (i % 2 == 0).then(|| period(start, start + 1.0 / 24.0)),
+                    )
+                })
+                .collect(),
+            dark_periods: vec![period(60000.0, 60000.4)],
+            geographic_location: Geodetic::<ECEF>::new(
+                Degrees::new(-17.8892),
+                Degrees::new(28.7624),
+                Meters::new(2396.0),
+            ),
+            astronomical_nights: vec![],
+            checksum: checksum.to_string(),
+            schedule_period: period(60000.0, 60002.0),
+        }
+    }
+
+    #[tokio::test]
+    async fn test_store_is_idempotent_by_checksum() {
+        let repo = SqliteRepository::open_in_memory().unwrap();
+        let first = repo.store_schedule(&schedule("a", 3)).await.unwrap();
+        let again = repo.store_schedule(&schedule("a", 3)).await.unwrap();
+        assert_eq!(first.schedule_id, again.schedule_id);
+        assert_eq!(repo.list_schedules().await.unwrap().len(), 1);
+
+        let stored = repo.get_schedule(first.schedule_id).await.unwrap();
+        assert_eq!(stored.blocks.len(), 3);
+        assert_eq!(stored.blocks[1].original_block_id, "ob-1");
+        assert_eq!(stored.blocks[1].visibility_periods.len(), 1);
+        assert!(stored.blocks[1].scheduled_period.is_none());
+        assert_eq!(stored.dark_periods[0].end.value(), 60000.4);
+        assert_eq!(
+            repo.fetch_possible_periods(first.schedule_id)
+                .await
+                .unwrap()
+                .len(),
+            3
+        );
+    }
+
+    #[tokio::test]
+    async fn test_populate_analytics_and_gaps() {
+        let repo = SqliteRepository::open_in_memory().unwrap();
+        let id = repo
+            .store_schedule(&schedule("a", 5))
+            .await
+            .unwrap()
+            .schedule_id;
+        assert_eq!(
+            repo.fetch_gap_metrics(id).await.unwrap(),
+            (None, None, None)
+        );
+
+        assert_eq!(repo.populate_schedule_analytics(id).await.unwrap(), 5);
+        assert!(repo.has_analytics_data(id).await.unwrap());
+        assert!(repo.has_validation_results(id).await.unwrap());
+
+        // Blocks 0, 2 and 4 run for an hour each, half a day apart.
+        let (count, mean, median) = repo.fetch_gap_metrics(id).await.unwrap();
+        assert_eq!(count, Some(2));
+        assert!((mean.unwrap().value() - 11.0).abs() < 1e-9);
+        assert!((median.unwrap().value() - 11.0).abs() < 1e-9);
+
+        assert_eq!(
+            repo.fetch_schedule_timeline_blocks(id).await.unwrap().len(),
+            3
+        );
+        let map = repo.fetch_visibility_map_data(id).await.unwrap();
+        assert_eq!((map.total_count, map.scheduled_count), (5, 3));
+        assert_eq!((map.priority_min, map.priority_max), (0.0, 4.0));
+    }
+
+    #[tokio::test]
+    async fn test_schedule_version_follows_derived_writes() {
+        let repo = SqliteRepository::open_in_memory().unwrap();
+        let id = repo
+            .store_schedule(&schedule("a", 3))
+            .await
+            .unwrap()
+            .schedule_id;
+
+        let stored = repo.schedule_version(id).await.unwrap().unwrap();
+        repo.populate_schedule_analytics(id).await.unwrap();
+        let populated = repo.schedule_version(id).await.unwrap().unwrap();
+        assert_ne!(stored, populated);
+
+        repo.update_schedule_metadata(id, Some("renamed".into()), None)
+            .await
+            .unwrap();
+        assert_ne!(repo.schedule_version(id).await.unwrap().unwrap(), populated);
+
+        repo.delete_schedule(id).await.unwrap();
+        assert_eq!(repo.schedule_version(id).await.unwrap(), None);
+    }
+
+    #[tokio::test]
+    async fn test_visibility_page_keyset_walk() {
+        let repo = SqliteRepository::open_in_memory().unwrap();
+        let id = repo
+            .store_schedule(&schedule("a", 7))
+            .await
+            .unwrap()
+            .schedule_id;
+        repo.populate_schedule_analytics(id).await.unwrap();
+
+        let mut query = VisibilityBlocksQuery {
+            limit: 3,
+            sort: VisibilityBlockSort::Priority,
+            direction: SortDirection::Desc,
+            ..Default::default()
+        };
+        let mut seen = Vec::new();
+        loop {
+            let page = repo.fetch_visibility_blocks_page(id, &query).await.unwrap();
+            assert_eq!(page.matched_count, 7);
+            seen.extend(page.blocks.iter().map(|b| b.priority));
+            match page.next_cursor {
+                Some(cursor) => query.after = Some(cursor),
+                None => break,
+            }
+        }
+        assert_eq!(seen, [6.0, 5.0, 4.0, 3.0, 2.0, 1.0, 0.0]);
+
+        let query = VisibilityBlocksQuery {
+            scheduled: Some(true),
+            search: Some("OB-".to_string()),
+            ..Default::default()
+        };
+        let page = repo.fetch_visibility_blocks_page(id, &query).await.unwrap();
+        assert_eq!(page.matched_count, 4);
+        assert_eq!(page.scheduled_count, 4);
+    }
+
+    #[tokio::test]
+    async fn test_delete_cascades_and_unassigns() {
+        let repo = SqliteRepository::open_in_memory().unwrap();
+        let id = repo
+            .store_schedule(&schedule("a", 2))
+            .await
+            .unwrap()
+            .schedule_id;
+        repo.populate_schedule_analytics(id).await.unwrap();
+        let env = repo.create_environment("La Palma").await.unwrap();
+        repo.assign_schedule(id, env.environment_id).await.unwrap();
+        assert!(repo.create_environment(" la palma ").await.is_err());
+
+        let listed = repo
+            .get_environment(env.environment_id)
+            .await
+            .unwrap()
+            .unwrap();
+        assert_eq!(listed.schedule_ids, [id]);
+        repo.delete_environment(env.environment_id).await.unwrap();
+        assert_eq!(repo.list_schedules().await.unwrap()[0].environment_id, None);
+
+        repo.delete_schedule(id).await.unwrap();
+        assert!(!repo.has_analytics_data(id).await.unwrap());
+        assert!(!repo.has_validation_results(id).await.unwrap());
+        assert!(repo.delete_schedule(id).await.is_err());
+    }
+
+    #[tokio::test]
+    async fn test_file_database_reopens() {
+        let path = std::env::temp_dir().join(format!("tsi-sqlite-{}.sqlite3", std::process::id()));
+        let _ = std::fs::remove_file(&path);
+
+        let id = {
+            let repo = SqliteRepository::open(&path).unwrap();
+            let id = repo
+                .store_schedule(&schedule("a", 4))
+                .await
+                .unwrap()
+                .schedule_id;
+            repo.populate_schedule_analytics(id).await.unwrap();
+            id
+        };
+
+        let repo = SqliteRepository::open(&path).unwrap();
+        assert_eq!(repo.get_blocks_for_schedule(id).await.unwrap().len(), 4);
+        assert_eq!(repo.fetch_compare_blocks(id).await.unwrap().len(), 4);
+
+        drop(repo);
+        for suffix in ["", "-wal", "-shm"] {
+            let _ = std::fs::remove_file(format!("{}{}", path.display(), suffix));
+        }
+    }
+}
@@ -7,8 +7,8 @@
 use async_trait::async_trait;
 
 use super::error::RepositoryResult;
-use crate::api::InsightsBlock;
-use crate::api::{DistributionBlock, LightweightBlock};
+use crate::api::{DistributionBlock, DistributionData, LightweightBlock};
+use crate::api::{InsightsBlock, InsightsData};
 
 /// Repository trait for analytics operations.
 ///
@@ -103,4 +103,52 @@ pub trait AnalyticsRepository: Send + Sync {
         &self,
         schedule_id: crate::api::ScheduleId,
     ) -> RepositoryResult<Vec<InsightsBlock>>;
+
+    // ==================== Aggregate Push-Down ====================
+
+    /// Compute distribution statistics inside the backend.
+    ///
+    /// Covers the blocks with non-zero visibility, like the services'
+    /// row-based path, but returns only aggregates: `blocks` is left empty
+    /// and `impossible_count` at 0 for the caller to fill in. Backends
+    /// that cannot aggregate keep the default, which declines.
+    ///
+    /// # Arguments
+    /// * `schedule_id` - The ID of the schedule
+    /// * `bins` - Histogram bins per column, or `None` for no histograms
+    ///
+    /// # Returns
+    /// * `Ok(Some(DistributionData))` - Aggregated distribution data
+    /// * `Ok(None)` - Not supported; use [`fetch_analytics_blocks_for_distribution`](Self::fetch_analytics_blocks_for_distribution)
+    /// * `Err(RepositoryError)` - If the operation fails
+    async fn fetch_distribution_summary(
+        &self,
+        _schedule_id: crate::api::ScheduleId,
+        _bins: Option<usize>,
+    ) -> RepositoryResult<Option<DistributionData>> {
+        Ok(None)
+    }
+
+    /// Compute insights (metrics, correlations, top observations and
+    /// conflicts) inside the backend.
+    ///
+    /// Covers the blocks with non-zero visibility and leaves `blocks`
+    /// empty. Backends that cannot aggregate keep the default, which
+    /// declines.
+    ///
+    /// # Arguments
+    /// * `schedule_id` - The ID of the schedule
+    /// * `top_n` - Length of the top-priority and top-visibility lists
+    ///
+    /// # Returns
+    /// * `Ok(Some(InsightsData))` - Aggregated insights
+    /// * `Ok(None)` - Not supported; use [`fetch_analytics_blocks_for_insights`](Self::fetch_analytics_blocks_for_insights)
+    /// * `Err(RepositoryError)` - If the operation fails
+    async fn fetch_insights_summary(
+        &self,
+        _schedule_id: crate::api::ScheduleId,
+        _top_n: usize,
+    ) -> RepositoryResult<Option<InsightsData>> {
+        Ok(None)
+    }
 }
@@ -401,3 +401,70 @@ impl From<diesel::r2d2::PoolError> for RepositoryError {
         )
     }
 }
+
+#[cfg(feature = "postgres-async")]
+impl From<tokio_postgres::Error> for RepositoryError {
+    fn from(err: tokio_postgres::Error) -> Self {
+        if err.is_closed() {
+            return RepositoryError::connection_with_context(
+                err.to_string(),
+                ErrorContext::default()
+                    .with_details("connection_closed")
+                    .retryable(),
+            );
+        }
+
+        match err.as_db_error() {
+            Some(db_error) => {
+                let code = db_error.code();
+                let context =
+                    ErrorContext::default().with_details(format!("sqlstate={}", code.code()));
+
+                // Some database errors are retryable (deadlocks, serialization failures)
+                let context = if *code == tokio_postgres::error::SqlState::T_R_SERIALIZATION_FAILURE
+                    || *code == tokio_postgres::error::SqlState::T_R_DEADLOCK_DETECTED
+                {
+                    context.retryable()
+                } else {
+                    context
+                };
+
+                RepositoryError::QueryError {
+                    message: db_error.message().to_string(),
+                    context,
+                }
+            }
+            None => RepositoryError::query(err.to_string()),
+        }
+    }
+}
+
+#[cfg(feature = "sqlite-repo")]
+impl From<rusqlite::Error> for RepositoryError {
+    fn from(err: rusqlite::Error) -> Self {
+        match err {
+            rusqlite::Error::QueryReturnedNoRows => RepositoryError::not_found("Record not found"),
+            rusqlite::Error::SqliteFailure(failure, message) => {
+                let message = message.unwrap_or_else(|| failure.to_string());
+                let context = ErrorContext::default()
+                    .with_details(format!("sqlite_error={:?}", failure.code));
+
+                // Another connection holding the write lock past busy_timeout
+                let context = if matches!(
+                    failure.code,
+                    rusqlite::ErrorCode::DatabaseBusy | rusqlite::ErrorCode::DatabaseLocked
+                ) {
+                    context.retryable()
+                } else {
+                    context
+                };
+
+                RepositoryError::QueryError { message, context }
+            }
+            rusqlite::Error::FromSqlConversionFailure(_, _, e) => {
+                RepositoryError::internal(format!("Deserialization error: {}", e))
+            }
+            other => RepositoryError::query(other.to_string()),
+        }
+    }
+}
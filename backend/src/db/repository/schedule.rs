@@ -4,6 +4,7 @@
 //! scheduling blocks, dark periods, and possible periods.
 
 use async_trait::async_trait;
+use std::sync::Arc;
 
 use super::error::{RepositoryError, RepositoryResult};
 use crate::api::*;
@@ -54,6 +55,26 @@ pub trait ScheduleRepository: Send + Sync {
     async fn get_schedule(&self, schedule_id: crate::api::ScheduleId)
         -> RepositoryResult<Schedule>;
 
+    /// Retrieve a complete schedule for read-only use.
+    ///
+    /// The default wraps [`get_schedule`](Self::get_schedule); repositories
+    /// that keep schedules in memory return their stored copy, so the read
+    /// is a pointer copy.
+    ///
+    /// # Arguments
+    /// * `schedule_id` - The ID of the schedule to retrieve
+    ///
+    /// # Returns
+    /// * `Ok(Arc<Schedule>)` - The complete schedule, shared
+    /// * `Err(RepositoryError::NotFound)` - If the schedule doesn't exist
+    /// * `Err(RepositoryError)` - If the operation fails
+    async fn get_schedule_shared(
+        &self,
+        schedule_id: crate::api::ScheduleId,
+    ) -> RepositoryResult<Arc<Schedule>> {
+        self.get_schedule(schedule_id).await.map(Arc::new)
+    }
+
     /// List all schedules with basic metadata.
     ///
     /// # Returns
@@ -128,6 +149,27 @@ pub trait ScheduleRepository: Send + Sync {
         schedule_id: crate::api::ScheduleId,
     ) -> RepositoryResult<Vec<SchedulingBlock>>;
 
+    /// Get the columnar view of a schedule used by the analytics services.
+    ///
+    /// The default builds it from [`get_schedule`](Self::get_schedule);
+    /// implementations should build it straight from storage instead of
+    /// materialising the blocks.
+    ///
+    /// # Arguments
+    /// * `schedule_id` - The ID of the schedule
+    ///
+    /// # Returns
+    /// * `Ok(ScheduleColumns)` - The schedule's blocks, column by column
+    /// * `Err(RepositoryError::NotFound)` - If the schedule doesn't exist
+    /// * `Err(RepositoryError)` - If the operation fails
+    async fn get_schedule_columns(
+        &self,
+        schedule_id: crate::api::ScheduleId,
+    ) -> RepositoryResult<crate::models::ScheduleColumns> {
+        let schedule = self.get_schedule(schedule_id).await?;
+        Ok(crate::models::ScheduleColumns::from_schedule(&schedule))
+    }
+
     // ==================== Dark Periods & Possible Periods ====================
 
     /// Fetch dark periods (observing windows) for a schedule.
@@ -213,4 +255,25 @@ pub trait ScheduleRepository: Send + Sync {
         new_name: Option<String>,
         new_location: Option<crate::api::GeographicLocation>,
     ) -> RepositoryResult<crate::api::ScheduleInfo>;
+
+    /// Opaque version of everything the schedule's read endpoints derive
+    /// from it: analytics, validation results, algorithm trace, metadata
+    /// and environment assignment.
+    ///
+    /// Every write to any of these changes the version, and versions are
+    /// never shared between schedules or between repository instances that
+    /// could hand out the same id, so they can back HTTP validators served
+    /// by several processes.
+    ///
+    /// # Arguments
+    /// * `schedule_id` - The ID of the schedule
+    ///
+    /// # Returns
+    /// * `Ok(Some(version))` - The current version
+    /// * `Ok(None)` - If the schedule doesn't exist
+    /// * `Err(RepositoryError)` - If the operation fails
+    async fn schedule_version(
+        &self,
+        schedule_id: crate::api::ScheduleId,
+    ) -> RepositoryResult<Option<String>>;
 }
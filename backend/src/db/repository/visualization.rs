@@ -49,6 +49,17 @@ pub trait VisualizationRepository: Send + Sync {
         schedule_id: crate::api::ScheduleId,
     ) -> RepositoryResult<crate::api::VisibilityMapData>;
 
+    /// Fetch one sorted, filtered page of visibility-map block summaries.
+    ///
+    /// Pages are keyset-paginated on `(sort key, scheduling_block_id)` via
+    /// `query.after`; without a cursor, `query.offset` rows are skipped so a
+    /// client can jump to an arbitrary scroll position.
+    async fn fetch_visibility_blocks_page(
+        &self,
+        schedule_id: crate::api::ScheduleId,
+        query: &crate::api::VisibilityBlocksQuery,
+    ) -> RepositoryResult<crate::api::VisibilityBlocksPage>;
+
     async fn fetch_blocks_for_histogram(
         &self,
         schedule_id: crate::api::ScheduleId,
@@ -192,6 +192,23 @@ pub async fn get_schedule<R: FullRepository + ?Sized>(
     repo.get_schedule(schedule_id).await
 }
 
+/// Retrieve a complete schedule by ID for read-only use, without copying it
+/// when the repository keeps it in memory.
+///
+/// # Arguments
+/// * `repo` - Repository implementation
+/// * `schedule_id` - The ID of the schedule to retrieve
+///
+/// # Returns
+/// * `Ok(Arc<Schedule>)` - The complete schedule, shared
+/// * `Err` if schedule not found or retrieval fails
+pub async fn get_schedule_shared<R: FullRepository + ?Sized>(
+    repo: &R,
+    schedule_id: crate::api::ScheduleId,
+) -> RepositoryResult<std::sync::Arc<Schedule>> {
+    repo.get_schedule_shared(schedule_id).await
+}
+
 /// List all schedules with basic metadata.
 ///
 /// # Arguments
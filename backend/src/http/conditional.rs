@@ -0,0 +1,256 @@
+//! Conditional GET middleware for schedule analytics.
+//!
+//! Analytics responses are tagged with the stored version of the
+//! schedule(s) they were built from (see
+//! [`ScheduleRepository::schedule_version`](crate::db::repository::ScheduleRepository::schedule_version)),
+//! which every write to a schedule's analytics, validation results, trace,
+//! metadata or environment advances. Because the version lives in the
+//! repository, every server process sharing it agrees on the tag. A request
+//! whose `If-None-Match` already carries the current tag is answered with
+//! `304 Not Modified` before the handler runs, so clients that persist
+//! responses revalidate without the server recomputing or re-sending the
+//! payload. Tags also carry the response format, so a deploy that changes a
+//! payload's shape retires what clients stored before it.
+
+use std::collections::HashMap;
+
+use axum::{
+    extract::{Path, Request, State},
+    http::{
+        header::{CACHE_CONTROL, ETAG, IF_NONE_MATCH},
+        HeaderMap, HeaderValue, Method, StatusCode,
+    },
+    middleware::Next,
+    response::{IntoResponse, Response},
+};
+
+use super::state::AppState;
+use crate::api::ScheduleId;
+
+/// Cached copies may be kept but must be revalidated before use.
+const CACHE_CONTROL_VALUE: &str = "private, no-cache";
+
+/// Version of the analytics payload shapes. Bump it with any change to the
+/// JSON an ETag-validated endpoint returns, so clients holding the old shape
+/// get a full response instead of a 304.
+const RESPONSE_FORMAT: u32 = 1;
+
+/// Path parameters naming the schedules a response is built from.
+const SCHEDULE_PARAMS: [&str; 2] = ["schedule_id", "other_id"];
+
+/// Middleware adding `ETag` validators to schedule analytics responses.
+/// Installed with `route_layer` on GET routes whose payload depends only
+/// on the schedules named in the path.
+pub async fn schedule_etag(
+    State(state): State<AppState>,
+    Path(params): Path<HashMap<String, String>>,
+    request: Request,
+    next: Next,
+) -> Response {
+    let schedule_ids: Vec<ScheduleId> = SCHEDULE_PARAMS
+        .iter()
+        .filter_map(|name| params.get(*name)?.parse::<i64>().ok())
+        .map(ScheduleId::new)
+        .collect();
+    if request.method() != Method::GET || schedule_ids.is_empty() {
+        return next.run(request).await;
+    }
+
+    // Taken before the handler runs: a write racing with it (including
+    // analytics the handler itself populates) leaves the response under the
+    // older tag, which only costs one extra refetch.
+    let Some(etag) = current_etag(&state, &schedule_ids).await else {
+        return next.run(request).await;
+    };
+    let Ok(etag_value) = HeaderValue::from_str(&etag) else {
+        return next.run(request).await;
+    };
+
+    if if_none_match(request.headers(), &etag) {
+        return (
+            StatusCode::NOT_MODIFIED,
+            [
+                (ETAG, etag_value),
+                (CACHE_CONTROL, HeaderValue::from_static(CACHE_CONTROL_VALUE)),
+            ],
+        )
+            .into_response();
+    }
+
+    let mut response = next.run(request).await;
+    if response.status().is_success() {
+        let headers = response.headers_mut();
+        headers.insert(ETAG, etag_value);
+        headers.insert(CACHE_CONTROL, HeaderValue::from_static(CACHE_CONTROL_VALUE));
+    }
+    response
+}
+
+/// Weak entity tag over the response format, the server version and the
+/// stored versions of `schedule_ids`, or `None`
+/// when a schedule does not exist or its version cannot be read; such
+/// responses are served without a validator.
+async fn current_etag(state: &AppState, schedule_ids: &[ScheduleId]) -> Option<String> {
+    let mut tag = format!("W/\"f{}+{}:", RESPONSE_FORMAT, env!("CARGO_PKG_VERSION"));
+    for (i, id) in schedule_ids.iter().enumerate() {
+        let version = match state.repository.schedule_version(*id).await {
+            Ok(version) => version?,
+            Err(e) => {
+                log::warn!("Failed to read version of schedule {}: {}", id, e);
+                return None;
+            }
+        };
+        if i > 0 {
+            tag.push('-');
+        }
+        tag.push_str(&format!("{}.{}", id.value(), version));
+    }
+    tag.push('"');
+    Some(tag)
+}
+
+/// Weak comparison of `etag` against every tag listed in `If-None-Match`.
+fn if_none_match(headers: &HeaderMap, etag: &str) -> bool {
+    let wanted = opaque_tag(etag);
+    headers
+        .get_all(IF_NONE_MATCH)
+        .iter()
+        .filter_map(|value| value.to_str().ok())
+        .flat_map(|value| value.split(','))
+        .map(str::trim)
+        .any(|tag| tag == "*" || opaque_tag(tag) == wanted)
+}
+
+fn opaque_tag(tag: &str) -> &str {
+    tag.strip_prefix("W/").unwrap_or(tag)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::db::repositories::LocalRepository;
+    use crate::db::repository::{AnalyticsRepository, EnvironmentRepository};
+    use crate::models::synthetic::{generate_schedule, SyntheticScheduleConfig};
+    use axum::{body::Body, middleware, routing::get, Router};
+    use std::sync::Arc;
+    use tower::util::ServiceExt;
+
+    fn app(state: AppState) -> Router {
+        Router::new()
+            .route("/schedules/{schedule_id}/data", get(|| async { "data" }))
+            .route(
+                "/schedules/{schedule_id}/compare/{other_id}",
+                get(|| async { "compare" }),
+            )
+            .route(
+                "/schedules/{schedule_id}/missing",
+                get(|| async { StatusCode::NOT_FOUND }),
+            )
+            .route_layer(middleware::from_fn_with_state(state.clone(), schedule_etag))
+            .with_state(state)
+    }
+
+    /// A repository holding `count` small schedules, with ids 1..=count.
+    fn repo_with_schedules(count: u64) -> Arc<LocalRepository> {
+        let repo = Arc::new(LocalRepository::new());
+        for seed in 0..count {
+            repo.store_schedule_impl(generate_schedule(&SyntheticScheduleConfig {
+                blocks: 4,
+                seed,
+                ..Default::default()
+            }));
+        }
+        repo
+    }
+
+    async fn get_with(app: &Router, uri: &str, if_none_match: Option<&str>) -> Response {
+        let mut request = Request::builder().uri(uri);
+        if let Some(tag) = if_none_match {
+            request = request.header(IF_NONE_MATCH, tag);
+        }
+        app.clone()
+            .oneshot(request.body(Body::empty()).unwrap())
+            .await
+            .unwrap()
+    }
+
+    fn etag_of(response: &Response) -> String {
+        response.headers()[ETAG].to_str().unwrap().to_owned()
+    }
+
+    #[tokio::test]
+    async fn matching_tag_is_not_modified_until_the_schedule_changes() {
+        let repo = repo_with_schedules(2);
+        let app = app(AppState::new(repo.clone()));
+
+        let first = get_with(&app, "/schedules/1/data", None).await;
+        assert_eq!(first.status(), StatusCode::OK);
+        assert_eq!(first.headers()[CACHE_CONTROL], CACHE_CONTROL_VALUE);
+        let tag = etag_of(&first);
+
+        let revalidated = get_with(&app, "/schedules/1/data", Some(&tag)).await;
+        assert_eq!(revalidated.status(), StatusCode::NOT_MODIFIED);
+        assert_eq!(etag_of(&revalidated), tag);
+
+        // Populating analytics changes what the endpoints return; other
+        // schedules are unaffected.
+        let other_tag = etag_of(&get_with(&app, "/schedules/2/data", None).await);
+        repo.populate_schedule_analytics(ScheduleId::new(1))
+            .await
+            .unwrap();
+
+        let stale = get_with(&app, "/schedules/1/data", Some(&tag)).await;
+        assert_eq!(stale.status(), StatusCode::OK);
+        assert_ne!(etag_of(&stale), tag);
+        let other = get_with(&app, "/schedules/2/data", Some(&other_tag)).await;
+        assert_eq!(other.status(), StatusCode::NOT_MODIFIED);
+    }
+
+    #[tokio::test]
+    async fn compare_tag_covers_both_schedules() {
+        let repo = repo_with_schedules(2);
+        let app = app(AppState::new(repo.clone()));
+
+        let tag = etag_of(&get_with(&app, "/schedules/1/compare/2", None).await);
+        repo.unassign_schedule(ScheduleId::new(2)).await.unwrap();
+        let response = get_with(&app, "/schedules/1/compare/2", Some(&tag)).await;
+        assert_eq!(response.status(), StatusCode::OK);
+    }
+
+    #[tokio::test]
+    async fn tag_lists_and_errors() {
+        let app = app(AppState::new(repo_with_schedules(1)));
+
+        let tag = etag_of(&get_with(&app, "/schedules/1/data", None).await);
+        let listed = format!("\"other\", {}", tag.trim_start_matches("W/"));
+        let response = get_with(&app, "/schedules/1/data", Some(&listed)).await;
+        assert_eq!(response.status(), StatusCode::NOT_MODIFIED);
+
+        let missing = get_with(&app, "/schedules/1/missing", None).await;
+        assert_eq!(missing.status(), StatusCode::NOT_FOUND);
+        assert!(missing.headers().get(ETAG).is_none());
+
+        // Unknown schedules are passed through without a validator.
+        let unknown = get_with(&app, "/schedules/9/data", None).await;
+        assert_eq!(unknown.status(), StatusCode::OK);
+        assert!(unknown.headers().get(ETAG).is_none());
+    }
+
+    #[tokio::test]
+    async fn tag_names_the_response_format() {
+        let app = app(AppState::new(repo_with_schedules(1)));
+        let tag = etag_of(&get_with(&app, "/schedules/1/data", None).await);
+        let prefix = format!("W/\"f{}+{}:1.", RESPONSE_FORMAT, env!("CARGO_PKG_VERSION"));
+        assert!(tag.starts_with(&prefix), "{tag}");
+    }
+
+    #[tokio::test]
+    async fn tags_differ_between_repository_instances() {
+        let first = app(AppState::new(repo_with_schedules(1)));
+        let second = app(AppState::new(repo_with_schedules(1)));
+        assert_ne!(
+            etag_of(&get_with(&first, "/schedules/1/data", None).await),
+            etag_of(&get_with(&second, "/schedules/1/data", None).await)
+        );
+    }
+}
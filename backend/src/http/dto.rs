@@ -138,6 +138,48 @@ pub struct ListSchedulesParams {
     pub offset: Option<u32>,
 }
 
+/// Query parameters for distributions endpoint.
+#[derive(Debug, Clone, Serialize, Deserialize, Default)]
+pub struct DistributionsQuery {
+    /// Histogram bins per charted column (max 200); no histograms when absent
+    #[serde(default)]
+    pub bins: Option<usize>,
+    /// Include per-block rows (default: true)
+    #[serde(default)]
+    pub blocks: Option<bool>,
+}
+
+/// Query parameters for insights endpoint.
+#[derive(Debug, Clone, Serialize, Deserialize, Default)]
+pub struct InsightsQuery {
+    /// Include per-block rows (default: true)
+    #[serde(default)]
+    pub blocks: Option<bool>,
+}
+
+/// Query parameters for the schedule dashboard endpoint.
+///
+/// Each parameter has the meaning and default of the same parameter on the
+/// section's own endpoint.
+#[derive(Debug, Clone, Serialize, Deserialize, Default)]
+pub struct DashboardQuery {
+    /// Sky-map HEALPix `nside`
+    #[serde(default)]
+    pub resolution: Option<u32>,
+    /// Distribution histogram bins
+    #[serde(default)]
+    pub bins: Option<usize>,
+    /// Trends empirical-rate bins
+    #[serde(default)]
+    pub trend_bins: Option<usize>,
+    /// Trends kernel bandwidth
+    #[serde(default)]
+    pub bandwidth: Option<f64>,
+    /// Trends smoothed-curve points
+    #[serde(default)]
+    pub points: Option<usize>,
+}
+
 /// Query parameters for trends endpoint.
 #[derive(Debug, Clone, Serialize, Deserialize, Default)]
 pub struct TrendsQuery {
@@ -174,6 +216,55 @@ pub struct CompareQuery {
     pub merge_epsilon_minutes: Option<f64>,
 }
 
+/// Query parameters for sky map endpoint.
+///
+/// `resolution` (HEALPix `nside`) switches to the aggregated view; the
+/// `ra_*`/`dec_*` bounds restrict which targets are returned individually.
+/// Missing viewport bounds default to the full sky.
+#[derive(Debug, Clone, Serialize, Deserialize, Default)]
+pub struct SkyMapQuery {
+    #[serde(default)]
+    pub resolution: Option<u32>,
+    /// Lower RA bound in degrees; greater than `ra_max` wraps through 0°.
+    #[serde(default)]
+    pub ra_min: Option<f64>,
+    #[serde(default)]
+    pub ra_max: Option<f64>,
+    #[serde(default)]
+    pub dec_min: Option<f64>,
+    #[serde(default)]
+    pub dec_max: Option<f64>,
+}
+
+/// Query parameters for the paginated visibility-map block table.
+///
+/// `after_key`/`after_id` resume after the last row of the previous page;
+/// without them `offset` rows are skipped instead.
+#[derive(Debug, Clone, Serialize, Deserialize, Default)]
+pub struct VisibilityBlocksParams {
+    #[serde(default)]
+    pub sort: Option<crate::api::VisibilityBlockSort>,
+    #[serde(default)]
+    pub direction: Option<crate::api::SortDirection>,
+    #[serde(default)]
+    pub priority_min: Option<f64>,
+    #[serde(default)]
+    pub priority_max: Option<f64>,
+    #[serde(default)]
+    pub scheduled: Option<bool>,
+    #[serde(default)]
+    pub search: Option<String>,
+    #[serde(default)]
+    pub after_key: Option<f64>,
+    #[serde(default)]
+    pub after_id: Option<i64>,
+    #[serde(default)]
+    pub offset: Option<usize>,
+    /// Page size (default 200, max 1000).
+    #[serde(default)]
+    pub limit: Option<usize>,
+}
+
 /// Query parameters for visibility histogram endpoint.
 #[derive(Debug, Clone, Serialize, Deserialize, Default)]
 pub struct VisibilityHistogramQuery {
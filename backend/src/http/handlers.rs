@@ -17,15 +17,17 @@ use std::time::Duration;
 
 use super::dto::{
     BulkDeleteSchedulesRequest, BulkDeleteSchedulesResponse, CompareQuery, CreateScheduleRequest,
-    CreateScheduleResponse, DeleteScheduleResponse, HealthResponse, JobStatusResponse,
-    ListSchedulesParams, ScheduleInfoDto, ScheduleListResponse, TrendsQuery, UpdateScheduleRequest,
-    VisibilityBin, VisibilityHistogramQuery,
+    CreateScheduleResponse, DashboardQuery, DeleteScheduleResponse, DistributionsQuery,
+    HealthResponse, InsightsQuery, JobStatusResponse, ListSchedulesParams, ScheduleInfoDto,
+    ScheduleListResponse, SkyMapQuery, TrendsQuery, UpdateScheduleRequest, VisibilityBin,
+    VisibilityBlocksParams, VisibilityHistogramQuery,
 };
 use super::error::AppError;
 use super::state::AppState;
-use crate::api::{AltAzData, AltAzRequest, ScheduleId, SchedulingBlock};
+use crate::api::{AltAzData, AltAzRequest, ScheduleId};
 use crate::db::services as db_services;
 use crate::http::extensions::BackendExtensions;
+use crate::models::ScheduleColumns;
 use crate::services::schedule_processor::TraceValidatorFn;
 
 /// Build a [`TraceValidatorFn`] from the registered backend extensions,
@@ -158,28 +160,30 @@ impl From<&crate::api::Schedule> for NativeScheduleExport {
 }
 
 fn block_matches_visibility_histogram_query(
-    block: &SchedulingBlock,
+    columns: &ScheduleColumns,
+    row: usize,
     query: &VisibilityHistogramQuery,
 ) -> bool {
+    let priority = columns.priorities[row];
     if let Some(min_p) = query.priority_min {
-        if block.priority < min_p {
+        if priority < min_p {
             return false;
         }
     }
     if let Some(max_p) = query.priority_max {
-        if block.priority > max_p {
+        if priority > max_p {
             return false;
         }
     }
     if let Some(ref ids) = query.block_ids {
-        if let Some(id) = block.id {
+        if let Some(id) = columns.block_ids[row] {
             if !ids.contains(&id.value()) {
                 return false;
             }
         }
     }
     if let Some(scheduled) = query.scheduled {
-        if block.scheduled_period.is_some() != scheduled {
+        if columns.scheduled_periods[row].is_some() != scheduled {
             return false;
         }
     }
@@ -208,6 +212,21 @@ pub async fn health_check(State(state): State<AppState>) -> HandlerResult<Health
     }))
 }
 
+/// GET /metrics
+///
+/// Prometheus text exposition of per-route request counts, latency and
+/// response-size histograms, in-flight gauges, repository timings and
+/// blocking/rayon pool load.
+pub async fn get_metrics() -> impl axum::response::IntoResponse {
+    (
+        [(
+            axum::http::header::CONTENT_TYPE,
+            "text/plain; version=0.0.4; charset=utf-8",
+        )],
+        crate::metrics::global().render_prometheus(),
+    )
+}
+
 /// GET /v1/_health/db
 ///
 /// Diagnostics endpoint that surfaces the bulk-import latency ring buffer
@@ -306,11 +325,11 @@ pub async fn get_schedule(
     Path(schedule_id): Path<i64>,
 ) -> HandlerResult<serde_json::Value> {
     let schedule_id = ScheduleId::new(schedule_id);
-    let schedule = db_services::get_schedule(state.repository.as_ref(), schedule_id).await?;
+    let schedule = db_services::get_schedule_shared(state.repository.as_ref(), schedule_id).await?;
 
     // Always export canonical native TSI schedule JSON, independent of the
     // adapter used at import time.
-    let export = NativeScheduleExport::from(&schedule);
+    let export = NativeScheduleExport::from(schedule.as_ref());
 
     let export_json = serde_json::to_string(&export).map_err(|e| {
         AppError::Internal(format!(
@@ -436,6 +455,7 @@ pub async fn delete_schedule(
 ) -> HandlerResult<DeleteScheduleResponse> {
     let schedule_id = ScheduleId::new(schedule_id);
     db_services::delete_schedule(state.repository.as_ref(), schedule_id).await?;
+    state.timeline_cache.invalidate(schedule_id);
 
     Ok(Json(DeleteScheduleResponse {
         message: format!("Schedule {} deleted successfully", schedule_id),
@@ -457,6 +477,9 @@ pub async fn bulk_delete_schedules(
         .map(ScheduleId::new)
         .collect();
     let deleted_count = db_services::bulk_delete_schedules(state.repository.as_ref(), &ids).await?;
+    for id in &ids {
+        state.timeline_cache.invalidate(*id);
+    }
     Ok(Json(BulkDeleteSchedulesResponse {
         deleted_count,
         message: format!(
@@ -519,29 +542,81 @@ pub async fn update_schedule(
 
 /// GET /v1/schedules/{schedule_id}/sky-map
 ///
-/// Get sky map visualization data for a schedule.
+/// Get sky map visualization data for a schedule.  With `resolution` the
+/// targets come back aggregated into HEALPix cells, and individually only
+/// inside the requested RA/Dec viewport.
 pub async fn get_sky_map(
     State(state): State<AppState>,
     Path(schedule_id): Path<i64>,
+    Query(query): Query<SkyMapQuery>,
 ) -> HandlerResult<crate::api::SkyMapData> {
     let schedule_id = ScheduleId::new(schedule_id);
-    let data = crate::services::sky_map::get_sky_map_data(state.repository.as_ref(), schedule_id)
-        .await
-        .map_err(AppError::Internal)?;
+    let detail = sky_map_detail(&query)?;
+    let data =
+        crate::services::sky_map::get_sky_map_data(state.repository.as_ref(), schedule_id, &detail)
+            .await
+            .map_err(AppError::Internal)?;
     Ok(Json(data))
 }
 
+fn sky_map_detail(query: &SkyMapQuery) -> Result<crate::services::sky_map::SkyMapDetail, AppError> {
+    use crate::services::sky_map::{SkyMapDetail, SkyViewport, MAX_SKY_MAP_RESOLUTION};
+
+    if let Some(resolution) = query.resolution {
+        if resolution == 0 || resolution > MAX_SKY_MAP_RESOLUTION {
+            return Err(AppError::BadRequest(format!(
+                "resolution must be between 1 and {}",
+                MAX_SKY_MAP_RESOLUTION
+            )));
+        }
+    }
+
+    let bounds = [query.ra_min, query.ra_max, query.dec_min, query.dec_max];
+    let viewport = if bounds.iter().all(Option::is_none) {
+        None
+    } else {
+        let viewport = SkyViewport {
+            ra_min: query.ra_min.unwrap_or(0.0),
+            ra_max: query.ra_max.unwrap_or(360.0),
+            dec_min: query.dec_min.unwrap_or(-90.0),
+            dec_max: query.dec_max.unwrap_or(90.0),
+        };
+        let ra_ok = |ra: f64| (0.0..=360.0).contains(&ra);
+        let dec_ok = |dec: f64| (-90.0..=90.0).contains(&dec);
+        if !ra_ok(viewport.ra_min)
+            || !ra_ok(viewport.ra_max)
+            || !dec_ok(viewport.dec_min)
+            || !dec_ok(viewport.dec_max)
+            || viewport.dec_min > viewport.dec_max
+        {
+            return Err(AppError::BadRequest(
+                "viewport needs 0 <= ra <= 360 and -90 <= dec_min <= dec_max <= 90".to_string(),
+            ));
+        }
+        Some(viewport)
+    };
+
+    Ok(SkyMapDetail {
+        resolution: query.resolution,
+        viewport,
+    })
+}
+
 /// GET /v1/schedules/{schedule_id}/distributions
 ///
-/// Get distribution analysis data for a schedule.
+/// Get distribution analysis data for a schedule. `?bins=N` adds
+/// histograms; `?blocks=false` returns aggregates only.
 pub async fn get_distributions(
     State(state): State<AppState>,
     Path(schedule_id): Path<i64>,
+    Query(query): Query<DistributionsQuery>,
 ) -> HandlerResult<crate::api::DistributionData> {
     let schedule_id = ScheduleId::new(schedule_id);
     let data = crate::services::distributions::get_distribution_data(
         state.repository.as_ref(),
         schedule_id,
+        query.bins,
+        query.blocks.unwrap_or(true),
     )
     .await
     .map_err(AppError::Internal)?;
@@ -565,6 +640,56 @@ pub async fn get_visibility_map(
     Ok(Json(data))
 }
 
+/// GET /v1/schedules/{schedule_id}/visibility-map/blocks
+///
+/// One sorted, filtered page of visibility-map blocks.
+pub async fn get_visibility_blocks(
+    State(state): State<AppState>,
+    Path(schedule_id): Path<i64>,
+    Query(params): Query<VisibilityBlocksParams>,
+) -> HandlerResult<crate::api::VisibilityBlocksPage> {
+    use crate::services::visibility_blocks::MAX_VISIBILITY_PAGE_SIZE;
+
+    let schedule_id = ScheduleId::new(schedule_id);
+
+    let limit = params.limit.unwrap_or(200);
+    if limit == 0 || limit > MAX_VISIBILITY_PAGE_SIZE {
+        return Err(AppError::BadRequest(format!(
+            "limit must be between 1 and {}",
+            MAX_VISIBILITY_PAGE_SIZE
+        )));
+    }
+    let after = match (params.after_key, params.after_id) {
+        (Some(key), Some(id)) if key.is_finite() => {
+            Some(crate::api::VisibilityBlockCursor { key, id })
+        }
+        (None, None) => None,
+        _ => {
+            return Err(AppError::BadRequest(
+                "after_key and after_id must be given together".to_string(),
+            ))
+        }
+    };
+
+    let query = crate::api::VisibilityBlocksQuery {
+        sort: params.sort.unwrap_or_default(),
+        direction: params.direction.unwrap_or_default(),
+        priority_min: params.priority_min,
+        priority_max: params.priority_max,
+        scheduled: params.scheduled,
+        search: params.search,
+        after,
+        offset: params.offset.unwrap_or(0),
+        limit,
+    };
+    let page = state
+        .repository
+        .fetch_visibility_blocks_page(schedule_id, &query)
+        .await?;
+
+    Ok(Json(page))
+}
+
 /// GET /v1/schedules/{schedule_id}/visibility-histogram
 ///
 /// Get visibility histogram data for a schedule with optional filters.
@@ -573,8 +698,7 @@ pub async fn get_visibility_histogram(
     Path(schedule_id): Path<i64>,
     Query(query): Query<VisibilityHistogramQuery>,
 ) -> HandlerResult<Vec<VisibilityBin>> {
-    use crate::db::models::BlockHistogramData;
-    use crate::services::visibility::compute_visibility_histogram_rust;
+    use crate::services::visibility::compute_visibility_histogram_columns;
 
     let schedule_id = ScheduleId::new(schedule_id);
 
@@ -601,27 +725,16 @@ pub async fn get_visibility_histogram(
         std::cmp::max(1, time_range_seconds / num_bins as i64)
     };
 
-    // Fetch blocks with visibility data
-    let blocks = state
-        .repository
-        .get_blocks_for_schedule(schedule_id)
-        .await?;
-
-    // Convert to histogram data format and apply filters
-    let histogram_blocks: Vec<BlockHistogramData> = blocks
-        .into_iter()
-        .filter(|b| block_matches_visibility_histogram_query(b, &query))
-        .map(|b| BlockHistogramData {
-            scheduling_block_id: b.id.map(|id| id.value()).unwrap_or(0),
-            priority: b.priority,
-            visibility_periods: Some(b.visibility_periods),
-        })
-        .collect();
+    // Read the filtered rows' visibility straight from the columns.
+    let columns = state.repository.get_schedule_columns(schedule_id).await?;
 
     // Compute histogram using the service
-    let bins = tokio::task::spawn_blocking(move || {
-        compute_visibility_histogram_rust(
-            histogram_blocks.into_iter(),
+    let bins = crate::metrics::spawn_blocking(move || {
+        let rows = (0..columns.len())
+            .filter(|&row| block_matches_visibility_histogram_query(&columns, row, &query));
+        compute_visibility_histogram_columns(
+            &columns,
+            rows,
             start_unix,
             end_unix,
             bin_duration_seconds,
@@ -639,6 +752,7 @@ pub async fn get_visibility_histogram(
 /// POST /v1/schedules/{schedule_id}/alt-az
 ///
 /// Compute altitude and azimuth curves for selected targets over a custom time window.
+/// The sampling is CPU-bound (targets × samples), so it runs on the blocking pool.
 pub async fn compute_alt_az(
     State(state): State<AppState>,
     Path(schedule_id): Path<i64>,
@@ -646,29 +760,76 @@ pub async fn compute_alt_az(
 ) -> HandlerResult<AltAzData> {
     let schedule_id = ScheduleId::new(schedule_id);
 
-    let _schedule = db_services::get_schedule(state.repository.as_ref(), schedule_id).await?;
+    let _schedule =
+        db_services::get_schedule_shared(state.repository.as_ref(), schedule_id).await?;
 
-    let data =
-        crate::services::compute_alt_az_data(schedule_id, &request).map_err(AppError::Internal)?;
+    let data = crate::metrics::spawn_blocking(move || {
+        crate::services::compute_alt_az_data(schedule_id, &request)
+    })
+    .await
+    .map_err(|e| AppError::Internal(format!("Task join error: {}", e)))?
+    .map_err(AppError::Internal)?;
 
     Ok(Json(data))
 }
 
 /// GET /v1/schedules/{schedule_id}/timeline
 ///
-/// Get timeline visualization data for a schedule.
+/// Get timeline visualization data for a schedule, including the
+/// render-ready month-row layout. Analytics are populated first if the
+/// schedule was stored without them. Non-empty serialized payloads are
+/// cached per schedule version, so repeat views skip both computation and
+/// serialization.
 pub async fn get_timeline(
     State(state): State<AppState>,
     Path(schedule_id): Path<i64>,
-) -> HandlerResult<crate::api::ScheduleTimelineData> {
+) -> Result<axum::response::Response, AppError> {
+    use axum::response::IntoResponse;
+
     let schedule_id = ScheduleId::new(schedule_id);
-    let data = crate::services::timeline::get_schedule_timeline_data(
-        state.repository.as_ref(),
-        schedule_id,
+    // Read on every request: a schedule deleted or changed elsewhere must
+    // not be served from this process's cache.
+    let version = timeline_version(&state, schedule_id).await?;
+    let body = match state.timeline_cache.get(schedule_id, &version) {
+        Some(body) => body,
+        None => {
+            // Populating analytics advances the version; key the payload by
+            // the version it is built from.
+            db_services::ensure_analytics(state.repository.as_ref(), schedule_id).await?;
+            let version = timeline_version(&state, schedule_id).await?;
+            let data = crate::services::timeline::get_schedule_timeline_data(
+                state.repository.as_ref(),
+                schedule_id,
+            )
+            .await
+            .map_err(AppError::Internal)?;
+            let body = axum::body::Bytes::from(
+                serde_json::to_vec(&data).map_err(|e| AppError::Internal(e.to_string()))?,
+            );
+            // Empty timelines are cheap to recompute, and caching one would
+            // pin it if the blocks only become visible later.
+            if data.total_count > 0 {
+                state
+                    .timeline_cache
+                    .insert(schedule_id, version, body.clone());
+            }
+            body
+        }
+    };
+    Ok((
+        [(axum::http::header::CONTENT_TYPE, "application/json")],
+        body,
     )
-    .await
-    .map_err(AppError::Internal)?;
-    Ok(Json(data))
+        .into_response())
+}
+
+/// Stored version keying a schedule's cached timeline.
+async fn timeline_version(state: &AppState, schedule_id: ScheduleId) -> Result<String, AppError> {
+    state
+        .repository
+        .schedule_version(schedule_id)
+        .await?
+        .ok_or_else(|| AppError::NotFound(format!("Schedule {} not found", schedule_id)))
 }
 
 /// GET /v1/schedules/{schedule_id}/algorithm_trace
@@ -694,15 +855,21 @@ pub async fn get_algorithm_trace(
 
 /// GET /v1/schedules/{schedule_id}/insights
 ///
-/// Get insights analysis data for a schedule.
+/// Get insights analysis data for a schedule. `?blocks=false` returns
+/// aggregates only.
 pub async fn get_insights(
     State(state): State<AppState>,
     Path(schedule_id): Path<i64>,
+    Query(query): Query<InsightsQuery>,
 ) -> HandlerResult<crate::api::InsightsData> {
     let schedule_id = ScheduleId::new(schedule_id);
-    let data = crate::services::insights::get_insights_data(state.repository.as_ref(), schedule_id)
-        .await
-        .map_err(AppError::Internal)?;
+    let data = crate::services::insights::get_insights_data(
+        state.repository.as_ref(),
+        schedule_id,
+        query.blocks.unwrap_or(true),
+    )
+    .await
+    .map_err(AppError::Internal)?;
     Ok(Json(data))
 }
 
@@ -740,6 +907,37 @@ pub async fn get_schedule_kpis(
     Ok(Json(kpi))
 }
 
+/// GET /v1/schedules/{schedule_id}/dashboard
+///
+/// Sky map, distributions, insights, trends, fragmentation and KPIs of a
+/// schedule in one response, computed from a single load of its analytics
+/// rows, with per-section timings.
+pub async fn get_schedule_dashboard(
+    State(state): State<AppState>,
+    Path(schedule_id): Path<i64>,
+    Query(query): Query<DashboardQuery>,
+) -> HandlerResult<crate::services::dashboard::ScheduleDashboard> {
+    use crate::services::dashboard::{get_dashboard_data, DashboardOptions};
+
+    let schedule_id = ScheduleId::new(schedule_id);
+    let defaults = DashboardOptions::default();
+    let options = DashboardOptions {
+        sky_map: sky_map_detail(&SkyMapQuery {
+            resolution: query.resolution,
+            ..SkyMapQuery::default()
+        })?,
+        distribution_bins: query.bins,
+        trend_bins: query.trend_bins.unwrap_or(defaults.trend_bins),
+        trend_bandwidth: query.bandwidth.unwrap_or(defaults.trend_bandwidth),
+        trend_points: query.points.unwrap_or(defaults.trend_points),
+    };
+
+    let data = get_dashboard_data(state.repository.as_ref(), schedule_id, options)
+        .await
+        .map_err(AppError::Internal)?;
+    Ok(Json(data))
+}
+
 /// GET /v1/environments/{environment_id}/kpis
 ///
 /// Batched KPI summaries for every schedule assigned to the given
@@ -832,20 +1030,20 @@ pub async fn compare_schedules(
 
     let current_name = match query.current_name {
         Some(name) if !name.trim().is_empty() => name,
-        _ => db_services::get_schedule(state.repository.as_ref(), current_id)
+        _ => db_services::get_schedule_shared(state.repository.as_ref(), current_id)
             .await
             .ok()
-            .map(|s| s.name)
+            .map(|s| s.name.clone())
             .filter(|name| !name.trim().is_empty())
             .unwrap_or_else(|| format!("Schedule #{}", schedule_id)),
     };
 
     let comparison_name = match query.comparison_name {
         Some(name) if !name.trim().is_empty() => name,
-        _ => db_services::get_schedule(state.repository.as_ref(), comparison_id)
+        _ => db_services::get_schedule_shared(state.repository.as_ref(), comparison_id)
             .await
             .ok()
-            .map(|s| s.name)
+            .map(|s| s.name.clone())
             .filter(|name| !name.trim().is_empty())
             .unwrap_or_else(|| format!("Schedule #{}", other_id)),
     };
@@ -1513,7 +1711,8 @@ pub async fn unassign_schedule_environment(
 #[cfg(test)]
 mod tests {
     use super::*;
-    use crate::api::{Constraints, ModifiedJulianDate, Period, SchedulingBlockId};
+    use crate::api::{Constraints, ModifiedJulianDate, Period, SchedulingBlock, SchedulingBlockId};
+    use crate::models::ScheduleColumnsBuilder;
 
     fn make_block(id: i64, priority: f64, scheduled: bool) -> SchedulingBlock {
         SchedulingBlock {
@@ -1543,10 +1742,51 @@ mod tests {
         }
     }
 
+    #[tokio::test]
+    async fn timeline_of_a_schedule_deleted_mid_request_is_not_served() {
+        use crate::db::repositories::LocalRepository;
+        use crate::db::repository::ScheduleRepository;
+        use crate::models::synthetic::{generate_schedule, SyntheticScheduleConfig};
+
+        let repo = Arc::new(LocalRepository::new());
+        let schedule_id = repo.store_schedule_impl(generate_schedule(&SyntheticScheduleConfig {
+            blocks: 20,
+            scheduled_fraction: 1.0,
+            ..Default::default()
+        }));
+        let state = AppState::new(repo.clone());
+        let timeline = || get_timeline(State(state.clone()), Path(schedule_id.value()));
+
+        assert_eq!(
+            timeline().await.unwrap().status(),
+            axum::http::StatusCode::OK
+        );
+        let version = repo.schedule_version(schedule_id).await.unwrap().unwrap();
+        let body = state.timeline_cache.get(schedule_id, &version).unwrap();
+
+        // The delete lands (here or in another process, so nothing is
+        // invalidated locally) before a request that read the schedule
+        // earlier stores its payload.
+        repo.delete_schedule(schedule_id).await.unwrap();
+        state.timeline_cache.insert(schedule_id, version, body);
+
+        assert!(matches!(timeline().await, Err(AppError::NotFound(_))));
+    }
+
+    fn columns_of(blocks: &[SchedulingBlock]) -> ScheduleColumns {
+        let window = Period {
+            start: ModifiedJulianDate::new(60000.0),
+            end: ModifiedJulianDate::new(60001.0),
+        };
+        let mut builder = ScheduleColumnsBuilder::new(Some(1), String::new(), window);
+        blocks.iter().for_each(|b| builder.push_block(b));
+        builder.finish()
+    }
+
     #[test]
     fn visibility_histogram_query_filters_scheduled_blocks() {
-        let scheduled_block = make_block(1, 8.0, true);
-        let unscheduled_block = make_block(2, 8.0, false);
+        let columns = columns_of(&[make_block(1, 8.0, true), make_block(2, 8.0, false)]);
+        let (scheduled_block, unscheduled_block) = (0, 1);
 
         let scheduled_query = VisibilityHistogramQuery {
             scheduled: Some(true),
@@ -1558,29 +1798,36 @@ mod tests {
         };
 
         assert!(block_matches_visibility_histogram_query(
-            &scheduled_block,
+            &columns,
+            scheduled_block,
             &scheduled_query
         ));
         assert!(!block_matches_visibility_histogram_query(
-            &unscheduled_block,
+            &columns,
+            unscheduled_block,
             &scheduled_query
         ));
         assert!(block_matches_visibility_histogram_query(
-            &unscheduled_block,
+            &columns,
+            unscheduled_block,
             &unscheduled_query
         ));
         assert!(!block_matches_visibility_histogram_query(
-            &scheduled_block,
+            &columns,
+            scheduled_block,
             &unscheduled_query
         ));
     }
 
     #[test]
     fn visibility_histogram_query_combines_scheduled_with_other_filters() {
-        let matching_block = make_block(7, 6.0, true);
-        let wrong_status = make_block(7, 6.0, false);
-        let wrong_priority = make_block(7, 3.0, true);
-        let wrong_id = make_block(9, 6.0, true);
+        let columns = columns_of(&[
+            make_block(7, 6.0, true),
+            make_block(7, 6.0, false),
+            make_block(7, 3.0, true),
+            make_block(9, 6.0, true),
+        ]);
+        let (matching_block, wrong_status, wrong_priority, wrong_id) = (0, 1, 2, 3);
 
         let query = VisibilityHistogramQuery {
             priority_min: Some(5.0),
@@ -1591,17 +1838,22 @@ mod tests {
         };
 
         assert!(block_matches_visibility_histogram_query(
-            &matching_block,
+            &columns,
+            matching_block,
             &query
         ));
         assert!(!block_matches_visibility_histogram_query(
-            &wrong_status,
+            &columns,
+            wrong_status,
             &query
         ));
         assert!(!block_matches_visibility_histogram_query(
-            &wrong_priority,
+            &columns,
+            wrong_priority,
             &query
         ));
-        assert!(!block_matches_visibility_histogram_query(&wrong_id, &query));
+        assert!(!block_matches_visibility_histogram_query(
+            &columns, wrong_id, &query
+        ));
     }
 }
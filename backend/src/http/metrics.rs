@@ -0,0 +1,32 @@
+//! Request metrics middleware.
+//!
+//! Records per-route request counts, latency, in-flight requests and
+//! response sizes into the process-wide [`crate::metrics`] registry. Routes
+//! are labelled by their matched template (e.g.
+//! `/v1/schedules/{schedule_id}/insights`) so path parameters do not
+//! explode series cardinality.
+
+use axum::{
+    body::HttpBody,
+    extract::{MatchedPath, Request},
+    middleware::Next,
+    response::Response,
+};
+
+/// Middleware recording request metrics. Installed with `route_layer`, so
+/// only requests that matched a route are counted.
+pub async fn track_metrics(request: Request, next: Next) -> Response {
+    let route = request
+        .extensions()
+        .get::<MatchedPath>()
+        .map(|p| p.as_str().to_owned())
+        .unwrap_or_else(|| "unmatched".to_owned());
+    let series = crate::metrics::global().route(request.method().as_str(), &route);
+
+    let in_flight = series.start();
+    let response = next.run(request).await;
+    // Streaming bodies (SSE job logs) have no exact size; skip them.
+    let size = HttpBody::size_hint(response.body()).exact();
+    in_flight.finish(response.status().as_u16(), size);
+    response
+}
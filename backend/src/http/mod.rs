@@ -45,6 +45,12 @@ pub mod dto;
 #[cfg(feature = "http-server")]
 pub mod extensions;
 
+#[cfg(feature = "http-server")]
+pub mod metrics;
+
+#[cfg(feature = "http-server")]
+pub mod conditional;
+
 #[cfg(feature = "http-server")]
 pub use router::create_router;
 
@@ -5,6 +5,8 @@
 
 use axum::{
     extract::DefaultBodyLimit,
+    http::header,
+    middleware,
     routing::{delete, get, patch, post},
     Router,
 };
@@ -14,8 +16,10 @@ use tower_http::{
     trace::TraceLayer,
 };
 
+use super::conditional::schedule_etag;
 use super::extensions::BackendExtensions;
 use super::handlers;
+use super::metrics::track_metrics;
 use super::state::AppState;
 
 /// Create the main application router with all routes and middleware,
@@ -36,46 +40,13 @@ pub fn create_router_with_extensions(state: AppState, mut extensions: BackendExt
     let cors = CorsLayer::new()
         .allow_origin(Any)
         .allow_methods(Any)
-        .allow_headers(Any);
+        .allow_headers(Any)
+        .expose_headers([header::ETAG]);
 
-    // Build the API router with versioned endpoints
-    let api_v1 = Router::new()
-        // Schedule CRUD
-        .route("/schedules", get(handlers::list_schedules))
-        .route("/schedules", post(handlers::create_schedule))
-        .route(
-            "/schedules/bulk-delete",
-            post(handlers::bulk_delete_schedules),
-        )
-        .route("/schedules/{schedule_id}", get(handlers::get_schedule))
-        .route(
-            "/schedules/{schedule_id}",
-            delete(handlers::delete_schedule),
-        )
-        .route("/schedules/{schedule_id}", patch(handlers::update_schedule))
-        // Environment CRUD
-        .route("/environments", get(handlers::list_environments))
-        .route("/environments", post(handlers::create_environment))
-        .route(
-            "/environments/{environment_id}",
-            get(handlers::get_environment),
-        )
-        .route(
-            "/environments/{environment_id}",
-            delete(handlers::delete_environment),
-        )
-        .route(
-            "/environments/{environment_id}/schedules",
-            post(handlers::bulk_import_schedules),
-        )
-        .route(
-            "/schedules/{schedule_id}/environment",
-            delete(handlers::unassign_schedule_environment),
-        )
-        // Job management
-        .route("/jobs/{job_id}", get(handlers::get_job_status))
-        .route("/jobs/{job_id}/logs", get(handlers::stream_job_logs))
-        // Visualization endpoints
+    // Read-only schedule analytics. Their payloads depend only on the
+    // schedules in the path, so they carry ETags and answer revalidation
+    // with 304 without running the handler.
+    let schedule_analytics = Router::new()
         .route(
             "/schedules/{schedule_id}/sky-map",
             get(handlers::get_sky_map),
@@ -89,12 +60,12 @@ pub fn create_router_with_extensions(state: AppState, mut extensions: BackendExt
             get(handlers::get_visibility_map),
         )
         .route(
-            "/schedules/{schedule_id}/visibility-histogram",
-            get(handlers::get_visibility_histogram),
+            "/schedules/{schedule_id}/visibility-map/blocks",
+            get(handlers::get_visibility_blocks),
         )
         .route(
-            "/schedules/{schedule_id}/alt-az",
-            post(handlers::compute_alt_az),
+            "/schedules/{schedule_id}/visibility-histogram",
+            get(handlers::get_visibility_histogram),
         )
         .route(
             "/schedules/{schedule_id}/timeline",
@@ -126,12 +97,61 @@ pub fn create_router_with_extensions(state: AppState, mut extensions: BackendExt
             "/schedules/{schedule_id}/kpis",
             get(handlers::get_schedule_kpis),
         )
+        .route(
+            "/schedules/{schedule_id}/dashboard",
+            get(handlers::get_schedule_dashboard),
+        )
+        .route_layer(middleware::from_fn_with_state(state.clone(), schedule_etag));
+
+    // Build the API router with versioned endpoints
+    let api_v1 = Router::new()
+        // Schedule CRUD
+        .route("/schedules", get(handlers::list_schedules))
+        .route("/schedules", post(handlers::create_schedule))
+        .route(
+            "/schedules/bulk-delete",
+            post(handlers::bulk_delete_schedules),
+        )
+        .route("/schedules/{schedule_id}", get(handlers::get_schedule))
+        .route(
+            "/schedules/{schedule_id}",
+            delete(handlers::delete_schedule),
+        )
+        .route("/schedules/{schedule_id}", patch(handlers::update_schedule))
+        // Environment CRUD
+        .route("/environments", get(handlers::list_environments))
+        .route("/environments", post(handlers::create_environment))
+        .route(
+            "/environments/{environment_id}",
+            get(handlers::get_environment),
+        )
+        .route(
+            "/environments/{environment_id}",
+            delete(handlers::delete_environment),
+        )
+        .route(
+            "/environments/{environment_id}/schedules",
+            post(handlers::bulk_import_schedules),
+        )
+        .route(
+            "/schedules/{schedule_id}/environment",
+            delete(handlers::unassign_schedule_environment),
+        )
+        // Job management
+        .route("/jobs/{job_id}", get(handlers::get_job_status))
+        .route("/jobs/{job_id}/logs", get(handlers::stream_job_logs))
+        // Alt-az curves are computed per request body.
+        .route(
+            "/schedules/{schedule_id}/alt-az",
+            post(handlers::compute_alt_az),
+        )
         .route(
             "/environments/{environment_id}/kpis",
             get(handlers::get_environment_kpis),
         )
         // Diagnostics
-        .route("/_health/db", get(handlers::db_diagnostics));
+        .route("/_health/db", get(handlers::db_diagnostics))
+        .merge(schedule_analytics);
 
     // Merge integrator-contributed routes under the same `/v1` prefix.
     let api_v1 = match extra_routes {
@@ -142,7 +162,10 @@ pub fn create_router_with_extensions(state: AppState, mut extensions: BackendExt
     // Combine all routes
     Router::new()
         .route("/health", get(handlers::health_check))
+        .route("/metrics", get(handlers::get_metrics))
         .nest("/v1", api_v1)
+        // Per-route metrics, labelled by the matched route template.
+        .route_layer(middleware::from_fn(track_metrics))
         // Allow large schedule payloads during uploads.
         .layer(DefaultBodyLimit::max(50 * 1024 * 1024))
         .layer(CompressionLayer::new())
@@ -189,6 +212,31 @@ mod tests {
         // If we got here, router was created successfully
     }
 
+    #[tokio::test]
+    async fn metrics_endpoint_reports_matched_routes() {
+        let repo =
+            Arc::new(LocalRepository::new()) as Arc<dyn crate::db::repository::FullRepository>;
+        let app = create_router(AppState::new(repo));
+
+        let request = Request::builder()
+            .uri("/v1/schedules/424242/insights")
+            .body(Body::empty())
+            .unwrap();
+        let _ = app.clone().oneshot(request).await.unwrap();
+
+        let request = Request::builder()
+            .uri("/metrics")
+            .body(Body::empty())
+            .unwrap();
+        let response = app.oneshot(request).await.unwrap();
+        assert_eq!(response.status(), StatusCode::OK);
+        let body = to_bytes(response.into_body(), usize::MAX).await.unwrap();
+        let text = String::from_utf8(body.to_vec()).unwrap();
+        assert!(text.contains("route=\"/v1/schedules/{schedule_id}/insights\""));
+        assert!(text.contains("# TYPE tsi_http_request_duration_seconds histogram"));
+        assert!(text.contains("tsi_db_pool_wait_seconds_count"));
+    }
+
     #[tokio::test]
     async fn default_router_accepts_native_schedule_uploads() {
         let repo =
@@ -1,9 +1,11 @@
 //! Application state for the HTTP server.
 
+use crate::api::ScheduleId;
 use crate::db::repository::FullRepository;
 use crate::http::extensions::BackendExtensions;
 use crate::services::job_tracker::JobTracker;
 use crate::services::{default_schedule_import_adapter, ScheduleImportAdapter};
+use axum::body::Bytes;
 use std::collections::VecDeque;
 use std::sync::{Arc, Mutex};
 
@@ -66,6 +68,61 @@ impl BulkImportLatencyRing {
     }
 }
 
+/// Number of schedules whose serialized timeline payload is kept in memory.
+const TIMELINE_CACHE_CAPACITY: usize = 32;
+
+/// Bounded per-schedule cache of serialized JSON responses, evicting the
+/// oldest entry when full. Cheap to clone (Arc).
+///
+/// Entries are keyed by the schedule's stored version
+/// ([`ScheduleRepository::schedule_version`](crate::db::repository::ScheduleRepository::schedule_version)),
+/// which callers read from the repository on every lookup. A write or a
+/// delete, by this process or another one sharing the database, therefore
+/// retires an entry even if it was inserted after the change.
+#[derive(Debug, Clone)]
+pub struct ScheduleResponseCache {
+    inner: Arc<Mutex<VecDeque<(ScheduleId, String, Bytes)>>>,
+    capacity: usize,
+}
+
+impl ScheduleResponseCache {
+    pub fn new(capacity: usize) -> Self {
+        Self {
+            inner: Arc::new(Mutex::new(VecDeque::with_capacity(capacity))),
+            capacity: capacity.max(1),
+        }
+    }
+
+    /// The payload stored for `schedule_id` at `version`, if any.
+    pub fn get(&self, schedule_id: ScheduleId, version: &str) -> Option<Bytes> {
+        let q = self.inner.lock().ok()?;
+        q.iter()
+            .find(|(id, v, _)| *id == schedule_id && v == version)
+            .map(|(_, _, body)| body.clone())
+    }
+
+    /// Insert or replace the payload for `schedule_id`, built from the
+    /// schedule at `version` (read before building it). Lock poisoning is
+    /// swallowed: a cache miss is always a valid outcome.
+    pub fn insert(&self, schedule_id: ScheduleId, version: String, body: Bytes) {
+        if let Ok(mut q) = self.inner.lock() {
+            q.retain(|(id, _, _)| *id != schedule_id);
+            if q.len() == self.capacity {
+                q.pop_front();
+            }
+            q.push_back((schedule_id, version, body));
+        }
+    }
+
+    /// Drop the payload for `schedule_id` early; lookups would skip it
+    /// anyway once its version is gone.
+    pub fn invalidate(&self, schedule_id: ScheduleId) {
+        if let Ok(mut q) = self.inner.lock() {
+            q.retain(|(id, _, _)| *id != schedule_id);
+        }
+    }
+}
+
 /// Shared application state passed to all handlers.
 #[derive(Clone)]
 pub struct AppState {
@@ -86,6 +143,9 @@ pub struct AppState {
     /// diagnostics endpoint. Cheap to clone — the underlying buffer is
     /// shared via `Arc<Mutex<_>>`.
     pub bulk_import_latencies: BulkImportLatencyRing,
+    /// Serialized `/timeline` payloads (blocks plus render-ready layout),
+    /// computed once per schedule.
+    pub timeline_cache: ScheduleResponseCache,
     /// Integrator-supplied extension registry. The router clones this
     /// during construction to mount any extra routes; handlers may
     /// also consult it (e.g. to look up algorithm trace validators).
@@ -109,6 +169,7 @@ impl AppState {
             job_tracker: JobTracker::new(),
             bulk_import_concurrency: bulk_import_concurrency_from_env(),
             bulk_import_latencies: BulkImportLatencyRing::new(),
+            timeline_cache: ScheduleResponseCache::new(TIMELINE_CACHE_CAPACITY),
             extensions: Arc::new(BackendExtensions::default()),
         }
     }
@@ -24,6 +24,7 @@
 //! - [`services`]: High-level business logic and visualization services
 //! - [`http`]: Axum-based HTTP server and request handlers
 //! - [`routes`]: Route-specific data types and business logic
+//! - [`metrics`]: Process-wide performance metrics (Prometheus text format)
 //!
 
 // Allow large error types - RepositoryError contains rich context for debugging
@@ -41,6 +42,7 @@
 pub mod api;
 
 pub mod db;
+pub mod metrics;
 pub mod models;
 
 pub mod routes;
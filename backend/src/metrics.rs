@@ -0,0 +1,445 @@
+//! Process-wide performance metrics, rendered in Prometheus text format.
+//!
+//! The registry is a lazily initialised global so that layers without
+//! access to the HTTP `AppState` (repositories, blocking-pool helpers,
+//! rayon call sites) can record into it. Recording is lock-free; the only
+//! lock is taken when a route is seen for the first time.
+//!
+//! Series exposed by [`Metrics::render_prometheus`]:
+//!
+//! - `tsi_http_requests_total{method,route,status}`
+//! - `tsi_http_requests_in_flight{method,route}`
+//! - `tsi_http_request_duration_seconds{method,route}` (histogram)
+//! - `tsi_http_response_size_bytes{method,route}` (histogram)
+//! - `tsi_db_pool_wait_seconds` / `tsi_db_query_seconds` (histograms)
+//! - `tsi_db_operations_total{outcome}`
+//! - `tsi_blocking_tasks_queued` / `tsi_blocking_tasks_running` (gauges)
+//! - `tsi_blocking_queue_wait_seconds` (histogram)
+//! - `tsi_rayon_jobs_in_flight` / `tsi_rayon_threads` (gauges)
+
+use std::collections::BTreeMap;
+use std::fmt::Write as _;
+use std::sync::atomic::{AtomicI64, AtomicU64, Ordering};
+use std::sync::{Arc, OnceLock};
+use std::time::{Duration, Instant};
+
+use parking_lot::RwLock;
+
+/// Upper bounds (seconds) for latency histograms.
+pub const LATENCY_BUCKETS_SECONDS: &[f64] = &[
+    0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 30.0,
+];
+
+/// Upper bounds (bytes) for response-size histograms.
+pub const SIZE_BUCKETS_BYTES: &[f64] = &[
+    256.0, 1024.0, 4096.0, 16384.0, 65536.0, 262144.0, 1048576.0, 4194304.0, 16777216.0, 67108864.0,
+];
+
+/// Fixed-bucket histogram with atomic counters.
+#[derive(Debug)]
+pub struct Histogram {
+    bounds: &'static [f64],
+    /// Per-bucket (non-cumulative) counts; the last slot is `+Inf`.
+    counts: Box<[AtomicU64]>,
+    /// Running sum stored as `f64` bits.
+    sum_bits: AtomicU64,
+}
+
+impl Histogram {
+    pub fn new(bounds: &'static [f64]) -> Self {
+        Self {
+            bounds,
+            counts: (0..=bounds.len()).map(|_| AtomicU64::new(0)).collect(),
+            sum_bits: AtomicU64::new(0f64.to_bits()),
+        }
+    }
+
+    pub fn observe(&self, value: f64) {
+        let bucket = self.bounds.partition_point(|&b| b < value);
+        self.counts[bucket].fetch_add(1, Ordering::Relaxed);
+        let _ = self
+            .sum_bits
+            .fetch_update(Ordering::Relaxed, Ordering::Relaxed, |bits| {
+                Some((f64::from_bits(bits) + value).to_bits())
+            });
+    }
+
+    pub fn observe_duration(&self, duration: Duration) {
+        self.observe(duration.as_secs_f64());
+    }
+
+    pub fn count(&self) -> u64 {
+        self.counts.iter().map(|c| c.load(Ordering::Relaxed)).sum()
+    }
+
+    pub fn sum(&self) -> f64 {
+        f64::from_bits(self.sum_bits.load(Ordering::Relaxed))
+    }
+
+    /// Append `_bucket`, `_sum` and `_count` samples. `labels` is either
+    /// empty or a comma-separated `key="value"` list without braces.
+    fn render(&self, out: &mut String, name: &str, labels: &str) {
+        let sep = if labels.is_empty() { "" } else { "," };
+        let mut cumulative = 0;
+        for (i, count) in self.counts.iter().enumerate() {
+            cumulative += count.load(Ordering::Relaxed);
+            let le = self
+                .bounds
+                .get(i)
+                .map_or_else(|| "+Inf".to_string(), |b| b.to_string());
+            let _ = writeln!(
+                out,
+                "{name}_bucket{{{labels}{sep}le=\"{le}\"}} {cumulative}"
+            );
+        }
+        let braced = if labels.is_empty() {
+            String::new()
+        } else {
+            format!("{{{labels}}}")
+        };
+        let _ = writeln!(out, "{name}_sum{braced} {}", self.sum());
+        let _ = writeln!(out, "{name}_count{braced} {cumulative}");
+    }
+}
+
+/// Per-route HTTP series.
+#[derive(Debug)]
+pub struct RouteMetrics {
+    /// Responses by status class (`1xx` … `5xx`).
+    responses: [AtomicU64; 5],
+    in_flight: AtomicI64,
+    pub latency: Histogram,
+    pub response_bytes: Histogram,
+}
+
+impl RouteMetrics {
+    fn new() -> Self {
+        Self {
+            responses: Default::default(),
+            in_flight: AtomicI64::new(0),
+            latency: Histogram::new(LATENCY_BUCKETS_SECONDS),
+            response_bytes: Histogram::new(SIZE_BUCKETS_BYTES),
+        }
+    }
+
+    /// Mark a request as started; the returned guard keeps it counted as
+    /// in flight until dropped (including when the handler future is
+    /// cancelled).
+    pub fn start(self: &Arc<Self>) -> InFlightRequest {
+        self.in_flight.fetch_add(1, Ordering::Relaxed);
+        InFlightRequest {
+            route: self.clone(),
+            started: Instant::now(),
+        }
+    }
+
+    pub fn requests(&self) -> u64 {
+        self.responses
+            .iter()
+            .map(|c| c.load(Ordering::Relaxed))
+            .sum()
+    }
+
+    pub fn in_flight(&self) -> i64 {
+        self.in_flight.load(Ordering::Relaxed)
+    }
+}
+
+/// Guard returned by [`RouteMetrics::start`].
+pub struct InFlightRequest {
+    route: Arc<RouteMetrics>,
+    started: Instant,
+}
+
+impl InFlightRequest {
+    /// Record the response status and, when known, its body size.
+    pub fn finish(self, status: u16, response_bytes: Option<u64>) {
+        let class = (status / 100).clamp(1, 5) as usize - 1;
+        self.route.responses[class].fetch_add(1, Ordering::Relaxed);
+        self.route.latency.observe_duration(self.started.elapsed());
+        if let Some(bytes) = response_bytes {
+            self.route.response_bytes.observe(bytes as f64);
+        }
+    }
+}
+
+impl Drop for InFlightRequest {
+    fn drop(&mut self) {
+        self.route.in_flight.fetch_sub(1, Ordering::Relaxed);
+    }
+}
+
+/// Decrements a gauge when dropped.
+pub struct GaugeGuard(&'static AtomicI64);
+
+impl GaugeGuard {
+    fn enter(gauge: &'static AtomicI64) -> Self {
+        gauge.fetch_add(1, Ordering::Relaxed);
+        Self(gauge)
+    }
+}
+
+impl Drop for GaugeGuard {
+    fn drop(&mut self) {
+        self.0.fetch_sub(1, Ordering::Relaxed);
+    }
+}
+
+/// The process-wide registry. Obtain it with [`global`].
+#[derive(Debug)]
+pub struct Metrics {
+    routes: RwLock<BTreeMap<(String, String), Arc<RouteMetrics>>>,
+    /// Time spent waiting for a pooled database connection.
+    pub db_pool_wait: Histogram,
+    /// Time spent executing a repository operation on a checked-out
+    /// connection.
+    pub db_query: Histogram,
+    db_ok: AtomicU64,
+    db_failed: AtomicU64,
+    blocking_queued: AtomicI64,
+    blocking_running: AtomicI64,
+    /// Delay between submitting a blocking task and it starting.
+    pub blocking_wait: Histogram,
+    rayon_jobs: AtomicI64,
+}
+
+impl Metrics {
+    fn new() -> Self {
+        Self {
+            routes: RwLock::new(BTreeMap::new()),
+            db_pool_wait: Histogram::new(LATENCY_BUCKETS_SECONDS),
+            db_query: Histogram::new(LATENCY_BUCKETS_SECONDS),
+            db_ok: AtomicU64::new(0),
+            db_failed: AtomicU64::new(0),
+            blocking_queued: AtomicI64::new(0),
+            blocking_running: AtomicI64::new(0),
+            blocking_wait: Histogram::new(LATENCY_BUCKETS_SECONDS),
+            rayon_jobs: AtomicI64::new(0),
+        }
+    }
+
+    /// Series for a `(method, route template)` pair, created on first use.
+    pub fn route(&self, method: &str, route: &str) -> Arc<RouteMetrics> {
+        let key = (method.to_string(), route.to_string());
+        if let Some(existing) = self.routes.read().get(&key) {
+            return existing.clone();
+        }
+        self.routes
+            .write()
+            .entry(key)
+            .or_insert_with(|| Arc::new(RouteMetrics::new()))
+            .clone()
+    }
+
+    /// Record the outcome of one repository operation.
+    pub fn record_db_operation(&self, ok: bool) {
+        let counter = if ok { &self.db_ok } else { &self.db_failed };
+        counter.fetch_add(1, Ordering::Relaxed);
+    }
+
+    /// Render every series in Prometheus text exposition format (0.0.4).
+    pub fn render_prometheus(&self) -> String {
+        let mut out = String::with_capacity(16 * 1024);
+        let routes = self.routes.read();
+
+        out.push_str("# HELP tsi_http_requests_total HTTP responses by route and status class.\n");
+        out.push_str("# TYPE tsi_http_requests_total counter\n");
+        for ((method, route), m) in routes.iter() {
+            for (i, count) in m.responses.iter().enumerate() {
+                let count = count.load(Ordering::Relaxed);
+                if count > 0 {
+                    let _ = writeln!(
+                        out,
+                        "tsi_http_requests_total{{method=\"{method}\",route=\"{}\",status=\"{}xx\"}} {count}",
+                        escape_label(route),
+                        i + 1
+                    );
+                }
+            }
+        }
+
+        out.push_str("# HELP tsi_http_requests_in_flight Requests currently being handled.\n");
+        out.push_str("# TYPE tsi_http_requests_in_flight gauge\n");
+        for ((method, route), m) in routes.iter() {
+            let _ = writeln!(
+                out,
+                "tsi_http_requests_in_flight{{method=\"{method}\",route=\"{}\"}} {}",
+                escape_label(route),
+                m.in_flight()
+            );
+        }
+
+        out.push_str("# HELP tsi_http_request_duration_seconds Request latency by route.\n");
+        out.push_str("# TYPE tsi_http_request_duration_seconds histogram\n");
+        for ((method, route), m) in routes.iter() {
+            let labels = format!("method=\"{method}\",route=\"{}\"", escape_label(route));
+            m.latency
+                .render(&mut out, "tsi_http_request_duration_seconds", &labels);
+        }
+
+        out.push_str(
+            "# HELP tsi_http_response_size_bytes Uncompressed response body size by route.\n",
+        );
+        out.push_str("# TYPE tsi_http_response_size_bytes histogram\n");
+        for ((method, route), m) in routes.iter() {
+            let labels = format!("method=\"{method}\",route=\"{}\"", escape_label(route));
+            m.response_bytes
+                .render(&mut out, "tsi_http_response_size_bytes", &labels);
+        }
+        drop(routes);
+
+        out.push_str("# HELP tsi_db_pool_wait_seconds Time waiting for a pooled connection.\n");
+        out.push_str("# TYPE tsi_db_pool_wait_seconds histogram\n");
+        self.db_pool_wait
+            .render(&mut out, "tsi_db_pool_wait_seconds", "");
+        out.push_str("# HELP tsi_db_query_seconds Time executing a repository operation.\n");
+        out.push_str("# TYPE tsi_db_query_seconds histogram\n");
+        self.db_query.render(&mut out, "tsi_db_query_seconds", "");
+        out.push_str("# HELP tsi_db_operations_total Repository operations by outcome.\n");
+        out.push_str("# TYPE tsi_db_operations_total counter\n");
+        let _ = writeln!(
+            out,
+            "tsi_db_operations_total{{outcome=\"ok\"}} {}",
+            self.db_ok.load(Ordering::Relaxed)
+        );
+        let _ = writeln!(
+            out,
+            "tsi_db_operations_total{{outcome=\"error\"}} {}",
+            self.db_failed.load(Ordering::Relaxed)
+        );
+
+        out.push_str(
+            "# HELP tsi_blocking_tasks_queued Blocking tasks submitted but not started.\n",
+        );
+        out.push_str("# TYPE tsi_blocking_tasks_queued gauge\n");
+        let _ = writeln!(
+            out,
+            "tsi_blocking_tasks_queued {}",
+            self.blocking_queued.load(Ordering::Relaxed)
+        );
+        out.push_str("# HELP tsi_blocking_tasks_running Blocking tasks currently running.\n");
+        out.push_str("# TYPE tsi_blocking_tasks_running gauge\n");
+        let _ = writeln!(
+            out,
+            "tsi_blocking_tasks_running {}",
+            self.blocking_running.load(Ordering::Relaxed)
+        );
+        out.push_str(
+            "# HELP tsi_blocking_queue_wait_seconds Delay before a blocking task starts.\n",
+        );
+        out.push_str("# TYPE tsi_blocking_queue_wait_seconds histogram\n");
+        self.blocking_wait
+            .render(&mut out, "tsi_blocking_queue_wait_seconds", "");
+
+        out.push_str(
+            "# HELP tsi_rayon_jobs_in_flight Parallel sections submitted to the rayon pool.\n",
+        );
+        out.push_str("# TYPE tsi_rayon_jobs_in_flight gauge\n");
+        let _ = writeln!(
+            out,
+            "tsi_rayon_jobs_in_flight {}",
+            self.rayon_jobs.load(Ordering::Relaxed)
+        );
+        out.push_str("# HELP tsi_rayon_threads Size of the global rayon pool.\n");
+        out.push_str("# TYPE tsi_rayon_threads gauge\n");
+        let _ = writeln!(out, "tsi_rayon_threads {}", rayon::current_num_threads());
+
+        out
+    }
+}
+
+fn escape_label(value: &str) -> String {
+    value
+        .replace('\\', "\\\\")
+        .replace('"', "\\\"")
+        .replace('\n', "\\n")
+}
+
+/// The process-wide metrics registry.
+pub fn global() -> &'static Metrics {
+    static METRICS: OnceLock<Metrics> = OnceLock::new();
+    METRICS.get_or_init(Metrics::new)
+}
+
+/// [`tokio::task::spawn_blocking`] that reports blocking-pool queue depth
+/// and queue wait.
+pub fn spawn_blocking<F, R>(f: F) -> tokio::task::JoinHandle<R>
+where
+    F: FnOnce() -> R + Send + 'static,
+    R: Send + 'static,
+{
+    let metrics = global();
+    let queued = GaugeGuard::enter(&metrics.blocking_queued);
+    let submitted = Instant::now();
+    tokio::task::spawn_blocking(move || {
+        drop(queued);
+        metrics.blocking_wait.observe_duration(submitted.elapsed());
+        let _running = GaugeGuard::enter(&metrics.blocking_running);
+        f()
+    })
+}
+
+/// Count a parallel section against the global rayon pool for as long as
+/// the returned guard lives. Rayon exposes no queue-depth API; concurrent
+/// sections above one are what queue behind each other.
+pub fn rayon_job() -> GaugeGuard {
+    GaugeGuard::enter(&global().rayon_jobs)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_histogram_buckets_are_cumulative() {
+        let h = Histogram::new(&[1.0, 2.0]);
+        h.observe(0.5);
+        h.observe(1.0);
+        h.observe(1.5);
+        h.observe(5.0);
+        assert_eq!(h.count(), 4);
+        assert!((h.sum() - 8.0).abs() < 1e-12);
+
+        let mut out = String::new();
+        h.render(&mut out, "x", "a=\"b\"");
+        assert!(out.contains("x_bucket{a=\"b\",le=\"1\"} 2\n"));
+        assert!(out.contains("x_bucket{a=\"b\",le=\"2\"} 3\n"));
+        assert!(out.contains("x_bucket{a=\"b\",le=\"+Inf\"} 4\n"));
+        assert!(out.contains("x_count{a=\"b\"} 4\n"));
+    }
+
+    #[test]
+    fn test_route_series_rendered() {
+        let metrics = Metrics::new();
+        let route = metrics.route("GET", "/v1/schedules/{schedule_id}/insights");
+        let request = route.start();
+        assert_eq!(route.in_flight(), 1);
+        request.finish(200, Some(2048));
+        assert_eq!(route.in_flight(), 0);
+        assert_eq!(route.requests(), 1);
+
+        let text = metrics.render_prometheus();
+        assert!(text.contains(
+            "tsi_http_requests_total{method=\"GET\",route=\"/v1/schedules/{schedule_id}/insights\",status=\"2xx\"} 1"
+        ));
+        assert!(text.contains("# TYPE tsi_http_request_duration_seconds histogram"));
+        assert!(text.contains("tsi_http_response_size_bytes_count{method=\"GET\""));
+        assert!(text.contains("tsi_rayon_threads "));
+    }
+
+    #[test]
+    fn test_dropped_request_leaves_in_flight() {
+        let metrics = Metrics::new();
+        let route = metrics.route("POST", "/x");
+        drop(route.start());
+        assert_eq!(route.in_flight(), 0);
+        assert_eq!(route.requests(), 0);
+    }
+
+    #[tokio::test]
+    async fn test_spawn_blocking_tracks_queue() {
+        let value = spawn_blocking(|| 7).await.unwrap();
+        assert_eq!(value, 7);
+        assert!(global().blocking_wait.count() >= 1);
+    }
+}
@@ -0,0 +1,264 @@
+//! Columnar view of a schedule for the analytics services.
+//!
+//! [`crate::api::SchedulingBlock`] is convenient for I/O but costly to
+//! clone: two `String`s, the constraints and a heap `Vec<Period>` per
+//! block. The analytics services read only a handful of its fields, so
+//! [`ScheduleColumns`] keeps one vector per field, every visibility period
+//! in a single buffer indexed by an offsets array, and block ids and names
+//! interned in a shared string table. Repositories build it directly from
+//! their storage, without materialising blocks first.
+
+use std::collections::HashMap;
+use std::ops::Range;
+use std::sync::Arc;
+
+use crate::api::{Period, Schedule, SchedulingBlock, SchedulingBlockId};
+
+/// Index of a string in a [`ScheduleColumns`] string table.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+pub struct Symbol(u32);
+
+/// Per-block fields of a schedule, stored column by column.
+///
+/// Row `i` of every column describes the same block, in the order the
+/// blocks were pushed.
+#[derive(Debug, Clone)]
+pub struct ScheduleColumns {
+    pub schedule_id: Option<i64>,
+    pub name: String,
+    pub schedule_period: Period,
+    pub dark_periods: Vec<Period>,
+    pub astronomical_nights: Vec<Period>,
+
+    pub block_ids: Vec<Option<SchedulingBlockId>>,
+    pub original_block_ids: Vec<Symbol>,
+    pub block_names: Vec<Symbol>,
+    pub priorities: Vec<f64>,
+    pub requested_seconds: Vec<f64>,
+    pub scheduled_periods: Vec<Option<Period>>,
+    /// `visibility[visibility_offsets[i]..visibility_offsets[i + 1]]` are
+    /// the visibility periods of block `i`.
+    visibility_offsets: Vec<u32>,
+    visibility: Vec<Period>,
+    strings: Vec<Arc<str>>,
+}
+
+impl ScheduleColumns {
+    /// Columns of `schedule`, borrowing nothing from it.
+    pub fn from_schedule(schedule: &Schedule) -> Self {
+        let mut builder = ScheduleColumnsBuilder::new(
+            schedule.id,
+            schedule.name.clone(),
+            schedule.schedule_period,
+        )
+        .with_capacity(schedule.blocks.len());
+        builder.dark_periods = schedule.dark_periods.clone();
+        builder.astronomical_nights = schedule.astronomical_nights.clone();
+        for block in &schedule.blocks {
+            builder.push_block(block);
+        }
+        builder.finish()
+    }
+
+    pub fn len(&self) -> usize {
+        self.priorities.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.priorities.is_empty()
+    }
+
+    pub fn str(&self, symbol: Symbol) -> &str {
+        &self.strings[symbol.0 as usize]
+    }
+
+    pub fn original_block_id(&self, row: usize) -> &str {
+        self.str(self.original_block_ids[row])
+    }
+
+    pub fn block_name(&self, row: usize) -> &str {
+        self.str(self.block_names[row])
+    }
+
+    fn visibility_range(&self, row: usize) -> Range<usize> {
+        self.visibility_offsets[row] as usize..self.visibility_offsets[row + 1] as usize
+    }
+
+    /// Visibility periods of block `row`.
+    pub fn visibility(&self, row: usize) -> &[Period] {
+        &self.visibility[self.visibility_range(row)]
+    }
+
+    /// Visibility periods of every block, concatenated in row order.
+    pub fn all_visibility(&self) -> &[Period] {
+        &self.visibility
+    }
+}
+
+/// Incremental builder of [`ScheduleColumns`], one block at a time.
+#[derive(Debug)]
+pub struct ScheduleColumnsBuilder {
+    pub dark_periods: Vec<Period>,
+    pub astronomical_nights: Vec<Period>,
+    columns: ScheduleColumns,
+    interned: HashMap<Arc<str>, Symbol>,
+}
+
+impl ScheduleColumnsBuilder {
+    pub fn new(schedule_id: Option<i64>, name: String, schedule_period: Period) -> Self {
+        Self {
+            dark_periods: Vec::new(),
+            astronomical_nights: Vec::new(),
+            columns: ScheduleColumns {
+                schedule_id,
+                name,
+                schedule_period,
+                dark_periods: Vec::new(),
+                astronomical_nights: Vec::new(),
+                block_ids: Vec::new(),
+                original_block_ids: Vec::new(),
+                block_names: Vec::new(),
+                priorities: Vec::new(),
+                requested_seconds: Vec::new(),
+                scheduled_periods: Vec::new(),
+                visibility_offsets: vec![0],
+                visibility: Vec::new(),
+                strings: Vec::new(),
+            },
+            interned: HashMap::new(),
+        }
+    }
+
+    /// Reserve room for `blocks` rows.
+    pub fn with_capacity(mut self, blocks: usize) -> Self {
+        let c = &mut self.columns;
+        c.block_ids.reserve(blocks);
+        c.original_block_ids.reserve(blocks);
+        c.block_names.reserve(blocks);
+        c.priorities.reserve(blocks);
+        c.requested_seconds.reserve(blocks);
+        c.scheduled_periods.reserve(blocks);
+        c.visibility_offsets.reserve(blocks);
+        self
+    }
+
+    fn intern(&mut self, s: &str) -> Symbol {
+        if let Some(symbol) = self.interned.get(s) {
+            return *symbol;
+        }
+        let symbol = Symbol(self.columns.strings.len() as u32);
+        let s: Arc<str> = Arc::from(s);
+        self.columns.strings.push(s.clone());
+        self.interned.insert(s, symbol);
+        symbol
+    }
+
+    pub fn push_block(&mut self, block: &SchedulingBlock) {
+        self.push_row(
+            block.id,
+            &block.original_block_id,
+            &block.block_name,
+            block.priority,
+            block.requested_duration.value(),
+            block.scheduled_period,
+            block.visibility_periods.iter().copied(),
+        );
+    }
+
+    /// Append one block from its raw fields.
+    #[allow(clippy::too_many_arguments)]
+    pub fn push_row(
+        &mut self,
+        id: Option<SchedulingBlockId>,
+        original_block_id: &str,
+        block_name: &str,
+        priority: f64,
+        requested_seconds: f64,
+        scheduled_period: Option<Period>,
+        visibility: impl IntoIterator<Item = Period>,
+    ) {
+        let original_block_id = self.intern(original_block_id);
+        let block_name = self.intern(block_name);
+        let c = &mut self.columns;
+        c.block_ids.push(id);
+        c.original_block_ids.push(original_block_id);
+        c.block_names.push(block_name);
+        c.priorities.push(priority);
+        c.requested_seconds.push(requested_seconds);
+        c.scheduled_periods.push(scheduled_period);
+        c.visibility.extend(visibility);
+        c.visibility_offsets.push(c.visibility.len() as u32);
+    }
+
+    pub fn finish(self) -> ScheduleColumns {
+        let mut columns = self.columns;
+        columns.dark_periods = self.dark_periods;
+        columns.astronomical_nights = self.astronomical_nights;
+        columns
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::api::{Constraints, ModifiedJulianDate};
+
+    fn period(start: f64, end: f64) -> Period {
+        Period::new(ModifiedJulianDate::new(start), ModifiedJulianDate::new(end))
+    }
+
+    fn bounds(periods: &[Period]) -> Vec<(f64, f64)> {
+        periods
+            .iter()
+            .map(|p| (p.start.value(), p.end.value()))
+            .collect()
+    }
+
+    fn block(id: i64, name: &str, visibility: Vec<Period>) -> SchedulingBlock {
+        SchedulingBlock {
+            id: Some(SchedulingBlockId(id)),
+            original_block_id: format!("ob-{id}"),
+            block_name: name.to_string(),
+            target_ra: 0.0.into(),
+            target_dec: 0.0.into(),
+            constraints: Constraints::new(0.0.into(), 90.0.into(), 0.0.into(), 360.0.into(), None),
+            priority: id as f64,
+            min_observation: 0.0.into(),
+            requested_duration: 3600.0.into(),
+            visibility_periods: visibility,
+            scheduled_period: (id % 2 == 0).then(|| period(1.0, 1.5)),
+        }
+    }
+
+    #[test]
+    fn rows_match_blocks() {
+        let blocks = vec![
+            block(1, "M31", vec![period(0.0, 1.0), period(2.0, 3.0)]),
+            block(2, "M31", vec![]),
+            block(3, "M42", vec![period(4.0, 5.0)]),
+        ];
+        let mut builder = ScheduleColumnsBuilder::new(Some(9), "s".into(), period(0.0, 10.0));
+        blocks.iter().for_each(|b| builder.push_block(b));
+        let columns = builder.finish();
+
+        assert_eq!(columns.len(), 3);
+        for (row, b) in blocks.iter().enumerate() {
+            assert_eq!(columns.block_ids[row], b.id);
+            assert_eq!(columns.original_block_id(row), b.original_block_id);
+            assert_eq!(columns.block_name(row), b.block_name);
+            assert_eq!(columns.priorities[row], b.priority);
+            assert_eq!(
+                bounds(columns.scheduled_periods[row].as_slice()),
+                bounds(b.scheduled_period.as_slice())
+            );
+            assert_eq!(
+                bounds(columns.visibility(row)),
+                bounds(&b.visibility_periods)
+            );
+        }
+        assert_eq!(columns.all_visibility().len(), 3);
+        // Repeated names share one entry.
+        assert_eq!(columns.block_names[0], columns.block_names[1]);
+        assert_eq!(columns.strings.len(), 5);
+    }
+}
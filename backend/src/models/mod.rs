@@ -1,6 +1,9 @@
+pub mod columns;
 pub mod macros;
 pub mod schedule;
+pub mod synthetic;
 pub mod time;
 
+pub use columns::{ScheduleColumns, ScheduleColumnsBuilder, Symbol};
 pub use schedule::*;
 pub use time::*;
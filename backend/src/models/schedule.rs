@@ -107,6 +107,7 @@ pub fn parse_schedule_json_str(json_schedule_json: &str) -> Result<api::Schedule
     // - Use a streaming JSON parser to process blocks and periods incrementally
     // - Store large possible_periods in a separate compressed file/table
     // - Lazy-load visibility periods on demand rather than materializing all at once
+    let _rayon = crate::metrics::rayon_job();
     match input.possible_periods {
         Some(map) => {
             let location = schedule.geographic_location;
@@ -22,22 +22,44 @@ pub struct AltAzRequest {
     pub start_mjd: f64,
     pub end_mjd: f64,
     pub targets: Vec<AltAzTargetRequest>,
+    /// Sampling cadence in minutes. Defaults to 10 minutes when omitted.
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub sample_interval_minutes: Option<f64>,
 }
 
-#[derive(Debug, Clone, Serialize, Deserialize)]
-pub struct AltAzCurve {
-    pub original_block_id: String,
-    pub block_name: String,
-    pub priority: f64,
-    pub altitudes_deg: Vec<f64>,
-    pub azimuths_deg: Vec<f64>,
-}
-
+/// Columnar altitude/azimuth payload.
+///
+/// Per-target metadata is stored as parallel columns (index `t` describes
+/// target `t`). Altitudes and azimuths are flat target-major matrices of
+/// `target_count * sample_count` values: the curve for target `t` is the
+/// slice `[t * sample_count, (t + 1) * sample_count)`, which the frontend
+/// maps onto typed-array views without copying.
 #[derive(Debug, Clone, Serialize, Deserialize)]
 pub struct AltAzData {
     pub schedule_id: i64,
+    pub sample_interval_minutes: f64,
+    pub sample_count: usize,
+    pub target_count: usize,
     pub sample_times_mjd: Vec<f64>,
-    pub curves: Vec<AltAzCurve>,
+    pub original_block_ids: Vec<String>,
+    pub block_names: Vec<String>,
+    pub priorities: Vec<f64>,
+    pub altitudes_deg: Vec<f32>,
+    pub azimuths_deg: Vec<f32>,
+}
+
+impl AltAzData {
+    /// Altitude samples (degrees) for target `index`.
+    pub fn altitudes_for(&self, index: usize) -> &[f32] {
+        let start = index * self.sample_count;
+        &self.altitudes_deg[start..start + self.sample_count]
+    }
+
+    /// Azimuth samples (degrees) for target `index`.
+    pub fn azimuths_for(&self, index: usize) -> &[f32] {
+        let start = index * self.sample_count;
+        &self.azimuths_deg[start..start + self.sample_count]
+    }
 }
 
 pub const GET_ALT_AZ_DATA: &str = "get_alt_az_data";
@@ -26,9 +26,31 @@ pub struct DistributionStats {
     pub sum: f64,
 }
 
+/// Fixed-width histogram of one column, split by scheduling status.
+///
+/// `bins` equal-width bins span `[min, max]`; bin `i` holds values in
+/// `[min + i * width, min + (i + 1) * width)` and the last bin also holds
+/// `max`. When every value is equal they all fall in the first bin.
+#[derive(Debug, Clone, Serialize, Deserialize)]
+pub struct DistributionHistogram {
+    pub min: f64,
+    pub max: f64,
+    pub scheduled: Vec<usize>,
+    pub unscheduled: Vec<usize>,
+}
+
+/// Histograms of the charted distribution columns.
+#[derive(Debug, Clone, Serialize, Deserialize)]
+pub struct DistributionHistograms {
+    pub priority: DistributionHistogram,
+    pub visibility_hours: DistributionHistogram,
+    pub requested_hours: DistributionHistogram,
+}
+
 /// Complete distribution dataset.
 #[derive(Debug, Clone, Serialize, Deserialize)]
 pub struct DistributionData {
+    /// Per-block rows; empty when the request asked for aggregates only.
     pub blocks: Vec<DistributionBlock>,
     pub priority_stats: DistributionStats,
     pub visibility_stats: DistributionStats,
@@ -37,6 +59,9 @@ pub struct DistributionData {
     pub scheduled_count: usize,
     pub unscheduled_count: usize,
     pub impossible_count: usize,
+    /// Present when the request asked for histogram `bins`.
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub histograms: Option<DistributionHistograms>,
 }
 
 /// Route function name constant for distribution data
@@ -137,6 +162,7 @@ mod tests {
             scheduled_count: 0,
             unscheduled_count: 0,
             impossible_count: 0,
+            histograms: None,
         };
         let debug_str = format!("{:?}", data);
         assert!(debug_str.contains("DistributionData"));
@@ -84,6 +84,7 @@ pub struct TopObservation {
 /// Complete insights dataset.
 #[derive(Debug, Clone, Serialize, Deserialize)]
 pub struct InsightsData {
+    /// Per-block rows; empty when the request asked for aggregates only.
     pub blocks: Vec<InsightsBlock>,
     pub metrics: AnalyticsMetrics,
     pub correlations: Vec<CorrelationEntry>,
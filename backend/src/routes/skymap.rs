@@ -37,6 +37,36 @@ pub struct SkyMapData {
     pub scheduled_count: usize,
     pub scheduled_time_min: Option<f64>,
     pub scheduled_time_max: Option<f64>,
+    /// Aggregated cells, present when the request asked for a `resolution`.
+    /// `blocks` then only holds the targets inside the requested viewport
+    /// (or none), while the counts and ranges above cover every target.
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub density: Option<SkyMapDensity>,
+}
+
+/// One HEALPix cell with at least one target.
+#[derive(Debug, Clone, Serialize, Deserialize)]
+pub struct SkyDensityCell {
+    /// RING-scheme pixel index.
+    pub pixel: u64,
+    /// Cell centre.
+    pub ra_deg: f64,
+    pub dec_deg: f64,
+    pub count: usize,
+    pub scheduled_count: usize,
+    pub mean_priority: f64,
+    pub max_priority: f64,
+}
+
+/// Level-of-detail view of a sky map: targets aggregated on a HEALPix grid.
+#[derive(Debug, Clone, Serialize, Deserialize)]
+pub struct SkyMapDensity {
+    /// HEALPix `nside`; the sphere is split into `12 * nside^2` equal-area cells.
+    pub nside: u32,
+    /// Approximate angular cell width (square root of the cell area).
+    pub cell_size_deg: f64,
+    /// Non-empty cells, ordered by pixel index.
+    pub cells: Vec<SkyDensityCell>,
 }
 
 /// Route function name constant
@@ -117,6 +147,7 @@ mod tests {
             scheduled_count: 0,
             scheduled_time_min: None,
             scheduled_time_max: None,
+            density: None,
         };
         let debug_str = format!("{:?}", data);
         assert!(debug_str.contains("SkyMapData"));
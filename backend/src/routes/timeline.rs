@@ -20,6 +20,41 @@ pub struct ScheduleTimelineBlock {
     pub num_visibility_periods: usize,
 }
 
+/// Number of priority colour bins used by [`TimelineLayout::color_index`].
+/// Priorities 0–10 map linearly onto bins `0..TIMELINE_COLOR_BINS`.
+pub const TIMELINE_COLOR_BINS: u8 = 16;
+
+/// Render-ready month-row layout of the scheduled blocks.
+///
+/// One entry per bar segment, stored as parallel columns. A block that
+/// spans a UTC month boundary is split into one segment per month it
+/// touches; every segment after the first is flagged as a continuation.
+/// `x0`/`x1` are fractional, 1-based days of the month, so a segment
+/// running to the end of a 31-day month ends at `32.0`.
+#[derive(Debug, Clone, Default, Serialize, Deserialize)]
+pub struct TimelineLayout {
+    /// Index into [`ScheduleTimelineData::blocks`].
+    pub block_index: Vec<u32>,
+    /// Index into [`ScheduleTimelineData::unique_months`].
+    pub row: Vec<u32>,
+    pub x0: Vec<f64>,
+    pub x1: Vec<f64>,
+    /// Priority colour bin, `0..TIMELINE_COLOR_BINS`.
+    pub color_index: Vec<u8>,
+    /// `true` when the segment continues a block from the previous month.
+    pub continuation: Vec<bool>,
+}
+
+impl TimelineLayout {
+    pub fn len(&self) -> usize {
+        self.block_index.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.block_index.is_empty()
+    }
+}
+
 /// Schedule timeline dataset.
 #[derive(Debug, Clone, Serialize, Deserialize)]
 pub struct ScheduleTimelineData {
@@ -28,8 +63,11 @@ pub struct ScheduleTimelineData {
     pub priority_max: f64,
     pub total_count: usize,
     pub scheduled_count: usize,
+    /// Sorted `YYYY-MM` labels of every month touched by a scheduled block.
     pub unique_months: Vec<String>,
     pub dark_periods: Vec<crate::api::Period>,
+    #[serde(default)]
+    pub layout: TimelineLayout,
 }
 
 /// Route function name constant for schedule timeline
@@ -87,6 +125,7 @@ mod tests {
             scheduled_count: 0,
             unique_months: vec![],
             dark_periods: vec![],
+            layout: TimelineLayout::default(),
         };
         let debug_str = format!("{:?}", data);
         assert!(debug_str.contains("ScheduleTimelineData"));
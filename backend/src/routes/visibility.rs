@@ -25,6 +25,83 @@ pub struct VisibilityMapData {
     pub scheduled_count: usize,
 }
 
+/// Sort key for the paginated visibility-map block table.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default, Serialize, Deserialize)]
+#[serde(rename_all = "snake_case")]
+pub enum VisibilityBlockSort {
+    #[default]
+    Priority,
+    NumVisibilityPeriods,
+    Scheduled,
+}
+
+impl VisibilityBlockSort {
+    /// Sort key of a block as a number (`scheduled` sorts as 0/1).
+    pub fn key(self, block: &VisibilityBlockSummary) -> f64 {
+        match self {
+            Self::Priority => block.priority,
+            Self::NumVisibilityPeriods => block.num_visibility_periods as f64,
+            Self::Scheduled => {
+                if block.scheduled {
+                    1.0
+                } else {
+                    0.0
+                }
+            }
+        }
+    }
+}
+
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default, Serialize, Deserialize)]
+#[serde(rename_all = "snake_case")]
+pub enum SortDirection {
+    Asc,
+    #[default]
+    Desc,
+}
+
+/// Keyset position: sort key and block id of the last row of a page.
+/// Rows are ordered by `(key, scheduling_block_id)` in the query direction.
+#[derive(Debug, Clone, Copy, PartialEq, Serialize, Deserialize)]
+pub struct VisibilityBlockCursor {
+    pub key: f64,
+    pub id: i64,
+}
+
+/// One page request for the visibility-map block table.
+#[derive(Debug, Clone, PartialEq, Default)]
+pub struct VisibilityBlocksQuery {
+    pub sort: VisibilityBlockSort,
+    pub direction: SortDirection,
+    /// Inclusive priority bounds.
+    pub priority_min: Option<f64>,
+    pub priority_max: Option<f64>,
+    pub scheduled: Option<bool>,
+    /// Case-insensitive substring of the original id or name, or an exact
+    /// scheduling block id.
+    pub search: Option<String>,
+    /// Resume after this row (keyset pagination).
+    pub after: Option<VisibilityBlockCursor>,
+    /// Matching rows to skip when there is no cursor (random access).
+    pub offset: usize,
+    pub limit: usize,
+}
+
+/// One page of visibility-map blocks.  `matched_count` counts every row
+/// matching the filters; the remaining summary fields cover the whole
+/// schedule, like [`VisibilityMapData`].
+#[derive(Debug, Clone, Serialize, Deserialize)]
+pub struct VisibilityBlocksPage {
+    pub blocks: Vec<VisibilityBlockSummary>,
+    pub matched_count: usize,
+    pub total_count: usize,
+    pub scheduled_count: usize,
+    pub priority_min: f64,
+    pub priority_max: f64,
+    /// Cursor for the following page; `None` on the last page.
+    pub next_cursor: Option<VisibilityBlockCursor>,
+}
+
 /// Route function name constant for visibility map
 pub const GET_VISIBILITY_MAP_DATA: &str = "get_visibility_map_data";
 /// Route function name constant for schedule time range
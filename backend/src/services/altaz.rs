@@ -1,14 +1,290 @@
-use qtty::{Degrees, Meters};
-use siderust::calculus::altitude::AltitudePeriodsProvider;
-use siderust::calculus::azimuth::AzimuthProvider;
-use siderust::coordinates::centers::Geodetic;
-use siderust::coordinates::frames::ECEF;
-use siderust::coordinates::spherical::direction;
-use siderust::time::ModifiedJulianDate;
+//! Altitude/azimuth curve computation for the AltAz page.
+//!
+//! Targets are fixed ICRS directions, so both horizontal coordinates of a
+//! target at a given instant follow from one rotation: precess the J2000
+//! direction to the mean equator of date, rotate by the local sidereal time
+//! and tilt onto the observer's horizon. Altitude and azimuth are then read
+//! off the same local vector instead of running two independent siderust
+//! transforms per sample.
+//!
+//! # Sampling kernel
+//!
+//! Every consumer that needs horizontal coordinates of fixed directions on a
+//! regular time grid (the AltAz page, visibility fallbacks, night searches)
+//! shares the same structure: the rotation depends only on the sample time,
+//! the direction only on the target. [`HorizontalGrid`] therefore computes
+//! the precession/LST rotation once per sample and stores its nine entries
+//! as structure-of-arrays columns; [`DirectionBatch`] stores target unit
+//! vectors the same way. [`sample_horizontal`] then evaluates each target
+//! against the whole grid with contiguous, auto-vectorisable dot products
+//! followed by a single `asin`/`atan2` pass, with targets split across rayon
+//! workers. Callers on the async runtime should run it on the blocking pool.
+//!
+//! The kernel models precession (IAU 1976) and mean sidereal time but not
+//! nutation, aberration or refraction. Against siderust's per-point
+//! `altitude_at` it stays within [`MAX_ALTITUDE_ERROR_DEG`].
 
-use crate::api::{AltAzCurve, AltAzData, AltAzRequest, ScheduleId};
+use rayon::prelude::*;
 
-const SAMPLE_INTERVAL_MINUTES: f64 = 10.0;
+use crate::api::{AltAzData, AltAzRequest, ScheduleId};
+
+/// Sampling cadence used when the request does not specify one.
+pub const DEFAULT_SAMPLE_INTERVAL_MINUTES: f64 = 10.0;
+
+/// Finest sampling cadence accepted from clients.
+pub const MIN_SAMPLE_INTERVAL_MINUTES: f64 = 1.0;
+
+/// Upper bound on `targets * samples` for a single request (≈ 200 targets
+/// over a month at one-minute cadence), keeping responses bounded.
+pub const MAX_TOTAL_SAMPLES: usize = 10_000_000;
+
+/// Approximate TT − UT1 in seconds. Request times are MJD on the TT axis
+/// (siderust convention) while sidereal time is driven by UT1. The observed
+/// value has stayed within ±2 s of this since 2015, i.e. < 0.01° in hour
+/// angle.
+const DELTA_T_SECONDS: f64 = 69.2;
+
+/// Documented accuracy bound of the kernel versus siderust's per-point
+/// `altitude_at` (degrees), dominated by the omitted nutation and
+/// aberration terms (≲ 40″) plus the ΔT approximation.
+pub const MAX_ALTITUDE_ERROR_DEG: f64 = 0.05;
+
+const MJD_J2000: f64 = 51_544.5;
+const DAYS_PER_JULIAN_CENTURY: f64 = 36_525.0;
+const ARCSEC_TO_RAD: f64 = std::f64::consts::PI / (180.0 * 3600.0);
+
+type Mat3 = [[f64; 3]; 3];
+
+/// Mean precession matrix from J2000 to the mean equator of date
+/// (IAU 1976, Lieske et al. 1977), for an epoch given as MJD(TT).
+fn precession_matrix(mjd_tt: f64) -> Mat3 {
+    let t = (mjd_tt - MJD_J2000) / DAYS_PER_JULIAN_CENTURY;
+    let t2 = t * t;
+    let t3 = t2 * t;
+    let zeta = (2306.2181 * t + 0.30188 * t2 + 0.017998 * t3) * ARCSEC_TO_RAD;
+    let z = (2306.2181 * t + 1.09468 * t2 + 0.018203 * t3) * ARCSEC_TO_RAD;
+    let theta = (2004.3109 * t - 0.42665 * t2 - 0.041833 * t3) * ARCSEC_TO_RAD;
+
+    let (sin_zeta, cos_zeta) = zeta.sin_cos();
+    let (sin_z, cos_z) = z.sin_cos();
+    let (sin_theta, cos_theta) = theta.sin_cos();
+
+    [
+        [
+            cos_zeta * cos_theta * cos_z - sin_zeta * sin_z,
+            -sin_zeta * cos_theta * cos_z - cos_zeta * sin_z,
+            -sin_theta * cos_z,
+        ],
+        [
+            cos_zeta * cos_theta * sin_z + sin_zeta * cos_z,
+            -sin_zeta * cos_theta * sin_z + cos_zeta * cos_z,
+            -sin_theta * sin_z,
+        ],
+        [cos_zeta * sin_theta, -sin_zeta * sin_theta, cos_theta],
+    ]
+}
+
+/// Greenwich mean sidereal time in radians (IAU 1982 expression) for an
+/// epoch given as MJD(TT).
+fn greenwich_mean_sidereal_time(mjd_tt: f64) -> f64 {
+    let d = mjd_tt - DELTA_T_SECONDS / 86_400.0 - MJD_J2000;
+    let t = d / DAYS_PER_JULIAN_CENTURY;
+    let gmst_deg =
+        280.460_618_37 + 360.985_647_366_29 * d + 0.000_387_933 * t * t - t * t * t / 38_710_000.0;
+    gmst_deg.rem_euclid(360.0).to_radians()
+}
+
+/// Rotation taking an ICRS unit vector to the observer's local
+/// (north, east, up) frame at `mjd_tt`.
+fn horizontal_rotation(lat_deg: f64, lon_deg: f64, mjd_tt: f64) -> Mat3 {
+    let precession = precession_matrix(mjd_tt);
+    let lst = greenwich_mean_sidereal_time(mjd_tt) + lon_deg.to_radians();
+    let (sin_lst, cos_lst) = lst.sin_cos();
+    let (sin_lat, cos_lat) = lat_deg.to_radians().sin_cos();
+
+    // Hour-angle frame: x towards the local meridian, y towards the west.
+    let mut hour_angle = [[0.0; 3]; 3];
+    for col in 0..3 {
+        let x = precession[0][col];
+        let y = precession[1][col];
+        hour_angle[0][col] = cos_lst * x + sin_lst * y;
+        hour_angle[1][col] = -sin_lst * x + cos_lst * y;
+        hour_angle[2][col] = precession[2][col];
+    }
+
+    let mut local = [[0.0; 3]; 3];
+    for col in 0..3 {
+        let x = hour_angle[0][col];
+        let z = hour_angle[2][col];
+        local[0][col] = -sin_lat * x + cos_lat * z;
+        local[1][col] = hour_angle[1][col];
+        local[2][col] = cos_lat * x + sin_lat * z;
+    }
+    local
+}
+
+/// Unit vector of an ICRS direction.
+fn icrs_unit_vector(ra_deg: f64, dec_deg: f64) -> [f64; 3] {
+    let (sin_ra, cos_ra) = ra_deg.to_radians().sin_cos();
+    let (sin_dec, cos_dec) = dec_deg.to_radians().sin_cos();
+    [cos_dec * cos_ra, cos_dec * sin_ra, sin_dec]
+}
+
+/// Altitude and azimuth (degrees, azimuth measured from north through
+/// east in `[0, 360)`) of a unit vector under a horizontal rotation.
+fn horizontal_from_rotation(rotation: &Mat3, v: &[f64; 3]) -> (f64, f64) {
+    let north = rotation[0][0] * v[0] + rotation[0][1] * v[1] + rotation[0][2] * v[2];
+    let east = rotation[1][0] * v[0] + rotation[1][1] * v[1] + rotation[1][2] * v[2];
+    let up = rotation[2][0] * v[0] + rotation[2][1] * v[1] + rotation[2][2] * v[2];
+    let altitude = up.clamp(-1.0, 1.0).asin().to_degrees();
+    let azimuth = east.atan2(north).to_degrees().rem_euclid(360.0);
+    (altitude, azimuth)
+}
+
+/// Altitude and azimuth (degrees) of a fixed ICRS direction seen from a
+/// geodetic site at `mjd_tt`, computed from a single horizontal transform.
+pub fn horizontal_at(
+    ra_deg: f64,
+    dec_deg: f64,
+    lat_deg: f64,
+    lon_deg: f64,
+    mjd_tt: f64,
+) -> (f64, f64) {
+    let rotation = horizontal_rotation(lat_deg, lon_deg, mjd_tt);
+    horizontal_from_rotation(&rotation, &icrs_unit_vector(ra_deg, dec_deg))
+}
+
+/// Horizontal rotations for a set of sample times and a fixed observer.
+///
+/// Entry `(row, col)` of the rotation at sample `s` is stored at
+/// `columns[row * 3 + col][s]`, so the kernel walks each column linearly.
+#[derive(Debug, Clone)]
+pub struct HorizontalGrid {
+    sample_times_mjd: Vec<f64>,
+    columns: [Vec<f64>; 9],
+}
+
+impl HorizontalGrid {
+    /// Precompute the rotations for `sample_times_mjd` (MJD, TT axis).
+    pub fn new(lat_deg: f64, lon_deg: f64, sample_times_mjd: Vec<f64>) -> Self {
+        let mut columns: [Vec<f64>; 9] =
+            std::array::from_fn(|_| Vec::with_capacity(sample_times_mjd.len()));
+        for &mjd in &sample_times_mjd {
+            let rotation = horizontal_rotation(lat_deg, lon_deg, mjd);
+            for (k, column) in columns.iter_mut().enumerate() {
+                column.push(rotation[k / 3][k % 3]);
+            }
+        }
+        Self {
+            sample_times_mjd,
+            columns,
+        }
+    }
+
+    /// Precompute `count` rotations starting at `start_mjd`, `step_days` apart.
+    pub fn regular(
+        lat_deg: f64,
+        lon_deg: f64,
+        start_mjd: f64,
+        step_days: f64,
+        count: usize,
+    ) -> Self {
+        let times = (0..count)
+            .map(|i| start_mjd + i as f64 * step_days)
+            .collect();
+        Self::new(lat_deg, lon_deg, times)
+    }
+
+    pub fn len(&self) -> usize {
+        self.sample_times_mjd.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.sample_times_mjd.is_empty()
+    }
+
+    pub fn sample_times_mjd(&self) -> &[f64] {
+        &self.sample_times_mjd
+    }
+
+    pub fn into_sample_times_mjd(self) -> Vec<f64> {
+        self.sample_times_mjd
+    }
+}
+
+/// Fixed ICRS directions stored as structure-of-arrays unit vectors.
+#[derive(Debug, Clone, Default)]
+pub struct DirectionBatch {
+    x: Vec<f64>,
+    y: Vec<f64>,
+    z: Vec<f64>,
+}
+
+impl DirectionBatch {
+    /// Build a batch from `(ra_deg, dec_deg)` pairs.
+    pub fn from_ra_dec<I>(directions: I) -> Self
+    where
+        I: IntoIterator<Item = (f64, f64)>,
+    {
+        let mut batch = Self::default();
+        for (ra_deg, dec_deg) in directions {
+            let [x, y, z] = icrs_unit_vector(ra_deg, dec_deg);
+            batch.x.push(x);
+            batch.y.push(y);
+            batch.z.push(z);
+        }
+        batch
+    }
+
+    pub fn len(&self) -> usize {
+        self.x.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.x.is_empty()
+    }
+}
+
+/// Evaluate every direction of `batch` at every sample of `grid`.
+///
+/// `altitudes_deg` and `azimuths_deg` are target-major matrices of
+/// `batch.len() * grid.len()` values (azimuth from north through east in
+/// `[0, 360)`). Targets are distributed across the rayon pool.
+pub fn sample_horizontal(
+    grid: &HorizontalGrid,
+    batch: &DirectionBatch,
+    altitudes_deg: &mut [f32],
+    azimuths_deg: &mut [f32],
+) {
+    let n = grid.len();
+    assert_eq!(altitudes_deg.len(), n * batch.len());
+    assert_eq!(azimuths_deg.len(), n * batch.len());
+    if n == 0 {
+        return;
+    }
+
+    let [m00, m01, m02, m10, m11, m12, m20, m21, m22] = &grid.columns;
+    let _rayon = crate::metrics::rayon_job();
+    altitudes_deg
+        .par_chunks_mut(n)
+        .zip(azimuths_deg.par_chunks_mut(n))
+        .enumerate()
+        .for_each_init(
+            || (vec![0.0_f64; n], vec![0.0_f64; n], vec![0.0_f64; n]),
+            |(north, east, up), (t, (altitudes, azimuths))| {
+                let (x, y, z) = (batch.x[t], batch.y[t], batch.z[t]);
+                for s in 0..n {
+                    north[s] = m00[s] * x + m01[s] * y + m02[s] * z;
+                    east[s] = m10[s] * x + m11[s] * y + m12[s] * z;
+                    up[s] = m20[s] * x + m21[s] * y + m22[s] * z;
+                }
+                for s in 0..n {
+                    altitudes[s] = up[s].clamp(-1.0, 1.0).asin().to_degrees() as f32;
+                    azimuths[s] = east[s].atan2(north[s]).to_degrees().rem_euclid(360.0) as f32;
+                }
+            },
+        );
+}
 
 pub fn compute_alt_az_data(
     schedule_id: ScheduleId,
@@ -18,53 +294,252 @@ pub fn compute_alt_az_data(
         return Err("end_mjd must be greater than start_mjd".to_string());
     }
 
-    let observer = Geodetic::<ECEF>::new(
-        Degrees::new(request.observatory.lon_deg),
-        Degrees::new(request.observatory.lat_deg),
-        Meters::new(request.observatory.height),
-    );
+    let sample_interval_minutes = request
+        .sample_interval_minutes
+        .unwrap_or(DEFAULT_SAMPLE_INTERVAL_MINUTES);
+    if !sample_interval_minutes.is_finite() || sample_interval_minutes < MIN_SAMPLE_INTERVAL_MINUTES
+    {
+        return Err(format!(
+            "sample_interval_minutes must be at least {}",
+            MIN_SAMPLE_INTERVAL_MINUTES
+        ));
+    }
 
     let duration_days = request.end_mjd - request.start_mjd;
-    let sample_count = ((duration_days * 24.0 * 60.0) / SAMPLE_INTERVAL_MINUTES)
+    let intervals = ((duration_days * 24.0 * 60.0) / sample_interval_minutes)
         .ceil()
         .max(1.0) as usize;
-    let step_days = duration_days / sample_count as f64;
-
-    let sample_times_mjd = (0..=sample_count)
-        .map(|i| request.start_mjd + i as f64 * step_days)
-        .collect::<Vec<_>>();
-
-    let curves = request
-        .targets
-        .iter()
-        .map(|target| {
-            let subject = direction::ICRS::new(
-                Degrees::new(target.target_ra_deg),
-                Degrees::new(target.target_dec_deg),
-            );
-
-            let mut altitudes_deg = Vec::with_capacity(sample_times_mjd.len());
-            let mut azimuths_deg = Vec::with_capacity(sample_times_mjd.len());
-
-            for mjd in &sample_times_mjd {
-                let mjd = ModifiedJulianDate::new(*mjd);
-                altitudes_deg.push(subject.altitude_at(&observer, mjd).value().to_degrees());
-                azimuths_deg.push(subject.azimuth_at(&observer, mjd).value().to_degrees());
-            }
+    let step_days = duration_days / intervals as f64;
+    let sample_count = intervals.saturating_add(1);
+    let target_count = request.targets.len();
 
-            AltAzCurve {
-                original_block_id: target.original_block_id.clone(),
-                block_name: target.block_name.clone(),
-                priority: target.priority,
-                altitudes_deg,
-                azimuths_deg,
-            }
-        })
-        .collect::<Vec<_>>();
+    if sample_count.saturating_mul(target_count) > MAX_TOTAL_SAMPLES {
+        return Err(format!(
+            "Request needs {} samples for {} targets; reduce the window, the target count \
+             or increase sample_interval_minutes (limit {} samples)",
+            sample_count, target_count, MAX_TOTAL_SAMPLES
+        ));
+    }
+
+    let grid = HorizontalGrid::regular(
+        request.observatory.lat_deg,
+        request.observatory.lon_deg,
+        request.start_mjd,
+        step_days,
+        sample_count,
+    );
+    let batch = DirectionBatch::from_ra_dec(
+        request
+            .targets
+            .iter()
+            .map(|t| (t.target_ra_deg, t.target_dec_deg)),
+    );
+
+    let mut altitudes_deg = vec![0.0_f32; sample_count * target_count];
+    let mut azimuths_deg = vec![0.0_f32; sample_count * target_count];
+    sample_horizontal(&grid, &batch, &mut altitudes_deg, &mut azimuths_deg);
 
     Ok(AltAzData {
         schedule_id: schedule_id.value(),
-        sample_times_mjd,
-        curves,
+        sample_interval_minutes,
+        sample_count,
+        target_count,
+        sample_times_mjd: grid.into_sample_times_mjd(),
+        original_block_ids: request
+            .targets
+            .iter()
+            .map(|t| t.original_block_id.clone())
+            .collect(),
+        block_names: request
+            .targets
+            .iter()
+            .map(|t| t.block_name.clone())
+            .collect(),
+        priorities: request.targets.iter().map(|t| t.priority).collect(),
+        altitudes_deg,
+        azimuths_deg,
     })
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::api::{AltAzObservatoryRequest, AltAzTargetRequest};
+    use qtty::{Degrees, Meters};
+    use siderust::calculus::altitude::AltitudePeriodsProvider;
+    use siderust::calculus::azimuth::AzimuthProvider;
+    use siderust::coordinates::centers::Geodetic;
+    use siderust::coordinates::frames::ECEF;
+    use siderust::coordinates::spherical::direction;
+    use siderust::time::ModifiedJulianDate;
+
+    fn target(id: &str, ra: f64, dec: f64) -> AltAzTargetRequest {
+        AltAzTargetRequest {
+            original_block_id: id.to_string(),
+            block_name: format!("{id}-name"),
+            priority: 5.0,
+            target_ra_deg: ra,
+            target_dec_deg: dec,
+        }
+    }
+
+    fn roque_request(targets: Vec<AltAzTargetRequest>) -> AltAzRequest {
+        AltAzRequest {
+            observatory: AltAzObservatoryRequest {
+                lon_deg: -17.8892,
+                lat_deg: 28.7624,
+                height: 2396.0,
+            },
+            start_mjd: 60694.0,
+            end_mjd: 60695.0,
+            targets,
+            sample_interval_minutes: None,
+        }
+    }
+
+    #[test]
+    fn test_columnar_layout() {
+        let request = roque_request(vec![target("a", 95.988, -52.696), target("b", 10.0, 40.0)]);
+        let data = compute_alt_az_data(ScheduleId::new(1), &request).unwrap();
+
+        assert_eq!(data.sample_count, 24 * 6 + 1);
+        assert_eq!(data.target_count, 2);
+        assert_eq!(data.sample_times_mjd.len(), data.sample_count);
+        assert_eq!(data.altitudes_deg.len(), 2 * data.sample_count);
+        assert_eq!(data.azimuths_deg.len(), 2 * data.sample_count);
+        assert_eq!(data.original_block_ids, vec!["a", "b"]);
+        assert!(data.azimuths_deg.iter().all(|az| (0.0..360.0).contains(az)));
+        assert!(data
+            .altitudes_deg
+            .iter()
+            .all(|alt| (-90.0..=90.0).contains(alt)));
+    }
+
+    #[test]
+    fn test_configurable_interval() {
+        let mut request = roque_request(vec![target("a", 10.0, 40.0)]);
+        request.sample_interval_minutes = Some(60.0);
+        let data = compute_alt_az_data(ScheduleId::new(1), &request).unwrap();
+        assert_eq!(data.sample_count, 25);
+        assert_eq!(data.sample_interval_minutes, 60.0);
+
+        request.sample_interval_minutes = Some(0.1);
+        assert!(compute_alt_az_data(ScheduleId::new(1), &request).is_err());
+    }
+
+    #[test]
+    fn test_rejects_inverted_window_and_oversized_requests() {
+        let mut request = roque_request(vec![target("a", 10.0, 40.0)]);
+        request.end_mjd = request.start_mjd;
+        assert!(compute_alt_az_data(ScheduleId::new(1), &request).is_err());
+
+        let mut request = roque_request(vec![target("a", 10.0, 40.0); 300]);
+        request.end_mjd = request.start_mjd + 365.0;
+        request.sample_interval_minutes = Some(1.0);
+        assert!(compute_alt_az_data(ScheduleId::new(1), &request).is_err());
+    }
+
+    #[test]
+    fn test_empty_target_list() {
+        let data = compute_alt_az_data(ScheduleId::new(1), &roque_request(Vec::new())).unwrap();
+        assert_eq!(data.target_count, 0);
+        assert!(data.altitudes_deg.is_empty());
+    }
+
+    #[test]
+    fn test_kernel_matches_scalar_transform() {
+        let directions = [
+            (95.988, -52.696),
+            (10.0, 40.0),
+            (279.23, 38.78),
+            (0.0, 89.9),
+        ];
+        let grid = HorizontalGrid::regular(28.7624, -17.8892, 60694.0, 1.0 / 96.0, 97);
+        let batch = DirectionBatch::from_ra_dec(directions);
+        let mut altitudes = vec![0.0_f32; grid.len() * batch.len()];
+        let mut azimuths = vec![0.0_f32; grid.len() * batch.len()];
+        sample_horizontal(&grid, &batch, &mut altitudes, &mut azimuths);
+
+        for (t, (ra, dec)) in directions.iter().enumerate() {
+            for (s, mjd) in grid.sample_times_mjd().iter().enumerate() {
+                let (alt, az) = horizontal_at(*ra, *dec, 28.7624, -17.8892, *mjd);
+                let k = t * grid.len() + s;
+                assert!((altitudes[k] as f64 - alt).abs() < 1e-4);
+                let diff = (azimuths[k] as f64 - az + 180.0).rem_euclid(360.0) - 180.0;
+                assert!(diff.abs() < 1e-3);
+            }
+        }
+    }
+
+    #[test]
+    fn test_kernel_within_bound_of_siderust_altitude() {
+        let observer = Geodetic::<ECEF>::new(
+            Degrees::new(-17.8892),
+            Degrees::new(28.7624),
+            Meters::new(2396.0),
+        );
+        // Sample a decade so the precession and ΔT terms are exercised.
+        let grid = HorizontalGrid::regular(28.7624, -17.8892, 58000.0, 37.3, 100);
+        let directions: Vec<(f64, f64)> = (0..12)
+            .map(|i| (i as f64 * 30.0 + 7.5, -75.0 + i as f64 * 14.0))
+            .collect();
+        let batch = DirectionBatch::from_ra_dec(directions.iter().copied());
+        let mut altitudes = vec![0.0_f32; grid.len() * batch.len()];
+        let mut azimuths = vec![0.0_f32; grid.len() * batch.len()];
+        sample_horizontal(&grid, &batch, &mut altitudes, &mut azimuths);
+
+        let mut worst = 0.0_f64;
+        for (t, (ra, dec)) in directions.iter().enumerate() {
+            let subject = direction::ICRS::new(Degrees::new(*ra), Degrees::new(*dec));
+            for (s, mjd) in grid.sample_times_mjd().iter().enumerate() {
+                let reference = subject
+                    .altitude_at(&observer, ModifiedJulianDate::new(*mjd))
+                    .value()
+                    .to_degrees();
+                worst = worst.max((altitudes[t * grid.len() + s] as f64 - reference).abs());
+            }
+        }
+        assert!(
+            worst < MAX_ALTITUDE_ERROR_DEG,
+            "kernel altitude error {worst}° exceeds bound"
+        );
+    }
+
+    #[test]
+    fn test_matches_siderust_per_point_transform() {
+        let observer = Geodetic::<ECEF>::new(
+            Degrees::new(-17.8892),
+            Degrees::new(28.7624),
+            Meters::new(2396.0),
+        );
+
+        for (ra, dec) in [(95.988, -52.696), (10.0, 40.0), (279.23, 38.78)] {
+            let subject = direction::ICRS::new(Degrees::new(ra), Degrees::new(dec));
+            for step in 0..24 {
+                let mjd = 60694.0 + step as f64 / 24.0;
+                let (alt, az) = horizontal_at(ra, dec, 28.7624, -17.8892, mjd);
+                let reference_alt = subject
+                    .altitude_at(&observer, ModifiedJulianDate::new(mjd))
+                    .value()
+                    .to_degrees();
+                assert!(
+                    (alt - reference_alt).abs() < MAX_ALTITUDE_ERROR_DEG,
+                    "altitude mismatch for ({ra}, {dec}) at {mjd}: {alt} vs {reference_alt}"
+                );
+
+                // Azimuth is ill-conditioned near the zenith.
+                if reference_alt < 80.0 {
+                    let reference_az = subject
+                        .azimuth_at(&observer, ModifiedJulianDate::new(mjd))
+                        .value()
+                        .to_degrees();
+                    let diff = (az - reference_az + 180.0).rem_euclid(360.0) - 180.0;
+                    assert!(
+                        diff.abs() * reference_alt.to_radians().cos() < MAX_ALTITUDE_ERROR_DEG,
+                        "azimuth mismatch for ({ra}, {dec}) at {mjd}: {az} vs {reference_az}"
+                    );
+                }
+            }
+        }
+    }
+}
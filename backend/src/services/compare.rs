@@ -6,6 +6,8 @@ use crate::api::{
     CompareData, CompareDiffBlock, CompareStats, RetimedBlockChange, SchedulingChange,
 };
 use crate::db::FullRepository;
+use crate::models::ScheduleColumns;
+use crate::services::stats::{median_in_place, SummaryStats};
 use std::collections::{HashMap, HashSet};
 
 /// Retimed-block tolerance: treat scheduled boundaries as unchanged if both
@@ -13,50 +15,24 @@ use std::collections::{HashMap, HashSet};
 const RETIMED_TOLERANCE_SECONDS: f64 = 1.0;
 const SECONDS_PER_DAY: f64 = 86_400.0;
 
-/// Compute statistics for a set of blocks.
+/// Compute statistics for a set of blocks in a single pass.
 pub(crate) fn compute_stats(blocks: &[CompareBlock]) -> CompareStats {
-    let scheduled_blocks: Vec<&CompareBlock> = blocks.iter().filter(|b| b.scheduled).collect();
-
-    let scheduled_count = scheduled_blocks.len();
-    let unscheduled_count = blocks.len() - scheduled_count;
-
-    if scheduled_blocks.is_empty() {
-        return CompareStats {
-            scheduled_count,
-            unscheduled_count,
-            total_priority: 0.0,
-            mean_priority: 0.0,
-            median_priority: 0.0,
-            total_hours: qtty::Hours::new(0.0),
-            gap_count: None,
-            gap_mean_hours: None,
-            gap_median_hours: None,
-        };
+    let mut priorities = SummaryStats::with_median(blocks.len());
+    let mut total_hours_f64 = 0.0;
+    for block in blocks.iter().filter(|b| b.scheduled) {
+        priorities.push(block.priority);
+        total_hours_f64 += block.requested_hours.value();
     }
 
-    let priorities: Vec<f64> = scheduled_blocks.iter().map(|b| b.priority).collect();
-    let total_priority: f64 = priorities.iter().sum();
-    let mean_priority = total_priority / scheduled_count as f64;
-
-    let mut sorted_priorities = priorities.clone();
-    sorted_priorities.sort_by(|a, b| a.partial_cmp(b).unwrap_or(std::cmp::Ordering::Equal));
-    let median_priority = if scheduled_count % 2 == 0 {
-        (sorted_priorities[scheduled_count / 2 - 1] + sorted_priorities[scheduled_count / 2]) / 2.0
-    } else {
-        sorted_priorities[scheduled_count / 2]
-    };
-
-    let total_hours_f64: f64 = scheduled_blocks
-        .iter()
-        .map(|b| b.requested_hours.value())
-        .sum();
+    let scheduled_count = priorities.count();
+    let unscheduled_count = blocks.len() - scheduled_count;
 
     CompareStats {
         scheduled_count,
         unscheduled_count,
-        total_priority,
-        mean_priority,
-        median_priority,
+        total_priority: priorities.sum(),
+        mean_priority: priorities.mean(),
+        median_priority: priorities.median().unwrap_or(0.0),
         total_hours: qtty::Hours::new(total_hours_f64),
         gap_count: None,
         gap_mean_hours: None,
@@ -375,19 +351,6 @@ fn lis_length(seq: &[usize]) -> usize {
     tails.len()
 }
 
-fn median_f64(vals: &mut [f64]) -> Option<f64> {
-    if vals.is_empty() {
-        return None;
-    }
-    vals.sort_by(|a, b| a.partial_cmp(b).unwrap_or(std::cmp::Ordering::Equal));
-    let n = vals.len();
-    if n % 2 == 0 {
-        Some((vals[n / 2 - 1] + vals[n / 2]) / 2.0)
-    } else {
-        Some(vals[n / 2])
-    }
-}
-
 fn std_dev(vals: &[f64], mean: f64) -> f64 {
     if vals.len() < 2 {
         return 0.0;
@@ -506,14 +469,14 @@ fn compute_advanced_compare(
 
     // Global shift median.
     let mut shifts: Vec<f64> = timed.iter().map(|t| t.shift_minutes).collect();
-    let global_shift_median = median_f64(&mut shifts).unwrap_or(0.0);
+    let global_shift_median = median_in_place(&mut shifts).unwrap_or(0.0);
 
     // Local shift MAD (median absolute deviation from global median).
     let mut deviations: Vec<f64> = timed
         .iter()
         .map(|t| (t.shift_minutes - global_shift_median).abs())
         .collect();
-    let local_shift_mad = median_f64(&mut deviations).unwrap_or(0.0);
+    let local_shift_mad = median_in_place(&mut deviations).unwrap_or(0.0);
 
     // Segmentation: scan by pos_a, keep block while pos_b stays strictly
     // increasing and |shift[i+1] - shift[i]| <= epsilon.
@@ -681,6 +644,28 @@ fn build_coherent_block(idx: usize, indices: &[usize], timed: &[TimedTask]) -> C
     }
 }
 
+/// Comparison rows of a schedule, read from its columns. Blocks without a
+/// database id are labelled by row, as the local repository does.
+pub fn compare_blocks(columns: &ScheduleColumns) -> Vec<CompareBlock> {
+    (0..columns.len())
+        .map(|row| {
+            let scheduled = columns.scheduled_periods[row];
+            CompareBlock {
+                scheduling_block_id: columns.block_ids[row]
+                    .map(|id| id.0.to_string())
+                    .unwrap_or_else(|| format!("local-{}", row + 1)),
+                original_block_id: columns.original_block_id(row).to_string(),
+                block_name: columns.block_name(row).to_string(),
+                priority: columns.priorities[row],
+                scheduled: scheduled.is_some(),
+                requested_hours: qtty::Hours::new(columns.requested_seconds[row] / 3600.0),
+                scheduled_start_mjd: scheduled.map(|p| p.start.value()),
+                scheduled_stop_mjd: scheduled.map(|p| p.end.value()),
+            }
+        })
+        .collect()
+}
+
 #[allow(clippy::too_many_arguments)]
 pub async fn get_compare_data(
     repo: &(dyn FullRepository + 'static),
@@ -692,17 +677,21 @@ pub async fn get_compare_data(
     min_block_size: Option<usize>,
     merge_epsilon_minutes: Option<f64>,
 ) -> Result<CompareData, String> {
-    let current_blocks = repo
-        .fetch_compare_blocks(current_schedule_id)
-        .await
+    // The four reads are independent; issue them together.
+    let (current, comparison, current_gaps, comparison_gaps) = tokio::join!(
+        repo.get_schedule_columns(current_schedule_id),
+        repo.get_schedule_columns(comparison_schedule_id),
+        repo.fetch_gap_metrics(current_schedule_id),
+        repo.fetch_gap_metrics(comparison_schedule_id),
+    );
+    let current_blocks = current
+        .map(|columns| compare_blocks(&columns))
         .map_err(|e| format!("Failed to fetch current schedule blocks: {}", e))?;
-    let comparison_blocks = repo
-        .fetch_compare_blocks(comparison_schedule_id)
-        .await
+    let comparison_blocks = comparison
+        .map(|columns| compare_blocks(&columns))
         .map_err(|e| format!("Failed to fetch comparison schedule blocks: {}", e))?;
-
-    let current_gap_metrics = repo.fetch_gap_metrics(current_schedule_id).await.ok();
-    let comparison_gap_metrics = repo.fetch_gap_metrics(comparison_schedule_id).await.ok();
+    let current_gap_metrics = current_gaps.ok();
+    let comparison_gap_metrics = comparison_gaps.ok();
 
     compute_compare_data_with_gaps(
         current_blocks,
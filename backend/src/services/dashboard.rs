@@ -0,0 +1,263 @@
+//! Schedule dashboard: the summary views of one schedule from a single load.
+//!
+//! The sky-map, distributions, insights, trends, fragmentation and KPI
+//! endpoints each ensure analytics and fetch overlapping rows on their own,
+//! so a page showing all of them pays for the same work several times.
+//! [`get_dashboard_data`] ensures analytics once, fetches the analytics
+//! rows, the schedule and its validation report concurrently, and derives
+//! every section from those in-memory rows in parallel on the blocking
+//! pool. Each section reports how long it took.
+//!
+//! Sections match their standalone endpoints, except that distributions
+//! and insights carry aggregates only (no per-block rows), as with
+//! `?blocks=false`.
+
+use std::time::Instant;
+
+use serde::{Deserialize, Serialize};
+
+use crate::api::{
+    DistributionBlock, DistributionData, FragmentationData, InsightsBlock, InsightsData,
+    LightweightBlock, ScheduleId, SkyMapData, TrendsData, ValidationReport,
+};
+use crate::db::{services as db_services, FullRepository};
+use crate::models::ScheduleColumns;
+use crate::services::schedule_kpis::{kpi_from_parts, ScheduleKpi};
+use crate::services::sky_map::{apply_sky_map_detail, compute_sky_map_data, SkyMapDetail};
+use crate::services::{distributions, fragmentation, insights, trends};
+
+/// Parameters of the parameterised sections, as on their own endpoints.
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub struct DashboardOptions {
+    pub sky_map: SkyMapDetail,
+    /// Distribution histogram bins; no histograms when `None`.
+    pub distribution_bins: Option<usize>,
+    pub trend_bins: usize,
+    pub trend_bandwidth: f64,
+    pub trend_points: usize,
+}
+
+impl Default for DashboardOptions {
+    /// The trends endpoint's defaults; no sky-map reduction or histograms.
+    fn default() -> Self {
+        Self {
+            sky_map: SkyMapDetail::default(),
+            distribution_bins: None,
+            trend_bins: 10,
+            trend_bandwidth: 0.5,
+            trend_points: 12,
+        }
+    }
+}
+
+/// Wall time spent on one part of the dashboard.
+#[derive(Debug, Clone, Serialize, Deserialize, PartialEq)]
+pub struct SectionTiming {
+    /// `load` for the shared fetch, otherwise the section's field name.
+    pub section: String,
+    pub duration_ms: f64,
+}
+
+/// Every summary view of a schedule, computed from one load.
+#[derive(Debug, Clone, Serialize, Deserialize)]
+pub struct ScheduleDashboard {
+    pub schedule_id: ScheduleId,
+    pub sky_map: SkyMapData,
+    pub distributions: DistributionData,
+    pub insights: InsightsData,
+    pub trends: TrendsData,
+    pub fragmentation: FragmentationData,
+    pub kpis: ScheduleKpi,
+    /// The shared load first, then each section.
+    pub timings: Vec<SectionTiming>,
+}
+
+/// Rows shared by every section.
+struct DashboardRows {
+    insights: Vec<InsightsBlock>,
+    sky_map: Vec<LightweightBlock>,
+    schedule: ScheduleColumns,
+    validation: ValidationReport,
+}
+
+fn timed<T>(section: &str, f: impl FnOnce() -> T) -> (T, SectionTiming) {
+    let started = Instant::now();
+    let value = f();
+    let timing = SectionTiming {
+        section: section.to_string(),
+        duration_ms: started.elapsed().as_secs_f64() * 1000.0,
+    };
+    (value, timing)
+}
+
+fn no_analytics(schedule_id: ScheduleId) -> String {
+    format!(
+        "No analytics data available for schedule_id={}. Run populate_schedule_analytics() first.",
+        schedule_id
+    )
+}
+
+/// Load the dashboard of `schedule_id`.
+pub async fn get_dashboard_data(
+    repo: &(dyn FullRepository + 'static),
+    schedule_id: ScheduleId,
+    options: DashboardOptions,
+) -> Result<ScheduleDashboard, String> {
+    let started = Instant::now();
+    db_services::ensure_analytics(repo, schedule_id)
+        .await
+        .map_err(|e| format!("Failed to ensure analytics: {}", e))?;
+
+    let (insight_rows, sky_map_rows, schedule, validation) = tokio::join!(
+        repo.fetch_analytics_blocks_for_insights(schedule_id),
+        repo.fetch_analytics_blocks_for_sky_map(schedule_id),
+        repo.get_schedule_columns(schedule_id),
+        repo.fetch_validation_results(schedule_id),
+    );
+    let schedule = schedule.map_err(|e| format!("Failed to load schedule: {}", e))?;
+    // Best-effort, as in the fragmentation and distributions services.
+    let validation = validation.unwrap_or_else(|_| ValidationReport {
+        schedule_id,
+        total_blocks: schedule.len(),
+        valid_blocks: 0,
+        impossible_blocks: vec![],
+        validation_errors: vec![],
+        validation_warnings: vec![],
+    });
+    let rows = DashboardRows {
+        insights: insight_rows.map_err(|e| format!("Failed to fetch insights blocks: {}", e))?,
+        sky_map: sky_map_rows.map_err(|e| format!("Failed to fetch analytics blocks: {}", e))?,
+        schedule,
+        validation,
+    };
+    let load = SectionTiming {
+        section: "load".to_string(),
+        duration_ms: started.elapsed().as_secs_f64() * 1000.0,
+    };
+
+    crate::metrics::spawn_blocking(move || compute_dashboard(schedule_id, rows, &options, load))
+        .await
+        .map_err(|e| format!("Task join error: {}", e))?
+}
+
+/// Derive every section from the shared rows, in parallel.
+fn compute_dashboard(
+    schedule_id: ScheduleId,
+    rows: DashboardRows,
+    options: &DashboardOptions,
+    load: SectionTiming,
+) -> Result<ScheduleDashboard, String> {
+    let DashboardRows {
+        insights: mut insight_rows,
+        sky_map: sky_map_rows,
+        schedule,
+        validation,
+    } = rows;
+    if insight_rows.is_empty() || sky_map_rows.is_empty() {
+        return Err(no_analytics(schedule_id));
+    }
+
+    // Trends keep zero-visibility blocks that have requested hours; every
+    // other section drops them.
+    let trend_rows = trends::trends_blocks(&insight_rows);
+    insight_rows.retain(|b| b.total_visibility_hours.value() > 0.0);
+    if insight_rows.is_empty() {
+        return Err(format!(
+            "No blocks with visibility data found for schedule_id={}.",
+            schedule_id
+        ));
+    }
+    let distribution_rows: Vec<DistributionBlock> = insight_rows
+        .iter()
+        .map(|b| DistributionBlock {
+            priority: b.priority,
+            total_visibility_hours: b.total_visibility_hours,
+            requested_hours: b.requested_hours,
+            elevation_range_deg: b.elevation_range_deg,
+            scheduled: b.scheduled,
+        })
+        .collect();
+    let impossible_count = validation.impossible_blocks.len();
+
+    let sky_map_section = || {
+        timed("sky_map", || {
+            compute_sky_map_data(sky_map_rows).map(|d| apply_sky_map_detail(d, &options.sky_map))
+        })
+    };
+    let distributions_section = || {
+        timed("distributions", || {
+            let mut data =
+                distributions::compute_distribution_data(distribution_rows, impossible_count)?;
+            if let Some(bins) = options.distribution_bins {
+                data.histograms = Some(distributions::compute_histograms(&data, bins));
+            }
+            data.blocks = Vec::new();
+            Ok::<_, String>(data)
+        })
+    };
+    let insights_section = || {
+        timed("insights", || {
+            let mut data = insights::compute_insights_data(insight_rows)?;
+            data.blocks = Vec::new();
+            Ok::<_, String>(data)
+        })
+    };
+    let trends_section = || {
+        timed("trends", || {
+            trends::compute_trends_data(
+                trend_rows,
+                options.trend_bins,
+                options.trend_bandwidth,
+                options.trend_points,
+            )
+        })
+    };
+    let fragmentation_section = || {
+        timed("fragmentation", || {
+            fragmentation::compute_fragmentation(&schedule, &validation)
+        })
+    };
+
+    let ((sky_map, distributions), ((insights, trends), fragmentation)) = rayon::join(
+        || rayon::join(sky_map_section, distributions_section),
+        || {
+            rayon::join(
+                || rayon::join(insights_section, trends_section),
+                fragmentation_section,
+            )
+        },
+    );
+
+    let (sky_map, sky_map_time) = sky_map;
+    let (distributions, distributions_time) = distributions;
+    let (insights, insights_time) = insights;
+    let (trends, trends_time) = trends;
+    let (fragmentation, fragmentation_time) = fragmentation;
+    let sky_map = sky_map?;
+    let distributions = distributions?;
+    let insights = insights?;
+    let trends = trends?;
+
+    let (kpis, kpis_time) = timed("kpis", || {
+        kpi_from_parts(schedule_id, &insights, &fragmentation)
+    });
+
+    Ok(ScheduleDashboard {
+        schedule_id,
+        sky_map,
+        distributions,
+        insights,
+        trends,
+        fragmentation,
+        kpis,
+        timings: vec![
+            load,
+            sky_map_time,
+            distributions_time,
+            insights_time,
+            trends_time,
+            fragmentation_time,
+            kpis_time,
+        ],
+    })
+}
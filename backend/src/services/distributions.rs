@@ -1,59 +1,83 @@
 #![allow(clippy::manual_is_multiple_of)]
 #![allow(clippy::redundant_closure)]
 
-use crate::api::{DistributionBlock, DistributionData, DistributionStats};
+use crate::api::{
+    DistributionBlock, DistributionData, DistributionHistogram, DistributionHistograms,
+    DistributionStats,
+};
 use crate::db::{services as db_services, FullRepository};
+use crate::services::stats::SummaryStats;
+
+/// Convert an accumulated series into its reported statistics (all zero
+/// when empty).
+fn distribution_stats(mut stats: SummaryStats) -> DistributionStats {
+    DistributionStats {
+        count: stats.count(),
+        mean: stats.mean(),
+        median: stats.median().unwrap_or(0.0),
+        std_dev: stats.std_dev(),
+        min: stats.min().unwrap_or(0.0),
+        max: stats.max().unwrap_or(0.0),
+        sum: stats.sum(),
+    }
+}
 
 /// Compute statistics for a set of values.
-/// This is a helper function that calculates mean, median, std dev, min, max, and sum.
+#[cfg(test)]
 fn compute_stats(values: &[f64]) -> DistributionStats {
-    if values.is_empty() {
-        return DistributionStats {
-            count: 0,
-            mean: 0.0,
-            median: 0.0,
-            std_dev: 0.0,
-            min: 0.0,
-            max: 0.0,
-            sum: 0.0,
-        };
-    }
+    let mut stats = SummaryStats::with_median(values.len());
+    values.iter().for_each(|v| stats.push(*v));
+    distribution_stats(stats)
+}
 
-    let count = values.len();
-    let sum: f64 = values.iter().sum();
-    let mean = sum / count as f64;
-
-    // Compute median
-    let mut sorted = values.to_vec();
-    sorted.sort_by(|a, b| a.partial_cmp(b).unwrap_or(std::cmp::Ordering::Equal));
-    let median = if count % 2 == 0 {
-        (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0
-    } else {
-        sorted[count / 2]
-    };
+/// Upper bound on histogram bins per column.
+pub const MAX_DISTRIBUTION_BINS: usize = 200;
 
-    // Compute standard deviation
-    let variance = values
-        .iter()
-        .map(|v| {
-            let diff = v - mean;
-            diff * diff
-        })
-        .sum::<f64>()
-        / count as f64;
-    let std_dev = variance.sqrt();
+/// Zero-based bin of `value` among `bins` equal-width bins over
+/// `[min, max]`, matching Postgres' `width_bucket` with `max` folded into
+/// the last bin so both backends return identical histograms.
+pub(crate) fn histogram_bin(value: f64, min: f64, max: f64, bins: usize) -> usize {
+    if max <= min {
+        return 0;
+    }
+    let bin = (bins as f64 * ((value - min) / (max - min))).floor();
+    (bin.max(0.0) as usize).min(bins - 1)
+}
 
-    let min = sorted.first().copied().unwrap_or(0.0);
-    let max = sorted.last().copied().unwrap_or(0.0);
+fn column_histogram(
+    blocks: &[DistributionBlock],
+    stats: &DistributionStats,
+    bins: usize,
+    value: impl Fn(&DistributionBlock) -> f64,
+) -> DistributionHistogram {
+    let mut histogram = DistributionHistogram {
+        min: stats.min,
+        max: stats.max,
+        scheduled: vec![0; bins],
+        unscheduled: vec![0; bins],
+    };
+    for block in blocks {
+        let bin = histogram_bin(value(block), stats.min, stats.max, bins);
+        if block.scheduled {
+            histogram.scheduled[bin] += 1;
+        } else {
+            histogram.unscheduled[bin] += 1;
+        }
+    }
+    histogram
+}
 
-    DistributionStats {
-        count,
-        mean,
-        median,
-        std_dev,
-        min,
-        max,
-        sum,
+/// Bin the charted columns of `data.blocks` over the ranges in its stats.
+pub fn compute_histograms(data: &DistributionData, bins: usize) -> DistributionHistograms {
+    let bins = bins.clamp(1, MAX_DISTRIBUTION_BINS);
+    DistributionHistograms {
+        priority: column_histogram(&data.blocks, &data.priority_stats, bins, |b| b.priority),
+        visibility_hours: column_histogram(&data.blocks, &data.visibility_stats, bins, |b| {
+            b.total_visibility_hours.value()
+        }),
+        requested_hours: column_histogram(&data.blocks, &data.requested_hours_stats, bins, |b| {
+            b.requested_hours.value()
+        }),
     }
 }
 
@@ -63,22 +87,23 @@ pub fn compute_distribution_data(
     blocks: Vec<DistributionBlock>,
     impossible_count: usize,
 ) -> Result<DistributionData, String> {
+    // Fill every series in one pass over the blocks.
     let total_count = blocks.len();
-    let scheduled_count = blocks.iter().filter(|b| b.scheduled).count();
+    let mut scheduled_count = 0;
+    let mut priorities = SummaryStats::with_median(total_count);
+    let mut visibility_hours = SummaryStats::with_median(total_count);
+    let mut requested_hours = SummaryStats::with_median(total_count);
+    for block in &blocks {
+        scheduled_count += usize::from(block.scheduled);
+        priorities.push(block.priority);
+        visibility_hours.push(block.total_visibility_hours.value());
+        requested_hours.push(block.requested_hours.value());
+    }
     let unscheduled_count = total_count - scheduled_count;
 
-    // Collect values for statistics (extract f64 from qtty types)
-    let priorities: Vec<f64> = blocks.iter().map(|b| b.priority).collect();
-    let visibility_hours: Vec<f64> = blocks
-        .iter()
-        .map(|b| b.total_visibility_hours.value())
-        .collect();
-    let requested_hours: Vec<f64> = blocks.iter().map(|b| b.requested_hours.value()).collect();
-
-    // Compute statistics
-    let priority_stats = compute_stats(&priorities);
-    let visibility_stats = compute_stats(&visibility_hours);
-    let requested_hours_stats = compute_stats(&requested_hours);
+    let priority_stats = distribution_stats(priorities);
+    let visibility_stats = distribution_stats(visibility_hours);
+    let requested_hours_stats = distribution_stats(requested_hours);
 
     Ok(DistributionData {
         blocks,
@@ -89,23 +114,58 @@ pub fn compute_distribution_data(
         scheduled_count,
         unscheduled_count,
         impossible_count,
+        histograms: None,
     })
 }
 
 /// Get complete distribution data with computed statistics using ETL analytics.
 ///
-/// This function retrieves blocks from the analytics.schedule_blocks_analytics table
-/// which contains pre-computed, denormalized data for optimal performance.
+/// With `bins`, each charted column is also returned as a histogram. With
+/// `include_blocks` false the per-block rows are dropped from the response,
+/// and repositories that aggregate server-side
+/// ([`fetch_distribution_summary`](crate::db::repository::AnalyticsRepository::fetch_distribution_summary))
+/// compute everything without shipping the rows at all.
 ///
 /// **Note**: Impossible blocks (zero visibility) are automatically excluded.
 pub async fn get_distribution_data(
     repo: &(dyn FullRepository + 'static),
     schedule_id: crate::api::ScheduleId,
+    bins: Option<usize>,
+    include_blocks: bool,
 ) -> Result<DistributionData, String> {
     db_services::ensure_analytics(repo, schedule_id)
         .await
         .map_err(|e| format!("Failed to ensure analytics: {}", e))?;
 
+    let bins = bins.map(|b| b.clamp(1, MAX_DISTRIBUTION_BINS));
+
+    // The validation report is independent of the summary; fetch both together.
+    let (validation, summary) = tokio::join!(repo.fetch_validation_results(schedule_id), async {
+        if include_blocks {
+            Ok(None)
+        } else {
+            repo.fetch_distribution_summary(schedule_id, bins).await
+        }
+    });
+
+    // Attempt to fetch validation report; if unavailable, assume zero impossible
+    let impossible_count = match validation {
+        Ok(report) => report.impossible_blocks.len(),
+        Err(_) => 0,
+    };
+
+    if !include_blocks {
+        let summary =
+            summary.map_err(|e| format!("Failed to aggregate analytics blocks: {}", e))?;
+        if let Some(mut summary) = summary {
+            if summary.total_count == 0 {
+                return Err(no_visible_blocks(schedule_id));
+            }
+            summary.impossible_count = impossible_count;
+            return Ok(summary);
+        }
+    }
+
     let mut blocks = repo
         .fetch_analytics_blocks_for_distribution(schedule_id)
         .await
@@ -121,20 +181,25 @@ pub async fn get_distribution_data(
     // Filter out impossible blocks (zero visibility)
     blocks.retain(|b| b.total_visibility_hours.value() > 0.0);
 
-    // Attempt to fetch validation report; if unavailable, assume zero impossible
-    let impossible_count = match repo.fetch_validation_results(schedule_id).await {
-        Ok(report) => report.impossible_blocks.len(),
-        Err(_) => 0,
-    };
-
     if blocks.is_empty() {
-        return Err(format!(
-            "No blocks with visibility data found for schedule_id={}. All blocks have zero visibility hours. This likely means visibility_periods data is missing from the schedule.",
-            schedule_id
-        ));
+        return Err(no_visible_blocks(schedule_id));
+    }
+
+    let mut data = compute_distribution_data(blocks, impossible_count)?;
+    if let Some(bins) = bins {
+        data.histograms = Some(compute_histograms(&data, bins));
     }
+    if !include_blocks {
+        data.blocks = Vec::new();
+    }
+    Ok(data)
+}
 
-    compute_distribution_data(blocks, impossible_count)
+fn no_visible_blocks(schedule_id: crate::api::ScheduleId) -> String {
+    format!(
+        "No blocks with visibility data found for schedule_id={}. All blocks have zero visibility hours. This likely means visibility_periods data is missing from the schedule.",
+        schedule_id
+    )
 }
 
 #[cfg(test)]
@@ -198,4 +263,39 @@ mod tests {
         assert_eq!(result.impossible_count, 1);
         assert_eq!(result.priority_stats.mean, 5.0);
     }
+
+    #[test]
+    fn test_histogram_bin_matches_width_bucket() {
+        assert_eq!(histogram_bin(0.0, 0.0, 10.0, 5), 0);
+        assert_eq!(histogram_bin(1.999, 0.0, 10.0, 5), 0);
+        assert_eq!(histogram_bin(2.0, 0.0, 10.0, 5), 1);
+        assert_eq!(histogram_bin(10.0, 0.0, 10.0, 5), 4);
+        assert_eq!(histogram_bin(3.0, 3.0, 3.0, 5), 0);
+    }
+
+    #[test]
+    fn test_compute_histograms() {
+        let block = |priority: f64, scheduled: bool| DistributionBlock {
+            priority,
+            total_visibility_hours: qtty::Hours::new(1.0),
+            requested_hours: qtty::Hours::new(1.0),
+            elevation_range_deg: qtty::Degrees::new(0.0),
+            scheduled,
+        };
+        let blocks = vec![
+            block(1.0, true),
+            block(2.0, false),
+            block(9.0, true),
+            block(10.0, false),
+        ];
+        let data = compute_distribution_data(blocks, 0).unwrap();
+        let histograms = compute_histograms(&data, 3);
+
+        assert_eq!(histograms.priority.min, 1.0);
+        assert_eq!(histograms.priority.max, 10.0);
+        assert_eq!(histograms.priority.scheduled, vec![1, 0, 1]);
+        assert_eq!(histograms.priority.unscheduled, vec![1, 0, 1]);
+        // Constant columns collapse into the first bin.
+        assert_eq!(histograms.visibility_hours.scheduled, vec![2, 0, 0]);
+    }
 }
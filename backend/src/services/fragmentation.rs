@@ -18,10 +18,11 @@ use std::collections::HashMap;
 
 use crate::api::{
     FragmentationData, FragmentationGap, FragmentationMetrics, FragmentationSegment,
-    FragmentationSegmentKind, ModifiedJulianDate, Period, ReasonBreakdownEntry, Schedule,
-    ScheduleId, UnscheduledReason, UnscheduledReasonSummary, ValidationIssue, ValidationReport,
+    FragmentationSegmentKind, ModifiedJulianDate, Period, ReasonBreakdownEntry, ScheduleId,
+    UnscheduledReason, UnscheduledReasonSummary, ValidationIssue, ValidationReport,
 };
 use crate::db::{services as db_services, FullRepository};
+use crate::models::ScheduleColumns;
 use qtty::time::Hours;
 
 // =========================================================================
@@ -38,24 +39,22 @@ pub async fn get_fragmentation_data(
         .await
         .map_err(|e| format!("Failed to ensure analytics: {}", e))?;
 
-    let schedule = repo
-        .get_schedule(schedule_id)
-        .await
-        .map_err(|e| format!("Failed to load schedule: {}", e))?;
+    let (schedule, validation) = tokio::join!(
+        repo.get_schedule_columns(schedule_id),
+        repo.fetch_validation_results(schedule_id),
+    );
+    let schedule = schedule.map_err(|e| format!("Failed to load schedule: {}", e))?;
 
     // Validation report is best-effort: empty on error (keeps endpoint robust
     // even if validation populate was skipped).
-    let validation = repo
-        .fetch_validation_results(schedule_id)
-        .await
-        .unwrap_or_else(|_| ValidationReport {
-            schedule_id,
-            total_blocks: schedule.blocks.len(),
-            valid_blocks: 0,
-            impossible_blocks: vec![],
-            validation_errors: vec![],
-            validation_warnings: vec![],
-        });
+    let validation = validation.unwrap_or_else(|_| ValidationReport {
+        schedule_id,
+        total_blocks: schedule.len(),
+        valid_blocks: 0,
+        impossible_blocks: vec![],
+        validation_errors: vec![],
+        validation_warnings: vec![],
+    });
 
     Ok(compute_fragmentation(&schedule, &validation))
 }
@@ -67,7 +66,7 @@ pub async fn get_fragmentation_data(
 /// Compute fragmentation data from an already-loaded schedule and validation
 /// report. This is the pure, deterministic core — all I/O lives in callers.
 pub fn compute_fragmentation(
-    schedule: &Schedule,
+    schedule: &ScheduleColumns,
     validation: &ValidationReport,
 ) -> FragmentationData {
     let schedule_window = schedule.schedule_period;
@@ -89,9 +88,10 @@ pub fn compute_fragmentation(
     let scheduled_union = clip_periods(
         &merge_periods(
             schedule
-                .blocks
+                .scheduled_periods
                 .iter()
-                .filter_map(|b| b.scheduled_period)
+                .flatten()
+                .copied()
                 .collect(),
         ),
         &schedule_window,
@@ -99,13 +99,7 @@ pub fn compute_fragmentation(
 
     // Fit-visibility union (stored visibility_periods — min-observation fits).
     let fit_visibility_union = clip_periods(
-        &merge_periods(
-            schedule
-                .blocks
-                .iter()
-                .flat_map(|b| b.visibility_periods.clone())
-                .collect(),
-        ),
+        &merge_periods(schedule.all_visibility().to_vec()),
         &schedule_window,
     );
 
@@ -138,11 +132,7 @@ pub fn compute_fragmentation(
     }
 
     let operable_hours_val: f64 = operable_periods.iter().map(duration_hours).sum();
-    let requested_hours_val: f64 = schedule
-        .blocks
-        .iter()
-        .map(|b| b.requested_duration.value() / 3600.0)
-        .sum();
+    let requested_hours_val: f64 = schedule.requested_seconds.iter().map(|s| s / 3600.0).sum();
     // Total scheduled hours = union of all scheduled block periods (clipped to
     // window). This matches the actual sum of scheduled time present in the
     // input JSON, independent of the operable baseline.
@@ -268,7 +258,7 @@ pub fn compute_fragmentation(
     };
 
     FragmentationData {
-        schedule_id: ScheduleId::new(schedule.id.unwrap_or(0)),
+        schedule_id: ScheduleId::new(schedule.schedule_id.unwrap_or(0)),
         schedule_name,
         schedule_window,
         operable_periods,
@@ -460,7 +450,7 @@ fn contains(periods: &[Period], t: f64) -> bool {
 // =========================================================================
 
 fn summarize_unscheduled_reasons(
-    schedule: &Schedule,
+    schedule: &ScheduleColumns,
     validation: &ValidationReport,
     fit_visibility_union: &[Period],
 ) -> Vec<UnscheduledReasonSummary> {
@@ -480,19 +470,17 @@ fn summarize_unscheduled_reasons(
             .push(issue);
     }
 
-    let mut buckets: HashMap<UnscheduledReason, Vec<(String, String)>> = HashMap::new();
+    // Rows of the unscheduled blocks in each bucket.
+    let mut buckets: HashMap<UnscheduledReason, Vec<usize>> = HashMap::new();
 
-    for block in &schedule.blocks {
-        if block.scheduled_period.is_some() {
+    for (row, scheduled) in schedule.scheduled_periods.iter().enumerate() {
+        if scheduled.is_some() {
             continue;
         }
-        let block_id = block.id.map(|i| i.value()).unwrap_or(-1);
+        let block_id = schedule.block_ids[row].map(|i| i.value()).unwrap_or(-1);
         let reason = classify_unscheduled_reason(block_id, &issues_by_block);
 
-        buckets
-            .entry(reason)
-            .or_default()
-            .push((block.original_block_id.clone(), block.block_name.clone()));
+        buckets.entry(reason).or_default().push(row);
     }
 
     // Deterministic output order (matches DTO documentation).
@@ -509,11 +497,15 @@ fn summarize_unscheduled_reasons(
         .map(|reason| {
             let entries = buckets.remove(reason).unwrap_or_default();
             let count = entries.len();
-            let example_block_ids = entries.iter().take(10).map(|(id, _)| id.clone()).collect();
+            let example_block_ids = entries
+                .iter()
+                .take(10)
+                .map(|&row| schedule.original_block_id(row).to_string())
+                .collect();
             let example_block_names = entries
                 .iter()
                 .take(10)
-                .map(|(_, name)| name.clone())
+                .map(|&row| schedule.block_name(row).to_string())
                 .collect();
             UnscheduledReasonSummary {
                 reason: *reason,
@@ -617,8 +609,8 @@ mod tests {
         dark: Vec<(f64, f64)>,
         nights: Vec<(f64, f64)>,
         blocks: Vec<SchedulingBlock>,
-    ) -> Schedule {
-        Schedule {
+    ) -> ScheduleColumns {
+        ScheduleColumns::from_schedule(&Schedule {
             id: Some(7),
             name: "t".into(),
             checksum: String::new(),
@@ -627,7 +619,7 @@ mod tests {
             geographic_location: empty_location(),
             astronomical_nights: nights.into_iter().map(|(s, e)| period(s, e)).collect(),
             blocks,
-        }
+        })
     }
 
     fn empty_validation() -> ValidationReport {
@@ -801,12 +793,7 @@ mod tests {
         // Total scheduled time in JSON = 0.25 + 0.5 = 0.75 day = 18h.
         let b1 = block(1, Some((0.0, 0.25)), vec![]);
         let b2 = block(2, Some((0.75, 1.25)), vec![]);
-        let sched = schedule_with(
-            (0.0, 1.5),
-            vec![(0.0, 1.0)],
-            vec![],
-            vec![b1, b2],
-        );
+        let sched = schedule_with((0.0, 1.5), vec![(0.0, 1.0)], vec![], vec![b1, b2]);
         let data = compute_fragmentation(&sched, &empty_validation());
 
         // scheduled_hours must mirror the union of scheduled periods clipped
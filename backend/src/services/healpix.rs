@@ -0,0 +1,136 @@
+//! Minimal HEALPix RING-scheme pixelisation.
+//!
+//! Only what the sky map level-of-detail view needs: mapping a position to
+//! its pixel and a pixel back to its centre.  Formulas follow Górski et al.
+//! (2005) and the reference `healpix_base` implementation.
+
+use std::f64::consts::{FRAC_PI_2, PI, TAU};
+
+/// Number of pixels on the sphere for a given `nside`.
+pub fn npix(nside: u32) -> u64 {
+    12 * nside as u64 * nside as u64
+}
+
+/// Approximate angular pixel width in degrees (square root of the pixel area).
+pub fn pixel_size_deg(nside: u32) -> f64 {
+    (4.0 * PI / npix(nside) as f64).sqrt().to_degrees()
+}
+
+/// RING pixel containing the equatorial position (`ra_deg`, `dec_deg`).
+pub fn ang2pix_ring(nside: u32, ra_deg: f64, dec_deg: f64) -> u64 {
+    let n = nside as i64;
+    let z = dec_deg.clamp(-90.0, 90.0).to_radians().sin();
+    let za = z.abs();
+    // tt ∈ [0, 4): longitude in units of 90°.
+    let tt = ra_deg.to_radians().rem_euclid(TAU) / FRAC_PI_2;
+
+    if za <= 2.0 / 3.0 {
+        // Equatorial belt.
+        let temp1 = n as f64 * (0.5 + tt);
+        let temp2 = n as f64 * z * 0.75;
+        let jp = (temp1 - temp2) as i64;
+        let jm = (temp1 + temp2) as i64;
+        let ir = n + 1 + jp - jm;
+        let kshift = 1 - (ir & 1);
+        let ip = ((jp + jm - n + kshift + 1) / 2).rem_euclid(4 * n);
+        let ncap = 2 * n * (n - 1);
+        (ncap + (ir - 1) * 4 * n + ip) as u64
+    } else {
+        // Polar caps.
+        let tp = tt - tt.floor();
+        let tmp = n as f64 * (3.0 * (1.0 - za)).sqrt();
+        let jp = (tp * tmp) as i64;
+        let jm = ((1.0 - tp) * tmp) as i64;
+        let ir = jp + jm + 1;
+        let ip = ((tt * ir as f64) as i64).rem_euclid(4 * ir);
+        if z > 0.0 {
+            (2 * ir * (ir - 1) + ip) as u64
+        } else {
+            (npix(nside) as i64 - 2 * ir * (ir + 1) + ip) as u64
+        }
+    }
+}
+
+/// Centre of a RING pixel as (`ra_deg`, `dec_deg`).
+pub fn pix2ang_ring(nside: u32, pixel: u64) -> (f64, f64) {
+    let n = nside as i64;
+    let npix = npix(nside) as i64;
+    let ncap = 2 * n * (n - 1);
+    let pix = pixel as i64;
+    let fact2 = 4.0 / npix as f64;
+
+    let (z, phi) = if pix < ncap {
+        let iring = (1 + isqrt(1 + 2 * pix)) >> 1;
+        let iphi = pix + 1 - 2 * iring * (iring - 1);
+        let z = 1.0 - (iring * iring) as f64 * fact2;
+        (z, (iphi as f64 - 0.5) * FRAC_PI_2 / iring as f64)
+    } else if pix < npix - ncap {
+        let ip = pix - ncap;
+        let iring = ip / (4 * n) + n;
+        let iphi = ip % (4 * n) + 1;
+        let fodd = if (iring + n) & 1 == 1 { 1.0 } else { 0.5 };
+        let z = (2 * n - iring) as f64 * 2.0 / (3.0 * n as f64);
+        (z, (iphi as f64 - fodd) * FRAC_PI_2 / n as f64)
+    } else {
+        let ip = npix - pix;
+        let iring = (1 + isqrt(2 * ip - 1)) >> 1;
+        let iphi = 4 * iring + 1 - (ip - 2 * iring * (iring - 1));
+        let z = -1.0 + (iring * iring) as f64 * fact2;
+        (z, (iphi as f64 - 0.5) * FRAC_PI_2 / iring as f64)
+    };
+
+    (phi.to_degrees(), z.clamp(-1.0, 1.0).asin().to_degrees())
+}
+
+fn isqrt(v: i64) -> i64 {
+    let mut r = (v as f64).sqrt() as i64;
+    while r * r > v {
+        r -= 1;
+    }
+    while (r + 1) * (r + 1) <= v {
+        r += 1;
+    }
+    r
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_pixel_centres_round_trip() {
+        for nside in [1, 2, 3, 4, 8, 16] {
+            for pixel in 0..npix(nside) {
+                let (ra, dec) = pix2ang_ring(nside, pixel);
+                assert!(
+                    (0.0..360.0).contains(&ra),
+                    "nside={nside} pixel={pixel} ra={ra}"
+                );
+                assert_eq!(ang2pix_ring(nside, ra, dec), pixel, "nside={nside}");
+            }
+        }
+    }
+
+    #[test]
+    fn test_known_pixels() {
+        // nside=1: four north-cap pixels, four equatorial, four south-cap.
+        assert_eq!(ang2pix_ring(1, 45.0, 60.0), 0);
+        assert_eq!(ang2pix_ring(1, 0.0, 0.0), 4);
+        assert_eq!(ang2pix_ring(1, 315.0, -60.0), 11);
+        assert_eq!(ang2pix_ring(4, 0.0, 90.0), 0);
+        assert_eq!(ang2pix_ring(4, 0.0, -90.0), npix(4) - 4);
+    }
+
+    #[test]
+    fn test_wraps_right_ascension() {
+        assert_eq!(ang2pix_ring(8, -10.0, 5.0), ang2pix_ring(8, 350.0, 5.0));
+        assert_eq!(ang2pix_ring(8, 360.0, 5.0), ang2pix_ring(8, 0.0, 5.0));
+    }
+
+    #[test]
+    fn test_pixel_size() {
+        // 12 pixels cover 41 253 deg²: ~58.6° on a side.
+        assert!((pixel_size_deg(1) - 58.63).abs() < 0.01);
+        assert!((pixel_size_deg(64) - 58.63 / 64.0).abs() < 0.01);
+    }
+}
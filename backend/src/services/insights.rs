@@ -7,13 +7,31 @@ use crate::db::models::{
 };
 
 use crate::db::{services as db_services, FullRepository};
+use crate::services::stats::SummaryStats;
 use qtty::time::Hours;
+use rayon::prelude::*;
 
-/// Compute analytics metrics from insights blocks.
+/// Compute analytics metrics from insights blocks in a single pass.
 pub(crate) fn compute_metrics(blocks: &[InsightsBlock]) -> AnalyticsMetrics {
+    let mut priorities = SummaryStats::with_median(blocks.len());
+    let mut scheduled_priorities = SummaryStats::new();
+    let mut unscheduled_priorities = SummaryStats::new();
+    let mut visibility_hours = SummaryStats::new();
+    let mut requested_hours = SummaryStats::new();
+    for block in blocks {
+        priorities.push(block.priority);
+        if block.scheduled {
+            scheduled_priorities.push(block.priority);
+        } else {
+            unscheduled_priorities.push(block.priority);
+        }
+        visibility_hours.push(block.total_visibility_hours.value());
+        requested_hours.push(block.requested_hours.value());
+    }
+
     let total_observations = blocks.len();
-    let scheduled_count = blocks.iter().filter(|b| b.scheduled).count();
-    let unscheduled_count = total_observations - scheduled_count;
+    let scheduled_count = scheduled_priorities.count();
+    let unscheduled_count = unscheduled_priorities.count();
 
     let scheduling_rate = if total_observations > 0 {
         scheduled_count as f64 / total_observations as f64
@@ -21,58 +39,17 @@ pub(crate) fn compute_metrics(blocks: &[InsightsBlock]) -> AnalyticsMetrics {
         0.0
     };
 
-    // Collect priorities for stats
-    let priorities: Vec<f64> = blocks.iter().map(|b| b.priority).collect();
-    let mean_priority = if !priorities.is_empty() {
-        priorities.iter().sum::<f64>() / priorities.len() as f64
-    } else {
-        0.0
-    };
-
-    // Compute median priority
-    let mut sorted_priorities = priorities.clone();
-    sorted_priorities.sort_by(|a, b| a.partial_cmp(b).unwrap_or(std::cmp::Ordering::Equal));
-    let median_priority = if !sorted_priorities.is_empty() {
-        if sorted_priorities.len() % 2 == 0 {
-            (sorted_priorities[sorted_priorities.len() / 2 - 1]
-                + sorted_priorities[sorted_priorities.len() / 2])
-                / 2.0
-        } else {
-            sorted_priorities[sorted_priorities.len() / 2]
-        }
-    } else {
-        0.0
-    };
-
-    // Scheduled and unscheduled priorities
-    let scheduled_priorities: Vec<f64> = blocks
-        .iter()
-        .filter(|b| b.scheduled)
-        .map(|b| b.priority)
-        .collect();
-    let mean_priority_scheduled = if !scheduled_priorities.is_empty() {
-        scheduled_priorities.iter().sum::<f64>() / scheduled_priorities.len() as f64
-    } else {
-        0.0
-    };
-
-    let unscheduled_priorities: Vec<f64> = blocks
-        .iter()
-        .filter(|b| !b.scheduled)
-        .map(|b| b.priority)
-        .collect();
-    let mean_priority_unscheduled = if !unscheduled_priorities.is_empty() {
-        unscheduled_priorities.iter().sum::<f64>() / unscheduled_priorities.len() as f64
-    } else {
-        0.0
-    };
+    let mean_priority = priorities.mean();
+    let median_priority = priorities.median().unwrap_or(0.0);
+    let mean_priority_scheduled = scheduled_priorities.mean();
+    let mean_priority_unscheduled = unscheduled_priorities.mean();
 
     // Priority-capture ratio: what fraction of the total priority "mass"
     // ended up scheduled. Insensitive to whether the algorithm also picks up
     // extra low-priority work (which would drag `mean_priority_scheduled`
     // down despite being a strict improvement).
-    let sum_priority_total: f64 = priorities.iter().sum();
-    let sum_priority_scheduled: f64 = scheduled_priorities.iter().sum();
+    let sum_priority_total = priorities.sum();
+    let sum_priority_scheduled = scheduled_priorities.sum();
     let priority_capture_ratio = if sum_priority_total > 0.0 {
         sum_priority_scheduled / sum_priority_total
     } else {
@@ -80,16 +57,8 @@ pub(crate) fn compute_metrics(blocks: &[InsightsBlock]) -> AnalyticsMetrics {
     };
 
     // Total visibility and requested hours (work with raw f64 values, then wrap as Hours)
-    let total_visibility_hours_f64: f64 = blocks
-        .iter()
-        .map(|b| b.total_visibility_hours.value())
-        .sum();
-    let requested_hours_vec: Vec<f64> = blocks.iter().map(|b| b.requested_hours.value()).collect();
-    let mean_requested_hours_f64 = if !requested_hours_vec.is_empty() {
-        requested_hours_vec.iter().sum::<f64>() / requested_hours_vec.len() as f64
-    } else {
-        0.0
-    };
+    let total_visibility_hours_f64 = visibility_hours.sum();
+    let mean_requested_hours_f64 = requested_hours.mean();
 
     AnalyticsMetrics {
         total_observations,
@@ -108,93 +77,123 @@ pub(crate) fn compute_metrics(blocks: &[InsightsBlock]) -> AnalyticsMetrics {
     }
 }
 
-/// Compute Spearman rank correlation between two variables.
-/// Uses a simple implementation of Spearman's rank correlation coefficient.
-pub(crate) fn compute_spearman_correlation(x: &[f64], y: &[f64]) -> f64 {
-    if x.len() != y.len() || x.is_empty() {
-        return 0.0;
+/// Analytics columns entering the correlation matrix, in output order.
+/// Each column is ranked once, so adding one costs a sort plus one dot
+/// product per existing column. Repositories that correlate server-side
+/// follow the same names and order.
+pub(crate) const CORRELATION_COLUMNS: &[(&str, fn(&InsightsBlock) -> f64)] = &[
+    ("priority", |b| b.priority),
+    ("total_visibility_hours", |b| {
+        b.total_visibility_hours.value()
+    }),
+    ("requested_hours", |b| b.requested_hours.value()),
+    ("elevation_range_deg", |b| b.elevation_range_deg.value()),
+];
+
+/// 1-based ranks of `values`, with tied values sharing the mean of the
+/// ranks they span.
+pub(crate) fn average_ranks(values: &[f64]) -> Vec<f64> {
+    let mut order: Vec<usize> = (0..values.len()).collect();
+    order.sort_unstable_by(|&a, &b| {
+        values[a]
+            .partial_cmp(&values[b])
+            .unwrap_or(std::cmp::Ordering::Equal)
+    });
+
+    let mut ranks = vec![0.0; values.len()];
+    let mut start = 0;
+    while start < order.len() {
+        let mut end = start + 1;
+        while end < order.len() && values[order[end]] == values[order[start]] {
+            end += 1;
+        }
+        // Positions start..end hold ranks start+1..=end.
+        let rank = (start + end + 1) as f64 / 2.0;
+        for &idx in &order[start..end] {
+            ranks[idx] = rank;
+        }
+        start = end;
     }
+    ranks
+}
 
-    let n = x.len();
+/// Ranks centred on their mean, with their Euclidean norm, so the Spearman
+/// coefficient of two columns is a single dot product.
+struct RankedColumn {
+    centred: Vec<f64>,
+    norm: f64,
+}
 
-    // Create ranks for x
-    let mut x_indexed: Vec<(usize, f64)> = x.iter().copied().enumerate().collect();
-    x_indexed.sort_by(|a, b| a.1.partial_cmp(&b.1).unwrap_or(std::cmp::Ordering::Equal));
-    let mut x_ranks = vec![0.0; n];
-    for (rank, (idx, _)) in x_indexed.iter().enumerate() {
-        x_ranks[*idx] = (rank + 1) as f64;
+impl RankedColumn {
+    fn new(values: &[f64]) -> Self {
+        let mut centred = average_ranks(values);
+        // Average ranks always sum to n(n+1)/2, ties included.
+        let mean = (values.len() + 1) as f64 / 2.0;
+        centred.iter_mut().for_each(|r| *r -= mean);
+        let norm = dot(&centred, &centred).sqrt();
+        Self { centred, norm }
     }
 
-    // Create ranks for y
-    let mut y_indexed: Vec<(usize, f64)> = y.iter().copied().enumerate().collect();
-    y_indexed.sort_by(|a, b| a.1.partial_cmp(&b.1).unwrap_or(std::cmp::Ordering::Equal));
-    let mut y_ranks = vec![0.0; n];
-    for (rank, (idx, _)) in y_indexed.iter().enumerate() {
-        y_ranks[*idx] = (rank + 1) as f64;
+    fn correlation(&self, other: &RankedColumn) -> f64 {
+        let denominator = self.norm * other.norm;
+        if denominator == 0.0 {
+            0.0
+        } else {
+            (dot(&self.centred, &other.centred) / denominator).clamp(-1.0, 1.0)
+        }
     }
+}
 
-    // Compute Pearson correlation on ranks
-    let mean_x = x_ranks.iter().sum::<f64>() / n as f64;
-    let mean_y = y_ranks.iter().sum::<f64>() / n as f64;
-
-    let mut numerator = 0.0;
-    let mut sum_sq_x = 0.0;
-    let mut sum_sq_y = 0.0;
-
-    for i in 0..n {
-        let dx = x_ranks[i] - mean_x;
-        let dy = y_ranks[i] - mean_y;
-        numerator += dx * dy;
-        sum_sq_x += dx * dx;
-        sum_sq_y += dy * dy;
+/// Dot product over four independent accumulators, which lets the
+/// compiler keep the loop in SIMD registers.
+fn dot(a: &[f64], b: &[f64]) -> f64 {
+    let mut acc = [0.0; 4];
+    let (a_chunks, b_chunks) = (a.chunks_exact(4), b.chunks_exact(4));
+    let tail: f64 = a_chunks
+        .remainder()
+        .iter()
+        .zip(b_chunks.remainder())
+        .map(|(x, y)| x * y)
+        .sum();
+    for (x, y) in a_chunks.zip(b_chunks) {
+        for ((acc, x), y) in acc.iter_mut().zip(x).zip(y) {
+            *acc += x * y;
+        }
     }
+    acc.iter().sum::<f64>() + tail
+}
 
-    let denominator = (sum_sq_x * sum_sq_y).sqrt();
-    if denominator == 0.0 {
-        0.0
-    } else {
-        numerator / denominator
+/// Compute Spearman rank correlation between two variables, ranking ties
+/// by their average rank.
+pub(crate) fn compute_spearman_correlation(x: &[f64], y: &[f64]) -> f64 {
+    if x.len() != y.len() || x.is_empty() {
+        return 0.0;
     }
+    RankedColumn::new(x).correlation(&RankedColumn::new(y))
 }
 
-/// Compute correlations between key variables.
+/// Compute Spearman correlations between every pair of
+/// [`CORRELATION_COLUMNS`]. Columns are ranked once each, in parallel.
 pub(crate) fn compute_correlations(blocks: &[InsightsBlock]) -> Vec<CorrelationEntry> {
     if blocks.len() < 2 {
         return vec![];
     }
 
-    // Extract variables (use primitive values for statistical routines)
-    let priorities: Vec<f64> = blocks.iter().map(|b| b.priority).collect();
-    let visibility: Vec<f64> = blocks
-        .iter()
-        .map(|b| b.total_visibility_hours.value())
-        .collect();
-    let requested: Vec<f64> = blocks.iter().map(|b| b.requested_hours.value()).collect();
-    let elevation: Vec<f64> = blocks
-        .iter()
-        .map(|b| b.elevation_range_deg.value())
+    let columns: Vec<RankedColumn> = CORRELATION_COLUMNS
+        .par_iter()
+        .map(|(_, value)| {
+            let values: Vec<f64> = blocks.iter().map(value).collect();
+            RankedColumn::new(&values)
+        })
         .collect();
 
-    let variables = vec![
-        ("priority", &priorities[..]),
-        ("total_visibility_hours", &visibility[..]),
-        ("requested_hours", &requested[..]),
-        ("elevation_range_deg", &elevation[..]),
-    ];
-
     let mut correlations = Vec::new();
-
-    // Compute all pairwise correlations
-    for i in 0..variables.len() {
-        for j in (i + 1)..variables.len() {
-            let (name1, data1) = variables[i];
-            let (name2, data2) = variables[j];
-
-            let corr = compute_spearman_correlation(data1, data2);
+    for i in 0..columns.len() {
+        for j in (i + 1)..columns.len() {
             correlations.push(CorrelationEntry {
-                variable1: name1.to_string(),
-                variable2: name2.to_string(),
-                correlation: corr,
+                variable1: CORRELATION_COLUMNS[i].0.to_string(),
+                variable2: CORRELATION_COLUMNS[j].0.to_string(),
+                correlation: columns[i].correlation(&columns[j]),
             });
         }
     }
@@ -292,6 +291,9 @@ fn find_conflicts(blocks: &[InsightsBlock]) -> Vec<ConflictRecord> {
     conflicts
 }
 
+/// Length of the top-priority and top-visibility lists.
+pub const TOP_OBSERVATIONS: usize = 10;
+
 /// Compute insights data with all analytics from raw blocks.
 pub fn compute_insights_data(blocks: Vec<InsightsBlock>) -> Result<InsightsData, String> {
     let total_count = blocks.len();
@@ -304,8 +306,8 @@ pub fn compute_insights_data(blocks: Vec<InsightsBlock>) -> Result<InsightsData,
     // Compute all analytics
     let metrics = compute_metrics(&blocks);
     let correlations = compute_correlations(&blocks);
-    let top_priority = get_top_observations(&blocks, "priority", 10);
-    let top_visibility = get_top_observations(&blocks, "total_visibility_hours", 10);
+    let top_priority = get_top_observations(&blocks, "priority", TOP_OBSERVATIONS);
+    let top_visibility = get_top_observations(&blocks, "total_visibility_hours", TOP_OBSERVATIONS);
     let conflicts = find_conflicts(&blocks);
 
     Ok(InsightsData {
@@ -324,16 +326,35 @@ pub fn compute_insights_data(blocks: Vec<InsightsBlock>) -> Result<InsightsData,
 /// Get complete insights data with computed analytics.
 /// Uses pre-computed analytics table when available for ~10-100x faster performance.
 ///
+/// With `include_blocks` false the per-block rows are dropped from the
+/// response, and repositories that aggregate server-side
+/// ([`fetch_insights_summary`](crate::db::repository::AnalyticsRepository::fetch_insights_summary))
+/// compute everything without shipping the rows at all.
+///
 /// **Note**: Impossible blocks (zero visibility) are automatically excluded during ETL.
 /// Validation results are stored separately and can be retrieved via py_get_validation_report.
 pub async fn get_insights_data(
     repo: &(dyn FullRepository + 'static),
     schedule_id: crate::api::ScheduleId,
+    include_blocks: bool,
 ) -> Result<InsightsData, String> {
     db_services::ensure_analytics(repo, schedule_id)
         .await
         .map_err(|e| format!("Failed to ensure analytics: {}", e))?;
 
+    if !include_blocks {
+        let summary = repo
+            .fetch_insights_summary(schedule_id, TOP_OBSERVATIONS)
+            .await
+            .map_err(|e| format!("Failed to aggregate insights blocks: {}", e))?;
+        if let Some(summary) = summary {
+            if summary.total_count == 0 {
+                return Err(no_visible_blocks(schedule_id));
+            }
+            return Ok(summary);
+        }
+    }
+
     // Fetch insights-ready analytics blocks
     let mut blocks = repo
         .fetch_analytics_blocks_for_insights(schedule_id)
@@ -352,18 +373,28 @@ pub async fn get_insights_data(
     blocks.retain(|b| b.total_visibility_hours.value() > 0.0);
 
     if blocks.is_empty() {
-        return Err(format!(
-            "No blocks with visibility data found for schedule_id={}. All blocks have zero visibility hours. This likely means visibility_periods data is missing from the schedule.",
-            schedule_id
-        ));
+        return Err(no_visible_blocks(schedule_id));
     }
 
-    compute_insights_data(blocks)
+    let mut data = compute_insights_data(blocks)?;
+    if !include_blocks {
+        data.blocks = Vec::new();
+    }
+    Ok(data)
+}
+
+fn no_visible_blocks(schedule_id: crate::api::ScheduleId) -> String {
+    format!(
+        "No blocks with visibility data found for schedule_id={}. All blocks have zero visibility hours. This likely means visibility_periods data is missing from the schedule.",
+        schedule_id
+    )
 }
 
 #[cfg(test)]
 mod tests {
-    use super::{compute_correlations, compute_metrics, compute_spearman_correlation};
+    use super::{
+        average_ranks, compute_correlations, compute_metrics, compute_spearman_correlation,
+    };
     use crate::api::InsightsBlock;
 
     fn create_test_block(
@@ -513,6 +544,23 @@ mod tests {
         assert!((-1.0..=1.0).contains(&corr));
     }
 
+    #[test]
+    fn test_average_ranks_share_ties() {
+        let ranks = average_ranks(&[10.0, 20.0, 10.0, 30.0, 20.0, 10.0]);
+        assert_eq!(ranks, vec![2.0, 4.5, 2.0, 6.0, 4.5, 2.0]);
+    }
+
+    #[test]
+    fn test_compute_spearman_correlation_with_ties() {
+        // Textbook value for average-tie ranks: x = [1, 2.5, 2.5, 4],
+        // y = [1, 2, 3, 4] gives rho = 4.5 / sqrt(4.5 * 5).
+        let corr = compute_spearman_correlation(&[1.0, 2.0, 2.0, 3.0], &[1.0, 2.0, 3.0, 4.0]);
+        assert!((corr - 4.5 / (4.5f64 * 5.0).sqrt()).abs() < 1e-12);
+
+        let constant = compute_spearman_correlation(&[1.0, 2.0, 3.0], &[5.0, 5.0, 5.0]);
+        assert_eq!(constant, 0.0);
+    }
+
     #[test]
     fn test_compute_spearman_correlation_length_mismatch() {
         let x = vec![1.0, 2.0, 3.0];
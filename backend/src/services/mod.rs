@@ -11,12 +11,15 @@ pub mod distributions;
 pub mod environment_preschedule;
 pub mod environment_structure;
 pub mod fragmentation;
+pub mod healpix;
 pub mod import_adapter;
 
 pub mod insights;
 
 pub mod sky_map;
 
+pub mod stats;
+
 pub mod timeline;
 
 pub mod trends;
@@ -29,10 +32,14 @@ pub mod schedule_processor;
 
 // Backend visibility fallback computation
 pub mod visibility;
+pub mod visibility_blocks;
 
 // KPI summary for Workspace verdict / delta / evolution UIs
 pub mod schedule_kpis;
 
+// All summary views of a schedule from one load
+pub mod dashboard;
+
 pub use altaz::compute_alt_az_data;
 pub use environment_preschedule::{
     apply_to_schedule, compute_env_preschedule, EnvPreschedulePayload,
@@ -43,4 +50,4 @@ pub use environment_structure::{
 pub use import_adapter::{
     default_schedule_import_adapter, NativeScheduleImportAdapter, ScheduleImportAdapter,
 };
-pub use visibility::compute_visibility_histogram_rust;
+pub use visibility::{compute_visibility_histogram_columns, compute_visibility_histogram_rust};
@@ -122,7 +122,7 @@ pub async fn compute_kpi_summary(
     repo: &(dyn FullRepository + 'static),
     schedule_id: ScheduleId,
 ) -> Result<ScheduleKpi, String> {
-    let insights = crate::services::insights::get_insights_data(repo, schedule_id)
+    let insights = crate::services::insights::get_insights_data(repo, schedule_id, false)
         .await
         .map_err(|e| format!("insights: {e}"))?;
     let fragmentation = crate::services::fragmentation::get_fragmentation_data(repo, schedule_id)
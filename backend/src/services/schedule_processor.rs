@@ -66,7 +66,7 @@ pub async fn process_schedule_async(
         LogLevel::Info,
         format!("Parsing import payload with {adapter_name}..."),
     );
-    let schedule = match tokio::task::spawn_blocking({
+    let schedule = match crate::metrics::spawn_blocking({
         let schedule_json = schedule_json.clone();
         let schedule_name = schedule_name.clone();
         let import_adapter = Arc::clone(&import_adapter);
@@ -213,6 +213,7 @@ pub async fn process_schedule_async(
 
     // Step 2: Store schedule
     tracker.log(&job_id, LogLevel::Info, "Storing schedule in repository...");
+    let store_started = std::time::Instant::now();
     let metadata = match db_services::store_schedule_with_options(
         repo.as_ref(),
         &schedule,
@@ -221,10 +222,20 @@ pub async fn process_schedule_async(
     .await
     {
         Ok(metadata) => {
+            // Blocks (plus their analytics and validation rows when enabled)
+            // per second of wall time, including repository round-trips.
+            let elapsed = store_started.elapsed().as_secs_f64();
+            let rows = schedule.blocks.len();
             tracker.log(
                 &job_id,
                 LogLevel::Success,
-                format!("✓ Stored schedule (ID: {})", metadata.schedule_id.value()),
+                format!(
+                    "✓ Stored schedule (ID: {}): {} blocks in {:.2}s ({:.0} rows/s)",
+                    metadata.schedule_id.value(),
+                    rows,
+                    elapsed,
+                    rows as f64 / elapsed.max(f64::EPSILON)
+                ),
             );
             metadata
         }
@@ -314,6 +325,7 @@ fn apply_visibility_override(
     nights: &[Period],
     location: &crate::api::GeographicLocation,
 ) {
+    let _rayon = crate::metrics::rayon_job();
     blocks.par_iter_mut().for_each(|block| {
         block.visibility_periods = compute_block_visibility(&VisibilityInput {
             location,
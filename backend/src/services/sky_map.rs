@@ -2,9 +2,122 @@
 #![allow(clippy::redundant_closure)]
 #![allow(clippy::useless_vec)]
 
-use crate::api::{LightweightBlock, SkyMapData};
+use std::collections::BTreeMap;
+
+use crate::api::{LightweightBlock, SkyDensityCell, SkyMapData, SkyMapDensity};
 use crate::db::FullRepository;
 
+use super::healpix;
+
+/// Largest accepted HEALPix `nside` (786 432 cells on the sphere).
+pub const MAX_SKY_MAP_RESOLUTION: u32 = 256;
+
+/// Equatorial box selecting which targets are returned individually.
+/// `ra_min > ra_max` selects a box wrapping through RA 0°.
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub struct SkyViewport {
+    pub ra_min: f64,
+    pub ra_max: f64,
+    pub dec_min: f64,
+    pub dec_max: f64,
+}
+
+impl SkyViewport {
+    pub fn contains(&self, ra_deg: f64, dec_deg: f64) -> bool {
+        if dec_deg < self.dec_min || dec_deg > self.dec_max {
+            return false;
+        }
+        let ra = ra_deg.rem_euclid(360.0);
+        if self.ra_min <= self.ra_max {
+            ra >= self.ra_min && ra <= self.ra_max
+        } else {
+            ra >= self.ra_min || ra <= self.ra_max
+        }
+    }
+}
+
+/// Level of detail requested from `/sky-map`.
+///
+/// - no `resolution`: every target (or only those in `viewport`);
+/// - with `resolution`: density cells for every target, plus the targets
+///   inside `viewport` when one is given.
+///
+/// Summary fields (counts, ranges, priority bins) always cover the whole
+/// schedule.
+#[derive(Debug, Clone, Copy, Default, PartialEq)]
+pub struct SkyMapDetail {
+    /// HEALPix `nside`, 1..=[`MAX_SKY_MAP_RESOLUTION`].
+    pub resolution: Option<u32>,
+    pub viewport: Option<SkyViewport>,
+}
+
+/// Aggregate targets into HEALPix RING cells of the given `nside`.
+pub fn compute_sky_density(blocks: &[LightweightBlock], nside: u32) -> SkyMapDensity {
+    struct Accumulator {
+        count: usize,
+        scheduled_count: usize,
+        priority_sum: f64,
+        max_priority: f64,
+    }
+
+    let mut cells: BTreeMap<u64, Accumulator> = BTreeMap::new();
+    for block in blocks {
+        let pixel = healpix::ang2pix_ring(
+            nside,
+            block.target_ra_deg.value(),
+            block.target_dec_deg.value(),
+        );
+        let cell = cells.entry(pixel).or_insert(Accumulator {
+            count: 0,
+            scheduled_count: 0,
+            priority_sum: 0.0,
+            max_priority: f64::NEG_INFINITY,
+        });
+        cell.count += 1;
+        if block.scheduled_period.is_some() {
+            cell.scheduled_count += 1;
+        }
+        cell.priority_sum += block.priority;
+        cell.max_priority = cell.max_priority.max(block.priority);
+    }
+
+    SkyMapDensity {
+        nside,
+        cell_size_deg: healpix::pixel_size_deg(nside),
+        cells: cells
+            .into_iter()
+            .map(|(pixel, cell)| {
+                let (ra_deg, dec_deg) = healpix::pix2ang_ring(nside, pixel);
+                SkyDensityCell {
+                    pixel,
+                    ra_deg,
+                    dec_deg,
+                    count: cell.count,
+                    scheduled_count: cell.scheduled_count,
+                    mean_priority: cell.priority_sum / cell.count as f64,
+                    max_priority: cell.max_priority,
+                }
+            })
+            .collect(),
+    }
+}
+
+/// Reduce full sky map data to the requested level of detail.
+pub fn apply_sky_map_detail(mut data: SkyMapData, detail: &SkyMapDetail) -> SkyMapData {
+    if let Some(nside) = detail.resolution {
+        data.density = Some(compute_sky_density(&data.blocks, nside));
+        if detail.viewport.is_none() {
+            data.blocks = Vec::new();
+        }
+    }
+    if let Some(viewport) = detail.viewport {
+        data.blocks.retain(|block| {
+            viewport.contains(block.target_ra_deg.value(), block.target_dec_deg.value())
+        });
+    }
+    data
+}
+
 /// Compute sky map data with priority bins and metadata.
 /// This function takes the raw blocks and computes everything needed for visualization.
 pub fn compute_sky_map_data(blocks: Vec<LightweightBlock>) -> Result<SkyMapData, String> {
@@ -22,6 +135,7 @@ pub fn compute_sky_map_data(blocks: Vec<LightweightBlock>) -> Result<SkyMapData,
             scheduled_count: 0,
             scheduled_time_min: None,
             scheduled_time_max: None,
+            density: None,
         });
     }
 
@@ -121,16 +235,19 @@ pub fn compute_sky_map_data(blocks: Vec<LightweightBlock>) -> Result<SkyMapData,
         scheduled_count,
         scheduled_time_min,
         scheduled_time_max,
+        density: None,
     })
 }
 
-/// Get complete sky map data with computed bins and metadata using ETL analytics.
+/// Get sky map data with computed bins and metadata using ETL analytics,
+/// reduced to the requested level of detail.
 ///
 /// This function retrieves blocks from the analytics repository
 /// which contains pre-computed, denormalized data for optimal performance.
 pub async fn get_sky_map_data(
     repo: &(dyn FullRepository + 'static),
     schedule_id: crate::api::ScheduleId,
+    detail: &SkyMapDetail,
 ) -> Result<SkyMapData, String> {
     let blocks = repo
         .fetch_analytics_blocks_for_sky_map(schedule_id)
@@ -143,12 +260,14 @@ pub async fn get_sky_map_data(
             schedule_id
         ));
     }
-    compute_sky_map_data(blocks)
+    compute_sky_map_data(blocks).map(|data| apply_sky_map_detail(data, detail))
 }
 
 #[cfg(test)]
 mod tests {
-    use super::compute_sky_map_data;
+    use super::{
+        apply_sky_map_detail, compute_sky_density, compute_sky_map_data, SkyMapDetail, SkyViewport,
+    };
     use crate::api::LightweightBlock;
 
     fn create_test_block(
@@ -343,4 +462,93 @@ mod tests {
         assert_eq!(data.dec_min.value(), -90.0);
         assert_eq!(data.dec_max.value(), 90.0);
     }
+
+    #[test]
+    fn test_compute_sky_density_aggregates_cells() {
+        let blocks = vec![
+            create_test_block("a", 2.0, 10.0, 10.0, true),
+            create_test_block("b", 6.0, 10.5, 10.2, false),
+            create_test_block("c", 4.0, 200.0, -45.0, false),
+        ];
+        let density = compute_sky_density(&blocks, 16);
+
+        assert_eq!(density.nside, 16);
+        assert_eq!(density.cells.len(), 2);
+        assert_eq!(density.cells.iter().map(|c| c.count).sum::<usize>(), 3);
+        let shared = density.cells.iter().find(|c| c.count == 2).unwrap();
+        assert_eq!(shared.scheduled_count, 1);
+        assert_eq!(shared.mean_priority, 4.0);
+        assert_eq!(shared.max_priority, 6.0);
+        assert!((shared.ra_deg - 10.0).abs() < density.cell_size_deg);
+        assert!((shared.dec_deg - 10.0).abs() < density.cell_size_deg);
+        assert!(density.cells.windows(2).all(|w| w[0].pixel < w[1].pixel));
+    }
+
+    #[test]
+    fn test_apply_sky_map_detail_resolution_only_drops_points() {
+        let blocks = vec![
+            create_test_block("a", 2.0, 10.0, 10.0, true),
+            create_test_block("b", 6.0, 100.0, 20.0, false),
+        ];
+        let data = compute_sky_map_data(blocks).unwrap();
+        let detail = SkyMapDetail {
+            resolution: Some(4),
+            viewport: None,
+        };
+        let reduced = apply_sky_map_detail(data, &detail);
+
+        assert!(reduced.blocks.is_empty());
+        assert_eq!(reduced.total_count, 2);
+        assert_eq!(reduced.scheduled_count, 1);
+        assert_eq!(reduced.density.unwrap().cells.len(), 2);
+    }
+
+    #[test]
+    fn test_apply_sky_map_detail_viewport_keeps_points_inside() {
+        let blocks = vec![
+            create_test_block("in", 2.0, 355.0, 10.0, false),
+            create_test_block("wrapped", 2.0, 5.0, -10.0, false),
+            create_test_block("out", 2.0, 180.0, 10.0, false),
+            create_test_block("too-high", 2.0, 0.0, 60.0, false),
+        ];
+        let data = compute_sky_map_data(blocks).unwrap();
+        let detail = SkyMapDetail {
+            resolution: Some(8),
+            viewport: Some(SkyViewport {
+                ra_min: 350.0,
+                ra_max: 10.0,
+                dec_min: -20.0,
+                dec_max: 20.0,
+            }),
+        };
+        let reduced = apply_sky_map_detail(data, &detail);
+
+        let ids: Vec<_> = reduced
+            .blocks
+            .iter()
+            .map(|b| b.original_block_id.as_str())
+            .collect();
+        assert_eq!(ids, vec!["in", "wrapped"]);
+        assert_eq!(reduced.total_count, 4);
+        assert_eq!(
+            reduced
+                .density
+                .unwrap()
+                .cells
+                .iter()
+                .map(|c| c.count)
+                .sum::<usize>(),
+            4
+        );
+    }
+
+    #[test]
+    fn test_apply_sky_map_detail_default_is_identity() {
+        let blocks = vec![create_test_block("a", 2.0, 10.0, 10.0, true)];
+        let data = compute_sky_map_data(blocks).unwrap();
+        let reduced = apply_sky_map_detail(data, &SkyMapDetail::default());
+
+        assert_eq!(reduced.blocks.len(), 1);
+        assert!(reduced.density.is_none());
+    }
 }
@@ -0,0 +1,240 @@
+//! Streaming summary statistics shared by the analytics services.
+//!
+//! [`SummaryStats`] folds values in one pass: count, sum, min/max and a
+//! Welford mean/variance. Accumulators are cheap enough that a service
+//! keeps one per series (all / scheduled / unscheduled priorities,
+//! visibility hours, …) and fills them all in a single loop over the
+//! blocks instead of collecting and re-walking a `Vec` per statistic.
+//! The median is the only statistic that needs the values themselves; an
+//! accumulator built with [`SummaryStats::with_median`] retains them and
+//! selects the middle in O(n) instead of sorting.
+
+use std::cmp::Ordering;
+
+/// One-pass accumulator of summary statistics over `f64` values.
+#[derive(Debug, Clone, Default)]
+pub struct SummaryStats {
+    count: usize,
+    sum: f64,
+    /// Welford running mean, used only for the variance update.
+    running_mean: f64,
+    /// Sum of squared deviations from the running mean.
+    m2: f64,
+    min: f64,
+    max: f64,
+    /// Retained values when the median is wanted.
+    values: Option<Vec<f64>>,
+}
+
+impl SummaryStats {
+    /// Accumulator for count, sum, mean, variance, min and max.
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Accumulator that also retains values for [`median`](Self::median).
+    pub fn with_median(capacity: usize) -> Self {
+        Self {
+            values: Some(Vec::with_capacity(capacity)),
+            ..Self::default()
+        }
+    }
+
+    pub fn push(&mut self, value: f64) {
+        if self.count == 0 {
+            self.min = value;
+            self.max = value;
+        } else {
+            self.min = self.min.min(value);
+            self.max = self.max.max(value);
+        }
+        self.count += 1;
+        self.sum += value;
+        let delta = value - self.running_mean;
+        self.running_mean += delta / self.count as f64;
+        self.m2 += delta * (value - self.running_mean);
+        if let Some(values) = self.values.as_mut() {
+            values.push(value);
+        }
+    }
+
+    /// Fold another accumulator into this one (Chan et al. pairwise
+    /// update), e.g. to combine per-thread partial results. Retained
+    /// values are kept only if both sides retain them.
+    pub fn merge(&mut self, other: &SummaryStats) {
+        if other.count == 0 {
+            return;
+        }
+        if self.count == 0 {
+            let values = self.values.take();
+            *self = other.clone();
+            if values.is_none() {
+                self.values = None;
+            }
+            return;
+        }
+        let count = self.count + other.count;
+        let delta = other.running_mean - self.running_mean;
+        self.m2 += other.m2 + delta * delta * (self.count * other.count) as f64 / count as f64;
+        self.running_mean += delta * other.count as f64 / count as f64;
+        self.count = count;
+        self.sum += other.sum;
+        self.min = self.min.min(other.min);
+        self.max = self.max.max(other.max);
+        match (self.values.as_mut(), other.values.as_ref()) {
+            (Some(values), Some(more)) => values.extend_from_slice(more),
+            _ => self.values = None,
+        }
+    }
+
+    pub fn count(&self) -> usize {
+        self.count
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.count == 0
+    }
+
+    pub fn sum(&self) -> f64 {
+        self.sum
+    }
+
+    /// Arithmetic mean, or 0 when empty. Reported as `sum / count` so it
+    /// matches a plain summation exactly.
+    pub fn mean(&self) -> f64 {
+        if self.count == 0 {
+            0.0
+        } else {
+            self.sum / self.count as f64
+        }
+    }
+
+    /// Population variance, or 0 when empty.
+    pub fn variance(&self) -> f64 {
+        if self.count == 0 {
+            0.0
+        } else {
+            (self.m2 / self.count as f64).max(0.0)
+        }
+    }
+
+    /// Population standard deviation, or 0 when empty.
+    pub fn std_dev(&self) -> f64 {
+        self.variance().sqrt()
+    }
+
+    pub fn min(&self) -> Option<f64> {
+        (self.count > 0).then_some(self.min)
+    }
+
+    pub fn max(&self) -> Option<f64> {
+        (self.count > 0).then_some(self.max)
+    }
+
+    /// Median of the retained values (mean of the middle pair for even
+    /// counts). `None` when empty or built without [`with_median`](Self::with_median).
+    /// Reorders the retained values.
+    pub fn median(&mut self) -> Option<f64> {
+        median_in_place(self.values.as_mut()?)
+    }
+}
+
+/// Median of `values` in O(n) via `select_nth_unstable`, reordering the
+/// slice. `None` when empty.
+pub fn median_in_place(values: &mut [f64]) -> Option<f64> {
+    let n = values.len();
+    if n == 0 {
+        return None;
+    }
+    let cmp = |a: &f64, b: &f64| a.partial_cmp(b).unwrap_or(Ordering::Equal);
+    let (lower, upper, _) = values.select_nth_unstable_by(n / 2, cmp);
+    let upper = *upper;
+    if n % 2 == 1 {
+        return Some(upper);
+    }
+    // Everything left of the pivot is <= it, so the lower middle value is
+    // the largest of them.
+    let lower = lower.iter().copied().fold(f64::NEG_INFINITY, f64::max);
+    Some((lower + upper) / 2.0)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn sorted_median(values: &[f64]) -> f64 {
+        let mut sorted = values.to_vec();
+        sorted.sort_by(|a, b| a.partial_cmp(b).unwrap());
+        let n = sorted.len();
+        if n % 2 == 0 {
+            (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0
+        } else {
+            sorted[n / 2]
+        }
+    }
+
+    fn pseudo_random(n: usize, seed: u64) -> Vec<f64> {
+        let mut state = seed;
+        (0..n)
+            .map(|_| {
+                state = state
+                    .wrapping_mul(6364136223846793005)
+                    .wrapping_add(1442695040888963407);
+                ((state >> 33) % 1000) as f64 / 10.0
+            })
+            .collect()
+    }
+
+    #[test]
+    fn matches_two_pass_statistics() {
+        for n in [1, 2, 3, 10, 101, 1000] {
+            let values = pseudo_random(n, n as u64);
+            let mut stats = SummaryStats::with_median(n);
+            values.iter().for_each(|v| stats.push(*v));
+
+            let mean = values.iter().sum::<f64>() / n as f64;
+            let variance = values.iter().map(|v| (v - mean).powi(2)).sum::<f64>() / n as f64;
+            assert_eq!(stats.count(), n);
+            assert_eq!(stats.mean(), mean);
+            assert!((stats.variance() - variance).abs() < 1e-9);
+            assert_eq!(stats.min(), values.iter().copied().reduce(f64::min));
+            assert_eq!(stats.max(), values.iter().copied().reduce(f64::max));
+            assert_eq!(stats.median(), Some(sorted_median(&values)));
+        }
+    }
+
+    #[test]
+    fn merge_equals_single_pass() {
+        let values = pseudo_random(500, 7);
+        let mut whole = SummaryStats::with_median(values.len());
+        values.iter().for_each(|v| whole.push(*v));
+
+        let (left, right) = values.split_at(123);
+        let mut merged = SummaryStats::with_median(0);
+        let mut other = SummaryStats::with_median(0);
+        left.iter().for_each(|v| merged.push(*v));
+        right.iter().for_each(|v| other.push(*v));
+        merged.merge(&other);
+
+        assert_eq!(merged.count(), whole.count());
+        assert!((merged.sum() - whole.sum()).abs() < 1e-9);
+        assert!((merged.variance() - whole.variance()).abs() < 1e-9);
+        assert_eq!(merged.min(), whole.min());
+        assert_eq!(merged.max(), whole.max());
+        assert_eq!(merged.median(), whole.median());
+    }
+
+    #[test]
+    fn empty_and_median_less_accumulators() {
+        let mut empty = SummaryStats::with_median(0);
+        assert_eq!(empty.mean(), 0.0);
+        assert_eq!(empty.std_dev(), 0.0);
+        assert_eq!(empty.min(), None);
+        assert_eq!(empty.median(), None);
+
+        let mut plain = SummaryStats::new();
+        plain.push(4.0);
+        assert_eq!(plain.median(), None);
+        assert_eq!(median_in_place(&mut [3.0, 1.0, 4.0, 2.0]), Some(2.5));
+    }
+}
@@ -4,12 +4,108 @@
 use crate::api;
 use crate::api::Period;
 use crate::db::models::ScheduleTimelineBlock;
-use crate::db::FullRepository;
-use chrono::TimeZone;
-use std::collections::HashSet;
+use crate::db::{services as db_services, FullRepository};
+use chrono::{Datelike, TimeZone};
+use std::collections::{BTreeSet, HashMap};
+
+/// MJD of the Unix epoch (1970-01-01T00:00:00Z).
+const MJD_UNIX_EPOCH: f64 = 40587.0;
+const SECONDS_PER_DAY: f64 = 86400.0;
+
+/// Unix timestamp of the first instant of `year-month` (UTC).
+fn month_start_unix(year: i32, month: u32) -> f64 {
+    chrono::Utc
+        .with_ymd_and_hms(year, month, 1, 0, 0, 0)
+        .single()
+        .map(|dt| dt.timestamp() as f64)
+        .unwrap_or(f64::NAN)
+}
+
+fn next_month(year: i32, month: u32) -> (i32, u32) {
+    if month == 12 {
+        (year + 1, 1)
+    } else {
+        (year, month + 1)
+    }
+}
+
+fn priority_color_index(priority: f64) -> u8 {
+    let bins = api::TIMELINE_COLOR_BINS;
+    let t = (priority / 10.0).clamp(0.0, 1.0);
+    if t.is_nan() {
+        return 0;
+    }
+    (t * f64::from(bins - 1)).round() as u8
+}
+
+/// Month-row bar segments for the scheduled blocks, plus the sorted month
+/// labels the rows refer to. Blocks crossing a UTC month boundary yield
+/// one segment per month.
+fn compute_timeline_layout(blocks: &[ScheduleTimelineBlock]) -> (api::TimelineLayout, Vec<String>) {
+    let mut layout = api::TimelineLayout::default();
+    let mut segment_months: Vec<(i32, u32)> = Vec::with_capacity(blocks.len());
+
+    for (index, block) in blocks.iter().enumerate() {
+        let start = (block.scheduled_start_mjd.value() - MJD_UNIX_EPOCH) * SECONDS_PER_DAY;
+        let stop = (block.scheduled_stop_mjd.value() - MJD_UNIX_EPOCH) * SECONDS_PER_DAY;
+        let Some(dt) = chrono::Utc.timestamp_opt(start.floor() as i64, 0).single() else {
+            continue;
+        };
+        let end = if stop.is_finite() {
+            stop.max(start)
+        } else {
+            start
+        };
+        let color = priority_color_index(block.priority);
+
+        let (mut year, mut month) = (dt.year(), dt.month());
+        let mut month_begin = month_start_unix(year, month);
+        let mut cursor = start;
+        let mut continuation = false;
+        loop {
+            let (next_year, next_mon) = next_month(year, month);
+            let next_begin = month_start_unix(next_year, next_mon);
+            let segment_end = end.min(next_begin);
+
+            layout.block_index.push(index as u32);
+            layout
+                .x0
+                .push((cursor - month_begin) / SECONDS_PER_DAY + 1.0);
+            layout
+                .x1
+                .push((segment_end - month_begin) / SECONDS_PER_DAY + 1.0);
+            layout.color_index.push(color);
+            layout.continuation.push(continuation);
+            segment_months.push((year, month));
+
+            if end <= next_begin || next_begin.is_nan() {
+                break;
+            }
+            (year, month) = (next_year, next_mon);
+            month_begin = next_begin;
+            cursor = next_begin;
+            continuation = true;
+        }
+    }
+
+    let months: BTreeSet<(i32, u32)> = segment_months.iter().copied().collect();
+    let rows: HashMap<(i32, u32), u32> = months
+        .iter()
+        .enumerate()
+        .map(|(row, key)| (*key, row as u32))
+        .collect();
+    layout.row = segment_months.iter().map(|key| rows[key]).collect();
+    let labels = months
+        .into_iter()
+        .map(|(year, month)| format!("{:04}-{:02}", year, month))
+        .collect();
+
+    (layout, labels)
+}
 
 /// Compute schedule timeline data with statistics and metadata.
-/// This function takes the raw blocks and computes everything needed for visualization.
+/// This function takes the raw blocks and computes everything needed for
+/// visualization, including the render-ready month-row layout.
 pub fn compute_schedule_timeline_data(
     blocks: Vec<ScheduleTimelineBlock>,
     dark_periods: Vec<Period>,
@@ -25,32 +121,20 @@ pub fn compute_schedule_timeline_data(
             scheduled_count: 0,
             unique_months: vec![],
             dark_periods: api_dark_periods,
+            layout: api::TimelineLayout::default(),
         });
     }
 
     // Compute statistics
     let mut priority_min = f64::MAX;
     let mut priority_max = f64::MIN;
-    let mut unique_months = HashSet::new();
 
     for block in &blocks {
         priority_min = priority_min.min(block.priority);
         priority_max = priority_max.max(block.priority);
-
-        // Convert MJD to year-month string using primitive mjd value
-        // MJD 0 = November 17, 1858
-        // Unix epoch (Jan 1, 1970) = MJD 40587
-        let unix_timestamp = (block.scheduled_start_mjd.value() - 40587.0) * 86400.0;
-        // Use timezone-aware constructor to avoid deprecated NaiveDateTime/DateTime APIs
-        if let Some(dt) = chrono::Utc.timestamp_opt(unix_timestamp as i64, 0).single() {
-            let month_label = dt.format("%Y-%m").to_string();
-            unique_months.insert(month_label);
-        }
     }
 
-    // Sort unique months
-    let mut sorted_months: Vec<String> = unique_months.into_iter().collect();
-    sorted_months.sort();
+    let (layout, sorted_months) = compute_timeline_layout(&blocks);
 
     // Handle edge cases
     if !priority_min.is_finite() {
@@ -63,16 +147,17 @@ pub fn compute_schedule_timeline_data(
         priority_max = priority_min + 1.0;
     }
 
-    let api_blocks: Vec<crate::api::ScheduleTimelineBlock> = blocks.to_vec();
+    let total_count = blocks.len();
 
     Ok(crate::api::ScheduleTimelineData {
-        blocks: api_blocks,
+        blocks,
         priority_min,
         priority_max,
-        total_count: blocks.len(),
-        scheduled_count: blocks.len(),
+        total_count,
+        scheduled_count: total_count,
         unique_months: sorted_months,
         dark_periods: api_dark_periods,
+        layout,
     })
 }
 
@@ -85,20 +170,23 @@ pub async fn get_schedule_timeline_data(
     repo: &(dyn FullRepository + 'static),
     schedule_id: crate::api::ScheduleId,
 ) -> Result<crate::api::ScheduleTimelineData, String> {
-    let blocks = repo
-        .fetch_schedule_timeline_blocks(schedule_id)
+    // Repositories that join timeline blocks against the analytics rows
+    // return nothing for schedules stored with analytics deferred.
+    db_services::ensure_analytics(repo, schedule_id)
         .await
-        .map_err(|e| format!("Failed to fetch timeline blocks: {}", e))?;
+        .map_err(|e| format!("Failed to ensure analytics: {}", e))?;
 
-    let schedule = repo
-        .get_schedule(schedule_id)
-        .await
-        .map_err(|e| format!("Failed to fetch schedule periods: {}", e))?;
+    let (blocks, schedule) = tokio::join!(
+        repo.fetch_schedule_timeline_blocks(schedule_id),
+        repo.get_schedule_shared(schedule_id),
+    );
+    let blocks = blocks.map_err(|e| format!("Failed to fetch timeline blocks: {}", e))?;
+    let schedule = schedule.map_err(|e| format!("Failed to fetch schedule periods: {}", e))?;
 
     let dark_periods = if schedule.dark_periods.is_empty() {
-        schedule.astronomical_nights
+        schedule.astronomical_nights.clone()
     } else {
-        schedule.dark_periods
+        schedule.dark_periods.clone()
     };
 
     compute_schedule_timeline_data(blocks, dark_periods)
@@ -154,5 +242,80 @@ mod tests {
         assert_eq!(result.priority_min, 5.0);
         assert_eq!(result.priority_max, 8.0);
         assert!(result.unique_months.len() >= 1); // At least one month
+        assert_eq!(result.layout.len(), 2);
+        assert_eq!(result.layout.row, vec![0, 1]);
+        assert_eq!(result.unique_months, vec!["2020-05", "2020-06"]);
+    }
+
+    fn timeline_block(id: i64, priority: f64, start: f64, stop: f64) -> ScheduleTimelineBlock {
+        ScheduleTimelineBlock {
+            scheduling_block_id: id,
+            original_block_id: format!("SB{:03}", id),
+            block_name: String::new(),
+            priority,
+            scheduled_start_mjd: crate::models::ModifiedJulianDate::new(start),
+            scheduled_stop_mjd: crate::models::ModifiedJulianDate::new(stop),
+            ra_deg: qtty::angular::Degrees::new(0.0),
+            dec_deg: qtty::angular::Degrees::new(0.0),
+            requested_hours: qtty::time::Hours::new(1.0),
+            total_visibility_hours: qtty::time::Hours::new(1.0),
+            num_visibility_periods: 1,
+        }
+    }
+
+    #[test]
+    fn test_layout_fractional_days() {
+        // MJD 60319.5 = 2024-01-10T12:00Z, MJD 60319.75 = 2024-01-10T18:00Z
+        let result =
+            compute_schedule_timeline_data(vec![timeline_block(1, 5.0, 60319.5, 60319.75)], vec![])
+                .unwrap();
+        let layout = &result.layout;
+        assert_eq!(result.unique_months, vec!["2024-01"]);
+        assert!((layout.x0[0] - 10.5).abs() < 1e-9);
+        assert!((layout.x1[0] - 10.75).abs() < 1e-9);
+        assert_eq!(layout.color_index[0], 8);
+        assert!(!layout.continuation[0]);
+    }
+
+    #[test]
+    fn test_layout_splits_at_month_boundaries() {
+        // 2024-01-30T00:00Z (MJD 60339) to 2024-03-02T00:00Z (MJD 60371)
+        let result =
+            compute_schedule_timeline_data(vec![timeline_block(1, 10.0, 60339.0, 60371.0)], vec![])
+                .unwrap();
+        let layout = &result.layout;
+        assert_eq!(result.unique_months, vec!["2024-01", "2024-02", "2024-03"]);
+        assert_eq!(layout.len(), 3);
+        assert_eq!(layout.block_index, vec![0, 0, 0]);
+        assert_eq!(layout.row, vec![0, 1, 2]);
+        assert_eq!(layout.continuation, vec![false, true, true]);
+        // Jan 30 → end of January (31 days)
+        assert!((layout.x0[0] - 30.0).abs() < 1e-9);
+        assert!((layout.x1[0] - 32.0).abs() < 1e-9);
+        // Whole of February 2024 (leap year)
+        assert!((layout.x0[1] - 1.0).abs() < 1e-9);
+        assert!((layout.x1[1] - 30.0).abs() < 1e-9);
+        // March 1 → March 2
+        assert!((layout.x0[2] - 1.0).abs() < 1e-9);
+        assert!((layout.x1[2] - 2.0).abs() < 1e-9);
+        assert_eq!(layout.color_index[0], api::TIMELINE_COLOR_BINS - 1);
+    }
+
+    #[test]
+    fn test_layout_year_boundary_and_inverted_stop() {
+        // 2024-12-31T12:00Z (MJD 60675.5) to 2025-01-01T06:00Z (MJD 60676.25)
+        let blocks = vec![
+            timeline_block(1, 0.0, 60675.5, 60676.25),
+            timeline_block(2, 3.0, 60680.0, 60679.0),
+        ];
+        let result = compute_schedule_timeline_data(blocks, vec![]).unwrap();
+        let layout = &result.layout;
+        assert_eq!(result.unique_months, vec!["2024-12", "2025-01"]);
+        assert_eq!(layout.block_index, vec![0, 0, 1]);
+        assert_eq!(layout.row, vec![0, 1, 1]);
+        assert!((layout.x1[0] - 32.0).abs() < 1e-9);
+        assert!((layout.x1[1] - 1.25).abs() < 1e-9);
+        // A stop before the start collapses to a zero-width bar.
+        assert_eq!(layout.x0[2], layout.x1[2]);
     }
 }
@@ -7,55 +7,43 @@ use crate::api::{
 use std::collections::HashMap;
 
 use crate::db::{services as db_services, FullRepository};
+use crate::services::stats::SummaryStats;
 
-/// Compute overview metrics from trends blocks.
+/// Compute overview metrics from trends blocks in a single pass.
 pub(crate) fn compute_metrics(blocks: &[TrendsBlock]) -> TrendsMetrics {
+    let mut scheduled_count = 0;
+    let mut zero_visibility_count = 0;
+    let mut priorities = SummaryStats::new();
+    let mut visibilities = SummaryStats::new();
+    let mut times = SummaryStats::new();
+    for block in blocks {
+        let visibility = block.total_visibility_hours.value();
+        scheduled_count += usize::from(block.scheduled);
+        zero_visibility_count += usize::from(visibility == 0.0);
+        priorities.push(block.priority);
+        visibilities.push(visibility);
+        times.push(block.requested_hours.value());
+    }
+
     let total_count = blocks.len();
-    let scheduled_count = blocks.iter().filter(|b| b.scheduled).count();
-    let zero_visibility_count = blocks
-        .iter()
-        .filter(|b| b.total_visibility_hours.value() == 0.0)
-        .count();
     let scheduling_rate = if total_count > 0 {
         scheduled_count as f64 / total_count as f64
     } else {
         0.0
     };
 
-    // Collect all values for stats (use primitive f64 values)
-    let priorities: Vec<f64> = blocks.iter().map(|b| b.priority).collect();
-    let visibilities: Vec<f64> = blocks
-        .iter()
-        .map(|b| b.total_visibility_hours.value())
-        .collect();
-    let times: Vec<f64> = blocks.iter().map(|b| b.requested_hours.value()).collect();
+    // Empty series keep the fold identities (+inf / -inf) as before.
+    let priority_min = priorities.min().unwrap_or(f64::INFINITY);
+    let priority_max = priorities.max().unwrap_or(f64::NEG_INFINITY);
+    let priority_mean = priorities.mean();
 
-    let priority_min = priorities.iter().copied().fold(f64::INFINITY, f64::min);
-    let priority_max = priorities.iter().copied().fold(f64::NEG_INFINITY, f64::max);
-    let priority_mean = if !priorities.is_empty() {
-        priorities.iter().sum::<f64>() / priorities.len() as f64
-    } else {
-        0.0
-    };
+    let visibility_min = visibilities.min().unwrap_or(f64::INFINITY);
+    let visibility_max = visibilities.max().unwrap_or(f64::NEG_INFINITY);
+    let visibility_mean = visibilities.mean();
 
-    let visibility_min = visibilities.iter().copied().fold(f64::INFINITY, f64::min);
-    let visibility_max = visibilities
-        .iter()
-        .copied()
-        .fold(f64::NEG_INFINITY, f64::max);
-    let visibility_mean = if !visibilities.is_empty() {
-        visibilities.iter().sum::<f64>() / visibilities.len() as f64
-    } else {
-        0.0
-    };
-
-    let time_min = times.iter().copied().fold(f64::INFINITY, f64::min);
-    let time_max = times.iter().copied().fold(f64::NEG_INFINITY, f64::max);
-    let time_mean = if !times.is_empty() {
-        times.iter().sum::<f64>() / times.len() as f64
-    } else {
-        0.0
-    };
+    let time_min = times.min().unwrap_or(f64::INFINITY);
+    let time_max = times.max().unwrap_or(f64::NEG_INFINITY);
+    let time_mean = times.mean();
 
     TrendsMetrics {
         total_count,
@@ -383,6 +371,33 @@ pub fn compute_trends_data(
     })
 }
 
+/// Convert insights rows into trends rows, dropping blocks without
+/// visibility. Blocks whose visibility was never computed fall back to
+/// their requested hours.
+pub(crate) fn trends_blocks(blocks: &[InsightsBlock]) -> Vec<TrendsBlock> {
+    blocks
+        .iter()
+        .map(|block| {
+            let mut total_visibility_hours = block.total_visibility_hours.value();
+            let requested_hours = block.requested_hours.value();
+            if total_visibility_hours == 0.0 && requested_hours > 0.0 {
+                total_visibility_hours = requested_hours;
+            }
+
+            TrendsBlock {
+                scheduling_block_id: block.scheduling_block_id,
+                original_block_id: block.original_block_id.clone(),
+                block_name: block.block_name.clone(),
+                priority: block.priority,
+                total_visibility_hours: qtty::Hours::new(total_visibility_hours),
+                requested_hours: qtty::Hours::new(requested_hours),
+                scheduled: block.scheduled,
+            }
+        })
+        .filter(|b| b.total_visibility_hours.value() > 0.0) // Filter out zero visibility
+        .collect()
+}
+
 /// Get complete trends data with computed analytics.
 /// Uses pre-computed analytics table when available for ~10-100x faster performance.
 ///
@@ -403,40 +418,7 @@ pub async fn get_trends_data(
         .fetch_analytics_blocks_for_insights(schedule_id)
         .await
         .map_err(|e| format!("Failed to fetch analytics blocks: {}", e))?;
-
-    // Convert InsightsBlock to TrendsBlock.
-    let blocks: Vec<TrendsBlock> = insight_blocks
-        .into_iter()
-        .map(|block| {
-            let InsightsBlock {
-                scheduling_block_id,
-                original_block_id,
-                block_name,
-                priority,
-                total_visibility_hours,
-                requested_hours,
-                scheduled,
-                ..
-            } = block;
-
-            let mut total_visibility_hours = total_visibility_hours.value();
-            let requested_hours = requested_hours.value();
-            if total_visibility_hours == 0.0 && requested_hours > 0.0 {
-                total_visibility_hours = requested_hours;
-            }
-
-            TrendsBlock {
-                scheduling_block_id,
-                original_block_id,
-                block_name,
-                priority,
-                total_visibility_hours: qtty::Hours::new(total_visibility_hours),
-                requested_hours: qtty::Hours::new(requested_hours),
-                scheduled,
-            }
-        })
-        .filter(|b| b.total_visibility_hours.value() > 0.0) // Filter out zero visibility
-        .collect();
+    let blocks = trends_blocks(&insight_blocks);
 
     if blocks.is_empty() {
         return Err(format!(
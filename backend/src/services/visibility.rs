@@ -478,7 +478,9 @@ mod tests {
 mod histogram {
     use std::collections::HashSet;
 
+    use crate::api::Period;
     use crate::db::models::{BlockHistogramData, VisibilityBin};
+    use crate::models::ScheduleColumns;
 
     /// A parsed visibility period with Unix timestamps for efficient comparison
     #[derive(Debug, Clone, Copy)]
@@ -518,6 +520,58 @@ mod histogram {
         bin_duration_seconds: i64,
         priority_min: Option<f64>,
         priority_max: Option<f64>,
+    ) -> Result<Vec<VisibilityBin>, String> {
+        bin_visibility(
+            blocks.map(|b| {
+                (
+                    b.scheduling_block_id,
+                    b.priority,
+                    b.visibility_periods.unwrap_or_default(),
+                )
+            }),
+            start_unix,
+            end_unix,
+            bin_duration_seconds,
+            priority_min,
+            priority_max,
+        )
+    }
+
+    /// [`compute_visibility_histogram_rust`] over the given `rows` of a
+    /// columnar schedule, reading their periods in place.
+    pub fn compute_visibility_histogram_columns(
+        columns: &ScheduleColumns,
+        rows: impl Iterator<Item = usize>,
+        start_unix: i64,
+        end_unix: i64,
+        bin_duration_seconds: i64,
+        priority_min: Option<f64>,
+        priority_max: Option<f64>,
+    ) -> Result<Vec<VisibilityBin>, String> {
+        bin_visibility(
+            rows.map(|row| {
+                (
+                    columns.block_ids[row].map(|id| id.value()).unwrap_or(0),
+                    columns.priorities[row],
+                    columns.visibility(row).iter().copied(),
+                )
+            }),
+            start_unix,
+            end_unix,
+            bin_duration_seconds,
+            priority_min,
+            priority_max,
+        )
+    }
+
+    /// Shared core: `blocks` yields `(block_id, priority, periods)`.
+    fn bin_visibility<P: IntoIterator<Item = Period>>(
+        blocks: impl Iterator<Item = (i64, f64, P)>,
+        start_unix: i64,
+        end_unix: i64,
+        bin_duration_seconds: i64,
+        priority_min: Option<f64>,
+        priority_max: Option<f64>,
     ) -> Result<Vec<VisibilityBin>, String> {
         // Validate inputs
         if start_unix >= end_unix {
@@ -543,29 +597,26 @@ mod histogram {
         // Parse visibility periods from all blocks
         let mut all_periods: Vec<VisibilityPeriod> = Vec::new();
 
-        for block in blocks {
+        for (block_id, priority, periods) in blocks {
             // Apply priority filter
             if let Some(min_p) = priority_min {
-                if block.priority < min_p {
+                if priority < min_p {
                     continue;
                 }
             }
             if let Some(max_p) = priority_max {
-                if block.priority > max_p {
+                if priority > max_p {
                     continue;
                 }
             }
 
-            // Use typed visibility periods directly
-            if let Some(periods) = &block.visibility_periods {
-                // Convert Period to VisibilityPeriod with Unix timestamps
-                for period in periods {
-                    all_periods.push(VisibilityPeriod {
-                        block_id: block.scheduling_block_id,
-                        start_unix: ((period.start.value() - 40587.0) * 86400.0) as i64,
-                        end_unix: ((period.end.value() - 40587.0) * 86400.0) as i64,
-                    });
-                }
+            // Convert Period to VisibilityPeriod with Unix timestamps
+            for period in periods {
+                all_periods.push(VisibilityPeriod {
+                    block_id,
+                    start_unix: ((period.start.value() - 40587.0) * 86400.0) as i64,
+                    end_unix: ((period.end.value() - 40587.0) * 86400.0) as i64,
+                });
             }
         }
 
@@ -721,6 +772,62 @@ mod histogram {
             assert!(visible_bins.iter().all(|b| b.visible_count <= 1));
         }
 
+        #[test]
+        fn test_columns_histogram_matches_rows() {
+            use crate::api::{Constraints, SchedulingBlock, SchedulingBlockId};
+            use crate::models::{ModifiedJulianDate, ScheduleColumnsBuilder};
+
+            let period = |s: f64, e: f64| Period {
+                start: ModifiedJulianDate::new(40587.0 + s),
+                end: ModifiedJulianDate::new(40587.0 + e),
+            };
+            let blocks: Vec<SchedulingBlock> = (0..6)
+                .map(|i| {
+                    let start = i as f64 * 0.1;
+                    SchedulingBlock::new(
+                        format!("b{i}"),
+                        String::new(),
+                        0.0.into(),
+                        0.0.into(),
+                        Constraints::new(0.0.into(), 90.0.into(), 0.0.into(), 360.0.into(), None),
+                        i as f64,
+                        0.0.into(),
+                        0.0.into(),
+                        Some(SchedulingBlockId(i)),
+                        Some(vec![period(start, start + 0.2), period(0.8, 0.9)]),
+                        None,
+                    )
+                })
+                .collect();
+            let mut builder = ScheduleColumnsBuilder::new(None, String::new(), period(0.0, 1.0));
+            blocks.iter().for_each(|b| builder.push_block(b));
+            let columns = builder.finish();
+
+            let rows = blocks.iter().map(|b| BlockHistogramData {
+                scheduling_block_id: b.id.unwrap().value(),
+                priority: b.priority,
+                visibility_periods: Some(b.visibility_periods.clone()),
+            });
+            let expected =
+                compute_visibility_histogram_rust(rows, 0, 86400, 3600, Some(2.0), None).unwrap();
+            let bins = compute_visibility_histogram_columns(
+                &columns,
+                0..columns.len(),
+                0,
+                86400,
+                3600,
+                Some(2.0),
+                None,
+            )
+            .unwrap();
+
+            let counts = |bins: &[VisibilityBin]| -> Vec<i64> {
+                bins.iter().map(|b| b.visible_count).collect()
+            };
+            assert_eq!(counts(&bins), counts(&expected));
+            assert_eq!(bins.iter().map(|b| b.visible_count).max(), Some(4));
+        }
+
         #[test]
         fn test_compute_histogram_validation() {
             let blocks: Vec<BlockHistogramData> = vec![];
@@ -744,4 +851,4 @@ mod histogram {
         }
     }
 }
-pub use histogram::compute_visibility_histogram_rust;
+pub use histogram::{compute_visibility_histogram_columns, compute_visibility_histogram_rust};
@@ -0,0 +1,360 @@
+//! Presorted in-memory index for the paginated visibility-map block table.
+//!
+//! Used by repositories that hold block summaries in memory.  Each sort key
+//! has a row permutation in ascending `(key, scheduling_block_id)` order,
+//! built once per schedule, so a page request is a binary search for the
+//! cursor followed by a filtered walk instead of a sort.
+
+use std::cmp::Ordering;
+
+use crate::api::{
+    SortDirection, VisibilityBlockCursor, VisibilityBlockSort, VisibilityBlockSummary,
+    VisibilityBlocksPage, VisibilityBlocksQuery,
+};
+
+/// Largest page the index hands out.
+pub const MAX_VISIBILITY_PAGE_SIZE: usize = 1000;
+
+#[derive(Debug)]
+pub struct VisibilityBlockIndex {
+    blocks: Vec<VisibilityBlockSummary>,
+    /// Lowercased `original_block_id \0 block_name` per row.
+    haystacks: Vec<String>,
+    by_priority: Vec<u32>,
+    by_periods: Vec<u32>,
+    by_scheduled: Vec<u32>,
+    scheduled_count: usize,
+    priority_min: f64,
+    priority_max: f64,
+}
+
+struct Needle {
+    text: String,
+    id: Option<i64>,
+}
+
+fn compare_keys(a: (f64, i64), b: (f64, i64)) -> Ordering {
+    a.0.total_cmp(&b.0).then(a.1.cmp(&b.1))
+}
+
+impl VisibilityBlockIndex {
+    pub fn new(blocks: Vec<VisibilityBlockSummary>) -> Self {
+        let haystacks = blocks
+            .iter()
+            .map(|b| format!("{}\0{}", b.original_block_id, b.block_name).to_lowercase())
+            .collect();
+
+        let order_by = |sort: VisibilityBlockSort| {
+            let mut order: Vec<u32> = (0..blocks.len() as u32).collect();
+            order.sort_unstable_by(|&a, &b| {
+                let (a, b) = (&blocks[a as usize], &blocks[b as usize]);
+                compare_keys(
+                    (sort.key(a), a.scheduling_block_id),
+                    (sort.key(b), b.scheduling_block_id),
+                )
+            });
+            order
+        };
+        let by_priority = order_by(VisibilityBlockSort::Priority);
+        let by_periods = order_by(VisibilityBlockSort::NumVisibilityPeriods);
+        let by_scheduled = order_by(VisibilityBlockSort::Scheduled);
+
+        let scheduled_count = blocks.iter().filter(|b| b.scheduled).count();
+        let (priority_min, priority_max) = if blocks.is_empty() {
+            (0.0, 1.0)
+        } else {
+            let first = &blocks[by_priority[0] as usize];
+            let last = &blocks[by_priority[by_priority.len() - 1] as usize];
+            (first.priority, last.priority)
+        };
+
+        Self {
+            blocks,
+            haystacks,
+            by_priority,
+            by_periods,
+            by_scheduled,
+            scheduled_count,
+            priority_min,
+            priority_max,
+        }
+    }
+
+    pub fn len(&self) -> usize {
+        self.blocks.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.blocks.is_empty()
+    }
+
+    fn order(&self, sort: VisibilityBlockSort) -> &[u32] {
+        match sort {
+            VisibilityBlockSort::Priority => &self.by_priority,
+            VisibilityBlockSort::NumVisibilityPeriods => &self.by_periods,
+            VisibilityBlockSort::Scheduled => &self.by_scheduled,
+        }
+    }
+
+    fn key_at(&self, sort: VisibilityBlockSort, row: u32) -> (f64, i64) {
+        let block = &self.blocks[row as usize];
+        (sort.key(block), block.scheduling_block_id)
+    }
+
+    /// Ascending slice of `order` that can match the priority bounds.
+    /// Only narrows anything for the priority sort.
+    fn candidate_range(&self, query: &VisibilityBlocksQuery) -> (usize, usize) {
+        let order = self.order(query.sort);
+        if query.sort != VisibilityBlockSort::Priority {
+            return (0, order.len());
+        }
+        let priority = |row: &u32| self.blocks[*row as usize].priority;
+        let lo = query
+            .priority_min
+            .map_or(0, |min| order.partition_point(|row| priority(row) < min));
+        let hi = query.priority_max.map_or(order.len(), |max| {
+            order.partition_point(|row| priority(row) <= max)
+        });
+        (lo, hi.max(lo))
+    }
+
+    /// Search text matches a substring of the original id or name, or the
+    /// exact scheduling block id (same semantics as the Postgres query).
+    fn matches(&self, row: u32, query: &VisibilityBlocksQuery, needle: Option<&Needle>) -> bool {
+        let block = &self.blocks[row as usize];
+        if query.priority_min.is_some_and(|min| block.priority < min)
+            || query.priority_max.is_some_and(|max| block.priority > max)
+            || query.scheduled.is_some_and(|s| block.scheduled != s)
+        {
+            return false;
+        }
+        needle.map_or(true, |needle| {
+            needle.id == Some(block.scheduling_block_id)
+                || self.haystacks[row as usize].contains(&needle.text)
+        })
+    }
+
+    /// Answer one page request.
+    pub fn page(&self, query: &VisibilityBlocksQuery) -> VisibilityBlocksPage {
+        let sort = query.sort;
+        let order = self.order(sort);
+        let limit = query.limit.clamp(1, MAX_VISIBILITY_PAGE_SIZE);
+        let needle = query
+            .search
+            .as_deref()
+            .map(str::trim)
+            .filter(|s| !s.is_empty())
+            .map(|s| Needle {
+                text: s.to_lowercase(),
+                id: s.parse().ok(),
+            });
+        let needle = needle.as_ref();
+        let (lo, hi) = self.candidate_range(query);
+
+        let matched_count = order[lo..hi]
+            .iter()
+            .filter(|&&row| self.matches(row, query, needle))
+            .count();
+
+        // Rows strictly past the cursor in the query direction.
+        let cursor_split = |after: &VisibilityBlockCursor, inclusive: bool| {
+            let after = (after.key, after.id);
+            lo + order[lo..hi].partition_point(|&row| {
+                let ord = compare_keys(self.key_at(sort, row), after);
+                ord.is_lt() || (inclusive && ord.is_eq())
+            })
+        };
+        let rows: Box<dyn Iterator<Item = &u32>> = match (query.direction, &query.after) {
+            (SortDirection::Asc, Some(after)) => {
+                Box::new(order[cursor_split(after, true)..hi].iter())
+            }
+            (SortDirection::Asc, None) => Box::new(order[lo..hi].iter()),
+            (SortDirection::Desc, Some(after)) => {
+                Box::new(order[lo..cursor_split(after, false)].iter().rev())
+            }
+            (SortDirection::Desc, None) => Box::new(order[lo..hi].iter().rev()),
+        };
+
+        let skip = if query.after.is_some() {
+            0
+        } else {
+            query.offset
+        };
+        let mut matching = rows
+            .filter(|&&row| self.matches(row, query, needle))
+            .skip(skip);
+        let page: Vec<u32> = matching.by_ref().take(limit).copied().collect();
+        let has_more = matching.next().is_some();
+
+        let next_cursor = if has_more {
+            page.last().map(|&row| {
+                let (key, id) = self.key_at(sort, row);
+                VisibilityBlockCursor { key, id }
+            })
+        } else {
+            None
+        };
+
+        VisibilityBlocksPage {
+            blocks: page
+                .iter()
+                .map(|&row| self.blocks[row as usize].clone())
+                .collect(),
+            matched_count,
+            total_count: self.blocks.len(),
+            scheduled_count: self.scheduled_count,
+            priority_min: self.priority_min,
+            priority_max: self.priority_max,
+            next_cursor,
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn block(id: i64, priority: f64, periods: usize, scheduled: bool) -> VisibilityBlockSummary {
+        VisibilityBlockSummary {
+            scheduling_block_id: id,
+            original_block_id: format!("OB-{id:03}"),
+            block_name: if id % 2 == 0 {
+                "Vega".into()
+            } else {
+                "Deneb".into()
+            },
+            priority,
+            num_visibility_periods: periods,
+            scheduled,
+        }
+    }
+
+    fn sample() -> VisibilityBlockIndex {
+        VisibilityBlockIndex::new(
+            (1..=50)
+                .map(|id| block(id, (id % 7) as f64, (id % 5) as usize, id % 3 == 0))
+                .collect(),
+        )
+    }
+
+    /// Reference: filter + full sort over the raw rows.
+    fn expected(index: &VisibilityBlockIndex, query: &VisibilityBlocksQuery) -> Vec<i64> {
+        let needle = query.search.as_ref().map(|s| s.to_lowercase());
+        let needle_id = query.search.as_ref().and_then(|s| s.parse::<i64>().ok());
+        let mut rows: Vec<&VisibilityBlockSummary> = index
+            .blocks
+            .iter()
+            .filter(|b| query.priority_min.map_or(true, |m| b.priority >= m))
+            .filter(|b| query.priority_max.map_or(true, |m| b.priority <= m))
+            .filter(|b| query.scheduled.map_or(true, |s| b.scheduled == s))
+            .filter(|b| {
+                needle.as_ref().map_or(true, |n| {
+                    needle_id == Some(b.scheduling_block_id)
+                        || b.original_block_id.to_lowercase().contains(n.as_str())
+                        || b.block_name.to_lowercase().contains(n.as_str())
+                })
+            })
+            .collect();
+        rows.sort_by(|a, b| {
+            let ord = compare_keys(
+                (query.sort.key(a), a.scheduling_block_id),
+                (query.sort.key(b), b.scheduling_block_id),
+            );
+            match query.direction {
+                SortDirection::Asc => ord,
+                SortDirection::Desc => ord.reverse(),
+            }
+        });
+        rows.iter().map(|b| b.scheduling_block_id).collect()
+    }
+
+    fn walk(index: &VisibilityBlockIndex, mut query: VisibilityBlocksQuery) -> Vec<i64> {
+        let mut ids = Vec::new();
+        loop {
+            let page = index.page(&query);
+            assert!(page.blocks.len() <= query.limit);
+            ids.extend(page.blocks.iter().map(|b| b.scheduling_block_id));
+            match page.next_cursor {
+                Some(cursor) => query.after = Some(cursor),
+                None => return ids,
+            }
+        }
+    }
+
+    #[test]
+    fn test_keyset_walk_matches_full_sort() {
+        let index = sample();
+        for sort in [
+            VisibilityBlockSort::Priority,
+            VisibilityBlockSort::NumVisibilityPeriods,
+            VisibilityBlockSort::Scheduled,
+        ] {
+            for direction in [SortDirection::Asc, SortDirection::Desc] {
+                let query = VisibilityBlocksQuery {
+                    sort,
+                    direction,
+                    limit: 7,
+                    ..Default::default()
+                };
+                assert_eq!(walk(&index, query.clone()), expected(&index, &query));
+            }
+        }
+    }
+
+    #[test]
+    fn test_filters_and_counts() {
+        let index = sample();
+        let query = VisibilityBlocksQuery {
+            sort: VisibilityBlockSort::Priority,
+            direction: SortDirection::Desc,
+            priority_min: Some(2.0),
+            priority_max: Some(5.0),
+            scheduled: Some(false),
+            search: Some("vEGa".into()),
+            limit: 4,
+            ..Default::default()
+        };
+        let want = expected(&index, &query);
+        assert!(!want.is_empty());
+        assert_eq!(walk(&index, query.clone()), want);
+
+        let first = index.page(&query);
+        assert_eq!(first.matched_count, want.len());
+        assert_eq!(first.total_count, 50);
+        assert_eq!(first.scheduled_count, 16);
+        assert_eq!((first.priority_min, first.priority_max), (0.0, 6.0));
+    }
+
+    #[test]
+    fn test_offset_without_cursor() {
+        let index = sample();
+        let query = VisibilityBlocksQuery {
+            sort: VisibilityBlockSort::NumVisibilityPeriods,
+            offset: 10,
+            limit: 5,
+            ..Default::default()
+        };
+        let page = index.page(&query);
+        let all = expected(&index, &query);
+        let ids: Vec<i64> = page.blocks.iter().map(|b| b.scheduling_block_id).collect();
+        assert_eq!(ids, all[10..15]);
+        // The cursor continues from the offset page.
+        let next = index.page(&VisibilityBlocksQuery {
+            after: page.next_cursor,
+            ..query
+        });
+        assert_eq!(next.blocks[0].scheduling_block_id, all[15]);
+    }
+
+    #[test]
+    fn test_empty_index() {
+        let index = VisibilityBlockIndex::new(vec![]);
+        let page = index.page(&VisibilityBlocksQuery {
+            limit: 10,
+            ..Default::default()
+        });
+        assert!(page.blocks.is_empty());
+        assert_eq!(page.matched_count, 0);
+        assert!(page.next_cursor.is_none());
+    }
+}
@@ -59,6 +59,7 @@ async fn test_factory_invalid_database_url() {
         idle_timeout_sec: 600,
         max_retries: 3,
         retry_delay_ms: 100,
+        bulk_copy: true,
     };
 
     let result = RepositoryFactory::create(RepositoryType::Postgres, Some(&invalid_config)).await;
@@ -21,8 +21,8 @@
 use std::sync::Arc;
 
 use tsi_rust::api::{
-    Constraints, ModifiedJulianDate, Period, Schedule, ScheduleId, SchedulingBlock,
-    SchedulingBlockId,
+    Constraints, InsightsData, ModifiedJulianDate, Period, Schedule, ScheduleId, SchedulingBlock,
+    SchedulingBlockId, SortDirection, VisibilityBlockSort, VisibilityBlocksQuery,
 };
 use tsi_rust::db::repositories::postgres::{PostgresConfig, PostgresRepository};
 use tsi_rust::db::{
@@ -30,7 +30,10 @@ use tsi_rust::db::{
     VisualizationRepository,
 };
 use tsi_rust::qtty::{Degrees, Meters};
+use tsi_rust::services::distributions::get_distribution_data;
+use tsi_rust::services::insights::get_insights_data;
 use tsi_rust::services::validation::{ValidationResult, ValidationStatus};
+use tsi_rust::services::visibility_blocks::VisibilityBlockIndex;
 use tsi_rust::siderust::coordinates::centers::Geodetic;
 use tsi_rust::siderust::coordinates::frames::ECEF;
 
@@ -65,6 +68,33 @@ fn create_test_repo() -> Option<PostgresRepository> {
     }
 }
 
+/// Like [`create_test_repo`], but ingesting per-block rows with batched
+/// `INSERT`s only, as after a rejected `COPY`.
+fn create_insert_only_repo() -> Option<PostgresRepository> {
+    let mut config = get_test_config()?;
+    config.bulk_copy = false;
+    PostgresRepository::new(config).ok()
+}
+
+/// `value` with every database-assigned id removed, so rows stored under
+/// different schedules compare equal.
+fn without_ids(value: serde_json::Value) -> serde_json::Value {
+    match value {
+        serde_json::Value::Object(map) => map
+            .into_iter()
+            .filter(|(key, _)| {
+                !matches!(
+                    key.as_str(),
+                    "id" | "schedule_id" | "block_id" | "scheduling_block_id"
+                )
+            })
+            .map(|(key, v)| (key, without_ids(v)))
+            .collect(),
+        serde_json::Value::Array(items) => items.into_iter().map(without_ids).collect(),
+        other => other,
+    }
+}
+
 /// Helper to create a test schedule with blocks.
 fn create_test_schedule(name: &str, checksum: &str, num_blocks: usize) -> Schedule {
     let dark_periods = vec![Period {
@@ -540,6 +570,190 @@ async fn test_postgres_fetch_insights_blocks() {
     assert_eq!(unscheduled_blocks.len(), 2);
 }
 
+/// Asserts `left` and `right` are equal up to floating-point rounding in
+/// their numbers.
+fn assert_json_close(left: &serde_json::Value, right: &serde_json::Value, path: &str) {
+    use serde_json::Value;
+    match (left, right) {
+        (Value::Number(a), Value::Number(b)) => {
+            let (a, b) = (a.as_f64().unwrap(), b.as_f64().unwrap());
+            let tolerance = 1e-9 * a.abs().max(b.abs()).max(1.0);
+            assert!((a - b).abs() <= tolerance, "{}: {} != {}", path, a, b);
+        }
+        (Value::Array(a), Value::Array(b)) => {
+            assert_eq!(a.len(), b.len(), "{}: length", path);
+            for (i, (a, b)) in a.iter().zip(b).enumerate() {
+                assert_json_close(a, b, &format!("{}[{}]", path, i));
+            }
+        }
+        (Value::Object(a), Value::Object(b)) => {
+            let mut keys: Vec<_> = a.keys().chain(b.keys()).collect();
+            keys.sort();
+            keys.dedup();
+            for key in keys {
+                assert_json_close(
+                    a.get(key).unwrap_or(&Value::Null),
+                    b.get(key).unwrap_or(&Value::Null),
+                    &format!("{}.{}", path, key),
+                );
+            }
+        }
+        _ => assert_eq!(left, right, "{}", path),
+    }
+}
+
+/// A schedule whose analysed columns repeat values, so medians, average
+/// ranks and top lists see ties, and whose priorities and requested hours
+/// fall on the edges of a 4-bin histogram. Even blocks are scheduled in
+/// overlapping slots; the last block has no visibility and is left out.
+fn create_aggregate_schedule(checksum: &str) -> Schedule {
+    let mut schedule = create_test_schedule("Aggregate Parity", checksum, 26);
+    for (i, block) in schedule.blocks.iter_mut().enumerate() {
+        block.priority = (i % 5) as f64;
+        block.requested_duration = (3600.0 * (1 + i % 3) as f64).into();
+        block.visibility_periods = vec![Period {
+            start: ModifiedJulianDate::new(60000.0),
+            end: ModifiedJulianDate::new(60000.0 + 0.1 * (1 + i % 5) as f64),
+        }];
+        if let Some(period) = block.scheduled_period.as_mut() {
+            let start = 60000.01 + 0.01 * (i / 4) as f64;
+            period.start = ModifiedJulianDate::new(start);
+            period.end = ModifiedJulianDate::new(start + 3600.0 / 86400.0);
+        }
+    }
+    schedule.blocks[25].visibility_periods.clear();
+    schedule
+}
+
+/// Orders the top lists and conflicts of `data` by block id. The service
+/// keeps the fetch order among equal keys, which SQL leaves unspecified.
+fn sort_insights_lists(data: &mut InsightsData) {
+    for top in [&mut data.top_priority, &mut data.top_visibility] {
+        top.sort_by_key(|o| o.scheduling_block_id);
+    }
+    data.conflicts
+        .sort_by(|a, b| (&a.block_id_1, &a.block_id_2).cmp(&(&b.block_id_1, &b.block_id_2)));
+}
+
+#[tokio::test]
+async fn test_postgres_distribution_summary_matches_rust_path() {
+    let Some(repo) = create_test_repo() else {
+        return;
+    };
+
+    let checksum = unique_checksum("distribution_parity");
+    let schedule_id = repo
+        .store_schedule(&create_aggregate_schedule(&checksum))
+        .await
+        .expect("Should store schedule")
+        .schedule_id;
+
+    for bins in [None, Some(1), Some(4), Some(7)] {
+        // Without blocks the repository aggregates in SQL; with them the
+        // service computes the same data in Rust.
+        let sql = get_distribution_data(&repo, schedule_id, bins, false)
+            .await
+            .expect("Should aggregate distribution in SQL");
+        let mut rust = get_distribution_data(&repo, schedule_id, bins, true)
+            .await
+            .expect("Should compute distribution in Rust");
+        assert_eq!(rust.blocks.len(), 25);
+        rust.blocks.clear();
+
+        assert_json_close(
+            &serde_json::to_value(&sql).unwrap(),
+            &serde_json::to_value(&rust).unwrap(),
+            &format!("bins={:?}", bins),
+        );
+    }
+}
+
+#[tokio::test]
+async fn test_postgres_insights_summary_matches_rust_path() {
+    let Some(repo) = create_test_repo() else {
+        return;
+    };
+
+    let checksum = unique_checksum("insights_parity");
+    let schedule_id = repo
+        .store_schedule(&create_aggregate_schedule(&checksum))
+        .await
+        .expect("Should store schedule")
+        .schedule_id;
+
+    let sql = get_insights_data(&repo, schedule_id, false)
+        .await
+        .expect("Should aggregate insights in SQL");
+    let mut rust = get_insights_data(&repo, schedule_id, true)
+        .await
+        .expect("Should compute insights in Rust");
+    assert_eq!(rust.blocks.len(), 25);
+    rust.blocks.clear();
+
+    assert!(!sql.conflicts.is_empty());
+    assert!(sql.correlations.iter().any(|c| c.correlation != 0.0));
+    let mut sql = sql;
+    sort_insights_lists(&mut sql);
+    sort_insights_lists(&mut rust);
+
+    assert_json_close(
+        &serde_json::to_value(&sql).unwrap(),
+        &serde_json::to_value(&rust).unwrap(),
+        "insights",
+    );
+}
+
+#[tokio::test]
+async fn test_postgres_copy_and_insert_ingest_store_the_same_rows() {
+    let (Some(copy_repo), Some(insert_repo)) = (create_test_repo(), create_insert_only_repo())
+    else {
+        return;
+    };
+
+    // Blocks with and without a fixed time and a scheduled period, so both
+    // paths write NULLs as well as values.
+    let mut schedule = create_test_schedule("Ingest Parity", "", 6);
+    schedule.blocks[1].constraints.fixed_time = Some(Period {
+        start: ModifiedJulianDate::new(60000.2),
+        end: ModifiedJulianDate::new(60000.4),
+    });
+    schedule.blocks[3].visibility_periods.clear();
+
+    let mut stored = Vec::new();
+    for (repo, path) in [(&copy_repo, "copy"), (&insert_repo, "insert")] {
+        schedule.checksum = unique_checksum(&format!("ingest_{}", path));
+        let schedule_id = repo
+            .store_schedule(&schedule)
+            .await
+            .expect("Should store schedule")
+            .schedule_id;
+        repo.populate_schedule_analytics(schedule_id)
+            .await
+            .expect("Should populate analytics");
+
+        let blocks = repo
+            .get_blocks_for_schedule(schedule_id)
+            .await
+            .expect("Should get blocks");
+        let insights = repo
+            .fetch_analytics_blocks_for_insights(schedule_id)
+            .await
+            .expect("Should fetch insights blocks");
+        let report = repo
+            .fetch_validation_results(schedule_id)
+            .await
+            .expect("Should fetch validation results");
+        stored.push(without_ids(serde_json::json!({
+            "blocks": blocks,
+            "insights": insights,
+            "validation": report,
+        })));
+    }
+
+    assert_eq!(stored[0]["blocks"].as_array().map(Vec::len), Some(6));
+    assert_eq!(stored[0], stored[1]);
+}
+
 // ============================================================================
 // Validation Tests
 // ============================================================================
@@ -743,6 +957,93 @@ async fn test_postgres_fetch_visibility_map_data() {
     assert_eq!(data.blocks.len(), 5);
 }
 
+/// Every page of `query` from `repo`, concatenated as block ids.
+async fn walk_visibility_pages(
+    repo: &PostgresRepository,
+    schedule_id: ScheduleId,
+    mut query: VisibilityBlocksQuery,
+) -> Vec<i64> {
+    let mut ids = Vec::new();
+    loop {
+        let page = repo
+            .fetch_visibility_blocks_page(schedule_id, &query)
+            .await
+            .expect("Should fetch visibility page");
+        assert!(page.blocks.len() <= query.limit);
+        ids.extend(page.blocks.iter().map(|b| b.scheduling_block_id));
+        match page.next_cursor {
+            Some(cursor) => query.after = Some(cursor),
+            None => return ids,
+        }
+    }
+}
+
+#[tokio::test]
+async fn test_postgres_visibility_page_keyset_walk_matches_index() {
+    let Some(repo) = create_test_repo() else {
+        return;
+    };
+
+    // Tied keys under every sort, and priorities that are not exact in
+    // binary so the cursor key must round-trip through the f64 parameter.
+    let checksum = unique_checksum("visibility_keyset");
+    let mut schedule = create_test_schedule("Visibility Keyset Test", &checksum, 23);
+    for (i, block) in schedule.blocks.iter_mut().enumerate() {
+        block.priority = 0.1 * (i % 4) as f64 + 0.2;
+        let first = block.visibility_periods[0].clone();
+        block.visibility_periods = vec![first; i % 3 + 1];
+    }
+
+    let schedule_id = repo
+        .store_schedule(&schedule)
+        .await
+        .expect("Should store schedule")
+        .schedule_id;
+    repo.populate_schedule_analytics(schedule_id)
+        .await
+        .expect("Should populate analytics");
+
+    let data = repo
+        .fetch_visibility_map_data(schedule_id)
+        .await
+        .expect("Should fetch visibility map data");
+    let index = VisibilityBlockIndex::new(data.blocks);
+
+    for sort in [
+        VisibilityBlockSort::Priority,
+        VisibilityBlockSort::NumVisibilityPeriods,
+        VisibilityBlockSort::Scheduled,
+    ] {
+        for direction in [SortDirection::Asc, SortDirection::Desc] {
+            let query = VisibilityBlocksQuery {
+                sort,
+                direction,
+                limit: 4,
+                ..Default::default()
+            };
+            let mut expected = Vec::new();
+            let mut index_query = query.clone();
+            loop {
+                let page = index.page(&index_query);
+                expected.extend(page.blocks.iter().map(|b| b.scheduling_block_id));
+                match page.next_cursor {
+                    Some(cursor) => index_query.after = Some(cursor),
+                    None => break,
+                }
+            }
+
+            assert_eq!(expected.len(), 23);
+            assert_eq!(
+                walk_visibility_pages(&repo, schedule_id, query).await,
+                expected,
+                "{:?} {:?}",
+                sort,
+                direction
+            );
+        }
+    }
+}
+
 #[tokio::test]
 async fn test_postgres_fetch_histogram_blocks() {
     let Some(repo) = create_test_repo() else {
@@ -776,6 +1077,90 @@ async fn test_postgres_fetch_histogram_blocks() {
     assert!(filtered.len() < 10, "Filter should reduce results");
 }
 
+// ============================================================================
+// Async Read Path Tests
+// ============================================================================
+
+#[cfg(feature = "postgres-async")]
+#[tokio::test]
+async fn test_postgres_async_reads_match_diesel() {
+    let (Some(repo), Some(diesel_repo)) = (create_test_repo(), create_test_repo()) else {
+        return;
+    };
+    let diesel_repo = diesel_repo.without_async_reads();
+
+    // A fixed-time window and a block without visibility, so the nullable
+    // columns are read both ways.
+    let checksum = unique_checksum("async_reads");
+    let mut schedule = create_test_schedule("Async Reads Test", &checksum, 9);
+    schedule.blocks[2].constraints.fixed_time = Some(Period {
+        start: ModifiedJulianDate::new(60000.2),
+        end: ModifiedJulianDate::new(60000.4),
+    });
+    schedule.blocks[5].visibility_periods.clear();
+
+    let schedule_id = repo
+        .store_schedule(&schedule)
+        .await
+        .expect("Should store schedule")
+        .schedule_id;
+    repo.populate_schedule_analytics(schedule_id)
+        .await
+        .expect("Should populate analytics");
+
+    // Debug output spells out every field, floats included, exactly.
+    let columns = repo
+        .get_schedule_columns(schedule_id)
+        .await
+        .expect("Should read columns async");
+    let diesel_columns = diesel_repo
+        .get_schedule_columns(schedule_id)
+        .await
+        .expect("Should read columns with diesel");
+    assert_eq!(columns.len(), 9);
+    assert_eq!(format!("{:?}", columns), format!("{:?}", diesel_columns));
+
+    // Neither path orders the timeline or compare rows.
+    let mut timeline = repo
+        .fetch_schedule_timeline_blocks(schedule_id)
+        .await
+        .expect("Should read timeline async");
+    let mut diesel_timeline = diesel_repo
+        .fetch_schedule_timeline_blocks(schedule_id)
+        .await
+        .expect("Should read timeline with diesel");
+    for blocks in [&mut timeline, &mut diesel_timeline] {
+        blocks.sort_by_key(|b| b.scheduling_block_id);
+    }
+    assert!(!timeline.is_empty());
+    assert_eq!(format!("{:?}", timeline), format!("{:?}", diesel_timeline));
+
+    let mut compare = repo
+        .fetch_compare_blocks(schedule_id)
+        .await
+        .expect("Should read compare blocks async");
+    let mut diesel_compare = diesel_repo
+        .fetch_compare_blocks(schedule_id)
+        .await
+        .expect("Should read compare blocks with diesel");
+    for blocks in [&mut compare, &mut diesel_compare] {
+        blocks.sort_by(|a, b| a.scheduling_block_id.cmp(&b.scheduling_block_id));
+    }
+    assert_eq!(compare.len(), 9);
+    assert_eq!(format!("{:?}", compare), format!("{:?}", diesel_compare));
+
+    let gaps = repo
+        .fetch_gap_metrics(schedule_id)
+        .await
+        .expect("Should read gap metrics async");
+    let diesel_gaps = diesel_repo
+        .fetch_gap_metrics(schedule_id)
+        .await
+        .expect("Should read gap metrics with diesel");
+    assert!(gaps.0.is_some());
+    assert_eq!(format!("{:?}", gaps), format!("{:?}", diesel_gaps));
+}
+
 // ============================================================================
 // Concurrent Access Tests
 // ============================================================================
@@ -248,6 +248,7 @@ fn test_distribution_data_creation() {
         scheduled_count: 0,
         unscheduled_count: 0,
         impossible_count: 0,
+        histograms: None,
     };
     assert_eq!(data.total_count, 0);
 }
@@ -430,6 +431,7 @@ fn test_sky_map_data_creation() {
         scheduled_count: 0,
         scheduled_time_min: None,
         scheduled_time_max: None,
+        density: None,
     };
     assert_eq!(data.priority_min, 0.0);
     assert_eq!(data.total_count, 0);
@@ -466,6 +468,7 @@ fn test_schedule_timeline_data_creation() {
         scheduled_count: 0,
         unique_months: vec![],
         dark_periods: vec![],
+        layout: Default::default(),
     };
     assert_eq!(data.total_count, 0);
     assert_eq!(data.scheduled_count, 0);
@@ -211,3 +211,83 @@ async fn test_idempotent_store() {
     // LocalRepository doesn't dedupe by checksum, so we have 2 schedules
     assert!(!schedules.is_empty());
 }
+
+#[tokio::test]
+async fn test_dashboard_matches_standalone_services() {
+    use tsi_rust::services::dashboard::{get_dashboard_data, DashboardOptions};
+    use tsi_rust::services::{distributions, insights};
+
+    let repo = LocalRepository::new();
+    let mut schedule = create_schedule_with_blocks("dashboard", 6);
+    for (i, block) in schedule.blocks.iter_mut().enumerate() {
+        let start = 60000.0 + i as f64 * 0.1;
+        block.priority = i as f64;
+        block.visibility_periods = vec![Period {
+            start: ModifiedJulianDate::new(start),
+            end: ModifiedJulianDate::new(start + 0.05 * (i + 1) as f64),
+        }];
+        if i % 2 == 0 {
+            block.scheduled_period = Some(Period {
+                start: ModifiedJulianDate::new(start),
+                end: ModifiedJulianDate::new(start + 0.02),
+            });
+        }
+    }
+    let schedule_id = store_schedule(&repo, &schedule).await.unwrap().schedule_id;
+
+    let options = DashboardOptions {
+        distribution_bins: Some(4),
+        ..DashboardOptions::default()
+    };
+    let dashboard = get_dashboard_data(&repo, schedule_id, options)
+        .await
+        .unwrap();
+
+    let standalone = distributions::get_distribution_data(&repo, schedule_id, Some(4), false)
+        .await
+        .unwrap();
+    assert_eq!(dashboard.distributions.total_count, standalone.total_count);
+    assert_eq!(
+        dashboard.distributions.priority_stats.mean,
+        standalone.priority_stats.mean
+    );
+    assert_eq!(
+        dashboard
+            .distributions
+            .histograms
+            .as_ref()
+            .unwrap()
+            .priority
+            .scheduled,
+        standalone.histograms.unwrap().priority.scheduled
+    );
+
+    let standalone = insights::get_insights_data(&repo, schedule_id, false)
+        .await
+        .unwrap();
+    assert!(dashboard.insights.blocks.is_empty());
+    assert_eq!(
+        dashboard.insights.metrics.scheduled_count,
+        standalone.metrics.scheduled_count
+    );
+    assert_eq!(dashboard.kpis.scheduled_count, standalone.scheduled_count);
+    assert_eq!(dashboard.sky_map.total_count, 6);
+
+    let sections: Vec<&str> = dashboard
+        .timings
+        .iter()
+        .map(|t| t.section.as_str())
+        .collect();
+    assert_eq!(
+        sections,
+        [
+            "load",
+            "sky_map",
+            "distributions",
+            "insights",
+            "trends",
+            "fragmentation",
+            "kpis"
+        ]
+    );
+}
@@ -11,9 +11,13 @@ import type {
   JobStatusResponse,
   HealthResponse,
   SkyMapData,
+  SkyMapQuery,
+  DashboardQuery,
   DistributionData,
+  DistributionsQuery,
   ScheduleTimelineData,
   InsightsData,
+  InsightsQuery,
   FragmentationData,
   AlgorithmTraceResponse,
   AltAzData,
@@ -24,6 +28,8 @@ import type {
   CompareData,
   CompareQuery,
   VisibilityMapData,
+  VisibilityBlocksPage,
+  VisibilityBlocksQuery,
   VisibilityBin,
   VisibilityHistogramQuery,
   ApiError as ApiErrorResponse,
@@ -38,6 +44,7 @@ import type {
   BulkImportRequest,
   BulkImportResponse,
   DeleteEnvironmentResponse,
+  ScheduleDashboard,
   ScheduleKpi,
   EnvironmentKpisResponse,
 } from './types';
@@ -49,12 +56,35 @@ import {
   ServerError,
   RateLimitError,
 } from './errors';
+import { scheduleIdsFromUrl, type ResponseStore } from './responseCache';
 
 // Base URL - use /api prefix for both dev (proxy) and prod (creates consistency with nginx)
 const BASE_URL = '/api';
 
+function serializeParams(params?: object): string {
+  const searchParams = new URLSearchParams();
+
+  Object.entries(params ?? {}).forEach(([key, value]) => {
+    if (value === undefined || value === null) {
+      return;
+    }
+
+    if (Array.isArray(value)) {
+      if (value.length > 0) {
+        searchParams.set(key, value.map(String).join(','));
+      }
+      return;
+    }
+
+    searchParams.append(key, String(value));
+  });
+
+  return searchParams.toString();
+}
+
 class ApiClient {
   private client: AxiosInstance;
+  private responseStore: ResponseStore | null = null;
 
   constructor() {
     this.client = axios.create({
@@ -62,26 +92,7 @@ class ApiClient {
       headers: {
         'Content-Type': 'application/json',
       },
-      paramsSerializer: (params) => {
-        const searchParams = new URLSearchParams();
-
-        Object.entries(params ?? {}).forEach(([key, value]) => {
-          if (value === undefined || value === null) {
-            return;
-          }
-
-          if (Array.isArray(value)) {
-            if (value.length > 0) {
-              searchParams.set(key, value.map(String).join(','));
-            }
-            return;
-          }
-
-          searchParams.append(key, String(value));
-        });
-
-        return searchParams.toString();
-      },
+      paramsSerializer: serializeParams,
     });
 
     // Response interceptor for error handling with typed errors
@@ -123,6 +134,58 @@ class ApiClient {
     );
   }
 
+  /**
+   * Persist schedule analytics responses in `store` and revalidate them by
+   * ETag, so reopening a schedule reuses the stored payloads after a 304.
+   */
+  setResponseStore(store: ResponseStore | null): void {
+    this.responseStore = store;
+  }
+
+  /**
+   * GET a schedule analytics endpoint, sending the stored response's ETag
+   * and replaying its body when the server answers 304.  Store failures
+   * only ever cost a full download.
+   */
+  private async getConditional<T>(url: string, params?: object, signal?: AbortSignal): Promise<T> {
+    const store = this.responseStore;
+    const query = serializeParams(params);
+    const key = query ? `${url}?${query}` : url;
+    const cached = store ? await store.get(key).catch(() => undefined) : undefined;
+
+    const response = await this.client.get<T>(url, {
+      params,
+      signal,
+      headers: cached ? { 'If-None-Match': cached.etag } : undefined,
+      validateStatus: (status) =>
+        (status >= 200 && status < 300) || (cached !== undefined && status === 304),
+    });
+    if (cached && response.status === 304) {
+      // Refreshing `storedAt` keeps eviction least-recently-used.
+      store?.put({ ...cached, storedAt: Date.now() }).catch(() => undefined);
+      return cached.data as T;
+    }
+
+    const etag = response.headers.etag;
+    if (store && typeof etag === 'string') {
+      const scheduleIds = scheduleIdsFromUrl(url);
+      store
+        .put({ key, scheduleIds, etag, data: response.data, storedAt: Date.now() })
+        .then(() =>
+          scheduleIds.length === 1 ? store.deleteSuperseded(scheduleIds[0], etag) : undefined
+        )
+        .catch(() => undefined);
+    }
+    return response.data;
+  }
+
+  /** Drop stored responses of schedules the user just changed. */
+  private async forgetSchedules(scheduleIds: number[]): Promise<void> {
+    const store = this.responseStore;
+    if (!store) return;
+    await Promise.all(scheduleIds.map((id) => store.deleteSchedule(id).catch(() => undefined)));
+  }
+
   // Health check
   async getHealth(): Promise<HealthResponse> {
     const { data } = await this.client.get<HealthResponse>('/health');
@@ -166,6 +229,7 @@ class ApiClient {
     const { data } = await this.client.delete<DeleteScheduleResponse>(
       `/v1/schedules/${scheduleId}`
     );
+    await this.forgetSchedules([scheduleId]);
     return data;
   }
 
@@ -174,40 +238,60 @@ class ApiClient {
       '/v1/schedules/bulk-delete',
       { schedule_ids: scheduleIds } satisfies BulkDeleteSchedulesRequest
     );
+    await this.forgetSchedules(scheduleIds);
     return data;
   }
 
   async updateSchedule(scheduleId: number, request: UpdateScheduleRequest): Promise<ScheduleInfo> {
     const { data } = await this.client.patch<ScheduleInfo>(`/v1/schedules/${scheduleId}`, request);
+    await this.forgetSchedules([scheduleId]);
     return data;
   }
 
   // Visualization endpoints
-  async getSkyMap(scheduleId: number, init?: { signal?: AbortSignal }): Promise<SkyMapData> {
-    const { data } = await this.client.get<SkyMapData>(`/v1/schedules/${scheduleId}/sky-map`, {
-      signal: init?.signal,
-    });
-    return data;
+  async getSkyMap(
+    scheduleId: number,
+    query?: SkyMapQuery,
+    init?: { signal?: AbortSignal }
+  ): Promise<SkyMapData> {
+    return this.getConditional<SkyMapData>(
+      `/v1/schedules/${scheduleId}/sky-map`,
+      query,
+      init?.signal
+    );
   }
 
   async getDistributions(
     scheduleId: number,
+    query?: DistributionsQuery,
     init?: { signal?: AbortSignal }
   ): Promise<DistributionData> {
-    const { data } = await this.client.get<DistributionData>(
+    return this.getConditional<DistributionData>(
       `/v1/schedules/${scheduleId}/distributions`,
-      { signal: init?.signal }
+      query,
+      init?.signal
     );
-    return data;
   }
 
   async getVisibilityMap(
     scheduleId: number,
     init?: { signal?: AbortSignal }
   ): Promise<VisibilityMapData> {
-    const { data } = await this.client.get<VisibilityMapData>(
+    return this.getConditional<VisibilityMapData>(
       `/v1/schedules/${scheduleId}/visibility-map`,
-      { signal: init?.signal }
+      undefined,
+      init?.signal
+    );
+  }
+
+  async getVisibilityBlocks(
+    scheduleId: number,
+    query?: VisibilityBlocksQuery,
+    init?: { signal?: AbortSignal }
+  ): Promise<VisibilityBlocksPage> {
+    const { data } = await this.client.get<VisibilityBlocksPage>(
+      `/v1/schedules/${scheduleId}/visibility-map/blocks`,
+      { params: query, signal: init?.signal }
     );
     return data;
   }
@@ -217,49 +301,62 @@ class ApiClient {
     query?: VisibilityHistogramQuery,
     init?: { signal?: AbortSignal }
   ): Promise<VisibilityBin[]> {
-    const { data } = await this.client.get<VisibilityBin[]>(
+    return this.getConditional<VisibilityBin[]>(
       `/v1/schedules/${scheduleId}/visibility-histogram`,
-      { params: query, signal: init?.signal }
+      query,
+      init?.signal
     );
-    return data;
   }
 
   async getTimeline(
     scheduleId: number,
     init?: { signal?: AbortSignal }
   ): Promise<ScheduleTimelineData> {
-    const { data } = await this.client.get<ScheduleTimelineData>(
+    return this.getConditional<ScheduleTimelineData>(
       `/v1/schedules/${scheduleId}/timeline`,
-      { signal: init?.signal }
+      undefined,
+      init?.signal
     );
-    return data;
   }
 
   async getInsights(
     scheduleId: number,
+    query?: InsightsQuery,
     init?: { signal?: AbortSignal }
   ): Promise<InsightsData> {
-    const { data } = await this.client.get<InsightsData>(
+    return this.getConditional<InsightsData>(
       `/v1/schedules/${scheduleId}/insights`,
-      { signal: init?.signal }
+      query,
+      init?.signal
     );
-    return data;
   }
 
   async getFragmentation(
     scheduleId: number,
     init?: { signal?: AbortSignal }
   ): Promise<FragmentationData> {
-    const { data } = await this.client.get<FragmentationData>(
+    return this.getConditional<FragmentationData>(
       `/v1/schedules/${scheduleId}/fragmentation`,
-      { signal: init?.signal }
+      undefined,
+      init?.signal
     );
-    return data;
   }
 
   async getScheduleKpis(scheduleId: number): Promise<ScheduleKpi> {
-    const { data } = await this.client.get<ScheduleKpi>(`/v1/schedules/${scheduleId}/kpis`);
-    return data;
+    return this.getConditional<ScheduleKpi>(`/v1/schedules/${scheduleId}/kpis`);
+  }
+
+  /** Sky map, distributions, insights, trends, fragmentation and KPIs in one request. */
+  async getScheduleDashboard(
+    scheduleId: number,
+    query?: DashboardQuery,
+    init?: { signal?: AbortSignal }
+  ): Promise<ScheduleDashboard> {
+    return this.getConditional<ScheduleDashboard>(
+      `/v1/schedules/${scheduleId}/dashboard`,
+      query,
+      init?.signal
+    );
   }
 
   async getEnvironmentKpis(environmentId: number): Promise<EnvironmentKpisResponse> {
@@ -273,11 +370,11 @@ class ApiClient {
     scheduleId: number,
     init?: { signal?: AbortSignal }
   ): Promise<AlgorithmTraceResponse> {
-    const { data } = await this.client.get<AlgorithmTraceResponse>(
+    return this.getConditional<AlgorithmTraceResponse>(
       `/v1/schedules/${scheduleId}/algorithm_trace`,
-      { signal: init?.signal }
+      undefined,
+      init?.signal
     );
-    return data;
   }
 
   async computeAltAz(
@@ -298,22 +395,22 @@ class ApiClient {
     query?: TrendsQuery,
     init?: { signal?: AbortSignal }
   ): Promise<TrendsData> {
-    const { data } = await this.client.get<TrendsData>(`/v1/schedules/${scheduleId}/trends`, {
-      params: query,
-      signal: init?.signal,
-    });
-    return data;
+    return this.getConditional<TrendsData>(
+      `/v1/schedules/${scheduleId}/trends`,
+      query,
+      init?.signal
+    );
   }
 
   async getValidationReport(
     scheduleId: number,
     init?: { signal?: AbortSignal }
   ): Promise<ValidationReport> {
-    const { data } = await this.client.get<ValidationReport>(
+    return this.getConditional<ValidationReport>(
       `/v1/schedules/${scheduleId}/validation-report`,
-      { signal: init?.signal }
+      undefined,
+      init?.signal
     );
-    return data;
   }
 
   async compareSchedules(
@@ -322,11 +419,11 @@ class ApiClient {
     query?: CompareQuery,
     init?: { signal?: AbortSignal }
   ): Promise<CompareData> {
-    const { data } = await this.client.get<CompareData>(
+    return this.getConditional<CompareData>(
       `/v1/schedules/${scheduleId}/compare/${otherId}`,
-      { params: query, signal: init?.signal }
+      query,
+      init?.signal
     );
-    return data;
   }
 
   // Job management
@@ -375,6 +472,7 @@ class ApiClient {
     const { data } = await this.client.delete<DeleteEnvironmentResponse>(
       `/v1/schedules/${scheduleId}/environment`
     );
+    await this.forgetSchedules([scheduleId]);
     return data;
   }
 }
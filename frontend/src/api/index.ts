@@ -1,3 +1,9 @@
 export * from './types';
 export * from './errors';
 export { api, default as ApiClient } from './client';
+export {
+  createIndexedDbStore,
+  createMemoryStore,
+  type CachedResponse,
+  type ResponseStore,
+} from './responseCache';
@@ -0,0 +1,79 @@
+import { describe, expect, it } from 'vitest';
+import { createMemoryStore, scheduleIdsFromUrl } from './responseCache';
+
+describe('responseCache', () => {
+  it('extracts the schedules a request path reads', () => {
+    expect(scheduleIdsFromUrl('/v1/schedules/12/insights')).toEqual([12]);
+    expect(scheduleIdsFromUrl('/v1/schedules/12/compare/34')).toEqual([12, 34]);
+    expect(scheduleIdsFromUrl('/v1/environments/3/kpis')).toEqual([]);
+  });
+
+  it('drops every response built from a deleted schedule', async () => {
+    const store = createMemoryStore();
+    const entry = (key: string, scheduleIds: number[]) => ({
+      key,
+      scheduleIds,
+      etag: 'W/"1"',
+      data: { key },
+      storedAt: 0,
+    });
+    await store.put(entry('/v1/schedules/1/insights', [1]));
+    await store.put(entry('/v1/schedules/2/compare/1', [2, 1]));
+    await store.put(entry('/v1/schedules/2/insights', [2]));
+
+    await store.deleteSchedule(1);
+
+    expect(await store.get('/v1/schedules/1/insights')).toBeUndefined();
+    expect(await store.get('/v1/schedules/2/compare/1')).toBeUndefined();
+    expect((await store.get('/v1/schedules/2/insights'))?.data).toEqual({
+      key: '/v1/schedules/2/insights',
+    });
+  });
+
+  it('expires stale entries and evicts the least recently stored beyond the cap', async () => {
+    let now = 10_000;
+    const store = createMemoryStore({ maxEntries: 2, maxAgeMs: 5_000 }, () => now);
+    const entry = (key: string, storedAt: number) => ({
+      key,
+      scheduleIds: [1],
+      etag: 'W/"1.1"',
+      data: null,
+      storedAt,
+    });
+    await store.put(entry('stale', 4_000));
+    await store.put(entry('a', 9_000));
+    expect(await store.get('stale')).toBeUndefined();
+
+    await store.put(entry('b', 9_500));
+    await store.put(entry('a', 10_000));
+    await store.put(entry('c', 10_000));
+    expect(await store.get('b')).toBeUndefined();
+    expect(await store.get('a')).toBeDefined();
+    expect(await store.get('c')).toBeDefined();
+
+    now = 20_000;
+    await store.put(entry('d', now));
+    expect(await store.get('a')).toBeUndefined();
+    expect(await store.get('d')).toBeDefined();
+  });
+
+  it('drops single-schedule responses stored under a superseded tag', async () => {
+    const store = createMemoryStore();
+    const entry = (key: string, scheduleIds: number[], etag: string) => ({
+      key,
+      scheduleIds,
+      etag,
+      data: null,
+      storedAt: Date.now(),
+    });
+    await store.put(entry('/v1/schedules/1/trends', [1], 'W/"1.1"'));
+    await store.put(entry('/v1/schedules/1/compare/2', [1, 2], 'W/"1.1-2.1"'));
+    await store.put(entry('/v1/schedules/1/insights', [1], 'W/"1.2"'));
+
+    await store.deleteSuperseded(1, 'W/"1.2"');
+
+    expect(await store.get('/v1/schedules/1/trends')).toBeUndefined();
+    expect(await store.get('/v1/schedules/1/compare/2')).toBeDefined();
+    expect(await store.get('/v1/schedules/1/insights')).toBeDefined();
+  });
+});
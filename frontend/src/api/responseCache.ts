@@ -0,0 +1,182 @@
+/**
+ * Persistent store for schedule analytics responses.
+ *
+ * The backend tags every analytics payload with an ETag built from a
+ * per-schedule version that changes whenever data derived from the schedule
+ * is written, so a stored response stays usable across page reloads: the
+ * client replays it after a `304 Not Modified` instead of downloading it
+ * again.  Entries are indexed by the schedule ids they belong to so a
+ * mutation can drop them.
+ *
+ * The store is bounded: entries unused for `maxAgeMs` expire, the least
+ * recently used ones are evicted beyond `maxEntries`, and a new tag for a
+ * schedule drops its responses stored under older tags.
+ */
+
+/** One stored response, keyed by request URL and query string. */
+export interface CachedResponse {
+  key: string;
+  scheduleIds: number[];
+  etag: string;
+  data: unknown;
+  /** When the entry was stored or last revalidated (ms since epoch). */
+  storedAt: number;
+}
+
+export interface ResponseStore {
+  get(key: string): Promise<CachedResponse | undefined>;
+  /** Store or refresh `entry`, then evict expired and excess entries. */
+  put(entry: CachedResponse): Promise<void>;
+  /** Drop every response built from `scheduleId`. */
+  deleteSchedule(scheduleId: number): Promise<void>;
+  /**
+   * Drop responses built from `scheduleId` alone whose tag is not `etag`;
+   * the server will never answer 304 for them again.
+   */
+  deleteSuperseded(scheduleId: number, etag: string): Promise<void>;
+}
+
+export interface ResponseStoreLimits {
+  maxEntries: number;
+  maxAgeMs: number;
+}
+
+export const DEFAULT_RESPONSE_STORE_LIMITS: ResponseStoreLimits = {
+  maxEntries: 300,
+  maxAgeMs: 14 * 24 * 60 * 60 * 1000,
+};
+
+const DB_NAME = 'tsi-response-cache';
+/**
+ * Bump with the server's `RESPONSE_FORMAT` whenever a stored endpoint's
+ * payload shape changes: upgrading drops every stored entry.  Version 2
+ * added the `storedAt` index; version 3 retires payloads stored before
+ * tags carried the response format.
+ */
+const DB_VERSION = 3;
+const STORE_NAME = 'responses';
+const SCHEDULE_INDEX = 'scheduleIds';
+const STORED_AT_INDEX = 'storedAt';
+
+const isSuperseded = (entry: CachedResponse, scheduleId: number, etag: string) =>
+  entry.scheduleIds.length === 1 && entry.scheduleIds[0] === scheduleId && entry.etag !== etag;
+
+/** Schedule ids named in an API path (`/v1/schedules/{id}/…/compare/{other}`). */
+export function scheduleIdsFromUrl(url: string): number[] {
+  const match = /\/schedules\/(\d+)(?:\/compare\/(\d+))?/.exec(url);
+  if (!match) return [];
+  return match.slice(1).filter(Boolean).map(Number);
+}
+
+function promisify<T>(request: IDBRequest<T>): Promise<T> {
+  return new Promise((resolve, reject) => {
+    request.onsuccess = () => resolve(request.result);
+    request.onerror = () => reject(request.error);
+  });
+}
+
+/**
+ * IndexedDB-backed store, or null where IndexedDB is unavailable (tests,
+ * some private browsing modes).  Failures surface as rejected promises;
+ * callers treat them as cache misses.
+ */
+export function createIndexedDbStore(
+  name = DB_NAME,
+  limits: ResponseStoreLimits = DEFAULT_RESPONSE_STORE_LIMITS
+): ResponseStore | null {
+  if (typeof indexedDB === 'undefined') return null;
+
+  let dbPromise: Promise<IDBDatabase> | null = null;
+  const open = () => {
+    dbPromise ??= new Promise<IDBDatabase>((resolve, reject) => {
+      const request = indexedDB.open(name, DB_VERSION);
+      request.onupgradeneeded = () => {
+        const db = request.result;
+        // Entries from an older version may hold payload shapes this build
+        // no longer reads.
+        if (db.objectStoreNames.contains(STORE_NAME)) db.deleteObjectStore(STORE_NAME);
+        const store = db.createObjectStore(STORE_NAME, { keyPath: 'key' });
+        store.createIndex(SCHEDULE_INDEX, 'scheduleIds', { multiEntry: true });
+        store.createIndex(STORED_AT_INDEX, 'storedAt');
+      };
+      request.onsuccess = () => resolve(request.result);
+      request.onerror = () => {
+        dbPromise = null;
+        reject(request.error);
+      };
+    });
+    return dbPromise;
+  };
+
+  const transaction = async (mode: IDBTransactionMode) =>
+    (await open()).transaction(STORE_NAME, mode).objectStore(STORE_NAME);
+
+  return {
+    async get(key) {
+      const store = await transaction('readonly');
+      return (await promisify(store.get(key))) as CachedResponse | undefined;
+    },
+    async put(entry) {
+      const store = await transaction('readwrite');
+      await promisify(store.put(entry));
+
+      const byAge = store.index(STORED_AT_INDEX);
+      const expired = await promisify(
+        byAge.getAllKeys(IDBKeyRange.upperBound(Date.now() - limits.maxAgeMs))
+      );
+      await Promise.all(expired.map((key) => promisify(store.delete(key))));
+      const excess = (await promisify(store.count())) - limits.maxEntries;
+      if (excess > 0) {
+        const oldest = await promisify(byAge.getAllKeys(null, excess));
+        await Promise.all(oldest.map((key) => promisify(store.delete(key))));
+      }
+    },
+    async deleteSchedule(scheduleId) {
+      const store = await transaction('readwrite');
+      const keys = await promisify(store.index(SCHEDULE_INDEX).getAllKeys(scheduleId));
+      await Promise.all(keys.map((key) => promisify(store.delete(key))));
+    },
+    async deleteSuperseded(scheduleId, etag) {
+      const store = await transaction('readwrite');
+      const entries = (await promisify(
+        store.index(SCHEDULE_INDEX).getAll(scheduleId)
+      )) as CachedResponse[];
+      await Promise.all(
+        entries
+          .filter((entry) => isSuperseded(entry, scheduleId, etag))
+          .map((entry) => promisify(store.delete(entry.key)))
+      );
+    },
+  };
+}
+
+/** In-memory store with the same contract, for tests. */
+export function createMemoryStore(
+  limits: ResponseStoreLimits = DEFAULT_RESPONSE_STORE_LIMITS,
+  now: () => number = Date.now
+): ResponseStore {
+  const entries = new Map<string, CachedResponse>();
+  return {
+    async get(key) {
+      return entries.get(key);
+    },
+    async put(entry) {
+      entries.set(entry.key, entry);
+      const byAge = [...entries.values()].sort((a, b) => a.storedAt - b.storedAt);
+      const cutoff = now() - limits.maxAgeMs;
+      const expired = byAge.filter((e) => e.storedAt <= cutoff).length;
+      const evict = Math.max(expired, byAge.length - limits.maxEntries);
+      byAge.slice(0, evict).forEach((e) => entries.delete(e.key));
+    },
+    async deleteSchedule(scheduleId) {
+      for (const [key, entry] of entries) {
+        if (entry.scheduleIds.includes(scheduleId)) entries.delete(key);
+      }
+    },
+    async deleteSuperseded(scheduleId, etag) {
+      for (const [key, entry] of entries) {
+        if (isSuperseded(entry, scheduleId, etag)) entries.delete(key);
+      }
+    },
+  };
+}
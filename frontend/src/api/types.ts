@@ -148,6 +148,8 @@ export interface AltAzRequest {
   start_mjd: number;
   end_mjd: number;
   targets: AltAzTargetRequest[];
+  /** Sampling cadence in minutes; the backend defaults to 10. */
+  sample_interval_minutes?: number;
 }
 
 // =============================================================================
@@ -306,6 +308,38 @@ export interface SkyMapData {
   scheduled_count: number;
   scheduled_time_min: number | null;
   scheduled_time_max: number | null;
+  /** Present when requested with `resolution`; `blocks` is then viewport-only. */
+  density?: SkyMapDensity;
+}
+
+/** One non-empty HEALPix cell (RING scheme). */
+export interface SkyDensityCell {
+  pixel: number;
+  ra_deg: number;
+  dec_deg: number;
+  count: number;
+  scheduled_count: number;
+  mean_priority: number;
+  max_priority: number;
+}
+
+export interface SkyMapDensity {
+  nside: number;
+  cell_size_deg: number;
+  cells: SkyDensityCell[];
+}
+
+/**
+ * Level of detail for `/sky-map`: `resolution` is the HEALPix `nside` of the
+ * density cells; the RA/Dec bounds select the targets returned individually
+ * (`ra_min > ra_max` wraps through 0°).
+ */
+export interface SkyMapQuery {
+  resolution?: number;
+  ra_min?: number;
+  ra_max?: number;
+  dec_min?: number;
+  dec_max?: number;
 }
 
 // Distributions
@@ -327,7 +361,25 @@ export interface DistributionStats {
   sum: number;
 }
 
+/**
+ * Equal-width bins over `[min, max]`, split by scheduling status.  The last
+ * bin also holds `max`; a constant column lands entirely in the first bin.
+ */
+export interface DistributionHistogram {
+  min: number;
+  max: number;
+  scheduled: number[];
+  unscheduled: number[];
+}
+
+export interface DistributionHistograms {
+  priority: DistributionHistogram;
+  visibility_hours: DistributionHistogram;
+  requested_hours: DistributionHistogram;
+}
+
 export interface DistributionData {
+  /** Empty when requested with `blocks: false`. */
   blocks: DistributionBlock[];
   priority_stats: DistributionStats;
   visibility_stats: DistributionStats;
@@ -336,6 +388,15 @@ export interface DistributionData {
   scheduled_count: number;
   unscheduled_count: number;
   impossible_count: number;
+  /** Present when requested with `bins`. */
+  histograms?: DistributionHistograms;
+}
+
+export interface DistributionsQuery {
+  /** Histogram bins per column (max 200). */
+  bins?: number;
+  /** Include per-block rows (default true). */
+  blocks?: boolean;
 }
 
 // Timeline
@@ -353,6 +414,20 @@ export interface ScheduleTimelineBlock {
   num_visibility_periods: number;
 }
 
+/**
+ * Render-ready month-row layout (parallel columns, one entry per bar
+ * segment). Blocks crossing a UTC month boundary are split into one
+ * segment per month; `x0`/`x1` are fractional 1-based days of the month.
+ */
+export interface TimelineLayoutColumns {
+  block_index: number[];
+  row: number[];
+  x0: number[];
+  x1: number[];
+  color_index: number[];
+  continuation: boolean[];
+}
+
 export interface ScheduleTimelineData {
   blocks: ScheduleTimelineBlock[];
   priority_min: number;
@@ -361,6 +436,7 @@ export interface ScheduleTimelineData {
   scheduled_count: number;
   unique_months: string[];
   dark_periods: Period[];
+  layout: TimelineLayoutColumns;
 }
 
 // Insights
@@ -423,6 +499,7 @@ export interface TopObservation {
 }
 
 export interface InsightsData {
+  /** Empty when requested with `blocks: false`. */
   blocks: InsightsBlock[];
   metrics: AnalyticsMetrics;
   correlations: CorrelationEntry[];
@@ -434,6 +511,11 @@ export interface InsightsData {
   impossible_count: number;
 }
 
+export interface InsightsQuery {
+  /** Include per-block rows (default true). */
+  blocks?: boolean;
+}
+
 // Fragmentation
 export type FragmentationSegmentKind =
   | 'non_operable'
@@ -501,18 +583,22 @@ export interface FragmentationMetrics {
   fit_visibility_fraction_of_operable: number;
 }
 
-export interface AltAzCurve {
-  original_block_id: string;
-  block_name: string;
-  priority: number;
-  altitudes_deg: number[];
-  azimuths_deg: number[];
-}
-
+/**
+ * Columnar alt/az payload. Per-target metadata lives in parallel arrays and
+ * the altitude/azimuth matrices are flat and target-major: the curve of
+ * target `t` spans `[t * sample_count, (t + 1) * sample_count)`.
+ */
 export interface AltAzData {
   schedule_id: number;
+  sample_interval_minutes: number;
+  sample_count: number;
+  target_count: number;
   sample_times_mjd: number[];
-  curves: AltAzCurve[];
+  original_block_ids: string[];
+  block_names: string[];
+  priorities: number[];
+  altitudes_deg: number[];
+  azimuths_deg: number[];
 }
 
 export interface FragmentationData {
@@ -750,16 +836,68 @@ export interface VisibilityMapData {
   scheduled_count: number;
 }
 
+export type VisibilityBlockSort = 'priority' | 'num_visibility_periods' | 'scheduled';
+
+/** Keyset position: sort key and block id of the last row of a page. */
+export interface VisibilityBlockCursor {
+  key: number;
+  id: number;
+}
+
+/** One page of visibility-map blocks; summary fields cover the whole schedule. */
+export interface VisibilityBlocksPage {
+  blocks: VisibilityBlockSummary[];
+  /** Rows matching the filters, across all pages. */
+  matched_count: number;
+  total_count: number;
+  scheduled_count: number;
+  priority_min: number;
+  priority_max: number;
+  /** `null` on the last page. */
+  next_cursor: VisibilityBlockCursor | null;
+}
+
 export interface VisibilityBin {
   bin_start_unix: number;
   bin_end_unix: number;
   visible_count: number;
 }
 
+// Dashboard
+export interface SectionTiming {
+  /** `load` for the shared fetch, otherwise the section's field name. */
+  section: string;
+  duration_ms: number;
+}
+
+/**
+ * Every summary view of a schedule from one load.  Distributions and
+ * insights carry aggregates only (empty `blocks`).
+ */
+export interface ScheduleDashboard {
+  schedule_id: number;
+  sky_map: SkyMapData;
+  distributions: DistributionData;
+  insights: InsightsData;
+  trends: TrendsData;
+  fragmentation: FragmentationData;
+  kpis: ScheduleKpi;
+  timings: SectionTiming[];
+}
+
 // =============================================================================
 // Query Parameters
 // =============================================================================
 
+/** Each parameter means what it does on the section's own endpoint. */
+export interface DashboardQuery {
+  resolution?: number;
+  bins?: number;
+  trend_bins?: number;
+  bandwidth?: number;
+  points?: number;
+}
+
 export interface TrendsQuery {
   bins?: number;
   bandwidth?: number;
@@ -774,6 +912,22 @@ export interface CompareQuery {
   merge_epsilon_minutes?: number;
 }
 
+export interface VisibilityBlocksQuery {
+  sort?: VisibilityBlockSort;
+  direction?: 'asc' | 'desc';
+  priority_min?: number;
+  priority_max?: number;
+  scheduled?: boolean;
+  /** Substring of the original id or name, or an exact scheduling block id. */
+  search?: string;
+  /** Resume after this row; takes precedence over `offset`. */
+  after_key?: number;
+  after_id?: number;
+  offset?: number;
+  /** Page size (default 200, max 1000). */
+  limit?: number;
+}
+
 export interface VisibilityHistogramQuery {
   bin_duration_minutes?: number;
   num_bins?: number;
@@ -5,7 +5,7 @@
 import { useState, useEffect } from 'react';
 import { Outlet, NavLink, useParams, useLocation } from 'react-router-dom';
 import { useAppStore } from '@/store';
-import { useHealth } from '@/hooks';
+import { useHealth, useSchedulePrefetch } from '@/hooks';
 import { useScheduleSync, AnalysisProvider } from '@/features/schedules';
 import { extensions } from '@/extensions';
 import BrandMark from './BrandMark';
@@ -157,6 +157,11 @@ function Layout() {
   const isLanding = location.pathname === '/';
   // Sync route scheduleId with Zustand store
   useScheduleSync();
+  // Warm the views usually opened next from this one.
+  useSchedulePrefetch(
+    Number(scheduleId ?? 0),
+    scheduleId ? location.pathname.split('/')[3] : undefined
+  );
 
   // Mobile menu state
   const [mobileMenuOpen, setMobileMenuOpen] = useState(false);
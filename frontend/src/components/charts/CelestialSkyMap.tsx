@@ -2,10 +2,30 @@
  * CelestialSkyMap – wraps d3-celestial (loaded globally via /celestial.js) to
  * render an interactive all-sky Aitoff projection with the real Milky Way,
  * equatorial grid, and our observation targets colored by priority bin.
+ *
+ * Large target sets are drawn by a WebGL point layer (`skyPointsGL.ts`)
+ * overlaid on the d3-celestial canvas.  When `density` is given (the
+ * server's HEALPix aggregation of a large schedule) the layer shows its
+ * cells instead of `blocks`; that view needs WebGL.
  */
-import { useEffect, useRef, useState, useCallback } from 'react';
-import type { LightweightBlock, PriorityBinInfo } from '@/api/types';
+import { useEffect, useMemo, useRef, useState, useCallback } from 'react';
+import type {
+  LightweightBlock,
+  PriorityBinInfo,
+  SkyDensityCell,
+  SkyMapDensity,
+} from '@/api/types';
 import { mjdToDate, isValidDate } from '@/constants/dates';
+import {
+  buildDensityLayer,
+  buildTargetLayer,
+  createSkyPointsRenderer,
+  projectSkyPoint,
+  raToCelestialLon,
+  readCelestialProjection,
+  type SkyPointsRenderer,
+  type SkyProjectionParams,
+} from './skyPointsGL';
 
 // ── Minimal type declaration for window.Celestial ─────────────────────────────
 declare global {
@@ -27,7 +47,11 @@ declare global {
         redraw: () => void;
       }) => void;
       clip: (coords: number[]) => boolean;
-      mapProjection: (coords: number[]) => [number, number];
+      mapProjection: ((coords: number[]) => [number, number]) & {
+        rotate?: () => number[];
+        scale?: () => number;
+        translate?: () => number[];
+      };
       context: CanvasRenderingContext2D;
       setStyle: (style: {
         stroke?: string;
@@ -54,8 +78,14 @@ export interface CelestialSkyMapProps {
   pathBlocks?: LightweightBlock[];
   /** When true, draws directed arrows between consecutive `pathBlocks`. */
   showPath?: boolean;
+  /** Draw targets with WebGL above this many blocks (canvas below it). */
+  glThreshold?: number;
+  /** Server-aggregated sky cells; drawn (with WebGL) instead of the targets. */
+  density?: SkyMapDensity | null;
 }
 
+const DEFAULT_GL_THRESHOLD = 5000;
+
 // ── Tooltip helpers ────────────────────────────────────────────────────────────
 
 interface DrawnPoint {
@@ -65,11 +95,19 @@ interface DrawnPoint {
 }
 
 interface TooltipState {
-  block: LightweightBlock;
+  block?: LightweightBlock;
+  cell?: SkyDensityCell;
   x: number;
   y: number;
 }
 
+/** Screen positions of the GL layer's points for one projection state. */
+interface ProjectedLayer {
+  params: SkyProjectionParams;
+  xs: Float32Array;
+  ys: Float32Array;
+}
+
 /** Draws a polyline through an array of canvas [x,y] points. */
 function drawSegmentLine(ctx: CanvasRenderingContext2D, pts: [number, number][]): void {
   if (pts.length < 2) return;
@@ -165,6 +203,8 @@ function CelestialSkyMap({
   showCoordinateGuide = true,
   pathBlocks,
   showPath = false,
+  glThreshold = DEFAULT_GL_THRESHOLD,
+  density,
 }: CelestialSkyMapProps) {
   const blocksRef = useRef(blocks);
   const binsRef = useRef(bins);
@@ -174,11 +214,30 @@ function CelestialSkyMap({
   const drawnPointsRef = useRef<DrawnPoint[]>([]);
   const [tooltip, setTooltip] = useState<TooltipState | null>(null);
 
+  // WebGL point layer state.
+  const glCanvasRef = useRef<HTMLCanvasElement>(null);
+  const rendererRef = useRef<SkyPointsRenderer | null>(null);
+  const glParamsRef = useRef<SkyProjectionParams | null>(null);
+  const projectedRef = useRef<ProjectedLayer | null>(null);
+  const [glUnavailable, setGlUnavailable] = useState(false);
+
+  const densityMode = !!density && density.cells.length > 0;
+  const useGl = !glUnavailable && (densityMode || blocks.length > glThreshold);
+  const glLayer = useMemo(() => {
+    if (!useGl) return null;
+    return densityMode && density
+      ? buildDensityLayer(density.cells, density.cell_size_deg)
+      : buildTargetLayer(blocks, bins);
+  }, [useGl, densityMode, density, blocks, bins]);
+  const glActiveRef = useRef(false);
+  const densityCellsRef = useRef<SkyDensityCell[] | null>(null);
+
   // Keep refs current on every render so redrawF always uses latest data.
   blocksRef.current = blocks;
   binsRef.current = bins;
   pathBlocksRef.current = pathBlocks;
   showPathRef.current = showPath;
+  densityCellsRef.current = densityMode && density ? density.cells : null;
 
   // ── Initialize the map once ─────────────────────────────────────────────
   useEffect(() => {
@@ -208,38 +267,53 @@ function CelestialSkyMap({
 
       drawnPointsRef.current = [];
 
-      for (const block of currentBlocks) {
-        // d3-celestial uses geographic [-180,180] longitude convention.
-        const lon = block.target_ra_deg > 180 ? block.target_ra_deg - 360 : block.target_ra_deg;
-        const coords = [lon, block.target_dec_deg];
+      // WebGL mode: one draw call with the current projection; the 2D
+      // canvas below only carries the map and the path overlay.
+      const renderer = glActiveRef.current ? rendererRef.current : null;
+      const glCanvas = glCanvasRef.current;
+      const params = renderer ? readCelestialProjection(Celestial.mapProjection) : null;
+      if (renderer && glCanvas && params) {
+        const base = ctx.canvas;
+        glCanvas.style.left = `${base.offsetLeft}px`;
+        glCanvas.style.top = `${base.offsetTop}px`;
+        glCanvas.style.width = `${base.clientWidth}px`;
+        glCanvas.style.height = `${base.clientHeight}px`;
+        renderer.draw(params, base.clientWidth, base.clientHeight, window.devicePixelRatio || 1);
+        glParamsRef.current = params;
+      } else {
+        for (const block of currentBlocks) {
+          // d3-celestial uses geographic [-180,180] longitude convention.
+          const lon = block.target_ra_deg > 180 ? block.target_ra_deg - 360 : block.target_ra_deg;
+          const coords = [lon, block.target_dec_deg];
+
+          if (!Celestial.clip(coords)) continue;
+
+          const [cx, cy] = Celestial.mapProjection(coords);
+          drawnPointsRef.current.push({ cx, cy, block });
+          const bin = currentBins.find(
+            (b) => block.priority >= b.min_priority && block.priority <= b.max_priority
+          );
+          const color = bin?.color ?? '#94a3b8';
+          const isScheduled = block.scheduled_period !== null;
+          const radius = isScheduled ? 3.5 : 2;
+
+          ctx.beginPath();
+          ctx.arc(cx, cy, radius, 0, 2 * Math.PI);
+          ctx.closePath();
+
+          if (isScheduled) {
+            ctx.globalAlpha = 0.85;
+            ctx.fillStyle = color;
+            ctx.fill();
+          }
 
-        if (!Celestial.clip(coords)) continue;
+          ctx.globalAlpha = isScheduled ? 0.9 : 0.45;
+          ctx.strokeStyle = color;
+          ctx.lineWidth = isScheduled ? 1.5 : 1;
+          ctx.stroke();
 
-        const [cx, cy] = Celestial.mapProjection(coords);
-        drawnPointsRef.current.push({ cx, cy, block });
-        const bin = currentBins.find(
-          (b) => block.priority >= b.min_priority && block.priority <= b.max_priority
-        );
-        const color = bin?.color ?? '#94a3b8';
-        const isScheduled = block.scheduled_period !== null;
-        const radius = isScheduled ? 3.5 : 2;
-
-        ctx.beginPath();
-        ctx.arc(cx, cy, radius, 0, 2 * Math.PI);
-        ctx.closePath();
-
-        if (isScheduled) {
-          ctx.globalAlpha = 0.85;
-          ctx.fillStyle = color;
-          ctx.fill();
+          ctx.globalAlpha = 1;
         }
-
-        ctx.globalAlpha = isScheduled ? 0.9 : 0.45;
-        ctx.strokeStyle = color;
-        ctx.lineWidth = isScheduled ? 1.5 : 1;
-        ctx.stroke();
-
-        ctx.globalAlpha = 1;
       }
 
       // ── Observation path overlay ─────────────────────────────────────
@@ -397,11 +471,74 @@ function CelestialSkyMap({
     // eslint-disable-next-line react-hooks/exhaustive-deps
   }, [containerId, showCoordinateGuide]);
 
+  // ── Upload the WebGL layer; the renderer is created on first use ─────────
+  useEffect(() => {
+    if (glLayer && !rendererRef.current) {
+      const canvas = glCanvasRef.current;
+      rendererRef.current = canvas ? createSkyPointsRenderer(canvas) : null;
+      if (!rendererRef.current) {
+        setGlUnavailable(true);
+        return;
+      }
+    }
+    rendererRef.current?.setLayer(glLayer);
+    glActiveRef.current = glLayer !== null && rendererRef.current !== null;
+    projectedRef.current = null;
+  }, [glLayer]);
+
+  useEffect(
+    () => () => {
+      rendererRef.current?.dispose();
+      rendererRef.current = null;
+      glActiveRef.current = false;
+    },
+    []
+  );
+
   // ── Redraw whenever the filtered block set or path visibility changes ──────
   useEffect(() => {
     if (!initializedRef.current) return;
     window.Celestial?.redraw();
-  }, [blocks, bins, showPath, pathBlocks]);
+  }, [blocks, bins, showPath, pathBlocks, glLayer]);
+
+  /**
+   * Nearest GL point to a CSS-pixel position on the map canvas.  Screen
+   * positions are recomputed on the CPU only after the projection changes.
+   */
+  const hitTestGl = useCallback(
+    (x: number, y: number): { block?: LightweightBlock; cell?: SkyDensityCell } | null => {
+      const params = glParamsRef.current;
+      if (!params) return null;
+      const cells = densityCellsRef.current;
+      const items = cells ?? blocksRef.current;
+      let projected = projectedRef.current;
+      if (!projected || projected.params !== params || projected.xs.length !== items.length) {
+        const xs = new Float32Array(items.length);
+        const ys = new Float32Array(items.length);
+        items.forEach((item, i) => {
+          const [ra, dec] =
+            'ra_deg' in item
+              ? [item.ra_deg, item.dec_deg]
+              : [item.target_ra_deg, item.target_dec_deg];
+          [xs[i], ys[i]] = projectSkyPoint(raToCelestialLon(ra), dec, params);
+        });
+        projected = { params, xs, ys };
+        projectedRef.current = projected;
+      }
+      let closest = -1;
+      let minDist = HOVER_RADIUS;
+      for (let i = 0; i < projected.xs.length; i++) {
+        const dist = Math.hypot(x - projected.xs[i], y - projected.ys[i]);
+        if (dist < minDist) {
+          minDist = dist;
+          closest = i;
+        }
+      }
+      if (closest < 0) return null;
+      return cells ? { cell: cells[closest] } : { block: blocksRef.current[closest] };
+    },
+    []
+  );
 
   // ── Hover detection ─────────────────────────────────────────────────────
   const handleMouseMove = useCallback(
@@ -410,6 +547,16 @@ function CelestialSkyMap({
       if (!canvas) return;
 
       const rect = canvas.getBoundingClientRect();
+      const wrapperRect = e.currentTarget.getBoundingClientRect();
+
+      if (glActiveRef.current) {
+        const hit = hitTestGl(e.clientX - rect.left, e.clientY - rect.top);
+        setTooltip(
+          hit ? { ...hit, x: e.clientX - wrapperRect.left, y: e.clientY - wrapperRect.top } : null
+        );
+        return;
+      }
+
       const scaleX = canvas.width / rect.width;
       const scaleY = canvas.height / rect.height;
       const mouseX = (e.clientX - rect.left) * scaleX;
@@ -427,7 +574,6 @@ function CelestialSkyMap({
       }
 
       if (closest) {
-        const wrapperRect = e.currentTarget.getBoundingClientRect();
         setTooltip({
           block: closest.block,
           x: e.clientX - wrapperRect.left,
@@ -437,7 +583,7 @@ function CelestialSkyMap({
         setTooltip(null);
       }
     },
-    [containerId]
+    [containerId, hitTestGl]
   );
 
   const handleMouseLeave = useCallback(() => {
@@ -450,7 +596,45 @@ function CelestialSkyMap({
   return (
     <div className="relative w-full" onMouseMove={handleMouseMove} onMouseLeave={handleMouseLeave}>
       <div id={containerId} className="w-full" style={{ minHeight: '500px' }} />
-      {tooltip && (
+      <canvas
+        ref={glCanvasRef}
+        id={`${containerId}-gl`}
+        className="pointer-events-none absolute"
+        hidden={!glLayer}
+      />
+      {tooltip?.cell && (
+        <div
+          className="pointer-events-none absolute z-10 max-w-xs rounded-lg border border-slate-600 bg-slate-900/95 p-3 text-xs shadow-xl backdrop-blur-sm"
+          style={{
+            left: tooltipFlip ? undefined : tooltip.x + 12,
+            right: tooltipFlip ? `calc(100% - ${tooltip.x}px + 12px)` : undefined,
+            top: tooltip.y + 12,
+          }}
+        >
+          <p className="mb-1.5 font-semibold text-slate-100">
+            {tooltip.cell.count.toLocaleString()} targets
+          </p>
+          <div className="space-y-1 text-slate-300">
+            <div className="flex justify-between gap-4">
+              <span className="text-slate-400">Scheduled</span>
+              <span>{tooltip.cell.scheduled_count.toLocaleString()}</span>
+            </div>
+            <div className="flex justify-between gap-4">
+              <span className="text-slate-400">Priority (mean / max)</span>
+              <span>
+                {tooltip.cell.mean_priority.toFixed(2)} / {tooltip.cell.max_priority.toFixed(2)}
+              </span>
+            </div>
+            <div className="flex justify-between gap-4">
+              <span className="text-slate-400">RA / Dec</span>
+              <span>
+                {tooltip.cell.ra_deg.toFixed(2)}° / {tooltip.cell.dec_deg.toFixed(2)}°
+              </span>
+            </div>
+          </div>
+        </div>
+      )}
+      {tooltip?.block && (
         <div
           className="pointer-events-none absolute z-10 max-w-xs rounded-lg border border-slate-600 bg-slate-900/95 p-3 text-xs shadow-xl backdrop-blur-sm"
           style={{
@@ -0,0 +1,234 @@
+/**
+ * WebGL timeline chart.
+ *
+ * Draws scheduled observations as month-row bars using one `scattergl`
+ * polyline per priority colour bin (NaN-separated segments), so Plotly
+ * never lays out per-block shapes on pan/zoom. Bar geometry comes
+ * precomputed from the backend (`ScheduleTimelineData.layout`); it is
+ * packed into polylines once — in the aggregations worker for large
+ * schedules — and hover is resolved against a per-row interval index
+ * instead of Plotly's point picking.
+ */
+import { memo, useCallback, useEffect, useMemo, useRef, useState } from 'react';
+import { transfer } from 'comlink';
+import type { Config, Data, Layout } from 'plotly.js-dist-min';
+import type { ScheduleTimelineBlock, TimelineLayoutColumns } from '@/api/types';
+import { mjdToDate } from '@/constants/dates';
+import { useAsyncMemo } from '@/hooks/useAsyncMemo';
+import { getAggregationsPool } from '@/workers/aggregationsClient';
+import {
+  buildTimelineLayout,
+  hitTestTimeline,
+  timelineBinColor,
+  timelineLayoutInput,
+  TIMELINE_COLOR_BINS,
+  type TimelineLayout,
+} from '@/workers/timelineLayout';
+import PlotlyChart from './PlotlyChart';
+
+/** Below this many segments the layout is packed inline (no worker hop). */
+const WORKER_TIMELINE_THRESHOLD = 2000;
+
+/** Bar thickness as a fraction of the row pitch. */
+const BAR_FRACTION = 0.4;
+
+/** Plot area reserved for margins/axis titles when sizing bars. */
+const VERTICAL_CHROME_PX = 140;
+
+interface PlotlyAxisInternals {
+  _offset: number;
+  p2d: (px: number) => number;
+}
+
+interface PlotlyGraphDivInternals {
+  _fullLayout?: { xaxis?: PlotlyAxisInternals; yaxis?: PlotlyAxisInternals };
+}
+
+interface HoverState {
+  left: number;
+  top: number;
+  blockIndex: number;
+}
+
+export interface TimelineGLChartProps {
+  blocks: ScheduleTimelineBlock[];
+  /** Sorted `YYYY-MM` keys; one row each. */
+  months: string[];
+  /** Server-computed bar segments. */
+  segments: TimelineLayoutColumns;
+  /** Themed base layout (title, colours, fonts). */
+  layout: Partial<Layout>;
+  config?: Partial<Config>;
+  /** Chart height in pixels. */
+  heightPx?: number;
+  onInitialized?: (figure: unknown, graphDiv: HTMLElement) => void;
+}
+
+const TimelineGLChart = memo(function TimelineGLChart({
+  blocks,
+  months,
+  segments,
+  layout,
+  config,
+  heightPx = 800,
+  onInitialized,
+}: TimelineGLChartProps) {
+  const useWorker = segments.x0.length > WORKER_TIMELINE_THRESHOLD;
+
+  const { value: timeline } = useAsyncMemo<TimelineLayout | null>(
+    (signal) => {
+      const pool = useWorker ? getAggregationsPool() : null;
+      const input = timelineLayoutInput(segments, months.length);
+      if (!pool) return buildTimelineLayout(input);
+      const buffers = [input.x0, input.x1, input.row, input.blockIndex, input.colorIndex].map(
+        (array) => array.buffer as ArrayBuffer
+      );
+      return pool.run(
+        'buildTimelineLayout',
+        (client) => client.buildTimelineLayout(transfer(input, buffers)),
+        { signal }
+      );
+    },
+    [segments, months, useWorker],
+    null
+  );
+
+  const rowPitchPx = (heightPx - VERTICAL_CHROME_PX) / Math.max(1, months.length);
+  const lineWidth = Math.min(40, Math.max(2, Math.round(BAR_FRACTION * rowPitchPx)));
+
+  const data = useMemo<Data[]>(() => {
+    if (!timeline) return [];
+    const traces: Data[] = [];
+    for (let bin = 0; bin < TIMELINE_COLOR_BINS; bin++) {
+      const lo = timeline.binOffsets[bin] * 3;
+      const hi = timeline.binOffsets[bin + 1] * 3;
+      if (hi === lo) continue;
+      traces.push({
+        type: 'scattergl',
+        mode: 'lines',
+        x: timeline.lineX.subarray(lo, hi) as unknown as number[],
+        y: timeline.lineY.subarray(lo, hi) as unknown as number[],
+        line: { color: timelineBinColor(bin), width: lineWidth },
+        opacity: 0.7,
+        connectgaps: false,
+        hoverinfo: 'skip',
+        showlegend: false,
+      });
+    }
+    return traces;
+  }, [timeline, lineWidth]);
+
+  const chartLayout = useMemo<Partial<Layout>>(
+    () => ({
+      ...layout,
+      hovermode: false,
+      xaxis: {
+        ...layout.xaxis,
+        title: { text: 'Day of Month' },
+        range: [0, 32],
+        dtick: 1,
+      },
+      yaxis: {
+        ...layout.yaxis,
+        title: { text: 'Month' },
+        tickmode: 'array',
+        tickvals: months.map((_, index) => index),
+        ticktext: months,
+        range: [months.length - 0.5, -0.5],
+      },
+    }),
+    [layout, months]
+  );
+
+  // Hover: map the cursor to data space and query the interval index.
+  const containerRef = useRef<HTMLDivElement>(null);
+  const [graphDiv, setGraphDiv] = useState<HTMLElement | null>(null);
+  const [hover, setHover] = useState<HoverState | null>(null);
+
+  const handleInitialized = useCallback(
+    (figure: unknown, gd: HTMLElement) => {
+      setGraphDiv(gd);
+      onInitialized?.(figure, gd);
+    },
+    [onInitialized]
+  );
+
+  useEffect(() => {
+    if (!graphDiv || !timeline) return;
+    let frame = 0;
+    let last: MouseEvent | null = null;
+
+    const update = () => {
+      frame = 0;
+      const event = last;
+      const full = (graphDiv as HTMLElement & PlotlyGraphDivInternals)._fullLayout;
+      const container = containerRef.current;
+      if (!event || !full?.xaxis || !full.yaxis || !container) return;
+      const rect = graphDiv.getBoundingClientRect();
+      const x = full.xaxis.p2d(event.clientX - rect.left - full.xaxis._offset);
+      const y = full.yaxis.p2d(event.clientY - rect.top - full.yaxis._offset);
+      const segment = hitTestTimeline(timeline, x, y, BAR_FRACTION / 2 + 0.05);
+      if (segment < 0) {
+        setHover(null);
+        return;
+      }
+      const box = container.getBoundingClientRect();
+      setHover({
+        left: event.clientX - box.left + 12,
+        top: event.clientY - box.top + 12,
+        blockIndex: timeline.blockIndex[segment],
+      });
+    };
+
+    const onMove = (event: MouseEvent) => {
+      last = event;
+      if (!frame) frame = requestAnimationFrame(update);
+    };
+    const onLeave = () => {
+      last = null;
+      if (frame) cancelAnimationFrame(frame);
+      frame = 0;
+      setHover(null);
+    };
+
+    graphDiv.addEventListener('mousemove', onMove);
+    graphDiv.addEventListener('mouseleave', onLeave);
+    return () => {
+      graphDiv.removeEventListener('mousemove', onMove);
+      graphDiv.removeEventListener('mouseleave', onLeave);
+      if (frame) cancelAnimationFrame(frame);
+    };
+  }, [graphDiv, timeline]);
+
+  const hovered = hover ? blocks[hover.blockIndex] : undefined;
+
+  return (
+    <div ref={containerRef} className="relative">
+      <PlotlyChart
+        data={data}
+        layout={chartLayout}
+        config={config}
+        height={`${heightPx}px`}
+        bundle="full"
+        ariaLabel="Observation timeline"
+        onInitialized={handleInitialized}
+      />
+      {hover && hovered && (
+        <div
+          className="pointer-events-none absolute z-10 rounded-md border border-slate-600 bg-slate-900/95 px-3 py-2 text-xs text-slate-200 shadow-lg"
+          style={{ left: hover.left, top: hover.top }}
+        >
+          <div className="font-medium">
+            {hovered.original_block_id}
+            {hovered.block_name ? ` — ${hovered.block_name}` : ''}
+          </div>
+          <div>Start: {mjdToDate(hovered.scheduled_start_mjd).toISOString()}</div>
+          <div>Priority: {hovered.priority.toFixed(1)}</div>
+          <div>Duration: {hovered.requested_hours.toFixed(1)}h</div>
+        </div>
+      )}
+    </div>
+  );
+});
+
+export default TimelineGLChart;
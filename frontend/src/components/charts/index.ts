@@ -8,3 +8,5 @@ export { default as ChartFullscreenOverlay } from './ChartFullscreenOverlay';
 export type { ChartFullscreenOverlayProps } from './ChartFullscreenOverlay';
 export { default as DownloadCsvButton } from './DownloadCsvButton';
 export type { DownloadCsvButtonProps } from './DownloadCsvButton';
+export { default as TimelineGLChart } from './TimelineGLChart';
+export type { TimelineGLChartProps } from './TimelineGLChart';
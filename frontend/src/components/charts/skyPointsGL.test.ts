@@ -0,0 +1,106 @@
+import { describe, it, expect } from 'vitest';
+import {
+  buildDensityLayer,
+  buildTargetLayer,
+  hexToRgb,
+  projectSkyPoint,
+  readCelestialProjection,
+  SKY_POINT_DISC,
+  SKY_POINT_RING,
+  SKY_POINT_SQUARE,
+  type SkyProjectionParams,
+} from './skyPointsGL';
+
+const params: SkyProjectionParams = { rotate: [0, 0, 0], scale: 100, translate: [400, 200] };
+
+describe('projectSkyPoint', () => {
+  it('maps the projection centre to the translation', () => {
+    const [x, y] = projectSkyPoint(0, 0, params);
+    expect(x).toBeCloseTo(400);
+    expect(y).toBeCloseTo(200);
+  });
+
+  it('mirrors longitude like the celestial (inside-out) Aitoff map', () => {
+    // aitoff.raw(-π/2, 0) = [-π/2, 0]
+    const [x, y] = projectSkyPoint(90, 0, params);
+    expect(x).toBeCloseTo(400 - (Math.PI / 2) * 100);
+    expect(y).toBeCloseTo(200);
+    expect(projectSkyPoint(-90, 0, params)[0]).toBeCloseTo(400 + (Math.PI / 2) * 100);
+  });
+
+  it('puts the poles on the vertical axis, north up', () => {
+    const [x, y] = projectSkyPoint(0, 90, params);
+    expect(x).toBeCloseTo(400);
+    expect(y).toBeCloseTo(200 - (Math.PI / 2) * 100);
+  });
+
+  it('applies the λ rotation before projecting', () => {
+    const rotated = { ...params, rotate: [90, 0, 0] as [number, number, number] };
+    const [x, y] = projectSkyPoint(-90, 10, rotated);
+    const [cx, cy] = projectSkyPoint(0, 10, params);
+    expect(x).toBeCloseTo(cx);
+    expect(y).toBeCloseTo(cy);
+  });
+});
+
+describe('readCelestialProjection', () => {
+  it('reads rotate/scale/translate from a d3 projection', () => {
+    const projection = Object.assign(() => [0, 0], {
+      rotate: () => [10, -5],
+      scale: () => 250,
+      translate: () => [320, 160],
+    });
+    expect(readCelestialProjection(projection)).toEqual({
+      rotate: [10, -5, 0],
+      scale: 250,
+      translate: [320, 160],
+    });
+    expect(readCelestialProjection(() => [0, 0])).toBeNull();
+  });
+});
+
+describe('layer builders', () => {
+  const bins = [
+    { min_priority: 0, max_priority: 5, color: '#2ca02c' },
+    { min_priority: 5, max_priority: 10, color: '#1f77b4' },
+  ];
+
+  it('parses hex colours', () => {
+    expect(hexToRgb('#1f77b4')).toEqual([31, 119, 180]);
+    expect(hexToRgb('#fff')).toEqual([255, 255, 255]);
+    expect(hexToRgb('not a colour')).toEqual([148, 163, 184]);
+  });
+
+  it('colours targets by bin and styles them by scheduling state', () => {
+    const layer = buildTargetLayer(
+      [
+        { priority: 2, target_ra_deg: 350, target_dec_deg: -20, scheduled_period: null },
+        { priority: 7, target_ra_deg: 10, target_dec_deg: 30, scheduled_period: {} },
+      ],
+      bins
+    );
+    expect(layer.count).toBe(2);
+    expect(Array.from(layer.lon)).toEqual([-10, 10]);
+    expect(Array.from(layer.color.subarray(0, 3))).toEqual([44, 160, 44]);
+    expect(Array.from(layer.color.subarray(4, 7))).toEqual([31, 119, 180]);
+    expect(layer.style[0]).toBe(SKY_POINT_RING);
+    expect(layer.style[1]).toBe(SKY_POINT_DISC);
+  });
+
+  it('sizes density cells in radians', () => {
+    const cell = {
+      ra_deg: 180,
+      dec_deg: 0,
+      count: 4,
+      scheduled_count: 1,
+      mean_priority: 3,
+      max_priority: 5,
+    };
+    const layer = buildDensityLayer([cell, { ...cell, count: 1 }], 2);
+    expect(layer.angularSize).toBe(true);
+    expect(layer.style[0]).toBe(SKY_POINT_SQUARE);
+    expect(layer.size[0]).toBeCloseTo(2 * (Math.PI / 180) * 1.15, 5);
+    // Denser cells sit further along the ramp (towards yellow).
+    expect(layer.color[0]).toBeGreaterThan(layer.color[4]);
+  });
+});
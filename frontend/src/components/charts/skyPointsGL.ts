@@ -0,0 +1,426 @@
+/**
+ * WebGL point layer for `CelestialSkyMap`.
+ *
+ * d3-celestial redraws its canvas by projecting every feature on the CPU,
+ * which stops being interactive at tens of thousands of targets.  This
+ * module uploads target positions once and projects them in the vertex
+ * shader with the same Aitoff projection, reading rotation, scale and
+ * translation from `Celestial.mapProjection` on every redraw, so pan and
+ * zoom cost one uniform update and one draw call.
+ *
+ * `projectSkyPoint` is the CPU twin of the shader, used for hover
+ * hit-testing and in unit tests.
+ */
+import type { SkyDensityCell as ApiSkyDensityCell } from '@/api/types';
+
+/** Projection parameters shared with d3-celestial (d3 v3 `geo.projection`). */
+export interface SkyProjectionParams {
+  /** `[λ, φ, γ]` rotation in degrees, as returned by `projection.rotate()`. */
+  rotate: [number, number, number];
+  /** `projection.scale()` in CSS pixels. */
+  scale: number;
+  /** `projection.translate()` in CSS pixels. */
+  translate: [number, number];
+}
+
+interface D3ProjectionLike {
+  rotate(): number[];
+  scale(): number;
+  translate(): number[];
+}
+
+/** Read the live projection parameters from d3-celestial's map projection. */
+export function readCelestialProjection(projection: unknown): SkyProjectionParams | null {
+  const p = projection as Partial<D3ProjectionLike> | null;
+  if (!p || typeof p.rotate !== 'function' || typeof p.scale !== 'function') return null;
+  if (typeof p.translate !== 'function') return null;
+  const [λ = 0, φ = 0, γ = 0] = p.rotate();
+  const [tx = 0, ty = 0] = p.translate();
+  return { rotate: [λ, φ, γ], scale: p.scale(), translate: [tx, ty] };
+}
+
+const D2R = Math.PI / 180;
+
+/**
+ * Project a geographic-convention sky position (`lon` ∈ [-180, 180], `lat`,
+ * both degrees) exactly as d3-celestial's Aitoff map does: d3's
+ * λ-then-φγ rotation, then `aitoff.raw(-λ, φ)`.
+ */
+export function projectSkyPoint(
+  lon: number,
+  lat: number,
+  params: SkyProjectionParams
+): [number, number] {
+  const [δλ, δφ, δγ] = params.rotate.map((v) => v * D2R);
+  let λ = lon * D2R + δλ;
+  if (λ > Math.PI) λ -= 2 * Math.PI;
+  else if (λ < -Math.PI) λ += 2 * Math.PI;
+  let φ = lat * D2R;
+  if (δφ !== 0 || δγ !== 0) {
+    const cosφ = Math.cos(φ);
+    const x = Math.cos(λ) * cosφ;
+    const y = Math.sin(λ) * cosφ;
+    const z = Math.sin(φ);
+    const k = z * Math.cos(δφ) + x * Math.sin(δφ);
+    λ = Math.atan2(y * Math.cos(δγ) - k * Math.sin(δγ), x * Math.cos(δφ) - z * Math.sin(δφ));
+    φ = Math.asin(Math.max(-1, Math.min(1, k * Math.cos(δγ) + y * Math.sin(δγ))));
+  }
+  const half = -λ / 2;
+  const cosφ = Math.cos(φ);
+  const α = Math.acos(Math.max(-1, Math.min(1, cosφ * Math.cos(half))));
+  const sinci = α > 1e-6 ? α / Math.sin(α) : 1;
+  const rx = 2 * cosφ * Math.sin(half) * sinci;
+  const ry = Math.sin(φ) * sinci;
+  return [params.translate[0] + rx * params.scale, params.translate[1] - ry * params.scale];
+}
+
+/** Marker styles understood by the fragment shader. */
+export const SKY_POINT_RING = 0;
+export const SKY_POINT_DISC = 1;
+export const SKY_POINT_SQUARE = 2;
+
+/**
+ * One layer of sprites.  `lon`/`lat` are degrees in d3-celestial's
+ * geographic convention; `color` is RGBA bytes per point.
+ */
+export interface SkyPointLayer {
+  count: number;
+  lon: Float32Array;
+  lat: Float32Array;
+  color: Uint8Array;
+  /** Sprite diameter: CSS pixels, or radians when `angularSize` is set. */
+  size: Float32Array;
+  style: Uint8Array;
+  /** Scale `size` with the projection (cells that cover a patch of sky). */
+  angularSize?: boolean;
+}
+
+/** Parse `#rgb`/`#rrggbb` into bytes; falls back to slate-400. */
+export function hexToRgb(color: string): [number, number, number] {
+  const hex = color.trim().replace(/^#/, '');
+  const full = hex.length === 3 ? hex.replace(/./g, (c) => c + c) : hex;
+  const value = /^[0-9a-f]{6}$/i.test(full) ? parseInt(full, 16) : 0x94a3b8;
+  return [(value >> 16) & 0xff, (value >> 8) & 0xff, value & 0xff];
+}
+
+const VERTEX_SHADER = `
+attribute vec2 a_lonlat;
+attribute vec4 a_color;
+attribute float a_size;
+attribute float a_style;
+uniform vec3 u_rotate;
+uniform float u_scale;
+uniform vec2 u_translate;
+uniform vec2 u_viewport;
+uniform float u_pixelRatio;
+uniform float u_angular;
+varying vec4 v_color;
+varying float v_style;
+const float PI = 3.141592653589793;
+const float D2R = PI / 180.0;
+
+void main() {
+  float lambda = a_lonlat.x * D2R + u_rotate.x;
+  if (lambda > PI) lambda -= 2.0 * PI;
+  else if (lambda < -PI) lambda += 2.0 * PI;
+  float phi = a_lonlat.y * D2R;
+  float cosPhi = cos(phi);
+  float x = cos(lambda) * cosPhi;
+  float y = sin(lambda) * cosPhi;
+  float z = sin(phi);
+  float k = z * cos(u_rotate.y) + x * sin(u_rotate.y);
+  lambda = atan(y * cos(u_rotate.z) - k * sin(u_rotate.z), x * cos(u_rotate.y) - z * sin(u_rotate.y));
+  phi = asin(clamp(k * cos(u_rotate.z) + y * sin(u_rotate.z), -1.0, 1.0));
+
+  // d3-celestial mirrors longitude: aitoff.raw(-lambda, phi).
+  float halfLambda = -lambda * 0.5;
+  cosPhi = cos(phi);
+  float alpha = acos(clamp(cosPhi * cos(halfLambda), -1.0, 1.0));
+  float sinci = alpha > 1e-6 ? alpha / sin(alpha) : 1.0;
+  vec2 px = u_translate + vec2(2.0 * cosPhi * sin(halfLambda), -sin(phi)) * sinci * u_scale;
+
+  vec2 clip = px / u_viewport * 2.0 - 1.0;
+  gl_Position = vec4(clip.x, -clip.y, 0.0, 1.0);
+  gl_PointSize = max(1.0, (u_angular > 0.5 ? a_size * u_scale : a_size) * u_pixelRatio);
+  v_color = a_color;
+  v_style = a_style;
+}
+`;
+
+const FRAGMENT_SHADER = `
+precision mediump float;
+varying vec4 v_color;
+varying float v_style;
+
+void main() {
+  vec2 c = gl_PointCoord * 2.0 - 1.0;
+  float r = length(c);
+  float alpha = v_color.a;
+  if (v_style < 1.5) {
+    if (r > 1.0) discard;
+    // Rings keep only the outer band, like the canvas stroke they replace.
+    if (v_style < 0.5 && r < 0.55) discard;
+  }
+  gl_FragColor = vec4(v_color.rgb * alpha, alpha);
+}
+`;
+
+export interface SkyPointsRenderer {
+  /** Upload the layer's attributes (once per data change). */
+  setLayer(layer: SkyPointLayer | null): void;
+  /** Draw with the given projection; `width`/`height` in CSS pixels. */
+  draw(params: SkyProjectionParams, width: number, height: number, pixelRatio: number): void;
+  dispose(): void;
+}
+
+function compile(gl: WebGLRenderingContext, type: number, source: string): WebGLShader {
+  const shader = gl.createShader(type);
+  if (!shader) throw new Error('Failed to allocate a WebGL shader');
+  gl.shaderSource(shader, source);
+  gl.compileShader(shader);
+  if (!gl.getShaderParameter(shader, gl.COMPILE_STATUS)) {
+    const log = gl.getShaderInfoLog(shader);
+    gl.deleteShader(shader);
+    throw new Error(`Sky map shader failed to compile: ${log}`);
+  }
+  return shader;
+}
+
+/**
+ * Create a renderer on `canvas`, or `null` when WebGL is unavailable (the
+ * caller then keeps drawing through d3-celestial's canvas context).
+ */
+export function createSkyPointsRenderer(canvas: HTMLCanvasElement): SkyPointsRenderer | null {
+  let gl: WebGLRenderingContext | null = null;
+  try {
+    gl = canvas.getContext('webgl', {
+      alpha: true,
+      premultipliedAlpha: true,
+      antialias: true,
+      // Lets "Download PNG" read the layer back after drawing.
+      preserveDrawingBuffer: true,
+    });
+  } catch {
+    gl = null;
+  }
+  if (!gl) return null;
+  const ctx = gl;
+
+  let program: WebGLProgram;
+  try {
+    const linked = ctx.createProgram();
+    if (!linked) return null;
+    ctx.attachShader(linked, compile(ctx, ctx.VERTEX_SHADER, VERTEX_SHADER));
+    ctx.attachShader(linked, compile(ctx, ctx.FRAGMENT_SHADER, FRAGMENT_SHADER));
+    ctx.linkProgram(linked);
+    if (!ctx.getProgramParameter(linked, ctx.LINK_STATUS)) {
+      console.error('[skyPointsGL] program failed to link', ctx.getProgramInfoLog(linked));
+      return null;
+    }
+    program = linked;
+  } catch (error) {
+    console.error('[skyPointsGL]', error);
+    return null;
+  }
+
+  const attributes = {
+    lonlat: ctx.getAttribLocation(program, 'a_lonlat'),
+    color: ctx.getAttribLocation(program, 'a_color'),
+    size: ctx.getAttribLocation(program, 'a_size'),
+    style: ctx.getAttribLocation(program, 'a_style'),
+  };
+  const uniforms = {
+    rotate: ctx.getUniformLocation(program, 'u_rotate'),
+    scale: ctx.getUniformLocation(program, 'u_scale'),
+    translate: ctx.getUniformLocation(program, 'u_translate'),
+    viewport: ctx.getUniformLocation(program, 'u_viewport'),
+    pixelRatio: ctx.getUniformLocation(program, 'u_pixelRatio'),
+    angular: ctx.getUniformLocation(program, 'u_angular'),
+  };
+  const buffers = {
+    lonlat: ctx.createBuffer(),
+    color: ctx.createBuffer(),
+    size: ctx.createBuffer(),
+    style: ctx.createBuffer(),
+  };
+  let count = 0;
+  let angular = false;
+
+  const upload = (buffer: WebGLBuffer | null, data: ArrayBufferView) => {
+    ctx.bindBuffer(ctx.ARRAY_BUFFER, buffer);
+    ctx.bufferData(ctx.ARRAY_BUFFER, data, ctx.STATIC_DRAW);
+  };
+
+  return {
+    setLayer(layer) {
+      count = layer?.count ?? 0;
+      angular = layer?.angularSize ?? false;
+      if (!layer || count === 0) return;
+      const lonlat = new Float32Array(count * 2);
+      for (let i = 0; i < count; i++) {
+        lonlat[2 * i] = layer.lon[i];
+        lonlat[2 * i + 1] = layer.lat[i];
+      }
+      upload(buffers.lonlat, lonlat);
+      upload(buffers.color, layer.color.subarray(0, count * 4));
+      upload(buffers.size, layer.size.subarray(0, count));
+      upload(buffers.style, Float32Array.from(layer.style.subarray(0, count)));
+    },
+
+    draw(params, width, height, pixelRatio) {
+      const targetWidth = Math.max(1, Math.round(width * pixelRatio));
+      const targetHeight = Math.max(1, Math.round(height * pixelRatio));
+      if (canvas.width !== targetWidth) canvas.width = targetWidth;
+      if (canvas.height !== targetHeight) canvas.height = targetHeight;
+      ctx.viewport(0, 0, targetWidth, targetHeight);
+      ctx.clearColor(0, 0, 0, 0);
+      ctx.clear(ctx.COLOR_BUFFER_BIT);
+      if (count === 0) return;
+
+      ctx.useProgram(program);
+      ctx.enable(ctx.BLEND);
+      ctx.blendFunc(ctx.ONE, ctx.ONE_MINUS_SRC_ALPHA);
+
+      ctx.bindBuffer(ctx.ARRAY_BUFFER, buffers.lonlat);
+      ctx.enableVertexAttribArray(attributes.lonlat);
+      ctx.vertexAttribPointer(attributes.lonlat, 2, ctx.FLOAT, false, 0, 0);
+      ctx.bindBuffer(ctx.ARRAY_BUFFER, buffers.color);
+      ctx.enableVertexAttribArray(attributes.color);
+      ctx.vertexAttribPointer(attributes.color, 4, ctx.UNSIGNED_BYTE, true, 0, 0);
+      ctx.bindBuffer(ctx.ARRAY_BUFFER, buffers.size);
+      ctx.enableVertexAttribArray(attributes.size);
+      ctx.vertexAttribPointer(attributes.size, 1, ctx.FLOAT, false, 0, 0);
+      ctx.bindBuffer(ctx.ARRAY_BUFFER, buffers.style);
+      ctx.enableVertexAttribArray(attributes.style);
+      ctx.vertexAttribPointer(attributes.style, 1, ctx.FLOAT, false, 0, 0);
+
+      ctx.uniform3f(
+        uniforms.rotate,
+        params.rotate[0] * D2R,
+        params.rotate[1] * D2R,
+        params.rotate[2] * D2R
+      );
+      ctx.uniform1f(uniforms.scale, params.scale);
+      ctx.uniform2f(uniforms.translate, params.translate[0], params.translate[1]);
+      ctx.uniform2f(uniforms.viewport, width, height);
+      ctx.uniform1f(uniforms.pixelRatio, pixelRatio);
+      ctx.uniform1f(uniforms.angular, angular ? 1 : 0);
+      ctx.drawArrays(ctx.POINTS, 0, count);
+    },
+
+    dispose() {
+      Object.values(buffers).forEach((buffer) => ctx.deleteBuffer(buffer));
+      ctx.deleteProgram(program);
+    },
+  };
+}
+
+// ── Layer builders ──────────────────────────────────────────────────────────
+
+/** Minimal target shape needed to build the point layer. */
+export interface SkyTarget {
+  priority: number;
+  target_ra_deg: number;
+  target_dec_deg: number;
+  scheduled_period: unknown | null;
+}
+
+/** Minimal priority-bin shape (`PriorityBinInfo`). */
+export interface SkyPriorityBin {
+  min_priority: number;
+  max_priority: number;
+  color: string;
+}
+
+/** d3-celestial's geographic longitude for a right ascension in degrees. */
+export function raToCelestialLon(raDeg: number): number {
+  return raDeg > 180 ? raDeg - 360 : raDeg;
+}
+
+/**
+ * Targets as sprites: per-priority-bin colour, filled discs for scheduled
+ * targets and rings for unscheduled ones (the canvas renderer's styling).
+ */
+export function buildTargetLayer(
+  targets: readonly SkyTarget[],
+  bins: readonly SkyPriorityBin[]
+): SkyPointLayer {
+  const count = targets.length;
+  const binColors = bins.map((bin) => hexToRgb(bin.color));
+  const fallback = hexToRgb('#94a3b8');
+  const layer: SkyPointLayer = {
+    count,
+    lon: new Float32Array(count),
+    lat: new Float32Array(count),
+    color: new Uint8Array(count * 4),
+    size: new Float32Array(count),
+    style: new Uint8Array(count),
+  };
+  for (let i = 0; i < count; i++) {
+    const target = targets[i];
+    layer.lon[i] = raToCelestialLon(target.target_ra_deg);
+    layer.lat[i] = target.target_dec_deg;
+    const bin = bins.findIndex(
+      (b) => target.priority >= b.min_priority && target.priority <= b.max_priority
+    );
+    const [r, g, b] = bin >= 0 ? binColors[bin] : fallback;
+    const scheduled = target.scheduled_period !== null;
+    layer.color.set([r, g, b, scheduled ? 217 : 115], i * 4);
+    layer.size[i] = scheduled ? 8 : 5;
+    layer.style[i] = scheduled ? SKY_POINT_DISC : SKY_POINT_RING;
+  }
+  return layer;
+}
+
+/** The fields of a `/sky-map?resolution=…` cell used for drawing. */
+export type SkyDensityCell = Pick<ApiSkyDensityCell, 'ra_deg' | 'dec_deg' | 'count'>;
+
+/** Colour ramp for density cells (dark blue → cyan → yellow). */
+const DENSITY_RAMP: [number, number, number][] = [
+  [30, 58, 138],
+  [8, 145, 178],
+  [52, 211, 153],
+  [250, 204, 21],
+];
+
+function densityColor(t: number): [number, number, number] {
+  const scaled = Math.max(0, Math.min(1, t)) * (DENSITY_RAMP.length - 1);
+  const lo = Math.floor(scaled);
+  const hi = Math.min(lo + 1, DENSITY_RAMP.length - 1);
+  const f = scaled - lo;
+  const a = DENSITY_RAMP[lo];
+  const b = DENSITY_RAMP[hi];
+  return [0, 1, 2].map((c) => Math.round(a[c] + (b[c] - a[c]) * f)) as [number, number, number];
+}
+
+/**
+ * Density cells as square sprites sized to the cell's angular width and
+ * coloured by log-count.
+ */
+export function buildDensityLayer(
+  cells: readonly SkyDensityCell[],
+  cellSizeDeg: number
+): SkyPointLayer {
+  const count = cells.length;
+  const maxLog = Math.log1p(cells.reduce((max, cell) => Math.max(max, cell.count), 0));
+  const layer: SkyPointLayer = {
+    count,
+    lon: new Float32Array(count),
+    lat: new Float32Array(count),
+    color: new Uint8Array(count * 4),
+    size: new Float32Array(count),
+    style: new Uint8Array(count).fill(SKY_POINT_SQUARE),
+    angularSize: true,
+  };
+  // Slight overlap hides seams between neighbouring cells.
+  const size = cellSizeDeg * D2R * 1.15;
+  for (let i = 0; i < count; i++) {
+    const cell = cells[i];
+    layer.lon[i] = raToCelestialLon(cell.ra_deg);
+    layer.lat[i] = cell.dec_deg;
+    const [r, g, b] = densityColor(maxLog > 0 ? Math.log1p(cell.count) / maxLog : 0);
+    layer.color.set([r, g, b, 170], i * 4);
+    layer.size[i] = size;
+  }
+  return layer;
+}
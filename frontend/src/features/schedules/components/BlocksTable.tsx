@@ -10,10 +10,17 @@
  * Used in VisibilityMap, Insights, and other drill-down views.
  */
 import { useState, useMemo, useCallback, memo, useEffect, useDeferredValue } from 'react';
+import { transfer } from 'comlink';
 import { useBlockSelection } from '../context/AnalysisContext';
 import { useAsyncMemo } from '@/hooks/useAsyncMemo';
-import { sortFilterBlocks as sortFilterBlocksSync } from '@/workers/aggregations';
-import { getAggregationsClient } from '@/workers/aggregationsClient';
+import { useWorkerDataset } from '@/hooks/useWorkerDataset';
+import { getAggregationsPool } from '@/workers/aggregationsClient';
+import {
+  blockColumnsFromBlocks,
+  blockColumnsTransferables,
+  createBlockQueryIndex,
+  sortFilterBlockColumns,
+} from '@/workers/blockColumns';
 
 const FILTERING_HINT_DELAY_MS = 200;
 
@@ -93,35 +100,55 @@ function BlocksTableInner<T extends TableBlock>({
 
   // Filter and sort the full block set (sorting happens BEFORE pagination so
   // page slices reflect the chosen sort order across the whole dataset).
-  // For small inputs we compute synchronously to avoid the postMessage hop;
-  // for larger ones we offload to the shared aggregations worker and keep
-  // showing the previous result until the new one resolves.
-  const useWorker = blocks.length > WORKER_BLOCKS_THRESHOLD;
+  // Both paths produce a permutation of row indices into `blocks`.  Small
+  // inputs are sorted inline; larger ones are loaded once into the shared
+  // aggregations worker as typed-array columns, and each filter/sort change
+  // sends only the query.  The previous order stays visible until the new
+  // one resolves.
+  const pool = blocks.length > WORKER_BLOCKS_THRESHOLD ? getAggregationsPool() : null;
+  const sort = useMemo(
+    () => ({ field: sortField, direction: sortDirection }),
+    [sortField, sortDirection]
+  );
 
-  const inlineSorted = useMemo(
+  const inline = useMemo(
+    () =>
+      pool ? null : { columns: blockColumnsFromBlocks(blocks), index: createBlockQueryIndex() },
+    [pool, blocks]
+  );
+  const inlineOrder = useMemo(
     () =>
-      sortFilterBlocksSync(blocks, deferredFilter, {
-        field: sortField,
-        direction: sortDirection,
-      }),
-    [blocks, deferredFilter, sortField, sortDirection]
+      inline ? sortFilterBlockColumns(inline.columns, deferredFilter, sort, inline.index) : null,
+    [inline, deferredFilter, sort]
   );
 
-  const { value: sortedBlocks } = useAsyncMemo<T[]>(
-    () => {
-      if (!useWorker) return inlineSorted;
-      const client = getAggregationsClient();
-      if (!client) return inlineSorted;
-      return client.sortFilterBlocks(blocks, deferredFilter, {
-        field: sortField,
-        direction: sortDirection,
-      }) as Promise<T[]>;
+  const dataset = useWorkerDataset(pool, blocks, (client) => {
+    const columns = blockColumnsFromBlocks(blocks);
+    return client.loadBlockDataset(transfer(columns, blockColumnsTransferables(columns)));
+  });
+
+  // Latest wins: a new filter keystroke aborts the previous query, dropping
+  // it from the worker queue if it has not started yet.
+  const { value: workerOrder } = useAsyncMemo<{ source: object; order: Uint32Array } | null>(
+    (signal) => {
+      if (!pool || !dataset) return null;
+      return pool
+        .run(
+          'sortFilterBlockDataset',
+          (client) => client.sortFilterBlockDataset(dataset.handle, deferredFilter, sort),
+          { worker: dataset.worker, signal }
+        )
+        .then((order) => ({ source: dataset.source, order }));
     },
-    [useWorker, blocks, deferredFilter, sortField, sortDirection, inlineSorted],
-    inlineSorted
+    [pool, dataset, deferredFilter, sort],
+    null
   );
 
-  const totalRows = sortedBlocks.length;
+  const order =
+    inlineOrder ?? (workerOrder && workerOrder.source === blocks ? workerOrder.order : null);
+  const isOrdering = order === null && blocks.length > 0;
+
+  const totalRows = order?.length ?? 0;
   const pageSize = Math.max(1, maxRows);
   const totalPages = Math.max(1, Math.ceil(totalRows / pageSize));
   const safePage = Math.min(page, totalPages - 1);
@@ -133,10 +160,10 @@ function BlocksTableInner<T extends TableBlock>({
   }, [deferredFilter, sortField, sortDirection, blocks, pageSize]);
 
   const processedBlocks = useMemo(() => {
-    if (totalRows <= pageSize) return sortedBlocks;
+    if (!order) return [];
     const start = safePage * pageSize;
-    return sortedBlocks.slice(start, start + pageSize);
-  }, [sortedBlocks, safePage, pageSize, totalRows]);
+    return Array.from(order.subarray(start, start + pageSize), (row) => blocks[row]);
+  }, [order, blocks, safePage, pageSize]);
 
   const showPagination = totalRows > pageSize;
   const pageStart = totalRows === 0 ? 0 : safePage * pageSize + 1;
@@ -206,7 +233,7 @@ function BlocksTableInner<T extends TableBlock>({
     return <span className="ml-1 text-primary-400">{sortDirection === 'asc' ? '↑' : '↓'}</span>;
   };
 
-  if (isLoading) {
+  if (isLoading || isOrdering) {
     return (
       <div className="rounded-lg border border-slate-700 bg-slate-800/50 p-8 text-center">
         <div className="inline-block h-6 w-6 animate-spin rounded-full border-2 border-slate-600 border-t-primary-500" />
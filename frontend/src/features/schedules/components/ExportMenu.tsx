@@ -26,6 +26,13 @@ import {
 interface ExportMenuProps<T extends ExportableBlock> {
   /** All blocks currently visible/filtered */
   blocks: T[];
+  /**
+   * Loads the filtered blocks on demand, for tables that only hold the
+   * visible rows.  When set, `blocks` may be empty and `filteredCount`
+   * gives the number of blocks an export will contain.
+   */
+  resolveBlocks?: () => Promise<T[]>;
+  filteredCount?: number;
   /** Total blocks before filtering (for metadata) */
   totalBlocks?: number;
   /** Columns to include in CSV export */
@@ -36,12 +43,15 @@ interface ExportMenuProps<T extends ExportableBlock> {
 
 export function ExportMenu<T extends ExportableBlock>({
   blocks,
+  resolveBlocks,
+  filteredCount,
   totalBlocks,
   columns,
   className = '',
 }: ExportMenuProps<T>) {
   const [isOpen, setIsOpen] = useState(false);
   const [copied, setCopied] = useState<string | null>(null);
+  const [isResolving, setIsResolving] = useState(false);
   const menuRef = useRef<HTMLDivElement>(null);
   const { scheduleId } = useParams();
   const currentId = parseInt(scheduleId ?? '0', 10);
@@ -59,9 +69,33 @@ export function ExportMenu<T extends ExportableBlock>({
     return () => document.removeEventListener('mousedown', handleClickOutside);
   }, []);
 
-  // Get selected blocks
+  // Get selected blocks.  With lazy loading the selection is only known by
+  // id until the blocks are resolved.
   const selectedBlocks = blocks.filter((b) => selectedBlockIds.has(b.scheduling_block_id));
-  const hasSelection = selectedBlocks.length > 0;
+  const hasSelection = resolveBlocks ? selectedBlockIds.size > 0 : selectedBlocks.length > 0;
+  const selectionCount = resolveBlocks ? selectedBlockIds.size : selectedBlocks.length;
+  const exportCount = filteredCount ?? blocks.length;
+
+  // Run an export action on the filtered (or selected) blocks, loading them
+  // first when the caller supplies them lazily.
+  const withBlocks = useCallback(
+    (action: (blocksToExport: T[]) => void | Promise<void>, selectionOnly = false) =>
+      async () => {
+        let source = blocks;
+        if (resolveBlocks) {
+          setIsResolving(true);
+          try {
+            source = await resolveBlocks();
+          } finally {
+            setIsResolving(false);
+          }
+        }
+        await action(
+          selectionOnly ? source.filter((b) => selectedBlockIds.has(b.scheduling_block_id)) : source
+        );
+      },
+    [blocks, resolveBlocks, selectedBlockIds]
+  );
 
   // Build export metadata
   const buildMetadata = useCallback(
@@ -72,10 +106,10 @@ export function ExportMenu<T extends ExportableBlock>({
       filters: {
         selectedBlockCount: selectedBlockIds.size || undefined,
       },
-      totalBlocks: totalBlocks ?? blocks.length,
+      totalBlocks: totalBlocks ?? exportCount,
       exportedBlocks: exportedBlocks.length,
     }),
-    [currentId, selectedSchedule, selectedBlockIds.size, totalBlocks, blocks.length]
+    [currentId, selectedSchedule, selectedBlockIds.size, totalBlocks, exportCount]
   );
 
   // Export handlers
@@ -162,24 +196,24 @@ export function ExportMenu<T extends ExportableBlock>({
         <div className="absolute right-0 top-full z-50 mt-1 w-56 rounded-lg border border-slate-600 bg-slate-800 py-1 shadow-lg">
           {/* Export all filtered */}
           <div className="border-b border-slate-700 px-3 py-1.5 text-xs font-medium uppercase tracking-wider text-slate-400">
-            Export Filtered ({blocks.length})
+            Export Filtered ({exportCount}){isResolving && ' · loading…'}
           </div>
           <button
-            onClick={() => handleExportCSV(blocks)}
+            onClick={withBlocks(handleExportCSV)}
             className="flex w-full items-center gap-2 px-3 py-2 text-left text-sm text-slate-200 hover:bg-slate-700"
           >
             <Icon name="chart-bar" className="h-4 w-4 text-slate-400" />
             Download as CSV
           </button>
           <button
-            onClick={() => handleExportJSON(blocks)}
+            onClick={withBlocks(handleExportJSON)}
             className="flex w-full items-center gap-2 px-3 py-2 text-left text-sm text-slate-200 hover:bg-slate-700"
           >
             <Icon name="brackets" className="h-4 w-4 text-slate-400" />
             Download as JSON
           </button>
           <button
-            onClick={() => handleExportBlockIds(blocks)}
+            onClick={withBlocks(handleExportBlockIds)}
             className="flex w-full items-center gap-2 px-3 py-2 text-left text-sm text-slate-200 hover:bg-slate-700"
           >
             <Icon name="list" className="h-4 w-4 text-slate-400" />
@@ -190,17 +224,17 @@ export function ExportMenu<T extends ExportableBlock>({
           {hasSelection && (
             <>
               <div className="border-b border-t border-slate-700 px-3 py-1.5 text-xs font-medium uppercase tracking-wider text-slate-400">
-                Export Selection ({selectedBlocks.length})
+                Export Selection ({selectionCount})
               </div>
               <button
-                onClick={() => handleExportCSV(selectedBlocks)}
+                onClick={withBlocks(handleExportCSV, true)}
                 className="flex w-full items-center gap-2 px-3 py-2 text-left text-sm text-slate-200 hover:bg-slate-700"
               >
                 <Icon name="chart-bar" className="h-4 w-4 text-slate-400" />
                 Selection as CSV
               </button>
               <button
-                onClick={() => handleExportJSON(selectedBlocks)}
+                onClick={withBlocks(handleExportJSON, true)}
                 className="flex w-full items-center gap-2 px-3 py-2 text-left text-sm text-slate-200 hover:bg-slate-700"
               >
                 <Icon name="brackets" className="h-4 w-4 text-slate-400" />
@@ -214,7 +248,7 @@ export function ExportMenu<T extends ExportableBlock>({
             Quick Actions
           </div>
           <button
-            onClick={() => handleCopyBlockIds(hasSelection ? selectedBlocks : blocks)}
+            onClick={withBlocks(handleCopyBlockIds, hasSelection)}
             className="flex w-full items-center justify-between px-3 py-2 text-left text-sm text-slate-200 hover:bg-slate-700"
           >
             <span className="flex items-center gap-2">
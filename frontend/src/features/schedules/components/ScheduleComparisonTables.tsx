@@ -1,22 +1,29 @@
 import { type ReactNode, useCallback, useEffect, useMemo, useState } from 'react';
+import { transfer } from 'comlink';
 import { mjdToDate, isValidDate } from '@/constants/dates';
 import type { ScheduleAnalysisData } from '../hooks/useScheduleAnalysisData';
 import { groupEquivalentSchedules } from '../analytics';
 import { useAsyncMemo } from '@/hooks/useAsyncMemo';
+import { useWorkerDataset } from '@/hooks/useWorkerDataset';
+import { getAggregationsPool } from '@/workers/aggregationsClient';
 import {
-  computeBlockStatusMap as computeBlockStatusMapSync,
-  type BlockStatusInputSchedule,
-} from '@/workers/aggregations';
-import { getAggregationsClient } from '@/workers/aggregationsClient';
+  comparisonColumnsFromRows,
+  comparisonColumnsTransferables,
+  rankStrings,
+  sortComparisonColumns,
+  type ComparisonQuery,
+} from '@/workers/blockColumns';
 
 const PAGE_SIZE = 100;
 
+const EMPTY_ORDER = new Uint32Array(0);
+
 /**
- * Skip the worker round-trip when the per-page workload is small.  The
- * aggregation cost scales with `schedules.length * pageBlockIds.length`
- * (each schedule's blocks are scanned once per page render).
+ * Below this many unique blocks the status table is sorted inline; above it
+ * the rows are loaded into the aggregations worker once and each sort/filter
+ * change only sends the query.
  */
-const WORKER_BLOCK_MAP_THRESHOLD = 200;
+const WORKER_BLOCK_STATUS_THRESHOLD = 2000;
 
 function formatMjdUtc(mjd: number | null | undefined): string {
   if (mjd == null || !Number.isFinite(mjd)) return '—';
@@ -483,21 +490,11 @@ export function SummaryTable({ schedules }: { schedules: ScheduleAnalysisData[]
   );
 }
 
-interface BlockEntry {
-  original_block_id: string;
-  maxPriority: number;
-  maxRequestedHours: number;
-  perSchedule: Record<
-    number,
-    { scheduled: boolean; start_mjd: number | null; requested_hours: number }
-  >;
-}
-
 /**
- * Lightweight per-block aggregate used for sorting/filtering across the full
- * dataset. Holds only the fields required by `sortBlockSummaries` and the
- * "differences only" filter so we can avoid allocating the heavier
- * `BlockEntry` objects for blocks that are not on the current page.
+ * Per-block aggregate across the compared schedules.  Sorting and the
+ * "differences only" filter run over its columnar form
+ * (`comparisonColumnsFromRows`); rows are looked up by permutation index
+ * only for the current page.
  */
 interface BlockSummary {
   original_block_id: string;
@@ -522,70 +519,6 @@ function compareNumber(left: number, right: number): number {
   return left - right;
 }
 
-function compareScheduleEntry(
-  left: { scheduled: boolean; start_mjd: number | null } | undefined,
-  right: { scheduled: boolean; start_mjd: number | null } | undefined
-): number {
-  const leftRank = left ? (left.scheduled ? 0 : 1) : 2;
-  const rightRank = right ? (right.scheduled ? 0 : 1) : 2;
-
-  if (leftRank !== rightRank) {
-    return leftRank - rightRank;
-  }
-
-  if (left?.scheduled && right?.scheduled) {
-    const leftStart = left.start_mjd ?? Number.POSITIVE_INFINITY;
-    const rightStart = right.start_mjd ?? Number.POSITIVE_INFINITY;
-    const byStart = compareNumber(leftStart, rightStart);
-    if (byStart !== 0) {
-      return byStart;
-    }
-  }
-
-  return 0;
-}
-
-function sortBlocks<T extends BlockSummary>(
-  blocks: T[],
-  sortField: BlockSortField,
-  sortDirection: BlockSortDirection
-): T[] {
-  const directionMultiplier = sortDirection === 'asc' ? 1 : -1;
-
-  return [...blocks].sort((left, right) => {
-    let comparison = 0;
-
-    switch (sortField.kind) {
-      case 'blockId':
-        comparison = compareText(left.original_block_id, right.original_block_id);
-        break;
-      case 'priority':
-        comparison = compareNumber(left.maxPriority, right.maxPriority);
-        break;
-      case 'duration':
-        comparison = compareNumber(left.maxRequestedHours, right.maxRequestedHours);
-        break;
-      case 'schedule':
-        comparison = compareScheduleEntry(
-          left.perSchedule[sortField.scheduleId],
-          right.perSchedule[sortField.scheduleId]
-        );
-        break;
-    }
-
-    if (comparison !== 0) {
-      return comparison * directionMultiplier;
-    }
-
-    const byPriority = compareNumber(left.maxPriority, right.maxPriority);
-    if (byPriority !== 0) {
-      return byPriority * -1;
-    }
-
-    return compareText(left.original_block_id, right.original_block_id);
-  });
-}
-
 export function BlockStatusTable({ schedules }: { schedules: ScheduleAnalysisData[] }) {
   const [page, setPage] = useState(0);
   const [showDifferencesOnly, setShowDifferencesOnly] = useState(false);
@@ -624,33 +557,73 @@ export function BlockStatusTable({ schedules }: { schedules: ScheduleAnalysisDat
     return map;
   }, [schedules]);
 
-  const sortedSummaries = useMemo(
-    () => sortBlocks([...blockSummaries.values()], sortField, sortDirection),
-    [blockSummaries, sortDirection, sortField]
+  const summaryRows = useMemo(() => [...blockSummaries.values()], [blockSummaries]);
+
+  const query = useMemo<ComparisonQuery>(
+    () => ({
+      sort:
+        sortField.kind === 'schedule'
+          ? {
+              kind: 'schedule',
+              scheduleIndex: Math.max(
+                0,
+                schedules.findIndex((schedule) => schedule.id === sortField.scheduleId)
+              ),
+            }
+          : sortField,
+      direction: sortDirection,
+      differencesOnly: showDifferencesOnly,
+    }),
+    [schedules, sortField, sortDirection, showDifferencesOnly]
   );
 
-  const filteredSummaries = useMemo(() => {
-    if (!showDifferencesOnly) return sortedSummaries;
+  const scheduleIds = useMemo(() => schedules.map((schedule) => schedule.id), [schedules]);
 
-    return sortedSummaries.filter((block) => {
-      const states = schedules.map((schedule) => {
-        const entry = block.perSchedule[schedule.id];
-        if (!entry) return 'missing' as const;
-        return entry.scheduled ? 'scheduled' : 'unscheduled';
-      });
+  // Sorting returns a permutation of `summaryRows`.  Large comparisons keep
+  // their columns resident in the aggregations worker.
+  const pool = summaryRows.length > WORKER_BLOCK_STATUS_THRESHOLD ? getAggregationsPool() : null;
 
-      const allScheduled = states.every((state) => state === 'scheduled');
-      const allUnscheduled = states.every((state) => state === 'unscheduled');
+  const inlineColumns = useMemo(() => {
+    if (pool) return null;
+    const columns = comparisonColumnsFromRows(summaryRows, scheduleIds);
+    return { columns, idRanks: rankStrings(columns.blockId) };
+  }, [pool, summaryRows, scheduleIds]);
 
-      return !allScheduled && !allUnscheduled;
-    });
-  }, [showDifferencesOnly, sortedSummaries, schedules]);
+  const inlineOrder = useMemo(
+    () =>
+      inlineColumns
+        ? sortComparisonColumns(inlineColumns.columns, query, inlineColumns.idRanks)
+        : null,
+    [inlineColumns, query]
+  );
 
-  const blockIds = useMemo(
-    () => filteredSummaries.map((block) => block.original_block_id),
-    [filteredSummaries]
+  const dataset = useWorkerDataset(pool, summaryRows, (client) => {
+    const columns = comparisonColumnsFromRows(summaryRows, scheduleIds);
+    return client.loadComparisonDataset(
+      transfer(columns, comparisonColumnsTransferables(columns))
+    );
+  });
+
+  const { value: workerOrder } = useAsyncMemo<{ source: object; order: Uint32Array } | null>(
+    (signal) => {
+      if (!pool || !dataset) return null;
+      return pool
+        .run(
+          'sortComparisonDataset',
+          (client) => client.sortComparisonDataset(dataset.handle, query),
+          { worker: dataset.worker, signal }
+        )
+        .then((order) => ({ source: dataset.source, order }));
+    },
+    [pool, dataset, query],
+    null
   );
 
+  const order =
+    inlineOrder ??
+    (workerOrder && workerOrder.source === summaryRows ? workerOrder.order : null) ??
+    EMPTY_ORDER;
+
   useEffect(() => {
     setPage(0);
   }, [showDifferencesOnly, schedules, sortDirection, sortField]);
@@ -686,72 +659,21 @@ export function BlockStatusTable({ schedules }: { schedules: ScheduleAnalysisDat
     return <span className="ml-1 text-sky-400">{sortDirection === 'asc' ? '↑' : '↓'}</span>;
   };
 
-  const totalPages = Math.ceil(blockIds.length / PAGE_SIZE);
+  const totalPages = Math.ceil(order.length / PAGE_SIZE);
   const currentPage = totalPages === 0 ? 0 : Math.min(page, totalPages - 1);
 
-  const pageBlockIds = useMemo(
-    () => blockIds.slice(currentPage * PAGE_SIZE, (currentPage + 1) * PAGE_SIZE),
-    [blockIds, currentPage]
-  );
-
-  // Build the heavier per-row map only for the visible page slice. Keyed by
-  // [currentPage, schedules, blockIds] so we re-aggregate only when the user
-  // navigates pages or the underlying data/sort changes.  When the workload
-  // grows large enough we offload it to the shared aggregations worker so
-  // the main thread stays responsive while users page through results.
-  const workerSchedulesPayload = useMemo<BlockStatusInputSchedule[]>(
-    () =>
-      schedules
-        .filter((s) => s.insights)
-        .map((s) => ({
-          id: s.id,
-          blocks: s.insights!.blocks.map((b) => ({
-            original_block_id: b.original_block_id,
-            priority: b.priority,
-            requested_hours: b.requested_hours,
-            scheduled: b.scheduled,
-            scheduled_start_mjd: b.scheduled_start_mjd,
-          })),
-        })),
-    [schedules]
-  );
-
-  const useWorkerForBlockMap =
-    workerSchedulesPayload.length * pageBlockIds.length > WORKER_BLOCK_MAP_THRESHOLD;
-
-  const inlineBlockMap = useMemo<Map<string, BlockEntry>>(
-    () =>
-      computeBlockStatusMapSync(workerSchedulesPayload, pageBlockIds) as unknown as Map<
-        string,
-        BlockEntry
-      >,
-    [workerSchedulesPayload, pageBlockIds]
-  );
-
-  const { value: pageBlockMap } = useAsyncMemo<Map<string, BlockEntry>>(
-    () => {
-      if (!useWorkerForBlockMap) return inlineBlockMap;
-      const client = getAggregationsClient();
-      if (!client) return inlineBlockMap;
-      return client
-        .computeBlockStatusMap(workerSchedulesPayload, pageBlockIds)
-        .then((m) => m as unknown as Map<string, BlockEntry>);
-    },
-    [useWorkerForBlockMap, workerSchedulesPayload, pageBlockIds, inlineBlockMap],
-    inlineBlockMap
-  );
-
   const pageBlocks = useMemo(
     () =>
-      pageBlockIds
-        .map((id) => pageBlockMap.get(id))
-        .filter((entry): entry is BlockEntry => entry !== undefined),
-    [pageBlockIds, pageBlockMap]
+      Array.from(
+        order.subarray(currentPage * PAGE_SIZE, (currentPage + 1) * PAGE_SIZE),
+        (row) => summaryRows[row]
+      ),
+    [order, currentPage, summaryRows]
   );
 
   return (
     <ComparePanel
-      title={`Block Status (${blockIds.length} of ${sortedSummaries.length} unique blocks)`}
+      title={`Block Status (${order.length} of ${summaryRows.length} unique blocks)`}
       headerActions={
         <div className="flex items-center gap-3">
           <button
@@ -0,0 +1,75 @@
+/**
+ * Tests for VirtualBlocksTable headers and server-driven sorting/filtering.
+ */
+import { describe, it, expect, vi } from 'vitest';
+import { render, screen } from '../../../test/test-utils';
+import { fireEvent } from '@testing-library/react';
+import { AnalysisProvider } from '../context/AnalysisContext';
+import { VirtualBlocksTable } from './VirtualBlocksTable';
+import type { TableBlock } from './BlocksTable';
+
+const makeBlock = (id: number): TableBlock => ({
+  scheduling_block_id: id,
+  original_block_id: `OB-${id}`,
+  priority: 5,
+  scheduled: id % 2 === 0,
+});
+
+function renderTable(props: {
+  rowCount: number;
+  totalCount?: number;
+  filter?: string;
+  onSortChange?: (field: 'priority' | 'scheduled') => void;
+  onFilterChange?: (filter: string) => void;
+}) {
+  return render(
+    <AnalysisProvider syncToUrl={false}>
+      <VirtualBlocksTable
+        rowCount={props.rowCount}
+        totalCount={props.totalCount}
+        rowAt={(i) => makeBlock(i + 1)}
+        onRangeChange={() => {}}
+        sort={{ field: 'priority', direction: 'desc' }}
+        onSortChange={props.onSortChange ?? (() => {})}
+        prioritySortField="priority"
+        statusSortField="scheduled"
+        filter={props.filter ?? ''}
+        onFilterChange={props.onFilterChange ?? (() => {})}
+      />
+    </AnalysisProvider>
+  );
+}
+
+describe('VirtualBlocksTable', () => {
+  it('shows matched and total counts', () => {
+    renderTable({ rowCount: 5, totalCount: 10 });
+    expect(screen.getByText(/5 of 10 blocks/)).toBeInTheDocument();
+  });
+
+  it('marks the active sort column', () => {
+    renderTable({ rowCount: 2 });
+    expect(screen.getByRole('columnheader', { name: /priority/i })).toHaveAttribute(
+      'aria-sort',
+      'descending'
+    );
+    expect(screen.getByRole('columnheader', { name: /status/i })).toHaveAttribute(
+      'aria-sort',
+      'none'
+    );
+  });
+
+  it('asks the caller to re-sort when a sortable header is clicked', () => {
+    const onSortChange = vi.fn();
+    renderTable({ rowCount: 2, onSortChange });
+    fireEvent.click(screen.getByRole('columnheader', { name: /status/i }));
+    expect(onSortChange).toHaveBeenCalledWith('scheduled');
+  });
+
+  it('forwards the text filter and reports an empty result', () => {
+    const onFilterChange = vi.fn();
+    renderTable({ rowCount: 0, filter: 'vega', onFilterChange });
+    expect(screen.getByText('No blocks match your filter')).toBeInTheDocument();
+    fireEvent.change(screen.getByPlaceholderText(/filter by id/i), { target: { value: 'deneb' } });
+    expect(onFilterChange).toHaveBeenCalledWith('deneb');
+  });
+});
@@ -0,0 +1,320 @@
+/**
+ * VirtualBlocksTable - Windowed block table for server-paginated data.
+ *
+ * Unlike BlocksTable, this table does not own the rows: a react-window
+ * `List` renders only the rows in (and just around) the viewport, asks
+ * `rowAt` for each, and reports the rendered range through `onRangeChange`
+ * so the caller can load the matching pages.  Sorting and the text filter
+ * are controlled props that the caller forwards to the server.  Rows not
+ * yet loaded render as placeholders, so the scrollbar always spans
+ * `rowCount`.
+ */
+import { useCallback, memo, type CSSProperties, type ReactNode } from 'react';
+import { List, type RowComponentProps } from 'react-window';
+import { useBlockSelection } from '../context/AnalysisContext';
+import type { TableBlock } from './BlocksTable';
+
+const ROW_HEIGHT = 44;
+const OVERSCAN_ROWS = 10;
+const DEFAULT_LIST_HEIGHT = 560;
+
+export type VirtualSortDirection = 'asc' | 'desc';
+
+export interface VirtualBlocksColumn<T extends TableBlock, S extends string> {
+  label: string;
+  /** CSS grid track for the column (default `6rem`). */
+  width?: string;
+  className?: string;
+  /** Server sort key behind this header, if sortable. */
+  sortField?: S;
+  render: (block: T) => ReactNode;
+}
+
+interface VirtualBlocksTableProps<T extends TableBlock, S extends string> {
+  /** Rows matching the current filters. */
+  rowCount: number;
+  /** Rows before filtering, shown as "N of M blocks". */
+  totalCount?: number;
+  /** Row at a table position, or undefined while its page loads. */
+  rowAt: (index: number) => T | undefined;
+  /** Called with the rendered row range (end exclusive). */
+  onRangeChange: (start: number, end: number) => void;
+  sort: { field: S; direction: VirtualSortDirection };
+  onSortChange: (field: S) => void;
+  /** Server sort keys behind the built-in Priority / Status headers. */
+  prioritySortField?: S;
+  statusSortField?: S;
+  extraColumns?: VirtualBlocksColumn<T, S>[];
+  filter: string;
+  onFilterChange: (filter: string) => void;
+  onBlockClick?: (block: T) => void;
+  title?: string;
+  isLoading?: boolean;
+  /** A page request is in flight (shown as a subtle hint, rows stay visible). */
+  isFetching?: boolean;
+  showSelection?: boolean;
+  /** Maximum height of the scrolling list. */
+  height?: number;
+}
+
+function VirtualBlocksTableInner<T extends TableBlock, S extends string>({
+  rowCount,
+  totalCount,
+  rowAt,
+  onRangeChange,
+  sort,
+  onSortChange,
+  prioritySortField,
+  statusSortField,
+  extraColumns = [],
+  filter,
+  onFilterChange,
+  onBlockClick,
+  title = 'Blocks',
+  isLoading = false,
+  isFetching = false,
+  showSelection = true,
+  height = DEFAULT_LIST_HEIGHT,
+}: VirtualBlocksTableProps<T, S>) {
+  const { selectedBlockIds, selectBlocks, addToSelection, removeFromSelection, isSelected } =
+    useBlockSelection();
+
+  const handleRowSelect = useCallback(
+    (block: TableBlock, event: React.MouseEvent) => {
+      event.stopPropagation();
+      const id = block.scheduling_block_id;
+      if (isSelected(id)) {
+        removeFromSelection([id]);
+      } else if (event.shiftKey) {
+        addToSelection([id]);
+      } else {
+        selectBlocks([id]);
+      }
+    },
+    [isSelected, removeFromSelection, addToSelection, selectBlocks]
+  );
+
+  const gridTemplateColumns = [
+    showSelection ? '2.5rem' : null,
+    'minmax(0, 1fr)',
+    '6rem',
+    '8rem',
+    ...extraColumns.map((column) => column.width ?? '6rem'),
+  ]
+    .filter(Boolean)
+    .join(' ');
+
+  const SortableHeader = ({ label, field }: { label: string; field?: S }) => {
+    if (!field) {
+      return <div role="columnheader">{label}</div>;
+    }
+    const active = sort.field === field;
+    return (
+      <div
+        role="columnheader"
+        className="cursor-pointer hover:text-white"
+        onClick={() => onSortChange(field)}
+        aria-sort={active ? (sort.direction === 'asc' ? 'ascending' : 'descending') : 'none'}
+      >
+        {label}
+        {active ? (
+          <span className="ml-1 text-primary-400">{sort.direction === 'asc' ? '↑' : '↓'}</span>
+        ) : (
+          <span className="ml-1 text-slate-600">↕</span>
+        )}
+      </div>
+    );
+  };
+
+  return (
+    <div className="rounded-lg border border-slate-700 bg-slate-800/50">
+      {/* Header */}
+      <div className="flex items-center justify-between border-b border-slate-700 px-4 py-3">
+        <div className="flex items-center gap-3">
+          {title && <h3 className="text-sm font-medium text-white">{title}</h3>}
+          <span className="text-xs text-slate-400">
+            {rowCount}
+            {totalCount !== undefined && rowCount !== totalCount && ` of ${totalCount}`} blocks
+          </span>
+          {selectedBlockIds.size > 0 && (
+            <span className="rounded-full bg-primary-600/20 px-2 py-0.5 text-xs text-primary-400">
+              {selectedBlockIds.size} selected
+            </span>
+          )}
+          {isFetching && !isLoading && (
+            <span className="text-xs text-slate-500" role="status" aria-live="polite">
+              Loading…
+            </span>
+          )}
+        </div>
+        <div className="flex items-center gap-2">
+          <input
+            type="text"
+            placeholder="Filter by ID or name..."
+            value={filter}
+            onChange={(e) => onFilterChange(e.target.value)}
+            className="w-48 rounded border border-slate-600 bg-slate-700 px-2 py-1 text-xs text-white placeholder-slate-400 focus:border-primary-500 focus:outline-none"
+          />
+          {selectedBlockIds.size > 0 && (
+            <button
+              onClick={() => selectBlocks([])}
+              className="text-xs text-slate-400 hover:text-white"
+            >
+              Clear selection
+            </button>
+          )}
+        </div>
+      </div>
+
+      {/* Column headers */}
+      <div
+        role="row"
+        className="grid items-center gap-x-3 border-b border-slate-700 px-3 py-2.5 text-left text-xs uppercase tracking-wider text-slate-400"
+        style={{ gridTemplateColumns }}
+      >
+        {showSelection && <div role="columnheader" aria-label="Selection" />}
+        <div role="columnheader">Block ID</div>
+        <SortableHeader label="Priority" field={prioritySortField} />
+        <SortableHeader label="Status" field={statusSortField} />
+        {extraColumns.map((column) => (
+          <SortableHeader key={column.label} label={column.label} field={column.sortField} />
+        ))}
+      </div>
+
+      {isLoading ? (
+        <div className="p-8 text-center">
+          <div className="inline-block h-6 w-6 animate-spin rounded-full border-2 border-slate-600 border-t-primary-500" />
+          <p className="mt-2 text-sm text-slate-400">Loading blocks...</p>
+        </div>
+      ) : rowCount === 0 ? (
+        <div className="px-4 py-8 text-center text-sm text-slate-400">
+          {filter ? 'No blocks match your filter' : 'No blocks available'}
+        </div>
+      ) : (
+        <List
+          // A new sort or filter is a new row set: start again at the top.
+          key={`${sort.field}:${sort.direction}:${filter}`}
+          rowCount={rowCount}
+          rowHeight={ROW_HEIGHT}
+          rowComponent={renderVirtualBlockRow}
+          rowProps={{
+            // The row renderer is not generic; T only narrows what callers see.
+            rowAt: rowAt as (index: number) => TableBlock | undefined,
+            columns: extraColumns as unknown as VirtualBlocksColumn<TableBlock, string>[],
+            gridTemplateColumns,
+            showSelection,
+            selectedBlockIds,
+            onBlockClick: onBlockClick as ((block: TableBlock) => void) | undefined,
+            onSelect: handleRowSelect,
+          }}
+          onRowsRendered={({ startIndex, stopIndex }) => onRangeChange(startIndex, stopIndex + 1)}
+          overscanCount={OVERSCAN_ROWS}
+          style={{ height: Math.min(height, rowCount * ROW_HEIGHT) }}
+          className="scrollbar-thin"
+        />
+      )}
+    </div>
+  );
+}
+
+interface VirtualRowData {
+  rowAt: (index: number) => TableBlock | undefined;
+  columns: VirtualBlocksColumn<TableBlock, string>[];
+  gridTemplateColumns: string;
+  showSelection: boolean;
+  selectedBlockIds: ReadonlySet<number>;
+  onBlockClick?: (block: TableBlock) => void;
+  onSelect: (block: TableBlock, event: React.MouseEvent) => void;
+}
+
+const VirtualBlockRow = memo(function VirtualBlockRow({
+  index,
+  style,
+  ariaAttributes,
+  rowAt,
+  columns,
+  gridTemplateColumns,
+  showSelection,
+  selectedBlockIds,
+  onBlockClick,
+  onSelect,
+}: RowComponentProps<VirtualRowData>) {
+  const block = rowAt(index);
+  const rowStyle: CSSProperties = { ...style, gridTemplateColumns };
+
+  if (!block) {
+    return (
+      <div {...ariaAttributes} style={rowStyle} className="flex items-center px-3">
+        <div className="h-3 w-1/3 animate-pulse rounded bg-slate-700/60" />
+      </div>
+    );
+  }
+
+  const selected = selectedBlockIds.has(block.scheduling_block_id);
+  return (
+    <div
+      {...ariaAttributes}
+      style={rowStyle}
+      onClick={() => onBlockClick?.(block)}
+      className={`grid cursor-pointer items-center gap-x-3 border-b border-slate-700/50 px-3 text-sm transition-colors ${
+        selected ? 'bg-primary-600/10 hover:bg-primary-600/20' : 'hover:bg-slate-700/30'
+      }`}
+    >
+      {showSelection && (
+        <div>
+          <input
+            type="checkbox"
+            aria-label={`Select block ${block.scheduling_block_id}`}
+            checked={selected}
+            onClick={(e) => onSelect(block, e)}
+            onChange={() => {}} // Controlled by onClick
+            className="rounded border-slate-500 bg-slate-700 text-primary-600 focus:ring-primary-500"
+          />
+        </div>
+      )}
+      <div className="truncate font-mono text-xs">
+        <span className="text-slate-500">#{block.scheduling_block_id}</span>
+        <span className="ml-2 text-slate-300">{block.original_block_id}</span>
+        {block.block_name && <span className="ml-2 text-slate-400">{block.block_name}</span>}
+      </div>
+      <div>
+        <span
+          className={`font-medium ${
+            block.priority >= 8
+              ? 'text-red-400'
+              : block.priority >= 5
+                ? 'text-amber-400'
+                : 'text-slate-300'
+          }`}
+        >
+          {block.priority.toFixed(1)}
+        </span>
+      </div>
+      <div>
+        {block.scheduled ? (
+          <span className="inline-flex items-center gap-1 text-emerald-400">
+            <span className="h-1.5 w-1.5 rounded-full bg-emerald-400" />
+            Scheduled
+          </span>
+        ) : (
+          <span className="inline-flex items-center gap-1 text-slate-400">
+            <span className="h-1.5 w-1.5 rounded-full bg-slate-500" />
+            Unscheduled
+          </span>
+        )}
+      </div>
+      {columns.map((column) => (
+        <div key={column.label} className={column.className}>
+          {column.render(block)}
+        </div>
+      ))}
+    </div>
+  );
+});
+
+const renderVirtualBlockRow = (props: RowComponentProps<VirtualRowData>) => (
+  <VirtualBlockRow {...props} />
+);
+
+// Memoize with generic support
+export const VirtualBlocksTable = memo(VirtualBlocksTableInner) as typeof VirtualBlocksTableInner;
@@ -10,6 +10,11 @@ export { SchedulePicker } from './SchedulePicker';
 export { SummaryTable, BlockStatusTable } from './ScheduleComparisonTables';
 export { ComparisonCharts } from './ScheduleComparisonCharts';
 export { BlocksTable, type TableBlock } from './BlocksTable';
+export {
+  VirtualBlocksTable,
+  type VirtualBlocksColumn,
+  type VirtualSortDirection,
+} from './VirtualBlocksTable';
 export { BlockDetailsDrawer } from './BlockDetailsDrawer';
 export { ExportMenu } from './ExportMenu';
 export { default as EnvironmentVerdict } from './EnvironmentVerdict';
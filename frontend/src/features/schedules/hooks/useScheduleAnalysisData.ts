@@ -48,7 +48,7 @@ export function useScheduleAnalysisData(
   const insightQueries = useQueries({
     queries: ids.map((id) => ({
       queryKey: queryKeys.insights(id),
-      queryFn: ({ signal }: { signal: AbortSignal }) => api.getInsights(id, { signal }),
+      queryFn: ({ signal }: { signal: AbortSignal }) => api.getInsights(id, undefined, { signal }),
       enabled: id > 0,
     })),
   });
@@ -8,3 +8,16 @@ export type {
 } from './usePlotlyChartChrome';
 export { useRemountDetector, useRenderCounter } from './useRemountDetector';
 export { useSiderust } from './useSiderust';
+export {
+  useVisibilityBlockPages,
+  VISIBILITY_PAGE_SIZE,
+  type VisibilityBlockPages,
+  type VisibilityBlocksFilter,
+  type VisibilityBlocksSummary,
+} from './useVisibilityBlockPages';
+export {
+  useSchedulePrefetch,
+  PREFETCH_GRAPH,
+  type PrefetchableView,
+  type ScheduleView,
+} from './useSchedulePrefetch';
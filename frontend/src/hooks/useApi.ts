@@ -9,7 +9,11 @@ import type {
   TrendsQuery,
   CompareQuery,
   VisibilityHistogramQuery,
+  VisibilityBlocksQuery,
   UpdateScheduleRequest,
+  SkyMapQuery,
+  DistributionsQuery,
+  InsightsQuery,
   AltAzRequest,
   CreateEnvironmentRequest,
   BulkImportRequest,
@@ -23,18 +27,35 @@ import type {
  */
 const HEAVY_SCHEDULE_GC_TIME_MS = 5 * 60_000;
 
+/** HEALPix density summary the Sky Map opens with (`nside` 32, ~1.8° cells). */
+export const SKY_MAP_SUMMARY_QUERY: SkyMapQuery = { resolution: 32 };
+
+/**
+ * Aggregates the Distributions page charts: server-side histograms instead
+ * of every block, so large schedules transfer kilobytes rather than rows.
+ */
+export const DISTRIBUTIONS_SUMMARY_QUERY: DistributionsQuery = { bins: 30, blocks: false };
+
+/** The Insights page shows aggregates only; per-block rows are not needed. */
+export const INSIGHTS_SUMMARY_QUERY: InsightsQuery = { blocks: false };
+
+/** Binning the Trends page starts from. */
+export const DEFAULT_TRENDS_QUERY = { bins: 10, bandwidth: 0.5 };
+
 // Query keys factory
 export const queryKeys = {
   health: ['health'] as const,
   schedules: ['schedules'] as const,
   schedule: (id: number) => ['schedule', id] as const,
-  skyMap: (id: number) => ['skyMap', id] as const,
-  distributions: (id: number) => ['distributions', id] as const,
+  skyMap: (id: number, query?: SkyMapQuery) => ['skyMap', id, query] as const,
+  distributions: (id: number, query?: DistributionsQuery) => ['distributions', id, query] as const,
   visibilityMap: (id: number) => ['visibilityMap', id] as const,
+  visibilityBlocks: (id: number, query: VisibilityBlocksQuery, page: number) =>
+    ['visibilityBlocks', id, query, page] as const,
   visibilityHistogram: (id: number, query?: VisibilityHistogramQuery) =>
     ['visibilityHistogram', id, query] as const,
   timeline: (id: number) => ['timeline', id] as const,
-  insights: (id: number) => ['insights', id] as const,
+  insights: (id: number, query?: InsightsQuery) => ['insights', id, query] as const,
   fragmentation: (id: number) => ['fragmentation', id] as const,
   algorithmTrace: (id: number) => ['algorithmTrace', id] as const,
   altAz: (id: number, request?: AltAzRequest) => ['altAz', id, request] as const,
@@ -132,19 +153,22 @@ export function useUpdateSchedule() {
 }
 
 // Visualization hooks
-export function useSkyMap(scheduleId: number) {
+export function useSkyMap(scheduleId: number, query?: SkyMapQuery, enabled = true) {
   return useQuery({
-    queryKey: queryKeys.skyMap(scheduleId),
-    queryFn: ({ signal }) => api.getSkyMap(scheduleId, { signal }),
-    enabled: scheduleId > 0,
+    queryKey: queryKeys.skyMap(scheduleId, query),
+    queryFn: ({ signal }) => api.getSkyMap(scheduleId, query, { signal }),
+    enabled: scheduleId > 0 && enabled,
     gcTime: HEAVY_SCHEDULE_GC_TIME_MS,
   });
 }
 
-export function useDistributions(scheduleId: number) {
+export function useDistributions(
+  scheduleId: number,
+  query: DistributionsQuery = DISTRIBUTIONS_SUMMARY_QUERY
+) {
   return useQuery({
-    queryKey: queryKeys.distributions(scheduleId),
-    queryFn: ({ signal }) => api.getDistributions(scheduleId, { signal }),
+    queryKey: queryKeys.distributions(scheduleId, query),
+    queryFn: ({ signal }) => api.getDistributions(scheduleId, query, { signal }),
     enabled: scheduleId > 0,
     gcTime: HEAVY_SCHEDULE_GC_TIME_MS,
   });
@@ -177,10 +201,10 @@ export function useTimeline(scheduleId: number) {
   });
 }
 
-export function useInsights(scheduleId: number) {
+export function useInsights(scheduleId: number, query: InsightsQuery = INSIGHTS_SUMMARY_QUERY) {
   return useQuery({
-    queryKey: queryKeys.insights(scheduleId),
-    queryFn: ({ signal }) => api.getInsights(scheduleId, { signal }),
+    queryKey: queryKeys.insights(scheduleId, query),
+    queryFn: ({ signal }) => api.getInsights(scheduleId, query, { signal }),
     enabled: scheduleId > 0,
     gcTime: HEAVY_SCHEDULE_GC_TIME_MS,
   });
@@ -8,7 +8,9 @@
  *     resolved value is kept so the UI doesn't flash empty.
  *   - `pending` flips to `true` only after `pendingDelayMs` of waiting, to
  *     avoid flicker on near-instant computations.
- *   - Stale results from outdated computations are dropped.
+ *   - Stale results from outdated computations are dropped, and the
+ *     `AbortSignal` passed to `compute` is aborted so in-flight work (e.g. a
+ *     queued worker request) can be cancelled — latest wins.
  *
  * NOTE: kept tiny and dependency-free on purpose; no scheduler libraries.
  */
@@ -25,7 +27,7 @@ export interface UseAsyncMemoResult<T> {
 }
 
 export function useAsyncMemo<T>(
-  compute: () => T | Promise<T>,
+  compute: (signal: AbortSignal) => T | Promise<T>,
   deps: ReadonlyArray<unknown>,
   initial: T,
   options: UseAsyncMemoOptions = {}
@@ -41,8 +43,9 @@ export function useAsyncMemo<T>(
     const myGen = ++generationRef.current;
     let pendingTimer: ReturnType<typeof setTimeout> | null = null;
     let settled = false;
+    const controller = new AbortController();
 
-    const result = compute();
+    const result = compute(controller.signal);
 
     if (!(result instanceof Promise)) {
       setState((prev) => (prev.pending ? { value: result, pending: false } : { value: result, pending: false }));
@@ -70,6 +73,7 @@ export function useAsyncMemo<T>(
       });
 
     return () => {
+      if (!settled) controller.abort();
       settled = true;
       if (pendingTimer) clearTimeout(pendingTimer);
     };
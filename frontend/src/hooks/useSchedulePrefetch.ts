@@ -0,0 +1,114 @@
+/**
+ * `useSchedulePrefetch` — warm the analytics a user is likely to open next.
+ *
+ * Each schedule view lists the views usually visited after it in
+ * `PREFETCH_GRAPH`.  When a view opens, their queries are prefetched in
+ * idle time, a couple at a time, with the exact keys those pages use, so
+ * switching tabs finds the data already cached.  Queries that are still
+ * fresh are skipped by React Query, and stored responses are revalidated
+ * with a 304 rather than downloaded again.
+ */
+import { useEffect } from 'react';
+import { useQueryClient, type QueryClient } from '@tanstack/react-query';
+import { api } from '@/api';
+import { runInIdleTime } from '@/lib/idleQueue';
+import {
+  DEFAULT_TRENDS_QUERY,
+  DISTRIBUTIONS_SUMMARY_QUERY,
+  INSIGHTS_SUMMARY_QUERY,
+  SKY_MAP_SUMMARY_QUERY,
+  queryKeys,
+} from './useApi';
+
+/** Prefetches in flight at once; leaves connections free for the page itself. */
+const PREFETCH_CONCURRENCY = 2;
+
+/** Schedule views, by their route segment under `/schedules/:scheduleId/`. */
+export type ScheduleView =
+  | 'sky-map'
+  | 'distributions'
+  | 'visibility-map'
+  | 'timeline'
+  | 'insights'
+  | 'fragmentation'
+  | 'trends'
+  | 'alt-az'
+  | 'validation'
+  | 'compare';
+
+/** Views whose opening query can be prefetched. */
+export type PrefetchableView = Exclude<ScheduleView, 'visibility-map' | 'alt-az' | 'compare'>;
+
+/** Likely next views, most likely first. */
+export const PREFETCH_GRAPH: Record<ScheduleView, PrefetchableView[]> = {
+  'sky-map': ['distributions', 'insights', 'timeline'],
+  distributions: ['insights', 'sky-map', 'trends'],
+  'visibility-map': ['timeline', 'sky-map'],
+  timeline: ['insights', 'fragmentation', 'validation'],
+  insights: ['distributions', 'trends', 'timeline'],
+  fragmentation: ['timeline', 'insights'],
+  trends: ['insights', 'distributions'],
+  'alt-az': ['sky-map', 'timeline'],
+  validation: ['insights', 'timeline'],
+  compare: ['insights', 'distributions'],
+};
+
+function prefetchView(queryClient: QueryClient, view: PrefetchableView, id: number) {
+  switch (view) {
+    case 'sky-map':
+      return queryClient.prefetchQuery({
+        queryKey: queryKeys.skyMap(id, SKY_MAP_SUMMARY_QUERY),
+        queryFn: ({ signal }) => api.getSkyMap(id, SKY_MAP_SUMMARY_QUERY, { signal }),
+      });
+    case 'distributions':
+      return queryClient.prefetchQuery({
+        queryKey: queryKeys.distributions(id, DISTRIBUTIONS_SUMMARY_QUERY),
+        queryFn: ({ signal }) => api.getDistributions(id, DISTRIBUTIONS_SUMMARY_QUERY, { signal }),
+      });
+    case 'timeline':
+      return queryClient.prefetchQuery({
+        queryKey: queryKeys.timeline(id),
+        queryFn: ({ signal }) => api.getTimeline(id, { signal }),
+      });
+    case 'insights':
+      return queryClient.prefetchQuery({
+        queryKey: queryKeys.insights(id, INSIGHTS_SUMMARY_QUERY),
+        queryFn: ({ signal }) => api.getInsights(id, INSIGHTS_SUMMARY_QUERY, { signal }),
+      });
+    case 'fragmentation':
+      return queryClient.prefetchQuery({
+        queryKey: queryKeys.fragmentation(id),
+        queryFn: ({ signal }) => api.getFragmentation(id, { signal }),
+      });
+    case 'trends':
+      return queryClient.prefetchQuery({
+        queryKey: queryKeys.trends(id, DEFAULT_TRENDS_QUERY),
+        queryFn: ({ signal }) => api.getTrends(id, DEFAULT_TRENDS_QUERY, { signal }),
+      });
+    case 'validation':
+      return queryClient.prefetchQuery({
+        queryKey: queryKeys.validationReport(id),
+        queryFn: ({ signal }) => api.getValidationReport(id, { signal }),
+      });
+  }
+}
+
+function isScheduleView(view: string | undefined): view is ScheduleView {
+  return view !== undefined && Object.prototype.hasOwnProperty.call(PREFETCH_GRAPH, view);
+}
+
+/**
+ * Prefetch the likely next views of `scheduleId` while `view` is open.
+ * Pending prefetches are dropped when the view or schedule changes.
+ */
+export function useSchedulePrefetch(scheduleId: number, view: string | undefined) {
+  const queryClient = useQueryClient();
+
+  useEffect(() => {
+    if (!(scheduleId > 0) || !isScheduleView(view)) return;
+    const tasks = PREFETCH_GRAPH[view].map(
+      (next) => () => prefetchView(queryClient, next, scheduleId)
+    );
+    return runInIdleTime(tasks, PREFETCH_CONCURRENCY);
+  }, [queryClient, scheduleId, view]);
+}
@@ -0,0 +1,169 @@
+/**
+ * `useVisibilityBlockPages` — windowed access to the server-sorted
+ * visibility-map block table.
+ *
+ * The table reports which rows it is showing and only the pages covering
+ * that range are queried, so a few hundred rows are held regardless of the
+ * schedule size.  Pages are requested by keyset cursor when the previous
+ * page has been seen (sequential scrolling) and by offset otherwise
+ * (scrollbar jumps).  Both return the same rows, so the cursor is not part
+ * of the query key.
+ */
+import { useCallback, useMemo, useRef, useState } from 'react';
+import { keepPreviousData, useQueries } from '@tanstack/react-query';
+import { api } from '@/api';
+import type {
+  VisibilityBlockCursor,
+  VisibilityBlockSummary,
+  VisibilityBlocksPage,
+  VisibilityBlocksQuery,
+} from '@/api/types';
+import { queryKeys } from './useApi';
+
+export const VISIBILITY_PAGE_SIZE = 200;
+
+/** Largest page the server hands out; used when walking every row for export. */
+const EXPORT_PAGE_SIZE = 1000;
+
+/** Pages drop out of the cache shortly after they scroll out of view. */
+const PAGE_GC_TIME_MS = 15_000;
+
+export type VisibilityBlocksFilter = Omit<
+  VisibilityBlocksQuery,
+  'after_key' | 'after_id' | 'offset' | 'limit'
+>;
+
+export type VisibilityBlocksSummary = Omit<VisibilityBlocksPage, 'blocks' | 'next_cursor'>;
+
+export interface VisibilityBlockPages {
+  /** Counts and priority range from the latest page; undefined until one arrives. */
+  summary: VisibilityBlocksSummary | undefined;
+  /** Row at a position in the sorted, filtered table, if its page is loaded. */
+  rowAt: (index: number) => VisibilityBlockSummary | undefined;
+  /** Tell the hook which rows are on screen (end exclusive). */
+  setRange: (start: number, end: number) => void;
+  isLoading: boolean;
+  isFetching: boolean;
+  error: Error | null;
+  /** Fetch every matching row in table order, e.g. for export. */
+  loadAll: (signal?: AbortSignal) => Promise<VisibilityBlockSummary[]>;
+}
+
+function cursorParams(cursor: VisibilityBlockCursor) {
+  return { after_key: cursor.key, after_id: cursor.id };
+}
+
+export function useVisibilityBlockPages(
+  scheduleId: number,
+  filter: VisibilityBlocksFilter
+): VisibilityBlockPages {
+  const filterKey = JSON.stringify(filter);
+
+  // Visible page range, tagged with the filter it was measured under so a
+  // filter change starts again from the first page.
+  const [range, setRangeState] = useState({ filterKey, first: 0, last: 0 });
+  const first = range.filterKey === filterKey ? range.first : 0;
+  const last = range.filterKey === filterKey ? range.last : 0;
+
+  // Cursor that starts page `n`, learned from page `n - 1`.
+  const cursorsRef = useRef({ filterKey, byPage: new Map<number, VisibilityBlockCursor>() });
+  if (cursorsRef.current.filterKey !== filterKey) {
+    cursorsRef.current = { filterKey, byPage: new Map() };
+  }
+  const cursors = cursorsRef.current.byPage;
+
+  const pages = useMemo(
+    () => Array.from({ length: last - first + 1 }, (_, i) => first + i),
+    [first, last]
+  );
+
+  const results = useQueries({
+    queries: pages.map((page) => ({
+      queryKey: queryKeys.visibilityBlocks(scheduleId, filter, page),
+      queryFn: async ({ signal }: { signal: AbortSignal }) => {
+        const cursor = cursors.get(page);
+        const data = await api.getVisibilityBlocks(
+          scheduleId,
+          {
+            ...filter,
+            limit: VISIBILITY_PAGE_SIZE,
+            ...(cursor ? cursorParams(cursor) : { offset: page * VISIBILITY_PAGE_SIZE }),
+          },
+          { signal }
+        );
+        if (data.next_cursor) {
+          cursors.set(page + 1, data.next_cursor);
+        }
+        return data;
+      },
+      enabled: scheduleId > 0,
+      gcTime: PAGE_GC_TIME_MS,
+      placeholderData: keepPreviousData,
+    })),
+  });
+
+  const setRange = useCallback(
+    (start: number, end: number) => {
+      const nextFirst = Math.max(0, Math.floor(start / VISIBILITY_PAGE_SIZE));
+      const nextLast = Math.max(nextFirst, Math.floor((end - 1) / VISIBILITY_PAGE_SIZE));
+      setRangeState((current) =>
+        current.filterKey === filterKey &&
+        current.first === nextFirst &&
+        current.last === nextLast
+          ? current
+          : { filterKey, first: nextFirst, last: nextLast }
+      );
+    },
+    [filterKey]
+  );
+
+  const rowAt = useCallback(
+    (index: number) => {
+      const page = Math.floor(index / VISIBILITY_PAGE_SIZE);
+      if (page < first || page > last) return undefined;
+      return results[page - first]?.data?.blocks[index % VISIBILITY_PAGE_SIZE];
+    },
+    [results, first, last]
+  );
+
+  const latest = results.find((r) => r.data)?.data;
+  const summary = useMemo<VisibilityBlocksSummary | undefined>(
+    () =>
+      latest && {
+        matched_count: latest.matched_count,
+        total_count: latest.total_count,
+        scheduled_count: latest.scheduled_count,
+        priority_min: latest.priority_min,
+        priority_max: latest.priority_max,
+      },
+    [latest]
+  );
+
+  const loadAll = useCallback(
+    async (signal?: AbortSignal) => {
+      const rows: VisibilityBlockSummary[] = [];
+      let cursor: VisibilityBlockCursor | null = null;
+      do {
+        const data: VisibilityBlocksPage = await api.getVisibilityBlocks(
+          scheduleId,
+          { ...filter, limit: EXPORT_PAGE_SIZE, ...(cursor ? cursorParams(cursor) : {}) },
+          { signal }
+        );
+        rows.push(...data.blocks);
+        cursor = data.next_cursor;
+      } while (cursor);
+      return rows;
+    },
+    [scheduleId, filter]
+  );
+
+  return {
+    summary,
+    rowAt,
+    setRange,
+    isLoading: !latest && results.some((r) => r.isLoading),
+    isFetching: results.some((r) => r.isFetching),
+    error: results.find((r) => r.error)?.error ?? null,
+    loadAll,
+  };
+}
@@ -0,0 +1,49 @@
+/**
+ * `useWorkerDataset` — keep a columnar dataset resident in the aggregations
+ * worker pool for as long as the component needs it.
+ *
+ * Returns the dataset's worker slot and handle once loaded (`null` before
+ * that, or when `pool` is `null`).  Datasets are shared per `source`
+ * identity, so several tables over the same schedule load it only once.
+ */
+import { useEffect, useState } from 'react';
+import {
+  acquireWorkerDataset,
+  type AggregationsClient,
+  type AggregationsPool,
+  type ResidentDataset,
+} from '@/workers/aggregationsClient';
+
+export interface WorkerDatasetHandle extends ResidentDataset {
+  /** The `source` this handle was loaded from. */
+  source: object;
+}
+
+export function useWorkerDataset(
+  pool: AggregationsPool | null,
+  source: object,
+  load: (client: AggregationsClient) => Promise<number>
+): WorkerDatasetHandle | null {
+  const [dataset, setDataset] = useState<WorkerDatasetHandle | null>(null);
+
+  useEffect(() => {
+    if (!pool) return;
+    let active = true;
+    const { dataset: loaded, release } = acquireWorkerDataset(pool, source, load);
+    loaded
+      .then((value) => {
+        if (active) setDataset({ ...value, source });
+      })
+      .catch(() => {
+        if (active) setDataset(null);
+      });
+    return () => {
+      active = false;
+      release();
+    };
+    // `load` is derived from `source`; keying on it would reload every render.
+    // eslint-disable-next-line react-hooks/exhaustive-deps
+  }, [pool, source]);
+
+  return dataset && dataset.source === source ? dataset : null;
+}
@@ -0,0 +1,50 @@
+import { describe, expect, it, vi, afterEach, beforeEach } from 'vitest';
+import { runInIdleTime } from './idleQueue';
+
+function deferred() {
+  let resolve!: () => void;
+  const promise = new Promise<void>((r) => (resolve = r));
+  return { promise, resolve };
+}
+
+describe('runInIdleTime', () => {
+  beforeEach(() => {
+    vi.useFakeTimers();
+  });
+
+  afterEach(() => {
+    vi.useRealTimers();
+  });
+
+  it('keeps at most `concurrency` tasks in flight, in order', async () => {
+    const gates = [deferred(), deferred(), deferred()];
+    const started: number[] = [];
+    const tasks = gates.map((gate, i) => () => {
+      started.push(i);
+      return gate.promise;
+    });
+
+    runInIdleTime(tasks, 2);
+    await vi.runAllTimersAsync();
+    expect(started).toEqual([0, 1]);
+
+    gates[0].resolve();
+    await vi.runAllTimersAsync();
+    expect(started).toEqual([0, 1, 2]);
+  });
+
+  it('moves on after a failed task', async () => {
+    const second = vi.fn(() => Promise.resolve());
+    runInIdleTime([() => Promise.reject(new Error('offline')), second], 1);
+    await vi.runAllTimersAsync();
+    expect(second).toHaveBeenCalledOnce();
+  });
+
+  it('does not start tasks after cancellation', async () => {
+    const task = vi.fn(() => Promise.resolve());
+    const cancel = runInIdleTime([task, task], 1);
+    cancel();
+    await vi.runAllTimersAsync();
+    expect(task).not.toHaveBeenCalled();
+  });
+});
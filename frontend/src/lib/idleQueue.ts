@@ -0,0 +1,53 @@
+/**
+ * Run background work when the browser is idle, a few tasks at a time.
+ *
+ * Used for speculative fetches that must never compete with the page the
+ * user is looking at: each task starts from an idle callback, and at most
+ * `concurrency` tasks are in flight.
+ */
+
+export type IdleTask = () => Promise<unknown>;
+
+type Cancel = () => void;
+
+function whenIdle(callback: () => void): Cancel {
+  if (typeof window !== 'undefined' && 'requestIdleCallback' in window) {
+    const handle = window.requestIdleCallback(callback);
+    return () => window.cancelIdleCallback(handle);
+  }
+  const handle = setTimeout(callback, 1);
+  return () => clearTimeout(handle);
+}
+
+/**
+ * Start `tasks` in order during idle periods.  Task failures are ignored.
+ * Returns a function that stops tasks that have not started yet.
+ */
+export function runInIdleTime(tasks: IdleTask[], concurrency = 2): Cancel {
+  let cancelled = false;
+  let next = 0;
+  const pending = new Set<Cancel>();
+
+  const startNext = () => {
+    if (cancelled || next >= tasks.length) return;
+    const task = tasks[next++];
+    const cancel = whenIdle(() => {
+      pending.delete(cancel);
+      if (cancelled) return;
+      task()
+        .catch(() => undefined)
+        .finally(startNext);
+    });
+    pending.add(cancel);
+  };
+
+  for (let i = 0; i < Math.min(Math.max(1, concurrency), tasks.length); i++) {
+    startNext();
+  }
+
+  return () => {
+    cancelled = true;
+    pending.forEach((cancel) => cancel());
+    pending.clear();
+  };
+}
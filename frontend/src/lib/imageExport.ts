@@ -34,6 +34,29 @@ export function downloadCanvasAsPng(canvas: HTMLCanvasElement, filename: string)
   downloadPngDataUrl(canvas.toDataURL('image/png'), filename);
 }
 
+/**
+ * Export stacked canvases (e.g. a WebGL overlay over a 2D base) as one PNG.
+ * Layers are stretched to the first canvas' backing size, drawn in order.
+ */
+export function downloadCanvasLayersAsPng(
+  layers: readonly HTMLCanvasElement[],
+  filename: string
+): void {
+  const [base] = layers;
+  if (!base) return;
+  if (layers.length === 1) {
+    downloadCanvasAsPng(base, filename);
+    return;
+  }
+  const composite = document.createElement('canvas');
+  composite.width = base.width;
+  composite.height = base.height;
+  const ctx = composite.getContext('2d');
+  if (!ctx) return;
+  for (const layer of layers) ctx.drawImage(layer, 0, 0, base.width, base.height);
+  downloadCanvasAsPng(composite, filename);
+}
+
 /**
  * Trigger a download for an SVG markup string.
  */
@@ -3,8 +3,12 @@ import ReactDOM from 'react-dom/client';
 import { QueryClient, QueryClientProvider } from '@tanstack/react-query';
 import { BrowserRouter } from 'react-router-dom';
 import App from './App';
+import { api, createIndexedDbStore } from './api';
 import './index.css';
 
+// Keep schedule analytics across reloads; revalidated by ETag on use.
+api.setResponseStore(createIndexedDbStore());
+
 const queryClient = new QueryClient({
   defaultOptions: {
     queries: {
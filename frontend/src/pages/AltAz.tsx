@@ -77,7 +77,8 @@ interface UniqueTarget extends TargetForComputation {
 const raDecKey = (ra: number, dec: number) => `${ra.toFixed(4)}_${dec.toFixed(4)}`;
 
 const DEFAULT_PERIOD_HOURS = 24;
-const TARGET_SAMPLE_INTERVAL_MINUTES = 10;
+const DEFAULT_SAMPLE_INTERVAL_MINUTES = 10;
+const SAMPLE_INTERVAL_OPTIONS = [1, 5, 10, 30, 60];
 
 const mjdToDate = (mjd: number): Date => new Date((mjd - 40587) * 86400000);
 
@@ -99,7 +100,9 @@ function parseDateTimeLocalUtc(value: string): Date {
 // ─── Target selector ─────────────────────────────────────────────────
 
 const MAX_DISPLAY = 200;
-const MAX_TARGETS = 10;
+const MAX_TARGETS = 200;
+/** Above this many curves Plotly's SVG renderer gets sluggish; switch to WebGL. */
+const WEBGL_TRACE_THRESHOLD = 20;
 
 // Stable colors for altitude traces
 const TRACE_COLORS = [
@@ -148,6 +151,10 @@ function AltAz() {
     return formatDateTimeLocalUtc(end);
   });
 
+  const [sampleIntervalMinutes, setSampleIntervalMinutes] = useState(
+    DEFAULT_SAMPLE_INTERVAL_MINUTES
+  );
+
   // Target selection
   const [selectedKeys, setSelectedKeys] = useState<Set<string>>(new Set());
   const [search, setSearch] = useState('');
@@ -208,6 +215,7 @@ function AltAz() {
       },
       start_mjd: dateToMjd(startDate),
       end_mjd: dateToMjd(endDate),
+      sample_interval_minutes: sampleIntervalMinutes,
       targets: selectedTargets.map(
         (target): AltAzTargetRequest => ({
           original_block_id: target.original_block_id,
@@ -218,7 +226,7 @@ function AltAz() {
         })
       ),
     };
-  }, [hasValidWindow, selectedTargets, observatory, startDate, endDate]);
+  }, [hasValidWindow, selectedTargets, observatory, startDate, endDate, sampleIntervalMinutes]);
 
   const {
     data: altAzData,
@@ -230,7 +238,23 @@ function AltAz() {
     () => altAzData?.sample_times_mjd.map(mjdToDate) ?? [],
     [altAzData]
   );
-  const curves = altAzData?.curves ?? [];
+
+  // The response is columnar: copy each flat matrix into a typed array once
+  // and hand Plotly zero-copy per-target views.
+  const curves = useMemo(() => {
+    if (!altAzData) return [];
+    const { sample_count: n, target_count: count } = altAzData;
+    const altitudes = Float32Array.from(altAzData.altitudes_deg);
+    const azimuths = Float32Array.from(altAzData.azimuths_deg);
+    return Array.from({ length: count }, (_, t) => ({
+      original_block_id: altAzData.original_block_ids[t],
+      block_name: altAzData.block_names[t],
+      priority: altAzData.priorities[t],
+      altitudes_deg: altitudes.subarray(t * n, (t + 1) * n),
+      azimuths_deg: azimuths.subarray(t * n, (t + 1) * n),
+    }));
+  }, [altAzData]);
+  const traceType = curves.length > WEBGL_TRACE_THRESHOLD ? 'scattergl' : 'scatter';
   const computing = altAzFetching;
 
   const toggleTarget = useCallback((key: string) => {
@@ -293,7 +317,7 @@ function AltAz() {
           ? `${curve.block_name} (${curve.original_block_id})`
           : curve.original_block_id;
         return {
-          type: 'scatter' as const,
+          type: traceType,
           mode: 'lines' as const,
           name: `${label} p=${curve.priority.toFixed(1)}`,
           x: sampleTimes,
@@ -302,7 +326,7 @@ function AltAz() {
           hovertemplate: `<b>${label}</b><br>Alt: %{y:.1f}°<br>%{x|%H:%M UTC}<extra></extra>`,
         };
       }),
-    [curves, sampleTimes]
+    [curves, sampleTimes, traceType]
   );
 
   const azTraces: Plotly.Data[] = useMemo(
@@ -312,7 +336,7 @@ function AltAz() {
           ? `${curve.block_name} (${curve.original_block_id})`
           : curve.original_block_id;
         return {
-          type: 'scatter' as const,
+          type: traceType,
           mode: 'lines' as const,
           name: `${label} p=${curve.priority.toFixed(1)}`,
           x: sampleTimes,
@@ -321,7 +345,7 @@ function AltAz() {
           hovertemplate: `<b>${label}</b><br>Az: %{y:.1f}°<br>%{x|%H:%M UTC}<extra></extra>`,
         };
       }),
-    [curves, sampleTimes]
+    [curves, sampleTimes, traceType]
   );
 
   // Loading states
@@ -398,6 +422,23 @@ function AltAz() {
           <p className="mt-1.5 text-xs text-slate-500">Default range is 24 hours.</p>
         </div>
 
+        <div>
+          <label className="mb-1.5 block text-xs font-medium text-slate-400">
+            Sample Interval
+          </label>
+          <select
+            value={String(sampleIntervalMinutes)}
+            onChange={(e) => setSampleIntervalMinutes(parseInt(e.target.value, 10))}
+            className="w-full rounded-md border border-slate-600 bg-slate-700 px-3 py-2 text-sm text-white focus:border-primary-500 focus:outline-none focus:ring-1 focus:ring-primary-500"
+          >
+            {SAMPLE_INTERVAL_OPTIONS.map((minutes) => (
+              <option key={minutes} value={String(minutes)}>
+                {minutes} min
+              </option>
+            ))}
+          </select>
+        </div>
+
         {(!hasValidWindow || (altAzError && altAzRequest)) && (
           <div className="sm:col-span-2 lg:col-span-3">
             {!hasValidWindow && (
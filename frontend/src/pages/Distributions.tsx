@@ -16,6 +16,7 @@ import {
   ChartPanel,
 } from '@/components';
 import { STATUS_COLORS } from '@/constants/colors';
+import type { DistributionHistogram } from '@/api/types';
 
 interface DistributionDetail {
   label: string;
@@ -30,6 +31,36 @@ interface DistributionSectionProps {
   config: Partial<Plotly.Config>;
 }
 
+/** Overlaid scheduled/unscheduled bars for a server-side histogram. */
+function histogramTraces(histogram: DistributionHistogram | undefined): Plotly.Data[] {
+  if (!histogram) return [];
+  const bins = histogram.scheduled.length;
+  const span = histogram.max - histogram.min;
+  // A constant column is one bin; give it a unit width so it stays visible.
+  const width = span > 0 ? span / bins : 1;
+  const centres = histogram.scheduled.map((_, i) => histogram.min + (i + 0.5) * width);
+  return [
+    {
+      type: 'bar',
+      x: centres,
+      y: histogram.scheduled,
+      width,
+      name: 'Scheduled',
+      marker: { color: STATUS_COLORS.scheduled },
+      opacity: 0.7,
+    },
+    {
+      type: 'bar',
+      x: centres,
+      y: histogram.unscheduled,
+      width,
+      name: 'Unscheduled',
+      marker: { color: STATUS_COLORS.unscheduled },
+      opacity: 0.7,
+    },
+  ];
+}
+
 function DistributionSection({
   title,
   details,
@@ -117,58 +148,9 @@ function Distributions() {
     return <ErrorMessage message="No data available" />;
   }
 
-  // Priority histogram
-  const priorityHistogram: Plotly.Data[] = [
-    {
-      type: 'histogram',
-      x: data.blocks.filter((b) => b.scheduled).map((b) => b.priority),
-      name: 'Scheduled',
-      marker: { color: STATUS_COLORS.scheduled },
-      opacity: 0.7,
-    },
-    {
-      type: 'histogram',
-      x: data.blocks.filter((b) => !b.scheduled).map((b) => b.priority),
-      name: 'Unscheduled',
-      marker: { color: STATUS_COLORS.unscheduled },
-      opacity: 0.7,
-    },
-  ];
-
-  // Visibility histogram
-  const visibilityHistogram: Plotly.Data[] = [
-    {
-      type: 'histogram',
-      x: data.blocks.filter((b) => b.scheduled).map((b) => b.total_visibility_hours),
-      name: 'Scheduled',
-      marker: { color: STATUS_COLORS.scheduled },
-      opacity: 0.7,
-    },
-    {
-      type: 'histogram',
-      x: data.blocks.filter((b) => !b.scheduled).map((b) => b.total_visibility_hours),
-      name: 'Unscheduled',
-      marker: { color: STATUS_COLORS.unscheduled },
-      opacity: 0.7,
-    },
-  ];
-
-  const requestedDurationHistogram: Plotly.Data[] = [
-    {
-      type: 'histogram',
-      x: data.blocks.filter((b) => b.scheduled).map((b) => b.requested_hours),
-      name: 'Scheduled',
-      marker: { color: STATUS_COLORS.scheduled },
-      opacity: 0.7,
-    },
-    {
-      type: 'histogram',
-      x: data.blocks.filter((b) => !b.scheduled).map((b) => b.requested_hours),
-      name: 'Unscheduled',
-      marker: { color: STATUS_COLORS.unscheduled },
-      opacity: 0.7,
-    },
-  ];
+  const priorityHistogram = histogramTraces(data.histograms?.priority);
+  const visibilityHistogram = histogramTraces(data.histograms?.visibility_hours);
+  const requestedDurationHistogram = histogramTraces(data.histograms?.requested_hours);
 
   const priorityDetails: DistributionDetail[] = [
     { label: 'Mean', value: data.priority_stats.mean.toFixed(2) },
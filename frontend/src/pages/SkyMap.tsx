@@ -4,10 +4,15 @@
  * Renders an Aitoff equal-area all-sky map with the real Milky Way,
  * equatorial grid, and observation targets colored by priority bin.
  * Powered by d3-celestial (loaded globally via /celestial.js).
+ *
+ * The page first fetches the aggregated view (HEALPix density cells plus
+ * summary statistics).  Schedules up to `SKY_MAP_POINT_LIMIT` targets then
+ * load every target for filtering and hover; larger ones stay on the
+ * density view.
  */
 import { useState, useMemo, useCallback } from 'react';
 import { useParams, useNavigate } from 'react-router-dom';
-import { useSkyMap } from '@/hooks';
+import { SKY_MAP_SUMMARY_QUERY, useSkyMap } from '@/hooks';
 import {
   LoadingSpinner,
   ErrorMessage,
@@ -23,9 +28,11 @@ import {
 import type { SkyMapFilterState } from '@/components';
 import type { LightweightBlock } from '@/api/types';
 import { mjdToDate, dateToMjd, isValidDate } from '@/constants/dates';
-import { downloadCanvasAsPng } from '@/lib/imageExport';
+import { downloadCanvasLayersAsPng } from '@/lib/imageExport';
 
 const SKY_MAP_CONTAINER_ID = 'sky-map-canvas';
+/** Above this many targets the map shows density cells instead of points. */
+const SKY_MAP_POINT_LIMIT = 50_000;
 const SECONDARY_ACTION_BUTTON_CLASS =
   'rounded-md border border-slate-600 bg-slate-800/70 px-3 py-1.5 text-xs font-medium text-slate-300 transition-colors hover:bg-slate-700 focus:outline-none focus:ring-2 focus:ring-primary-500 focus:ring-offset-2 focus:ring-offset-slate-800';
 
@@ -95,7 +102,10 @@ function SkyMap() {
   const { scheduleId } = useParams();
   const navigate = useNavigate();
   const id = parseInt(scheduleId ?? '0', 10);
-  const { data, isLoading, error, refetch } = useSkyMap(id);
+  const summary = useSkyMap(id, SKY_MAP_SUMMARY_QUERY);
+  const aggregated = (summary.data?.total_count ?? 0) > SKY_MAP_POINT_LIMIT;
+  const points = useSkyMap(id, undefined, !!summary.data && !aggregated);
+  const { data, isLoading, error, refetch } = aggregated || summary.error ? summary : points;
 
   const [filters, setFilters] = useState<SkyMapFilterState | null>(null);
   const activeFilters = useMemo(() => {
@@ -145,12 +155,16 @@ function SkyMap() {
   const handleDownloadSkyMap = useCallback(() => {
     const canvas = document.querySelector<HTMLCanvasElement>(`#${SKY_MAP_CONTAINER_ID} canvas`);
     if (!canvas) return;
-    downloadCanvasAsPng(canvas, 'sky-map');
+    // Large target sets are drawn on a WebGL overlay next to the map canvas.
+    const overlay = document.getElementById(`${SKY_MAP_CONTAINER_ID}-gl`);
+    const layers =
+      overlay instanceof HTMLCanvasElement && !overlay.hidden ? [canvas, overlay] : [canvas];
+    downloadCanvasLayersAsPng(layers, 'sky-map');
   }, []);
 
   // ── Loading / error / empty states ──────────────────────────────
 
-  if (isLoading) {
+  if (isLoading || summary.isLoading) {
     return (
       <div className="flex h-full items-center justify-center">
         <LoadingSpinner size="lg" />
@@ -188,10 +202,11 @@ function SkyMap() {
     return <ErrorMessage message="No data available" />;
   }
 
-  const { all: allFiltered, scheduled } = filteredBlocks;
-  const totalFiltered = allFiltered.length;
+  // The density view is unfiltered: report the whole schedule.
+  const totalFiltered = data.density ? data.total_count : filteredBlocks.all.length;
+  const scheduledCount = data.density ? data.scheduled_count : filteredBlocks.scheduled.length;
   const schedulingRate =
-    totalFiltered > 0 ? ((scheduled.length / totalFiltered) * 100).toFixed(1) : '0';
+    totalFiltered > 0 ? ((scheduledCount / totalFiltered) * 100).toFixed(1) : '0';
 
   const scheduledTimeRange = {
     min: mjdToUtc(data.scheduled_time_min),
@@ -213,7 +228,7 @@ function SkyMap() {
         />
         <MetricCard
           label="Scheduled"
-          value={scheduled.length}
+          value={scheduledCount}
           icon={<Icon name="check-circle" />}
         />
         <MetricCard
@@ -229,14 +244,22 @@ function SkyMap() {
       </MetricsGrid>
 
       <div className="flex flex-col gap-4">
-        <SkyMapFilters
-          filters={activeFilters}
-          onChange={setFilters}
-          scheduledTimeRange={scheduledTimeRange}
-          priorityRange={{ min: data.priority_min, max: data.priority_max }}
-          bins={data.priority_bins}
-          onReset={handleReset}
-        />
+        {data.density ? (
+          <p className="rounded-md border border-slate-700 bg-slate-800/60 px-4 py-3 text-sm text-slate-300">
+            {data.total_count.toLocaleString()} targets are shown aggregated into{' '}
+            {data.density.cells.length.toLocaleString()} sky cells of ~
+            {data.density.cell_size_deg.toFixed(1)}°. Hover a cell for its counts and priorities.
+          </p>
+        ) : (
+          <SkyMapFilters
+            filters={activeFilters}
+            onChange={setFilters}
+            scheduledTimeRange={scheduledTimeRange}
+            priorityRange={{ min: data.priority_min, max: data.priority_max }}
+            bins={data.priority_bins}
+            onReset={handleReset}
+          />
+        )}
 
         <ChartPanel
           title="Celestial Coordinates (Aitoff)"
@@ -244,6 +267,7 @@ function SkyMap() {
             <div className="flex items-center gap-2">
               <button
                 type="button"
+                hidden={!!data.density}
                 onClick={() => setShowPath((prev) => !prev)}
                 className={[
                   SECONDARY_ACTION_BUTTON_CLASS,
@@ -275,6 +299,7 @@ function SkyMap() {
             showCoordinateGuide
             showPath={showPath}
             pathBlocks={pathBlocks}
+            density={data.density}
           />
         </ChartPanel>
       </div>
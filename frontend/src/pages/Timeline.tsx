@@ -9,13 +9,12 @@ import {
   ErrorMessage,
   Icon,
   MetricCard,
-  PlotlyChart,
+  TimelineGLChart,
   PageHeader,
   PageContainer,
   MetricsGrid,
   ChartPanel,
 } from '@/components';
-import { mjdToDate } from '@/constants/dates';
 
 function Timeline() {
   const { scheduleId } = useParams();
@@ -53,115 +52,6 @@ function Timeline() {
     return <ErrorMessage message="No data available" />;
   }
 
-  // Group blocks by month and create month mapping
-  const monthMap = new Map<string, number>();
-  data.unique_months.forEach((month, index) => {
-    monthMap.set(month, index);
-  });
-
-  // Height of each observation bar in data units (0.4 = 40% of row height)
-  const barHeight = 0.4;
-
-  // Create shapes for each observation block (renders reliably, no aliasing)
-  const shapes = data.blocks.map((block) => {
-    const startDate = mjdToDate(block.scheduled_start_mjd);
-    const stopDate = mjdToDate(block.scheduled_stop_mjd);
-    const monthKey = `${startDate.getFullYear()}-${String(startDate.getMonth() + 1).padStart(2, '0')}`;
-    const stopMonthKey = `${stopDate.getFullYear()}-${String(stopDate.getMonth() + 1).padStart(2, '0')}`;
-    const monthIndex = monthMap.get(monthKey) ?? 0;
-
-    // Calculate fractional day positions for start and stop
-    const startDay =
-      startDate.getDate() + startDate.getHours() / 24 + startDate.getMinutes() / 1440;
-
-    let stopDay: number;
-    if (monthKey === stopMonthKey) {
-      stopDay = stopDate.getDate() + stopDate.getHours() / 24 + stopDate.getMinutes() / 1440;
-    } else {
-      // Block crosses month boundary: clamp to end of start month
-      const daysInMonth = new Date(startDate.getFullYear(), startDate.getMonth() + 1, 0).getDate();
-      stopDay = daysInMonth + 1;
-    }
-
-    return {
-      type: 'rect' as const,
-      xref: 'x' as const,
-      yref: 'y' as const,
-      x0: startDay,
-      x1: stopDay,
-      y0: monthIndex - barHeight / 2,
-      y1: monthIndex + barHeight / 2,
-      fillcolor: `hsl(${(block.priority / 10) * 240}, 70%, 50%)`,
-      opacity: 0.7,
-      line: { width: 0 },
-      layer: 'above' as const,
-    };
-  });
-
-  // Create hover trace (invisible scatter points at block centers for tooltips)
-  const hoverData = data.blocks.map((block) => {
-    const startDate = mjdToDate(block.scheduled_start_mjd);
-    const stopDate = mjdToDate(block.scheduled_stop_mjd);
-    const monthKey = `${startDate.getFullYear()}-${String(startDate.getMonth() + 1).padStart(2, '0')}`;
-    const stopMonthKey = `${stopDate.getFullYear()}-${String(stopDate.getMonth() + 1).padStart(2, '0')}`;
-    const monthIndex = monthMap.get(monthKey) ?? 0;
-
-    const startDay =
-      startDate.getDate() + startDate.getHours() / 24 + startDate.getMinutes() / 1440;
-
-    let stopDay: number;
-    if (monthKey === stopMonthKey) {
-      stopDay = stopDate.getDate() + stopDate.getHours() / 24 + stopDate.getMinutes() / 1440;
-    } else {
-      const daysInMonth = new Date(startDate.getFullYear(), startDate.getMonth() + 1, 0).getDate();
-      stopDay = daysInMonth + 1;
-    }
-
-    const centerDay = (startDay + stopDay) / 2;
-
-    return {
-      x: centerDay,
-      y: monthIndex,
-      text: `${block.original_block_id}${block.block_name ? ` — ${block.block_name}` : ''}<br>Start: ${startDate.toISOString()}<br>Priority: ${block.priority.toFixed(1)}<br>Duration: ${block.requested_hours.toFixed(1)}h`,
-    };
-  });
-
-  const plotData: Plotly.Data[] = [
-    {
-      type: 'scatter',
-      mode: 'markers',
-      x: hoverData.map((d) => d.x),
-      y: hoverData.map((d) => d.y),
-      text: hoverData.map((d) => d.text),
-      hoverinfo: 'text',
-      marker: {
-        size: 20,
-        opacity: 0, // Invisible but still capturable for hover
-      },
-      showlegend: false,
-    },
-  ];
-
-  // Final layout with shapes
-  const timelineLayout = {
-    ...layout,
-    xaxis: {
-      ...layout.xaxis,
-      title: { text: 'Day of Month' },
-      range: [0, 32],
-      dtick: 1,
-    },
-    yaxis: {
-      ...layout.yaxis,
-      title: { text: 'Month' },
-      tickmode: 'array' as const,
-      tickvals: data.unique_months.map((_, index) => index),
-      ticktext: data.unique_months,
-      autorange: 'reversed' as const,
-    },
-    shapes,
-  };
-
   return (
     <PageContainer>
       {/* Header */}
@@ -189,11 +79,13 @@ function Timeline() {
 
       {/* Timeline chart */}
       <ChartPanel title="Schedule Timeline" headerActions={downloadButton}>
-        <PlotlyChart
-          data={plotData}
-          layout={timelineLayout}
+        <TimelineGLChart
+          blocks={data.blocks}
+          months={data.unique_months}
+          segments={data.layout}
+          layout={layout}
           config={config}
-          height="800px"
+          heightPx={800}
           onInitialized={onInitialized}
         />
       </ChartPanel>
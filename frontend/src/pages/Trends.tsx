@@ -4,7 +4,7 @@
  */
 import { useState, useRef, useCallback, useEffect } from 'react';
 import { useParams } from 'react-router-dom';
-import { useTrends, usePlotlyTheme, usePlotlyDownload } from '@/hooks';
+import { DEFAULT_TRENDS_QUERY, useTrends, usePlotlyTheme, usePlotlyDownload } from '@/hooks';
 import {
   LoadingSpinner,
   ErrorMessage,
@@ -27,7 +27,7 @@ function Trends() {
   const id = parseInt(scheduleId ?? '0', 10);
 
   // Applied query parameters (drive the API query)
-  const [appliedParams, setAppliedParams] = useState({ bins: 10, bandwidth: 0.5 });
+  const [appliedParams, setAppliedParams] = useState(DEFAULT_TRENDS_QUERY);
 
   // Local UI state (immediate feedback, debounced before apply)
   const [bins, setBins] = useState(appliedParams.bins);
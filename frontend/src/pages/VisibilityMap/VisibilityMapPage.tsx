@@ -9,14 +9,21 @@
  * - URL sync for shareable analysis states
  *
  * ARCHITECTURE:
- * - Uses shared VisibilityMapData/VisibilityBin types from api/types.ts
+ * - Uses shared VisibilityBlocksPage/VisibilityBin types from api/types.ts
  * - FilterSettings for histogram controls
- * - BlocksTable + BlockDetailsDrawer for drill-down
+ * - VirtualBlocksTable + BlockDetailsDrawer for drill-down; rows are sorted,
+ *   filtered and paged on the server, only the visible pages are loaded
  * - AnalysisContext for cross-view filter/selection state
  */
 import { useState, useCallback, useMemo, memo, useEffect, useRef } from 'react';
 import { useParams } from 'react-router-dom';
-import { useVisibilityMap, useVisibilityHistogram } from '@/hooks';
+import {
+  useVisibilityBlockPages,
+  useVisibilityHistogram,
+  type VisibilityBlockPages,
+  type VisibilityBlocksFilter,
+  type VisibilityBlocksSummary,
+} from '@/hooks';
 import {
   LoadingSpinner,
   ErrorMessage,
@@ -28,14 +35,21 @@ import {
 } from '@/components';
 import {
   OpportunitiesHistogram,
-  BlocksTable,
+  VirtualBlocksTable,
   BlockDetailsDrawer,
   ExportMenu,
   useAnalysis,
   type FilterParams,
   type TableBlock,
+  type VirtualBlocksColumn,
+  type VirtualSortDirection,
 } from '@/features/schedules';
-import type { VisibilityMapData, VisibilityBin, VisibilityHistogramQuery } from '@/api/types';
+import type {
+  VisibilityBin,
+  VisibilityBlockSort,
+  VisibilityBlockSummary,
+  VisibilityHistogramQuery,
+} from '@/api/types';
 
 // =============================================================================
 // Types
@@ -46,6 +60,37 @@ interface VisibilityBlock extends TableBlock {
   num_visibility_periods: number;
 }
 
+interface TableSort {
+  field: VisibilityBlockSort;
+  direction: VirtualSortDirection;
+}
+
+function toVisibilityBlock(b: VisibilityBlockSummary): VisibilityBlock {
+  return {
+    scheduling_block_id: b.scheduling_block_id,
+    original_block_id: b.original_block_id,
+    block_name: b.block_name,
+    priority: b.priority,
+    scheduled: b.scheduled,
+    num_visibility_periods: b.num_visibility_periods,
+    // These are not in the visibility map endpoint but could be added
+    total_visibility_hours: undefined,
+    requested_hours: undefined,
+  };
+}
+
+/** Export loads blocks through `resolveBlocks`; nothing is held up front. */
+const NO_BLOCKS: VisibilityBlock[] = [];
+
+const EXTRA_COLUMNS: VirtualBlocksColumn<VisibilityBlock, VisibilityBlockSort>[] = [
+  {
+    label: 'Windows',
+    sortField: 'num_visibility_periods',
+    className: 'tabular-nums text-slate-300',
+    render: (block) => block.num_visibility_periods,
+  },
+];
+
 // =============================================================================
 // Default Values
 // =============================================================================
@@ -59,6 +104,8 @@ const DEFAULT_FILTERS: FilterParams = {
 };
 
 const FILTER_DEBOUNCE_MS = 150;
+const SEARCH_DEBOUNCE_MS = 250;
+const DEFAULT_TABLE_SORT: TableSort = { field: 'priority', direction: 'desc' };
 const PRIORITY_SLIDER_CLASS =
   'pointer-events-none absolute inset-x-0 top-1/2 h-6 w-full -translate-y-1/2 appearance-none bg-transparent focus:outline-none [&::-moz-range-thumb]:pointer-events-auto [&::-moz-range-thumb]:h-4 [&::-moz-range-thumb]:w-4 [&::-moz-range-thumb]:cursor-pointer [&::-moz-range-thumb]:rounded-full [&::-moz-range-thumb]:border-2 [&::-moz-range-thumb]:border-slate-950 [&::-moz-range-thumb]:bg-primary-400 [&::-moz-range-track]:h-2 [&::-moz-range-track]:rounded-full [&::-moz-range-track]:border-0 [&::-moz-range-track]:bg-transparent [&::-webkit-slider-runnable-track]:h-2 [&::-webkit-slider-runnable-track]:rounded-full [&::-webkit-slider-runnable-track]:bg-transparent [&::-webkit-slider-thumb]:pointer-events-auto [&::-webkit-slider-thumb]:mt-[-4px] [&::-webkit-slider-thumb]:h-4 [&::-webkit-slider-thumb]:w-4 [&::-webkit-slider-thumb]:cursor-pointer [&::-webkit-slider-thumb]:appearance-none [&::-webkit-slider-thumb]:rounded-full [&::-webkit-slider-thumb]:border-2 [&::-webkit-slider-thumb]:border-slate-950 [&::-webkit-slider-thumb]:bg-primary-400';
 
@@ -67,21 +114,21 @@ const PRIORITY_SLIDER_CLASS =
 // =============================================================================
 
 interface SummaryMetricsProps {
-  mapData: VisibilityMapData;
+  summary: VisibilityBlocksSummary;
   filteredCount: number;
   selectionCount: number;
 }
 
 const SummaryMetrics = memo(function SummaryMetrics({
-  mapData,
+  summary,
   filteredCount,
   selectionCount,
 }: SummaryMetricsProps) {
   const schedulingRate =
-    mapData.total_count > 0
-      ? ((mapData.scheduled_count / mapData.total_count) * 100).toFixed(1)
+    summary.total_count > 0
+      ? ((summary.scheduled_count / summary.total_count) * 100).toFixed(1)
       : '0';
-  const filteredOutCount = Math.max(mapData.total_count - filteredCount, 0);
+  const filteredOutCount = Math.max(summary.total_count - filteredCount, 0);
 
   return (
     <>
@@ -92,17 +139,17 @@ const SummaryMetrics = memo(function SummaryMetrics({
       <MetricsGrid>
         <MetricCard
           label="Total Blocks"
-          value={mapData.total_count}
+          value={summary.total_count}
           icon={<Icon name="chart-bar" />}
         />
         <MetricCard
           label="Scheduled"
-          value={`${mapData.scheduled_count} (${schedulingRate}%)`}
+          value={`${summary.scheduled_count} (${schedulingRate}%)`}
           icon={<Icon name="check-circle" />}
         />
         <MetricCard
           label="Priority Range"
-          value={`${mapData.priority_min.toFixed(1)} – ${mapData.priority_max.toFixed(1)}`}
+          value={`${summary.priority_min.toFixed(1)} – ${summary.priority_max.toFixed(1)}`}
           icon={<Icon name="star" />}
         />
         <MetricCard label="Filtered" value={filteredOutCount} icon={<Icon name="search" />} />
@@ -119,7 +166,12 @@ const SummaryMetrics = memo(function SummaryMetrics({
 // =============================================================================
 
 interface VisibilityMapContentProps {
-  mapData: VisibilityMapData;
+  summary: VisibilityBlocksSummary;
+  pages: VisibilityBlockPages;
+  tableSort: TableSort;
+  onTableSortChange: (field: VisibilityBlockSort) => void;
+  search: string;
+  onSearchChange: (search: string) => void;
   histogramData: VisibilityBin[] | undefined;
   histogramLoading: boolean;
   filters: FilterParams;
@@ -127,7 +179,12 @@ interface VisibilityMapContentProps {
 }
 
 const VisibilityMapContent = memo(function VisibilityMapContent({
-  mapData,
+  summary,
+  pages,
+  tableSort,
+  onTableSortChange,
+  search,
+  onSearchChange,
   histogramData,
   histogramLoading,
   filters,
@@ -145,42 +202,18 @@ const VisibilityMapContent = memo(function VisibilityMapContent({
     });
   }, [filters.priorityMin, filters.priorityMax, setPriorityFilter]);
 
-  // Convert API blocks to table format with filtering
-  const blocks = useMemo((): VisibilityBlock[] => {
-    return mapData.blocks.map((b) => ({
-      scheduling_block_id: b.scheduling_block_id,
-      original_block_id: b.original_block_id,
-      block_name: b.block_name,
-      priority: b.priority,
-      scheduled: b.scheduled,
-      num_visibility_periods: b.num_visibility_periods,
-      // These are not in the visibility map endpoint but could be added
-      total_visibility_hours: undefined,
-      requested_hours: undefined,
-    }));
-  }, [mapData.blocks]);
-
-  // Filter blocks based on analysis context
-  const filteredBlocks = useMemo(() => {
-    let result = blocks;
-
-    // Priority filter from context
-    if (state.priorityFilter.min !== undefined) {
-      result = result.filter((b) => b.priority >= state.priorityFilter.min!);
-    }
-    if (state.priorityFilter.max !== undefined) {
-      result = result.filter((b) => b.priority <= state.priorityFilter.max!);
-    }
-
-    // Scheduled filter from context
-    if (state.scheduledFilter === 'scheduled') {
-      result = result.filter((b) => b.scheduled);
-    } else if (state.scheduledFilter === 'unscheduled') {
-      result = result.filter((b) => !b.scheduled);
-    }
-
-    return result;
-  }, [blocks, state.priorityFilter, state.scheduledFilter]);
+  const { rowAt: summaryAt, loadAll } = pages;
+  const rowAt = useCallback(
+    (index: number) => {
+      const row = summaryAt(index);
+      return row && toVisibilityBlock(row);
+    },
+    [summaryAt]
+  );
+  const resolveBlocks = useCallback(
+    async () => (await loadAll()).map(toVisibilityBlock),
+    [loadAll]
+  );
 
   // Handle block click for details drawer
   const handleBlockClick = useCallback(
@@ -207,15 +240,15 @@ const VisibilityMapContent = memo(function VisibilityMapContent({
     <PageContainer>
       {/* Summary metrics */}
       <SummaryMetrics
-        mapData={mapData}
-        filteredCount={filteredBlocks.length}
+        summary={summary}
+        filteredCount={summary.matched_count}
         selectionCount={selectionCount}
       />
 
       <div className="flex flex-col gap-4">
         <VisibilityFiltersBar
           filters={filters}
-          priorityRange={{ min: mapData.priority_min, max: mapData.priority_max }}
+          priorityRange={{ min: summary.priority_min, max: summary.priority_max }}
           scheduledFilter={state.scheduledFilter}
           onFiltersChange={onFiltersChange}
           onScheduledFilterChange={setScheduledFilter}
@@ -232,8 +265,10 @@ const VisibilityMapContent = memo(function VisibilityMapContent({
         <div className="mb-3 flex items-center justify-between">
           <h2 className="text-lg font-semibold text-white">Observation Blocks</h2>
           <ExportMenu
-            blocks={filteredBlocks}
-            totalBlocks={mapData.total_count}
+            blocks={NO_BLOCKS}
+            resolveBlocks={resolveBlocks}
+            filteredCount={summary.matched_count}
+            totalBlocks={summary.total_count}
             columns={[
               'scheduling_block_id',
               'original_block_id',
@@ -244,11 +279,21 @@ const VisibilityMapContent = memo(function VisibilityMapContent({
             ]}
           />
         </div>
-        <BlocksTable
-          blocks={filteredBlocks}
-          title=""
-          maxRows={200}
+        <VirtualBlocksTable
+          rowCount={summary.matched_count}
+          totalCount={summary.total_count}
+          rowAt={rowAt}
+          onRangeChange={pages.setRange}
+          sort={tableSort}
+          onSortChange={onTableSortChange}
+          prioritySortField="priority"
+          statusSortField="scheduled"
+          extraColumns={EXTRA_COLUMNS}
+          filter={search}
+          onFilterChange={onSearchChange}
           onBlockClick={handleBlockClick}
+          isFetching={pages.isFetching}
+          title=""
           showSelection
         />
       </div>
@@ -522,11 +567,49 @@ function VisibilityMapPage() {
   // Applied filter state for histogram (separate from AnalysisContext filters)
   const [appliedFilters, setAppliedFilters] = useState<FilterParams>(DEFAULT_FILTERS);
 
+  // Block table sort and text search; both are applied on the server.
+  const [tableSort, setTableSort] = useState<TableSort>(DEFAULT_TABLE_SORT);
+  const [search, setSearch] = useState('');
+  const [appliedSearch, setAppliedSearch] = useState('');
+
+  useEffect(() => {
+    const handle = setTimeout(() => setAppliedSearch(search.trim()), SEARCH_DEBOUNCE_MS);
+    return () => clearTimeout(handle);
+  }, [search]);
+
   // Get analysis context for priority filter (shared with histogram)
   const { state: analysisState } = useAnalysis();
 
-  // Fetch visibility map data (includes blocks list)
-  const { data: mapData, isLoading: mapLoading, error: mapError } = useVisibilityMap(currentId);
+  const blocksFilter = useMemo<VisibilityBlocksFilter>(() => {
+    const filter: VisibilityBlocksFilter = {
+      sort: tableSort.field,
+      direction: tableSort.direction,
+    };
+    if (analysisState.priorityFilter.min !== undefined) {
+      filter.priority_min = analysisState.priorityFilter.min;
+    }
+    if (analysisState.priorityFilter.max !== undefined) {
+      filter.priority_max = analysisState.priorityFilter.max;
+    }
+    if (analysisState.scheduledFilter !== 'all') {
+      filter.scheduled = analysisState.scheduledFilter === 'scheduled';
+    }
+    if (appliedSearch) {
+      filter.search = appliedSearch;
+    }
+    return filter;
+  }, [tableSort, analysisState.priorityFilter, analysisState.scheduledFilter, appliedSearch]);
+
+  // Only the pages under the table viewport are fetched
+  const pages = useVisibilityBlockPages(currentId, blocksFilter);
+
+  const handleTableSortChange = useCallback((field: VisibilityBlockSort) => {
+    setTableSort((current) =>
+      current.field === field
+        ? { field, direction: current.direction === 'asc' ? 'desc' : 'asc' }
+        : { field, direction: 'desc' }
+    );
+  }, []);
 
   // Build histogram query from applied filters + analysis context
   const histogramQuery = useMemo<VisibilityHistogramQuery>(() => {
@@ -582,7 +665,7 @@ function VisibilityMapPage() {
   }, []);
 
   // Initial loading state
-  if (mapLoading && !mapData) {
+  if (pages.isLoading && !pages.summary) {
     return (
       <PageContainer>
         <div className="flex h-96 items-center justify-center">
@@ -592,13 +675,13 @@ function VisibilityMapPage() {
     );
   }
 
-  // Only block rendering on map-level errors (histogram errors are shown inline)
-  if (mapError) {
+  // Only block rendering on block-table errors (histogram errors are shown inline)
+  if (pages.error && !pages.summary) {
     return (
       <PageContainer>
         <ErrorMessage
           title="Failed to load visibility map"
-          message={(mapError as Error).message}
+          message={pages.error.message}
           onRetry={() => refetch()}
         />
       </PageContainer>
@@ -606,7 +689,7 @@ function VisibilityMapPage() {
   }
 
   // No data state
-  if (!mapData) {
+  if (!pages.summary) {
     return (
       <PageContainer>
         <ErrorMessage message="No data available" />
@@ -616,7 +699,12 @@ function VisibilityMapPage() {
 
   return (
     <VisibilityMapContent
-      mapData={mapData}
+      summary={pages.summary}
+      pages={pages}
+      tableSort={tableSort}
+      onTableSortChange={handleTableSortChange}
+      search={search}
+      onSearchChange={setSearch}
       histogramData={histogramData}
       histogramLoading={histogramLoading}
       filters={appliedFilters}
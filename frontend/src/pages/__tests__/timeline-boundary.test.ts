@@ -1,76 +1,117 @@
 /**
- * Tests for Timeline month-boundary clamping logic.
+ * Tests for the Timeline bar packing (`workers/timelineLayout.ts`).
  *
- * Verifies that blocks crossing a month boundary produce valid
- * x0 ≤ x1 coordinates and that overlapping blocks are semi-transparent.
+ * Month-boundary splitting happens on the backend; these tests verify that
+ * the server-provided segments (including continuation segments) are packed
+ * into per-colour polylines and that the hover index resolves the bar
+ * under the cursor.
  */
 import { describe, it, expect } from 'vitest';
-import { mjdToDate, dateToMjd } from '@/constants/dates';
+import type { TimelineLayoutColumns } from '@/api/types';
+import {
+  buildTimelineLayout,
+  hitTestTimeline,
+  timelineLayoutInput,
+  TIMELINE_COLOR_BINS,
+} from '@/workers/timelineLayout';
 
-// ─── Reimplemented shape builder (mirrors Timeline.tsx) ─────────────
+type Segment = [blockIndex: number, row: number, x0: number, x1: number, color?: number];
 
-function computeShape(startMjd: number, stopMjd: number, monthMap: Map<string, number>) {
-  const barHeight = 0.4;
-  const startDate = mjdToDate(startMjd);
-  const stopDate = mjdToDate(stopMjd);
-  const monthKey = `${startDate.getFullYear()}-${String(startDate.getMonth() + 1).padStart(2, '0')}`;
-  const stopMonthKey = `${stopDate.getFullYear()}-${String(stopDate.getMonth() + 1).padStart(2, '0')}`;
-  const monthIndex = monthMap.get(monthKey) ?? 0;
-
-  const startDay = startDate.getDate() + startDate.getHours() / 24 + startDate.getMinutes() / 1440;
-
-  let stopDay: number;
-  if (monthKey === stopMonthKey) {
-    stopDay = stopDate.getDate() + stopDate.getHours() / 24 + stopDate.getMinutes() / 1440;
-  } else {
-    const daysInMonth = new Date(startDate.getFullYear(), startDate.getMonth() + 1, 0).getDate();
-    stopDay = daysInMonth + 1;
-  }
-
-  return { x0: startDay, x1: stopDay, monthIndex, barHeight };
+function layoutFor(segments: Segment[], rows: number) {
+  const columns: TimelineLayoutColumns = {
+    block_index: segments.map(([block]) => block),
+    row: segments.map(([, row]) => row),
+    x0: segments.map(([, , x0]) => x0),
+    x1: segments.map(([, , , x1]) => x1),
+    color_index: segments.map(([, , , , color]) => color ?? 8),
+    continuation: segments.map(() => false),
+  };
+  return buildTimelineLayout(timelineLayoutInput(columns, rows));
 }
 
 // ─── Tests ──────────────────────────────────────────────────────────
 
-describe('Timeline month-boundary handling', () => {
-  const monthMap = new Map([
-    ['2024-01', 0],
-    ['2024-02', 1],
-    ['2024-03', 2],
-  ]);
-
-  it('block within same month produces x1 > x0', () => {
-    // 2024-01-10 to 2024-01-12
-    const startMjd = dateToMjd(new Date(Date.UTC(2024, 0, 10)));
-    const stopMjd = dateToMjd(new Date(Date.UTC(2024, 0, 12)));
+describe('Timeline polylines', () => {
+  it('groups segments by priority colour bin with NaN gaps', () => {
+    const layout = layoutFor(
+      [
+        [0, 0, 1, 2, TIMELINE_COLOR_BINS - 1],
+        [1, 0, 3, 4, 0],
+        [2, 0, 5, 6, TIMELINE_COLOR_BINS - 1],
+      ],
+      1
+    );
+    expect(layout.binOffsets[TIMELINE_COLOR_BINS]).toBe(3);
+    expect(layout.binOffsets[1]).toBe(1);
+    // Bin 0 comes first in the polyline buffer.
+    expect(layout.lineX[0]).toBe(3);
+    expect(layout.lineX[1]).toBe(4);
+    expect(Number.isNaN(layout.lineX[2])).toBe(true);
+    expect(Number.isNaN(layout.lineY[2])).toBe(true);
+  });
 
-    const shape = computeShape(startMjd, stopMjd, monthMap);
-    expect(shape.x1).toBeGreaterThan(shape.x0);
+  it('clamps out-of-range colour bins', () => {
+    const layout = layoutFor([[0, 0, 1, 2, 200]], 1);
+    expect(layout.colorIndex[0]).toBe(TIMELINE_COLOR_BINS - 1);
   });
+});
+
+describe('Timeline hover index', () => {
+  // Block 0 runs Jan 30 → Feb 2 and arrives as a segment plus a
+  // continuation segment on the February row.
+  const layout = layoutFor(
+    [
+      [0, 0, 30, 32],
+      [0, 1, 1, 3],
+      [1, 0, 2, 10],
+      [2, 0, 5, 6],
+      [3, 1, 20, 21],
+    ],
+    2
+  );
 
-  it('block crossing month boundary is clamped so x1 > x0', () => {
-    // 2024-01-30 to 2024-02-02 — previously would produce x1 < x0
-    const startMjd = dateToMjd(new Date(Date.UTC(2024, 0, 30)));
-    const stopMjd = dateToMjd(new Date(Date.UTC(2024, 1, 2)));
+  it('finds the bar under the cursor, preferring the later start', () => {
+    expect(hitTestTimeline(layout, 3, 0)).toBe(2);
+    expect(hitTestTimeline(layout, 5.5, 0)).toBe(3);
+    expect(hitTestTimeline(layout, 8, 0.1)).toBe(2);
+    expect(hitTestTimeline(layout, 20.5, 1)).toBe(4);
+  });
 
-    const shape = computeShape(startMjd, stopMjd, monthMap);
-    expect(shape.x1).toBeGreaterThan(shape.x0);
-    // Should clamp to end of January (31 days → stopDay = 32)
-    expect(shape.x1).toBe(32);
+  it('maps continuation segments back to their block', () => {
+    expect(layout.blockIndex[hitTestTimeline(layout, 31, 0)]).toBe(0);
+    expect(layout.blockIndex[hitTestTimeline(layout, 2, 1)]).toBe(0);
   });
 
-  it('block crossing year boundary is clamped correctly', () => {
-    // December → January of next year
-    const decMap = new Map([
-      ['2024-12', 0],
-      ['2025-01', 1],
-    ]);
-    const startMjd = dateToMjd(new Date(Date.UTC(2024, 11, 30)));
-    const stopMjd = dateToMjd(new Date(Date.UTC(2025, 0, 3)));
+  it('misses outside bars and between rows', () => {
+    expect(hitTestTimeline(layout, 15, 0)).toBe(-1);
+    expect(hitTestTimeline(layout, 3, 0.5)).toBe(-1);
+    expect(hitTestTimeline(layout, 3, 5)).toBe(-1);
+  });
 
-    const shape = computeShape(startMjd, stopMjd, decMap);
-    expect(shape.x1).toBeGreaterThan(shape.x0);
-    // December has 31 days → stopDay = 32
-    expect(shape.x1).toBe(32);
+  it('matches a linear scan on random data', () => {
+    const segments: Segment[] = [];
+    let seed = 7;
+    const rand = () => (seed = (seed * 1103515245 + 12345) % 2 ** 31) / 2 ** 31;
+    for (let i = 0; i < 500; i++) {
+      const x0 = 1 + rand() * 30;
+      segments.push([i, Math.floor(rand() * 3), x0, x0 + rand() * 2]);
+    }
+    const random = layoutFor(segments, 3);
+    for (let q = 0; q < 500; q++) {
+      const x = 1 + rand() * 31;
+      const y = Math.floor(rand() * 3);
+      const hit = hitTestTimeline(random, x, y);
+      const covering: number[] = [];
+      for (let i = 0; i < random.count; i++) {
+        if (random.row[i] === y && random.x0[i] <= x && random.x1[i] >= x) covering.push(i);
+      }
+      if (covering.length === 0) {
+        expect(hit).toBe(-1);
+      } else {
+        expect(covering).toContain(hit);
+        const latest = Math.max(...covering.map((i) => random.x0[i]));
+        expect(random.x0[hit]).toBe(latest);
+      }
+    }
   });
 });
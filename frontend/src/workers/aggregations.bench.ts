@@ -0,0 +1,65 @@
+/**
+ * Micro-benchmarks for the aggregation primitives.
+ *
+ * Run with `npm run bench`.
+ */
+import { bench, describe } from 'vitest';
+import {
+  computeParetoFront,
+  computeParetoFrontNaive,
+  sortFilterBlocks,
+  type ObjectiveDirection,
+  type SortFilterBlock,
+} from './aggregations';
+import {
+  blockColumnsFromBlocks,
+  createBlockQueryIndex,
+  sortFilterBlockColumns,
+} from './blockColumns';
+
+function randomPoints(n: number, k: number, seed: number): number[][] {
+  let state = seed;
+  const rand = () => (state = (state * 1103515245 + 12345) % 2 ** 31) / 2 ** 31;
+  return Array.from({ length: n }, () => Array.from({ length: k }, rand));
+}
+
+const CASES: { n: number; directions: ObjectiveDirection[] }[] = [
+  { n: 5_000, directions: ['min', 'max'] },
+  { n: 5_000, directions: ['min', 'max', 'min'] },
+];
+
+for (const { n, directions } of CASES) {
+  const values = randomPoints(n, directions.length, 7);
+  describe(`computeParetoFront n=${n} k=${directions.length}`, () => {
+    bench('sort / skyline', () => {
+      computeParetoFront(values, directions);
+    });
+    bench('pairwise', () => {
+      computeParetoFrontNaive(values, directions);
+    });
+  });
+}
+
+describe('block filter + sort, 100k blocks', () => {
+  let state = 3;
+  const rand = () => (state = (state * 1103515245 + 12345) % 2 ** 31) / 2 ** 31;
+  const blocks: SortFilterBlock[] = Array.from({ length: 100_000 }, (_, i) => ({
+    scheduling_block_id: i + 1,
+    original_block_id: `OB-${Math.floor(rand() * 1e6)}`,
+    block_name: `Target ${Math.floor(rand() * 5000)}`,
+    priority: rand() * 10,
+    scheduled: rand() < 0.4,
+  }));
+  const columns = blockColumnsFromBlocks(blocks);
+  const index = createBlockQueryIndex();
+  const sort = { field: 'priority', direction: 'desc' } as const;
+  // Warm the trigram index and cached permutation, as a resident dataset would be.
+  sortFilterBlockColumns(columns, 'warm', sort, index);
+
+  bench('indexed (resident dataset)', () => {
+    sortFilterBlockColumns(columns, 'target 12', sort, index);
+  });
+  bench('row scan + sort', () => {
+    sortFilterBlocks(blocks, 'target 12', sort);
+  });
+});
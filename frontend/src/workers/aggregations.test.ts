@@ -0,0 +1,62 @@
+import { describe, it, expect } from 'vitest';
+import {
+  computeParetoFront,
+  computeParetoFrontNaive,
+  type ObjectiveDirection,
+} from './aggregations';
+
+/** Deterministic LCG so failures are reproducible. */
+function lcg(seed: number) {
+  let state = seed;
+  return () => (state = (state * 1103515245 + 12345) % 2 ** 31) / 2 ** 31;
+}
+
+describe('computeParetoFront', () => {
+  it('flags dominated points for mixed directions', () => {
+    const values = [
+      [1, 10], // front: lowest cost
+      [2, 12], // front: better score
+      [3, 11], // dominated by [2, 12]
+      [2, 12], // duplicate: equal points do not dominate each other
+    ];
+    expect(computeParetoFront(values, ['min', 'max'])).toEqual([false, false, true, false]);
+  });
+
+  it('handles a single objective and degenerate inputs', () => {
+    expect(computeParetoFront([[3], [1], [1], [2]], ['min'])).toEqual([true, false, false, true]);
+    expect(computeParetoFront([], ['min', 'max'])).toEqual([]);
+    expect(computeParetoFront([[1, 2]], ['min', 'max'])).toEqual([false]);
+    expect(computeParetoFront([[1], [2]], [])).toEqual([false, false]);
+  });
+
+  it('uses the skyline path for three or more objectives', () => {
+    const values = [
+      [1, 1, 1],
+      [1, 1, 2],
+      [0, 5, 5],
+      [2, 0, 9],
+    ];
+    expect(computeParetoFront(values, ['min', 'min', 'min'])).toEqual([false, true, false, false]);
+  });
+
+  it('matches the pairwise reference on random data with ties', () => {
+    const rand = lcg(42);
+    const specials = [Infinity, -Infinity, NaN];
+    for (let trial = 0; trial < 300; trial++) {
+      const n = Math.floor(rand() * 80);
+      const k = 1 + Math.floor(rand() * 4);
+      const directions: ObjectiveDirection[] = Array.from({ length: k }, () =>
+        rand() < 0.5 ? 'min' : 'max'
+      );
+      // Small integer range forces plenty of ties and duplicates.
+      const values = Array.from({ length: n }, () =>
+        Array.from({ length: k }, () =>
+          rand() < 0.05 ? specials[Math.floor(rand() * specials.length)] : Math.floor(rand() * 6)
+        )
+      );
+      expect(computeParetoFront(values, directions)).toEqual(
+        computeParetoFrontNaive(values, directions)
+      );
+    }
+  });
+});
@@ -13,81 +13,7 @@
  */
 
 // ---------------------------------------------------------------------------
-// computeBlockStatusMap — used by ScheduleComparisonTables.BlockStatusTable
-// ---------------------------------------------------------------------------
-
-export interface BlockStatusInputBlock {
-  original_block_id: string;
-  priority: number;
-  requested_hours: number;
-  scheduled: boolean;
-  scheduled_start_mjd: number | null | undefined;
-}
-
-export interface BlockStatusInputSchedule {
-  id: number;
-  blocks: BlockStatusInputBlock[];
-}
-
-export interface BlockStatusEntry {
-  original_block_id: string;
-  maxPriority: number;
-  maxRequestedHours: number;
-  perSchedule: Record<
-    number,
-    {
-      scheduled: boolean;
-      start_mjd: number | null | undefined;
-      requested_hours: number;
-    }
-  >;
-}
-
-/**
- * Build the per-(block × schedule) map for the visible page slice.
- *
- * @param schedules  list of schedules to aggregate over
- * @param pageBlockIds  the original_block_ids that should appear in the result
- */
-export function computeBlockStatusMap(
-  schedules: BlockStatusInputSchedule[],
-  pageBlockIds: string[]
-): Map<string, BlockStatusEntry> {
-  const ids = new Set(pageBlockIds);
-  const map = new Map<string, BlockStatusEntry>();
-  if (ids.size === 0) return map;
-
-  for (const schedule of schedules) {
-    for (const block of schedule.blocks) {
-      const key = block.original_block_id;
-      if (!ids.has(key)) continue;
-
-      let entry = map.get(key);
-      if (!entry) {
-        entry = {
-          original_block_id: key,
-          maxPriority: block.priority,
-          maxRequestedHours: block.requested_hours,
-          perSchedule: {},
-        };
-        map.set(key, entry);
-      }
-
-      entry.maxPriority = Math.max(entry.maxPriority, block.priority);
-      entry.maxRequestedHours = Math.max(entry.maxRequestedHours, block.requested_hours);
-      entry.perSchedule[schedule.id] = {
-        scheduled: block.scheduled,
-        start_mjd: block.scheduled_start_mjd,
-        requested_hours: block.requested_hours,
-      };
-    }
-  }
-
-  return map;
-}
-
-// ---------------------------------------------------------------------------
-// sortFilterBlocks — used by BlocksTable
+// sortFilterBlocks — row-based reference for `blockColumns.sortFilterBlockColumns`
 // ---------------------------------------------------------------------------
 
 export interface SortFilterBlock {
@@ -267,11 +193,137 @@ export type ObjectiveDirection = 'min' | 'max';
  * i-th input row.
  *
  * A point `a` dominates `b` when it is no worse on every objective and
- * strictly better on at least one.
+ * strictly better on at least one.  Identical points never dominate each
+ * other, so duplicates on the front are all kept.
+ *
+ * Runs in O(n log n) for one or two objectives (sort + sweep) and uses
+ * sort-filter-skyline for three or more: points are visited in
+ * lexicographic order — a linear extension of dominance — and only
+ * compared against the skyline found so far.  Inputs containing `NaN`
+ * fall back to {@link computeParetoFrontNaive}, whose pairwise comparisons
+ * define the semantics for unordered values.
  */
 export function computeParetoFront(
   values: readonly (readonly number[])[],
   directions: readonly ObjectiveDirection[]
+): boolean[] {
+  const n = values.length;
+  const k = directions.length;
+  if (k === 0 || n < 2) return new Array<boolean>(n).fill(false);
+
+  // Column-major copy with every objective turned into a minimisation.
+  const cols: Float64Array[] = [];
+  for (let d = 0; d < k; d += 1) {
+    const col = new Float64Array(n);
+    const sign = directions[d] === 'max' ? -1 : 1;
+    for (let i = 0; i < n; i += 1) {
+      const v = values[i][d];
+      if (Number.isNaN(v)) return computeParetoFrontNaive(values, directions);
+      col[i] = sign * v;
+    }
+    cols.push(col);
+  }
+
+  if (k === 1) return paretoFront1D(cols[0]);
+  if (k === 2) return paretoFront2D(cols[0], cols[1]);
+  return paretoFrontSkyline(cols);
+}
+
+function paretoFront1D(x: Float64Array): boolean[] {
+  let best = Infinity;
+  for (let i = 0; i < x.length; i += 1) if (x[i] < best) best = x[i];
+  return Array.from(x, (v) => v > best);
+}
+
+/**
+ * Sweep by ascending `x`.  A point is dominated by an earlier `x` group
+ * when that group's best `y` is no worse, or by its own group when some
+ * point there has a strictly smaller `y`.
+ */
+function paretoFront2D(x: Float64Array, y: Float64Array): boolean[] {
+  const n = x.length;
+  const order = new Uint32Array(n);
+  for (let i = 0; i < n; i += 1) order[i] = i;
+  order.sort((a, b) => compareLexicographic([x, y], a, b));
+
+  const dominated = new Array<boolean>(n).fill(false);
+  let bestBefore = Infinity;
+  let hasBefore = false;
+  let lo = 0;
+  while (lo < n) {
+    const gx = x[order[lo]];
+    let hi = lo + 1;
+    while (hi < n && x[order[hi]] === gx) hi += 1;
+    // Sorted by y within the group, so the first entry holds its minimum.
+    const groupBest = y[order[lo]];
+    for (let p = lo; p < hi; p += 1) {
+      const yi = y[order[p]];
+      dominated[order[p]] = (hasBefore && bestBefore <= yi) || groupBest < yi;
+    }
+    if (!hasBefore || groupBest < bestBefore) bestBefore = groupBest;
+    hasBefore = true;
+    lo = hi;
+  }
+  return dominated;
+}
+
+function compareLexicographic(cols: readonly Float64Array[], a: number, b: number): number {
+  for (let d = 0; d < cols.length; d += 1) {
+    const av = cols[d][a];
+    const bv = cols[d][b];
+    // Explicit comparisons: `Infinity - Infinity` would be NaN.
+    if (av < bv) return -1;
+    if (av > bv) return 1;
+  }
+  return 0;
+}
+
+function dominatesMin(cols: readonly Float64Array[], a: number, b: number): boolean {
+  let strictlyBetter = false;
+  for (let d = 0; d < cols.length; d += 1) {
+    const av = cols[d][a];
+    const bv = cols[d][b];
+    if (av > bv) return false;
+    if (av < bv) strictlyBetter = true;
+  }
+  return strictlyBetter;
+}
+
+/**
+ * Sort-filter-skyline.  Anything that dominates a point sorts before it, and
+ * by transitivity a dominated point is always dominated by some skyline
+ * point, so the window never needs evicting.
+ */
+function paretoFrontSkyline(cols: readonly Float64Array[]): boolean[] {
+  const n = cols[0].length;
+  const order = new Uint32Array(n);
+  for (let i = 0; i < n; i += 1) order[i] = i;
+  order.sort((a, b) => compareLexicographic(cols, a, b));
+
+  const dominated = new Array<boolean>(n).fill(false);
+  const skyline: number[] = [];
+  for (let p = 0; p < n; p += 1) {
+    const i = order[p];
+    let isDominated = false;
+    for (let s = 0; s < skyline.length; s += 1) {
+      if (dominatesMin(cols, skyline[s], i)) {
+        isDominated = true;
+        break;
+      }
+    }
+    if (isDominated) dominated[i] = true;
+    else skyline.push(i);
+  }
+  return dominated;
+}
+
+/**
+ * Reference O(n²·k) pairwise implementation of {@link computeParetoFront}.
+ * Kept for inputs with `NaN` and as the oracle in tests and benchmarks.
+ */
+export function computeParetoFrontNaive(
+  values: readonly (readonly number[])[],
+  directions: readonly ObjectiveDirection[]
 ): boolean[] {
   const n = values.length;
   const k = directions.length;
@@ -2,22 +2,92 @@
  * Web Worker entry point that exposes the pure aggregation helpers from
  * `./aggregations.ts` over a Comlink RPC channel.
  *
+ * Large tables use the resident-dataset protocol: columns are loaded once
+ * (`loadBlockDataset` / `loadComparisonDataset`, buffers transferred), kept
+ * here under a numeric handle, and queried with small messages that return
+ * a transferred permutation index.
+ *
  * The components consume this through `aggregationsClient.ts`; this file
  * itself never touches the DOM.
  */
-import { expose } from 'comlink';
+import { expose, transfer } from 'comlink';
+import { binHeatmap, computeParetoFront, type SortFilterSpec } from './aggregations';
 import {
-  binHeatmap,
-  computeBlockStatusMap,
-  computeParetoFront,
-  sortFilterBlocks,
-} from './aggregations';
+  createBlockQueryIndex,
+  rankStrings,
+  sortComparisonColumns,
+  sortFilterBlockColumns,
+  type BlockColumns,
+  type BlockQueryIndex,
+  type ComparisonColumns,
+  type ComparisonQuery,
+} from './blockColumns';
+import {
+  buildTimelineLayout,
+  timelineLayoutTransferables,
+  type TimelineLayout,
+  type TimelineLayoutInput,
+} from './timelineLayout';
+
+type ResidentDataset =
+  | { kind: 'blocks'; columns: BlockColumns; index: BlockQueryIndex }
+  | { kind: 'comparison'; columns: ComparisonColumns; idRanks?: Uint32Array };
+
+const datasets = new Map<number, ResidentDataset>();
+let nextHandle = 1;
+
+function residentDataset<K extends ResidentDataset['kind']>(
+  handle: number,
+  kind: K
+): Extract<ResidentDataset, { kind: K }> {
+  const dataset = datasets.get(handle);
+  if (!dataset || dataset.kind !== kind) {
+    throw new Error(`Unknown ${kind} dataset handle ${handle}`);
+  }
+  return dataset as Extract<ResidentDataset, { kind: K }>;
+}
+
+function register(dataset: ResidentDataset): number {
+  const handle = nextHandle++;
+  datasets.set(handle, dataset);
+  return handle;
+}
+
+function transferOrder(order: Uint32Array): Uint32Array {
+  return transfer(order, [order.buffer as ArrayBuffer]);
+}
 
 export const aggregationsApi = {
-  computeBlockStatusMap,
-  sortFilterBlocks,
   binHeatmap,
   computeParetoFront,
+  /** Typed-array timeline layout; buffers are transferred, not copied. */
+  buildTimelineLayout(input: TimelineLayoutInput): TimelineLayout {
+    const layout = buildTimelineLayout(input);
+    return transfer(layout, timelineLayoutTransferables(layout));
+  },
+
+  loadBlockDataset(columns: BlockColumns): number {
+    return register({ kind: 'blocks', columns, index: createBlockQueryIndex() });
+  },
+  /** Row permutation of a resident block dataset (see `sortFilterBlockColumns`). */
+  sortFilterBlockDataset(handle: number, filter: string, sort: SortFilterSpec): Uint32Array {
+    const { columns, index } = residentDataset(handle, 'blocks');
+    return transferOrder(sortFilterBlockColumns(columns, filter, sort, index));
+  },
+
+  loadComparisonDataset(columns: ComparisonColumns): number {
+    return register({ kind: 'comparison', columns });
+  },
+  /** Row permutation of a resident comparison dataset (see `sortComparisonColumns`). */
+  sortComparisonDataset(handle: number, query: ComparisonQuery): Uint32Array {
+    const dataset = residentDataset(handle, 'comparison');
+    dataset.idRanks ??= rankStrings(dataset.columns.blockId);
+    return transferOrder(sortComparisonColumns(dataset.columns, query, dataset.idRanks));
+  },
+
+  releaseDataset(handle: number): void {
+    datasets.delete(handle);
+  },
 };
 
 export type AggregationsApi = typeof aggregationsApi;
@@ -0,0 +1,139 @@
+import { describe, it, expect } from 'vitest';
+import {
+  createAggregationsPool,
+  isAbortError,
+  type AggregationsClient,
+} from './aggregationsClient';
+
+/** A promise whose settlement the test controls. */
+function deferred<T>() {
+  let resolve!: (value: T) => void;
+  const promise = new Promise<T>((res) => (resolve = res));
+  return { promise, resolve };
+}
+
+function fakePool(size: number, { terminable = false } = {}) {
+  const clients: AggregationsClient[] = [];
+  const terminated: AggregationsClient[] = [];
+  const pool = createAggregationsPool(() => {
+    const client = { id: clients.length } as unknown as AggregationsClient;
+    clients.push(client);
+    return terminable ? { client, terminate: () => terminated.push(client) } : { client };
+  }, size);
+  const slotOf = (client: AggregationsClient) => clients.indexOf(client);
+  return { pool, slotOf, clients, terminated };
+}
+
+describe('createAggregationsPool', () => {
+  it('runs one request per worker and queues the rest', async () => {
+    const { pool } = fakePool(1);
+    const first = deferred<string>();
+    const started: string[] = [];
+
+    const a = pool.run('a', () => (started.push('a'), first.promise));
+    const b = pool.run('b', async () => (started.push('b'), 'b'));
+    expect(started).toEqual(['a']);
+
+    first.resolve('a');
+    expect(await a).toBe('a');
+    expect(await b).toBe('b');
+    expect(started).toEqual(['a', 'b']);
+  });
+
+  it('drops aborted requests before they start (latest wins)', async () => {
+    const { pool } = fakePool(1);
+    const blocker = deferred<void>();
+    const started: string[] = [];
+    void pool.run('blocker', () => blocker.promise);
+
+    const stale = new AbortController();
+    const staleResult = pool.run('stale', async () => started.push('stale'), {
+      signal: stale.signal,
+    });
+    const latest = pool.run('latest', async () => (started.push('latest'), 'latest'));
+    stale.abort();
+
+    await expect(staleResult).rejects.toSatisfy(isAbortError);
+    blocker.resolve();
+    expect(await latest).toBe('latest');
+    expect(started).toEqual(['latest']);
+  });
+
+  it('rejects running requests on abort and discards their result', async () => {
+    const { pool } = fakePool(1);
+    const running = deferred<string>();
+    const controller = new AbortController();
+    const result = pool.run('slow', () => running.promise, { signal: controller.signal });
+    const next = pool.run('next', async () => 'next');
+
+    controller.abort();
+    await expect(result).rejects.toSatisfy(isAbortError);
+    running.resolve('ignored');
+    expect(await next).toBe('next');
+  });
+
+  it('restarts the worker when a running request is aborted', async () => {
+    const { pool, clients, terminated } = fakePool(1, { terminable: true });
+    const running = deferred<string>();
+    const controller = new AbortController();
+    const result = pool.run('slow', () => running.promise, { signal: controller.signal });
+    const ranOn: AggregationsClient[] = [];
+    const next = pool.run('next', async (client) => (ranOn.push(client), 'next'));
+
+    controller.abort();
+    await expect(result).rejects.toSatisfy(isAbortError);
+    // The slot is free without waiting for the abandoned request.
+    expect(await next).toBe('next');
+    expect(terminated).toEqual([clients[0]]);
+    expect(ranOn).toEqual([clients[1]]);
+
+    // A late result from the terminated worker does not disturb the slot.
+    running.resolve('ignored');
+    expect(await pool.run('after', async () => 'after')).toBe('after');
+  });
+
+  it('keeps pinned workers alive when a running request is aborted', async () => {
+    const { pool, terminated } = fakePool(1, { terminable: true });
+    pool.pin(0);
+    const running = deferred<string>();
+    const controller = new AbortController();
+    const result = pool.run('slow', () => running.promise, { signal: controller.signal });
+
+    controller.abort();
+    await expect(result).rejects.toSatisfy(isAbortError);
+    expect(terminated).toEqual([]);
+    running.resolve('ignored');
+    pool.unpin(0);
+  });
+
+  it('rejects immediately when the signal is already aborted', async () => {
+    const { pool } = fakePool(1);
+    const controller = new AbortController();
+    controller.abort();
+    let ran = false;
+    await expect(
+      pool.run('noop', async () => (ran = true), { signal: controller.signal })
+    ).rejects.toSatisfy(isAbortError);
+    expect(ran).toBe(false);
+  });
+
+  it('spreads work across workers and honours pinning', async () => {
+    const { pool, slotOf } = fakePool(3);
+    const hold = deferred<void>();
+    const slots: number[] = [];
+    const record = (client: AggregationsClient) => {
+      slots.push(slotOf(client));
+      return hold.promise;
+    };
+
+    void pool.run('x', record);
+    void pool.run('y', record);
+    expect(pool.pick()).toBe(2);
+    const pinned = pool.run('pinned', record, { worker: 0 });
+    expect(slots).toEqual([0, 1]);
+    hold.resolve();
+    await pinned;
+    expect(slots).toEqual([0, 1, 0]);
+    await expect(pool.run('bad', record, { worker: 7 })).rejects.toThrow(RangeError);
+  });
+});
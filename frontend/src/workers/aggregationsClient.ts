@@ -1,20 +1,262 @@
 /**
- * Thin wrapper around the aggregations Web Worker.
+ * Pool of aggregations Web Workers.
  *
- * The worker is created lazily — and only once per session — so we avoid
- * spawning it on pages that never need heavy compute.  Calling code uses
- * `getAggregationsClient()` to obtain the comlink-wrapped proxy.
+ * Workers are created lazily — only once per session — so pages that never
+ * need heavy compute do not spawn them.  The pool is sized from
+ * `navigator.hardwareConcurrency` (leaving a core for the main thread, at
+ * most `MAX_POOL_SIZE`).  Calling code uses `getAggregationsPool()` and
+ * submits work with `pool.run(label, task, { signal })`.
+ *
+ * Each worker runs one request at a time; further requests queue on the
+ * client side so that cancellation is cheap:
+ *   - every request gets an id and, in development builds, its queue and
+ *     run time are logged to the console;
+ *   - aborting a request's `AbortSignal` drops it from the queue, or — if it
+ *     is already running — rejects it immediately and terminates its worker,
+ *     respawning a fresh one so the slot is free for the next request;
+ *   - a slot that holds resident datasets is never terminated (that would
+ *     drop them), so there an aborted request only has its result discarded
+ *     and keeps the slot busy until it finishes;
+ *   - `useAsyncMemo` aborts the previous computation whenever its deps
+ *     change, which gives latest-wins semantics per consumer.
  *
  * In environments without a real `Worker` constructor (vitest/jsdom with no
- * worker shim), `getAggregationsClient()` returns `null` so callers can fall
+ * worker shim), `getAggregationsPool()` returns `null` so callers can fall
  * back to running the same pure functions on the main thread.
+ *
+ * Resident datasets (see `aggregations.worker.ts`) live on one worker.
+ * `acquireWorkerDataset` loads a given source array once, remembers which
+ * worker holds it, pins that worker, reference-counts its users and
+ * releases the worker copy (and the pin) when the last one lets go.
+ * Queries against a dataset must pass its `worker` to `run`.
  */
 import { wrap, type Remote } from 'comlink';
 import type { AggregationsApi } from './aggregations.worker';
 
-let cached: Remote<AggregationsApi> | null | undefined;
+export type AggregationsClient = Remote<AggregationsApi>;
+
+/** Upper bound on pool size; the workloads are memory- rather than CPU-heavy. */
+const MAX_POOL_SIZE = 4;
+
+/** One pool worker; `terminate` lets the pool cancel running requests. */
+export interface AggregationsWorker {
+  client: AggregationsClient;
+  terminate?: () => void;
+}
+
+export interface AggregationsRunOptions {
+  /** Abort to drop the request (queued) or cancel it (running). */
+  signal?: AbortSignal;
+  /** Pool slot to run on; required for resident-dataset handles. */
+  worker?: number;
+}
+
+export interface AggregationsPool {
+  readonly size: number;
+  run<T>(
+    label: string,
+    task: (client: AggregationsClient) => Promise<T>,
+    options?: AggregationsRunOptions
+  ): Promise<T>;
+  /** Least-loaded slot, for placing new resident datasets. */
+  pick(): number;
+  /** Keep `worker` alive across aborts while it holds resident state. */
+  pin(worker: number): void;
+  unpin(worker: number): void;
+}
+
+export interface AggregationsPoolOptions {
+  /** Log per-request timing to the console. */
+  log?: boolean;
+}
+
+interface PoolRequest {
+  id: number;
+  label: string;
+  task: (client: AggregationsClient) => Promise<unknown>;
+  resolve: (value: unknown) => void;
+  reject: (reason: unknown) => void;
+  signal?: AbortSignal;
+  enqueuedAt: number;
+  settled: boolean;
+  detach: () => void;
+}
+
+interface PoolSlot {
+  worker: AggregationsWorker;
+  queue: PoolRequest[];
+  running: PoolRequest | null;
+  pins: number;
+}
+
+function abortReason(signal: AbortSignal): unknown {
+  return signal.reason ?? new DOMException('Aggregation request aborted', 'AbortError');
+}
+
+export function isAbortError(error: unknown): boolean {
+  return error instanceof DOMException && error.name === 'AbortError';
+}
+
+/**
+ * Build a pool over `size` workers created by `createWorker`.  Exposed for
+ * tests; the app uses the lazily created `getAggregationsPool()`.
+ */
+export function createAggregationsPool(
+  createWorker: () => AggregationsWorker,
+  size: number,
+  options: AggregationsPoolOptions = {}
+): AggregationsPool {
+  const slots: PoolSlot[] = Array.from({ length: Math.max(1, size) }, () => ({
+    worker: createWorker(),
+    queue: [],
+    running: null,
+    pins: 0,
+  }));
+  let nextId = 1;
+
+  const load = (slot: PoolSlot) => slot.queue.length + (slot.running ? 1 : 0);
+
+  const log = (request: PoolRequest, slot: number, outcome: string, startedAt?: number) => {
+    if (!options.log) return;
+    const now = performance.now();
+    const queued = (startedAt ?? now) - request.enqueuedAt;
+    const ran = startedAt === undefined ? 0 : now - startedAt;
+    console.debug(
+      `[aggregations #${request.id}] ${request.label} on worker ${slot}: ${outcome} ` +
+        `(queued ${queued.toFixed(1)} ms, ran ${ran.toFixed(1)} ms)`
+    );
+  };
+
+  const pump = (index: number) => {
+    const slot = slots[index];
+    if (slot.running) return;
+    const request = slot.queue.shift();
+    if (!request) return;
 
-export function getAggregationsClient(): Remote<AggregationsApi> | null {
+    slot.running = request;
+    const startedAt = performance.now();
+    const finish = (outcome: string, settle: () => void) => {
+      // The worker was replaced after an abort; the slot has moved on.
+      if (slot.running !== request) return;
+      slot.running = null;
+      request.detach();
+      if (!request.settled) {
+        request.settled = true;
+        settle();
+        log(request, index, outcome, startedAt);
+      } else {
+        log(request, index, 'discarded (aborted while running)', startedAt);
+      }
+      pump(index);
+    };
+
+    let pending: Promise<unknown>;
+    try {
+      pending = request.task(slot.worker.client);
+    } catch (error) {
+      pending = Promise.reject(error);
+    }
+    pending.then(
+      (value) => finish('done', () => request.resolve(value)),
+      (error) => finish('failed', () => request.reject(error))
+    );
+  };
+
+  /** Replace a slot's busy worker so an aborted request stops occupying it. */
+  const recycle = (index: number): boolean => {
+    const slot = slots[index];
+    if (slot.pins > 0 || !slot.worker.terminate) return false;
+    slot.worker.terminate();
+    slot.worker = createWorker();
+    slot.running = null;
+    return true;
+  };
+
+  const slotAt = (worker: number) => {
+    const slot = slots[worker];
+    if (!slot) throw new RangeError(`No aggregations worker ${worker}`);
+    return slot;
+  };
+
+  const pick = () => {
+    let best = 0;
+    for (let i = 1; i < slots.length; i++) {
+      if (load(slots[i]) < load(slots[best])) best = i;
+    }
+    return best;
+  };
+
+  return {
+    size: slots.length,
+    pick,
+    pin(worker) {
+      slotAt(worker).pins += 1;
+    },
+    unpin(worker) {
+      const slot = slotAt(worker);
+      slot.pins = Math.max(0, slot.pins - 1);
+    },
+    run<T>(
+      label: string,
+      task: (client: AggregationsClient) => Promise<T>,
+      { signal, worker }: AggregationsRunOptions = {}
+    ): Promise<T> {
+      const index = worker ?? pick();
+      if (index < 0 || index >= slots.length) {
+        return Promise.reject(new RangeError(`No aggregations worker ${index}`));
+      }
+      if (signal?.aborted) return Promise.reject(abortReason(signal));
+
+      return new Promise<T>((resolve, reject) => {
+        const slot = slots[index];
+        const request: PoolRequest = {
+          id: nextId++,
+          label,
+          task,
+          resolve: resolve as (value: unknown) => void,
+          reject,
+          signal,
+          enqueuedAt: performance.now(),
+          settled: false,
+          detach: () => undefined,
+        };
+
+        if (signal) {
+          const onAbort = () => {
+            if (request.settled) return;
+            request.settled = true;
+            const queued = slot.queue.indexOf(request);
+            let restarted = false;
+            if (queued >= 0) {
+              slot.queue.splice(queued, 1);
+              log(request, index, 'cancelled before start');
+            } else if (slot.running === request && recycle(index)) {
+              request.detach();
+              restarted = true;
+              log(request, index, 'cancelled while running (worker restarted)');
+            }
+            reject(abortReason(signal));
+            if (restarted) pump(index);
+          };
+          signal.addEventListener('abort', onAbort, { once: true });
+          request.detach = () => signal.removeEventListener('abort', onAbort);
+        }
+
+        slot.queue.push(request);
+        pump(index);
+      });
+    },
+  };
+}
+
+function defaultPoolSize(): number {
+  const cores = typeof navigator !== 'undefined' ? navigator.hardwareConcurrency : undefined;
+  return Math.min(MAX_POOL_SIZE, Math.max(1, (cores ?? 2) - 1));
+}
+
+let cached: AggregationsPool | null | undefined;
+
+export function getAggregationsPool(): AggregationsPool | null {
   if (cached !== undefined) return cached;
 
   if (typeof Worker === 'undefined') {
@@ -23,10 +265,16 @@ export function getAggregationsClient(): Remote<AggregationsApi> | null {
   }
 
   try {
-    const worker = new Worker(new URL('./aggregations.worker.ts', import.meta.url), {
-      type: 'module',
-    });
-    cached = wrap<AggregationsApi>(worker);
+    cached = createAggregationsPool(
+      () => {
+        const worker = new Worker(new URL('./aggregations.worker.ts', import.meta.url), {
+          type: 'module',
+        });
+        return { client: wrap<AggregationsApi>(worker), terminate: () => worker.terminate() };
+      },
+      defaultPoolSize(),
+      { log: import.meta.env.DEV }
+    );
   } catch {
     // Browsers/test runners without module-worker support.
     cached = null;
@@ -35,7 +283,70 @@ export function getAggregationsClient(): Remote<AggregationsApi> | null {
   return cached;
 }
 
-/** Test-only escape hatch — drop the cached proxy so the next call recreates it. */
-export function __resetAggregationsClient(): void {
+interface ResidentEntry {
+  dataset: Promise<ResidentDataset>;
+  refs: number;
+}
+
+export interface ResidentDataset {
+  /** Pool slot holding the dataset. */
+  worker: number;
+  handle: number;
+}
+
+const resident = new WeakMap<object, ResidentEntry>();
+
+/**
+ * Load `source` into a pool worker (via `load`) unless it is already
+ * resident, and return its location plus a release callback.  `source` is
+ * only used as an identity key — typically the React Query data array for
+ * a schedule.
+ */
+export function acquireWorkerDataset(
+  pool: AggregationsPool,
+  source: object,
+  load: (client: AggregationsClient) => Promise<number>
+): { dataset: Promise<ResidentDataset>; release: () => void } {
+  let entry = resident.get(source);
+  if (!entry) {
+    const worker = pool.pick();
+    pool.pin(worker);
+    entry = {
+      dataset: pool
+        .run('loadDataset', load, { worker })
+        .then((handle) => ({ worker, handle })),
+      refs: 0,
+    };
+    resident.set(source, entry);
+    // A failed load must not poison later attempts.
+    entry.dataset.catch(() => {
+      resident.delete(source);
+      pool.unpin(worker);
+    });
+  }
+  entry.refs += 1;
+  const acquired = entry;
+  let released = false;
+  return {
+    dataset: acquired.dataset,
+    release: () => {
+      if (released) return;
+      released = true;
+      acquired.refs -= 1;
+      if (acquired.refs > 0) return;
+      if (resident.get(source) === acquired) resident.delete(source);
+      acquired.dataset
+        .then(({ worker, handle }) =>
+          pool
+            .run('releaseDataset', (client) => client.releaseDataset(handle), { worker })
+            .finally(() => pool.unpin(worker))
+        )
+        .catch(() => undefined);
+    },
+  };
+}
+
+/** Test-only escape hatch — drop the cached pool so the next call recreates it. */
+export function __resetAggregationsPool(): void {
   cached = undefined;
 }
@@ -0,0 +1,143 @@
+import { describe, it, expect } from 'vitest';
+import { sortFilterBlocks, type SortFilterBlock, type SortFilterField } from './aggregations';
+import {
+  blockColumnsFromBlocks,
+  comparisonColumnsFromRows,
+  createBlockQueryIndex,
+  packStrings,
+  rankStrings,
+  sortComparisonColumns,
+  sortFilterBlockColumns,
+  unpackString,
+  type ComparisonRowInput,
+} from './blockColumns';
+
+function lcg(seed: number) {
+  let state = seed;
+  return () => (state = (state * 1103515245 + 12345) % 2 ** 31) / 2 ** 31;
+}
+
+describe('packStrings', () => {
+  it('round-trips values, treating undefined as empty', () => {
+    const packed = packStrings(['OB-1', undefined, 'Crab']);
+    expect([0, 1, 2].map((i) => unpackString(packed, i))).toEqual(['OB-1', '', 'Crab']);
+  });
+
+  it('ranks with numeric, case-insensitive collation', () => {
+    expect(Array.from(rankStrings(packStrings(['b10', 'B2', 'a', 'b2'])))).toEqual([2, 1, 0, 1]);
+  });
+});
+
+describe('sortFilterBlockColumns', () => {
+  const rand = lcg(11);
+  const blocks: SortFilterBlock[] = Array.from({ length: 400 }, (_, i) => ({
+    scheduling_block_id: 1000 + i,
+    original_block_id: `OB-${Math.floor(rand() * 200)}`,
+    block_name: rand() < 0.5 ? `Target ${Math.floor(rand() * 50)}` : undefined,
+    priority: Math.floor(rand() * 10),
+    scheduled: rand() < 0.4,
+    total_visibility_hours: rand() < 0.9 ? Math.floor(rand() * 20) : undefined,
+    requested_hours: Math.floor(rand() * 5),
+  }));
+  const columns = blockColumnsFromBlocks(blocks);
+  const fields: SortFilterField[] = [
+    'priority',
+    'scheduled',
+    'total_visibility_hours',
+    'requested_hours',
+  ];
+  // Typed progressively, then edited, like a user in the filter box.
+  const filters = ['', 'o', 'ob', 'ob-', 'ob-1', 'ob-10', 'ob-1', 't', 'TARGET 4', '105', 'zzz'];
+
+  it('matches the row-based sortFilterBlocks on random data', () => {
+    for (const field of fields) {
+      for (const direction of ['asc', 'desc'] as const) {
+        const index = createBlockQueryIndex();
+        for (const filter of filters) {
+          const expected = sortFilterBlocks(blocks, filter, { field, direction });
+          const cached = sortFilterBlockColumns(columns, filter, { field, direction }, index);
+          const fresh = sortFilterBlockColumns(columns, filter, { field, direction });
+          expect(Array.from(cached, (row) => blocks[row])).toEqual(expected);
+          expect(Array.from(fresh, (row) => blocks[row])).toEqual(expected);
+        }
+      }
+    }
+  });
+
+  it('returns a fresh array so callers may transfer it', () => {
+    const index = createBlockQueryIndex();
+    const sort = { field: 'priority', direction: 'desc' } as const;
+    const first = sortFilterBlockColumns(columns, '', sort, index);
+    first.fill(0);
+    const second = sortFilterBlockColumns(columns, '', sort, index);
+    expect(Array.from(second, (row) => blocks[row])).toEqual(sortFilterBlocks(blocks, '', sort));
+  });
+});
+
+describe('sortComparisonColumns', () => {
+  const rows: ComparisonRowInput[] = [
+    {
+      original_block_id: 'B-10',
+      maxPriority: 5,
+      maxRequestedHours: 1,
+      perSchedule: {
+        1: { scheduled: true, start_mjd: 60001 },
+        2: { scheduled: true, start_mjd: 1 },
+      },
+    },
+    {
+      original_block_id: 'B-2',
+      maxPriority: 5,
+      maxRequestedHours: 3,
+      perSchedule: { 1: { scheduled: false, start_mjd: null } },
+    },
+    {
+      original_block_id: 'B-1',
+      maxPriority: 9,
+      maxRequestedHours: 2,
+      perSchedule: {
+        1: { scheduled: true, start_mjd: 60000 },
+        2: { scheduled: false, start_mjd: null },
+      },
+    },
+  ];
+  const columns = comparisonColumnsFromRows(rows, [1, 2]);
+  const ranks = rankStrings(columns.blockId);
+  const ids = (order: Uint32Array) => Array.from(order, (row) => rows[row].original_block_id);
+
+  it('sorts block ids numerically', () => {
+    const order = sortComparisonColumns(
+      columns,
+      { sort: { kind: 'blockId' }, direction: 'asc', differencesOnly: false },
+      ranks
+    );
+    expect(ids(order)).toEqual(['B-1', 'B-2', 'B-10']);
+  });
+
+  it('breaks priority ties by block id', () => {
+    const order = sortComparisonColumns(
+      columns,
+      { sort: { kind: 'priority' }, direction: 'desc', differencesOnly: false },
+      ranks
+    );
+    expect(ids(order)).toEqual(['B-1', 'B-2', 'B-10']);
+  });
+
+  it('orders schedule columns by state, then start time', () => {
+    const order = sortComparisonColumns(
+      columns,
+      { sort: { kind: 'schedule', scheduleIndex: 0 }, direction: 'asc', differencesOnly: false },
+      ranks
+    );
+    expect(ids(order)).toEqual(['B-1', 'B-10', 'B-2']);
+  });
+
+  it('drops rows that agree across every schedule', () => {
+    const order = sortComparisonColumns(
+      columns,
+      { sort: { kind: 'priority' }, direction: 'desc', differencesOnly: true },
+      ranks
+    );
+    expect(ids(order)).toEqual(['B-1', 'B-2']);
+  });
+});
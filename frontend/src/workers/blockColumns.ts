@@ -0,0 +1,457 @@
+/**
+ * Columnar (structure-of-arrays) block datasets for the aggregations worker.
+ *
+ * Tables hand the worker their rows once, as typed-array columns whose
+ * buffers are transferred rather than structured-cloned.  The worker keeps
+ * the dataset resident under a numeric handle; every later sort/filter
+ * request sends only the query and gets back a `Uint32Array` permutation of
+ * row indices into the caller's original array.
+ *
+ * Like `aggregations.ts`, this module is DOM-free and runs both inside the
+ * worker and inline on the main thread (small inputs, tests, no `Worker`).
+ */
+import type { SortFilterBlock, SortFilterSpec } from './aggregations';
+
+/** Strings concatenated into one buffer; row `i` is `text[offsets[i]..offsets[i + 1]]`. */
+export interface PackedStrings {
+  text: string;
+  offsets: Uint32Array;
+}
+
+export function packStrings(values: readonly (string | undefined)[]): PackedStrings {
+  const offsets = new Uint32Array(values.length + 1);
+  const parts: string[] = [];
+  let length = 0;
+  for (let i = 0; i < values.length; i++) {
+    const value = values[i] ?? '';
+    parts.push(value);
+    length += value.length;
+    offsets[i + 1] = length;
+  }
+  return { text: parts.join(''), offsets };
+}
+
+export function unpackString(packed: PackedStrings, index: number): string {
+  return packed.text.slice(packed.offsets[index], packed.offsets[index + 1]);
+}
+
+const collator = new Intl.Collator(undefined, { numeric: true, sensitivity: 'base' });
+
+/**
+ * Dense collation rank of every packed string (numeric, case-insensitive),
+ * so text sorts become integer comparisons.  Equal strings share a rank.
+ */
+export function rankStrings(packed: PackedStrings): Uint32Array {
+  const count = packed.offsets.length - 1;
+  const values = Array.from({ length: count }, (_, i) => unpackString(packed, i));
+  const order = new Uint32Array(count);
+  for (let i = 0; i < count; i++) order[i] = i;
+  order.sort((a, b) => collator.compare(values[a], values[b]));
+  const ranks = new Uint32Array(count);
+  let rank = 0;
+  for (let k = 0; k < count; k++) {
+    if (k > 0 && collator.compare(values[order[k - 1]], values[order[k]]) !== 0) rank++;
+    ranks[order[k]] = rank;
+  }
+  return ranks;
+}
+
+function identityOrder(count: number): Uint32Array {
+  const order = new Uint32Array(count);
+  for (let i = 0; i < count; i++) order[i] = i;
+  return order;
+}
+
+// ---------------------------------------------------------------------------
+// Block datasets — BlocksTable
+// ---------------------------------------------------------------------------
+
+export interface BlockColumns {
+  count: number;
+  schedulingBlockId: Float64Array;
+  originalBlockId: PackedStrings;
+  blockName: PackedStrings;
+  priority: Float64Array;
+  /** 1 when scheduled, else 0. */
+  scheduled: Uint8Array;
+  /** Missing values are stored as 0, matching `sortFilterBlocks`. */
+  totalVisibilityHours: Float64Array;
+  requestedHours: Float64Array;
+}
+
+export function blockColumnsFromBlocks(blocks: readonly SortFilterBlock[]): BlockColumns {
+  const count = blocks.length;
+  const columns: BlockColumns = {
+    count,
+    schedulingBlockId: new Float64Array(count),
+    originalBlockId: packStrings(blocks.map((b) => b.original_block_id)),
+    blockName: packStrings(blocks.map((b) => b.block_name)),
+    priority: new Float64Array(count),
+    scheduled: new Uint8Array(count),
+    totalVisibilityHours: new Float64Array(count),
+    requestedHours: new Float64Array(count),
+  };
+  for (let i = 0; i < count; i++) {
+    const block = blocks[i];
+    columns.schedulingBlockId[i] = block.scheduling_block_id;
+    columns.priority[i] = block.priority;
+    columns.scheduled[i] = block.scheduled ? 1 : 0;
+    columns.totalVisibilityHours[i] = block.total_visibility_hours ?? 0;
+    columns.requestedHours[i] = block.requested_hours ?? 0;
+  }
+  return columns;
+}
+
+/** Buffers to hand to comlink's `transfer` when posting a dataset. */
+export function blockColumnsTransferables(columns: BlockColumns): ArrayBuffer[] {
+  return [
+    columns.schedulingBlockId,
+    columns.originalBlockId.offsets,
+    columns.blockName.offsets,
+    columns.priority,
+    columns.scheduled,
+    columns.totalVisibilityHours,
+    columns.requestedHours,
+  ].map((array) => array.buffer as ArrayBuffer);
+}
+
+function blockSortKey(columns: BlockColumns, field: SortFilterSpec['field']): ArrayLike<number> {
+  switch (field) {
+    case 'priority':
+      return columns.priority;
+    case 'scheduled':
+      return columns.scheduled;
+    case 'total_visibility_hours':
+      return columns.totalVisibilityHours;
+    case 'requested_hours':
+      return columns.requestedHours;
+  }
+}
+
+/** Separates the searchable fields so matches never span two of them. */
+const FIELD_SEPARATOR = '\u0000';
+
+/**
+ * Lazily built query caches for one `BlockColumns` dataset:
+ *   - `haystacks`: lowercased `id \0 original_block_id \0 block_name` per row;
+ *   - `trigrams`: posting lists (ascending row ids) for every trigram of the
+ *     haystacks, so filters of three or more characters only verify rows
+ *     that contain all of the filter's trigrams;
+ *   - `orders` / `ranks`: the stable sort permutation (and its inverse) per
+ *     field and direction, so a filter change intersects the matches with a
+ *     cached order instead of re-sorting;
+ *   - `last`: the previous filter and its matches — a filter that extends it
+ *     can only match a subset of those rows.
+ * Keep one per resident dataset; it is not transferable.
+ */
+export interface BlockQueryIndex {
+  haystacks: string[] | null;
+  trigrams: Map<string, Uint32Array> | null;
+  orders: Map<string, Uint32Array>;
+  ranks: Map<string, Uint32Array>;
+  last: { filter: string; matches: Uint32Array } | null;
+}
+
+export function createBlockQueryIndex(): BlockQueryIndex {
+  return { haystacks: null, trigrams: null, orders: new Map(), ranks: new Map(), last: null };
+}
+
+function blockHaystacks(columns: BlockColumns, index: BlockQueryIndex): string[] {
+  index.haystacks ??= Array.from(
+    { length: columns.count },
+    (_, i) =>
+      String(columns.schedulingBlockId[i]) +
+      FIELD_SEPARATOR +
+      unpackString(columns.originalBlockId, i).toLowerCase() +
+      FIELD_SEPARATOR +
+      unpackString(columns.blockName, i).toLowerCase()
+  );
+  return index.haystacks;
+}
+
+function blockTrigrams(columns: BlockColumns, index: BlockQueryIndex): Map<string, Uint32Array> {
+  if (index.trigrams) return index.trigrams;
+  const haystacks = blockHaystacks(columns, index);
+  const postings = new Map<string, number[]>();
+  for (let row = 0; row < haystacks.length; row++) {
+    const text = haystacks[row];
+    for (let k = 0; k + 3 <= text.length; k++) {
+      const gram = text.slice(k, k + 3);
+      let list = postings.get(gram);
+      if (!list) postings.set(gram, (list = []));
+      // Rows are visited in order, so a repeat can only be the last entry.
+      if (list[list.length - 1] !== row) list.push(row);
+    }
+  }
+  index.trigrams = new Map(Array.from(postings, ([gram, rows]) => [gram, Uint32Array.from(rows)]));
+  return index.trigrams;
+}
+
+/** Rows present in both ascending lists. */
+function intersectSorted(left: Uint32Array, right: Uint32Array): Uint32Array {
+  const out = new Uint32Array(Math.min(left.length, right.length));
+  let i = 0;
+  let j = 0;
+  let n = 0;
+  while (i < left.length && j < right.length) {
+    if (left[i] < right[j]) i++;
+    else if (left[i] > right[j]) j++;
+    else {
+      out[n++] = left[i];
+      i++;
+      j++;
+    }
+  }
+  return out.subarray(0, n);
+}
+
+/** Candidate rows for `lower` from the trigram index (a superset of the matches). */
+function trigramCandidates(
+  columns: BlockColumns,
+  index: BlockQueryIndex,
+  lower: string
+): Uint32Array {
+  const trigrams = blockTrigrams(columns, index);
+  const lists: Uint32Array[] = [];
+  for (let k = 0; k + 3 <= lower.length; k++) {
+    const list = trigrams.get(lower.slice(k, k + 3));
+    if (!list) return new Uint32Array(0);
+    lists.push(list);
+  }
+  lists.sort((a, b) => a.length - b.length);
+  let candidates = lists[0];
+  for (let l = 1; l < lists.length && candidates.length > 0; l++) {
+    candidates = intersectSorted(candidates, lists[l]);
+  }
+  return candidates;
+}
+
+/** Ascending ids of rows whose id, original id or name contain `lower`. */
+function matchingRows(columns: BlockColumns, index: BlockQueryIndex, lower: string): Uint32Array {
+  let candidates: Uint32Array | null = null;
+  const last = index.last;
+  if (last && lower.includes(last.filter)) candidates = last.matches;
+  if (lower.length >= 3) {
+    const fromIndex = trigramCandidates(columns, index, lower);
+    candidates = candidates ? intersectSorted(candidates, fromIndex) : fromIndex;
+  }
+
+  const haystacks = blockHaystacks(columns, index);
+  // A separator in the filter would let a match straddle two fields.
+  const matches = lower.includes(FIELD_SEPARATOR)
+    ? (row: number) => haystacks[row].split(FIELD_SEPARATOR).some((f) => f.includes(lower))
+    : (row: number) => haystacks[row].includes(lower);
+  const total = candidates ? candidates.length : columns.count;
+  const out = new Uint32Array(total);
+  let n = 0;
+  for (let k = 0; k < total; k++) {
+    const row = candidates ? candidates[k] : k;
+    if (matches(row)) out[n++] = row;
+  }
+  const result = out.slice(0, n);
+  index.last = { filter: lower, matches: result };
+  return result;
+}
+
+function cachedOrder(
+  columns: BlockColumns,
+  index: BlockQueryIndex,
+  sort: SortFilterSpec
+): { order: Uint32Array; rank: Uint32Array } {
+  const cacheKey = `${sort.field}:${sort.direction}`;
+  let order = index.orders.get(cacheKey);
+  let rank = index.ranks.get(cacheKey);
+  if (!order || !rank) {
+    const key = blockSortKey(columns, sort.field);
+    const sign = sort.direction === 'asc' ? 1 : -1;
+    // Index tie-break keeps the sort stable regardless of engine.
+    order = identityOrder(columns.count).sort((a, b) => sign * (key[a] - key[b]) || a - b);
+    rank = new Uint32Array(columns.count);
+    for (let k = 0; k < order.length; k++) rank[order[k]] = k;
+    index.orders.set(cacheKey, order);
+    index.ranks.set(cacheKey, rank);
+  }
+  return { order, rank };
+}
+
+/**
+ * Columnar equivalent of `sortFilterBlocks`: rows whose scheduling id,
+ * original id or name contain `filter` (case-insensitive), stably sorted by
+ * `sort`.  Returns a fresh array of row indices into the dataset (safe to
+ * transfer).
+ *
+ * With a long-lived `index` the filter is a trigram lookup plus verification
+ * and the sort is an intersection with a cached permutation: small match
+ * sets are ordered by their cached rank, large ones by walking the cached
+ * order.
+ */
+export function sortFilterBlockColumns(
+  columns: BlockColumns,
+  filter: string,
+  sort: SortFilterSpec,
+  index: BlockQueryIndex = createBlockQueryIndex()
+): Uint32Array {
+  const { order, rank } = cachedOrder(columns, index, sort);
+  if (!filter) return order.slice();
+
+  const matches = matchingRows(columns, index, filter.toLowerCase());
+  const m = matches.length;
+  if (m * Math.log2(m + 1) < columns.count) {
+    return matches.slice().sort((a, b) => rank[a] - rank[b]);
+  }
+  const keep = new Uint8Array(columns.count);
+  for (let k = 0; k < m; k++) keep[matches[k]] = 1;
+  const out = new Uint32Array(m);
+  let n = 0;
+  for (let k = 0; k < order.length; k++) {
+    if (keep[order[k]]) out[n++] = order[k];
+  }
+  return out;
+}
+
+// ---------------------------------------------------------------------------
+// Comparison datasets — ScheduleComparisonTables.BlockStatusTable
+// ---------------------------------------------------------------------------
+
+/** Per-schedule state codes; the order is also the sort rank. */
+export const COMPARISON_SCHEDULED = 0;
+export const COMPARISON_UNSCHEDULED = 1;
+export const COMPARISON_MISSING = 2;
+
+export interface ComparisonColumns {
+  /** Number of unique blocks (rows). */
+  count: number;
+  /** Number of schedules (columns). */
+  scheduleCount: number;
+  blockId: PackedStrings;
+  maxPriority: Float64Array;
+  maxRequestedHours: Float64Array;
+  /** Row-major `[schedule * count + row]` state code. */
+  state: Uint8Array;
+  /** Row-major scheduled start; `NaN` when unscheduled or unknown. */
+  startMjd: Float64Array;
+}
+
+export interface ComparisonRowInput {
+  original_block_id: string;
+  maxPriority: number;
+  maxRequestedHours: number;
+  perSchedule: Record<number, { scheduled: boolean; start_mjd: number | null | undefined }>;
+}
+
+export function comparisonColumnsFromRows(
+  rows: readonly ComparisonRowInput[],
+  scheduleIds: readonly number[]
+): ComparisonColumns {
+  const count = rows.length;
+  const scheduleCount = scheduleIds.length;
+  const columns: ComparisonColumns = {
+    count,
+    scheduleCount,
+    blockId: packStrings(rows.map((row) => row.original_block_id)),
+    maxPriority: new Float64Array(count),
+    maxRequestedHours: new Float64Array(count),
+    state: new Uint8Array(count * scheduleCount).fill(COMPARISON_MISSING),
+    startMjd: new Float64Array(count * scheduleCount).fill(NaN),
+  };
+  for (let i = 0; i < count; i++) {
+    const row = rows[i];
+    columns.maxPriority[i] = row.maxPriority;
+    columns.maxRequestedHours[i] = row.maxRequestedHours;
+    for (let s = 0; s < scheduleCount; s++) {
+      const entry = row.perSchedule[scheduleIds[s]];
+      if (!entry) continue;
+      const cell = s * count + i;
+      columns.state[cell] = entry.scheduled ? COMPARISON_SCHEDULED : COMPARISON_UNSCHEDULED;
+      columns.startMjd[cell] = entry.start_mjd ?? NaN;
+    }
+  }
+  return columns;
+}
+
+export function comparisonColumnsTransferables(columns: ComparisonColumns): ArrayBuffer[] {
+  return [
+    columns.blockId.offsets,
+    columns.maxPriority,
+    columns.maxRequestedHours,
+    columns.state,
+    columns.startMjd,
+  ].map((array) => array.buffer as ArrayBuffer);
+}
+
+export type ComparisonSortField =
+  | { kind: 'blockId' }
+  | { kind: 'priority' }
+  | { kind: 'duration' }
+  | { kind: 'schedule'; scheduleIndex: number };
+
+export interface ComparisonQuery {
+  sort: ComparisonSortField;
+  direction: 'asc' | 'desc';
+  /** Drop rows that are scheduled everywhere or unscheduled everywhere. */
+  differencesOnly: boolean;
+}
+
+function isUniformRow(columns: ComparisonColumns, row: number): boolean {
+  const { count, scheduleCount, state } = columns;
+  if (scheduleCount === 0) return true;
+  const first = state[row];
+  if (first === COMPARISON_MISSING) return false;
+  for (let s = 1; s < scheduleCount; s++) {
+    if (state[s * count + row] !== first) return false;
+  }
+  return true;
+}
+
+/**
+ * Sort (and optionally filter) comparison rows.  Ties fall back to
+ * priority descending, then block id ascending, then input order.
+ *
+ * @param idRanks  collation ranks of `blockId` (see `rankStrings`)
+ */
+export function sortComparisonColumns(
+  columns: ComparisonColumns,
+  query: ComparisonQuery,
+  idRanks: Uint32Array
+): Uint32Array {
+  let order = identityOrder(columns.count);
+  if (query.differencesOnly) {
+    let kept = 0;
+    for (let i = 0; i < columns.count; i++) {
+      if (!isUniformRow(columns, i)) order[kept++] = i;
+    }
+    order = order.slice(0, kept);
+  }
+
+  const { count, maxPriority, maxRequestedHours, state, startMjd } = columns;
+  const sign = query.direction === 'asc' ? 1 : -1;
+  const sort = query.sort;
+  let primary: (a: number, b: number) => number;
+  switch (sort.kind) {
+    case 'blockId':
+      primary = (a, b) => idRanks[a] - idRanks[b];
+      break;
+    case 'priority':
+      primary = (a, b) => maxPriority[a] - maxPriority[b];
+      break;
+    case 'duration':
+      primary = (a, b) => maxRequestedHours[a] - maxRequestedHours[b];
+      break;
+    case 'schedule': {
+      const base = sort.scheduleIndex * count;
+      primary = (a, b) => {
+        const byState = state[base + a] - state[base + b];
+        if (byState !== 0 || state[base + a] !== COMPARISON_SCHEDULED) return byState;
+        const left = Number.isNaN(startMjd[base + a]) ? Infinity : startMjd[base + a];
+        const right = Number.isNaN(startMjd[base + b]) ? Infinity : startMjd[base + b];
+        return left < right ? -1 : left > right ? 1 : 0;
+      };
+      break;
+    }
+  }
+
+  return order.sort(
+    (a, b) =>
+      sign * primary(a, b) || maxPriority[b] - maxPriority[a] || idRanks[a] - idRanks[b] || a - b
+  );
+}
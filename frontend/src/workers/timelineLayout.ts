@@ -0,0 +1,185 @@
+/**
+ * Typed-array layout for the Timeline page.
+ *
+ * The backend returns the month-row bar segments as parallel columns
+ * (`ScheduleTimelineData.layout`). This module packs them once into
+ * a handful of WebGL polylines (one per priority colour bin) and a per-row
+ * interval index used for hover hit-testing, so the page only draws.
+ *
+ * Like `aggregations.ts`, this module is DOM-free: it runs inside the
+ * aggregations worker and directly in unit tests. All buffers are plain
+ * typed arrays so they can be transferred instead of copied.
+ */
+import type { TimelineLayoutColumns } from '@/api/types';
+
+/** Number of priority colour bins; matches the backend's `TIMELINE_COLOR_BINS`. */
+export const TIMELINE_COLOR_BINS = 16;
+
+export interface TimelineLayoutInput {
+  x0: Float64Array;
+  x1: Float64Array;
+  row: Uint32Array;
+  blockIndex: Uint32Array;
+  colorIndex: Uint8Array;
+  /** Number of month rows. */
+  rows: number;
+}
+
+export interface TimelineLayout {
+  /** Number of bar segments. */
+  count: number;
+  /** Fractional day-of-month (1-based) where each segment starts/ends. */
+  x0: Float64Array;
+  x1: Float64Array;
+  /** Month row of each segment. */
+  row: Uint32Array;
+  /** Index of the source block in `ScheduleTimelineData.blocks`. */
+  blockIndex: Uint32Array;
+  /** Priority colour bin of each segment, `0..TIMELINE_COLOR_BINS`. */
+  colorIndex: Uint8Array;
+  /**
+   * Polyline vertices grouped by colour bin: three entries per segment
+   * (`x0`, `x1`, `NaN` gap). Bin `b` covers segments
+   * `[binOffsets[b], binOffsets[b + 1])`.
+   */
+  lineX: Float64Array;
+  lineY: Float32Array;
+  binOffsets: Uint32Array;
+  /** Segment ids ordered by `(row, x0)` — the hover index. */
+  order: Uint32Array;
+  /** Row `r` occupies `order[rowOffsets[r] .. rowOffsets[r + 1]]`. */
+  rowOffsets: Uint32Array;
+  /** Running max of `x1` along `order`, reset at each row start. */
+  prefixMaxX1: Float64Array;
+}
+
+/** Hue used for colour bin `bin` (priority 0–10 mapped onto hue 0–240). */
+export function timelineBinColor(bin: number): string {
+  const hue = (bin / (TIMELINE_COLOR_BINS - 1)) * 240;
+  return `hsl(${hue.toFixed(1)}, 70%, 50%)`;
+}
+
+/** Copy the JSON layout columns into typed arrays. */
+export function timelineLayoutInput(
+  columns: TimelineLayoutColumns,
+  rows: number
+): TimelineLayoutInput {
+  return {
+    x0: Float64Array.from(columns.x0),
+    x1: Float64Array.from(columns.x1),
+    row: Uint32Array.from(columns.row),
+    blockIndex: Uint32Array.from(columns.block_index),
+    colorIndex: Uint8Array.from(columns.color_index),
+    rows,
+  };
+}
+
+/** Pack server-side segments into polylines and the hover index. */
+export function buildTimelineLayout(input: TimelineLayoutInput): TimelineLayout {
+  const { x0, x1, row, blockIndex } = input;
+  const count = x0.length;
+  const rows = Math.max(input.rows, 1);
+  const colorIndex = input.colorIndex.map((bin) => Math.min(bin, TIMELINE_COLOR_BINS - 1));
+
+  // Polylines grouped by colour bin (counting sort keeps input order).
+  const binOffsets = new Uint32Array(TIMELINE_COLOR_BINS + 1);
+  for (let i = 0; i < count; i++) binOffsets[colorIndex[i] + 1]++;
+  for (let b = 0; b < TIMELINE_COLOR_BINS; b++) binOffsets[b + 1] += binOffsets[b];
+  const cursor = binOffsets.slice(0, TIMELINE_COLOR_BINS);
+  const lineX = new Float64Array(count * 3);
+  const lineY = new Float32Array(count * 3);
+  for (let i = 0; i < count; i++) {
+    const slot = cursor[colorIndex[i]]++ * 3;
+    lineX[slot] = x0[i];
+    lineX[slot + 1] = x1[i];
+    lineX[slot + 2] = NaN;
+    lineY[slot] = row[i];
+    lineY[slot + 1] = row[i];
+    lineY[slot + 2] = NaN;
+  }
+
+  // Hover index: segments bucketed by row, sorted by x0 within a row.
+  const rowOffsets = new Uint32Array(rows + 1);
+  for (let i = 0; i < count; i++) rowOffsets[Math.min(row[i], rows - 1) + 1]++;
+  for (let r = 0; r < rows; r++) rowOffsets[r + 1] += rowOffsets[r];
+  const order = new Uint32Array(count);
+  const fill = rowOffsets.slice(0, rows);
+  for (let i = 0; i < count; i++) order[fill[Math.min(row[i], rows - 1)]++] = i;
+  const prefixMaxX1 = new Float64Array(count);
+  for (let r = 0; r < rows; r++) {
+    const lo = rowOffsets[r];
+    const hi = rowOffsets[r + 1];
+    order.subarray(lo, hi).sort((a, b) => x0[a] - x0[b]);
+    let runningMax = -Infinity;
+    for (let k = lo; k < hi; k++) {
+      runningMax = Math.max(runningMax, x1[order[k]]);
+      prefixMaxX1[k] = runningMax;
+    }
+  }
+
+  return {
+    count,
+    x0,
+    x1,
+    row,
+    blockIndex,
+    colorIndex,
+    lineX,
+    lineY,
+    binOffsets,
+    order,
+    rowOffsets,
+    prefixMaxX1,
+  };
+}
+
+/**
+ * Segment under the data-space point `(x, y)`, or `-1`.
+ *
+ * `y` is the (fractional) row coordinate; points further than
+ * `rowHalfHeight` from a row centre miss. When bars overlap, the one that
+ * started last — drawn on top — wins. Runs in O(log n + overlap).
+ */
+export function hitTestTimeline(
+  layout: TimelineLayout,
+  x: number,
+  y: number,
+  rowHalfHeight = 0.3
+): number {
+  const r = Math.round(y);
+  if (r < 0 || r >= layout.rowOffsets.length - 1 || Math.abs(y - r) > rowHalfHeight) {
+    return -1;
+  }
+  const lo = layout.rowOffsets[r];
+  let hi = layout.rowOffsets[r + 1];
+  const { order, x0, x1, prefixMaxX1 } = layout;
+
+  // Last position whose segment starts at or before x.
+  let left = lo;
+  while (left < hi) {
+    const mid = (left + hi) >>> 1;
+    if (x0[order[mid]] <= x) left = mid + 1;
+    else hi = mid;
+  }
+  for (let k = left - 1; k >= lo && prefixMaxX1[k] >= x; k--) {
+    if (x1[order[k]] >= x) return order[k];
+  }
+  return -1;
+}
+
+/** Buffers to hand to comlink's `transfer` when posting a layout. */
+export function timelineLayoutTransferables(layout: TimelineLayout): ArrayBuffer[] {
+  return [
+    layout.x0,
+    layout.x1,
+    layout.row,
+    layout.blockIndex,
+    layout.colorIndex,
+    layout.lineX,
+    layout.lineY,
+    layout.binOffsets,
+    layout.order,
+    layout.rowOffsets,
+    layout.prefixMaxX1,
+  ].map((array) => array.buffer as ArrayBuffer);
+}